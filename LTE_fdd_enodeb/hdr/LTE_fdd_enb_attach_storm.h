@@ -0,0 +1,131 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_attach_storm.h
+
+    Description: Contains all the definitions for the LTE FDD eNodeB
+                 attach storm benchmark.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_ENB_ATTACH_STORM_H__
+#define __LTE_FDD_ENB_ATTACH_STORM_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_interface.h"
+#include "LTE_fdd_enb_msgq.h"
+#include "LTE_fdd_enb_user.h"
+#include "liblte_security.h"
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <sys/time.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LTE_FDD_ENB_ATTACH_STORM_MAX_UES   10000
+#define LTE_FDD_ENB_ATTACH_STORM_WINDOW    256
+#define LTE_FDD_ENB_ATTACH_STORM_TIMEOUT_S 60
+#define LTE_FDD_ENB_ATTACH_STORM_IMSI_BASE 1010000000000ULL   // MCC=001, MNC=01
+#define LTE_FDD_ENB_ATTACH_STORM_IMEI_BASE 350000000000000ULL
+#define LTE_FDD_ENB_ATTACH_STORM_K         "000102030405060708090a0b0c0d0e0f"
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef struct{
+    struct timeval start;
+    uint32         latency_us;
+    bool           subscriber_added;
+    bool           attached;
+    bool           done;
+}LTE_FDD_ENB_ATTACH_STORM_UE_STRUCT;
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+// Feeds attach requests from simulated UEs into the MME the same way RRC
+// does, keeping at most a window of attaches in flight.  The workers hand
+// anything the MME sends to a simulated UE here instead of to RRC, where
+// it is answered as a UE would, so the whole NAS procedure runs on the
+// real MME and HSS without a radio.  A run has its own thread and reports
+// back with a ctrl info message.  Its subscribers are never written to
+// the user file and are removed from the HSS when it ends.
+class LTE_fdd_enb_attach_storm
+{
+public:
+    // Singleton
+    static LTE_fdd_enb_attach_storm* get_instance(void);
+    static void cleanup(void);
+
+    // External interface
+    LTE_FDD_ENB_ERROR_ENUM start(uint32 N_ues);
+
+    // Communication
+    void handle_mme_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
+
+private:
+    // Singleton
+    static LTE_fdd_enb_attach_storm *instance;
+    LTE_fdd_enb_attach_storm();
+    ~LTE_fdd_enb_attach_storm();
+
+    // Run
+    static void* run_thread(void *inputs);
+    void run(uint32 N_ues, std::string *report);
+    pthread_t run_thread_id;
+    uint32    N_run_ues;
+    bool      run_started;
+    bool      running;
+
+    // Simulated UEs
+    void handle_nas_msg(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void handle_release(LTE_fdd_enb_user *user);
+    void send_attach_request(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void send_authentication_response(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb, LIBLTE_BYTE_MSG_STRUCT *auth_req_msg);
+    void send_security_mode_complete(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void send_attach_complete(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void send_nas_msg(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb, LIBLTE_BYTE_MSG_STRUCT *nas_msg);
+    LTE_FDD_ENB_ATTACH_STORM_UE_STRUCT  *ue;
+    LIBLTE_SECURITY_MILENAGE_CTX_STRUCT  milenage;
+
+    // Progress
+    boost::mutex              run_mutex;
+    boost::mutex              done_mutex;
+    boost::condition_variable done_cond;
+    uint32                    N_done;
+    uint32                    N_attached;
+};
+
+#endif /* __LTE_FDD_ENB_ATTACH_STORM_H__ */
@@ -41,8 +41,10 @@
 *******************************************************************************/
 
 #include "LTE_fdd_enb_interface.h"
+#include "LTE_fdd_enb_persist.h"
 #include "liblte_rrc.h"
 #include "liblte_phy.h"
+#include <boost/thread/mutex.hpp>
 #include <string>
 #include <map>
 
@@ -91,12 +93,19 @@ typedef struct{
     bool                                    sib6_present;
     bool                                    sib7_present;
     bool                                    sib8_present;
-    bool                                    mib_pcap_sent;
-    bool                                    sib1_pcap_sent;
-    bool                                    sib_pcap_sent[4];
     bool                                    continuous_sib_pcap;
 }LTE_FDD_ENB_SYS_INFO_STRUCT;
 
+// Published configuration, never modified once readers can see it
+typedef struct{
+    LTE_FDD_ENB_SYS_INFO_STRUCT sys_info;
+    double                      param_double[LTE_FDD_ENB_PARAM_N_ITEMS];
+    int64                       param_int64[LTE_FDD_ENB_PARAM_N_ITEMS];
+    uint32                      param_uint32[LTE_FDD_ENB_PARAM_N_ITEMS];
+    uint32                      version;
+    uint32                      sys_info_version;
+}LTE_FDD_ENB_CNFG_SNAPSHOT_STRUCT;
+
 /*******************************************************************************
                               CLASS DECLARATIONS
 *******************************************************************************/
@@ -120,12 +129,17 @@ public:
 
     // MIB/SIB Construction
     void construct_sys_info(void);
-    void get_sys_info(LTE_FDD_ENB_SYS_INFO_STRUCT &_sys_info);
+
+    // Configuration Snapshots
+    const LTE_FDD_ENB_CNFG_SNAPSHOT_STRUCT* read_lock(uint32 *reader_idx);
+    void read_unlock(uint32 reader_idx);
 
     // Config File
     void read_cnfg_file(void);
 
 private:
+    friend class LTE_fdd_enb_cnfg_reader;
+
     // Singleton
     static LTE_fdd_enb_cnfg_db *instance;
     LTE_fdd_enb_cnfg_db();
@@ -135,14 +149,44 @@ private:
     std::map<LTE_FDD_ENB_PARAM_ENUM, double> var_map_double;
     std::map<LTE_FDD_ENB_PARAM_ENUM, int64>  var_map_int64;
     std::map<LTE_FDD_ENB_PARAM_ENUM, uint32> var_map_uint32;
+    void store_param(LTE_FDD_ENB_PARAM_ENUM param, int64 value);
+    void store_dl_earfcn(int64 dl_earfcn);
 
     // System information
     LTE_FDD_ENB_SYS_INFO_STRUCT sys_info;
+    uint32                      sys_info_version;
+
+    // Configuration Snapshots
+    void publish_snapshot(void);
+    void wait_for_readers(uint32 reader_idx);
+    boost::mutex                      snapshot_mutex;
+    LTE_FDD_ENB_CNFG_SNAPSHOT_STRUCT *snapshot;
+    uint32                            snapshot_version;
+    uint32                            snapshot_epoch;
+    uint32                            snapshot_readers[2];
 
     // Config File
-    void write_cnfg_file(void);
+    bool write_cnfg_file(FILE *cnfg_file);
     void delete_cnfg_file(void);
-    bool use_cnfg_file;
+    LTE_fdd_enb_persist *cnfg_persist;
+    bool                 use_cnfg_file;
+};
+
+// Keeps the current configuration snapshot alive for the lifetime of the
+// object.  Hold one for the duration of a unit of work (a subframe, a
+// message) rather than copying the configuration or taking a mutex.
+class LTE_fdd_enb_cnfg_reader
+{
+public:
+    LTE_fdd_enb_cnfg_reader();
+    ~LTE_fdd_enb_cnfg_reader();
+
+    const LTE_FDD_ENB_CNFG_SNAPSHOT_STRUCT *cnfg;
+    const LTE_FDD_ENB_SYS_INFO_STRUCT      *sys_info;
+
+private:
+    LTE_fdd_enb_cnfg_db *cnfg_db;
+    uint32               reader_idx;
 };
 
 #endif /* __LTE_FDD_ENB_CNFG_DB_H__ */
@@ -37,6 +37,7 @@
 
 #include "LTE_fdd_enb_interface.h"
 #include "LTE_fdd_enb_msgq.h"
+#include "LTE_fdd_enb_worker_mgr.h"
 
 /*******************************************************************************
                               DEFINES
@@ -81,8 +82,8 @@ private:
 
     // Communication
     void handle_pdcp_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
-    LTE_fdd_enb_msgq                   *pdcp_comm_msgq;
-    boost::interprocess::message_queue *gw_pdcp_mq;
+    LTE_fdd_enb_msgq       *pdcp_comm_msgq;
+    LTE_fdd_enb_worker_mgr *worker_mgr;
 
     // PDCP Message Handlers
     void handle_gw_data(LTE_FDD_ENB_GW_DATA_READY_MSG_STRUCT *gw_data);
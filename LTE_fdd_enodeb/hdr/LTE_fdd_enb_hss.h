@@ -42,6 +42,12 @@
 
 #include "LTE_fdd_enb_interface.h"
 #include "LTE_fdd_enb_user.h"
+#include "LTE_fdd_enb_persist.h"
+#include "liblte_security.h"
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/unordered_map.hpp>
 #include <list>
 
 /*******************************************************************************
@@ -53,6 +59,12 @@
 #define LTE_FDD_ENB_IND_HE_MAX_VALUE 31
 #define LTE_FDD_ENB_SEQ_HE_MAX_VALUE 0x7FFFFFFFFFFFUL
 
+#define LTE_FDD_ENB_USER_FILE_MAGIC   0x4244554CUL // "LUDB"
+#define LTE_FDD_ENB_USER_FILE_VERSION 1
+
+#define LTE_FDD_ENB_HSS_N_PREGEN_AV  3
+#define LTE_FDD_ENB_HSS_N_AV_THREADS 2
+
 /*******************************************************************************
                               FORWARD DECLARATIONS
 *******************************************************************************/
@@ -63,32 +75,72 @@
 *******************************************************************************/
 
 typedef struct{
-    uint8 k[16];
+    LIBLTE_SECURITY_MILENAGE_CTX_STRUCT milenage;
+    uint8                               k[16];
 }LTE_FDD_ENB_STORED_DATA_STRUCT;
 
+typedef struct{
+    uint64 sqn_he;
+    uint64 seq_he;
+    uint8  ind_he;
+}LTE_FDD_ENB_GENERATED_DATA_STRUCT;
+
+// Authentication vector computed ahead of demand for one serving network
 typedef struct{
     LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT auth_vec;
-    uint64                                   sqn_he;
-    uint64                                   seq_he;
+    uint16                                   mcc;
+    uint16                                   mnc;
     uint8                                    ak[6];
     uint8                                    mac[8];
-    uint8                                    k_asme[32];
     uint8                                    k_enb[32];
-    uint8                                    k_up_enc[32];
-    uint8                                    k_up_int[32];
-    uint8                                    ind_he;
-}LTE_FDD_ENB_GENERATED_DATA_STRUCT;
+}LTE_FDD_ENB_PREGEN_AV_STRUCT;
 
+// Attach waiting for an authentication vector, the user is looked up
+// again by C-RNTI when the vector is ready
 typedef struct{
-    LTE_FDD_ENB_USER_ID_STRUCT        id;
-    LTE_FDD_ENB_STORED_DATA_STRUCT    stored_data;
-    LTE_FDD_ENB_GENERATED_DATA_STRUCT generated_data;
+    LTE_FDD_ENB_RB_ENUM rb_id;
+    uint32              user_gen;
+    uint16              c_rnti;
+    uint16              mcc;
+    uint16              mnc;
+}LTE_FDD_ENB_HSS_AV_REQ_STRUCT;
+
+typedef struct{
+    LTE_FDD_ENB_USER_ID_STRUCT                id;
+    LTE_FDD_ENB_STORED_DATA_STRUCT            stored_data;
+    LTE_FDD_ENB_GENERATED_DATA_STRUCT         generated_data;
+    LTE_FDD_ENB_PREGEN_AV_STRUCT              pregen_av[LTE_FDD_ENB_HSS_N_PREGEN_AV];
+    boost::mutex                              mutex;
+    std::list<LTE_FDD_ENB_HSS_AV_REQ_STRUCT>  av_req_list;
+    uint32                                    N_pregen_av;
+    bool                                      persist;
 }LTE_FDD_ENB_HSS_USER_STRUCT;
 
+// User file layout, a header followed by N_users records
+typedef struct{
+    uint32 magic;
+    uint32 version;
+    uint64 N_users;
+}LTE_FDD_ENB_USER_FILE_HEADER_STRUCT;
+
+typedef struct{
+    uint64 imsi;
+    uint64 imei;
+    uint8  k[16];
+}LTE_FDD_ENB_USER_FILE_RECORD_STRUCT;
+
 /*******************************************************************************
                               CLASS DECLARATIONS
 *******************************************************************************/
 
+// Users are indexed by IMSI and IMEI.  The indices are guarded by a
+// shared lock that only adding and deleting users take exclusively, and
+// each user has its own lock for its sequence numbers and vectors.  A
+// pool of threads keeps a few authentication vectors ready for every
+// user, so an attach normally just takes one off the top.  When none is
+// ready the MME is not held up, the pool makes one ahead of all refills
+// and signals the MME with an auth vec ready message.  Every attach gets
+// its own copy of the vector, the HSS keeps none once it is handed out.
 class LTE_fdd_enb_hss
 {
 public:
@@ -97,17 +149,17 @@ public:
     static void cleanup(void);
 
     // External interface
-    LTE_FDD_ENB_ERROR_ENUM add_user(std::string imsi, std::string imei, std::string k);
+    LTE_FDD_ENB_ERROR_ENUM add_user(std::string imsi, std::string imei, std::string k, bool persist);
     LTE_FDD_ENB_ERROR_ENUM del_user(std::string imsi);
     std::string print_all_users(void);
     bool is_imsi_allowed(uint64 imsi);
     bool is_imei_allowed(uint64 imei);
     LTE_FDD_ENB_USER_ID_STRUCT* get_user_id_from_imsi(uint64 imsi);
     LTE_FDD_ENB_USER_ID_STRUCT* get_user_id_from_imei(uint64 imei);
-    void generate_security_data(LTE_FDD_ENB_USER_ID_STRUCT *id, uint16 mcc, uint16 mnc);
-    void security_resynch(LTE_FDD_ENB_USER_ID_STRUCT *id, uint16 mcc, uint16 mnc, uint8 *auts);
-    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT* regenerate_enb_security_data(LTE_FDD_ENB_USER_ID_STRUCT *id, uint32 nas_count_ul);
-    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT* get_auth_vec(LTE_FDD_ENB_USER_ID_STRUCT *id);
+    bool generate_security_data(LTE_FDD_ENB_USER_ID_STRUCT *id, uint16 mcc, uint16 mnc, LTE_fdd_enb_user *enb_user, LTE_fdd_enb_rb *rb, LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT *auth_vec);
+    void cancel_security_data(LTE_FDD_ENB_USER_ID_STRUCT *id, uint32 user_gen);
+    void security_resynch(LTE_FDD_ENB_USER_ID_STRUCT *id, uint16 mcc, uint16 mnc, uint8 *rand, uint8 *auts);
+    void regenerate_enb_security_data(LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT *auth_vec, uint32 nas_count_ul);
 
     // User File
     void set_use_user_file(bool uuf);
@@ -120,13 +172,27 @@ private:
     ~LTE_fdd_enb_hss();
 
     // Allowed users
-    boost::mutex                             user_mutex;
-    std::list<LTE_FDD_ENB_HSS_USER_STRUCT *> user_list;
+    LTE_FDD_ENB_HSS_USER_STRUCT* find_user(LTE_FDD_ENB_USER_ID_STRUCT *id);
+    boost::shared_mutex                                           user_mutex;
+    boost::unordered_map<uint64, LTE_FDD_ENB_HSS_USER_STRUCT *>   imsi_map;
+    boost::unordered_map<uint64, LTE_FDD_ENB_HSS_USER_STRUCT *>   imei_map;
+
+    // Authentication Vectors
+    static void* av_thread(void *inputs);
+    void generate_av(LTE_FDD_ENB_HSS_USER_STRUCT *user, uint16 mcc, uint16 mnc, LTE_FDD_ENB_PREGEN_AV_STRUCT *av);
+    bool use_pregen_av(LTE_FDD_ENB_HSS_USER_STRUCT *user, uint16 mcc, uint16 mnc, LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT *auth_vec);
+    void queue_av_refill(LTE_FDD_ENB_HSS_USER_STRUCT *user, bool first);
+    boost::mutex                                                  av_mutex;
+    boost::condition_variable                                     av_cond;
+    std::list<uint64>                                             av_queue;
+    pthread_t                                                     av_thread_id[LTE_FDD_ENB_HSS_N_AV_THREADS];
+    bool                                                          av_not_done;
 
     // User File
-    void write_user_file(void);
+    bool write_user_file(FILE *user_file);
     void delete_user_file(void);
-    bool use_user_file;
+    LTE_fdd_enb_persist                                          *user_persist;
+    bool                                                          use_user_file;
 };
 
 #endif /* __LTE_FDD_ENB_HSS_H__ */
@@ -59,8 +59,12 @@
                               DEFINES
 *******************************************************************************/
 
-#define LTE_FDD_ENB_DEFAULT_CTRL_PORT 30000
-#define LTE_FDD_ENB_DEBUG_PORT_OFFSET 1
+#define LTE_FDD_ENB_DEFAULT_CTRL_PORT     30000
+#define LTE_FDD_ENB_DEBUG_PORT_OFFSET     1
+#define LTE_FDD_ENB_MAX_CTRL_CLIENTS      4
+#define LTE_FDD_ENB_MAX_DEBUG_CLIENTS     8
+#define LTE_FDD_ENB_CTRL_CLIENT_TX_LIMIT  65536
+#define LTE_FDD_ENB_DEBUG_CLIENT_TX_LIMIT 1048576
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -95,6 +99,9 @@ typedef enum{
     LTE_FDD_ENB_ERROR_CANT_REASSEMBLE_SDU,
     LTE_FDD_ENB_ERROR_DUPLICATE_ENTRY,
     LTE_FDD_ENB_ERROR_READ_ONLY,
+    LTE_FDD_ENB_ERROR_NO_FREE_HARQ_PROC,
+    LTE_FDD_ENB_ERROR_HARQ_PROC_NOT_FOUND,
+    LTE_FDD_ENB_ERROR_NO_FREE_SOFT_BUFFER,
     LTE_FDD_ENB_ERROR_N_ITEMS,
 }LTE_FDD_ENB_ERROR_ENUM;
 static const char LTE_fdd_enb_error_text[LTE_FDD_ENB_ERROR_N_ITEMS][100] = {"none",
@@ -119,7 +126,10 @@ static const char LTE_fdd_enb_error_text[LTE_FDD_ENB_ERROR_N_ITEMS][100] = {"non
                                                                             "timer not found",
                                                                             "cant reassemble SDU",
                                                                             "duplicate entry",
-                                                                            "read only"};
+                                                                            "read only",
+                                                                            "no free HARQ process",
+                                                                            "HARQ process not found",
+                                                                            "no free soft buffer"};
 
 typedef enum{
     LTE_FDD_ENB_DEBUG_TYPE_ERROR = 0,
@@ -216,6 +226,9 @@ typedef enum{
     LTE_FDD_ENB_PARAM_DEBUG_TYPE,
     LTE_FDD_ENB_PARAM_DEBUG_LEVEL,
     LTE_FDD_ENB_PARAM_ENABLE_PCAP,
+    LTE_FDD_ENB_PARAM_ENABLE_ROHC,
+    LTE_FDD_ENB_PARAM_UE_AMBR_DL,
+    LTE_FDD_ENB_PARAM_N_WORKERS,
     LTE_FDD_ENB_PARAM_IP_ADDR_START,
     LTE_FDD_ENB_PARAM_DNS_ADDR,
     LTE_FDD_ENB_PARAM_USE_CNFG_FILE,
@@ -269,6 +282,9 @@ static const char LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_N_ITEMS][100] = {"ban
                                                                             "debug_type",
                                                                             "debug_level",
                                                                             "enable_pcap",
+                                                                            "enable_rohc",
+                                                                            "ue_ambr_dl",
+                                                                            "n_workers",
                                                                             "ip_addr_start",
                                                                             "dns_addr",
                                                                             "use_cnfg_file",
@@ -292,6 +308,12 @@ typedef struct{
     bool                      read_only;
 }LTE_FDD_ENB_VAR_STRUCT;
 
+// Debug stream subscription of one debug port client
+typedef struct{
+    uint32 type_mask;
+    uint32 level_mask;
+}LTE_FDD_ENB_DEBUG_SUB_STRUCT;
+
 /*******************************************************************************
                               CLASS DECLARATIONS
 *******************************************************************************/
@@ -307,35 +329,39 @@ public:
     void set_ctrl_port(int16 port);
     void start_ports(void);
     void stop_ports(void);
-    void send_ctrl_msg(std::string msg);
+    void send_ctrl_msg(uint32 client, std::string msg);
     void send_ctrl_info_msg(std::string msg, ...);
-    void send_ctrl_error_msg(LTE_FDD_ENB_ERROR_ENUM error, std::string msg);
+    void send_ctrl_error_msg(uint32 client, LTE_FDD_ENB_ERROR_ENUM error, std::string msg);
     void send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, std::string file_name, int32 line, std::string msg, ...);
     void send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, std::string file_name, int32 line, LIBLTE_BIT_MSG_STRUCT *lte_msg, std::string msg, ...);
     void send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, std::string file_name, int32 line, LIBLTE_BYTE_MSG_STRUCT *lte_msg, std::string msg, ...);
     void open_pcap_fd(void);
-    void send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_ENUM dir, uint32 rnti, uint32 current_tti, uint8 *msg, uint32 N_bits);
-    static void handle_ctrl_msg(std::string msg);
-    static void handle_ctrl_connect(void);
-    static void handle_ctrl_disconnect(void);
+    void send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_ENUM dir, uint32 rnti, uint32 current_tti, const uint8 *msg, uint32 N_bits);
+    static void handle_ctrl_msg(uint32 client, const char *line, uint32 len);
+    static void handle_ctrl_connect(uint32 client);
+    static void handle_ctrl_disconnect(uint32 client);
     static void handle_ctrl_error(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM err);
-    static void handle_debug_msg(std::string msg);
-    static void handle_debug_connect(void);
-    static void handle_debug_disconnect(void);
+    static void handle_debug_msg(uint32 client, const char *line, uint32 len);
+    static void handle_debug_connect(uint32 client);
+    static void handle_debug_disconnect(uint32 client);
     static void handle_debug_error(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM err);
-    boost::mutex          ctrl_mutex;
-    boost::mutex          debug_mutex;
-    FILE                 *pcap_fd;
-    libtools_socket_wrap *ctrl_socket;
-    libtools_socket_wrap *debug_socket;
-    int16                 ctrl_port;
-    int16                 debug_port;
-    static bool           ctrl_connected;
-    static bool           debug_connected;
+    std::map<uint32, LTE_FDD_ENB_DEBUG_SUB_STRUCT>  debug_subs;
+    boost::mutex                                    ctrl_mutex;
+    boost::mutex                                    debug_mutex;
+    FILE                                           *pcap_fd;
+    libtools_socket_wrap                           *ctrl_socket;
+    libtools_socket_wrap                           *debug_socket;
+    uint32                                          n_ctrl_clients;
+    uint32                                          debug_sub_type_mask;
+    uint32                                          debug_sub_level_mask;
+    int16                                           ctrl_port;
+    int16                                           debug_port;
+    static bool                                     ctrl_connected;
+    static bool                                     debug_connected;
 
     // Handlers
     LTE_FDD_ENB_ERROR_ENUM handle_write(std::string msg);
-    void handle_add_user(std::string msg);
+    void handle_add_user(uint32 client, std::string msg);
 
     // Get/Set
     bool get_shutdown(void);
@@ -348,12 +374,14 @@ private:
     ~LTE_fdd_enb_interface();
 
     // Handlers
-    void handle_read(std::string msg);
-    void handle_start(void);
-    void handle_stop(void);
-    void handle_help(void);
-    void handle_del_user(std::string msg);
-    void handle_print_users(void);
+    void handle_read(uint32 client, std::string msg);
+    void handle_start(uint32 client);
+    void handle_stop(uint32 client);
+    void handle_help(uint32 client);
+    void handle_del_user(uint32 client, std::string msg);
+    void handle_print_users(uint32 client);
+    void handle_attach_storm(uint32 client, std::string msg);
+    void handle_debug_subscribe(uint32 client, std::string msg);
 
     // Variables
     std::map<std::string, LTE_FDD_ENB_VAR_STRUCT> var_map;
@@ -369,6 +397,8 @@ private:
     LTE_FDD_ENB_ERROR_ENUM write_value(LTE_FDD_ENB_VAR_STRUCT *var, std::string value);
     LTE_FDD_ENB_ERROR_ENUM write_value(LTE_FDD_ENB_VAR_STRUCT *var, uint32 value);
     bool is_string_valid_as_number(std::string str, uint32 length, uint8 max_value);
+    void update_debug_sub_masks(void);
+    void send_debug_to_subs(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, std::string msg);
 };
 
 #endif /* __LTE_FDD_ENB_INTERFACE_H__ */
@@ -43,6 +43,7 @@
 #include "LTE_fdd_enb_interface.h"
 #include "LTE_fdd_enb_cnfg_db.h"
 #include "LTE_fdd_enb_msgq.h"
+#include "LTE_fdd_enb_worker_mgr.h"
 #include "LTE_fdd_enb_user.h"
 #include "liblte_mac.h"
 #include <boost/thread/mutex.hpp>
@@ -53,6 +54,12 @@
                               DEFINES
 *******************************************************************************/
 
+#define LTE_FDD_ENB_MAX_DL_HARQ_TX 4
+#define LTE_FDD_ENB_MAX_UL_HARQ_TX 4
+#define LTE_FDD_ENB_SR_GRANT_TBS   256
+
+// Smallest RLC PDU asked for when a bearer is near the end of its share
+#define LTE_FDD_ENB_MIN_DRB_PDU_BYTES 16
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -74,6 +81,9 @@ typedef struct{
     LIBLTE_PHY_ALLOCATION_STRUCT alloc;
     LIBLTE_MAC_PDU_STRUCT        mac_pdu;
     uint32                       current_tti;
+    bool                         harq_retx;
+    bool                         packed;
+    bool                         pull;
 }LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT;
 
 typedef struct{
@@ -97,7 +107,6 @@ public:
     void stop(void);
 
     // External interface
-    void update_sys_info(void);
     void sched_ul(LTE_fdd_enb_user *user, uint32 requested_tbs);
 
 private:
@@ -117,7 +126,7 @@ private:
     LTE_fdd_enb_msgq                   *phy_comm_msgq;
     LTE_fdd_enb_msgq                   *rlc_comm_msgq;
     boost::interprocess::message_queue *mac_phy_mq;
-    boost::interprocess::message_queue *mac_rlc_mq;
+    LTE_fdd_enb_worker_mgr             *worker_mgr;
 
     // PHY Message Handlers
     void handle_ready_to_send(LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT *rts);
@@ -138,6 +147,13 @@ private:
     void handle_ulsch_short_bsr(LTE_fdd_enb_user *user, LIBLTE_MAC_SHORT_BSR_CE_STRUCT *short_bsr);
     void handle_ulsch_long_bsr(LTE_fdd_enb_user *user, LIBLTE_MAC_LONG_BSR_CE_STRUCT *long_bsr);
 
+    // HARQ
+    void handle_dl_harq_feedback(LTE_fdd_enb_user *user, uint32 current_tti, bool ack);
+    void handle_ul_harq_result(LTE_fdd_enb_user *user, uint32 current_tti, bool crc_pass);
+    LTE_FDD_ENB_ERROR_ENUM start_dl_harq_proc(LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT *dl_sched, uint32 current_tti);
+    LTE_FDD_ENB_ERROR_ENUM start_ul_harq_proc(LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT *ul_sched, uint32 current_tti, LIBLTE_PHY_SOFT_BUFFER_STRUCT **soft_buffer);
+    LTE_FDD_ENB_ERROR_ENUM continue_ul_harq_proc(LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT *ul_sched, uint32 current_tti, LIBLTE_PHY_SOFT_BUFFER_STRUCT **soft_buffer);
+
     // Data Constructors
     void construct_random_access_response(uint8 preamble, uint16 timing_adv, uint32 current_tti);
 
@@ -146,23 +162,45 @@ private:
     LTE_FDD_ENB_ERROR_ENUM add_to_rar_sched_queue(uint32 current_tti, LIBLTE_PHY_ALLOCATION_STRUCT *dl_alloc, LIBLTE_PHY_ALLOCATION_STRUCT *ul_alloc, LIBLTE_MAC_RAR_STRUCT *rar);
     LTE_FDD_ENB_ERROR_ENUM add_to_dl_sched_queue(uint32 current_tti, LIBLTE_MAC_PDU_STRUCT *mac_pdu, LIBLTE_PHY_ALLOCATION_STRUCT *alloc);
     LTE_FDD_ENB_ERROR_ENUM add_to_ul_sched_queue(uint32 current_tti, LIBLTE_PHY_ALLOCATION_STRUCT *alloc);
+    LTE_FDD_ENB_ERROR_ENUM add_to_ul_retx_sched_queue(uint32 current_tti, LIBLTE_PHY_ALLOCATION_STRUCT *alloc);
+    boost::mutex                                   sched_mutex;
     boost::mutex                                   rar_sched_queue_mutex;
     boost::mutex                                   dl_sched_queue_mutex;
     boost::mutex                                   ul_sched_queue_mutex;
     std::list<LTE_FDD_ENB_RAR_SCHED_QUEUE_STRUCT*> rar_sched_queue;
     std::list<LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT*>  dl_sched_queue;
     std::list<LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT*>  ul_sched_queue;
+    std::list<LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT*>  ul_retx_sched_queue;
+    std::list<uint16>                              dl_pull_queue;
     LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT             sched_dl_subfr[10];
     LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT             sched_ul_subfr[10];
+    LIBLTE_MAC_PRB_MASK_STRUCT                     sched_dl_prb_mask[10];
+    LIBLTE_MAC_PRB_MASK_STRUCT                     sched_ul_prb_mask[10];
+    LIBLTE_MAC_SCHED_STRUCT                        sched_dl_policy;
+    LIBLTE_MAC_SCHED_STRUCT                        sched_ul_policy;
+    LIBLTE_MAC_SCHED_UE_STRUCT                     sched_ue[LIBLTE_MAC_SCHED_N_UE_MAX];
+    LIBLTE_MAC_SCHED_GRANT_STRUCT                  sched_grant[LIBLTE_MAC_SCHED_N_UE_MAX];
+    LTE_fdd_enb_user                              *sched_user[LIBLTE_MAC_SCHED_N_UE_MAX];
+    LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT             *sched_dl_cand[LIBLTE_MAC_SCHED_N_UE_MAX];
+    LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT             *sched_ul_cand[LIBLTE_MAC_SCHED_N_UE_MAX];
     uint8                                          sched_cur_dl_subfn;
     uint8                                          sched_cur_ul_subfn;
 
-    // Parameters
-    boost::mutex                sys_info_mutex;
-    LTE_FDD_ENB_SYS_INFO_STRUCT sys_info;
-
     // Helpers
-    uint32 get_n_reserved_prbs(uint32 current_tti);
+    uint32 get_n_sib_prbs(uint32 current_tti);
+    uint32 get_n_pucch_prbs(void);
+    void init_dl_prb_mask(uint8 subfn);
+    void init_ul_prb_mask(uint8 subfn);
+    void set_alloc_prbs(LIBLTE_PHY_ALLOCATION_STRUCT *alloc, LIBLTE_MAC_RB_ALLOC_STRUCT *rb_alloc);
+    void init_dl_alloc(LIBLTE_PHY_ALLOCATION_STRUCT *alloc, LTE_fdd_enb_user *user);
+    void pad_dl_mac_pdu(LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT *dl_sched);
+    void get_dl_rbs(LTE_fdd_enb_user *user, LTE_fdd_enb_rb **rb, uint32 *N_rb);
+    uint32 get_dl_buffer_state(LTE_fdd_enb_user *user);
+    uint32 get_dl_qos_state(LTE_fdd_enb_user *user, bool *gbr, float *qos_weight);
+    uint32 get_dl_rb_allowance(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    uint32 add_dl_rb_sdus(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb, uint32 N_bytes_limit, LIBLTE_MAC_PDU_STRUCT *mac_pdu, uint32 *N_bytes);
+    void build_dl_mac_pdu(LTE_fdd_enb_user *user, LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT *dl_sched);
+    LTE_FDD_ENB_PUCCH_SCHEDULE_STRUCT* get_pucch_sched(LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_subfr, uint16 rnti);
 };
 
 #endif /* __LTE_FDD_ENB_MAC_H__ */
@@ -47,6 +47,7 @@
 
 #include "LTE_fdd_enb_cnfg_db.h"
 #include "LTE_fdd_enb_msgq.h"
+#include "LTE_fdd_enb_worker_mgr.h"
 #include <boost/interprocess/ipc/message_queue.hpp>
 #include <boost/thread/mutex.hpp>
 
@@ -80,8 +81,9 @@ public:
     void start(void);
     void stop(void);
 
-    // External interface
-    void update_sys_info(void);
+    // Communication
+    void handle_rrc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
+    void handle_hss_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
 
 private:
     // Singleton
@@ -94,14 +96,15 @@ private:
     bool         started;
 
     // Communication
-    void handle_rrc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
-    LTE_fdd_enb_msgq                   *rrc_comm_msgq;
-    boost::interprocess::message_queue *mme_rrc_mq;
+    LTE_fdd_enb_worker_mgr *worker_mgr;
 
     // RRC Message Handlers
     void handle_nas_msg(LTE_FDD_ENB_MME_NAS_MSG_READY_MSG_STRUCT *nas_msg);
     void handle_rrc_cmd_resp(LTE_FDD_ENB_MME_RRC_CMD_RESP_MSG_STRUCT *rrc_cmd_resp);
 
+    // HSS Message Handlers
+    void handle_auth_vec_ready(LTE_FDD_ENB_MME_AUTH_VEC_READY_MSG_STRUCT *auth_vec_ready);
+
     // Message Parsers
     void parse_attach_complete(LIBLTE_BYTE_MSG_STRUCT *msg, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
     void parse_attach_request(LIBLTE_BYTE_MSG_STRUCT *msg, LTE_fdd_enb_user **user, LTE_fdd_enb_rb **rb);
@@ -131,14 +134,11 @@ private:
     void send_esm_information_request(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
     void send_rrc_command(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb, LTE_FDD_ENB_RRC_CMD_ENUM cmd);
 
-    // Parameters
-    boost::mutex                sys_info_mutex;
-    LTE_FDD_ENB_SYS_INFO_STRUCT sys_info;
-
     // Helpers
     uint32 get_next_ip_addr(void);
-    uint32 next_ip_addr;
-    uint32 dns_addr;
+    boost::mutex ip_addr_mutex;
+    uint32       next_ip_addr;
+    uint32       dns_addr;
 };
 
 #endif /* __LTE_FDD_ENB_MME_H__ */
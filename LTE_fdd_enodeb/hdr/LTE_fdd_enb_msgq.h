@@ -54,7 +54,8 @@
                               DEFINES
 *******************************************************************************/
 
-#define LTE_FDD_ENB_N_SIB_ALLOCS 7
+#define LTE_FDD_ENB_N_SIB_ALLOCS       7
+#define LTE_FDD_ENB_MAX_PUCCH_DECODES 20
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -105,6 +106,9 @@ typedef enum{
     LTE_FDD_ENB_MESSAGE_TYPE_MME_NAS_MSG_READY,
     LTE_FDD_ENB_MESSAGE_TYPE_MME_RRC_CMD_RESP,
 
+    // HSS -> MME Messages
+    LTE_FDD_ENB_MESSAGE_TYPE_MME_AUTH_VEC_READY,
+
     // GW -> PDCP Messages
     LTE_FDD_ENB_MESSAGE_TYPE_PDCP_DATA_SDU_READY,
 
@@ -130,6 +134,7 @@ static const char LTE_fdd_enb_message_type_text[LTE_FDD_ENB_MESSAGE_TYPE_N_ITEMS
                                                                                           "RRC command ready",
                                                                                           "MME NAS message ready",
                                                                                           "MME RRC command response",
+                                                                                          "MME auth vec ready",
                                                                                           "PDCP data sdu ready",
                                                                                           "GW data ready"};
 
@@ -159,16 +164,22 @@ static const char LTE_fdd_enb_dest_layer_text[LTE_FDD_ENB_DEST_LAYER_N_ITEMS][10
 typedef struct{
     LIBLTE_PHY_PDCCH_STRUCT dl_allocations;
     LIBLTE_PHY_PDCCH_STRUCT ul_allocations;
-    uint32                  N_avail_prbs;
-    uint32                  N_sched_prbs;
     uint32                  current_tti;
 }LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT;
 typedef struct{
-    LIBLTE_PHY_PDCCH_STRUCT decodes;
-    uint32                  N_avail_prbs;
-    uint32                  N_sched_prbs;
-    uint32                  current_tti;
-    uint8                   next_prb;
+    uint32 n_1_pucch_sr;
+    uint32 n_2_pucch;
+    uint16 rnti;
+    bool   harq_ack;
+    bool   sr;
+    bool   cqi;
+}LTE_FDD_ENB_PUCCH_SCHEDULE_STRUCT;
+typedef struct{
+    LIBLTE_PHY_PDCCH_STRUCT            decodes;
+    LIBLTE_PHY_SOFT_BUFFER_STRUCT     *soft_buffer[LIBLTE_PHY_PDCCH_MAX_ALLOC];
+    LTE_FDD_ENB_PUCCH_SCHEDULE_STRUCT  pucch[LTE_FDD_ENB_MAX_PUCCH_DECODES];
+    uint32                             N_pucch;
+    uint32                             current_tti;
 }LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT;
 
 // PHY -> MAC Messages
@@ -184,11 +195,18 @@ typedef struct{
 }LTE_FDD_ENB_PRACH_DECODE_MSG_STRUCT;
 typedef struct{
     uint32 current_tti;
+    uint16 rnti;
+    uint8  cqi;
+    bool   harq_ack_present;
+    bool   harq_ack;
+    bool   sr_present;
+    bool   cqi_present;
 }LTE_FDD_ENB_PUCCH_DECODE_MSG_STRUCT;
 typedef struct{
     LIBLTE_BIT_MSG_STRUCT msg;
     uint32                current_tti;
     uint16                rnti;
+    bool                  crc_pass;
 }LTE_FDD_ENB_PUSCH_DECODE_MSG_STRUCT;
 
 // RLC -> MAC Messages
@@ -265,6 +283,14 @@ typedef struct{
     LTE_FDD_ENB_MME_RRC_CMD_RESP_ENUM  cmd_resp;
 }LTE_FDD_ENB_MME_RRC_CMD_RESP_MSG_STRUCT;
 
+// HSS -> MME Messages
+typedef struct{
+    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT auth_vec;
+    LTE_FDD_ENB_RB_ENUM                      rb_id;
+    uint32                                   user_gen;
+    uint16                                   c_rnti;
+}LTE_FDD_ENB_MME_AUTH_VEC_READY_MSG_STRUCT;
+
 // GW -> PDCP Messages
 typedef struct{
     LTE_fdd_enb_user *user;
@@ -316,6 +342,9 @@ typedef union{
     LTE_FDD_ENB_MME_NAS_MSG_READY_MSG_STRUCT mme_nas_msg_ready;
     LTE_FDD_ENB_MME_RRC_CMD_RESP_MSG_STRUCT  mme_rrc_cmd_resp;
 
+    // HSS -> MME Messages
+    LTE_FDD_ENB_MME_AUTH_VEC_READY_MSG_STRUCT mme_auth_vec_ready;
+
     // GW -> PDCP Messages
     LTE_FDD_ENB_PDCP_DATA_SDU_READY_MSG_STRUCT pdcp_data_sdu_ready;
 
@@ -324,9 +353,10 @@ typedef union{
 }LTE_FDD_ENB_MESSAGE_UNION;
 
 typedef struct{
-    LTE_FDD_ENB_MESSAGE_TYPE_ENUM type;
-    LTE_FDD_ENB_DEST_LAYER_ENUM   dest_layer;
-    LTE_FDD_ENB_MESSAGE_UNION     msg;
+    LTE_FDD_ENB_MESSAGE_TYPE_ENUM  type;
+    LTE_FDD_ENB_DEST_LAYER_ENUM    dest_layer;
+    LTE_fdd_enb_user              *user; // Selects the worker, NULL for messages outside the workers
+    LTE_FDD_ENB_MESSAGE_UNION      msg;
 }LTE_FDD_ENB_MESSAGE_STRUCT;
 
 /*******************************************************************************
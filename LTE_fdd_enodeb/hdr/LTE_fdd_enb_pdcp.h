@@ -39,6 +39,7 @@
 
 #include "LTE_fdd_enb_cnfg_db.h"
 #include "LTE_fdd_enb_msgq.h"
+#include "LTE_fdd_enb_worker_mgr.h"
 #include <boost/thread/mutex.hpp>
 #include <boost/interprocess/ipc/message_queue.hpp>
 
@@ -46,6 +47,8 @@
                               DEFINES
 *******************************************************************************/
 
+// Maximum number of data PDUs ciphered in one call
+#define LTE_FDD_ENB_PDCP_CIPHER_BATCH_SIZE 16
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -72,8 +75,10 @@ public:
     void start(void);
     void stop(void);
 
-    // External interface
-    void update_sys_info(void);
+    // Communication
+    void handle_rlc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
+    void handle_rrc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
+    void handle_gw_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
 
 private:
     // Singleton
@@ -86,14 +91,7 @@ private:
     bool         started;
 
     // Communication
-    void handle_rlc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
-    void handle_rrc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
-    void handle_gw_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
-    LTE_fdd_enb_msgq                   *rlc_comm_msgq;
-    LTE_fdd_enb_msgq                   *rrc_comm_msgq;
-    LTE_fdd_enb_msgq                   *gw_comm_msgq;
-    boost::interprocess::message_queue *pdcp_rlc_mq;
-    boost::interprocess::message_queue *pdcp_rrc_mq;
+    LTE_fdd_enb_worker_mgr             *worker_mgr;
     boost::interprocess::message_queue *pdcp_gw_mq;
 
     // RLC Message Handlers
@@ -105,9 +103,9 @@ private:
     // GW Message Handlers
     void handle_data_sdu_ready(LTE_FDD_ENB_PDCP_DATA_SDU_READY_MSG_STRUCT *data_sdu_ready);
 
-    // Parameters
-    boost::mutex                sys_info_mutex;
-    LTE_FDD_ENB_SYS_INFO_STRUCT sys_info;
+    // Helpers
+    void decipher_pdu(LTE_fdd_enb_rb *rb, LIBLTE_BYTE_MSG_STRUCT *pdu, uint32 N_sn_bits);
+    void send_rohc_feedback(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb, LIBLTE_BYTE_MSG_STRUCT *feedback);
 };
 
 #endif /* __LTE_FDD_ENB_PDCP_H__ */
@@ -0,0 +1,113 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_persist.h
+
+    Description: Contains all the definitions for the LTE FDD eNodeB
+                 write-behind file persistence.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_ENB_PERSIST_H__
+#define __LTE_FDD_ENB_PERSIST_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_interface.h"
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <stdio.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LTE_FDD_ENB_PERSIST_DELAY_M_SECONDS 100
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+// Persistence callback, writes the whole file and returns false on failure
+class LTE_fdd_enb_persist_cb
+{
+public:
+    typedef bool (*FuncType)(void*, FILE*);
+    LTE_fdd_enb_persist_cb();
+    LTE_fdd_enb_persist_cb(FuncType f, void* o);
+    bool operator()(FILE *file);
+private:
+    FuncType  func;
+    void     *obj;
+};
+template<class class_type, bool (class_type::*Func)(FILE*)>
+    bool LTE_fdd_enb_persist_cb_wrapper(void *o, FILE *file)
+{
+    return (static_cast<class_type*>(o)->*Func)(file);
+}
+
+// Changes only mark the file dirty.  A background thread waits for a
+// burst of changes to settle, then rewrites the file once into a
+// temporary file and renames it over the old one, so a crash leaves
+// either the old or the new contents and never a partial file.
+class LTE_fdd_enb_persist
+{
+public:
+    // Constructor/Destructor
+    LTE_fdd_enb_persist(std::string file_name, uint32 delay_m_seconds, LTE_fdd_enb_persist_cb cb);
+    ~LTE_fdd_enb_persist();
+
+    // External interface
+    void mark_dirty(void);
+    void flush(void);
+    void remove_file(void);
+
+private:
+    // Writer
+    static void* write_thread(void *inputs);
+    void write_file(void);
+    LTE_fdd_enb_persist_cb    cb;
+    boost::mutex              dirty_mutex;
+    boost::mutex              write_mutex;
+    boost::condition_variable dirty_cond;
+    std::string               file_name;
+    std::string               tmp_file_name;
+    pthread_t                 thread;
+    uint32                    delay_m_seconds;
+    bool                      dirty;
+    bool                      not_done;
+};
+
+#endif /* __LTE_FDD_ENB_PERSIST_H__ */
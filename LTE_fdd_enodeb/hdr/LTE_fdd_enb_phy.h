@@ -78,7 +78,6 @@ public:
     void stop(void);
 
     // External interface
-    void update_sys_info(void);
     uint32 get_n_cce(void);
 
     // Radio interface
@@ -107,27 +106,34 @@ private:
     void handle_dl_schedule(LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_sched);
     void handle_ul_schedule(LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_sched);
     void process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf);
-    boost::mutex                       sys_info_mutex;
     boost::mutex                       dl_sched_mutex;
     boost::mutex                       ul_sched_mutex;
-    LTE_FDD_ENB_SYS_INFO_STRUCT        sys_info;
     LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT dl_schedule[10];
     LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT ul_schedule[10];
     LIBLTE_PHY_PCFICH_STRUCT           pcfich;
     LIBLTE_PHY_PHICH_STRUCT            phich[10];
     LIBLTE_PHY_PDCCH_STRUCT            pdcch;
     LIBLTE_PHY_SUBFRAME_STRUCT         dl_subframe;
+    uint16                             dl_ack_rnti[10][LIBLTE_PHY_PDCCH_MAX_ALLOC];
     LIBLTE_BIT_MSG_STRUCT              dl_rrc_msg;
+    uint32                             dl_ack_n_cce[10][LIBLTE_PHY_PDCCH_MAX_ALLOC];
+    uint32                             N_dl_ack[10];
     uint32                             dl_current_tti;
     uint32                             last_rts_current_tti;
+    uint32                             sys_info_version;
     bool                               late_subfr;
+    bool                               mib_pcap_sent;
+    bool                               sib1_pcap_sent;
+    bool                               sib_pcap_sent[4];
 
     // Uplink
     void process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf);
+    void decode_pucch(LTE_FDD_ENB_PUCCH_SCHEDULE_STRUCT *pucch_sched);
     LTE_FDD_ENB_PRACH_DECODE_MSG_STRUCT prach_decode;
     LTE_FDD_ENB_PUCCH_DECODE_MSG_STRUCT pucch_decode;
     LTE_FDD_ENB_PUSCH_DECODE_MSG_STRUCT pusch_decode;
     LIBLTE_PHY_SUBFRAME_STRUCT          ul_subframe;
+    LIBLTE_PHY_PUCCH_STRUCT             pucch;
     uint32                              ul_current_tti;
     uint32                              prach_sfn_mod;
     uint32                              prach_subfn_mod;
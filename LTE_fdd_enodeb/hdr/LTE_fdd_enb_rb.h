@@ -48,14 +48,35 @@
 *******************************************************************************/
 
 #include "LTE_fdd_enb_interface.h"
+#include "liblte_qos.h"
 #include "liblte_rlc.h"
+#include "liblte_rohc.h"
 #include "liblte_rrc.h"
+#include "liblte_security.h"
 #include <list>
+#include <vector>
 
 /*******************************************************************************
                               DEFINES
 *******************************************************************************/
 
+// RLC windows are indexed by the full 10 bit SN space
+#define LTE_FDD_ENB_RLC_SN_MOD       1024
+#define LTE_FDD_ENB_RLC_SN_MASK      (LTE_FDD_ENB_RLC_SN_MOD - 1)
+#define LTE_FDD_ENB_RLC_RX_MAP_WORDS (LTE_FDD_ENB_RLC_SN_MOD/32)
+
+// ROHC is configured with the default maxCID and the RTP, UDP, and ESP profiles
+#define LTE_FDD_ENB_ROHC_MAX_CID  15
+#define LTE_FDD_ENB_ROHC_PROFILES ((1 << LIBLTE_ROHC_PROFILE_RTP) | \
+                                   (1 << LIBLTE_ROHC_PROFILE_UDP) | \
+                                   (1 << LIBLTE_ROHC_PROFILE_ESP))
+
+// QoS of the default and dedicated EPS bearers, bit rates use the
+// 24.301 encoding
+#define LTE_FDD_ENB_DEF_BEARER_QCI    9
+#define LTE_FDD_ENB_DED_BEARER_QCI    4
+#define LTE_FDD_ENB_DED_BEARER_MBR    0x68 // 384kbps
+#define LTE_FDD_ENB_DED_BEARER_GBR    0x48 // 128kbps
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -96,6 +117,7 @@ typedef enum{
     LTE_FDD_ENB_MME_STATE_ID_REQUEST_IMSI,
     LTE_FDD_ENB_MME_STATE_REJECT,
     LTE_FDD_ENB_MME_STATE_AUTHENTICATE,
+    LTE_FDD_ENB_MME_STATE_WAIT_FOR_AUTH_VEC,
     LTE_FDD_ENB_MME_STATE_AUTH_REJECTED,
     LTE_FDD_ENB_MME_STATE_ENABLE_SECURITY,
     LTE_FDD_ENB_MME_STATE_RELEASE,
@@ -110,6 +132,7 @@ static const char LTE_fdd_enb_mme_state_text[LTE_FDD_ENB_MME_STATE_N_ITEMS][100]
                                                                                     "ID REQUEST IMSI",
                                                                                     "REJECT",
                                                                                     "AUTHENTICATE",
+                                                                                    "WAIT FOR AUTH VEC",
                                                                                     "AUTH REJECTED",
                                                                                     "ENABLE SECURITY",
                                                                                     "RELEASE",
@@ -180,6 +203,15 @@ typedef struct{
     uint32 bytes_per_subfn;
 }LTE_FDD_ENB_QOS_STRUCT;
 
+// The window owns the received MAC SDU, the RLC data field starts at data_offset
+typedef struct{
+    LIBLTE_BYTE_MSG_STRUCT   *data;
+    LIBLTE_RLC_FI_FIELD_ENUM  fi;
+    uint32                    data_offset;
+    uint32                    N_li;
+    uint16                    li[LIBLTE_RLC_MAX_LI];
+}LTE_FDD_ENB_RLC_RX_PDU_STRUCT;
+
 /*******************************************************************************
                               CLASS DECLARATIONS
 *******************************************************************************/
@@ -242,14 +274,31 @@ public:
     void set_pdcp_rx_count(uint32 rx_count);
     uint32 get_pdcp_tx_count(void);
     void set_pdcp_tx_count(uint32 tx_count);
+    void set_pdcp_cipher(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM alg, uint8 *key_256);
+    LIBLTE_SECURITY_CIPHER_CTX_STRUCT* get_pdcp_cipher_ctx(uint8 direction);
+    void set_pdcp_integrity(uint8 *key_256);
+    LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT* get_pdcp_integrity_ctx(uint8 direction);
+    void set_pdcp_rohc(bool enable);
+    bool get_pdcp_rohc(void);
+    LIBLTE_ROHC_COMP_STRUCT* get_pdcp_rohc_comp(void);
+    LIBLTE_ROHC_DECOMP_STRUCT* get_pdcp_rohc_decomp(void);
 
     // RLC
     void queue_rlc_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu);
     LTE_FDD_ENB_ERROR_ENUM get_next_rlc_pdu(LIBLTE_BYTE_MSG_STRUCT **pdu);
     LTE_FDD_ENB_ERROR_ENUM delete_next_rlc_pdu(void);
+    LTE_FDD_ENB_ERROR_ENUM release_next_rlc_pdu(void);
     void queue_rlc_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu);
     LTE_FDD_ENB_ERROR_ENUM get_next_rlc_sdu(LIBLTE_BYTE_MSG_STRUCT **sdu);
     LTE_FDD_ENB_ERROR_ENUM delete_next_rlc_sdu(void);
+    bool queue_rlc_tx_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu);
+    LTE_FDD_ENB_ERROR_ENUM get_next_rlc_tx_sdu(LIBLTE_BYTE_MSG_STRUCT **sdu);
+    LTE_FDD_ENB_ERROR_ENUM delete_next_rlc_tx_sdu(void);
+    uint32 get_rlc_tx_queue_bytes(uint32 *N_sdus);
+    uint32 get_rlc_tx_N_drops(void);
+    uint32 get_rlc_tx_sdu_offset(void);
+    void set_rlc_tx_sdu_offset(uint32 offset);
+    boost::mutex* get_rlc_tx_mutex(void);
     LTE_FDD_ENB_RLC_CONFIG_ENUM get_rlc_config(void);
     uint16 get_rlc_vrr(void);
     void set_rlc_vrr(uint16 vrr);
@@ -257,7 +306,7 @@ public:
     uint16 get_rlc_vrmr(void);
     uint16 get_rlc_vrh(void);
     void set_rlc_vrh(uint16 vrh);
-    void rlc_add_to_am_reception_buffer(LIBLTE_RLC_AMD_PDU_STRUCT *amd_pdu);
+    bool rlc_add_to_am_reception_buffer(LIBLTE_RLC_AMD_PDU_STRUCT *amd_pdu, LIBLTE_BYTE_MSG_STRUCT *pdu);
     void rlc_get_am_reception_buffer_status(LIBLTE_RLC_STATUS_PDU_STRUCT *status);
     LTE_FDD_ENB_ERROR_ENUM rlc_am_reassemble(LIBLTE_BYTE_MSG_STRUCT *sdu);
     uint16 get_rlc_vta(void);
@@ -267,15 +316,14 @@ public:
     void set_rlc_vts(uint16 vts);
     void rlc_add_to_transmission_buffer(LIBLTE_RLC_AMD_PDU_STRUCT *amd_pdu);
     void rlc_update_transmission_buffer(uint32 ack_sn);
+    LIBLTE_RLC_AMD_PDU_STRUCT* rlc_get_transmission_buffer_pdu(uint16 sn);
     void rlc_start_t_poll_retransmit(void);
     void rlc_stop_t_poll_retransmit(void);
     void handle_t_poll_retransmit_timer_expiry(uint32 timer_id);
-    void set_rlc_vruh(uint16 vruh);
     uint16 get_rlc_vruh(void);
-    void set_rlc_vrur(uint16 vrur);
     uint16 get_rlc_vrur(void);
     uint16 get_rlc_um_window_size(void);
-    void rlc_add_to_um_reception_buffer(LIBLTE_RLC_UMD_PDU_STRUCT *umd_pdu);
+    bool rlc_add_to_um_reception_buffer(LIBLTE_RLC_UMD_PDU_STRUCT *umd_pdu, LIBLTE_BYTE_MSG_STRUCT *pdu);
     LTE_FDD_ENB_ERROR_ENUM rlc_um_reassemble(LIBLTE_BYTE_MSG_STRUCT *sdu);
     void set_rlc_vtus(uint16 vtus);
     uint16 get_rlc_vtus(void);
@@ -284,6 +332,7 @@ public:
     void queue_mac_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu);
     LTE_FDD_ENB_ERROR_ENUM get_next_mac_sdu(LIBLTE_BYTE_MSG_STRUCT **sdu);
     LTE_FDD_ENB_ERROR_ENUM delete_next_mac_sdu(void);
+    uint32 get_mac_sdu_queue_bytes(uint32 *N_sdus);
     LTE_FDD_ENB_MAC_CONFIG_ENUM get_mac_config(void);
     void start_ul_sched_timer(uint32 m_seconds);
     void stop_ul_sched_timer(void);
@@ -307,7 +356,11 @@ public:
     void set_qos(LTE_FDD_ENB_QOS_ENUM _qos);
     LTE_FDD_ENB_QOS_ENUM get_qos(void);
     uint32 get_qos_tti_freq(void);
-    uint32 get_qos_bytes_per_subfn(void);
+    void set_bearer_qos(uint8 _qci, uint32 gbr_kbps, uint32 mbr_kbps);
+    uint8 get_qci(void);
+    LIBLTE_QOS_QCI_STRUCT* get_qci_char(void);
+    LIBLTE_QOS_TOKEN_BUCKET_STRUCT* get_gbr_bucket(void);
+    LIBLTE_QOS_TOKEN_BUCKET_STRUCT* get_mbr_bucket(void);
 
 private:
     // Identity
@@ -319,14 +372,11 @@ private:
     std::list<LIBLTE_BYTE_MSG_STRUCT *> gw_data_msg_queue;
 
     // MME
-    boost::mutex                        mme_nas_msg_queue_mutex;
     std::list<LIBLTE_BYTE_MSG_STRUCT *> mme_nas_msg_queue;
     LTE_FDD_ENB_MME_PROC_ENUM           mme_procedure;
     LTE_FDD_ENB_MME_STATE_ENUM          mme_state;
 
     // RRC
-    boost::mutex                        rrc_pdu_queue_mutex;
-    boost::mutex                        rrc_nas_msg_queue_mutex;
     std::list<LIBLTE_BIT_MSG_STRUCT *>  rrc_pdu_queue;
     std::list<LIBLTE_BYTE_MSG_STRUCT *> rrc_nas_msg_queue;
     LTE_FDD_ENB_RRC_PROC_ENUM           rrc_procedure;
@@ -334,39 +384,55 @@ private:
     uint8                               rrc_transaction_id;
 
     // PDCP
-    boost::mutex                        pdcp_pdu_queue_mutex;
-    boost::mutex                        pdcp_sdu_queue_mutex;
-    boost::mutex                        pdcp_data_sdu_queue_mutex;
-    std::list<LIBLTE_BYTE_MSG_STRUCT *> pdcp_pdu_queue;
-    std::list<LIBLTE_BIT_MSG_STRUCT *>  pdcp_sdu_queue;
-    std::list<LIBLTE_BYTE_MSG_STRUCT *> pdcp_data_sdu_queue;
-    LTE_FDD_ENB_PDCP_CONFIG_ENUM        pdcp_config;
-    uint32                              pdcp_rx_count;
-    uint32                              pdcp_tx_count;
+    boost::mutex                         pdcp_data_sdu_queue_mutex;
+    std::list<LIBLTE_BYTE_MSG_STRUCT *>  pdcp_pdu_queue;
+    std::list<LIBLTE_BIT_MSG_STRUCT *>   pdcp_sdu_queue;
+    std::list<LIBLTE_BYTE_MSG_STRUCT *>  pdcp_data_sdu_queue;
+    LTE_FDD_ENB_PDCP_CONFIG_ENUM         pdcp_config;
+    uint32                               pdcp_rx_count;
+    uint32                               pdcp_tx_count;
+    LIBLTE_SECURITY_CIPHER_CTX_STRUCT    pdcp_ul_cipher;
+    LIBLTE_SECURITY_CIPHER_CTX_STRUCT    pdcp_dl_cipher;
+    LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT pdcp_ul_integrity;
+    LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT pdcp_dl_integrity;
+    LIBLTE_ROHC_COMP_STRUCT              pdcp_rohc_comp;
+    LIBLTE_ROHC_DECOMP_STRUCT            pdcp_rohc_decomp;
+    bool                                 pdcp_rohc;
 
     // RLC
     boost::mutex                                  rlc_pdu_queue_mutex;
-    boost::mutex                                  rlc_sdu_queue_mutex;
+    boost::mutex                                  rlc_tx_sdu_queue_mutex;
+    boost::mutex                                  rlc_tx_mutex;
     std::list<LIBLTE_BYTE_MSG_STRUCT *>           rlc_pdu_queue;
     std::list<LIBLTE_BYTE_MSG_STRUCT *>           rlc_sdu_queue;
-    std::map<uint16, LIBLTE_BYTE_MSG_STRUCT *>    rlc_am_reception_buffer;
-    std::map<uint16, LIBLTE_RLC_AMD_PDU_STRUCT *> rlc_am_transmission_buffer;
-    std::map<uint16, LIBLTE_BYTE_MSG_STRUCT *>    rlc_um_reception_buffer;
+    std::list<LIBLTE_BYTE_MSG_STRUCT *>           rlc_tx_sdu_queue;
+    std::list<uint64>                             rlc_tx_sdu_time_queue;
+    LTE_FDD_ENB_RLC_RX_PDU_STRUCT                 rlc_rx_window[LTE_FDD_ENB_RLC_SN_MOD];
+    LIBLTE_RLC_AMD_PDU_STRUCT                    *rlc_tx_window[LTE_FDD_ENB_RLC_SN_MOD];
+    std::vector<LIBLTE_RLC_AMD_PDU_STRUCT *>      rlc_tx_pool;
     LTE_FDD_ENB_RLC_CONFIG_ENUM                   rlc_config;
+    LIBLTE_QOS_CODEL_STRUCT                       rlc_tx_codel;
+    uint32                                        rlc_rx_map[LTE_FDD_ENB_RLC_RX_MAP_WORDS];
+    uint32                                        rlc_rx_N_ahead;
+    uint32                                        rlc_tx_window_N_pdus;
+    uint32                                        rlc_tx_sdu_offset;
+    uint32                                        rlc_tx_sdu_queue_bytes;
     uint16                                        rlc_vrr;
     uint16                                        rlc_vrmr;
     uint16                                        rlc_vrh;
-    uint16                                        rlc_first_am_segment_sn;
-    uint16                                        rlc_last_am_segment_sn;
     uint16                                        rlc_vta;
     uint16                                        rlc_vtms;
     uint16                                        rlc_vts;
     uint16                                        rlc_vruh;
-    uint16                                        rlc_vrur;
     uint16                                        rlc_um_window_size;
-    uint16                                        rlc_first_um_segment_sn;
-    uint16                                        rlc_last_um_segment_sn;
     uint16                                        rlc_vtus;
+    uint16                                        rlc_rx_next_sn;
+    uint16                                        rlc_rx_next_seg;
+    uint16                                        rlc_rx_sdu_sn;
+    uint16                                        rlc_rx_sdu_seg;
+    uint16                                        rlc_rx_release_sn;
+    bool                                          rlc_rx_sdu_started;
+    bool                                          rlc_tx_aqm;
 
     // MAC
     boost::mutex                        mac_sdu_queue_mutex;
@@ -384,6 +450,14 @@ private:
     uint8  drb_id;
     uint8  log_chan_group;
 
+    // RLC
+    bool rlc_rx_window_has(uint16 sn);
+    void rlc_add_to_rx_window(uint16 sn, LIBLTE_RLC_FI_FIELD_ENUM fi, uint32 N_li, uint16 *li, LIBLTE_BYTE_MSG_STRUCT *data, uint32 data_offset);
+    void rlc_release_rx_window(void);
+    void rlc_advance_rx_cursor(void);
+    uint32 rlc_get_rx_segment(uint16 sn, uint16 seg, uint8 **data);
+    LTE_FDD_ENB_ERROR_ENUM rlc_reassemble(LIBLTE_BYTE_MSG_STRUCT *sdu);
+
     // Generic
     void queue_msg(LIBLTE_BIT_MSG_STRUCT *msg, boost::mutex *mutex, std::list<LIBLTE_BIT_MSG_STRUCT *> *queue);
     void queue_msg(LIBLTE_BYTE_MSG_STRUCT *msg, boost::mutex *mutex, std::list<LIBLTE_BYTE_MSG_STRUCT *> *queue);
@@ -391,8 +465,13 @@ private:
     LTE_FDD_ENB_ERROR_ENUM get_next_msg(boost::mutex *mutex, std::list<LIBLTE_BYTE_MSG_STRUCT *> *queue, LIBLTE_BYTE_MSG_STRUCT **msg);
     LTE_FDD_ENB_ERROR_ENUM delete_next_msg(boost::mutex *mutex, std::list<LIBLTE_BIT_MSG_STRUCT *> *queue);
     LTE_FDD_ENB_ERROR_ENUM delete_next_msg(boost::mutex *mutex, std::list<LIBLTE_BYTE_MSG_STRUCT *> *queue);
-    LTE_FDD_ENB_QOS_STRUCT avail_qos[LTE_FDD_ENB_QOS_N_ITEMS];
-    LTE_FDD_ENB_QOS_ENUM   qos;
+    uint32 get_queue_bytes(boost::mutex *mutex, std::list<LIBLTE_BYTE_MSG_STRUCT *> *queue, uint32 *N_msgs);
+    LTE_FDD_ENB_QOS_STRUCT         avail_qos[LTE_FDD_ENB_QOS_N_ITEMS];
+    LTE_FDD_ENB_QOS_ENUM           qos;
+    LIBLTE_QOS_QCI_STRUCT          qci_char;
+    LIBLTE_QOS_TOKEN_BUCKET_STRUCT gbr_bucket;
+    LIBLTE_QOS_TOKEN_BUCKET_STRUCT mbr_bucket;
+    uint8                          qci;
 };
 
 #endif /* __LTE_FDD_ENB_RB_H__ */
@@ -41,6 +41,7 @@
 
 #include "LTE_fdd_enb_cnfg_db.h"
 #include "LTE_fdd_enb_msgq.h"
+#include "LTE_fdd_enb_worker_mgr.h"
 #include <boost/thread/mutex.hpp>
 #include <boost/interprocess/ipc/message_queue.hpp>
 
@@ -74,9 +75,14 @@ public:
     void start(void);
     void stop(void);
 
+    // Communication
+    void handle_mac_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
+    void handle_pdcp_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
+
     // External interface
-    void update_sys_info(void);
-    void handle_retransmit(LIBLTE_RLC_AMD_PDU_STRUCT *amd, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void handle_retransmit(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    uint32 get_buffer_state(LTE_fdd_enb_rb *rb);
+    LTE_FDD_ENB_ERROR_ENUM get_pdu(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb, uint32 N_bytes_max, LIBLTE_BYTE_MSG_STRUCT *pdu);
 
 private:
     // Singleton
@@ -89,33 +95,28 @@ private:
     bool         started;
 
     // Communication
-    void handle_mac_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
-    void handle_pdcp_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
-    LTE_fdd_enb_msgq                   *mac_comm_msgq;
-    LTE_fdd_enb_msgq                   *pdcp_comm_msgq;
+    LTE_fdd_enb_worker_mgr             *worker_mgr;
     boost::interprocess::message_queue *rlc_mac_mq;
-    boost::interprocess::message_queue *rlc_pdcp_mq;
 
     // MAC Message Handlers
     void handle_pdu_ready(LTE_FDD_ENB_RLC_PDU_READY_MSG_STRUCT *pdu_ready);
     void handle_tm_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
-    void handle_um_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
-    void handle_am_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    bool handle_um_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    bool handle_am_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
     void handle_status_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
 
     // PDCP Message Handlers
     void handle_sdu_ready(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT *sdu_ready);
     void handle_tm_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
-    void handle_um_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
-    void handle_am_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void handle_um_am_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
 
     // Message Constructors
     void send_status_pdu(LIBLTE_RLC_STATUS_PDU_STRUCT *status_pdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
-    void send_amd_pdu(LIBLTE_RLC_AMD_PDU_STRUCT *amd, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
-
-    // Parameters
-    boost::mutex                sys_info_mutex;
-    LTE_FDD_ENB_SYS_INFO_STRUCT sys_info;
+    void signal_mac(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    LTE_FDD_ENB_ERROR_ENUM build_umd_pdu(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb, uint32 N_bytes_max, LIBLTE_BYTE_MSG_STRUCT *pdu);
+    LTE_FDD_ENB_ERROR_ENUM build_amd_pdu(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb, uint32 N_bytes_max, LIBLTE_BYTE_MSG_STRUCT *pdu);
+    bool concatenate_sdus(LTE_fdd_enb_rb *rb, uint32 N_bytes_max, uint32 *N_li, uint16 *li, LIBLTE_RLC_FI_FIELD_ENUM *fi, LIBLTE_BYTE_MSG_STRUCT *data);
+    bool am_tx_window_open(LTE_fdd_enb_rb *rb);
 };
 
 #endif /* __LTE_FDD_ENB_RLC_H__ */
@@ -48,6 +48,7 @@
 #include "LTE_fdd_enb_cnfg_db.h"
 #include "LTE_fdd_enb_user.h"
 #include "LTE_fdd_enb_msgq.h"
+#include "LTE_fdd_enb_worker_mgr.h"
 #include <boost/thread/mutex.hpp>
 #include <boost/interprocess/ipc/message_queue.hpp>
 
@@ -81,8 +82,9 @@ public:
     void start(void);
     void stop(void);
 
-    // External interface
-    void update_sys_info(void);
+    // Communication
+    void handle_pdcp_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
+    void handle_mme_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
 
 private:
     // Singleton
@@ -95,12 +97,7 @@ private:
     bool         started;
 
     // Communication
-    void handle_pdcp_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
-    void handle_mme_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
-    LTE_fdd_enb_msgq                   *pdcp_comm_msgq;
-    LTE_fdd_enb_msgq                   *mme_comm_msgq;
-    boost::interprocess::message_queue *rrc_pdcp_mq;
-    boost::interprocess::message_queue *rrc_mme_mq;
+    LTE_fdd_enb_worker_mgr *worker_mgr;
 
     // PDCP Message Handlers
     void handle_pdu_ready(LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT *pdu_ready);
@@ -123,10 +120,6 @@ private:
     void send_rrc_con_release(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
     void send_rrc_con_setup(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
     void send_security_mode_command(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
-
-    // Parameters
-    boost::mutex                sys_info_mutex;
-    LTE_FDD_ENB_SYS_INFO_STRUCT sys_info;
 };
 
 #endif /* __LTE_FDD_ENB_RRC_H__ */
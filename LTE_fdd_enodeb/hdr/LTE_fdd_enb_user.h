@@ -47,6 +47,8 @@
 #include "LTE_fdd_enb_rb.h"
 #include "liblte_mac.h"
 #include "liblte_mme.h"
+#include "liblte_phy.h"
+#include "liblte_qos.h"
 #include "typedefs.h"
 #include <string>
 
@@ -54,6 +56,8 @@
                               DEFINES
 *******************************************************************************/
 
+#define LTE_FDD_ENB_N_HARQ_PROCS             8
+#define LTE_FDD_ENB_DL_HARQ_FEEDBACK_TIMEOUT 8 // TTIs without feedback before a DL process is treated as ACKed
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -77,12 +81,40 @@ typedef struct{
     uint8  ck[16];
     uint8  ik[16];
     uint8  autn[16];
+    uint8  k_asme[32];
     uint8  k_nas_enc[32];
     uint8  k_nas_int[32];
+    uint8  k_enb[32];
     uint8  k_rrc_enc[32];
     uint8  k_rrc_int[32];
+    uint8  k_up_enc[32];
+    uint8  k_up_int[32];
 }LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT;
 
+typedef struct{
+    LIBLTE_PHY_ALLOCATION_STRUCT alloc;
+    uint32                       tx_tti;
+    uint32                       N_tx;
+    bool                         ndi;
+    bool                         active;
+}LTE_FDD_ENB_DL_HARQ_PROC_STRUCT;
+
+typedef struct{
+    LIBLTE_PHY_ALLOCATION_STRUCT  alloc;
+    LIBLTE_PHY_SOFT_BUFFER_STRUCT soft_buffer;
+    uint32                        tx_tti;
+    uint32                        N_tx;
+    bool                          ndi;
+    bool                          active;
+}LTE_FDD_ENB_UL_HARQ_PROC_STRUCT;
+
+typedef struct{
+    uint32 sr_cnfg_idx;
+    uint32 n_1_pucch_sr;
+    uint32 cqi_pmi_cnfg_idx;
+    uint32 n_2_pucch_cqi;
+}LTE_FDD_ENB_PUCCH_CNFG_STRUCT;
+
 /*******************************************************************************
                               CLASS DECLARATIONS
 *******************************************************************************/
@@ -106,6 +138,8 @@ public:
     bool is_guti_set(void);
     void set_temp_id(uint64 id);
     uint64 get_temp_id(void);
+    void set_gen(uint32 _gen);
+    uint32 get_gen(void);
     std::string get_imsi_str(void);
     uint64 get_imsi_num(void);
     std::string get_imei_str(void);
@@ -121,9 +155,13 @@ public:
     // Security
     void set_auth_vec(LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT *av);
     LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT* get_auth_vec(void);
+    void set_pending_auth_vec(LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT *av);
+    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT* get_pending_auth_vec(void);
     void increment_nas_count_dl(void);
     void increment_nas_count_ul(void);
     bool is_auth_vec_set(void);
+    void set_cipher_alg(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM alg);
+    LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM get_cipher_alg(void);
 
     // Capabilities
     void set_eea_support(uint8 eea, bool support);
@@ -170,21 +208,37 @@ public:
     LIBLTE_MME_PROTOCOL_CONFIG_OPTIONS_STRUCT* get_protocol_cnfg_opts(void);
 
     // MAC
-    bool get_dl_ndi(void);
-    void flip_dl_ndi(void);
-    bool get_ul_ndi(void);
-    void flip_ul_ndi(void);
+    LTE_FDD_ENB_DL_HARQ_PROC_STRUCT* get_dl_harq_proc(uint32 proc);
+    LTE_FDD_ENB_ERROR_ENUM get_free_dl_harq_proc(uint32 current_tti, uint32 *proc);
+    LTE_FDD_ENB_ERROR_ENUM find_dl_harq_proc(uint32 tx_tti, uint32 *proc);
+    void release_dl_harq_proc(uint32 proc);
+    LTE_FDD_ENB_UL_HARQ_PROC_STRUCT* get_ul_harq_proc(uint32 proc);
+    void release_ul_harq_proc(uint32 proc);
+    void set_pucch_cnfg(LTE_FDD_ENB_PUCCH_CNFG_STRUCT *cnfg);
+    LTE_FDD_ENB_PUCCH_CNFG_STRUCT* get_pucch_cnfg(void);
+    bool is_pucch_cnfg_set(void);
+    void set_dl_cqi(uint8 cqi);
+    uint8 get_dl_cqi(void);
+    LIBLTE_MAC_SCHED_UE_STRUCT* get_dl_sched_ue(void);
+    LIBLTE_MAC_SCHED_UE_STRUCT* get_ul_sched_ue(void);
+    void set_dl_ambr(uint32 ambr_kbps);
+    LIBLTE_QOS_TOKEN_BUCKET_STRUCT* get_dl_ambr_bucket(void);
+    LIBLTE_QOS_DRR_STRUCT* get_dl_drr(void);
     LIBLTE_MAC_PDU_STRUCT pusch_mac_pdu;
 
     // Generic
     void set_delete_at_idle(bool dai);
     bool get_delete_at_idle(void);
+    void set_sim_ue(uint32 idx);
+    bool is_sim_ue(void);
+    uint32 get_sim_ue(void);
 
 private:
     // Identity
     LTE_FDD_ENB_USER_ID_STRUCT           id;
     LIBLTE_MME_EPS_MOBILE_ID_GUTI_STRUCT guti;
     uint64                               temp_id;
+    uint32                               gen;
     uint32                               c_rnti;
     uint32                               c_rnti_timer_id;
     uint32                               ip_addr;
@@ -194,8 +248,11 @@ private:
     bool                                 ip_addr_set;
 
     // Security
-    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT auth_vec;
-    bool                                     auth_vec_set;
+    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT    auth_vec;
+    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT    pending_auth_vec;
+    bool                                        auth_vec_set;
+    bool                                        pending_auth_vec_set;
+    LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM cipher_alg;
 
     // Capabilities
     bool eea_support[8];
@@ -223,12 +280,22 @@ private:
     bool                                      eit_flag;
 
     // MAC
-    bool dl_ndi;
-    bool ul_ndi;
+    LTE_FDD_ENB_DL_HARQ_PROC_STRUCT dl_harq_proc[LTE_FDD_ENB_N_HARQ_PROCS];
+    LTE_FDD_ENB_UL_HARQ_PROC_STRUCT ul_harq_proc[LTE_FDD_ENB_N_HARQ_PROCS];
+    LTE_FDD_ENB_PUCCH_CNFG_STRUCT   pucch_cnfg;
+    LIBLTE_MAC_SCHED_UE_STRUCT      dl_sched_ue;
+    LIBLTE_MAC_SCHED_UE_STRUCT      ul_sched_ue;
+    LIBLTE_QOS_TOKEN_BUCKET_STRUCT  dl_ambr_bucket;
+    LIBLTE_QOS_DRR_STRUCT           dl_drr;
+    uint8                           dl_cqi;
+    bool                            pucch_cnfg_set;
+    void init_harq_procs(void);
 
     // Generic
     void handle_timer_expiry(uint32 timer_id);
-    bool delete_at_idle;
+    uint32 sim_ue_idx;
+    bool   delete_at_idle;
+    bool   sim_ue;
 };
 
 #endif /* __LTE_FDD_ENB_USER_H__ */
@@ -43,6 +43,7 @@
 
 #include "LTE_fdd_enb_interface.h"
 #include "LTE_fdd_enb_user.h"
+#include "liblte_phy.h"
 #include <boost/thread/mutex.hpp>
 #include <string>
 
@@ -50,6 +51,7 @@
                               DEFINES
 *******************************************************************************/
 
+#define LTE_FDD_ENB_SOFT_BUFFER_POOL_SIZE (8*1024*1024)
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -84,10 +86,13 @@ public:
     LTE_FDD_ENB_ERROR_ENUM find_user(LIBLTE_MME_EPS_MOBILE_ID_GUTI_STRUCT *guti, LTE_fdd_enb_user **user);
     LTE_FDD_ENB_ERROR_ENUM find_user(LIBLTE_RRC_S_TMSI_STRUCT *s_tmsi, LTE_fdd_enb_user **user);
     LTE_FDD_ENB_ERROR_ENUM find_user(uint32 ip_addr, LTE_fdd_enb_user **user);
+    void get_pucch_users(std::list<LTE_fdd_enb_user*> *users);
     LTE_FDD_ENB_ERROR_ENUM del_user(LTE_fdd_enb_user *user);
     LTE_FDD_ENB_ERROR_ENUM del_user(std::string imsi);
     LTE_FDD_ENB_ERROR_ENUM del_user(uint16 c_rnti);
     LTE_FDD_ENB_ERROR_ENUM del_user(LIBLTE_MME_EPS_MOBILE_ID_GUTI_STRUCT *guti);
+    LTE_FDD_ENB_ERROR_ENUM alloc_soft_buffer(uint32 tbs, LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer);
+    void free_soft_buffer(LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer);
 
 private:
     // Singleton
@@ -107,7 +112,12 @@ private:
     boost::mutex                        c_rnti_mutex;
     boost::mutex                        timer_id_mutex;
     uint32                              next_m_tmsi;
+    uint32                              next_gen;
     uint16                              next_c_rnti;
+
+    // HARQ soft buffer storage
+    LIBLTE_PHY_SOFT_BUFFER_POOL_STRUCT *soft_buffer_pool;
+    boost::mutex                        soft_buffer_mutex;
 };
 
 #endif /* __LTE_FDD_ENB_USER_MGR_H__ */
@@ -0,0 +1,127 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_worker_mgr.h
+
+    Description: Contains all the definitions for the LTE FDD eNodeB
+                 protocol worker manager.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_ENB_WORKER_MGR_H__
+#define __LTE_FDD_ENB_WORKER_MGR_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_interface.h"
+#include "LTE_fdd_enb_msgq.h"
+#include <boost/thread/mutex.hpp>
+#include <boost/interprocess/ipc/message_queue.hpp>
+#include <list>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LTE_FDD_ENB_MAX_WORKERS         16
+#define LTE_FDD_ENB_DEFAULT_N_WORKERS   2
+#define LTE_FDD_ENB_WORKER_MSGQ_N_MSGS  1000
+#define LTE_FDD_ENB_WORKER_OVFL_N_MSGS  10000
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef struct{
+    boost::interprocess::message_queue      *mq;
+    std::list<LTE_FDD_ENB_MESSAGE_STRUCT *>  local_queue;
+    std::list<LTE_FDD_ENB_MESSAGE_STRUCT *>  ovfl_queue;
+    boost::mutex                             ovfl_mutex;
+    std::string                              mq_name;
+    pthread_t                                rx_thread;
+    uint32                                   N_drops;
+}LTE_FDD_ENB_WORKER_STRUCT;
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+// Users are spread over N workers by C-RNTI.  A worker runs the RLC,
+// PDCP, RRC, and MME handlers for all of its users, so each user's
+// protocol state is only ever touched by one thread.  Messages between
+// these layers for a user stay on the worker that produced them and
+// never go through a message queue.  Only MAC and the GW hand messages
+// across to a worker.  Sending never blocks, when a worker's message
+// queue is full messages wait in its overflow queue, and are dropped
+// once that is full too.
+class LTE_fdd_enb_worker_mgr
+{
+public:
+    // Singleton
+    static LTE_fdd_enb_worker_mgr* get_instance(void);
+    static void cleanup(void);
+
+    // Start/Stop
+    void start(void);
+    void stop(void);
+
+    // External interface
+    void send(LTE_fdd_enb_user              *user,
+              LTE_FDD_ENB_MESSAGE_TYPE_ENUM  type,
+              LTE_FDD_ENB_DEST_LAYER_ENUM    dest_layer,
+              LTE_FDD_ENB_MESSAGE_UNION     *msg_content,
+              uint32                         msg_content_size);
+    void send(uint16                         c_rnti,
+              LTE_FDD_ENB_MESSAGE_TYPE_ENUM  type,
+              LTE_FDD_ENB_DEST_LAYER_ENUM    dest_layer,
+              LTE_FDD_ENB_MESSAGE_UNION     *msg_content,
+              uint32                         msg_content_size);
+    uint32 get_worker(LTE_fdd_enb_user *user);
+
+private:
+    // Singleton
+    static LTE_fdd_enb_worker_mgr *instance;
+    LTE_fdd_enb_worker_mgr();
+    ~LTE_fdd_enb_worker_mgr();
+
+    // Start/Stop
+    boost::mutex start_mutex;
+    bool         started;
+
+    // Workers
+    static void* receive_thread(void *inputs);
+    void queue_msg(uint32 idx, LTE_fdd_enb_user *user, LTE_FDD_ENB_MESSAGE_TYPE_ENUM type, LTE_FDD_ENB_DEST_LAYER_ENUM dest_layer, LTE_FDD_ENB_MESSAGE_UNION *msg_content, uint32 msg_content_size);
+    void handle_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg);
+    LTE_FDD_ENB_WORKER_STRUCT worker[LTE_FDD_ENB_MAX_WORKERS];
+    pthread_key_t             worker_key;
+    uint32                    N_workers;
+};
+
+#endif /* __LTE_FDD_ENB_WORKER_MGR_H__ */
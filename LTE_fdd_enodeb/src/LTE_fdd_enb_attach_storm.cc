@@ -0,0 +1,527 @@
+#line 2 "LTE_fdd_enb_attach_storm.cc" // Make __FILE__ omit the path
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_attach_storm.cc
+
+    Description: Contains all the implementations for the LTE FDD eNodeB
+                 attach storm benchmark.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_attach_storm.h"
+#include "LTE_fdd_enb_hss.h"
+#include "LTE_fdd_enb_user_mgr.h"
+#include "LTE_fdd_enb_worker_mgr.h"
+#include "liblte_mme.h"
+#include <boost/thread/thread_time.hpp>
+#include <algorithm>
+#include <vector>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+LTE_fdd_enb_attach_storm* LTE_fdd_enb_attach_storm::instance = NULL;
+boost::mutex              attach_storm_instance_mutex;
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+/*******************/
+/*    Singleton    */
+/*******************/
+LTE_fdd_enb_attach_storm* LTE_fdd_enb_attach_storm::get_instance(void)
+{
+    boost::mutex::scoped_lock lock(attach_storm_instance_mutex);
+
+    if(NULL == instance)
+    {
+        instance = new LTE_fdd_enb_attach_storm();
+    }
+
+    return(instance);
+}
+void LTE_fdd_enb_attach_storm::cleanup(void)
+{
+    boost::mutex::scoped_lock lock(attach_storm_instance_mutex);
+
+    if(NULL != instance)
+    {
+        delete instance;
+        instance = NULL;
+    }
+}
+
+/********************************/
+/*    Constructor/Destructor    */
+/********************************/
+LTE_fdd_enb_attach_storm::LTE_fdd_enb_attach_storm()
+{
+    uint32 i;
+    uint8  k[16];
+
+    // Every simulated UE shares the same K
+    for(i=0; i<16; i++)
+    {
+        k[i] = i;
+    }
+    liblte_security_milenage_init(&milenage, k, NULL);
+
+    ue          = new LTE_FDD_ENB_ATTACH_STORM_UE_STRUCT[LTE_FDD_ENB_ATTACH_STORM_MAX_UES];
+    N_done      = 0;
+    N_attached  = 0;
+    N_run_ues   = 0;
+    run_started = false;
+    running     = false;
+}
+LTE_fdd_enb_attach_storm::~LTE_fdd_enb_attach_storm()
+{
+    if(run_started)
+    {
+        pthread_join(run_thread_id, NULL);
+    }
+    delete [] ue;
+}
+
+/****************************/
+/*    External Interface    */
+/****************************/
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_attach_storm::start(uint32 N_ues)
+{
+    boost::mutex::scoped_lock  lock(run_mutex);
+    LTE_fdd_enb_interface     *interface = LTE_fdd_enb_interface::get_instance();
+    LTE_FDD_ENB_ERROR_ENUM     err       = LTE_FDD_ENB_ERROR_NONE;
+
+    if(!interface->app_is_started())
+    {
+        err = LTE_FDD_ENB_ERROR_ALREADY_STOPPED;
+    }else if(0                                  == N_ues ||
+             LTE_FDD_ENB_ATTACH_STORM_MAX_UES <  N_ues){
+        err = LTE_FDD_ENB_ERROR_OUT_OF_BOUNDS;
+    }else if(running){
+        err = LTE_FDD_ENB_ERROR_ALREADY_STARTED;
+    }else{
+        // Reap the previous run
+        if(run_started)
+        {
+            pthread_join(run_thread_id, NULL);
+        }
+        N_run_ues   = N_ues;
+        run_started = true;
+        running     = true;
+        pthread_create(&run_thread_id, NULL, &run_thread, this);
+    }
+
+    return(err);
+}
+
+/*************/
+/*    Run    */
+/*************/
+void* LTE_fdd_enb_attach_storm::run_thread(void *inputs)
+{
+    LTE_fdd_enb_attach_storm *attach_storm = (LTE_fdd_enb_attach_storm *)inputs;
+    LTE_fdd_enb_interface    *interface    = LTE_fdd_enb_interface::get_instance();
+    std::string               report;
+
+    // Runs off the ctrl port's thread, so other commands are still served
+    attach_storm->run(attach_storm->N_run_ues, &report);
+    interface->send_ctrl_info_msg("attach_storm %s", report.c_str());
+
+    attach_storm->run_mutex.lock();
+    attach_storm->running = false;
+    attach_storm->run_mutex.unlock();
+
+    return(NULL);
+}
+void LTE_fdd_enb_attach_storm::run(uint32       N_ues,
+                                   std::string *report)
+{
+    boost::mutex::scoped_lock  done_lock(done_mutex);
+    LTE_fdd_enb_hss           *hss       = LTE_fdd_enb_hss::get_instance();
+    LTE_fdd_enb_user_mgr      *user_mgr  = LTE_fdd_enb_user_mgr::get_instance();
+    LTE_fdd_enb_user          *user;
+    LTE_fdd_enb_rb            *rb;
+    std::vector<uint32>        latency;
+    boost::system_time         deadline;
+    struct timeval             start;
+    struct timeval             end;
+    char                       imsi_str[16];
+    char                       imei_str[16];
+    char                       str[256];
+    double                     elapsed;
+    uint32                     N_sent    = 0;
+    uint32                     p50       = 0;
+    uint32                     p99       = 0;
+    uint32                     max       = 0;
+    uint32                     i;
+    bool                       timed_out = false;
+
+    for(i=0; i<N_ues; i++)
+    {
+        ue[i].subscriber_added = false;
+        ue[i].done             = false;
+        ue[i].attached         = false;
+    }
+    N_done     = 0;
+    N_attached = 0;
+    done_lock.unlock();
+
+    // Subscribers already configured with these IDs are used as they are
+    // and left alone afterwards
+    for(i=0; i<N_ues; i++)
+    {
+        snprintf(imsi_str, sizeof(imsi_str), "%015llu", LTE_FDD_ENB_ATTACH_STORM_IMSI_BASE + i);
+        snprintf(imei_str, sizeof(imei_str), "%015llu", LTE_FDD_ENB_ATTACH_STORM_IMEI_BASE + i);
+        ue[i].subscriber_added = (LTE_FDD_ENB_ERROR_NONE == hss->add_user(imsi_str, imei_str, LTE_FDD_ENB_ATTACH_STORM_K, false));
+    }
+
+    gettimeofday(&start, NULL);
+    deadline = boost::get_system_time() + boost::posix_time::seconds(LTE_FDD_ENB_ATTACH_STORM_TIMEOUT_S);
+    while(N_sent < N_ues &&
+          !timed_out)
+    {
+        // Keep a window of attaches in flight
+        done_lock.lock();
+        while(LTE_FDD_ENB_ATTACH_STORM_WINDOW <= N_sent - N_done &&
+              !timed_out)
+        {
+            timed_out = !done_cond.timed_wait(done_lock, deadline);
+        }
+        done_lock.unlock();
+
+        if(!timed_out)
+        {
+            gettimeofday(&ue[N_sent].start, NULL);
+            if(LTE_FDD_ENB_ERROR_NONE == user_mgr->add_user(&user))
+            {
+                user->set_sim_ue(N_sent);
+                user->setup_srb1(&rb);
+                send_attach_request(user, rb);
+            }else{
+                // Out of C-RNTIs, counts as a failed attach
+                done_lock.lock();
+                ue[N_sent].done = true;
+                N_done++;
+                done_lock.unlock();
+            }
+            N_sent++;
+        }
+    }
+
+    // Wait for the rest
+    done_lock.lock();
+    while(N_done < N_sent &&
+          !timed_out)
+    {
+        timed_out = !done_cond.timed_wait(done_lock, deadline);
+    }
+    gettimeofday(&end, NULL);
+    for(i=0; i<N_sent; i++)
+    {
+        if(ue[i].done && ue[i].attached)
+        {
+            latency.push_back(ue[i].latency_us);
+        }
+    }
+    done_lock.unlock();
+
+    // Remove the subscribers this run added
+    for(i=0; i<N_ues; i++)
+    {
+        if(ue[i].subscriber_added)
+        {
+            snprintf(imsi_str, sizeof(imsi_str), "%015llu", LTE_FDD_ENB_ATTACH_STORM_IMSI_BASE + i);
+            hss->del_user(imsi_str);
+        }
+    }
+
+    if(0 != latency.size())
+    {
+        std::sort(latency.begin(), latency.end());
+        p50 = latency[latency.size()/2];
+        p99 = latency[(latency.size()*99)/100];
+        max = latency[latency.size()-1];
+    }
+    elapsed = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec)/1000000.0;
+    snprintf(str,
+             sizeof(str),
+             "attached=%u/%u time=%.3fs rate=%.1f attaches/s latency p50=%uus p99=%uus max=%uus%s",
+             (uint32)latency.size(),
+             N_ues,
+             elapsed,
+             latency.size()/elapsed,
+             p50,
+             p99,
+             max,
+             timed_out ? " (timed out)" : "");
+    *report = str;
+}
+
+/***********************/
+/*    Communication    */
+/***********************/
+void LTE_fdd_enb_attach_storm::handle_mme_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
+{
+    LTE_fdd_enb_interface                   *interface  = LTE_fdd_enb_interface::get_instance();
+    LTE_fdd_enb_worker_mgr                  *worker_mgr = LTE_fdd_enb_worker_mgr::get_instance();
+    LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT    *cmd_ready  = &msg->msg.rrc_cmd_ready;
+    LTE_FDD_ENB_MME_RRC_CMD_RESP_MSG_STRUCT  cmd_resp;
+
+    switch(msg->type)
+    {
+    case LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY:
+        handle_nas_msg(msg->msg.rrc_nas_msg_ready.user, msg->msg.rrc_nas_msg_ready.rb);
+        break;
+    case LTE_FDD_ENB_MESSAGE_TYPE_RRC_CMD_READY:
+        switch(cmd_ready->cmd)
+        {
+        case LTE_FDD_ENB_RRC_CMD_RELEASE:
+            handle_release(cmd_ready->user);
+            break;
+        case LTE_FDD_ENB_RRC_CMD_SECURITY:
+            // There is no AS security to set up, answer right away
+            cmd_resp.user     = cmd_ready->user;
+            cmd_resp.rb       = cmd_ready->rb;
+            cmd_resp.cmd_resp = LTE_FDD_ENB_MME_RRC_CMD_RESP_SECURITY;
+            worker_mgr->send(cmd_resp.user,
+                             LTE_FDD_ENB_MESSAGE_TYPE_MME_RRC_CMD_RESP,
+                             LTE_FDD_ENB_DEST_LAYER_MME,
+                             (LTE_FDD_ENB_MESSAGE_UNION *)&cmd_resp,
+                             sizeof(LTE_FDD_ENB_MME_RRC_CMD_RESP_MSG_STRUCT));
+            break;
+        case LTE_FDD_ENB_RRC_CMD_SETUP_DEF_DRB:
+            // The attach accept rides along with the default bearer setup
+            handle_nas_msg(cmd_ready->user, cmd_ready->rb);
+            break;
+        default:
+            break;
+        }
+        break;
+    default:
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Received invalid simulated UE message %s",
+                                  LTE_fdd_enb_message_type_text[msg->type]);
+        break;
+    }
+
+    delete msg;
+}
+
+/***********************/
+/*    Simulated UEs    */
+/***********************/
+void LTE_fdd_enb_attach_storm::handle_nas_msg(LTE_fdd_enb_user *user,
+                                              LTE_fdd_enb_rb   *rb)
+{
+    LIBLTE_BYTE_MSG_STRUCT *msg;
+    uint8                   pd;
+    uint8                   msg_type;
+
+    if(LTE_FDD_ENB_ERROR_NONE == rb->get_next_rrc_nas_msg(&msg))
+    {
+        liblte_mme_parse_msg_header(msg, &pd, &msg_type);
+        switch(msg_type)
+        {
+        case LIBLTE_MME_MSG_TYPE_AUTHENTICATION_REQUEST:
+            send_authentication_response(user, rb, msg);
+            break;
+        case LIBLTE_MME_MSG_TYPE_SECURITY_MODE_COMMAND:
+            send_security_mode_complete(user, rb);
+            break;
+        case LIBLTE_MME_MSG_TYPE_ATTACH_ACCEPT:
+            send_attach_complete(user, rb);
+            break;
+        default:
+            // Rejects are followed by a release, which ends the attach
+            break;
+        }
+        rb->delete_next_rrc_nas_msg();
+    }
+}
+void LTE_fdd_enb_attach_storm::handle_release(LTE_fdd_enb_user *user)
+{
+    LTE_FDD_ENB_ATTACH_STORM_UE_STRUCT *sim = &ue[user->get_sim_ue()];
+    struct timeval                      now;
+
+    gettimeofday(&now, NULL);
+
+    done_mutex.lock();
+    if(!sim->done)
+    {
+        sim->latency_us = (now.tv_sec - sim->start.tv_sec)*1000000 + (now.tv_usec - sim->start.tv_usec);
+        sim->done       = true;
+        N_done++;
+        if(sim->attached)
+        {
+            N_attached++;
+        }
+        done_cond.notify_all();
+    }
+    done_mutex.unlock();
+}
+void LTE_fdd_enb_attach_storm::send_attach_request(LTE_fdd_enb_user *user,
+                                                   LTE_fdd_enb_rb   *rb)
+{
+    LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT           attach_req;
+    LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT pdn_con_req;
+    LIBLTE_BYTE_MSG_STRUCT                         msg;
+    uint64                                         imsi = LTE_FDD_ENB_ATTACH_STORM_IMSI_BASE + user->get_sim_ue();
+    uint32                                         i;
+
+    memset(&attach_req, 0, sizeof(attach_req));
+
+    pdn_con_req.eps_bearer_id                  = 0;
+    pdn_con_req.proc_transaction_id            = 1;
+    pdn_con_req.pdn_type                       = LIBLTE_MME_PDN_TYPE_IPV4;
+    pdn_con_req.request_type                   = LIBLTE_MME_REQUEST_TYPE_INITIAL_REQUEST;
+    pdn_con_req.esm_info_transfer_flag_present = false;
+    pdn_con_req.apn_present                    = false;
+    pdn_con_req.protocol_cnfg_opts_present     = false;
+    pdn_con_req.device_properties_present      = false;
+    liblte_mme_pack_pdn_connectivity_request_msg(&pdn_con_req, &attach_req.esm_msg);
+
+    attach_req.eps_attach_type          = LIBLTE_MME_EPS_ATTACH_TYPE_EPS_ATTACH;
+    attach_req.nas_ksi.tsc_flag         = LIBLTE_MME_TYPE_OF_SECURITY_CONTEXT_FLAG_NATIVE;
+    attach_req.nas_ksi.nas_ksi          = 7; // No key available
+    attach_req.eps_mobile_id.type_of_id = LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI;
+    for(i=0; i<15; i++)
+    {
+        attach_req.eps_mobile_id.imsi[14-i] = imsi % 10;
+        imsi                               /= 10;
+    }
+    attach_req.ue_network_cap.eea[0] = true;
+    attach_req.ue_network_cap.eea[1] = true;
+    attach_req.ue_network_cap.eea[2] = true;
+    attach_req.ue_network_cap.eia[1] = true;
+    attach_req.ue_network_cap.eia[2] = true;
+    liblte_mme_pack_attach_request_msg(&attach_req, &msg);
+
+    send_nas_msg(user, rb, &msg);
+}
+void LTE_fdd_enb_attach_storm::send_authentication_response(LTE_fdd_enb_user       *user,
+                                                            LTE_fdd_enb_rb         *rb,
+                                                            LIBLTE_BYTE_MSG_STRUCT *auth_req_msg)
+{
+    LIBLTE_MME_AUTHENTICATION_REQUEST_MSG_STRUCT  auth_req;
+    LIBLTE_MME_AUTHENTICATION_RESPONSE_MSG_STRUCT auth_resp;
+    LIBLTE_BYTE_MSG_STRUCT                        msg;
+    uint8                                         ck[16];
+    uint8                                         ik[16];
+    uint8                                         ak[6];
+
+    liblte_mme_unpack_authentication_request_msg(auth_req_msg, &auth_req);
+
+    // Run the UE side of Milenage on the challenge
+    memset(&auth_resp, 0, sizeof(auth_resp));
+    liblte_security_milenage_f2345(&milenage, auth_req.rand, auth_resp.res, ck, ik, ak);
+    liblte_mme_pack_authentication_response_msg(&auth_resp, &msg);
+
+    send_nas_msg(user, rb, &msg);
+}
+void LTE_fdd_enb_attach_storm::send_security_mode_complete(LTE_fdd_enb_user *user,
+                                                           LTE_fdd_enb_rb   *rb)
+{
+    LIBLTE_MME_SECURITY_MODE_COMPLETE_MSG_STRUCT sec_mode_comp;
+    LIBLTE_BYTE_MSG_STRUCT                       msg;
+
+    // The MME's copy of the NAS keys stands in for the ones the UE would
+    // derive itself
+    sec_mode_comp.imeisv_present = false;
+    liblte_mme_pack_security_mode_complete_msg(&sec_mode_comp,
+                                               LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED_WITH_NEW_EPS_SECURITY_CONTEXT,
+                                               user->get_auth_vec()->k_nas_int,
+                                               user->get_auth_vec()->nas_count_ul,
+                                               LIBLTE_SECURITY_DIRECTION_UPLINK,
+                                               rb->get_rb_id()-1,
+                                               &msg);
+
+    send_nas_msg(user, rb, &msg);
+}
+void LTE_fdd_enb_attach_storm::send_attach_complete(LTE_fdd_enb_user *user,
+                                                    LTE_fdd_enb_rb   *rb)
+{
+    LIBLTE_MME_ATTACH_COMPLETE_MSG_STRUCT                            attach_comp;
+    LIBLTE_MME_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_ACCEPT_MSG_STRUCT act_def_eps_bearer_context_accept;
+    LIBLTE_BYTE_MSG_STRUCT                                           msg;
+
+    act_def_eps_bearer_context_accept.eps_bearer_id              = user->get_eps_bearer_id();
+    act_def_eps_bearer_context_accept.proc_transaction_id        = user->get_proc_transaction_id();
+    act_def_eps_bearer_context_accept.protocol_cnfg_opts_present = false;
+    liblte_mme_pack_activate_default_eps_bearer_context_accept_msg(&act_def_eps_bearer_context_accept,
+                                                                   &attach_comp.esm_msg);
+    liblte_mme_pack_attach_complete_msg(&attach_comp,
+                                        LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED,
+                                        user->get_auth_vec()->k_nas_int,
+                                        user->get_auth_vec()->nas_count_ul,
+                                        LIBLTE_SECURITY_DIRECTION_UPLINK,
+                                        rb->get_rb_id()-1,
+                                        &msg);
+
+    // Only the release that follows this ends a successful attach
+    ue[user->get_sim_ue()].attached = true;
+
+    send_nas_msg(user, rb, &msg);
+}
+void LTE_fdd_enb_attach_storm::send_nas_msg(LTE_fdd_enb_user       *user,
+                                            LTE_fdd_enb_rb         *rb,
+                                            LIBLTE_BYTE_MSG_STRUCT *nas_msg)
+{
+    LTE_fdd_enb_user_mgr                     *user_mgr   = LTE_fdd_enb_user_mgr::get_instance();
+    LTE_fdd_enb_worker_mgr                   *worker_mgr = LTE_fdd_enb_worker_mgr::get_instance();
+    LTE_FDD_ENB_MME_NAS_MSG_READY_MSG_STRUCT  nas_msg_ready;
+
+    // Uplink traffic keeps the C-RNTI reserved, as it does through MAC
+    user_mgr->reset_c_rnti_timer(user->get_c_rnti());
+
+    // Queue the NAS message for the MME
+    rb->queue_mme_nas_msg(nas_msg);
+
+    // Signal the MME
+    nas_msg_ready.user = user;
+    nas_msg_ready.rb   = rb;
+    worker_mgr->send(nas_msg_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_MME_NAS_MSG_READY,
+                     LTE_FDD_ENB_DEST_LAYER_MME,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
+                     sizeof(LTE_FDD_ENB_MME_NAS_MSG_READY_MSG_STRUCT));
+}
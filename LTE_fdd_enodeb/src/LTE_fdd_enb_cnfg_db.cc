@@ -52,10 +52,12 @@
 #include "LTE_fdd_enb_pdcp.h"
 #include "LTE_fdd_enb_rrc.h"
 #include "LTE_fdd_enb_mme.h"
+#include "LTE_fdd_enb_worker_mgr.h"
 #include "liblte_mac.h"
 #include "liblte_interface.h"
 #include <boost/thread/mutex.hpp>
 #include <boost/lexical_cast.hpp>
+#include <unistd.h>
 
 /*******************************************************************************
                               DEFINES
@@ -147,14 +149,32 @@ LTE_fdd_enb_cnfg_db::LTE_fdd_enb_cnfg_db()
     var_map_uint32[LTE_FDD_ENB_PARAM_DEBUG_TYPE]               = 0xFFFFFFFF;
     var_map_uint32[LTE_FDD_ENB_PARAM_DEBUG_LEVEL]              = 0xFFFFFFFF;
     var_map_int64[LTE_FDD_ENB_PARAM_ENABLE_PCAP]               = 0;
+    var_map_int64[LTE_FDD_ENB_PARAM_ENABLE_ROHC]               = 0;
+    var_map_int64[LTE_FDD_ENB_PARAM_UE_AMBR_DL]                = 0;
+    var_map_int64[LTE_FDD_ENB_PARAM_N_WORKERS]                 = LTE_FDD_ENB_DEFAULT_N_WORKERS;
     var_map_uint32[LTE_FDD_ENB_PARAM_IP_ADDR_START]            = 0xC0A80102;
     var_map_uint32[LTE_FDD_ENB_PARAM_DNS_ADDR]                 = 0xC0A80101;
     var_map_int64[LTE_FDD_ENB_PARAM_USE_CNFG_FILE]             = 0;
     var_map_int64[LTE_FDD_ENB_PARAM_USE_USER_FILE]             = 0;
     use_cnfg_file                                              = false;
+    cnfg_persist                                               = new LTE_fdd_enb_persist("/tmp/LTE_fdd_enodeb.cnfg_db",
+                                                                                         LTE_FDD_ENB_PERSIST_DELAY_M_SECONDS,
+                                                                                         LTE_fdd_enb_persist_cb(&LTE_fdd_enb_persist_cb_wrapper<LTE_fdd_enb_cnfg_db, &LTE_fdd_enb_cnfg_db::write_cnfg_file>, this));
+
+    // Configuration snapshots
+    memset(&sys_info, 0, sizeof(sys_info));
+    sys_info_version    = 0;
+    snapshot            = NULL;
+    snapshot_version    = 0;
+    snapshot_epoch      = 0;
+    snapshot_readers[0] = 0;
+    snapshot_readers[1] = 0;
+    publish_snapshot();
 }
 LTE_fdd_enb_cnfg_db::~LTE_fdd_enb_cnfg_db()
 {
+    delete cnfg_persist;
+    delete snapshot;
 }
 
 /*****************************/
@@ -163,26 +183,26 @@ LTE_fdd_enb_cnfg_db::~LTE_fdd_enb_cnfg_db()
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::set_param(LTE_FDD_ENB_PARAM_ENUM param,
                                                       int64                  value)
 {
-    LTE_fdd_enb_hss                                   *hss   = LTE_fdd_enb_hss::get_instance();
-    LTE_fdd_enb_radio                                 *radio = LTE_fdd_enb_radio::get_instance();
-    std::map<LTE_FDD_ENB_PARAM_ENUM, int64>::iterator  iter  = var_map_int64.find(param);
-    LTE_FDD_ENB_ERROR_ENUM                             err   = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+    LTE_fdd_enb_hss                                   *hss  = LTE_fdd_enb_hss::get_instance();
+    std::map<LTE_FDD_ENB_PARAM_ENUM, int64>::iterator  iter = var_map_int64.find(param);
+    LTE_FDD_ENB_ERROR_ENUM                             err  = LTE_FDD_ENB_ERROR_INVALID_PARAM;
 
     if(var_map_int64.end() != iter)
     {
         (*iter).second = value;
         err            = LTE_FDD_ENB_ERROR_NONE;
 
-        // Set any related parameters
+        // Set any related parameters, they are published together with
+        // the parameter itself
         if(LTE_FDD_ENB_PARAM_N_ID_CELL == param)
         {
-            set_param(LTE_FDD_ENB_PARAM_N_ID_2, value % 3);
-            set_param(LTE_FDD_ENB_PARAM_N_ID_1, (value - (value % 3))/3);
+            store_param(LTE_FDD_ENB_PARAM_N_ID_2, value % 3);
+            store_param(LTE_FDD_ENB_PARAM_N_ID_1, (value - (value % 3))/3);
+        }else if(LTE_FDD_ENB_PARAM_FREQ_BAND == param){
+            // A new band starts out on its first EARFCN
+            store_dl_earfcn((int64)liblte_interface_first_dl_earfcn[value]);
         }else if(LTE_FDD_ENB_PARAM_DL_EARFCN == param){
-            set_param(LTE_FDD_ENB_PARAM_UL_EARFCN, (int64)liblte_interface_get_corresponding_ul_earfcn(value));
-            set_param(LTE_FDD_ENB_PARAM_DL_CENTER_FREQ, (int64)liblte_interface_dl_earfcn_to_frequency(value));
-            set_param(LTE_FDD_ENB_PARAM_UL_CENTER_FREQ, (int64)liblte_interface_ul_earfcn_to_frequency(liblte_interface_get_corresponding_ul_earfcn(value)));
-            radio->set_earfcns(value, (int64)liblte_interface_get_corresponding_ul_earfcn(value));
+            store_dl_earfcn(value);
         }else if(LTE_FDD_ENB_PARAM_USE_CNFG_FILE == param){
             if(value)
             {
@@ -200,9 +220,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::set_param(LTE_FDD_ENB_PARAM_ENUM par
             }
         }
 
+        publish_snapshot();
+
         if(use_cnfg_file)
         {
-            write_cnfg_file();
+            cnfg_persist->mark_dirty();
         }
     }
 
@@ -219,40 +241,43 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::set_param(LTE_FDD_ENB_PARAM_ENUM par
         (*iter).second = value;
         err            = LTE_FDD_ENB_ERROR_NONE;
 
-        // Set any related parameters
+        // Set any related parameters, they are published together with
+        // the parameter itself
         if(LTE_FDD_ENB_PARAM_BANDWIDTH == param)
         {
             if(value == 20)
             {
-                set_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_20MHZ);
-                set_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_20MHZ);
-                set_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_100);
+                store_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_20MHZ);
+                store_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_20MHZ);
+                store_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_100);
             }else if(value == 15){
-                set_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_15MHZ);
-                set_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_15MHZ);
-                set_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_75);
+                store_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_15MHZ);
+                store_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_15MHZ);
+                store_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_75);
             }else if(value == 10){
-                set_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_10MHZ);
-                set_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_10MHZ);
-                set_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_50);
+                store_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_10MHZ);
+                store_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_10MHZ);
+                store_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_50);
             }else if(value == 5){
-                set_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_5MHZ);
-                set_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_5MHZ);
-                set_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_25);
+                store_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_5MHZ);
+                store_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_5MHZ);
+                store_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_25);
             }else if(value == 3){
-                set_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_3MHZ);
-                set_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_3MHZ);
-                set_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_15);
+                store_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_3MHZ);
+                store_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_3MHZ);
+                store_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_15);
             }else{
-                set_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_1_4MHZ);
-                set_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_1_4MHZ);
-                set_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_6);
+                store_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_1_4MHZ);
+                store_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_1_4MHZ);
+                store_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_6);
             }
         }
 
+        publish_snapshot();
+
         if(use_cnfg_file)
         {
-            write_cnfg_file();
+            cnfg_persist->mark_dirty();
         }
     }
 
@@ -285,9 +310,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::set_param(LTE_FDD_ENB_PARAM_ENUM par
         }
         err = LTE_FDD_ENB_ERROR_NONE;
 
+        publish_snapshot();
+
         if(use_cnfg_file)
         {
-            write_cnfg_file();
+            cnfg_persist->mark_dirty();
         }
     }
 
@@ -304,14 +331,37 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::set_param(LTE_FDD_ENB_PARAM_ENUM par
         (*iter).second = value;
         err            = LTE_FDD_ENB_ERROR_NONE;
 
+        publish_snapshot();
+
         if(use_cnfg_file)
         {
-            write_cnfg_file();
+            cnfg_persist->mark_dirty();
         }
     }
 
     return(err);
 }
+void LTE_fdd_enb_cnfg_db::store_param(LTE_FDD_ENB_PARAM_ENUM param,
+                                      int64                  value)
+{
+    std::map<LTE_FDD_ENB_PARAM_ENUM, int64>::iterator iter = var_map_int64.find(param);
+
+    if(var_map_int64.end() != iter)
+    {
+        (*iter).second = value;
+    }
+}
+void LTE_fdd_enb_cnfg_db::store_dl_earfcn(int64 dl_earfcn)
+{
+    LTE_fdd_enb_radio *radio     = LTE_fdd_enb_radio::get_instance();
+    int64              ul_earfcn = (int64)liblte_interface_get_corresponding_ul_earfcn(dl_earfcn);
+
+    store_param(LTE_FDD_ENB_PARAM_DL_EARFCN,      dl_earfcn);
+    store_param(LTE_FDD_ENB_PARAM_UL_EARFCN,      ul_earfcn);
+    store_param(LTE_FDD_ENB_PARAM_DL_CENTER_FREQ, (int64)liblte_interface_dl_earfcn_to_frequency(dl_earfcn));
+    store_param(LTE_FDD_ENB_PARAM_UL_CENTER_FREQ, (int64)liblte_interface_ul_earfcn_to_frequency(ul_earfcn));
+    radio->set_earfcns(dl_earfcn, ul_earfcn);
+}
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::get_param(LTE_FDD_ENB_PARAM_ENUM  param,
                                                       int64                  &value)
 {
@@ -402,12 +452,6 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::get_param(LTE_FDD_ENB_PARAM_ENUM  pa
 /******************************/
 void LTE_fdd_enb_cnfg_db::construct_sys_info(void)
 {
-    LTE_fdd_enb_phy                                    *phy  = LTE_fdd_enb_phy::get_instance();
-    LTE_fdd_enb_mac                                    *mac  = LTE_fdd_enb_mac::get_instance();
-    LTE_fdd_enb_rlc                                    *rlc  = LTE_fdd_enb_rlc::get_instance();
-    LTE_fdd_enb_pdcp                                   *pdcp = LTE_fdd_enb_pdcp::get_instance();
-    LTE_fdd_enb_rrc                                    *rrc  = LTE_fdd_enb_rrc::get_instance();
-    LTE_fdd_enb_mme                                    *mme  = LTE_fdd_enb_mme::get_instance();
     std::map<LTE_FDD_ENB_PARAM_ENUM, double>::iterator  double_iter;
     std::map<LTE_FDD_ENB_PARAM_ENUM, int64>::iterator   int64_iter;
     std::map<LTE_FDD_ENB_PARAM_ENUM, uint32>::iterator  uint32_iter;
@@ -619,9 +663,9 @@ void LTE_fdd_enb_cnfg_db::construct_sys_info(void)
     sys_info.sib2.rr_config_common_sib.pusch_cnfg.ul_rs.sequence_hopping_enabled               = false;
     sys_info.sib2.rr_config_common_sib.pusch_cnfg.ul_rs.cyclic_shift                           = 0;
     sys_info.sib2.rr_config_common_sib.pucch_cnfg.delta_pucch_shift                            = LIBLTE_RRC_DELTA_PUCCH_SHIFT_DS1;
-    sys_info.sib2.rr_config_common_sib.pucch_cnfg.n_rb_cqi                                     = 0;
+    sys_info.sib2.rr_config_common_sib.pucch_cnfg.n_rb_cqi                                     = 1;
     sys_info.sib2.rr_config_common_sib.pucch_cnfg.n_cs_an                                      = 0;
-    sys_info.sib2.rr_config_common_sib.pucch_cnfg.n1_pucch_an                                  = 0;
+    sys_info.sib2.rr_config_common_sib.pucch_cnfg.n1_pucch_an                                  = 4;
     sys_info.sib2.rr_config_common_sib.srs_ul_cnfg.present                                     = false;
     int64_iter                                                                                 = var_map_int64.find(LTE_FDD_ENB_PARAM_P0_NOMINAL_PUSCH);
     if(var_map_int64.end() != int64_iter)
@@ -898,25 +942,76 @@ void LTE_fdd_enb_cnfg_db::construct_sys_info(void)
     sys_info.si_win_len       = liblte_rrc_si_window_length_num[sys_info.sib1.si_window_length];
 
     // PCAP variables
-    sys_info.mib_pcap_sent       = false;
-    sys_info.sib1_pcap_sent      = false;
-    sys_info.sib_pcap_sent[0]    = false;
-    sys_info.sib_pcap_sent[1]    = false;
-    sys_info.sib_pcap_sent[2]    = false;
-    sys_info.sib_pcap_sent[3]    = false;
     sys_info.continuous_sib_pcap = false;
 
-    // Update all layers
-    phy->update_sys_info();
-    mac->update_sys_info();
-    rlc->update_sys_info();
-    pdcp->update_sys_info();
-    rrc->update_sys_info();
-    mme->update_sys_info();
+    // Make the new system information visible to all layers at once
+    sys_info_version++;
+    publish_snapshot();
+}
+
+/*********************************/
+/*    Configuration Snapshots    */
+/*********************************/
+const LTE_FDD_ENB_CNFG_SNAPSHOT_STRUCT* LTE_fdd_enb_cnfg_db::read_lock(uint32 *reader_idx)
+{
+    // Count the reader against the current epoch before looking at the
+    // snapshot, so a publish either sees the reader or the reader sees
+    // the new snapshot
+    *reader_idx = __atomic_load_n(&snapshot_epoch, __ATOMIC_SEQ_CST) & 1;
+    __atomic_fetch_add(&snapshot_readers[*reader_idx], 1, __ATOMIC_SEQ_CST);
+
+    return(__atomic_load_n(&snapshot, __ATOMIC_SEQ_CST));
 }
-void LTE_fdd_enb_cnfg_db::get_sys_info(LTE_FDD_ENB_SYS_INFO_STRUCT &_sys_info)
+void LTE_fdd_enb_cnfg_db::read_unlock(uint32 reader_idx)
 {
-    memcpy(&_sys_info, &sys_info, sizeof(sys_info));
+    __atomic_fetch_sub(&snapshot_readers[reader_idx], 1, __ATOMIC_SEQ_CST);
+}
+void LTE_fdd_enb_cnfg_db::publish_snapshot(void)
+{
+    boost::mutex::scoped_lock                           lock(snapshot_mutex);
+    std::map<LTE_FDD_ENB_PARAM_ENUM, double>::iterator  double_iter;
+    std::map<LTE_FDD_ENB_PARAM_ENUM, int64>::iterator   int64_iter;
+    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32>::iterator  uint32_iter;
+    LTE_FDD_ENB_CNFG_SNAPSHOT_STRUCT                   *new_snapshot = new LTE_FDD_ENB_CNFG_SNAPSHOT_STRUCT;
+    LTE_FDD_ENB_CNFG_SNAPSHOT_STRUCT                   *old_snapshot;
+
+    // Build the new snapshot
+    memset(new_snapshot, 0, sizeof(LTE_FDD_ENB_CNFG_SNAPSHOT_STRUCT));
+    memcpy(&new_snapshot->sys_info, &sys_info, sizeof(sys_info));
+    for(double_iter=var_map_double.begin(); double_iter!=var_map_double.end(); double_iter++)
+    {
+        new_snapshot->param_double[(*double_iter).first] = (*double_iter).second;
+    }
+    for(int64_iter=var_map_int64.begin(); int64_iter!=var_map_int64.end(); int64_iter++)
+    {
+        new_snapshot->param_int64[(*int64_iter).first] = (*int64_iter).second;
+    }
+    for(uint32_iter=var_map_uint32.begin(); uint32_iter!=var_map_uint32.end(); uint32_iter++)
+    {
+        new_snapshot->param_uint32[(*uint32_iter).first] = (*uint32_iter).second;
+    }
+    new_snapshot->version          = ++snapshot_version;
+    new_snapshot->sys_info_version = sys_info_version;
+
+    // Swap it in
+    old_snapshot = __atomic_exchange_n(&snapshot, new_snapshot, __ATOMIC_SEQ_CST);
+
+    // Wait out everyone who could still be looking at the old snapshot.
+    // Flipping twice catches readers that picked up the old epoch just
+    // before the first flip.
+    if(NULL != old_snapshot)
+    {
+        wait_for_readers(__atomic_fetch_add(&snapshot_epoch, 1, __ATOMIC_SEQ_CST) & 1);
+        wait_for_readers(__atomic_fetch_add(&snapshot_epoch, 1, __ATOMIC_SEQ_CST) & 1);
+        delete old_snapshot;
+    }
+}
+void LTE_fdd_enb_cnfg_db::wait_for_readers(uint32 reader_idx)
+{
+    while(0 != __atomic_load_n(&snapshot_readers[reader_idx], __ATOMIC_SEQ_CST))
+    {
+        usleep(100);
+    }
 }
 
 /*********************/
@@ -943,102 +1038,89 @@ void LTE_fdd_enb_cnfg_db::read_cnfg_file(void)
         fclose(cnfg_file);
     }
 }
-void LTE_fdd_enb_cnfg_db::write_cnfg_file(void)
+bool LTE_fdd_enb_cnfg_db::write_cnfg_file(FILE *cnfg_file)
 {
-    std::map<LTE_FDD_ENB_PARAM_ENUM, double>::iterator  iter_d;
-    std::map<LTE_FDD_ENB_PARAM_ENUM, int64>::iterator   iter_i64;
-    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32>::iterator  iter_u32;
-    FILE                                               *cnfg_file = NULL;
-    uint32                                              i;
-
-    cnfg_file = fopen("/tmp/LTE_fdd_enodeb.cnfg_db", "w");
-
-    if(NULL != cnfg_file)
+    LTE_fdd_enb_cnfg_reader cnfg;
+    uint32                  i;
+
+    // Runs on the persistence thread, so only look at the published
+    // snapshot and never at the parameter maps
+    fprintf(cnfg_file, "%s %f\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_BANDWIDTH], cnfg.cnfg->param_double[LTE_FDD_ENB_PARAM_BANDWIDTH]);
+    fprintf(cnfg_file, "%s %s\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_FREQ_BAND], liblte_interface_band_text[cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_FREQ_BAND]]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DL_EARFCN], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_DL_EARFCN]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_N_ANT], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_N_ANT]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_N_ID_CELL], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_N_ID_CELL]);
+    fprintf(cnfg_file, "%s %03X\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_MCC], cnfg.cnfg->param_uint32[LTE_FDD_ENB_PARAM_MCC] & 0xFFF);
+    if((cnfg.cnfg->param_uint32[LTE_FDD_ENB_PARAM_MNC] & 0xF00) == 0xF00)
     {
-        iter_d = var_map_double.find(LTE_FDD_ENB_PARAM_BANDWIDTH);
-        fprintf(cnfg_file, "%s %f\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_BANDWIDTH], (*iter_d).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_FREQ_BAND);
-        fprintf(cnfg_file, "%s %s\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_FREQ_BAND], liblte_interface_band_text[(*iter_i64).second]);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_DL_EARFCN);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DL_EARFCN], (*iter_i64).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_N_ANT);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_N_ANT], (*iter_i64).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_N_ID_CELL);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_N_ID_CELL], (*iter_i64).second);
-        iter_u32 = var_map_uint32.find(LTE_FDD_ENB_PARAM_MCC);
-        fprintf(cnfg_file, "%s %03X\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_MCC], (*iter_u32).second & 0xFFF);
-        iter_u32 = var_map_uint32.find(LTE_FDD_ENB_PARAM_MNC);
-        if(((*iter_u32).second & 0xF00) == 0xF00)
-        {
-            fprintf(cnfg_file, "%s %02X\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_MNC], (*iter_u32).second & 0xFF);
-        }else{
-            fprintf(cnfg_file, "%s %03X\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_MNC], (*iter_u32).second & 0xFFF);
-        }
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_CELL_ID);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_CELL_ID], (*iter_i64).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_TRACKING_AREA_CODE);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_TRACKING_AREA_CODE], (*iter_i64).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_Q_RX_LEV_MIN);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_Q_RX_LEV_MIN], (*iter_i64).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_P0_NOMINAL_PUSCH);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUSCH], (*iter_i64).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_P0_NOMINAL_PUCCH);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUCCH], (*iter_i64).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB3_PRESENT);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB3_PRESENT], (*iter_i64).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_Q_HYST);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_Q_HYST], (*iter_i64).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB4_PRESENT);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB4_PRESENT], (*iter_i64).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB5_PRESENT);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB5_PRESENT], (*iter_i64).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB6_PRESENT);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB6_PRESENT], (*iter_i64).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB7_PRESENT);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB7_PRESENT], (*iter_i64).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB8_PRESENT);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB8_PRESENT], (*iter_i64).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_SEARCH_WIN_SIZE);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SEARCH_WIN_SIZE], (*iter_i64).second);
-        iter_u32 = var_map_uint32.find(LTE_FDD_ENB_PARAM_DEBUG_TYPE);
-        fprintf(cnfg_file, "%s ", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_TYPE]);
-        for(i=0; i<32; i++)
+        fprintf(cnfg_file, "%s %02X\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_MNC], cnfg.cnfg->param_uint32[LTE_FDD_ENB_PARAM_MNC] & 0xFF);
+    }else{
+        fprintf(cnfg_file, "%s %03X\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_MNC], cnfg.cnfg->param_uint32[LTE_FDD_ENB_PARAM_MNC] & 0xFFF);
+    }
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_CELL_ID], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_CELL_ID]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_TRACKING_AREA_CODE], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_TRACKING_AREA_CODE]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_Q_RX_LEV_MIN], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_Q_RX_LEV_MIN]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUSCH], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUSCH]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUCCH], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUCCH]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB3_PRESENT], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_SIB3_PRESENT]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_Q_HYST], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_Q_HYST]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB4_PRESENT], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_SIB4_PRESENT]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB5_PRESENT], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_SIB5_PRESENT]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB6_PRESENT], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_SIB6_PRESENT]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB7_PRESENT], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_SIB7_PRESENT]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SIB8_PRESENT], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_SIB8_PRESENT]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SEARCH_WIN_SIZE], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_SEARCH_WIN_SIZE]);
+    fprintf(cnfg_file, "%s ", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_TYPE]);
+    for(i=0; i<32; i++)
+    {
+        if(i < LTE_FDD_ENB_DEBUG_TYPE_N_ITEMS)
         {
-            if(i < LTE_FDD_ENB_DEBUG_TYPE_N_ITEMS)
+            if(((cnfg.cnfg->param_uint32[LTE_FDD_ENB_PARAM_DEBUG_TYPE] >> i) & 0x01) == 0x01)
             {
-                if((((*iter_u32).second >> i) & 0x01) == 0x01)
-                {
-                    fprintf(cnfg_file, "%s ", LTE_fdd_enb_debug_type_text[i]);
-                }
+                fprintf(cnfg_file, "%s ", LTE_fdd_enb_debug_type_text[i]);
             }
         }
-        fprintf(cnfg_file, "\n");
-        iter_u32 = var_map_uint32.find(LTE_FDD_ENB_PARAM_DEBUG_LEVEL);
-        fprintf(cnfg_file, "%s ", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_LEVEL]);
-        for(i=0; i<32; i++)
+    }
+    fprintf(cnfg_file, "\n");
+    fprintf(cnfg_file, "%s ", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_LEVEL]);
+    for(i=0; i<32; i++)
+    {
+        if(i < LTE_FDD_ENB_DEBUG_LEVEL_N_ITEMS)
         {
-            if(i < LTE_FDD_ENB_DEBUG_LEVEL_N_ITEMS)
+            if(((cnfg.cnfg->param_uint32[LTE_FDD_ENB_PARAM_DEBUG_LEVEL] >> i) & 0x01) == 0x01)
             {
-                if((((*iter_u32).second >> i) & 0x01) == 0x01)
-                {
-                    fprintf(cnfg_file, "%s ", LTE_fdd_enb_debug_level_text[i]);
-                }
+                fprintf(cnfg_file, "%s ", LTE_fdd_enb_debug_level_text[i]);
             }
         }
-        fprintf(cnfg_file, "\n");
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_ENABLE_PCAP);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_ENABLE_PCAP], (*iter_i64).second);
-        iter_u32 = var_map_uint32.find(LTE_FDD_ENB_PARAM_IP_ADDR_START);
-        fprintf(cnfg_file, "%s %08X\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_IP_ADDR_START], (*iter_u32).second);
-        iter_u32 = var_map_uint32.find(LTE_FDD_ENB_PARAM_DNS_ADDR);
-        fprintf(cnfg_file, "%s %08X\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DNS_ADDR], (*iter_u32).second);
-        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_USE_USER_FILE);
-        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_USE_USER_FILE], (*iter_i64).second);
-
-        fclose(cnfg_file);
     }
+    fprintf(cnfg_file, "\n");
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_ENABLE_PCAP], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_ENABLE_PCAP]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_ENABLE_ROHC], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_ENABLE_ROHC]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_UE_AMBR_DL], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_UE_AMBR_DL]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_N_WORKERS], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_N_WORKERS]);
+    fprintf(cnfg_file, "%s %08X\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_IP_ADDR_START], cnfg.cnfg->param_uint32[LTE_FDD_ENB_PARAM_IP_ADDR_START]);
+    fprintf(cnfg_file, "%s %08X\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DNS_ADDR], cnfg.cnfg->param_uint32[LTE_FDD_ENB_PARAM_DNS_ADDR]);
+    fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_USE_USER_FILE], cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_USE_USER_FILE]);
+
+
+    return(0 == ferror(cnfg_file));
 }
 void LTE_fdd_enb_cnfg_db::delete_cnfg_file(void)
 {
-    remove("/tmp/LTE_fdd_enodeb.cnfg_db");
+    cnfg_persist->remove_file();
+}
+
+/*************************/
+/*    Snapshot Reader    */
+/*************************/
+LTE_fdd_enb_cnfg_reader::LTE_fdd_enb_cnfg_reader()
+{
+    // The database outlives every reader, skip get_instance() and its mutex
+    cnfg_db  = LTE_fdd_enb_cnfg_db::instance;
+    cnfg     = cnfg_db->read_lock(&reader_idx);
+    sys_info = &cnfg->sys_info;
+}
+LTE_fdd_enb_cnfg_reader::~LTE_fdd_enb_cnfg_reader()
+{
+    cnfg_db->read_unlock(reader_idx);
 }
@@ -187,8 +187,7 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_gw::start(char *err_str)
         // Setup PDCP communication
         pdcp_comm_msgq = new LTE_fdd_enb_msgq("pdcp_gw_mq",
                                               pdcp_cb);
-        gw_pdcp_mq     = new boost::interprocess::message_queue(boost::interprocess::open_only,
-                                                                "gw_pdcp_mq");
+        worker_mgr     = LTE_fdd_enb_worker_mgr::get_instance();
 
         // Setup a thread to receive packets from the TUN device
         pthread_create(&rx_thread, NULL, &receive_thread, this);
@@ -312,11 +311,11 @@ void* LTE_fdd_enb_gw::receive_thread(void *inputs)
 
                     // Send message to PDCP
                     pdcp_data_sdu.rb->queue_pdcp_data_sdu(&msg);
-                    LTE_fdd_enb_msgq::send(gw->gw_pdcp_mq,
-                                           LTE_FDD_ENB_MESSAGE_TYPE_PDCP_DATA_SDU_READY,
-                                           LTE_FDD_ENB_DEST_LAYER_PDCP,
-                                           (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_data_sdu,
-                                           sizeof(LTE_FDD_ENB_PDCP_DATA_SDU_READY_MSG_STRUCT));
+                    gw->worker_mgr->send(pdcp_data_sdu.user,
+                                         LTE_FDD_ENB_MESSAGE_TYPE_PDCP_DATA_SDU_READY,
+                                         LTE_FDD_ENB_DEST_LAYER_PDCP,
+                                         (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_data_sdu,
+                                         sizeof(LTE_FDD_ENB_PDCP_DATA_SDU_READY_MSG_STRUCT));
                 }
 
                 idx = 0;
@@ -41,8 +41,11 @@
 
 #include "LTE_fdd_enb_hss.h"
 #include "LTE_fdd_enb_cnfg_db.h"
+#include "LTE_fdd_enb_worker_mgr.h"
 #include "liblte_security.h"
 #include <boost/lexical_cast.hpp>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 /*******************************************************************************
                               DEFINES
@@ -95,11 +98,42 @@ void LTE_fdd_enb_hss::cleanup(void)
 /********************************/
 LTE_fdd_enb_hss::LTE_fdd_enb_hss()
 {
-    user_list.clear();
+    uint32 i;
+
+    imsi_map.clear();
+    imei_map.clear();
     use_user_file = false;
+    user_persist  = new LTE_fdd_enb_persist("/tmp/LTE_fdd_enodeb.user_db",
+                                            LTE_FDD_ENB_PERSIST_DELAY_M_SECONDS,
+                                            LTE_fdd_enb_persist_cb(&LTE_fdd_enb_persist_cb_wrapper<LTE_fdd_enb_hss, &LTE_fdd_enb_hss::write_user_file>, this));
+
+    // Authentication vectors
+    av_not_done = true;
+    for(i=0; i<LTE_FDD_ENB_HSS_N_AV_THREADS; i++)
+    {
+        pthread_create(&av_thread_id[i], NULL, &av_thread, this);
+    }
 }
 LTE_fdd_enb_hss::~LTE_fdd_enb_hss()
 {
+    boost::unordered_map<uint64, LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator iter;
+    uint32                                                                i;
+
+    av_mutex.lock();
+    av_not_done = false;
+    av_cond.notify_all();
+    av_mutex.unlock();
+    for(i=0; i<LTE_FDD_ENB_HSS_N_AV_THREADS; i++)
+    {
+        pthread_join(av_thread_id[i], NULL);
+    }
+
+    delete user_persist;
+
+    for(iter=imsi_map.begin(); iter!=imsi_map.end(); iter++)
+    {
+        delete (*iter).second;
+    }
 }
 
 /****************************/
@@ -107,15 +141,15 @@ LTE_fdd_enb_hss::~LTE_fdd_enb_hss()
 /****************************/
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::add_user(std::string imsi,
                                                  std::string imei,
-                                                 std::string k)
+                                                 std::string k,
+                                                 bool        persist)
 {
-    std::list<LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator  iter;
-    LTE_FDD_ENB_HSS_USER_STRUCT                        *new_user = new LTE_FDD_ENB_HSS_USER_STRUCT;
-    LTE_FDD_ENB_ERROR_ENUM                              err      = LTE_FDD_ENB_ERROR_BAD_ALLOC;
-    const char                                         *imsi_str = imsi.c_str();
-    const char                                         *imei_str = imei.c_str();
-    const char                                         *k_str    = k.c_str();
-    uint32                                              i;
+    LTE_FDD_ENB_HSS_USER_STRUCT *new_user = new LTE_FDD_ENB_HSS_USER_STRUCT;
+    LTE_FDD_ENB_ERROR_ENUM       err      = LTE_FDD_ENB_ERROR_BAD_ALLOC;
+    const char                  *imsi_str = imsi.c_str();
+    const char                  *imei_str = imei.c_str();
+    const char                  *k_str    = k.c_str();
+    uint32                       i;
 
     if(NULL != new_user      &&
        15   == imsi.length() &&
@@ -157,31 +191,32 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::add_user(std::string imsi,
             }
         }
 
+        liblte_security_milenage_init(&new_user->stored_data.milenage, new_user->stored_data.k, NULL);
         new_user->generated_data.sqn_he = 0;
         new_user->generated_data.seq_he = 0;
         new_user->generated_data.ind_he = 0;
+        new_user->N_pregen_av           = 0;
+        new_user->persist               = persist;
 
         user_mutex.lock();
-        err = LTE_FDD_ENB_ERROR_NONE;
-        for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+        if(imsi_map.end() != imsi_map.find(new_user->id.imsi) ||
+           imei_map.end() != imei_map.find(new_user->id.imei))
         {
-            if((*iter)->id.imsi == new_user->id.imsi ||
-               (*iter)->id.imei == new_user->id.imei)
-            {
-                err = LTE_FDD_ENB_ERROR_DUPLICATE_ENTRY;
-            }
-        }
-        if(LTE_FDD_ENB_ERROR_NONE == err)
-        {
-            user_list.push_back(new_user);
-        }else{
+            err = LTE_FDD_ENB_ERROR_DUPLICATE_ENTRY;
             delete new_user;
+        }else{
+            err                         = LTE_FDD_ENB_ERROR_NONE;
+            imsi_map[new_user->id.imsi] = new_user;
+            imei_map[new_user->id.imei] = new_user;
+            queue_av_refill(new_user, false);
         }
         user_mutex.unlock();
 
-        if(use_user_file)
+        if(LTE_FDD_ENB_ERROR_NONE == err &&
+           persist                       &&
+           use_user_file)
         {
-            write_user_file();
+            user_persist->mark_dirty();
         }
     }
 
@@ -189,26 +224,41 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::add_user(std::string imsi,
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::del_user(std::string imsi)
 {
-    boost::mutex::scoped_lock                           lock(user_mutex);
-    std::list<LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator  iter;
-    LTE_FDD_ENB_HSS_USER_STRUCT                        *user = NULL;
-    LTE_FDD_ENB_ERROR_ENUM                              err  = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
-
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    boost::unordered_map<uint64, LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator  iter;
+    LTE_FDD_ENB_HSS_USER_STRUCT                                           *user     = NULL;
+    LTE_FDD_ENB_ERROR_ENUM                                                 err      = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+    const char                                                            *imsi_str = imsi.c_str();
+    uint64                                                                 imsi_num = 0;
+    uint32                                                                 i;
+    bool                                                                   persist  = false;
+
+    if(15 == imsi.length())
     {
-        if(imsi == boost::lexical_cast<std::string>((*iter)->id.imsi))
+        for(i=0; i<15; i++)
+        {
+            imsi_num *= 10;
+            imsi_num += imsi_str[i] - '0';
+        }
+
+        // Taking the index exclusively waits out everyone using the user
+        user_mutex.lock();
+        iter = imsi_map.find(imsi_num);
+        if(imsi_map.end() != iter)
         {
-            user = (*iter);
-            user_list.erase(iter);
+            user    = (*iter).second;
+            persist = user->persist;
+            imsi_map.erase(iter);
+            imei_map.erase(user->id.imei);
             delete user;
             err = LTE_FDD_ENB_ERROR_NONE;
-            break;
         }
         user_mutex.unlock();
 
-        if(use_user_file)
+        if(LTE_FDD_ENB_ERROR_NONE == err &&
+           persist                       &&
+           use_user_file)
         {
-            write_user_file();
+            user_persist->mark_dirty();
         }
     }
 
@@ -216,29 +266,29 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::del_user(std::string imsi)
 }
 std::string LTE_fdd_enb_hss::print_all_users(void)
 {
-    boost::mutex::scoped_lock                          lock(user_mutex);
-    std::list<LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator iter;
-    std::string                                        output;
-    uint32                                             i;
-    uint32                                             hex_val;
-
-    output = boost::lexical_cast<std::string>(user_list.size());
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    boost::shared_lock<boost::shared_mutex>                               lock(user_mutex);
+    boost::unordered_map<uint64, LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator iter;
+    std::string                                                           output;
+    uint32                                                                i;
+    uint32                                                                hex_val;
+
+    output = boost::lexical_cast<std::string>(imsi_map.size());
+    for(iter=imsi_map.begin(); iter!=imsi_map.end(); iter++)
     {
         output += "\n";
-        output += "imsi=" + boost::lexical_cast<std::string>((*iter)->id.imsi);
-        output += " imei=" + boost::lexical_cast<std::string>((*iter)->id.imei);
+        output += "imsi=" + boost::lexical_cast<std::string>((*iter).second->id.imsi);
+        output += " imei=" + boost::lexical_cast<std::string>((*iter).second->id.imei);
         output += " k=";
         for(i=0; i<16; i++)
         {
-            hex_val = ((*iter)->stored_data.k[i] >> 4) & 0xF;
+            hex_val = ((*iter).second->stored_data.k[i] >> 4) & 0xF;
             if(hex_val < 0xA)
             {
                 output += (char)(hex_val + '0');
             }else{
                 output += (char)((hex_val-0xA) + 'A');
             }
-            hex_val = (*iter)->stored_data.k[i] & 0xF;
+            hex_val = (*iter).second->stored_data.k[i] & 0xF;
             if(hex_val < 0xA)
             {
                 output += (char)(hex_val + '0');
@@ -252,270 +302,417 @@ std::string LTE_fdd_enb_hss::print_all_users(void)
 }
 bool LTE_fdd_enb_hss::is_imsi_allowed(uint64 imsi)
 {
-    boost::mutex::scoped_lock                          lock(user_mutex);
-    std::list<LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator iter;
-    bool                                               ret = false;
+    boost::shared_lock<boost::shared_mutex> lock(user_mutex);
 
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
-    {
-        if(imsi == (*iter)->id.imsi)
-        {
-            ret = true;
-            break;
-        }
-    }
-
-    return(ret);
+    return(imsi_map.end() != imsi_map.find(imsi));
 }
 bool LTE_fdd_enb_hss::is_imei_allowed(uint64 imei)
 {
-    boost::mutex::scoped_lock                          lock(user_mutex);
-    std::list<LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator iter;
-    bool                                               ret = false;
+    boost::shared_lock<boost::shared_mutex> lock(user_mutex);
 
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
-    {
-        if(imei == (*iter)->id.imei)
-        {
-            ret = true;
-            break;
-        }
-    }
-
-    return(ret);
+    return(imei_map.end() != imei_map.find(imei));
 }
 LTE_FDD_ENB_USER_ID_STRUCT* LTE_fdd_enb_hss::get_user_id_from_imsi(uint64 imsi)
 {
-    boost::mutex::scoped_lock                           lock(user_mutex);
-    std::list<LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator  iter;
-    LTE_FDD_ENB_USER_ID_STRUCT                         *id = NULL;
+    boost::shared_lock<boost::shared_mutex>                                lock(user_mutex);
+    boost::unordered_map<uint64, LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator  iter = imsi_map.find(imsi);
+    LTE_FDD_ENB_USER_ID_STRUCT                                            *id   = NULL;
 
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    if(imsi_map.end() != iter)
     {
-        if(imsi == (*iter)->id.imsi)
-        {
-            id = &(*iter)->id;
-        }
+        id = &(*iter).second->id;
     }
 
     return(id);
 }
 LTE_FDD_ENB_USER_ID_STRUCT* LTE_fdd_enb_hss::get_user_id_from_imei(uint64 imei)
 {
-    boost::mutex::scoped_lock                           lock(user_mutex);
-    std::list<LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator  iter;
-    LTE_FDD_ENB_USER_ID_STRUCT                         *id = NULL;
+    boost::shared_lock<boost::shared_mutex>                                lock(user_mutex);
+    boost::unordered_map<uint64, LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator  iter = imei_map.find(imei);
+    LTE_FDD_ENB_USER_ID_STRUCT                                            *id   = NULL;
 
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    if(imei_map.end() != iter)
     {
-        if(imei == (*iter)->id.imei)
-        {
-            id = &(*iter)->id;
-        }
+        id = &(*iter).second->id;
     }
 
     return(id);
 }
-void LTE_fdd_enb_hss::generate_security_data(LTE_FDD_ENB_USER_ID_STRUCT *id,
-                                             uint16                      mcc,
-                                             uint16                      mnc)
+bool LTE_fdd_enb_hss::generate_security_data(LTE_FDD_ENB_USER_ID_STRUCT               *id,
+                                             uint16                                    mcc,
+                                             uint16                                    mnc,
+                                             LTE_fdd_enb_user                         *enb_user,
+                                             LTE_fdd_enb_rb                           *rb,
+                                             LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT *auth_vec)
 {
-    boost::mutex::scoped_lock                          lock(user_mutex);
-    std::list<LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator iter;
-    uint32                                             i;
-    uint32                                             rand_val;
-    uint8                                              sqn[6];
-    uint8                                              amf[2] = {0x80, 0x00}; // 3GPP 33.102 v10.0.0 Annex H
-
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    boost::shared_lock<boost::shared_mutex>  lock(user_mutex);
+    LTE_FDD_ENB_HSS_USER_STRUCT             *user  = find_user(id);
+    LTE_FDD_ENB_HSS_AV_REQ_STRUCT            av_req;
+    bool                                     ready = true;
+
+    if(NULL != user)
     {
-        if(id->imei == (*iter)->id.imei &&
-           id->imsi == (*iter)->id.imsi)
+        user->mutex.lock();
+        if(!use_pregen_av(user, mcc, mnc, auth_vec))
         {
-            // Generate sqn
-            // From 33.102 v10.0.0 section C.3.2
-            (*iter)->generated_data.seq_he = ((*iter)->generated_data.seq_he + 1) % LTE_FDD_ENB_SEQ_HE_MAX_VALUE;
-            (*iter)->generated_data.ind_he = ((*iter)->generated_data.ind_he + 1) % LTE_FDD_ENB_IND_HE_MAX_VALUE;
-            (*iter)->generated_data.sqn_he = ((*iter)->generated_data.seq_he << LTE_FDD_ENB_IND_HE_N_BITS) | (*iter)->generated_data.ind_he;
-            for(i=0; i<6; i++)
-            {
-                sqn[i] = ((*iter)->generated_data.sqn_he >> (5-i)*8) & 0xFF;
-            }
+            // Nothing ready for this serving network, vectors for any
+            // other one are of no use.  Hand the request to the pool
+            // instead of making the caller wait for Milenage.  The pool
+            // only gets the C-RNTI, the user may be gone by the time
+            // the vector is ready.
+            av_req.rb_id      = rb->get_rb_id();
+            av_req.user_gen   = enb_user->get_gen();
+            av_req.c_rnti     = enb_user->get_c_rnti();
+            av_req.mcc        = mcc;
+            av_req.mnc        = mnc;
+            user->N_pregen_av = 0;
+            user->av_req_list.push_back(av_req);
+            ready             = false;
+        }
+        user->mutex.unlock();
 
-            // Generate RAND
-            for(i=0; i<4; i++)
-            {
-                rand_val                                     = rand();
-                (*iter)->generated_data.auth_vec.rand[i*4+0] = rand_val & 0xFF;
-                (*iter)->generated_data.auth_vec.rand[i*4+1] = (rand_val >> 8) & 0xFF;
-                (*iter)->generated_data.auth_vec.rand[i*4+2] = (rand_val >> 16) & 0xFF;
-                (*iter)->generated_data.auth_vec.rand[i*4+3] = (rand_val >> 24) & 0xFF;
-            }
+        queue_av_refill(user, !ready);
+    }
 
-            // Generate MAC, RES, CK, IK, and AK
-            liblte_security_milenage_f1((*iter)->stored_data.k,
-                                        (*iter)->generated_data.auth_vec.rand,
-                                        sqn,
-                                        amf,
-                                        (*iter)->generated_data.mac);
-            liblte_security_milenage_f2345((*iter)->stored_data.k,
-                                           (*iter)->generated_data.auth_vec.rand,
-                                           (*iter)->generated_data.auth_vec.res,
-                                           (*iter)->generated_data.auth_vec.ck,
-                                           (*iter)->generated_data.auth_vec.ik,
-                                           (*iter)->generated_data.ak);
-
-            // Construct AUTN
-            for(i=0; i<6; i++)
-            {
-                (*iter)->generated_data.auth_vec.autn[i] = sqn[i] ^ (*iter)->generated_data.ak[i];
-            }
-            for(i=0; i<2; i++)
-            {
-                (*iter)->generated_data.auth_vec.autn[6+i] = amf[i];
-            }
-            for(i=0; i<8; i++)
+    return(ready);
+}
+void LTE_fdd_enb_hss::cancel_security_data(LTE_FDD_ENB_USER_ID_STRUCT *id,
+                                           uint32                      user_gen)
+{
+    boost::shared_lock<boost::shared_mutex>             lock(user_mutex);
+    LTE_FDD_ENB_HSS_USER_STRUCT                        *user = find_user(id);
+    std::list<LTE_FDD_ENB_HSS_AV_REQ_STRUCT>::iterator  iter;
+
+    if(NULL != user)
+    {
+        user->mutex.lock();
+        iter = user->av_req_list.begin();
+        while(iter != user->av_req_list.end())
+        {
+            if(user_gen == (*iter).user_gen)
             {
-                (*iter)->generated_data.auth_vec.autn[8+i] = (*iter)->generated_data.mac[i];
+                iter = user->av_req_list.erase(iter);
+            }else{
+                iter++;
             }
-
-            // Reset NAS counts
-            // 3GPP 33.401 v10.0.0 section 6.5
-            (*iter)->generated_data.auth_vec.nas_count_ul = 0;
-            (*iter)->generated_data.auth_vec.nas_count_dl = 0;
-
-            // Generate Kasme
-            liblte_security_generate_k_asme((*iter)->generated_data.auth_vec.ck,
-                                            (*iter)->generated_data.auth_vec.ik,
-                                            (*iter)->generated_data.ak,
-                                            sqn,
-                                            mcc,
-                                            mnc,
-                                            (*iter)->generated_data.k_asme);
-
-            // Generate K_nas_enc and K_nas_int
-            liblte_security_generate_k_nas((*iter)->generated_data.k_asme,
-                                           LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_EEA0,
-                                           LIBLTE_SECURITY_INTEGRITY_ALGORITHM_ID_128_EIA2,
-                                           (*iter)->generated_data.auth_vec.k_nas_enc,
-                                           (*iter)->generated_data.auth_vec.k_nas_int);
-
-            // Generate K_enb
-            liblte_security_generate_k_enb((*iter)->generated_data.k_asme,
-                                           (*iter)->generated_data.auth_vec.nas_count_ul,
-                                           (*iter)->generated_data.k_enb);
-
-            // Generate K_rrc_enc and K_rrc_int
-            liblte_security_generate_k_rrc((*iter)->generated_data.k_enb,
-                                           LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_EEA0,
-                                           LIBLTE_SECURITY_INTEGRITY_ALGORITHM_ID_128_EIA2,
-                                           (*iter)->generated_data.auth_vec.k_rrc_enc,
-                                           (*iter)->generated_data.auth_vec.k_rrc_int);
-
-            // Generate K_up_enc and K_up_int
-            liblte_security_generate_k_up((*iter)->generated_data.k_enb,
-                                          LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_EEA0,
-                                          LIBLTE_SECURITY_INTEGRITY_ALGORITHM_ID_128_EIA2,
-                                          (*iter)->generated_data.k_up_enc,
-                                          (*iter)->generated_data.k_up_int);
-
-            break;
         }
+        user->mutex.unlock();
     }
 }
 void LTE_fdd_enb_hss::security_resynch(LTE_FDD_ENB_USER_ID_STRUCT *id,
                                        uint16                      mcc,
                                        uint16                      mnc,
+                                       uint8                      *rand,
                                        uint8                      *auts)
 {
-    boost::mutex::scoped_lock                          lock(user_mutex);
-    std::list<LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator iter;
-    uint32                                             i;
-    uint8                                              sqn[6];
+    boost::shared_lock<boost::shared_mutex>  lock(user_mutex);
+    LTE_FDD_ENB_HSS_USER_STRUCT             *user = find_user(id);
+    uint32                                   i;
+    uint8                                    sqn[6];
+    uint8                                    ak[6];
 
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    if(NULL != user)
     {
-        if(id->imei == (*iter)->id.imei &&
-           id->imsi == (*iter)->id.imsi)
+        user->mutex.lock();
+
+        // Decode returned SQN and break into SEQ and IND, rand is the
+        // one sent in the rejected authentication request
+        liblte_security_milenage_f5_star(&user->stored_data.milenage,
+                                         rand,
+                                         ak);
+        user->generated_data.sqn_he = 0;
+        for(i=0; i<6; i++)
         {
-            // Decode returned SQN and break into SEQ and IND
-            liblte_security_milenage_f5_star((*iter)->stored_data.k,
-                                             (*iter)->generated_data.auth_vec.rand,
-                                             (*iter)->generated_data.ak);
-            (*iter)->generated_data.sqn_he = 0;
-            for(i=0; i<6; i++)
-            {
-                sqn[i]                          = auts[i] ^ (*iter)->generated_data.ak[i];
-                (*iter)->generated_data.sqn_he |= (uint64)sqn[i] << (5-i)*8;
-            }
-            (*iter)->generated_data.seq_he = (*iter)->generated_data.sqn_he >> LTE_FDD_ENB_IND_HE_N_BITS;
-            (*iter)->generated_data.ind_he = (*iter)->generated_data.sqn_he & LTE_FDD_ENB_IND_HE_MASK;
-            if((*iter)->generated_data.ind_he > 0)
+            sqn[i]                       = auts[i] ^ ak[i];
+            user->generated_data.sqn_he |= (uint64)sqn[i] << (5-i)*8;
+        }
+        user->generated_data.seq_he = user->generated_data.sqn_he >> LTE_FDD_ENB_IND_HE_N_BITS;
+        user->generated_data.ind_he = user->generated_data.sqn_he & LTE_FDD_ENB_IND_HE_MASK;
+        if(user->generated_data.ind_he > 0)
+        {
+            user->generated_data.ind_he--;
+        }
+
+        // Vectors generated from the old sequence number would be rejected
+        user->N_pregen_av = 0;
+        user->mutex.unlock();
+
+        queue_av_refill(user, false);
+    }
+}
+void LTE_fdd_enb_hss::regenerate_enb_security_data(LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT *auth_vec,
+                                                   uint32                                    nas_count_ul)
+{
+    // Only uses the caller's copy of the vector, so no lock is needed
+
+    // Generate K_enb
+    liblte_security_generate_k_enb(auth_vec->k_asme,
+                                   nas_count_ul,
+                                   auth_vec->k_enb);
+
+    // Generate K_rrc_enc and K_rrc_int
+    liblte_security_generate_k_rrc(auth_vec->k_enb,
+                                   LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_EEA0,
+                                   LIBLTE_SECURITY_INTEGRITY_ALGORITHM_ID_128_EIA2,
+                                   auth_vec->k_rrc_enc,
+                                   auth_vec->k_rrc_int);
+
+    // Generate K_up_enc and K_up_int
+    liblte_security_generate_k_up(auth_vec->k_enb,
+                                  LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_EEA0,
+                                  LIBLTE_SECURITY_INTEGRITY_ALGORITHM_ID_128_EIA2,
+                                  auth_vec->k_up_enc,
+                                  auth_vec->k_up_int);
+}
+
+/***********************/
+/*    Allowed Users    */
+/***********************/
+LTE_FDD_ENB_HSS_USER_STRUCT* LTE_fdd_enb_hss::find_user(LTE_FDD_ENB_USER_ID_STRUCT *id)
+{
+    boost::unordered_map<uint64, LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator  iter = imsi_map.find(id->imsi);
+    LTE_FDD_ENB_HSS_USER_STRUCT                                           *user = NULL;
+
+    // Caller holds user_mutex
+    if(imsi_map.end() != iter &&
+       id->imei       == (*iter).second->id.imei)
+    {
+        user = (*iter).second;
+    }
+
+    return(user);
+}
+
+/********************************/
+/*    Authentication Vectors    */
+/********************************/
+void* LTE_fdd_enb_hss::av_thread(void *inputs)
+{
+    LTE_fdd_enb_hss                                                       *hss        = (LTE_fdd_enb_hss *)inputs;
+    LTE_fdd_enb_cnfg_db                                                   *cnfg_db    = LTE_fdd_enb_cnfg_db::get_instance();
+    LTE_fdd_enb_worker_mgr                                                *worker_mgr = LTE_fdd_enb_worker_mgr::get_instance();
+    const LTE_FDD_ENB_CNFG_SNAPSHOT_STRUCT                                *cnfg;
+    boost::unordered_map<uint64, LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator  iter;
+    LTE_FDD_ENB_HSS_USER_STRUCT                                           *user;
+    LTE_FDD_ENB_PREGEN_AV_STRUCT                                           av;
+    LTE_FDD_ENB_HSS_AV_REQ_STRUCT                                          av_req;
+    LTE_FDD_ENB_MME_AUTH_VEC_READY_MSG_STRUCT                              auth_vec_ready;
+    boost::mutex::scoped_lock                                              lock(hss->av_mutex);
+    uint64                                                                 imsi;
+    uint32                                                                 reader_idx;
+    uint16                                                                 mcc;
+    uint16                                                                 mnc;
+    bool                                                                   refill;
+    bool                                                                   signal;
+
+    while(hss->av_not_done)
+    {
+        if(0 == hss->av_queue.size())
+        {
+            hss->av_cond.wait(lock);
+        }else{
+            imsi = hss->av_queue.front();
+            hss->av_queue.pop_front();
+            lock.unlock();
+
+            // Top the user's vectors up one at a time, so an attach for
+            // this user never waits for more than one to finish
+            refill = true;
+            while(refill)
             {
-                (*iter)->generated_data.ind_he--;
+                refill = false;
+                signal = false;
+                cnfg   = cnfg_db->read_lock(&reader_idx);
+                mcc    = cnfg->sys_info.mcc;
+                mnc    = cnfg->sys_info.mnc;
+                cnfg_db->read_unlock(reader_idx);
+
+                hss->user_mutex.lock_shared();
+                iter = hss->imsi_map.find(imsi);
+                if(hss->imsi_map.end() != iter)
+                {
+                    user = (*iter).second;
+                    user->mutex.lock();
+                    if(0 != user->av_req_list.size())
+                    {
+                        // An attach is waiting on this user, serve it
+                        // before topping up
+                        av_req = user->av_req_list.front();
+                        user->av_req_list.pop_front();
+                        if(!hss->use_pregen_av(user, av_req.mcc, av_req.mnc, &auth_vec_ready.auth_vec))
+                        {
+                            hss->generate_av(user, av_req.mcc, av_req.mnc, &av);
+                            memcpy(&auth_vec_ready.auth_vec, &av.auth_vec, sizeof(LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT));
+                        }
+                        auth_vec_ready.rb_id    = av_req.rb_id;
+                        auth_vec_ready.user_gen = av_req.user_gen;
+                        auth_vec_ready.c_rnti   = av_req.c_rnti;
+                        signal                  = true;
+                        refill                  = true;
+                    }else if(LTE_FDD_ENB_HSS_N_PREGEN_AV > user->N_pregen_av){
+                        hss->generate_av(user, mcc, mnc, &user->pregen_av[user->N_pregen_av]);
+                        user->N_pregen_av++;
+                        refill = (LTE_FDD_ENB_HSS_N_PREGEN_AV > user->N_pregen_av);
+                    }
+                    user->mutex.unlock();
+                }
+                hss->user_mutex.unlock_shared();
+
+                if(signal)
+                {
+                    worker_mgr->send(auth_vec_ready.c_rnti,
+                                     LTE_FDD_ENB_MESSAGE_TYPE_MME_AUTH_VEC_READY,
+                                     LTE_FDD_ENB_DEST_LAYER_MME,
+                                     (LTE_FDD_ENB_MESSAGE_UNION *)&auth_vec_ready,
+                                     sizeof(LTE_FDD_ENB_MME_AUTH_VEC_READY_MSG_STRUCT));
+                }
             }
 
-            break;
+            lock.lock();
         }
     }
+
+    return(NULL);
 }
-LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT* LTE_fdd_enb_hss::regenerate_enb_security_data(LTE_FDD_ENB_USER_ID_STRUCT *id,
-                                                                                        uint32                      nas_count_ul)
+void LTE_fdd_enb_hss::generate_av(LTE_FDD_ENB_HSS_USER_STRUCT  *user,
+                                  uint16                        mcc,
+                                  uint16                        mnc,
+                                  LTE_FDD_ENB_PREGEN_AV_STRUCT *av)
 {
-    boost::mutex::scoped_lock                           lock(user_mutex);
-    std::list<LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator  iter;
-    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT           *auth_vec = NULL;
+    uint32 i;
+    uint32 rand_val;
+    uint8  sqn[6];
+    uint8  amf[2] = {0x80, 0x00}; // 3GPP 33.102 v10.0.0 Annex H
+
+    // Caller holds the user's mutex
+    av->mcc = mcc;
+    av->mnc = mnc;
+
+    // Generate sqn
+    // From 33.102 v10.0.0 section C.3.2
+    user->generated_data.seq_he = (user->generated_data.seq_he + 1) % LTE_FDD_ENB_SEQ_HE_MAX_VALUE;
+    user->generated_data.ind_he = (user->generated_data.ind_he + 1) % LTE_FDD_ENB_IND_HE_MAX_VALUE;
+    user->generated_data.sqn_he = (user->generated_data.seq_he << LTE_FDD_ENB_IND_HE_N_BITS) | user->generated_data.ind_he;
+    for(i=0; i<6; i++)
+    {
+        sqn[i] = (user->generated_data.sqn_he >> (5-i)*8) & 0xFF;
+    }
 
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    // Generate RAND
+    for(i=0; i<4; i++)
     {
-        if(id->imei == (*iter)->id.imei &&
-           id->imsi == (*iter)->id.imsi)
-        {
-            // Generate K_enb
-            liblte_security_generate_k_enb((*iter)->generated_data.k_asme,
-                                           nas_count_ul,
-                                           (*iter)->generated_data.k_enb);
-
-            // Generate K_rrc_enc and K_rrc_int
-            liblte_security_generate_k_rrc((*iter)->generated_data.k_enb,
-                                           LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_EEA0,
-                                           LIBLTE_SECURITY_INTEGRITY_ALGORITHM_ID_128_EIA2,
-                                           (*iter)->generated_data.auth_vec.k_rrc_enc,
-                                           (*iter)->generated_data.auth_vec.k_rrc_int);
-
-            // Generate K_up_enc and K_up_int
-            liblte_security_generate_k_up((*iter)->generated_data.k_enb,
-                                          LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_EEA0,
-                                          LIBLTE_SECURITY_INTEGRITY_ALGORITHM_ID_128_EIA2,
-                                          (*iter)->generated_data.k_up_enc,
-                                          (*iter)->generated_data.k_up_int);
-
-            auth_vec = &(*iter)->generated_data.auth_vec;
-
-            break;
-        }
+        rand_val                 = rand();
+        av->auth_vec.rand[i*4+0] = rand_val & 0xFF;
+        av->auth_vec.rand[i*4+1] = (rand_val >> 8) & 0xFF;
+        av->auth_vec.rand[i*4+2] = (rand_val >> 16) & 0xFF;
+        av->auth_vec.rand[i*4+3] = (rand_val >> 24) & 0xFF;
+    }
+
+    // Generate MAC, RES, CK, IK, and AK
+    liblte_security_milenage_f1(&user->stored_data.milenage,
+                                av->auth_vec.rand,
+                                sqn,
+                                amf,
+                                av->mac);
+    liblte_security_milenage_f2345(&user->stored_data.milenage,
+                                   av->auth_vec.rand,
+                                   av->auth_vec.res,
+                                   av->auth_vec.ck,
+                                   av->auth_vec.ik,
+                                   av->ak);
+
+    // Construct AUTN
+    for(i=0; i<6; i++)
+    {
+        av->auth_vec.autn[i] = sqn[i] ^ av->ak[i];
+    }
+    for(i=0; i<2; i++)
+    {
+        av->auth_vec.autn[6+i] = amf[i];
+    }
+    for(i=0; i<8; i++)
+    {
+        av->auth_vec.autn[8+i] = av->mac[i];
     }
 
-    return(auth_vec);
+    // Reset NAS counts
+    // 3GPP 33.401 v10.0.0 section 6.5
+    av->auth_vec.nas_count_ul = 0;
+    av->auth_vec.nas_count_dl = 0;
+
+    // Generate Kasme
+    liblte_security_generate_k_asme(av->auth_vec.ck,
+                                    av->auth_vec.ik,
+                                    av->ak,
+                                    sqn,
+                                    mcc,
+                                    mnc,
+                                    av->auth_vec.k_asme);
+
+    // Generate K_nas_enc and K_nas_int
+    liblte_security_generate_k_nas(av->auth_vec.k_asme,
+                                   LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_EEA0,
+                                   LIBLTE_SECURITY_INTEGRITY_ALGORITHM_ID_128_EIA2,
+                                   av->auth_vec.k_nas_enc,
+                                   av->auth_vec.k_nas_int);
+
+    // Generate K_enb
+    liblte_security_generate_k_enb(av->auth_vec.k_asme,
+                                   av->auth_vec.nas_count_ul,
+                                   av->k_enb);
+    memcpy(av->auth_vec.k_enb, av->k_enb, 32);
+
+    // Generate K_rrc_enc and K_rrc_int
+    liblte_security_generate_k_rrc(av->k_enb,
+                                   LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_EEA0,
+                                   LIBLTE_SECURITY_INTEGRITY_ALGORITHM_ID_128_EIA2,
+                                   av->auth_vec.k_rrc_enc,
+                                   av->auth_vec.k_rrc_int);
+
+    // Generate K_up_enc and K_up_int
+    liblte_security_generate_k_up(av->k_enb,
+                                  LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_EEA0,
+                                  LIBLTE_SECURITY_INTEGRITY_ALGORITHM_ID_128_EIA2,
+                                  av->auth_vec.k_up_enc,
+                                  av->auth_vec.k_up_int);
 }
-LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT* LTE_fdd_enb_hss::get_auth_vec(LTE_FDD_ENB_USER_ID_STRUCT *id)
+bool LTE_fdd_enb_hss::use_pregen_av(LTE_FDD_ENB_HSS_USER_STRUCT              *user,
+                                    uint16                                    mcc,
+                                    uint16                                    mnc,
+                                    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT *auth_vec)
 {
-    boost::mutex::scoped_lock                           lock(user_mutex);
-    std::list<LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator  iter;
-    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT           *auth_vec = NULL;
+    uint32 i;
+    bool   found = false;
 
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    // Caller holds the user's mutex
+    if(0   <  user->N_pregen_av      &&
+       mcc == user->pregen_av[0].mcc &&
+       mnc == user->pregen_av[0].mnc)
     {
-        if(id->imei == (*iter)->id.imei &&
-           id->imsi == (*iter)->id.imsi)
+        // Use the oldest vector, it has the lowest sequence number
+        memcpy(auth_vec, &user->pregen_av[0].auth_vec, sizeof(LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT));
+        for(i=1; i<user->N_pregen_av; i++)
         {
-            auth_vec = &(*iter)->generated_data.auth_vec;
-
-            break;
+            memcpy(&user->pregen_av[i-1], &user->pregen_av[i], sizeof(LTE_FDD_ENB_PREGEN_AV_STRUCT));
         }
+        user->N_pregen_av--;
+        found = true;
     }
 
-    return(auth_vec);
+    return(found);
+}
+void LTE_fdd_enb_hss::queue_av_refill(LTE_FDD_ENB_HSS_USER_STRUCT *user,
+                                      bool                         first)
+{
+    boost::mutex::scoped_lock lock(av_mutex);
+
+    if(first)
+    {
+        av_queue.push_front(user->id.imsi);
+    }else{
+        av_queue.push_back(user->id.imsi);
+    }
+    av_cond.notify_one();
 }
 
 /*******************/
@@ -527,58 +724,114 @@ void LTE_fdd_enb_hss::set_use_user_file(bool uuf)
 
     if(use_user_file)
     {
-        write_user_file();
+        user_persist->mark_dirty();
     }else{
         delete_user_file();
     }
 }
 void LTE_fdd_enb_hss::read_user_file(void)
 {
-    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_fdd_enb_cnfg_db   *cnfg_db   = LTE_fdd_enb_cnfg_db::get_instance();
-    std::string            line_str;
-    FILE                  *user_file = NULL;
-    int64                  uuf       = 1;
-    char                   str[LTE_FDD_ENB_MAX_LINE_SIZE];
+    LTE_fdd_enb_interface               *interface = LTE_fdd_enb_interface::get_instance();
+    LTE_fdd_enb_cnfg_db                 *cnfg_db   = LTE_fdd_enb_cnfg_db::get_instance();
+    LTE_FDD_ENB_USER_FILE_HEADER_STRUCT *hdr;
+    LTE_FDD_ENB_USER_FILE_RECORD_STRUCT *rec;
+    LTE_FDD_ENB_HSS_USER_STRUCT         *new_user;
+    std::string                          line_str;
+    struct stat                          file_stat;
+    FILE                                *user_file = NULL;
+    void                                *file_map  = MAP_FAILED;
+    int64                                uuf       = 1;
+    uint64                               i;
+    char                                 str[LTE_FDD_ENB_MAX_LINE_SIZE];
 
     user_file = fopen("/tmp/LTE_fdd_enodeb.user_db", "r");
 
     if(NULL != user_file)
     {
-        while(NULL != fgets(str, LTE_FDD_ENB_MAX_LINE_SIZE, user_file))
+        if(0                                           == fstat(fileno(user_file), &file_stat) &&
+           sizeof(LTE_FDD_ENB_USER_FILE_HEADER_STRUCT) <= (uint64)file_stat.st_size)
         {
-            line_str = str;
-            interface->handle_add_user(line_str.substr(0, line_str.length()-1));
+            file_map = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fileno(user_file), 0);
+        }
+        hdr = (LTE_FDD_ENB_USER_FILE_HEADER_STRUCT *)file_map;
+
+        if(MAP_FAILED                    != file_map     &&
+           LTE_FDD_ENB_USER_FILE_MAGIC   == hdr->magic   &&
+           LTE_FDD_ENB_USER_FILE_VERSION == hdr->version &&
+           (uint64)file_stat.st_size     == sizeof(LTE_FDD_ENB_USER_FILE_HEADER_STRUCT) + hdr->N_users*sizeof(LTE_FDD_ENB_USER_FILE_RECORD_STRUCT))
+        {
+            // The file was written from a list without duplicates, so
+            // the records go straight in without parsing or checking
+            rec = (LTE_FDD_ENB_USER_FILE_RECORD_STRUCT *)(hdr + 1);
+            user_mutex.lock();
+            for(i=0; i<hdr->N_users; i++)
+            {
+                new_user                        = new LTE_FDD_ENB_HSS_USER_STRUCT;
+                new_user->id.imsi               = rec[i].imsi;
+                new_user->id.imei               = rec[i].imei;
+                memcpy(new_user->stored_data.k, rec[i].k, 16);
+                liblte_security_milenage_init(&new_user->stored_data.milenage, new_user->stored_data.k, NULL);
+                new_user->generated_data.sqn_he = 0;
+                new_user->generated_data.seq_he = 0;
+                new_user->generated_data.ind_he = 0;
+                new_user->N_pregen_av           = 0;
+                new_user->persist               = true;
+                imsi_map[new_user->id.imsi]     = new_user;
+                imei_map[new_user->id.imei]     = new_user;
+                queue_av_refill(new_user, false);
+            }
+            user_mutex.unlock();
+        }else{
+            // Text format used before the binary one, one user per line
+            while(NULL != fgets(str, LTE_FDD_ENB_MAX_LINE_SIZE, user_file))
+            {
+                line_str = str;
+                interface->handle_add_user(LIBTOOLS_SOCKET_WRAP_ALL_CLIENTS, line_str.substr(0, line_str.length()-1));
+            }
+        }
+
+        if(MAP_FAILED != file_map)
+        {
+            munmap(file_map, file_stat.st_size);
         }
         fclose(user_file);
         use_user_file = true;
         cnfg_db->set_param(LTE_FDD_ENB_PARAM_USE_USER_FILE, uuf);
     }
 }
-void LTE_fdd_enb_hss::write_user_file(void)
+bool LTE_fdd_enb_hss::write_user_file(FILE *user_file)
 {
-    boost::mutex::scoped_lock                           lock(user_mutex);
-    std::list<LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator  iter;
-    FILE                                               *user_file = NULL;
-    uint32                                              i;
-
-    user_file = fopen("/tmp/LTE_fdd_enodeb.user_db", "w");
-
-    if(NULL != user_file)
+    boost::unordered_map<uint64, LTE_FDD_ENB_HSS_USER_STRUCT *>::iterator  iter;
+    LTE_FDD_ENB_USER_FILE_HEADER_STRUCT                                    hdr;
+    LTE_FDD_ENB_USER_FILE_RECORD_STRUCT                                   *rec;
+    uint64                                                                 i = 0;
+
+    // Copy the users out so the index is only locked for the copy and not
+    // for the file I/O, users that are not persisted are skipped
+    user_mutex.lock_shared();
+    hdr.magic   = LTE_FDD_ENB_USER_FILE_MAGIC;
+    hdr.version = LTE_FDD_ENB_USER_FILE_VERSION;
+    rec         = new LTE_FDD_ENB_USER_FILE_RECORD_STRUCT[imsi_map.size()];
+    for(iter=imsi_map.begin(); iter!=imsi_map.end(); iter++)
     {
-        for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+        if((*iter).second->persist)
         {
-            fprintf(user_file, "imsi=%015llu imei=%015llu k=", (*iter)->id.imsi, (*iter)->id.imei);
-            for(i=0; i<16; i++)
-            {
-                fprintf(user_file, "%02X", (*iter)->stored_data.k[i]);
-            }
-            fprintf(user_file, "\n");
+            rec[i].imsi = (*iter).second->id.imsi;
+            rec[i].imei = (*iter).second->id.imei;
+            memcpy(rec[i].k, (*iter).second->stored_data.k, 16);
+            i++;
         }
-        fclose(user_file);
     }
+    hdr.N_users = i;
+    user_mutex.unlock_shared();
+
+    fwrite(&hdr, sizeof(hdr), 1, user_file);
+    fwrite(rec, sizeof(LTE_FDD_ENB_USER_FILE_RECORD_STRUCT), hdr.N_users, user_file);
+    delete [] rec;
+
+    return(0 == ferror(user_file));
 }
 void LTE_fdd_enb_hss::delete_user_file(void)
 {
-    remove("/tmp/LTE_fdd_enodeb.user_db");
+    user_persist->remove_file();
 }
@@ -59,6 +59,8 @@
 #include "LTE_fdd_enb_mac.h"
 #include "LTE_fdd_enb_phy.h"
 #include "LTE_fdd_enb_radio.h"
+#include "LTE_fdd_enb_worker_mgr.h"
+#include "LTE_fdd_enb_attach_storm.h"
 #include "liblte_interface.h"
 #include <boost/lexical_cast.hpp>
 #include <boost/interprocess/ipc/message_queue.hpp>
@@ -106,6 +108,13 @@ LTE_fdd_enb_interface* LTE_fdd_enb_interface::get_instance(void)
 }
 void LTE_fdd_enb_interface::cleanup(void)
 {
+    // Socket callbacks call get_instance, so the ports must be closed
+    // before the instance mutex is taken
+    if(NULL != instance)
+    {
+        instance->stop_ports();
+    }
+
     boost::mutex::scoped_lock lock(interface_instance_mutex);
 
     if(NULL != instance)
@@ -123,12 +132,15 @@ LTE_fdd_enb_interface::LTE_fdd_enb_interface()
     uint32 i;
 
     // Communication
-    ctrl_socket     = NULL;
-    debug_socket    = NULL;
-    ctrl_port       = LTE_FDD_ENB_DEFAULT_CTRL_PORT;
-    debug_port      = ctrl_port + LTE_FDD_ENB_DEBUG_PORT_OFFSET;
-    ctrl_connected  = false;
-    debug_connected = false;
+    ctrl_socket          = NULL;
+    debug_socket         = NULL;
+    n_ctrl_clients       = 0;
+    debug_sub_type_mask  = 0;
+    debug_sub_level_mask = 0;
+    ctrl_port            = LTE_FDD_ENB_DEFAULT_CTRL_PORT;
+    debug_port           = ctrl_port + LTE_FDD_ENB_DEBUG_PORT_OFFSET;
+    ctrl_connected       = false;
+    debug_connected      = false;
 
     // Variables
     var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_BANDWIDTH]]          = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_DOUBLE, LTE_FDD_ENB_PARAM_BANDWIDTH, 0, 0, 0, 0, true, false, false};
@@ -157,6 +169,9 @@ LTE_fdd_enb_interface::LTE_fdd_enb_interface()
     var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_TYPE]]         = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_UINT32, LTE_FDD_ENB_PARAM_DEBUG_TYPE, 0, 0, 0, 0, true, true, false};
     var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_LEVEL]]        = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_UINT32, LTE_FDD_ENB_PARAM_DEBUG_LEVEL, 0, 0, 0, 0, true, true, false};
     var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_ENABLE_PCAP]]        = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_ENABLE_PCAP, 0, 0, 0, 1, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_ENABLE_ROHC]]        = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_ENABLE_ROHC, 0, 0, 0, 1, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_UE_AMBR_DL]]         = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_UE_AMBR_DL, 0, 0, 0, 10000000, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_N_WORKERS]]          = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_N_WORKERS, 0, 0, 1, LTE_FDD_ENB_MAX_WORKERS, false, false, false};
     var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_IP_ADDR_START]]      = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_HEX, LTE_FDD_ENB_PARAM_IP_ADDR_START, 0, 0, 0, 0, true, false, false};
     var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DNS_ADDR]]           = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_HEX, LTE_FDD_ENB_PARAM_DNS_ADDR, 0, 0, 0, 0, true, false, false};
     var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_USE_CNFG_FILE]]      = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_USE_CNFG_FILE, 0, 0, 0, 1, false, true, false};
@@ -210,7 +225,8 @@ void LTE_fdd_enb_interface::start_ports(void)
     {
         debug_socket = new libtools_socket_wrap(NULL,
                                                 debug_port,
-                                                LIBTOOLS_SOCKET_WRAP_TYPE_SERVER,
+                                                LTE_FDD_ENB_MAX_DEBUG_CLIENTS,
+                                                LTE_FDD_ENB_DEBUG_CLIENT_TX_LIMIT,
                                                 &handle_debug_msg,
                                                 &handle_debug_connect,
                                                 &handle_debug_disconnect,
@@ -226,7 +242,8 @@ void LTE_fdd_enb_interface::start_ports(void)
     {
         ctrl_socket = new libtools_socket_wrap(NULL,
                                                ctrl_port,
-                                               LIBTOOLS_SOCKET_WRAP_TYPE_SERVER,
+                                               LTE_FDD_ENB_MAX_CTRL_CLIENTS,
+                                               LTE_FDD_ENB_CTRL_CLIENT_TX_LIMIT,
                                                &handle_ctrl_msg,
                                                &handle_ctrl_connect,
                                                &handle_ctrl_disconnect,
@@ -260,7 +277,8 @@ void LTE_fdd_enb_interface::stop_ports(void)
         debug_socket = NULL;
     }
 }
-void LTE_fdd_enb_interface::send_ctrl_msg(std::string msg)
+void LTE_fdd_enb_interface::send_ctrl_msg(uint32      client,
+                                          std::string msg)
 {
     boost::mutex::scoped_lock lock(ctrl_connect_mutex);
     std::string               tmp_msg;
@@ -269,7 +287,7 @@ void LTE_fdd_enb_interface::send_ctrl_msg(std::string msg)
     {
         tmp_msg  = msg;
         tmp_msg += "\n";
-        ctrl_socket->send(tmp_msg);
+        ctrl_socket->send(client, tmp_msg);
     }
 }
 void LTE_fdd_enb_interface::send_ctrl_info_msg(std::string msg,
@@ -296,7 +314,8 @@ void LTE_fdd_enb_interface::send_ctrl_info_msg(std::string msg,
         ctrl_socket->send(tmp_msg);
     }
 }
-void LTE_fdd_enb_interface::send_ctrl_error_msg(LTE_FDD_ENB_ERROR_ENUM error,
+void LTE_fdd_enb_interface::send_ctrl_error_msg(uint32                 client,
+                                                LTE_FDD_ENB_ERROR_ENUM error,
                                                 std::string            msg)
 {
     boost::mutex::scoped_lock lock(ctrl_connect_mutex);
@@ -315,7 +334,7 @@ void LTE_fdd_enb_interface::send_ctrl_error_msg(LTE_FDD_ENB_ERROR_ENUM error,
         tmp_msg += msg;
         tmp_msg += "\n";
 
-        ctrl_socket->send(tmp_msg);
+        ctrl_socket->send(client, tmp_msg);
     }
 }
 void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM  type,
@@ -333,9 +352,8 @@ void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM  type,
     struct timezone            time_zone;
     char                      *args_msg;
 
-    if(debug_connected                 &&
-       (debug_type_mask & (1 << type)) &&
-       (debug_level_mask & (1 << level)))
+    if((debug_sub_type_mask & (1 << type)) &&
+       (debug_sub_level_mask & (1 << level)))
     {
         // Format the output string
         gettimeofday(&time, &time_zone);
@@ -360,7 +378,7 @@ void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM  type,
         // Cleanup the variable argument string
         free(args_msg);
 
-        debug_socket->send(tmp_msg);
+        send_debug_to_subs(type, level, tmp_msg);
     }
 }
 void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM   type,
@@ -381,9 +399,8 @@ void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM   type,
     uint32                     hex_val;
     char                      *args_msg;
 
-    if(debug_connected                 &&
-       (debug_type_mask & (1 << type)) &&
-       (debug_level_mask & (1 << level)))
+    if((debug_sub_type_mask & (1 << type)) &&
+       (debug_sub_level_mask & (1 << level)))
     {
         // Format the output string
         gettimeofday(&time, &time_zone);
@@ -438,7 +455,7 @@ void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM   type,
         // Cleanup the variable argument string
         free(args_msg);
 
-        debug_socket->send(tmp_msg);
+        send_debug_to_subs(type, level, tmp_msg);
     }
 }
 void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM   type,
@@ -459,9 +476,8 @@ void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM   type,
     uint32                     hex_val;
     char                      *args_msg;
 
-    if(debug_connected                 &&
-       (debug_type_mask & (1 << type)) &&
-       (debug_level_mask & (1 << level)))
+    if((debug_sub_type_mask & (1 << type)) &&
+       (debug_sub_level_mask & (1 << level)))
     {
         // Format the output string
         gettimeofday(&time, &time_zone);
@@ -504,7 +520,7 @@ void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM   type,
         // Cleanup the variable argument string
         free(args_msg);
 
-        debug_socket->send(tmp_msg);
+        send_debug_to_subs(type, level, tmp_msg);
     }
 }
 void LTE_fdd_enb_interface::open_pcap_fd(void)
@@ -530,23 +546,20 @@ void LTE_fdd_enb_interface::open_pcap_fd(void)
 void LTE_fdd_enb_interface::send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_ENUM  dir,
                                           uint32                           rnti,
                                           uint32                           current_tti,
-                                          uint8                           *msg,
+                                          const uint8                     *msg,
                                           uint32                           N_bits)
 {
-    LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
-    struct timeval       time;
-    struct timezone      time_zone;
-    int64                enable_pcap;
-    uint32               i;
-    uint32               idx;
-    uint32               length;
-    uint16               tmp;
-    uint8                pcap_c_hdr[15];
-    uint8                pcap_msg[LIBLTE_MAX_MSG_SIZE/8];
-
-    cnfg_db->get_param(LTE_FDD_ENB_PARAM_ENABLE_PCAP, enable_pcap);
-
-    if(enable_pcap)
+    LTE_fdd_enb_cnfg_reader cnfg;
+    struct timeval          time;
+    struct timezone         time_zone;
+    uint32                  i;
+    uint32                  idx;
+    uint32                  length;
+    uint16                  tmp;
+    uint8                   pcap_c_hdr[15];
+    uint8                   pcap_msg[LIBLTE_MAX_MSG_SIZE/8];
+
+    if(cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_ENABLE_PCAP])
     {
         // Get approximate time stamp
         gettimeofday(&time, &time_zone);
@@ -622,60 +635,71 @@ void LTE_fdd_enb_interface::send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_ENUM  dir,
         fwrite(pcap_msg,      sizeof(uint8),  idx, pcap_fd);
     }
 }
-void LTE_fdd_enb_interface::handle_ctrl_msg(std::string msg)
+void LTE_fdd_enb_interface::handle_ctrl_msg(uint32      client,
+                                            const char *line,
+                                            uint32      len)
 {
     LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
     LTE_fdd_enb_cnfg_db   *cnfg_db   = LTE_fdd_enb_cnfg_db::get_instance();
     LTE_fdd_enb_radio     *radio     = LTE_fdd_enb_radio::get_instance();
+    std::string            msg(line, len);
 
     if(std::string::npos != msg.find("read"))
     {
-        interface->handle_read(msg.substr(msg.find("read")+sizeof("read"), std::string::npos));
+        interface->handle_read(client, msg.substr(msg.find("read")+sizeof("read"), std::string::npos));
     }else if(std::string::npos != msg.find("write")){
-        interface->send_ctrl_error_msg(interface->handle_write(msg.substr(msg.find("write")+sizeof("write"), std::string::npos)), "");
+        interface->send_ctrl_error_msg(client, interface->handle_write(msg.substr(msg.find("write")+sizeof("write"), std::string::npos)), "");
     }else if(std::string::npos != msg.find("start")){
-        interface->handle_start();
+        interface->handle_start(client);
     }else if(std::string::npos != msg.find("stop")){
-        interface->handle_stop();
+        interface->handle_stop(client);
     }else if(std::string::npos != msg.find("shutdown")){
         interface->shutdown = true;
         if(radio->is_started())
         {
-            interface->handle_stop();
+            interface->handle_stop(client);
         }else{
-            interface->send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, "");
+            interface->send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, "");
         }
     }else if(std::string::npos != msg.find("construct_si")){
         cnfg_db->construct_sys_info();
-        interface->send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, "");
+        interface->send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, "");
     }else if(std::string::npos != msg.find("help")){
-        interface->handle_help();
+        interface->handle_help(client);
     }else if(std::string::npos != msg.find("add_user")){
-        interface->handle_add_user(msg.substr(msg.find("add_user")+sizeof("add_user"), std::string::npos));
+        interface->handle_add_user(client, msg.substr(msg.find("add_user")+sizeof("add_user"), std::string::npos));
     }else if(std::string::npos != msg.find("del_user")){
-        interface->handle_del_user(msg.substr(msg.find("del_user")+sizeof("del_user"), std::string::npos));
+        interface->handle_del_user(client, msg.substr(msg.find("del_user")+sizeof("del_user"), std::string::npos));
     }else if(std::string::npos != msg.find("print_users")){
-        interface->handle_print_users();
+        interface->handle_print_users(client);
+    }else if(std::string::npos != msg.find("attach_storm")){
+        interface->handle_attach_storm(client, msg.substr(msg.find("attach_storm")+sizeof("attach_storm")-1, std::string::npos));
     }else{
-        interface->send_ctrl_error_msg(LTE_FDD_ENB_ERROR_INVALID_COMMAND, "");
+        interface->send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_INVALID_COMMAND, "");
     }
 }
-void LTE_fdd_enb_interface::handle_ctrl_connect(void)
+void LTE_fdd_enb_interface::handle_ctrl_connect(uint32 client)
 {
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+
     ctrl_connect_mutex.lock();
+    interface->n_ctrl_clients++;
     LTE_fdd_enb_interface::ctrl_connected = true;
     ctrl_connect_mutex.unlock();
 
-    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
-
-    interface->send_ctrl_msg("*** LTE FDD ENB ***");
-    interface->send_ctrl_msg("Type help to see a list of commands");
+    interface->send_ctrl_msg(client, "*** LTE FDD ENB ***");
+    interface->send_ctrl_msg(client, "Type help to see a list of commands");
 }
-void LTE_fdd_enb_interface::handle_ctrl_disconnect(void)
+void LTE_fdd_enb_interface::handle_ctrl_disconnect(uint32 client)
 {
-    boost::mutex::scoped_lock lock(ctrl_connect_mutex);
+    boost::mutex::scoped_lock  lock(ctrl_connect_mutex);
+    LTE_fdd_enb_interface     *interface = LTE_fdd_enb_interface::get_instance();
 
-    LTE_fdd_enb_interface::ctrl_connected = false;
+    if(0 != interface->n_ctrl_clients)
+    {
+        interface->n_ctrl_clients--;
+    }
+    LTE_fdd_enb_interface::ctrl_connected = (0 != interface->n_ctrl_clients);
 }
 void LTE_fdd_enb_interface::handle_ctrl_error(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM err)
 {
@@ -689,29 +713,41 @@ void LTE_fdd_enb_interface::handle_ctrl_error(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM er
                               libtools_socket_wrap_error_text[err]);
     assert(0);
 }
-void LTE_fdd_enb_interface::handle_debug_msg(std::string msg)
+void LTE_fdd_enb_interface::handle_debug_msg(uint32      client,
+                                             const char *line,
+                                             uint32      len)
 {
-    // No messages to handle
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+
+    interface->handle_debug_subscribe(client, std::string(line, len));
 }
-void LTE_fdd_enb_interface::handle_debug_connect(void)
+void LTE_fdd_enb_interface::handle_debug_connect(uint32 client)
 {
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+
+    // New clients get everything the debug_type and debug_level parameters allow
     debug_connect_mutex.lock();
-    LTE_fdd_enb_interface::debug_connected = true;
+    interface->debug_subs[client].type_mask  = (1 << LTE_FDD_ENB_DEBUG_TYPE_N_ITEMS) - 1;
+    interface->debug_subs[client].level_mask = (1 << LTE_FDD_ENB_DEBUG_LEVEL_N_ITEMS) - 1;
+    LTE_fdd_enb_interface::debug_connected   = true;
     debug_connect_mutex.unlock();
+    interface->update_debug_sub_masks();
 
-    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
-
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_IFACE,
-                              __FILE__,
-                              __LINE__,
-                              "*** LTE FDD ENB DEBUG INTERFACE ***");
+    if(NULL != interface->debug_socket)
+    {
+        interface->debug_socket->send(client, "*** LTE FDD ENB DEBUG INTERFACE ***\n");
+        interface->debug_socket->send(client, "Type subscribe or unsubscribe followed by debug types and levels, or all\n");
+    }
 }
-void LTE_fdd_enb_interface::handle_debug_disconnect(void)
+void LTE_fdd_enb_interface::handle_debug_disconnect(uint32 client)
 {
-    boost::mutex::scoped_lock lock(debug_connect_mutex);
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
 
-    LTE_fdd_enb_interface::debug_connected = false;
+    debug_connect_mutex.lock();
+    interface->debug_subs.erase(client);
+    LTE_fdd_enb_interface::debug_connected = (0 != interface->debug_subs.size());
+    debug_connect_mutex.unlock();
+    interface->update_debug_sub_masks();
 }
 void LTE_fdd_enb_interface::handle_debug_error(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM err)
 {
@@ -722,7 +758,8 @@ void LTE_fdd_enb_interface::handle_debug_error(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM e
 /******************/
 /*    Handlers    */
 /******************/
-void LTE_fdd_enb_interface::handle_read(std::string msg)
+void LTE_fdd_enb_interface::handle_read(uint32      client,
+                                        std::string msg)
 {
     LTE_fdd_enb_cnfg_db                                     *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
     LTE_fdd_enb_radio                                       *radio   = LTE_fdd_enb_radio::get_instance();
@@ -745,20 +782,20 @@ void LTE_fdd_enb_interface::handle_read(std::string msg)
             {
             case LTE_FDD_ENB_VAR_TYPE_DOUBLE:
                 cnfg_db->get_param((*iter).second.param, d_value);
-                send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(d_value));
+                send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(d_value));
                 break;
             case LTE_FDD_ENB_VAR_TYPE_INT64:
                 cnfg_db->get_param((*iter).second.param, i_value);
                 if(LTE_FDD_ENB_PARAM_FREQ_BAND == (*iter).second.param)
                 {
-                    send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, liblte_interface_band_text[i_value]);
+                    send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, liblte_interface_band_text[i_value]);
                 }else{
-                    send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(i_value));
+                    send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(i_value));
                 }
                 break;
             case LTE_FDD_ENB_VAR_TYPE_HEX:
                 cnfg_db->get_param((*iter).second.param, s_value);
-                send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, s_value);
+                send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, s_value);
                 break;
             case LTE_FDD_ENB_VAR_TYPE_UINT32:
                 cnfg_db->get_param((*iter).second.param, u_value);
@@ -772,7 +809,7 @@ void LTE_fdd_enb_interface::handle_read(std::string msg)
                             tmp_str += " ";
                         }
                     }
-                    send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, tmp_str);
+                    send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, tmp_str);
                 }else if(LTE_FDD_ENB_PARAM_DEBUG_LEVEL == (*iter).second.param){
                     for(i=0; i<LTE_FDD_ENB_DEBUG_LEVEL_N_ITEMS; i++)
                     {
@@ -782,43 +819,43 @@ void LTE_fdd_enb_interface::handle_read(std::string msg)
                             tmp_str += " ";
                         }
                     }
-                    send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, tmp_str);
+                    send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, tmp_str);
                 }else{
-                    send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(u_value));
+                    send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(u_value));
                 }
                 break;
             default:
-                send_ctrl_error_msg(LTE_FDD_ENB_ERROR_INVALID_PARAM, "");
+                send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_INVALID_PARAM, "");
                 break;
             }
         }else{
             // Handle all radio parameters
             if(std::string::npos != msg.find(LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_AVAILABLE_RADIOS]))
             {
-                send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(avail_radios.num_radios));
+                send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(avail_radios.num_radios));
                 for(i=0; i<avail_radios.num_radios; i++)
                 {
                     tmp_str  = boost::lexical_cast<std::string>(i);
                     tmp_str += ":";
                     tmp_str += avail_radios.radio[i].name;
-                    send_ctrl_msg(tmp_str);
+                    send_ctrl_msg(client, tmp_str);
                 }
             }else if(std::string::npos != msg.find(LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SELECTED_RADIO_NAME])){
-                send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, selected_radio.name);
+                send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, selected_radio.name);
             }else if(std::string::npos != msg.find(LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SELECTED_RADIO_IDX])){
-                send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(radio->get_selected_radio_idx()));
+                send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(radio->get_selected_radio_idx()));
             }else if(std::string::npos != msg.find(LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_TX_GAIN])){
-                send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(radio->get_tx_gain()));
+                send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(radio->get_tx_gain()));
             }else if(std::string::npos != msg.find(LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_RX_GAIN])){
-                send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(radio->get_rx_gain()));
+                send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(radio->get_rx_gain()));
             }else if(std::string::npos != msg.find(LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_CLOCK_SOURCE])){
-                send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, radio->get_clock_source());
+                send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, radio->get_clock_source());
             }else{
-                send_ctrl_error_msg(LTE_FDD_ENB_ERROR_INVALID_PARAM, "");
+                send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_INVALID_PARAM, "");
             }
         }
     }catch(...){
-        send_ctrl_error_msg(LTE_FDD_ENB_ERROR_EXCEPTION, "");
+        send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_EXCEPTION, "");
     }
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_interface::handle_write(std::string msg)
@@ -864,6 +901,7 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_interface::handle_write(std::string msg)
                         }
                         debug_type_mask = u_value;
                         err             = write_value(&(*iter).second, u_value);
+                        update_debug_sub_masks();
                     }else if(LTE_FDD_ENB_PARAM_DEBUG_LEVEL == (*iter).second.param){
                         u_value = 0;
                         for(i=0; i<LTE_FDD_ENB_DEBUG_LEVEL_N_ITEMS; i++)
@@ -875,6 +913,7 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_interface::handle_write(std::string msg)
                         }
                         debug_level_mask = u_value;
                         err              = write_value(&(*iter).second, u_value);
+                        update_debug_sub_masks();
                     }else{
                         u_value = boost::lexical_cast<uint32>(msg.substr(msg.find(" ")+1, std::string::npos));
                         err     = write_value(&(*iter).second, u_value);
@@ -911,7 +950,7 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_interface::handle_write(std::string msg)
 
     return(err);
 }
-void LTE_fdd_enb_interface::handle_start(void)
+void LTE_fdd_enb_interface::handle_start(uint32 client)
 {
     boost::mutex::scoped_lock  lock(start_mutex);
     LTE_fdd_enb_cnfg_db       *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
@@ -923,6 +962,7 @@ void LTE_fdd_enb_interface::handle_start(void)
     LTE_fdd_enb_gw            *gw      = LTE_fdd_enb_gw::get_instance();
     LTE_fdd_enb_phy           *phy     = LTE_fdd_enb_phy::get_instance();
     LTE_fdd_enb_radio         *radio   = LTE_fdd_enb_radio::get_instance();
+    LTE_fdd_enb_worker_mgr    *wkr_mgr = LTE_fdd_enb_worker_mgr::get_instance();
     LTE_FDD_ENB_ERROR_ENUM     err;
     char                       err_str[LTE_FDD_ENB_MAX_LINE_SIZE];
 
@@ -937,16 +977,8 @@ void LTE_fdd_enb_interface::handle_start(void)
         // Initialize message queues for inter-layer communication
         boost::interprocess::message_queue::remove("phy_mac_mq");
         boost::interprocess::message_queue::remove("mac_phy_mq");
-        boost::interprocess::message_queue::remove("mac_rlc_mq");
         boost::interprocess::message_queue::remove("rlc_mac_mq");
-        boost::interprocess::message_queue::remove("rlc_pdcp_mq");
-        boost::interprocess::message_queue::remove("pdcp_rlc_mq");
-        boost::interprocess::message_queue::remove("pdcp_rrc_mq");
-        boost::interprocess::message_queue::remove("rrc_pdcp_mq");
-        boost::interprocess::message_queue::remove("rrc_mme_mq");
-        boost::interprocess::message_queue::remove("mme_rrc_mq");
         boost::interprocess::message_queue::remove("pdcp_gw_mq");
-        boost::interprocess::message_queue::remove("gw_pdcp_mq");
         boost::interprocess::message_queue phy_mac_mq(boost::interprocess::create_only,
                                                       "phy_mac_mq",
                                                       100,
@@ -955,51 +987,20 @@ void LTE_fdd_enb_interface::handle_start(void)
                                                       "mac_phy_mq",
                                                       100,
                                                       sizeof(LTE_FDD_ENB_MESSAGE_STRUCT *));
-        boost::interprocess::message_queue mac_rlc_mq(boost::interprocess::create_only,
-                                                      "mac_rlc_mq",
-                                                      100,
-                                                      sizeof(LTE_FDD_ENB_MESSAGE_STRUCT *));
         boost::interprocess::message_queue rlc_mac_mq(boost::interprocess::create_only,
                                                       "rlc_mac_mq",
                                                       100,
                                                       sizeof(LTE_FDD_ENB_MESSAGE_STRUCT *));
-        boost::interprocess::message_queue rlc_pdcp_mq(boost::interprocess::create_only,
-                                                       "rlc_pdcp_mq",
-                                                       100,
-                                                       sizeof(LTE_FDD_ENB_MESSAGE_STRUCT *));
-        boost::interprocess::message_queue pdcp_rlc_mq(boost::interprocess::create_only,
-                                                       "pdcp_rlc_mq",
-                                                       100,
-                                                       sizeof(LTE_FDD_ENB_MESSAGE_STRUCT *));
-        boost::interprocess::message_queue pdcp_rrc_mq(boost::interprocess::create_only,
-                                                       "pdcp_rrc_mq",
-                                                       100,
-                                                       sizeof(LTE_FDD_ENB_MESSAGE_STRUCT *));
-        boost::interprocess::message_queue rrc_pdcp_mq(boost::interprocess::create_only,
-                                                       "rrc_pdcp_mq",
-                                                       100,
-                                                       sizeof(LTE_FDD_ENB_MESSAGE_STRUCT *));
-        boost::interprocess::message_queue rrc_mme_mq(boost::interprocess::create_only,
-                                                      "rrc_mme_mq",
-                                                      100,
-                                                      sizeof(LTE_FDD_ENB_MESSAGE_STRUCT *));
-        boost::interprocess::message_queue mme_rrc_mq(boost::interprocess::create_only,
-                                                      "mme_rrc_mq",
-                                                      100,
-                                                      sizeof(LTE_FDD_ENB_MESSAGE_STRUCT *));
         boost::interprocess::message_queue pdcp_gw_mq(boost::interprocess::create_only,
                                                       "pdcp_gw_mq",
                                                       100,
                                                       sizeof(LTE_FDD_ENB_MESSAGE_STRUCT *));
-        boost::interprocess::message_queue gw_pdcp_mq(boost::interprocess::create_only,
-                                                      "gw_pdcp_mq",
-                                                      100,
-                                                      sizeof(LTE_FDD_ENB_MESSAGE_STRUCT *));
 
         // Start layers
         err = gw->start(err_str);
         if(LTE_FDD_ENB_ERROR_NONE == err)
         {
+            wkr_mgr->start();
             phy->start(this);
             mac->start(this);
             rlc->start();
@@ -1009,7 +1010,7 @@ void LTE_fdd_enb_interface::handle_start(void)
             err = radio->start();
             if(LTE_FDD_ENB_ERROR_NONE == err)
             {
-                send_ctrl_error_msg(err, "");
+                send_ctrl_error_msg(client, err, "");
             }else{
                 start_mutex.lock();
                 started = false;
@@ -1022,26 +1023,27 @@ void LTE_fdd_enb_interface::handle_start(void)
                 rrc->stop();
                 mme->stop();
 
-                send_ctrl_error_msg(err, "");
+                send_ctrl_error_msg(client, err, "");
             }
         }else{
-            send_ctrl_error_msg(err, err_str);
+            send_ctrl_error_msg(client, err, err_str);
         }
     }else{
-        send_ctrl_error_msg(LTE_FDD_ENB_ERROR_ALREADY_STARTED, "");
+        send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_ALREADY_STARTED, "");
     }
 }
-void LTE_fdd_enb_interface::handle_stop(void)
+void LTE_fdd_enb_interface::handle_stop(uint32 client)
 {
     boost::mutex::scoped_lock  lock(start_mutex);
-    LTE_fdd_enb_radio         *radio = LTE_fdd_enb_radio::get_instance();
-    LTE_fdd_enb_phy           *phy   = LTE_fdd_enb_phy::get_instance();
-    LTE_fdd_enb_mac           *mac   = LTE_fdd_enb_mac::get_instance();
-    LTE_fdd_enb_rlc           *rlc   = LTE_fdd_enb_rlc::get_instance();
-    LTE_fdd_enb_pdcp          *pdcp  = LTE_fdd_enb_pdcp::get_instance();
-    LTE_fdd_enb_rrc           *rrc   = LTE_fdd_enb_rrc::get_instance();
-    LTE_fdd_enb_mme           *mme   = LTE_fdd_enb_mme::get_instance();
-    LTE_fdd_enb_gw            *gw    = LTE_fdd_enb_gw::get_instance();
+    LTE_fdd_enb_radio         *radio   = LTE_fdd_enb_radio::get_instance();
+    LTE_fdd_enb_phy           *phy     = LTE_fdd_enb_phy::get_instance();
+    LTE_fdd_enb_mac           *mac     = LTE_fdd_enb_mac::get_instance();
+    LTE_fdd_enb_rlc           *rlc     = LTE_fdd_enb_rlc::get_instance();
+    LTE_fdd_enb_pdcp          *pdcp    = LTE_fdd_enb_pdcp::get_instance();
+    LTE_fdd_enb_rrc           *rrc     = LTE_fdd_enb_rrc::get_instance();
+    LTE_fdd_enb_mme           *mme     = LTE_fdd_enb_mme::get_instance();
+    LTE_fdd_enb_gw            *gw      = LTE_fdd_enb_gw::get_instance();
+    LTE_fdd_enb_worker_mgr    *wkr_mgr = LTE_fdd_enb_worker_mgr::get_instance();
     LTE_FDD_ENB_ERROR_ENUM     err;
 
     if(started)
@@ -1060,6 +1062,7 @@ void LTE_fdd_enb_interface::handle_stop(void)
             rrc->stop();
             mme->stop();
             gw->stop();
+            wkr_mgr->stop();
 
             // Send a message to all inter-layer message_queues to unblock receive
             LTE_fdd_enb_msgq::send("phy_mac_mq",
@@ -1072,70 +1075,22 @@ void LTE_fdd_enb_interface::handle_stop(void)
                                    LTE_FDD_ENB_DEST_LAYER_ANY,
                                    NULL,
                                    0);
-            LTE_fdd_enb_msgq::send("mac_rlc_mq",
-                                   LTE_FDD_ENB_MESSAGE_TYPE_KILL,
-                                   LTE_FDD_ENB_DEST_LAYER_ANY,
-                                   NULL,
-                                   0);
             LTE_fdd_enb_msgq::send("rlc_mac_mq",
                                    LTE_FDD_ENB_MESSAGE_TYPE_KILL,
                                    LTE_FDD_ENB_DEST_LAYER_ANY,
                                    NULL,
                                    0);
-            LTE_fdd_enb_msgq::send("rlc_pdcp_mq",
-                                   LTE_FDD_ENB_MESSAGE_TYPE_KILL,
-                                   LTE_FDD_ENB_DEST_LAYER_ANY,
-                                   NULL,
-                                   0);
-            LTE_fdd_enb_msgq::send("pdcp_rlc_mq",
-                                   LTE_FDD_ENB_MESSAGE_TYPE_KILL,
-                                   LTE_FDD_ENB_DEST_LAYER_ANY,
-                                   NULL,
-                                   0);
-            LTE_fdd_enb_msgq::send("pdcp_rrc_mq",
-                                   LTE_FDD_ENB_MESSAGE_TYPE_KILL,
-                                   LTE_FDD_ENB_DEST_LAYER_ANY,
-                                   NULL,
-                                   0);
-            LTE_fdd_enb_msgq::send("rrc_pdcp_mq",
-                                   LTE_FDD_ENB_MESSAGE_TYPE_KILL,
-                                   LTE_FDD_ENB_DEST_LAYER_ANY,
-                                   NULL,
-                                   0);
-            LTE_fdd_enb_msgq::send("rrc_mme_mq",
-                                   LTE_FDD_ENB_MESSAGE_TYPE_KILL,
-                                   LTE_FDD_ENB_DEST_LAYER_ANY,
-                                   NULL,
-                                   0);
-            LTE_fdd_enb_msgq::send("mme_rrc_mq",
-                                   LTE_FDD_ENB_MESSAGE_TYPE_KILL,
-                                   LTE_FDD_ENB_DEST_LAYER_ANY,
-                                   NULL,
-                                   0);
             LTE_fdd_enb_msgq::send("pdcp_gw_mq",
                                    LTE_FDD_ENB_MESSAGE_TYPE_KILL,
                                    LTE_FDD_ENB_DEST_LAYER_ANY,
                                    NULL,
                                    0);
-            LTE_fdd_enb_msgq::send("gw_pdcp_mq",
-                                   LTE_FDD_ENB_MESSAGE_TYPE_KILL,
-                                   LTE_FDD_ENB_DEST_LAYER_ANY,
-                                   NULL,
-                                   0);
             sleep(1);
 
             boost::interprocess::message_queue::remove("phy_mac_mq");
             boost::interprocess::message_queue::remove("mac_phy_mq");
-            boost::interprocess::message_queue::remove("mac_rlc_mq");
             boost::interprocess::message_queue::remove("rlc_mac_mq");
-            boost::interprocess::message_queue::remove("rlc_pdcp_mq");
-            boost::interprocess::message_queue::remove("pdcp_rlc_mq");
-            boost::interprocess::message_queue::remove("pdcp_rrc_mq");
-            boost::interprocess::message_queue::remove("rrc_pdcp_mq");
-            boost::interprocess::message_queue::remove("rrc_mme_mq");
-            boost::interprocess::message_queue::remove("mme_rrc_mq");
             boost::interprocess::message_queue::remove("pdcp_gw_mq");
-            boost::interprocess::message_queue::remove("gw_pdcp_mq");
 
             // Cleanup all layers
             LTE_fdd_enb_radio::cleanup();
@@ -1146,16 +1101,17 @@ void LTE_fdd_enb_interface::handle_stop(void)
             LTE_fdd_enb_rrc::cleanup();
             LTE_fdd_enb_mme::cleanup();
             LTE_fdd_enb_gw::cleanup();
+            LTE_fdd_enb_worker_mgr::cleanup();
 
-            send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, "");
+            send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, "");
         }else{
-            send_ctrl_error_msg(err, "");
+            send_ctrl_error_msg(client, err, "");
         }
     }else{
-        send_ctrl_error_msg(LTE_FDD_ENB_ERROR_ALREADY_STOPPED, "");
+        send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_ALREADY_STOPPED, "");
     }
 }
-void LTE_fdd_enb_interface::handle_help(void)
+void LTE_fdd_enb_interface::handle_help(uint32 client)
 {
     LTE_fdd_enb_cnfg_db                                     *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
     LTE_fdd_enb_radio                                       *radio   = LTE_fdd_enb_radio::get_instance();
@@ -1169,26 +1125,27 @@ void LTE_fdd_enb_interface::handle_help(void)
     uint32                                                   u_value;
     uint32                                                   i;
 
-    send_ctrl_msg("***System Configuration Parameters***");
-    send_ctrl_msg("\tRead parameters using read <param> format");
-    send_ctrl_msg("\tSet parameters using write <param> <value> format");
+    send_ctrl_msg(client, "***System Configuration Parameters***");
+    send_ctrl_msg(client, "\tRead parameters using read <param> format");
+    send_ctrl_msg(client, "\tSet parameters using write <param> <value> format");
     // Commands
-    send_ctrl_msg("\tCommands:");
-    send_ctrl_msg("\t\tstart                                  - Constructs the system information and starts the eNB");
-    send_ctrl_msg("\t\tstop                                   - Stops the eNB");
-    send_ctrl_msg("\t\tshutdown                               - Stops the eNB and exits");
-    send_ctrl_msg("\t\tconstruct_si                           - Constructs the new system information");
-    send_ctrl_msg("\t\thelp                                   - Prints this screen");
-    send_ctrl_msg("\t\tadd_user imsi=<imsi> imei=<imei> k=<k> - Adds a user to the HSS (<imsi> and <imei> are 15 decimal digits, and <k> is 32 hex digits)");
-    send_ctrl_msg("\t\tdel_user imsi=<imsi>                   - Deletes a user from the HSS");
-    send_ctrl_msg("\t\tprint_users                            - Prints all the users in the HSS");
+    send_ctrl_msg(client, "\tCommands:");
+    send_ctrl_msg(client, "\t\tstart                                  - Constructs the system information and starts the eNB");
+    send_ctrl_msg(client, "\t\tstop                                   - Stops the eNB");
+    send_ctrl_msg(client, "\t\tshutdown                               - Stops the eNB and exits");
+    send_ctrl_msg(client, "\t\tconstruct_si                           - Constructs the new system information");
+    send_ctrl_msg(client, "\t\thelp                                   - Prints this screen");
+    send_ctrl_msg(client, "\t\tadd_user imsi=<imsi> imei=<imei> k=<k> - Adds a user to the HSS (<imsi> and <imei> are 15 decimal digits, and <k> is 32 hex digits)");
+    send_ctrl_msg(client, "\t\tdel_user imsi=<imsi>                   - Deletes a user from the HSS");
+    send_ctrl_msg(client, "\t\tprint_users                            - Prints all the users in the HSS");
+    send_ctrl_msg(client, "\t\tattach_storm <n>                       - Attaches <n> simulated UEs through the MME and HSS, attaches/s and latency percentiles follow in an info message");
 
     // Radio Parameters
-    send_ctrl_msg("\tRadio Parameters:");
+    send_ctrl_msg(client, "\tRadio Parameters:");
     tmp_str  = "\t\t";
     tmp_str += LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_AVAILABLE_RADIOS];
     tmp_str += ": (read-only)";
-    send_ctrl_msg(tmp_str);
+    send_ctrl_msg(client, tmp_str);
     for(i=0; i<avail_radios.num_radios; i++)
     {
         try
@@ -1200,13 +1157,13 @@ void LTE_fdd_enb_interface::handle_help(void)
         }catch(...){
             // Intentionally do nothing
         }
-        send_ctrl_msg(tmp_str);
+        send_ctrl_msg(client, tmp_str);
     }
     tmp_str  = "\t\t";
     tmp_str += LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SELECTED_RADIO_NAME];
     tmp_str += " (read-only) = ";
     tmp_str += selected_radio.name;
-    send_ctrl_msg(tmp_str);
+    send_ctrl_msg(client, tmp_str);
     tmp_str  = "\t\t";
     tmp_str += LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SELECTED_RADIO_IDX];
     tmp_str += " = ";
@@ -1216,7 +1173,7 @@ void LTE_fdd_enb_interface::handle_help(void)
     }catch(...){
         // Intentionally do nothing
     }
-    send_ctrl_msg(tmp_str);
+    send_ctrl_msg(client, tmp_str);
     tmp_str  = "\t\t";
     tmp_str += LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_TX_GAIN];
     tmp_str += " = ";
@@ -1226,7 +1183,7 @@ void LTE_fdd_enb_interface::handle_help(void)
     }catch(...){
         // Intentionally do nothing
     }
-    send_ctrl_msg(tmp_str);
+    send_ctrl_msg(client, tmp_str);
     tmp_str  = "\t\t";
     tmp_str += LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_RX_GAIN];
     tmp_str += " = ";
@@ -1236,15 +1193,15 @@ void LTE_fdd_enb_interface::handle_help(void)
     }catch(...){
         // Intentionally do nothing
     }
-    send_ctrl_msg(tmp_str);
+    send_ctrl_msg(client, tmp_str);
     tmp_str  = "\t\t";
     tmp_str += LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_CLOCK_SOURCE];
     tmp_str += " = ";
     tmp_str += radio->get_clock_source();
-    send_ctrl_msg(tmp_str);
+    send_ctrl_msg(client, tmp_str);
 
     // System Parameters
-    send_ctrl_msg("\tSystem Parameters:");
+    send_ctrl_msg(client, "\tSystem Parameters:");
     for(iter=var_map.begin(); iter!=var_map.end(); iter++)
     {
         tmp_str  = "\t\t";
@@ -1301,10 +1258,11 @@ void LTE_fdd_enb_interface::handle_help(void)
         }catch(...){
             // Intentionally do nothing
         }
-        send_ctrl_msg(tmp_str);
+        send_ctrl_msg(client, tmp_str);
     }
 }
-void LTE_fdd_enb_interface::handle_add_user(std::string msg)
+void LTE_fdd_enb_interface::handle_add_user(uint32      client,
+                                            std::string msg)
 {
     LTE_fdd_enb_hss *hss = LTE_fdd_enb_hss::get_instance();
     std::string      imsi_str;
@@ -1331,12 +1289,13 @@ void LTE_fdd_enb_interface::handle_add_user(std::string msg)
 
     if(imsi_valid && imei_valid && k_valid)
     {
-        send_ctrl_error_msg(hss->add_user(imsi_str, imei_str, k_str), "");
+        send_ctrl_error_msg(client, hss->add_user(imsi_str, imei_str, k_str, true), "");
     }else{
-        send_ctrl_error_msg(LTE_FDD_ENB_ERROR_INVALID_PARAM, "");
+        send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_INVALID_PARAM, "");
     }
 }
-void LTE_fdd_enb_interface::handle_del_user(std::string msg)
+void LTE_fdd_enb_interface::handle_del_user(uint32      client,
+                                            std::string msg)
 {
     LTE_fdd_enb_hss *hss = LTE_fdd_enb_hss::get_instance();
     std::string      imsi_str;
@@ -1347,16 +1306,96 @@ void LTE_fdd_enb_interface::handle_del_user(std::string msg)
 
     if(is_string_valid_as_number(imsi_str, 15, 0x9))
     {
-        send_ctrl_error_msg(hss->del_user(imsi_str), "");
+        send_ctrl_error_msg(client, hss->del_user(imsi_str), "");
     }else{
-        send_ctrl_error_msg(LTE_FDD_ENB_ERROR_INVALID_PARAM, "");
+        send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_INVALID_PARAM, "");
     }
 }
-void LTE_fdd_enb_interface::handle_print_users(void)
+void LTE_fdd_enb_interface::handle_print_users(uint32 client)
 {
     LTE_fdd_enb_hss *hss = LTE_fdd_enb_hss::get_instance();
 
-    send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, hss->print_all_users());
+    send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_NONE, hss->print_all_users());
+}
+void LTE_fdd_enb_interface::handle_attach_storm(uint32      client,
+                                                std::string msg)
+{
+    LTE_fdd_enb_attach_storm *attach_storm = LTE_fdd_enb_attach_storm::get_instance();
+    uint32                    N_ues;
+
+    try
+    {
+        N_ues = boost::lexical_cast<uint32>(msg.substr(msg.find_first_not_of(" "), std::string::npos));
+        send_ctrl_error_msg(client, attach_storm->start(N_ues), "");
+    }catch(...){
+        send_ctrl_error_msg(client, LTE_FDD_ENB_ERROR_INVALID_PARAM, "");
+    }
+}
+void LTE_fdd_enb_interface::handle_debug_subscribe(uint32      client,
+                                                   std::string msg)
+{
+    std::map<uint32, LTE_FDD_ENB_DEBUG_SUB_STRUCT>::iterator iter;
+    std::string                                              args;
+    uint32                                                   type_mask  = 0;
+    uint32                                                   level_mask = 0;
+    uint32                                                   i;
+    bool                                                     subscribe;
+
+    if(std::string::npos != msg.find("unsubscribe"))
+    {
+        subscribe = false;
+        args      = msg.substr(msg.find("unsubscribe")+sizeof("unsubscribe")-1, std::string::npos);
+    }else if(std::string::npos != msg.find("subscribe")){
+        subscribe = true;
+        args      = msg.substr(msg.find("subscribe")+sizeof("subscribe")-1, std::string::npos);
+    }else{
+        debug_socket->send(client, "fail \"Invalid command\"\n");
+        return;
+    }
+
+    if(std::string::npos != args.find("all"))
+    {
+        type_mask  = (1 << LTE_FDD_ENB_DEBUG_TYPE_N_ITEMS) - 1;
+        level_mask = (1 << LTE_FDD_ENB_DEBUG_LEVEL_N_ITEMS) - 1;
+    }else{
+        for(i=0; i<LTE_FDD_ENB_DEBUG_TYPE_N_ITEMS; i++)
+        {
+            if(std::string::npos != args.find(LTE_fdd_enb_debug_type_text[i]))
+            {
+                type_mask |= 1 << i;
+            }
+        }
+        for(i=0; i<LTE_FDD_ENB_DEBUG_LEVEL_N_ITEMS; i++)
+        {
+            if(std::string::npos != args.find(LTE_fdd_enb_debug_level_text[i]))
+            {
+                level_mask |= 1 << i;
+            }
+        }
+    }
+    if(0 == type_mask && 0 == level_mask)
+    {
+        debug_socket->send(client, "fail \"Invalid param\"\n");
+        return;
+    }
+
+    debug_connect_mutex.lock();
+    iter = debug_subs.find(client);
+    if(debug_subs.end() != iter)
+    {
+        if(subscribe)
+        {
+            (*iter).second.type_mask  |= type_mask;
+            (*iter).second.level_mask |= level_mask;
+        }else{
+            (*iter).second.type_mask  &= ~type_mask;
+            (*iter).second.level_mask &= ~level_mask;
+        }
+    }
+    debug_connect_mutex.unlock();
+    update_debug_sub_masks();
+
+    debug_socket->send(client, "ok\n");
 }
 
 /*******************/
@@ -1451,7 +1490,6 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_interface::write_value(LTE_FDD_ENB_VAR_STRUCT
                     if(value == liblte_interface_band_num[i])
                     {
                         err = cnfg_db->set_param(var->param, (int64)i);
-                        err = cnfg_db->set_param(LTE_FDD_ENB_PARAM_DL_EARFCN, (int64)liblte_interface_first_dl_earfcn[i]);
                         cnfg_db->construct_sys_info();
                         break;
                     }
@@ -1571,3 +1609,36 @@ bool LTE_fdd_enb_interface::is_string_valid_as_number(std::string str,
 
     return(ret);
 }
+void LTE_fdd_enb_interface::update_debug_sub_masks(void)
+{
+    boost::mutex::scoped_lock                                lock(debug_connect_mutex);
+    std::map<uint32, LTE_FDD_ENB_DEBUG_SUB_STRUCT>::iterator iter;
+    uint32                                                   type_mask  = 0;
+    uint32                                                   level_mask = 0;
+
+    for(iter=debug_subs.begin(); iter!=debug_subs.end(); iter++)
+    {
+        type_mask  |= (*iter).second.type_mask;
+        level_mask |= (*iter).second.level_mask;
+    }
+
+    // Nothing is formatted unless some client wants it and the global masks allow it
+    debug_sub_type_mask  = type_mask & debug_type_mask;
+    debug_sub_level_mask = level_mask & debug_level_mask;
+}
+void LTE_fdd_enb_interface::send_debug_to_subs(LTE_FDD_ENB_DEBUG_TYPE_ENUM  type,
+                                               LTE_FDD_ENB_DEBUG_LEVEL_ENUM level,
+                                               std::string                  msg)
+{
+    std::map<uint32, LTE_FDD_ENB_DEBUG_SUB_STRUCT>::iterator iter;
+
+    // Caller holds debug_connect_mutex, slow clients drop their own messages
+    for(iter=debug_subs.begin(); iter!=debug_subs.end(); iter++)
+    {
+        if(((*iter).second.type_mask & (1 << type)) &&
+           ((*iter).second.level_mask & (1 << level)))
+        {
+            debug_socket->send((*iter).first, msg);
+        }
+    }
+}
@@ -52,6 +52,7 @@
 #include "LTE_fdd_enb_timer_mgr.h"
 #include "LTE_fdd_enb_mac.h"
 #include "LTE_fdd_enb_phy.h"
+#include "LTE_fdd_enb_rlc.h"
 
 /*******************************************************************************
                               DEFINES
@@ -70,6 +71,13 @@
 LTE_fdd_enb_mac* LTE_fdd_enb_mac::instance = NULL;
 boost::mutex     mac_instance_mutex;
 
+// Redundancy version sequence for HARQ retransmissions 3GPP TS 36.321 v10.2.0 section 5.4.2.2
+static const uint32 harq_rv_idx[4] = {0, 2, 3, 1};
+
+// Wideband CQI to DL MCS, following the spectral efficiencies of 3GPP TS 36.213 v10.3.0 table 7.2.3-1
+// and capped at 16QAM since 64QAM is not yet used for DL data
+static const uint8 cqi_to_mcs[16] = {0, 0, 0, 2, 4, 6, 8, 11, 13, 16, 16, 16, 16, 16, 16, 16};
+
 /*******************************************************************************
                               CLASS IMPLEMENTATIONS
 *******************************************************************************/
@@ -120,7 +128,6 @@ void LTE_fdd_enb_mac::start(LTE_fdd_enb_interface *iface)
     boost::mutex::scoped_lock  lock(start_mutex);
     LTE_fdd_enb_msgq_cb        phy_cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_mac, &LTE_fdd_enb_mac::handle_phy_msg>, this);
     LTE_fdd_enb_msgq_cb        rlc_cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_mac, &LTE_fdd_enb_mac::handle_rlc_msg>, this);
-    LTE_fdd_enb_cnfg_db       *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
     uint32                     i;
 
     if(!started)
@@ -134,30 +141,35 @@ void LTE_fdd_enb_mac::start(LTE_fdd_enb_interface *iface)
                                              rlc_cb);
         mac_phy_mq    = new boost::interprocess::message_queue(boost::interprocess::open_only,
                                                                "mac_phy_mq");
-        mac_rlc_mq    = new boost::interprocess::message_queue(boost::interprocess::open_only,
-                                                               "mac_rlc_mq");
+        worker_mgr    = LTE_fdd_enb_worker_mgr::get_instance();
 
         // Scheduler
-        cnfg_db->get_sys_info(sys_info);
         for(i=0; i<10; i++)
         {
             sched_dl_subfr[i].dl_allocations.N_alloc = 0;
             sched_dl_subfr[i].ul_allocations.N_alloc = 0;
-            sched_dl_subfr[i].N_avail_prbs           = sys_info.N_rb_dl - get_n_reserved_prbs(i);
-            sched_dl_subfr[i].N_sched_prbs           = 0;
             sched_dl_subfr[i].current_tti            = i;
 
             sched_ul_subfr[i].decodes.N_alloc = 0;
-            sched_ul_subfr[i].N_avail_prbs    = sys_info.N_rb_ul;
-            sched_ul_subfr[i].N_sched_prbs    = 0;
+            sched_ul_subfr[i].N_pucch         = 0;
             sched_ul_subfr[i].current_tti     = i;
-            sched_ul_subfr[i].next_prb        = 0;
         }
         sched_dl_subfr[0].current_tti = 10;
         sched_dl_subfr[1].current_tti = 11;
         sched_dl_subfr[2].current_tti = 12;
         sched_cur_dl_subfn            = 3;
         sched_cur_ul_subfn            = 0;
+        for(i=0; i<10; i++)
+        {
+            init_dl_prb_mask(i);
+            init_ul_prb_mask(i);
+        }
+        liblte_mac_sched_init(&sched_dl_policy,
+                              LIBLTE_MAC_SCHED_POLICY_PROPORTIONAL_FAIR,
+                              LIBLTE_MAC_RA_TYPE_2);
+        liblte_mac_sched_init(&sched_ul_policy,
+                              LIBLTE_MAC_SCHED_POLICY_PROPORTIONAL_FAIR,
+                              LIBLTE_MAC_RA_TYPE_2);
     }
 }
 void LTE_fdd_enb_mac::stop(void)
@@ -210,7 +222,8 @@ void LTE_fdd_enb_mac::handle_phy_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
         }
     }else{
         // Forward message to RLC
-        mac_rlc_mq->send(&msg, sizeof(msg), 0);
+        worker_mgr->send(msg->user, msg->type, msg->dest_layer, &msg->msg, sizeof(LTE_FDD_ENB_MESSAGE_UNION));
+        delete msg;
     }
 }
 void LTE_fdd_enb_mac::handle_rlc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
@@ -243,17 +256,10 @@ void LTE_fdd_enb_mac::handle_rlc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
 /****************************/
 /*    External Interface    */
 /****************************/
-void LTE_fdd_enb_mac::update_sys_info(void)
-{
-    LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
-
-    sys_info_mutex.lock();
-    cnfg_db->get_sys_info(sys_info);
-    sys_info_mutex.unlock();
-}
 void LTE_fdd_enb_mac::sched_ul(LTE_fdd_enb_user *user,
                                uint32            requested_tbs)
 {
+    LTE_fdd_enb_cnfg_reader      cnfg;
     LIBLTE_PHY_ALLOCATION_STRUCT alloc;
 
     alloc.pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
@@ -265,15 +271,11 @@ void LTE_fdd_enb_mac::sched_ul(LTE_fdd_enb_user *user,
     alloc.tx_mode        = 1;
     alloc.rnti           = user->get_c_rnti();
     alloc.tpc            = LIBLTE_PHY_TPC_COMMAND_DCI_0_3_4_DB_NEG_1;
-    alloc.ndi            = user->get_ul_ndi();
-    user->flip_ul_ndi();
-    sys_info_mutex.lock();
     liblte_phy_get_tbs_mcs_and_n_prb_for_ul(requested_tbs,
-                                            sys_info.N_rb_ul,
+                                            cnfg.sys_info->N_rb_ul - 2*get_n_pucch_prbs(),
                                             &alloc.tbs,
                                             &alloc.mcs,
                                             &alloc.N_prb);
-    sys_info_mutex.unlock();
 
     // Add the allocation to the scheduling queue
     if(LTE_FDD_ENB_ERROR_NONE != add_to_ul_sched_queue((sched_ul_subfr[sched_cur_ul_subfn].current_tti + 4) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1),
@@ -321,12 +323,11 @@ void LTE_fdd_enb_mac::handle_ready_to_send(LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT
             sched_dl_subfr[sched_cur_dl_subfn].current_tti = (sched_dl_subfr[sched_cur_dl_subfn].current_tti + 10) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
 
             // Clear the subframe
-            sys_info_mutex.lock();
+            sched_mutex.lock();
             sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc = 0;
             sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc = 0;
-            sched_dl_subfr[sched_cur_dl_subfn].N_avail_prbs           = sys_info.N_rb_dl - get_n_reserved_prbs(sched_dl_subfr[sched_cur_dl_subfn].current_tti);
-            sched_dl_subfr[sched_cur_dl_subfn].N_sched_prbs           = 0;
-            sys_info_mutex.unlock();
+            init_dl_prb_mask(sched_cur_dl_subfn);
+            sched_mutex.unlock();
 
             // Advance the subframe number
             sched_cur_dl_subfn = (sched_cur_dl_subfn + 1) % 10;
@@ -347,9 +348,11 @@ void LTE_fdd_enb_mac::handle_ready_to_send(LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT
             sched_ul_subfr[sched_cur_ul_subfn].current_tti = (sched_ul_subfr[sched_cur_ul_subfn].current_tti + 10) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
 
             // Clear the subframe
+            sched_mutex.lock();
             sched_ul_subfr[sched_cur_ul_subfn].decodes.N_alloc = 0;
-            sched_ul_subfr[sched_cur_ul_subfn].N_sched_prbs    = 0;
-            sched_ul_subfr[sched_cur_ul_subfn].next_prb        = 0;
+            sched_ul_subfr[sched_cur_ul_subfn].N_pucch         = 0;
+            init_ul_prb_mask(sched_cur_ul_subfn);
+            sched_mutex.unlock();
 
             // Advance the subframe number
             sched_cur_ul_subfn = (sched_cur_ul_subfn + 1) % 10;
@@ -372,15 +375,14 @@ void LTE_fdd_enb_mac::handle_ready_to_send(LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT
     sched_ul_subfr[sched_cur_ul_subfn].current_tti = (sched_ul_subfr[sched_cur_ul_subfn].current_tti + 10) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
 
     // Clear the subframes
-    sys_info_mutex.lock();
+    sched_mutex.lock();
     sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc = 0;
     sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc = 0;
-    sched_dl_subfr[sched_cur_dl_subfn].N_avail_prbs           = sys_info.N_rb_dl - get_n_reserved_prbs(sched_dl_subfr[sched_cur_dl_subfn].current_tti);
-    sched_dl_subfr[sched_cur_dl_subfn].N_sched_prbs           = 0;
     sched_ul_subfr[sched_cur_ul_subfn].decodes.N_alloc        = 0;
-    sched_ul_subfr[sched_cur_ul_subfn].N_sched_prbs           = 0;
-    sched_ul_subfr[sched_cur_ul_subfn].next_prb               = 0;
-    sys_info_mutex.unlock();
+    sched_ul_subfr[sched_cur_ul_subfn].N_pucch                = 0;
+    init_dl_prb_mask(sched_cur_dl_subfn);
+    init_ul_prb_mask(sched_cur_ul_subfn);
+    sched_mutex.unlock();
 
     // Advance the subframe numbers
     sched_cur_dl_subfn = (sched_cur_dl_subfn + 1) % 10;
@@ -402,11 +404,38 @@ void LTE_fdd_enb_mac::handle_prach_decode(LTE_FDD_ENB_PRACH_DECODE_MSG_STRUCT *p
 }
 void LTE_fdd_enb_mac::handle_pucch_decode(LTE_FDD_ENB_PUCCH_DECODE_MSG_STRUCT *pucch_decode)
 {
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                              __FILE__,
-                              __LINE__,
-                              "Not handling PUCCH_DECODE");
+    LTE_fdd_enb_user_mgr *user_mgr = LTE_fdd_enb_user_mgr::get_instance();
+    LTE_fdd_enb_user     *user     = NULL;
+
+    if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(pucch_decode->rnti, &user))
+    {
+        if(pucch_decode->harq_ack_present)
+        {
+            handle_dl_harq_feedback(user, pucch_decode->current_tti, pucch_decode->harq_ack);
+        }
+        if(pucch_decode->cqi_present)
+        {
+            user->set_dl_cqi(pucch_decode->cqi);
+        }
+        if(pucch_decode->sr_present)
+        {
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                      __FILE__,
+                                      __LINE__,
+                                      "Scheduling request for RNTI=%u CURRENT_TTI=%u",
+                                      pucch_decode->rnti,
+                                      pucch_decode->current_tti);
+            sched_ul(user, LTE_FDD_ENB_SR_GRANT_TBS);
+        }
+    }else{
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                  __FILE__,
+                                  __LINE__,
+                                  "PUCCH decode for invalid RNTI (%u)",
+                                  pucch_decode->rnti);
+    }
 }
 void LTE_fdd_enb_mac::handle_pusch_decode(LTE_FDD_ENB_PUSCH_DECODE_MSG_STRUCT *pusch_decode)
 {
@@ -417,53 +446,58 @@ void LTE_fdd_enb_mac::handle_pusch_decode(LTE_FDD_ENB_PUSCH_DECODE_MSG_STRUCT *p
     // Find the user
     if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(pusch_decode->rnti, &user))
     {
-        // Reset the C-RNTI release timer
-        user_mgr->reset_c_rnti_timer(pusch_decode->rnti);
-
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  &pusch_decode->msg,
-                                  "PUSCH decode for RNTI=%u CURRENT_TTI=%u",
-                                  pusch_decode->rnti,
-                                  pusch_decode->current_tti);
-        interface->send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_UL,
-                                 pusch_decode->rnti,
-                                 pusch_decode->current_tti,
-                                 pusch_decode->msg.msg,
-                                 pusch_decode->msg.N_bits);
+        handle_ul_harq_result(user, pusch_decode->current_tti, pusch_decode->crc_pass);
 
-        // Set the correct channel type
-        user->pusch_mac_pdu.chan_type = LIBLTE_MAC_CHAN_TYPE_ULSCH;
-
-        // Unpack MAC PDU
-        liblte_mac_unpack_mac_pdu(&pusch_decode->msg,
-                                  &user->pusch_mac_pdu);
-
-        for(i=0; i<user->pusch_mac_pdu.N_subheaders; i++)
+        if(pusch_decode->crc_pass)
         {
-            if(LIBLTE_MAC_ULSCH_CCCH_LCID == user->pusch_mac_pdu.subheader[i].lcid)
+            // Reset the C-RNTI release timer
+            user_mgr->reset_c_rnti_timer(pusch_decode->rnti);
+
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                      __FILE__,
+                                      __LINE__,
+                                      &pusch_decode->msg,
+                                      "PUSCH decode for RNTI=%u CURRENT_TTI=%u",
+                                      pusch_decode->rnti,
+                                      pusch_decode->current_tti);
+            interface->send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_UL,
+                                     pusch_decode->rnti,
+                                     pusch_decode->current_tti,
+                                     pusch_decode->msg.msg,
+                                     pusch_decode->msg.N_bits);
+
+            // Set the correct channel type
+            user->pusch_mac_pdu.chan_type = LIBLTE_MAC_CHAN_TYPE_ULSCH;
+
+            // Unpack MAC PDU
+            liblte_mac_unpack_mac_pdu(&pusch_decode->msg,
+                                      &user->pusch_mac_pdu);
+
+            for(i=0; i<user->pusch_mac_pdu.N_subheaders; i++)
             {
-                handle_ulsch_ccch_sdu(user, user->pusch_mac_pdu.subheader[i].lcid, &user->pusch_mac_pdu.subheader[i].payload.sdu);
-            }else if(LIBLTE_MAC_ULSCH_DCCH_LCID_BEGIN <= user->pusch_mac_pdu.subheader[i].lcid &&
-                     LIBLTE_MAC_ULSCH_DCCH_LCID_END   >= user->pusch_mac_pdu.subheader[i].lcid){
-                handle_ulsch_dcch_sdu(user, user->pusch_mac_pdu.subheader[i].lcid, &user->pusch_mac_pdu.subheader[i].payload.sdu);
-            }else if(LIBLTE_MAC_ULSCH_EXT_POWER_HEADROOM_REPORT_LCID == user->pusch_mac_pdu.subheader[i].lcid){
-                handle_ulsch_ext_power_headroom_report(user, &user->pusch_mac_pdu.subheader[i].payload.ext_power_headroom);
-            }else if(LIBLTE_MAC_ULSCH_POWER_HEADROOM_REPORT_LCID == user->pusch_mac_pdu.subheader[i].lcid){
-                handle_ulsch_power_headroom_report(user, &user->pusch_mac_pdu.subheader[i].payload.power_headroom);
-            }else if(LIBLTE_MAC_ULSCH_C_RNTI_LCID == user->pusch_mac_pdu.subheader[i].lcid){
-                handle_ulsch_c_rnti(&user, &user->pusch_mac_pdu.subheader[i].payload.c_rnti);
-            }else if(LIBLTE_MAC_ULSCH_TRUNCATED_BSR_LCID == user->pusch_mac_pdu.subheader[i].lcid){
-                handle_ulsch_truncated_bsr(user, &user->pusch_mac_pdu.subheader[i].payload.truncated_bsr);
-            }else if(LIBLTE_MAC_ULSCH_SHORT_BSR_LCID == user->pusch_mac_pdu.subheader[i].lcid){
-                handle_ulsch_short_bsr(user, &user->pusch_mac_pdu.subheader[i].payload.short_bsr);
-            }else if(LIBLTE_MAC_ULSCH_LONG_BSR_LCID == user->pusch_mac_pdu.subheader[i].lcid){
-                handle_ulsch_long_bsr(user, &user->pusch_mac_pdu.subheader[i].payload.long_bsr);
+                if(LIBLTE_MAC_ULSCH_CCCH_LCID == user->pusch_mac_pdu.subheader[i].lcid)
+                {
+                    handle_ulsch_ccch_sdu(user, user->pusch_mac_pdu.subheader[i].lcid, &user->pusch_mac_pdu.subheader[i].payload.sdu);
+                }else if(LIBLTE_MAC_ULSCH_DCCH_LCID_BEGIN <= user->pusch_mac_pdu.subheader[i].lcid &&
+                         LIBLTE_MAC_ULSCH_DCCH_LCID_END   >= user->pusch_mac_pdu.subheader[i].lcid){
+                    handle_ulsch_dcch_sdu(user, user->pusch_mac_pdu.subheader[i].lcid, &user->pusch_mac_pdu.subheader[i].payload.sdu);
+                }else if(LIBLTE_MAC_ULSCH_EXT_POWER_HEADROOM_REPORT_LCID == user->pusch_mac_pdu.subheader[i].lcid){
+                    handle_ulsch_ext_power_headroom_report(user, &user->pusch_mac_pdu.subheader[i].payload.ext_power_headroom);
+                }else if(LIBLTE_MAC_ULSCH_POWER_HEADROOM_REPORT_LCID == user->pusch_mac_pdu.subheader[i].lcid){
+                    handle_ulsch_power_headroom_report(user, &user->pusch_mac_pdu.subheader[i].payload.power_headroom);
+                }else if(LIBLTE_MAC_ULSCH_C_RNTI_LCID == user->pusch_mac_pdu.subheader[i].lcid){
+                    handle_ulsch_c_rnti(&user, &user->pusch_mac_pdu.subheader[i].payload.c_rnti);
+                }else if(LIBLTE_MAC_ULSCH_TRUNCATED_BSR_LCID == user->pusch_mac_pdu.subheader[i].lcid){
+                    handle_ulsch_truncated_bsr(user, &user->pusch_mac_pdu.subheader[i].payload.truncated_bsr);
+                }else if(LIBLTE_MAC_ULSCH_SHORT_BSR_LCID == user->pusch_mac_pdu.subheader[i].lcid){
+                    handle_ulsch_short_bsr(user, &user->pusch_mac_pdu.subheader[i].payload.short_bsr);
+                }else if(LIBLTE_MAC_ULSCH_LONG_BSR_LCID == user->pusch_mac_pdu.subheader[i].lcid){
+                    handle_ulsch_long_bsr(user, &user->pusch_mac_pdu.subheader[i].payload.long_bsr);
+                }
             }
         }
-    }else{
+    }else if(pusch_decode->crc_pass){
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                   LTE_FDD_ENB_DEBUG_LEVEL_MAC,
                                   __FILE__,
@@ -483,10 +517,38 @@ void LTE_fdd_enb_mac::handle_sdu_ready(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT *sdu
     LIBLTE_MAC_PDU_STRUCT         mac_pdu;
     LIBLTE_PHY_ALLOCATION_STRUCT  alloc;
     LIBLTE_BYTE_MSG_STRUCT       *sdu;
+    std::list<uint16>::iterator   iter;
     uint32                        current_tti;
+    bool                          found;
 
-    if(LTE_FDD_ENB_ERROR_NONE == sdu_ready->rb->get_next_mac_sdu(&sdu))
+    if(LTE_FDD_ENB_RLC_CONFIG_TM != sdu_ready->rb->get_rlc_config())
     {
+        // UM and AM bearers are pulled from RLC once the scheduler knows
+        // how many bytes the user can be given
+        user = sdu_ready->user;
+        dl_sched_queue_mutex.lock();
+        found = false;
+        for(iter=dl_pull_queue.begin(); iter!=dl_pull_queue.end(); iter++)
+        {
+            if((*iter) == user->get_c_rnti())
+            {
+                found = true;
+            }
+        }
+        if(!found)
+        {
+            dl_pull_queue.push_back(user->get_c_rnti());
+        }
+        dl_sched_queue_mutex.unlock();
+
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Data available for RNTI=%u and RB=%s",
+                                  user->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
+    }else if(LTE_FDD_ENB_ERROR_NONE == sdu_ready->rb->get_next_mac_sdu(&sdu)){
         user = sdu_ready->user;
 
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
@@ -499,24 +561,7 @@ void LTE_fdd_enb_mac::handle_sdu_ready(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT *sdu
                                   LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
 
         // Fill in the allocation
-        alloc.pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
-        alloc.mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
-        alloc.chan_type      = LIBLTE_PHY_CHAN_TYPE_DLSCH;
-        alloc.rv_idx         = 0;
-        alloc.N_codewords    = 1;
-        sys_info_mutex.lock();
-        if(1 == sys_info.N_ant)
-        {
-            alloc.tx_mode = 1;
-        }else{
-            alloc.tx_mode = 2;
-        }
-        sys_info_mutex.unlock();
-        alloc.rnti = user->get_c_rnti();
-        alloc.mcs  = 0;
-        alloc.tpc  = LIBLTE_PHY_TPC_COMMAND_DCI_1_1A_1B_1D_2_3_DB_ZERO;
-        alloc.ndi  = user->get_dl_ndi();
-        user->flip_dl_ndi();
+        init_dl_alloc(&alloc, user);
 
         // Pack the PDU
         mac_pdu.chan_type = LIBLTE_MAC_CHAN_TYPE_DLSCH;
@@ -611,11 +656,11 @@ void LTE_fdd_enb_mac::handle_ulsch_ccch_sdu(LTE_fdd_enb_user       *user,
         // Signal RLC
         rlc_pdu_ready.user = user;
         rlc_pdu_ready.rb   = rb;
-        LTE_fdd_enb_msgq::send(mac_rlc_mq,
-                               LTE_FDD_ENB_MESSAGE_TYPE_RLC_PDU_READY,
-                               LTE_FDD_ENB_DEST_LAYER_RLC,
-                               (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_pdu_ready,
-                               sizeof(LTE_FDD_ENB_RLC_PDU_READY_MSG_STRUCT));
+        worker_mgr->send(rlc_pdu_ready.user,
+                         LTE_FDD_ENB_MESSAGE_TYPE_RLC_PDU_READY,
+                         LTE_FDD_ENB_DEST_LAYER_RLC,
+                         (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_pdu_ready,
+                         sizeof(LTE_FDD_ENB_RLC_PDU_READY_MSG_STRUCT));
     }else{
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                   LTE_FDD_ENB_DEBUG_LEVEL_MAC,
@@ -670,11 +715,11 @@ void LTE_fdd_enb_mac::handle_ulsch_dcch_sdu(LTE_fdd_enb_user       *user,
             // Signal RLC
             rlc_pdu_ready.user = user;
             rlc_pdu_ready.rb   = rb;
-            LTE_fdd_enb_msgq::send(mac_rlc_mq,
-                                   LTE_FDD_ENB_MESSAGE_TYPE_RLC_PDU_READY,
-                                   LTE_FDD_ENB_DEST_LAYER_RLC,
-                                   (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_pdu_ready,
-                                   sizeof(LTE_FDD_ENB_RLC_PDU_READY_MSG_STRUCT));
+            worker_mgr->send(rlc_pdu_ready.user,
+                             LTE_FDD_ENB_MESSAGE_TYPE_RLC_PDU_READY,
+                             LTE_FDD_ENB_DEST_LAYER_RLC,
+                             (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_pdu_ready,
+                             sizeof(LTE_FDD_ENB_RLC_PDU_READY_MSG_STRUCT));
         }
     }else{
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
@@ -757,6 +802,188 @@ void LTE_fdd_enb_mac::handle_ulsch_long_bsr(LTE_fdd_enb_user              *user,
                               long_bsr->buffer_size_3);
 }
 
+/**************/
+/*    HARQ    */
+/**************/
+void LTE_fdd_enb_mac::handle_dl_harq_feedback(LTE_fdd_enb_user *user,
+                                              uint32            current_tti,
+                                              bool              ack)
+{
+    LTE_FDD_ENB_DL_HARQ_PROC_STRUCT *harq;
+    uint32                           tx_tti;
+    uint32                           proc;
+
+    // Feedback in subframe n is for the PDSCH sent in subframe n-4
+    tx_tti = (current_tti + LTE_FDD_ENB_CURRENT_TTI_MAX + 1 - 4) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+
+    if(LTE_FDD_ENB_ERROR_NONE == user->find_dl_harq_proc(tx_tti, &proc))
+    {
+        harq = user->get_dl_harq_proc(proc);
+
+        if(ack)
+        {
+            user->release_dl_harq_proc(proc);
+        }else if(LTE_FDD_ENB_MAX_DL_HARQ_TX > harq->N_tx){
+            // Resend the same transport block with the next redundancy version
+            harq->alloc.rv_idx = harq_rv_idx[harq->N_tx % 4];
+            harq->tx_tti       = (sched_dl_subfr[sched_cur_dl_subfn].current_tti + 4) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+            harq->N_tx++;
+            if(LTE_FDD_ENB_ERROR_NONE != add_to_dl_sched_queue(harq->tx_tti,
+                                                               NULL,
+                                                               &harq->alloc))
+            {
+                user->release_dl_harq_proc(proc);
+            }
+        }else{
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                      __FILE__,
+                                      __LINE__,
+                                      "DL HARQ process %u failed after %u transmissions for RNTI=%u",
+                                      proc,
+                                      harq->N_tx,
+                                      user->get_c_rnti());
+            user->release_dl_harq_proc(proc);
+        }
+    }
+}
+void LTE_fdd_enb_mac::handle_ul_harq_result(LTE_fdd_enb_user *user,
+                                            uint32            current_tti,
+                                            bool              crc_pass)
+{
+    LTE_FDD_ENB_UL_HARQ_PROC_STRUCT *harq = user->get_ul_harq_proc(current_tti);
+
+    // Ignore results for a transmission the process has already moved on from
+    if(harq->active &&
+       harq->tx_tti == current_tti)
+    {
+        if(crc_pass)
+        {
+            user->release_ul_harq_proc(current_tti);
+        }else if(LTE_FDD_ENB_MAX_UL_HARQ_TX > harq->N_tx){
+            // The UE retransmits non-adaptively 8 subframes later on the PHICH NACK
+            harq->alloc.rv_idx = harq_rv_idx[harq->N_tx % 4];
+            harq->N_tx++;
+            if(LTE_FDD_ENB_ERROR_NONE != add_to_ul_retx_sched_queue((current_tti + 8) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1),
+                                                                    &harq->alloc))
+            {
+                user->release_ul_harq_proc(current_tti);
+            }
+        }else{
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                      __FILE__,
+                                      __LINE__,
+                                      "UL HARQ process %u failed after %u transmissions for RNTI=%u",
+                                      current_tti % LTE_FDD_ENB_N_HARQ_PROCS,
+                                      harq->N_tx,
+                                      user->get_c_rnti());
+            user->release_ul_harq_proc(current_tti);
+        }
+    }
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::start_dl_harq_proc(LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT *dl_sched,
+                                                           uint32                             current_tti)
+{
+    LTE_fdd_enb_user_mgr            *user_mgr = LTE_fdd_enb_user_mgr::get_instance();
+    LTE_fdd_enb_user                *user     = NULL;
+    LTE_FDD_ENB_DL_HARQ_PROC_STRUCT *harq;
+    LTE_FDD_ENB_ERROR_ENUM           err      = LTE_FDD_ENB_ERROR_NONE;
+    uint32                           proc;
+
+    if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(dl_sched->alloc.rnti, &user))
+    {
+        if(dl_sched->harq_retx)
+        {
+            harq         = user->get_dl_harq_proc(dl_sched->alloc.harq_process);
+            harq->tx_tti = current_tti;
+        }else{
+            err = user->get_free_dl_harq_proc(current_tti, &proc);
+            if(LTE_FDD_ENB_ERROR_NONE == err)
+            {
+                harq                         = user->get_dl_harq_proc(proc);
+                harq->ndi                   ^= 1;
+                dl_sched->alloc.harq_process = proc;
+                dl_sched->alloc.ndi          = harq->ndi;
+                dl_sched->alloc.rv_idx       = 0;
+                memcpy(&harq->alloc, &dl_sched->alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+                harq->tx_tti                 = current_tti;
+                harq->N_tx                   = 1;
+                harq->active                 = true;
+            }
+        }
+    }
+
+    return(err);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::start_ul_harq_proc(LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT  *ul_sched,
+                                                           uint32                              current_tti,
+                                                           LIBLTE_PHY_SOFT_BUFFER_STRUCT     **soft_buffer)
+{
+    LTE_fdd_enb_user_mgr            *user_mgr = LTE_fdd_enb_user_mgr::get_instance();
+    LTE_fdd_enb_user                *user     = NULL;
+    LTE_FDD_ENB_UL_HARQ_PROC_STRUCT *harq;
+    LTE_FDD_ENB_ERROR_ENUM           err      = LTE_FDD_ENB_ERROR_NONE;
+
+    *soft_buffer = NULL;
+    if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(ul_sched->alloc.rnti, &user))
+    {
+        // FDD uplink HARQ is synchronous, the process is fixed by the subframe
+        harq = user->get_ul_harq_proc(current_tti);
+        if(harq->active &&
+           harq->tx_tti == current_tti)
+        {
+            // A retransmission already occupies this process
+            err = LTE_FDD_ENB_ERROR_NO_FREE_HARQ_PROC;
+        }else{
+            // New transmission on this process, flush anything left over
+            user->release_ul_harq_proc(current_tti);
+
+            harq->ndi                   ^= 1;
+            ul_sched->alloc.harq_process = current_tti % LTE_FDD_ENB_N_HARQ_PROCS;
+            ul_sched->alloc.ndi          = harq->ndi;
+            ul_sched->alloc.rv_idx       = 0;
+            memcpy(&harq->alloc, &ul_sched->alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+            harq->tx_tti                 = current_tti;
+            harq->N_tx                   = 1;
+            harq->active                 = true;
+            if(LTE_FDD_ENB_ERROR_NONE == user_mgr->alloc_soft_buffer(ul_sched->alloc.tbs, &harq->soft_buffer))
+            {
+                *soft_buffer = &harq->soft_buffer;
+            }
+        }
+    }
+
+    return(err);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::continue_ul_harq_proc(LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT  *ul_sched,
+                                                              uint32                              current_tti,
+                                                              LIBLTE_PHY_SOFT_BUFFER_STRUCT     **soft_buffer)
+{
+    LTE_fdd_enb_user_mgr            *user_mgr = LTE_fdd_enb_user_mgr::get_instance();
+    LTE_fdd_enb_user                *user     = NULL;
+    LTE_FDD_ENB_UL_HARQ_PROC_STRUCT *harq;
+    LTE_FDD_ENB_ERROR_ENUM           err      = LTE_FDD_ENB_ERROR_HARQ_PROC_NOT_FOUND;
+
+    *soft_buffer = NULL;
+    if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(ul_sched->alloc.rnti, &user))
+    {
+        harq = user->get_ul_harq_proc(current_tti);
+        if(harq->active &&
+           harq->tx_tti == (current_tti + LTE_FDD_ENB_CURRENT_TTI_MAX + 1 - 8) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1))
+        {
+            harq->tx_tti = current_tti;
+            if(NULL != harq->soft_buffer.pool)
+            {
+                *soft_buffer = &harq->soft_buffer;
+            }
+            err = LTE_FDD_ENB_ERROR_NONE;
+        }
+    }
+
+    return(err);
+}
+
 /***************************/
 /*    Data Constructors    */
 /***************************/
@@ -765,6 +992,7 @@ void LTE_fdd_enb_mac::construct_random_access_response(uint8  preamble,
                                                        uint32 current_tti)
 {
     LTE_fdd_enb_user_mgr         *user_mgr = LTE_fdd_enb_user_mgr::get_instance();
+    LTE_fdd_enb_cnfg_reader       cnfg;
     LTE_fdd_enb_user             *user     = NULL;
     LIBLTE_MAC_RAR_STRUCT         rar;
     LIBLTE_PHY_ALLOCATION_STRUCT  dl_alloc;
@@ -794,13 +1022,11 @@ void LTE_fdd_enb_mac::construct_random_access_response(uint8  preamble,
         ul_alloc.N_layers       = 1;
         ul_alloc.tx_mode        = 1; // From 36.213 v10.3.0 section 7.1
         ul_alloc.rnti           = rar.temp_c_rnti;
-        sys_info_mutex.lock();
         liblte_phy_get_tbs_mcs_and_n_prb_for_ul(56,
-                                                sys_info.N_rb_ul,
+                                                cnfg.sys_info->N_rb_ul - 2*get_n_pucch_prbs(),
                                                 &ul_alloc.tbs,
                                                 &ul_alloc.mcs,
                                                 &ul_alloc.N_prb);
-        sys_info_mutex.unlock();
 
         // Fill in the RAR
         rar.hdr_type       = LIBLTE_MAC_RAR_HEADER_TYPE_RAPID;
@@ -849,22 +1075,44 @@ void LTE_fdd_enb_mac::construct_random_access_response(uint8  preamble,
 /*******************/
 void LTE_fdd_enb_mac::scheduler(void)
 {
-    boost::mutex::scoped_lock           lock(sys_info_mutex);
-    LTE_fdd_enb_phy                    *phy = LTE_fdd_enb_phy::get_instance();
-    LTE_FDD_ENB_RAR_SCHED_QUEUE_STRUCT *rar_sched;
-    LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT  *dl_sched;
-    LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT  *ul_sched;
-    uint32                              N_cce;
-    uint32                              N_pad;
-    uint32                              resp_win_start;
-    uint32                              resp_win_stop;
-    uint32                              i;
-    uint32                              rb_start;
-    uint32                              riv;
-    int32                               N_avail_dl_prbs;
-    int32                               N_avail_ul_prbs;
-    int32                               N_avail_dcis;
-    bool                                sched_out_of_headroom;
+    boost::mutex::scoped_lock                                lock(sched_mutex);
+    LTE_fdd_enb_phy                                         *phy = LTE_fdd_enb_phy::get_instance();
+    LTE_FDD_ENB_RAR_SCHED_QUEUE_STRUCT                      *rar_sched;
+    LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT                       *dl_sched;
+    LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT                       *ul_sched;
+    LIBLTE_PHY_SOFT_BUFFER_STRUCT                           *soft_buffer;
+    LTE_fdd_enb_user_mgr                                    *user_mgr = LTE_fdd_enb_user_mgr::get_instance();
+    LTE_fdd_enb_cnfg_reader                                  cnfg;
+    LTE_FDD_ENB_PUCCH_SCHEDULE_STRUCT                       *pucch;
+    LTE_FDD_ENB_PUCCH_CNFG_STRUCT                           *pucch_cnfg;
+    LTE_fdd_enb_user                                        *user;
+    LTE_FDD_ENB_UL_HARQ_PROC_STRUCT                         *ul_harq;
+    std::list<LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT*>::iterator  dl_iter;
+    std::list<LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT*>::iterator  iter;
+    std::list<LTE_fdd_enb_user*>::iterator                   user_iter;
+    std::list<LTE_fdd_enb_user*>                             pucch_users;
+    std::list<uint16>::iterator                              pull_iter;
+    LIBLTE_MAC_PRB_MASK_STRUCT                               ul_prb_mask;
+    LIBLTE_MAC_RB_ALLOC_STRUCT                               dl_rb_alloc;
+    LIBLTE_MAC_RB_ALLOC_STRUCT                               ul_rb_alloc;
+    uint32                                                   N_cce;
+    uint32                                                   N_bytes;
+    uint32                                                   N_bytes_allowed;
+    uint32                                                   N_prb;
+    uint32                                                   N_sched_ue;
+    uint32                                                   N_grant;
+    uint32                                                   resp_win_start;
+    uint32                                                   resp_win_stop;
+    uint32                                                   proc;
+    uint32                                                   i;
+    int32                                                    N_avail_dcis;
+    bool                                                     sched_out_of_headroom;
+    bool                                                     found;
+    bool                                                     harq_free;
+    bool                                                     gbr;
+    bool                                                     sr_due;
+    bool                                                     cqi_due;
+    float                                                    qos_weight;
 
     // Get the number of CCEs for the next subframe
     N_cce = phy->get_n_cce();
@@ -881,7 +1129,7 @@ void LTE_fdd_enb_mac::scheduler(void)
         resp_win_start = (rar_sched->current_tti + 3) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
 
         // Determine when the response window stops
-        resp_win_stop = (resp_win_start + liblte_rrc_ra_response_window_size_num[sys_info.sib2.rr_config_common_sib.rach_cnfg.ra_resp_win_size]) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+        resp_win_stop = (resp_win_start + liblte_rrc_ra_response_window_size_num[cnfg.sys_info->sib2.rr_config_common_sib.rach_cnfg.ra_resp_win_size]) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
 
         // Take into account the SFN wrap
         // FIXME: Test this
@@ -908,43 +1156,39 @@ void LTE_fdd_enb_mac::scheduler(void)
                                      rar_sched->dl_alloc.msg.N_bits);
             liblte_phy_get_tbs_mcs_and_n_prb_for_dl(rar_sched->dl_alloc.msg.N_bits,
                                                     sched_cur_dl_subfn,
-                                                    sys_info.N_rb_dl,
+                                                    cnfg.sys_info->N_rb_dl,
                                                     rar_sched->dl_alloc.rnti,
                                                     &rar_sched->dl_alloc.tbs,
                                                     &rar_sched->dl_alloc.mcs,
                                                     &rar_sched->dl_alloc.N_prb);
 
-            // Determine how many PRBs and DCIs are available in this subframe
-            N_avail_dl_prbs = sched_dl_subfr[sched_cur_dl_subfn].N_avail_prbs - sched_dl_subfr[sched_cur_dl_subfn].N_sched_prbs;
-            N_avail_ul_prbs = sched_ul_subfr[(sched_cur_ul_subfn+6)%10].N_avail_prbs - sched_ul_subfr[(sched_cur_ul_subfn+6)%10].N_sched_prbs;
-            N_avail_dcis    = N_cce - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
-
-            if(rar_sched->dl_alloc.N_prb <= N_avail_dl_prbs &&
-               rar_sched->ul_alloc.N_prb <= N_avail_ul_prbs &&
-               1                         <= N_avail_dcis)
+            // Determine how many DCIs are available in this subframe and
+            // find PRBs for msg3 in a copy of the UL mask so a failed DL
+            // allocation leaves the UL subframe untouched
+            N_avail_dcis = N_cce - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
+            memcpy(&ul_prb_mask, &sched_ul_prb_mask[(sched_cur_dl_subfn+6)%10], sizeof(LIBLTE_MAC_PRB_MASK_STRUCT));
+
+            if(1              <= N_avail_dcis                                                  &&
+               LIBLTE_SUCCESS == liblte_mac_alloc_prbs(&ul_prb_mask,
+                                                       LIBLTE_MAC_RA_TYPE_2,
+                                                       rar_sched->ul_alloc.N_prb,
+                                                       rar_sched->ul_alloc.N_prb,
+                                                       &ul_rb_alloc)                           &&
+               LIBLTE_SUCCESS == liblte_mac_alloc_prbs(&sched_dl_prb_mask[sched_cur_dl_subfn],
+                                                       LIBLTE_MAC_RA_TYPE_2,
+                                                       rar_sched->dl_alloc.N_prb,
+                                                       rar_sched->dl_alloc.N_prb,
+                                                       &dl_rb_alloc))
             {
-                // Determine the RB start for the UL allocation
-                rb_start                                            = sched_ul_subfr[(sched_cur_ul_subfn+6)%10].next_prb;
-                sched_ul_subfr[(sched_cur_ul_subfn+6)%10].next_prb += rar_sched->ul_alloc.N_prb;
-
-                // Fill in the PRBs for the UL allocation
-                for(i=0; i<rar_sched->ul_alloc.N_prb; i++)
-                {
-                    rar_sched->ul_alloc.prb[0][i] = rb_start+i;
-                    rar_sched->ul_alloc.prb[1][i] = rb_start+i;
-                }
+                memcpy(&sched_ul_prb_mask[(sched_cur_dl_subfn+6)%10], &ul_prb_mask, sizeof(LIBLTE_MAC_PRB_MASK_STRUCT));
 
-                // Determine the RIV for the UL and re-pack the RAR
-                if((rar_sched->ul_alloc.N_prb-1) <= (sys_info.N_rb_ul/2))
-                {
-                    riv = sys_info.N_rb_ul*(rar_sched->ul_alloc.N_prb - 1) + rb_start;
-                }else{
-                    riv = sys_info.N_rb_ul*(sys_info.N_rb_ul - rar_sched->ul_alloc.N_prb + 1) + (sys_info.N_rb_ul - 1 - rb_start);
-                }
+                // Fill in the PRBs for the DL and UL allocations
+                set_alloc_prbs(&rar_sched->dl_alloc, &dl_rb_alloc);
+                set_alloc_prbs(&rar_sched->ul_alloc, &ul_rb_alloc);
 
                 // Fill in the RBA for the UL allocation
                 // FIXME: implement 36.213 v10.3.0 section 6.2
-                rar_sched->rar.rba = riv & 0x3FF;
+                rar_sched->rar.rba = ul_rb_alloc.riv & 0x3FF;
 
                 // Re-pack the RAR
                 liblte_mac_pack_random_access_response_pdu(&rar_sched->rar,
@@ -970,6 +1214,7 @@ void LTE_fdd_enb_mac::scheduler(void)
                 memcpy(&sched_ul_subfr[(sched_cur_dl_subfn+6)%10].decodes.alloc[sched_ul_subfr[(sched_cur_dl_subfn+6)%10].decodes.N_alloc],
                        &rar_sched->ul_alloc,
                        sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+                sched_ul_subfr[(sched_cur_dl_subfn+6)%10].soft_buffer[sched_ul_subfr[(sched_cur_dl_subfn+6)%10].decodes.N_alloc] = NULL;
                 sched_ul_subfr[(sched_cur_dl_subfn+6)%10].decodes.N_alloc++;
 
                 // Remove RAR from queue
@@ -997,53 +1242,184 @@ void LTE_fdd_enb_mac::scheduler(void)
 
     // Schedule DL for the next subframe
     dl_sched_queue_mutex.lock();
-    sched_out_of_headroom = false;
-    while(0     != dl_sched_queue.size() &&
-          false == sched_out_of_headroom)
+    N_sched_ue = 0;
+    dl_iter    = dl_sched_queue.begin();
+    while(dl_sched_queue.end() != dl_iter)
     {
-        dl_sched = dl_sched_queue.front();
+        dl_sched = (*dl_iter);
 
         if(dl_sched->current_tti == sched_dl_subfr[sched_cur_dl_subfn].current_tti)
         {
-            // Pack the message and determine TBS
-            liblte_mac_pack_mac_pdu(&dl_sched->mac_pdu,
-                                    &dl_sched->alloc.msg);
-            liblte_phy_get_tbs_and_n_prb_for_dl(dl_sched->alloc.msg.N_bits,
-                                                sys_info.N_rb_dl,
-                                                dl_sched->alloc.mcs,
-                                                &dl_sched->alloc.tbs,
-                                                &dl_sched->alloc.N_prb);
+            // Retransmissions resend the stored transport block as is and
+            // allocations that waited a subframe are already padded
+            if(!dl_sched->harq_retx &&
+               !dl_sched->packed)
+            {
+                // Pack the message and determine TBS
+                liblte_mac_pack_mac_pdu(&dl_sched->mac_pdu,
+                                        &dl_sched->alloc.msg);
+                liblte_phy_get_tbs_and_n_prb_for_dl(dl_sched->alloc.msg.N_bits,
+                                                    cnfg.sys_info->N_rb_dl,
+                                                    dl_sched->alloc.mcs,
+                                                    &dl_sched->alloc.tbs,
+                                                    &dl_sched->alloc.N_prb);
+                pad_dl_mac_pdu(dl_sched);
+            }
 
-            // Pad and repack if needed
-            if(dl_sched->alloc.tbs > dl_sched->alloc.msg.N_bits)
+            // Only the oldest allocation of each user competes for the subframe
+            found = false;
+            for(i=0; i<N_sched_ue; i++)
             {
-                N_pad = (dl_sched->alloc.tbs - dl_sched->alloc.msg.N_bits)/8;
+                if(sched_dl_cand[i]->alloc.rnti == dl_sched->alloc.rnti)
+                {
+                    found = true;
+                }
+            }
+            if(LTE_FDD_ENB_ERROR_NONE != user_mgr->find_user(dl_sched->alloc.rnti, &user))
+            {
+                user = NULL;
+            }
+
+            // New transmissions need a free HARQ process
+            harq_free = true;
+            if(NULL != user &&
+               !dl_sched->harq_retx)
+            {
+                harq_free = (LTE_FDD_ENB_ERROR_NONE == user->get_free_dl_harq_proc(dl_sched->current_tti, &proc));
+            }
 
-                if(1 == N_pad)
+            if(!found                                 &&
+               harq_free                              &&
+               LIBLTE_MAC_SCHED_N_UE_MAX > N_sched_ue)
+            {
+                if(NULL != user)
                 {
-                    for(i=0; i<dl_sched->mac_pdu.N_subheaders; i++)
-                    {
-                        memcpy(&dl_sched->mac_pdu.subheader[dl_sched->mac_pdu.N_subheaders-i], &dl_sched->mac_pdu.subheader[dl_sched->mac_pdu.N_subheaders-i-1], sizeof(LIBLTE_MAC_PDU_SUBHEADER_STRUCT));
-                    }
-                    dl_sched->mac_pdu.subheader[0].lcid = LIBLTE_MAC_DLSCH_PADDING_LCID;
-                    dl_sched->mac_pdu.N_subheaders++;
-                }else if(2 == N_pad){
-                    for(i=0; i<dl_sched->mac_pdu.N_subheaders; i++)
-                    {
-                        memcpy(&dl_sched->mac_pdu.subheader[dl_sched->mac_pdu.N_subheaders-i+1], &dl_sched->mac_pdu.subheader[dl_sched->mac_pdu.N_subheaders-i-1], sizeof(LIBLTE_MAC_PDU_SUBHEADER_STRUCT));
-                    }
-                    dl_sched->mac_pdu.subheader[0].lcid  = LIBLTE_MAC_DLSCH_PADDING_LCID;
-                    dl_sched->mac_pdu.subheader[1].lcid  = LIBLTE_MAC_DLSCH_PADDING_LCID;
-                    dl_sched->mac_pdu.N_subheaders      += 2;
+                    memcpy(&sched_ue[N_sched_ue], user->get_dl_sched_ue(), sizeof(LIBLTE_MAC_SCHED_UE_STRUCT));
+                    sched_ue[N_sched_ue].cqi = user->get_dl_cqi();
                 }else{
-                    dl_sched->mac_pdu.subheader[dl_sched->mac_pdu.N_subheaders].lcid = LIBLTE_MAC_DLSCH_PADDING_LCID;
-                    dl_sched->mac_pdu.N_subheaders++;
+                    liblte_mac_sched_ue_init(&sched_ue[N_sched_ue], dl_sched->alloc.rnti);
                 }
+                sched_ue[N_sched_ue].rnti      = dl_sched->alloc.rnti;
+                sched_ue[N_sched_ue].N_prb_min = dl_sched->alloc.N_prb;
+                sched_ue[N_sched_ue].N_prb_max = dl_sched->alloc.N_prb;
+                sched_ue[N_sched_ue].retx      = dl_sched->harq_retx;
+                sched_user[N_sched_ue]         = user;
+                sched_dl_cand[N_sched_ue]      = dl_sched;
+                N_sched_ue++;
+            }
+            dl_iter++;
+        }else if(dl_sched->current_tti < sched_dl_subfr[sched_cur_dl_subfn].current_tti){
+            // Remove DL schedule from queue
+            dl_iter = dl_sched_queue.erase(dl_iter);
+            delete dl_sched;
+        }else{
+            dl_iter++;
+        }
+    }
 
-                liblte_mac_pack_mac_pdu(&dl_sched->mac_pdu,
-                                        &dl_sched->alloc.msg);
+    // Users with RLC data compete for as many PRBs as it takes to empty
+    // their buffers, the MAC PDU is built once the grant is known
+    pull_iter = dl_pull_queue.begin();
+    while(dl_pull_queue.end() != pull_iter)
+    {
+        N_bytes = 0;
+        if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(*pull_iter, &user))
+        {
+            N_bytes = get_dl_buffer_state(user);
+        }
+        if(0 == N_bytes)
+        {
+            pull_iter = dl_pull_queue.erase(pull_iter);
+            continue;
+        }
+
+        found = false;
+        for(i=0; i<N_sched_ue; i++)
+        {
+            if(sched_dl_cand[i]->alloc.rnti == *pull_iter)
+            {
+                found = true;
+            }
+        }
+        harq_free = (LTE_FDD_ENB_ERROR_NONE == user->get_free_dl_harq_proc(sched_dl_subfr[sched_cur_dl_subfn].current_tti, &proc));
+
+        // Users held back by MBR or AMBR stay queued until tokens build up
+        N_bytes_allowed = get_dl_qos_state(user, &gbr, &qos_weight);
+
+        if(!found                                       &&
+           harq_free                                    &&
+           0                         != N_bytes_allowed &&
+           LIBLTE_MAC_SCHED_N_UE_MAX >  N_sched_ue)
+        {
+            dl_sched = new LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT;
+            init_dl_alloc(&dl_sched->alloc, user);
+            dl_sched->current_tti = sched_dl_subfr[sched_cur_dl_subfn].current_tti;
+            dl_sched->harq_retx   = false;
+            dl_sched->packed      = false;
+            dl_sched->pull        = true;
+
+            // The transport block has to fit the allocation message
+            N_bytes = N_bytes_allowed;
+            if(N_bytes*8 > LIBLTE_MAX_MSG_SIZE)
+            {
+                N_bytes = LIBLTE_MAX_MSG_SIZE/8;
             }
+            N_prb = cnfg.sys_info->N_rb_dl;
+            liblte_phy_get_tbs_and_n_prb_for_dl(N_bytes*8,
+                                                cnfg.sys_info->N_rb_dl,
+                                                dl_sched->alloc.mcs,
+                                                &dl_sched->alloc.tbs,
+                                                &N_prb);
+            liblte_phy_get_tbs_for_dl(N_prb, dl_sched->alloc.mcs, &dl_sched->alloc.tbs);
+            while(1                   <  N_prb &&
+                  LIBLTE_MAX_MSG_SIZE <  dl_sched->alloc.tbs)
+            {
+                N_prb--;
+                liblte_phy_get_tbs_for_dl(N_prb, dl_sched->alloc.mcs, &dl_sched->alloc.tbs);
+            }
+
+            memcpy(&sched_ue[N_sched_ue], user->get_dl_sched_ue(), sizeof(LIBLTE_MAC_SCHED_UE_STRUCT));
+            sched_ue[N_sched_ue].cqi        = user->get_dl_cqi();
+            sched_ue[N_sched_ue].rnti       = dl_sched->alloc.rnti;
+            sched_ue[N_sched_ue].N_prb_min  = 1;
+            sched_ue[N_sched_ue].N_prb_max  = N_prb;
+            sched_ue[N_sched_ue].retx       = false;
+            sched_ue[N_sched_ue].gbr        = gbr;
+            sched_ue[N_sched_ue].qos_weight = qos_weight;
+            sched_user[N_sched_ue]          = user;
+            sched_dl_cand[N_sched_ue]       = dl_sched;
+            N_sched_ue++;
+        }
+        pull_iter++;
+    }
+
+    // Rank the users and give the winners contiguous PRBs, one DCI each
+    N_avail_dcis = N_cce - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
+    liblte_mac_sched_run(&sched_dl_policy,
+                         sched_ue,
+                         N_sched_ue,
+                         &sched_dl_prb_mask[sched_cur_dl_subfn],
+                         (0 < N_avail_dcis) ? N_avail_dcis : 0,
+                         sched_grant,
+                         &N_grant);
+    for(i=0; i<N_grant; i++)
+    {
+        dl_sched = sched_dl_cand[sched_grant[i].ue_idx];
+        set_alloc_prbs(&dl_sched->alloc, &sched_grant[i].rb_alloc);
+
+        // Pull RLC PDUs sized to exactly what was granted
+        if(dl_sched->pull)
+        {
+            liblte_phy_get_tbs_for_dl(dl_sched->alloc.N_prb,
+                                      dl_sched->alloc.mcs,
+                                      &dl_sched->alloc.tbs);
+            build_dl_mac_pdu(sched_user[sched_grant[i].ue_idx], dl_sched);
+        }
 
+        if((!dl_sched->pull                                                                           ||
+            0                          != dl_sched->mac_pdu.N_subheaders)                             &&
+           LTE_FDD_ENB_ERROR_NONE      == start_dl_harq_proc(dl_sched, sched_dl_subfr[sched_cur_dl_subfn].current_tti))
+        {
             // Send a PCAP message
             interface->send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
                                      dl_sched->alloc.rnti,
@@ -1051,68 +1427,190 @@ void LTE_fdd_enb_mac::scheduler(void)
                                      dl_sched->alloc.msg.msg,
                                      dl_sched->alloc.tbs);
 
-            // Determine how many PRBs and DCIs are available in this subframe
-            N_avail_dl_prbs = sched_dl_subfr[sched_cur_dl_subfn].N_avail_prbs - sched_dl_subfr[sched_cur_dl_subfn].N_sched_prbs;
-            N_avail_dcis    = N_cce - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
-
-            if(dl_sched->alloc.N_prb <= N_avail_dl_prbs &&
-               1                     <= N_avail_dcis)
-            {
-                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                          __FILE__,
-                                          __LINE__,
-                                          &dl_sched->alloc.msg,
-                                          "DL allocation sent for RNTI=%u CURRENT_TTI=%u",
-                                          dl_sched->alloc.rnti,
-                                          sched_dl_subfr[sched_cur_dl_subfn].current_tti);
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                      __FILE__,
+                                      __LINE__,
+                                      &dl_sched->alloc.msg,
+                                      "DL allocation sent for RNTI=%u CURRENT_TTI=%u",
+                                      dl_sched->alloc.rnti,
+                                      sched_dl_subfr[sched_cur_dl_subfn].current_tti);
 
-                // Schedule DL
-                memcpy(&sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.alloc[sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc],
-                       &dl_sched->alloc,
-                       sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
-                sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc++;
+            // Schedule DL
+            memcpy(&sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.alloc[sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc],
+                   &dl_sched->alloc,
+                   sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+            sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc++;
 
-                // Remove DL schedule from queue
-                dl_sched_queue.pop_front();
-                delete dl_sched;
-            }
-        }else if(dl_sched->current_tti < sched_dl_subfr[sched_cur_dl_subfn].current_tti){
             // Remove DL schedule from queue
-            dl_sched_queue.pop_front();
+            dl_sched_queue.remove(dl_sched);
             delete dl_sched;
-        }else{
-            sched_out_of_headroom = true;
+            sched_dl_cand[sched_grant[i].ue_idx] = NULL;
+        }
+    }
+    for(i=0; i<N_sched_ue; i++)
+    {
+        if(NULL != sched_user[i])
+        {
+            memcpy(sched_user[i]->get_dl_sched_ue(), &sched_ue[i], sizeof(LIBLTE_MAC_SCHED_UE_STRUCT));
+        }
+
+        // Pulled users that lost out simply try again next subframe
+        if(NULL != sched_dl_cand[i] &&
+           sched_dl_cand[i]->pull)
+        {
+            delete sched_dl_cand[i];
+        }
+    }
+
+    // Allocations that did not fit wait for the next subframe
+    for(dl_iter=dl_sched_queue.begin(); dl_iter!=dl_sched_queue.end(); dl_iter++)
+    {
+        if((*dl_iter)->current_tti == sched_dl_subfr[sched_cur_dl_subfn].current_tti)
+        {
+            (*dl_iter)->current_tti = ((*dl_iter)->current_tti + 1) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
         }
     }
     dl_sched_queue_mutex.unlock();
 
     // Schedule UL for the next subframe
     ul_sched_queue_mutex.lock();
-    sched_out_of_headroom = false;
-    while(0     != ul_sched_queue.size() &&
-          false == sched_out_of_headroom)
+
+    // Non-adaptive retransmissions keep their PRBs and need no DCI
+    iter = ul_retx_sched_queue.begin();
+    while(ul_retx_sched_queue.end() != iter)
     {
-        ul_sched = ul_sched_queue.front();
+        ul_sched = (*iter);
 
-        // Determine how many PRBs and DCIs are available in this subframe
-        N_avail_ul_prbs = sched_ul_subfr[(sched_cur_dl_subfn+4)%10].N_avail_prbs - sched_ul_subfr[(sched_cur_dl_subfn+4)%10].N_sched_prbs;
-        N_avail_dcis    = N_cce - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
+        if(ul_sched->current_tti == sched_ul_subfr[(sched_cur_dl_subfn+4)%10].current_tti)
+        {
+            if(LTE_FDD_ENB_ERROR_NONE == continue_ul_harq_proc(ul_sched, ul_sched->current_tti, &soft_buffer))
+            {
+                if(liblte_mac_prb_mask_is_free(&sched_ul_prb_mask[(sched_cur_dl_subfn+4)%10],
+                                               ul_sched->alloc.prb[0],
+                                               ul_sched->alloc.N_prb))
+                {
+                    liblte_mac_prb_mask_set_list(&sched_ul_prb_mask[(sched_cur_dl_subfn+4)%10],
+                                                 ul_sched->alloc.prb[0],
+                                                 ul_sched->alloc.N_prb);
+                }else{
+                    // A msg3 took these PRBs, so move the retransmission with a DCI 0 that keeps
+                    // the NDI.  A regular MCS in DCI 0 signals redundancy version 0.
+                    N_avail_dcis = N_cce - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
+                    if(1              <= N_avail_dcis &&
+                       LIBLTE_SUCCESS == liblte_mac_alloc_prbs(&sched_ul_prb_mask[(sched_cur_dl_subfn+4)%10],
+                                                               LIBLTE_MAC_RA_TYPE_2,
+                                                               ul_sched->alloc.N_prb,
+                                                               ul_sched->alloc.N_prb,
+                                                               &ul_rb_alloc))
+                    {
+                        set_alloc_prbs(&ul_sched->alloc, &ul_rb_alloc);
+                        ul_sched->alloc.rv_idx = 0;
+                        if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(ul_sched->alloc.rnti, &user))
+                        {
+                            ul_harq = user->get_ul_harq_proc(ul_sched->current_tti);
+                            memcpy(&ul_harq->alloc, &ul_sched->alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+                        }
+
+                        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                                  __FILE__,
+                                                  __LINE__,
+                                                  "Adaptive UL retransmission for RNTI=%u CURRENT_TTI=%u",
+                                                  ul_sched->alloc.rnti,
+                                                  ul_sched->current_tti);
+
+                        // Schedule UL allocation
+                        memcpy(&sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.alloc[sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc],
+                               &ul_sched->alloc,
+                               sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+                        sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc++;
+                    }
+                }
+
+                // Schedule UL decode 4 subframes from now
+                memcpy(&sched_ul_subfr[(sched_cur_dl_subfn+4)%10].decodes.alloc[sched_ul_subfr[(sched_cur_dl_subfn+4)%10].decodes.N_alloc],
+                       &ul_sched->alloc,
+                       sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+                sched_ul_subfr[(sched_cur_dl_subfn+4)%10].soft_buffer[sched_ul_subfr[(sched_cur_dl_subfn+4)%10].decodes.N_alloc] = soft_buffer;
+                sched_ul_subfr[(sched_cur_dl_subfn+4)%10].decodes.N_alloc++;
+            }
+            iter = ul_retx_sched_queue.erase(iter);
+            delete ul_sched;
+        }else if(ul_sched->current_tti < sched_ul_subfr[(sched_cur_dl_subfn+4)%10].current_tti){
+            // Missed the retransmission, the process is flushed on its next new transmission
+            iter = ul_retx_sched_queue.erase(iter);
+            delete ul_sched;
+        }else{
+            iter++;
+        }
+    }
+
+    // Collect the oldest UL request of each user that has a free HARQ process
+    N_sched_ue = 0;
+    for(iter=ul_sched_queue.begin(); iter!=ul_sched_queue.end(); iter++)
+    {
+        ul_sched = (*iter);
+
+        found = false;
+        for(i=0; i<N_sched_ue; i++)
+        {
+            if(sched_ul_cand[i]->alloc.rnti == ul_sched->alloc.rnti)
+            {
+                found = true;
+            }
+        }
+        if(LTE_FDD_ENB_ERROR_NONE != user_mgr->find_user(ul_sched->alloc.rnti, &user))
+        {
+            user = NULL;
+        }
 
-        if(ul_sched->alloc.N_prb <= N_avail_ul_prbs &&
-           1                     <= N_avail_dcis)
+        // FDD uplink HARQ is synchronous, a retransmission may already hold the process
+        harq_free = true;
+        if(NULL != user)
         {
-            // Determine the RB start
-            rb_start                                            = sched_ul_subfr[(sched_cur_dl_subfn+4)%10].next_prb;
-            sched_ul_subfr[(sched_cur_dl_subfn+4)%10].next_prb += ul_sched->alloc.N_prb;
+            ul_harq   = user->get_ul_harq_proc(sched_ul_subfr[(sched_cur_dl_subfn+4)%10].current_tti);
+            harq_free = !(ul_harq->active && ul_harq->tx_tti == sched_ul_subfr[(sched_cur_dl_subfn+4)%10].current_tti);
+        }
 
-            // Fill in the PRBs
-            for(i=0; i<ul_sched->alloc.N_prb; i++)
+        if(!found                                 &&
+           harq_free                              &&
+           LIBLTE_MAC_SCHED_N_UE_MAX > N_sched_ue)
+        {
+            // There is no UL channel quality report, so DL CQI stands in for it
+            if(NULL != user)
             {
-                ul_sched->alloc.prb[0][i] = rb_start+i;
-                ul_sched->alloc.prb[1][i] = rb_start+i;
+                memcpy(&sched_ue[N_sched_ue], user->get_ul_sched_ue(), sizeof(LIBLTE_MAC_SCHED_UE_STRUCT));
+                sched_ue[N_sched_ue].cqi = user->get_dl_cqi();
+            }else{
+                liblte_mac_sched_ue_init(&sched_ue[N_sched_ue], ul_sched->alloc.rnti);
             }
+            sched_ue[N_sched_ue].rnti      = ul_sched->alloc.rnti;
+            sched_ue[N_sched_ue].N_prb_min = ul_sched->alloc.N_prb;
+            sched_ue[N_sched_ue].N_prb_max = ul_sched->alloc.N_prb;
+            sched_ue[N_sched_ue].retx      = false;
+            sched_user[N_sched_ue]         = user;
+            sched_ul_cand[N_sched_ue]      = ul_sched;
+            N_sched_ue++;
+        }
+    }
+
+    // Rank the users and give the winners contiguous PRBs, one DCI each
+    N_avail_dcis = N_cce - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
+    liblte_mac_sched_run(&sched_ul_policy,
+                         sched_ue,
+                         N_sched_ue,
+                         &sched_ul_prb_mask[(sched_cur_dl_subfn+4)%10],
+                         (0 < N_avail_dcis) ? N_avail_dcis : 0,
+                         sched_grant,
+                         &N_grant);
+    for(i=0; i<N_grant; i++)
+    {
+        ul_sched = sched_ul_cand[sched_grant[i].ue_idx];
+        set_alloc_prbs(&ul_sched->alloc, &sched_grant[i].rb_alloc);
 
+        if(LTE_FDD_ENB_ERROR_NONE == start_ul_harq_proc(ul_sched, sched_ul_subfr[(sched_cur_dl_subfn+4)%10].current_tti, &soft_buffer))
+        {
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                       LTE_FDD_ENB_DEBUG_LEVEL_MAC,
                                       __FILE__,
@@ -1125,6 +1623,7 @@ void LTE_fdd_enb_mac::scheduler(void)
             memcpy(&sched_ul_subfr[(sched_cur_dl_subfn+4)%10].decodes.alloc[sched_ul_subfr[(sched_cur_dl_subfn+4)%10].decodes.N_alloc],
                    &ul_sched->alloc,
                    sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+            sched_ul_subfr[(sched_cur_dl_subfn+4)%10].soft_buffer[sched_ul_subfr[(sched_cur_dl_subfn+4)%10].decodes.N_alloc] = soft_buffer;
             sched_ul_subfr[(sched_cur_dl_subfn+4)%10].decodes.N_alloc++;
             // Schedule UL allocation
             memcpy(&sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.alloc[sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc],
@@ -1133,13 +1632,54 @@ void LTE_fdd_enb_mac::scheduler(void)
             sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc++;
 
             // Remove UL schedule from queue
-            ul_sched_queue.pop_front();
+            ul_sched_queue.remove(ul_sched);
             delete ul_sched;
-        }else{
-            sched_out_of_headroom = true;
+        }
+    }
+    for(i=0; i<N_sched_ue; i++)
+    {
+        if(NULL != sched_user[i])
+        {
+            memcpy(sched_user[i]->get_ul_sched_ue(), &sched_ue[i], sizeof(LIBLTE_MAC_SCHED_UE_STRUCT));
         }
     }
     ul_sched_queue_mutex.unlock();
+
+    // Schedule HARQ-ACK decodes 4 subframes from now for the DL allocations in this subframe
+    for(i=0; i<sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc; i++)
+    {
+        if(LIBLTE_MAC_C_RNTI_START <= sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.alloc[i].rnti &&
+           LIBLTE_MAC_C_RNTI_END   >= sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.alloc[i].rnti)
+        {
+            pucch = get_pucch_sched(&sched_ul_subfr[(sched_cur_dl_subfn+4)%10],
+                                    sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.alloc[i].rnti);
+            if(NULL != pucch)
+            {
+                pucch->harq_ack = true;
+            }
+        }
+    }
+
+    // Schedule SR and CQI decodes 4 subframes from now
+    user_mgr->get_pucch_users(&pucch_users);
+    for(user_iter=pucch_users.begin(); user_iter!=pucch_users.end(); user_iter++)
+    {
+        pucch_cnfg = (*user_iter)->get_pucch_cnfg();
+        sr_due     = (sched_ul_subfr[(sched_cur_dl_subfn+4)%10].current_tti % 10) == (pucch_cnfg->sr_cnfg_idx - 5);
+        cqi_due    = (sched_ul_subfr[(sched_cur_dl_subfn+4)%10].current_tti % 20) == (pucch_cnfg->cqi_pmi_cnfg_idx - 17);
+        if(sr_due || cqi_due)
+        {
+            pucch = get_pucch_sched(&sched_ul_subfr[(sched_cur_dl_subfn+4)%10],
+                                    (*user_iter)->get_c_rnti());
+            if(NULL != pucch)
+            {
+                pucch->n_1_pucch_sr = pucch_cnfg->n_1_pucch_sr;
+                pucch->n_2_pucch    = pucch_cnfg->n_2_pucch_cqi;
+                pucch->sr           = sr_due;
+                pucch->cqi          = cqi_due;
+            }
+        }
+    }
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::add_to_rar_sched_queue(uint32                        current_tti,
                                                                LIBLTE_PHY_ALLOCATION_STRUCT *dl_alloc,
@@ -1179,8 +1719,15 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::add_to_dl_sched_queue(uint32
 
     if(NULL != dl_sched)
     {
+        // A NULL MAC PDU marks a HARQ retransmission of an already packed allocation
         dl_sched->current_tti = current_tti;
-        memcpy(&dl_sched->mac_pdu, mac_pdu, sizeof(LIBLTE_MAC_PDU_STRUCT));
+        dl_sched->harq_retx   = (NULL == mac_pdu);
+        dl_sched->packed      = false;
+        dl_sched->pull        = false;
+        if(!dl_sched->harq_retx)
+        {
+            memcpy(&dl_sched->mac_pdu, mac_pdu, sizeof(LIBLTE_MAC_PDU_STRUCT));
+        }
         memcpy(&dl_sched->alloc, alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
 
         dl_sched_queue_mutex.lock();
@@ -1231,38 +1778,527 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::add_to_ul_sched_queue(uint32
 
     return(err);
 }
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::add_to_ul_retx_sched_queue(uint32                        current_tti,
+                                                                   LIBLTE_PHY_ALLOCATION_STRUCT *alloc)
+{
+    LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT *ul_sched = NULL;
+    LTE_FDD_ENB_ERROR_ENUM             err      = LTE_FDD_ENB_ERROR_CANT_SCHEDULE;
+
+    ul_sched = new LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT;
+
+    if(NULL != ul_sched)
+    {
+        ul_sched->current_tti = current_tti;
+        memcpy(&ul_sched->alloc, alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+
+        ul_sched_queue_mutex.lock();
+        ul_retx_sched_queue.push_back(ul_sched);
+        ul_sched_queue_mutex.unlock();
+
+        err = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
 
 /*****************/
 /*    Helpers    */
 /*****************/
-uint32 LTE_fdd_enb_mac::get_n_reserved_prbs(uint32 current_tti)
+uint32 LTE_fdd_enb_mac::get_n_sib_prbs(uint32 current_tti)
 {
-    uint32 N_reserved_prbs = 0;
-    uint32 i;
+    LTE_fdd_enb_cnfg_reader             cnfg;
+    const LIBLTE_PHY_ALLOCATION_STRUCT *sib[5];
+    uint32                              N_sib      = 0;
+    uint32                              N_sib_prbs = 0;
+    uint32                              tbs;
+    uint32                              N_prb;
+    uint32                              i;
+    uint8                               mcs;
+
+    // SIB1
+    if(5 == (current_tti % 10) &&
+       0 == ((current_tti / 10) % 2))
+    {
+        sib[N_sib++] = &cnfg.sys_info->sib1_alloc;
+    }
+
+    // SIs in the 1st scheduling info list entry are sent throughout their window
+    if((0 * cnfg.sys_info->si_win_len)%10   <= (current_tti % 10) &&
+       (1 * cnfg.sys_info->si_win_len)%10   >  (current_tti % 10) &&
+       ((0 * cnfg.sys_info->si_win_len)/10) == ((current_tti / 10) % cnfg.sys_info->si_periodicity_T))
+    {
+        sib[N_sib++] = &cnfg.sys_info->sib_alloc[0];
+    }
+
+    // All other SIs
+    for(i=1; i<cnfg.sys_info->sib1.N_sched_info; i++)
+    {
+        if(0                             != cnfg.sys_info->sib_alloc[i].msg.N_bits &&
+           (i * cnfg.sys_info->si_win_len)%10  == (current_tti % 10)               &&
+           ((i * cnfg.sys_info->si_win_len)/10 == ((current_tti / 10) % cnfg.sys_info->si_periodicity_T)))
+        {
+            sib[N_sib++] = &cnfg.sys_info->sib_alloc[i];
+        }
+    }
 
-    // Reserve PRBs for the MIB
+    // Size them the same way the PHY does for this subframe
+    for(i=0; i<N_sib; i++)
+    {
+        if(LIBLTE_SUCCESS == liblte_phy_get_tbs_mcs_and_n_prb_for_dl(sib[i]->msg.N_bits,
+                                                                     current_tti % 10,
+                                                                     cnfg.sys_info->N_rb_dl,
+                                                                     sib[i]->rnti,
+                                                                     &tbs,
+                                                                     &mcs,
+                                                                     &N_prb))
+        {
+            N_sib_prbs += N_prb;
+        }
+    }
+
+    return(N_sib_prbs);
+}
+uint32 LTE_fdd_enb_mac::get_n_pucch_prbs(void)
+{
+    LTE_fdd_enb_phy         *phy = LTE_fdd_enb_phy::get_instance();
+    LTE_fdd_enb_cnfg_reader  cnfg;
+    uint32                   N_pucch_prbs;
+
+    // PUCCH occupies PRBs at both edges of the band, covering format 2 and
+    // every format 1 resource up to the last dynamic HARQ-ACK resource
+    liblte_phy_get_n_prb_for_pucch(liblte_rrc_delta_pucch_shift_num[cnfg.sys_info->sib2.rr_config_common_sib.pucch_cnfg.delta_pucch_shift],
+                                   cnfg.sys_info->sib2.rr_config_common_sib.pucch_cnfg.n_rb_cqi,
+                                   cnfg.sys_info->sib2.rr_config_common_sib.pucch_cnfg.n_cs_an,
+                                   cnfg.sys_info->sib2.rr_config_common_sib.pucch_cnfg.n1_pucch_an + phy->get_n_cce(),
+                                   &N_pucch_prbs);
+
+    return(N_pucch_prbs);
+}
+void LTE_fdd_enb_mac::init_dl_prb_mask(uint8 subfn)
+{
+    LTE_fdd_enb_cnfg_reader     cnfg;
+    LIBLTE_MAC_PRB_MASK_STRUCT *mask        = &sched_dl_prb_mask[subfn];
+    uint32                      current_tti = sched_dl_subfr[subfn].current_tti;
+
+    liblte_mac_prb_mask_init(mask, cnfg.sys_info->N_rb_dl);
+
+    // The PHY places the SIBs in the lowest PRBs
+    liblte_mac_prb_mask_set(mask, 0, get_n_sib_prbs(current_tti));
+
+    // Keep the PBCH PRBs free of user data, with an odd number of PRBs the
+    // central 72 subcarriers touch 7 PRBs
     if(0 == (current_tti % 10))
     {
-        N_reserved_prbs += 6;
+        if(0 == (cnfg.sys_info->N_rb_dl % 2))
+        {
+            liblte_mac_prb_mask_set(mask, (cnfg.sys_info->N_rb_dl - 6)/2, 6);
+        }else{
+            liblte_mac_prb_mask_set(mask, (cnfg.sys_info->N_rb_dl - 7)/2, 7);
+        }
     }
+}
+void LTE_fdd_enb_mac::init_ul_prb_mask(uint8 subfn)
+{
+    LTE_fdd_enb_cnfg_reader     cnfg;
+    LIBLTE_MAC_PRB_MASK_STRUCT *mask         = &sched_ul_prb_mask[subfn];
+    uint32                      N_pucch_prbs = get_n_pucch_prbs();
 
-    // Reserve PRBs for SIB1
-    if(5 == (current_tti % 10) &&
-       0 == ((current_tti / 10) % 2))
+    liblte_mac_prb_mask_init(mask, cnfg.sys_info->N_rb_ul);
+
+    // PUCCH occupies both edges of the band
+    liblte_mac_prb_mask_set(mask, 0, N_pucch_prbs);
+    liblte_mac_prb_mask_set(mask, cnfg.sys_info->N_rb_ul - N_pucch_prbs, N_pucch_prbs);
+}
+void LTE_fdd_enb_mac::set_alloc_prbs(LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
+                                     LIBLTE_MAC_RB_ALLOC_STRUCT   *rb_alloc)
+{
+    uint32 i;
+
+    for(i=0; i<rb_alloc->N_prb; i++)
     {
-        N_reserved_prbs += sys_info.sib1_alloc.N_prb;
+        alloc->prb[0][i] = rb_alloc->prb[i];
+        alloc->prb[1][i] = rb_alloc->prb[i];
     }
+    alloc->N_prb = rb_alloc->N_prb;
+}
+void LTE_fdd_enb_mac::init_dl_alloc(LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
+                                    LTE_fdd_enb_user             *user)
+{
+    LTE_fdd_enb_cnfg_reader  cnfg;
+
+    alloc->pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
+    alloc->mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
+    alloc->chan_type      = LIBLTE_PHY_CHAN_TYPE_DLSCH;
+    alloc->rv_idx         = 0;
+    alloc->N_codewords    = 1;
+    if(1 == cnfg.sys_info->N_ant)
+    {
+        alloc->tx_mode = 1;
+    }else{
+        alloc->tx_mode = 2;
+    }
+    alloc->rnti = user->get_c_rnti();
+    alloc->mcs  = cqi_to_mcs[user->get_dl_cqi() & 0xF];
+    alloc->tpc  = LIBLTE_PHY_TPC_COMMAND_DCI_1_1A_1B_1D_2_3_DB_ZERO;
+    if(10 <= alloc->mcs)
+    {
+        alloc->mod_type = LIBLTE_PHY_MODULATION_TYPE_16QAM;
+    }
+}
+void LTE_fdd_enb_mac::pad_dl_mac_pdu(LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT *dl_sched)
+{
+    uint32 N_pad;
+    uint32 i;
 
-    // Reserve PRBs for all other SIBs
-    for(i=0; i<sys_info.sib1.N_sched_info; i++)
+    // Pad and repack if needed
+    if(dl_sched->alloc.tbs > dl_sched->alloc.msg.N_bits)
     {
-        if(0                             != sys_info.sib_alloc[i].msg.N_bits &&
-           (i * sys_info.si_win_len)%10  == (current_tti % 10)               &&
-           ((i * sys_info.si_win_len)/10 == ((current_tti / 10) % sys_info.si_periodicity_T)))
+        N_pad = (dl_sched->alloc.tbs - dl_sched->alloc.msg.N_bits)/8;
+
+        if(1 == N_pad)
+        {
+            for(i=0; i<dl_sched->mac_pdu.N_subheaders; i++)
+            {
+                memcpy(&dl_sched->mac_pdu.subheader[dl_sched->mac_pdu.N_subheaders-i], &dl_sched->mac_pdu.subheader[dl_sched->mac_pdu.N_subheaders-i-1], sizeof(LIBLTE_MAC_PDU_SUBHEADER_STRUCT));
+            }
+            dl_sched->mac_pdu.subheader[0].lcid = LIBLTE_MAC_DLSCH_PADDING_LCID;
+            dl_sched->mac_pdu.N_subheaders++;
+        }else if(2 == N_pad){
+            for(i=0; i<dl_sched->mac_pdu.N_subheaders; i++)
+            {
+                memcpy(&dl_sched->mac_pdu.subheader[dl_sched->mac_pdu.N_subheaders-i+1], &dl_sched->mac_pdu.subheader[dl_sched->mac_pdu.N_subheaders-i-1], sizeof(LIBLTE_MAC_PDU_SUBHEADER_STRUCT));
+            }
+            dl_sched->mac_pdu.subheader[0].lcid  = LIBLTE_MAC_DLSCH_PADDING_LCID;
+            dl_sched->mac_pdu.subheader[1].lcid  = LIBLTE_MAC_DLSCH_PADDING_LCID;
+            dl_sched->mac_pdu.N_subheaders      += 2;
+        }else{
+            dl_sched->mac_pdu.subheader[dl_sched->mac_pdu.N_subheaders].lcid = LIBLTE_MAC_DLSCH_PADDING_LCID;
+            dl_sched->mac_pdu.N_subheaders++;
+        }
+
+        liblte_mac_pack_mac_pdu(&dl_sched->mac_pdu,
+                                &dl_sched->alloc.msg);
+    }
+    dl_sched->packed = true;
+}
+void LTE_fdd_enb_mac::get_dl_rbs(LTE_fdd_enb_user  *user,
+                                 LTE_fdd_enb_rb   **rb,
+                                 uint32            *N_rb)
+{
+    *N_rb = 0;
+    if(LTE_FDD_ENB_ERROR_NONE == user->get_srb1(&rb[*N_rb]))
+    {
+        (*N_rb)++;
+    }
+    if(LTE_FDD_ENB_ERROR_NONE == user->get_srb2(&rb[*N_rb]))
+    {
+        (*N_rb)++;
+    }
+    if(LTE_FDD_ENB_ERROR_NONE == user->get_drb(LTE_FDD_ENB_RB_DRB1, &rb[*N_rb]))
+    {
+        (*N_rb)++;
+    }
+    if(LTE_FDD_ENB_ERROR_NONE == user->get_drb(LTE_FDD_ENB_RB_DRB2, &rb[*N_rb]))
+    {
+        (*N_rb)++;
+    }
+}
+uint32 LTE_fdd_enb_mac::get_dl_buffer_state(LTE_fdd_enb_user *user)
+{
+    LTE_fdd_enb_rlc *rlc = LTE_fdd_enb_rlc::get_instance();
+    LTE_fdd_enb_rb  *rb[LTE_FDD_ENB_RB_N_ITEMS];
+    uint32           N_rb;
+    uint32           N_bytes;
+    uint32           total = 0;
+    uint32           i;
+
+    get_dl_rbs(user, rb, &N_rb);
+    for(i=0; i<N_rb; i++)
+    {
+        // Allow for the longest MAC subheader
+        N_bytes = rlc->get_buffer_state(rb[i]);
+        if(0 != N_bytes)
+        {
+            total += N_bytes + 3;
+        }
+    }
+
+    return(total);
+}
+uint32 LTE_fdd_enb_mac::get_dl_qos_state(LTE_fdd_enb_user *user,
+                                         bool             *gbr,
+                                         float            *qos_weight)
+{
+    LTE_fdd_enb_rlc *rlc = LTE_fdd_enb_rlc::get_instance();
+    LTE_fdd_enb_rb  *rb[LTE_FDD_ENB_RB_N_ITEMS];
+    uint64           now = liblte_qos_get_time_us();
+    uint32           N_rb;
+    uint32           N_bytes;
+    uint32           N_allowed;
+    uint32           total = 0;
+    uint32           i;
+    float            weight;
+
+    *gbr        = false;
+    *qos_weight = 1;
+    liblte_qos_token_bucket_update(user->get_dl_ambr_bucket(), now);
+    get_dl_rbs(user, rb, &N_rb);
+    for(i=0; i<N_rb; i++)
+    {
+        N_bytes = rlc->get_buffer_state(rb[i]);
+        if(0 == N_bytes)
+        {
+            continue;
+        }
+
+        // Signalling outranks every data bearer
+        weight = LIBLTE_QOS_N_PRIORITY_LEVELS + 1;
+        if(0 != rb[i]->get_qci())
+        {
+            liblte_qos_token_bucket_update(rb[i]->get_gbr_bucket(), now);
+            liblte_qos_token_bucket_update(rb[i]->get_mbr_bucket(), now);
+            if(0 != liblte_qos_token_bucket_bytes(rb[i]->get_gbr_bucket()))
+            {
+                *gbr = true;
+            }
+            N_allowed = get_dl_rb_allowance(user, rb[i]);
+            if(N_bytes > N_allowed)
+            {
+                N_bytes = N_allowed;
+            }
+            weight = LIBLTE_QOS_N_PRIORITY_LEVELS + 1 - rb[i]->get_qci_char()->priority;
+        }
+
+        // Allow for the longest MAC subheader
+        if(0 != N_bytes)
+        {
+            total += N_bytes + 3;
+            if(weight > *qos_weight)
+            {
+                *qos_weight = weight;
+            }
+        }
+    }
+
+    return(total);
+}
+uint32 LTE_fdd_enb_mac::get_dl_rb_allowance(LTE_fdd_enb_user *user,
+                                            LTE_fdd_enb_rb   *rb)
+{
+    LIBLTE_QOS_TOKEN_BUCKET_STRUCT *mbr       = rb->get_mbr_bucket();
+    LIBLTE_QOS_TOKEN_BUCKET_STRUCT *ambr      = user->get_dl_ambr_bucket();
+    uint32                          N_allowed = 0xFFFFFFFF;
+
+    // A bit rate of 0 leaves the bearer unlimited
+    if(0 != mbr->rate_kbps)
+    {
+        N_allowed = liblte_qos_token_bucket_bytes(mbr);
+    }
+    if(0                                != ambr->rate_kbps                           &&
+       LIBLTE_QOS_RESOURCE_TYPE_NON_GBR == rb->get_qci_char()->resource_type         &&
+       N_allowed                        >  liblte_qos_token_bucket_bytes(ambr))
+    {
+        N_allowed = liblte_qos_token_bucket_bytes(ambr);
+    }
+
+    return(N_allowed);
+}
+uint32 LTE_fdd_enb_mac::add_dl_rb_sdus(LTE_fdd_enb_user      *user,
+                                       LTE_fdd_enb_rb        *rb,
+                                       uint32                 N_bytes_limit,
+                                       LIBLTE_MAC_PDU_STRUCT *mac_pdu,
+                                       uint32                *N_bytes)
+{
+    LTE_fdd_enb_rlc *rlc    = LTE_fdd_enb_rlc::get_instance();
+    uint32           N_used = 0;
+    uint32           N_bytes_max;
+    uint32           N_sdu_bytes;
+
+    // Keep two subheaders free for padding
+    while((LIBLTE_MAC_MAX_MAC_PDU_N_SUBHEADERS - 2) > mac_pdu->N_subheaders &&
+          3                                         <= *N_bytes              &&
+          N_used                                    <  N_bytes_limit)
+    {
+        // The subheader L field grows to 15 bits for SDUs of 128 bytes or more
+        N_bytes_max = *N_bytes - 2;
+        if(128 <= N_bytes_max)
+        {
+            N_bytes_max = *N_bytes - 3;
+        }
+
+        // A bearer near the end of its share may overshoot it by one small PDU
+        if(N_bytes_max > (N_bytes_limit - N_used))
+        {
+            N_bytes_max = N_bytes_limit - N_used;
+            if(LTE_FDD_ENB_MIN_DRB_PDU_BYTES > N_bytes_max)
+            {
+                N_bytes_max = LTE_FDD_ENB_MIN_DRB_PDU_BYTES;
+            }
+            if(N_bytes_max > (*N_bytes - 2))
+            {
+                N_bytes_max = *N_bytes - 2;
+            }
+        }
+        if(LTE_FDD_ENB_ERROR_NONE != rlc->get_pdu(user,
+                                                  rb,
+                                                  N_bytes_max,
+                                                  &mac_pdu->subheader[mac_pdu->N_subheaders].payload.sdu))
+        {
+            break;
+        }
+        mac_pdu->subheader[mac_pdu->N_subheaders].lcid = rb->get_rb_id();
+        N_sdu_bytes                                    = mac_pdu->subheader[mac_pdu->N_subheaders].payload.sdu.N_bytes;
+        if(128 <= N_sdu_bytes)
+        {
+            *N_bytes -= N_sdu_bytes + 3;
+        }else{
+            *N_bytes -= N_sdu_bytes + 2;
+        }
+        N_used += N_sdu_bytes;
+        mac_pdu->N_subheaders++;
+    }
+
+    return(N_used);
+}
+void LTE_fdd_enb_mac::build_dl_mac_pdu(LTE_fdd_enb_user                  *user,
+                                       LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT *dl_sched)
+{
+    LTE_fdd_enb_rlc                *rlc     = LTE_fdd_enb_rlc::get_instance();
+    LTE_fdd_enb_rb                 *rb[LTE_FDD_ENB_RB_N_ITEMS];
+    LTE_fdd_enb_rb                 *drb[LIBLTE_QOS_DRR_N_FLOWS_MAX];
+    LIBLTE_MAC_PDU_STRUCT          *mac_pdu = &dl_sched->mac_pdu;
+    LIBLTE_QOS_DRR_STRUCT          *drr     = user->get_dl_drr();
+    LIBLTE_QOS_QCI_STRUCT          *qci_char;
+    uint32                          N_rb;
+    uint32                          N_bytes = dl_sched->alloc.tbs/8;
+    uint32                          N_limit;
+    uint32                          N_sent;
+    uint32                          flow;
+    uint32                          priority;
+    uint32                          i;
+
+    mac_pdu->chan_type    = LIBLTE_MAC_CHAN_TYPE_DLSCH;
+    mac_pdu->N_subheaders = 0;
+
+    // Signalling bearers are served first and in full
+    get_dl_rbs(user, rb, &N_rb);
+    for(i=0; i<N_rb; i++)
+    {
+        if(0 == rb[i]->get_qci())
+        {
+            add_dl_rb_sdus(user, rb[i], 0xFFFFFFFF, mac_pdu, &N_bytes);
+        }
+    }
+
+    // GBR bearers get their guaranteed bit rate next, in priority order
+    for(priority=1; priority<=LIBLTE_QOS_N_PRIORITY_LEVELS; priority++)
+    {
+        for(i=0; i<N_rb; i++)
+        {
+            qci_char = rb[i]->get_qci_char();
+            if(0                            != rb[i]->get_qci()        &&
+               LIBLTE_QOS_RESOURCE_TYPE_GBR == qci_char->resource_type &&
+               priority                     == qci_char->priority)
+            {
+                N_limit = liblte_qos_token_bucket_bytes(rb[i]->get_gbr_bucket());
+                if(N_limit > get_dl_rb_allowance(user, rb[i]))
+                {
+                    N_limit = get_dl_rb_allowance(user, rb[i]);
+                }
+                N_sent = add_dl_rb_sdus(user, rb[i], N_limit, mac_pdu, &N_bytes);
+                liblte_qos_token_bucket_consume(rb[i]->get_gbr_bucket(), N_sent);
+                liblte_qos_token_bucket_consume(rb[i]->get_mbr_bucket(), N_sent);
+            }
+        }
+    }
+
+    // The rest is shared between the data bearers by deficit round
+    // robin, with quanta weighted by priority, within MBR and AMBR
+    for(flow=0; flow<drr->N_flows; flow++)
+    {
+        drr->flow[flow].backlogged = false;
+    }
+    for(i=0; i<N_rb; i++)
+    {
+        if(0 != rb[i]->get_qci())
+        {
+            flow                       = rb[i]->get_rb_id() - LTE_FDD_ENB_RB_DRB1;
+            drb[flow]                  = rb[i];
+            drr->flow[flow].backlogged = (0 != rlc->get_buffer_state(rb[i]));
+            liblte_qos_drr_set_quantum(drr, flow, LIBLTE_QOS_DRR_QUANTUM(rb[i]->get_qci_char()->priority));
+        }
+    }
+    while((LIBLTE_MAC_MAX_MAC_PDU_N_SUBHEADERS - 2) > mac_pdu->N_subheaders &&
+          3                                         <= N_bytes              &&
+          LIBLTE_SUCCESS                            == liblte_qos_drr_select(drr, &flow, &N_limit))
+    {
+        if(N_limit > get_dl_rb_allowance(user, drb[flow]))
+        {
+            N_limit = get_dl_rb_allowance(user, drb[flow]);
+        }
+        N_sent = 0;
+        if(0 != N_limit)
+        {
+            N_sent = add_dl_rb_sdus(user, drb[flow], N_limit, mac_pdu, &N_bytes);
+        }
+        liblte_qos_token_bucket_consume(drb[flow]->get_mbr_bucket(), N_sent);
+        if(LIBLTE_QOS_RESOURCE_TYPE_NON_GBR == drb[flow]->get_qci_char()->resource_type)
+        {
+            liblte_qos_token_bucket_consume(user->get_dl_ambr_bucket(), N_sent);
+        }
+
+        // A bearer that is out of data, window, or tokens sits out the
+        // rest of this TTI
+        liblte_qos_drr_charge(drr,
+                              flow,
+                              N_sent,
+                              (0 == N_sent || 0 == rlc->get_buffer_state(drb[flow])));
+    }
+
+    if(0 != mac_pdu->N_subheaders)
+    {
+        liblte_mac_pack_mac_pdu(mac_pdu,
+                                &dl_sched->alloc.msg);
+        pad_dl_mac_pdu(dl_sched);
+    }
+}
+LTE_FDD_ENB_PUCCH_SCHEDULE_STRUCT* LTE_fdd_enb_mac::get_pucch_sched(LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_subfr,
+                                                                    uint16                              rnti)
+{
+    LTE_FDD_ENB_PUCCH_SCHEDULE_STRUCT *pucch = NULL;
+    uint32                             i;
+    bool                               pusch = false;
+
+    // A user with a PUSCH allocation sends its UCI on PUSCH instead
+    for(i=0; i<ul_subfr->decodes.N_alloc; i++)
+    {
+        if(rnti == ul_subfr->decodes.alloc[i].rnti)
+        {
+            pusch = true;
+        }
+    }
+
+    if(!pusch)
+    {
+        for(i=0; i<ul_subfr->N_pucch; i++)
+        {
+            if(rnti == ul_subfr->pucch[i].rnti)
+            {
+                pucch = &ul_subfr->pucch[i];
+            }
+        }
+        if(NULL                          == pucch &&
+           LTE_FDD_ENB_MAX_PUCCH_DECODES >  ul_subfr->N_pucch)
         {
-            N_reserved_prbs += sys_info.sib_alloc[i].N_prb;
+            pucch               = &ul_subfr->pucch[ul_subfr->N_pucch++];
+            pucch->n_1_pucch_sr = 0;
+            pucch->n_2_pucch    = 0;
+            pucch->rnti         = rnti;
+            pucch->harq_ack     = false;
+            pucch->sr           = false;
+            pucch->cqi          = false;
         }
     }
 
-    return(N_reserved_prbs);
+    return(pucch);
 }
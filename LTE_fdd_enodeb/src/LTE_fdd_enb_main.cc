@@ -80,4 +80,8 @@ int main(int argc, char *argv[])
     }
 
     interface->cleanup();
+
+    // Write out any pending configuration and user changes
+    LTE_fdd_enb_hss::cleanup();
+    LTE_fdd_enb_cnfg_db::cleanup();
 }
@@ -116,15 +116,11 @@ void LTE_fdd_enb_mme::start(void)
 {
     boost::mutex::scoped_lock  lock(start_mutex);
     LTE_fdd_enb_cnfg_db       *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
-    LTE_fdd_enb_msgq_cb        rrc_cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_mme, &LTE_fdd_enb_mme::handle_rrc_msg>, this);
 
     if(!started)
     {
-        started       = true;
-        rrc_comm_msgq = new LTE_fdd_enb_msgq("rrc_mme_mq",
-                                             rrc_cb);
-        mme_rrc_mq    = new boost::interprocess::message_queue(boost::interprocess::open_only,
-                                                               "mme_rrc_mq");
+        started    = true;
+        worker_mgr = LTE_fdd_enb_worker_mgr::get_instance();
 
         cnfg_db->get_param(LTE_FDD_ENB_PARAM_IP_ADDR_START, next_ip_addr);
         cnfg_db->get_param(LTE_FDD_ENB_PARAM_DNS_ADDR, dns_addr);
@@ -138,7 +134,6 @@ void LTE_fdd_enb_mme::stop(void)
     if(started)
     {
         started = false;
-        delete rrc_comm_msgq;
     }
 }
 
@@ -170,17 +165,26 @@ void LTE_fdd_enb_mme::handle_rrc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
         break;
     }
 }
-
-/****************************/
-/*    External Interface    */
-/****************************/
-void LTE_fdd_enb_mme::update_sys_info(void)
+void LTE_fdd_enb_mme::handle_hss_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
 {
-    LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
 
-    sys_info_mutex.lock();
-    cnfg_db->get_sys_info(sys_info);
-    sys_info_mutex.unlock();
+    switch(msg->type)
+    {
+    case LTE_FDD_ENB_MESSAGE_TYPE_MME_AUTH_VEC_READY:
+        handle_auth_vec_ready(&msg->msg.mme_auth_vec_ready);
+        delete msg;
+        break;
+    default:
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Received invalid HSS message %s",
+                                  LTE_fdd_enb_message_type_text[msg->type]);
+        delete msg;
+        break;
+    }
 }
 
 /******************************/
@@ -321,6 +325,54 @@ void LTE_fdd_enb_mme::handle_rrc_cmd_resp(LTE_FDD_ENB_MME_RRC_CMD_RESP_MSG_STRUC
     }
 }
 
+/******************************/
+/*    HSS Message Handlers    */
+/******************************/
+void LTE_fdd_enb_mme::handle_auth_vec_ready(LTE_FDD_ENB_MME_AUTH_VEC_READY_MSG_STRUCT *auth_vec_ready)
+{
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+    LTE_fdd_enb_user_mgr  *user_mgr  = LTE_fdd_enb_user_mgr::get_instance();
+    LTE_fdd_enb_user      *user      = NULL;
+    LTE_fdd_enb_rb        *rb        = NULL;
+
+    // The user may have been deleted, or its C-RNTI handed to another
+    // one, while the vector was being made
+    if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(auth_vec_ready->c_rnti, &user) &&
+       auth_vec_ready->user_gen == user->get_gen())
+    {
+        if(LTE_FDD_ENB_RB_SRB1 == auth_vec_ready->rb_id)
+        {
+            user->get_srb1(&rb);
+        }else if(LTE_FDD_ENB_RB_SRB2 == auth_vec_ready->rb_id){
+            user->get_srb2(&rb);
+        }
+    }
+
+    if(NULL == rb)
+    {
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Authentication vector ready for a released connection, RNTI=%u and RB=%s",
+                                  auth_vec_ready->c_rnti,
+                                  LTE_fdd_enb_rb_text[auth_vec_ready->rb_id]);
+    }else if(LTE_FDD_ENB_MME_STATE_WAIT_FOR_AUTH_VEC == rb->get_mme_state()){
+        user->set_pending_auth_vec(&auth_vec_ready->auth_vec);
+        rb->set_mme_state(LTE_FDD_ENB_MME_STATE_AUTHENTICATE);
+        send_authentication_request(user, rb);
+    }else{
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Authentication vector ready in state %s, RNTI=%u and RB=%s",
+                                  LTE_fdd_enb_mme_state_text[rb->get_mme_state()],
+                                  user->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    }
+}
+
 /*************************/
 /*    Message Parsers    */
 /*************************/
@@ -391,74 +443,114 @@ void LTE_fdd_enb_mme::parse_attach_request(LIBLTE_BYTE_MSG_STRUCT  *msg,
                               (*user)->get_c_rnti(),
                               LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
 
-    // Unpack the message
-    liblte_mme_unpack_attach_request_msg(msg, &attach_req);
-
-    // Parse the ESM message
-    liblte_mme_parse_msg_header(&attach_req.esm_msg, &pd, &msg_type);
-    switch(msg_type)
+    // Unpack the message, a malformed one is rejected
+    if(LIBLTE_SUCCESS != liblte_mme_unpack_attach_request_msg(msg, &attach_req))
     {
-    case LIBLTE_MME_MSG_TYPE_PDN_CONNECTIVITY_REQUEST:
-        parse_pdn_connectivity_request(&attach_req.esm_msg, (*user), (*rb));
-        break;
-    default:
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                   LTE_FDD_ENB_DEBUG_LEVEL_MME,
                                   __FILE__,
                                   __LINE__,
-                                  "Not handling NAS message with MSG_TYPE=%02X",
-                                  msg_type);
-        break;
-    }
+                                  "Malformed Attach Request for RNTI=%u and RB=%s",
+                                  (*user)->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
+        (*rb)->set_mme_procedure(LTE_FDD_ENB_MME_PROC_ATTACH);
+        (*user)->set_emm_cause(LIBLTE_MME_EMM_CAUSE_INVALID_MANDATORY_INFORMATION);
+        (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_REJECT);
+    }else{
+        // Parse the ESM message
+        liblte_mme_parse_msg_header(&attach_req.esm_msg, &pd, &msg_type);
+        switch(msg_type)
+        {
+        case LIBLTE_MME_MSG_TYPE_PDN_CONNECTIVITY_REQUEST:
+            parse_pdn_connectivity_request(&attach_req.esm_msg, (*user), (*rb));
+            break;
+        default:
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                                      __FILE__,
+                                      __LINE__,
+                                      "Not handling NAS message with MSG_TYPE=%02X",
+                                      msg_type);
+            break;
+        }
 
-    // Set the procedure
-    (*rb)->set_mme_procedure(LTE_FDD_ENB_MME_PROC_ATTACH);
+        // Set the procedure
+        (*rb)->set_mme_procedure(LTE_FDD_ENB_MME_PROC_ATTACH);
 
-    // Store the attach type
-    (*user)->set_attach_type(attach_req.eps_attach_type);
+        // Store the attach type
+        (*user)->set_attach_type(attach_req.eps_attach_type);
 
-    // Store UE capabilities
-    for(i=0; i<8; i++)
-    {
-        (*user)->set_eea_support(i, attach_req.ue_network_cap.eea[i]);
-        (*user)->set_eia_support(i, attach_req.ue_network_cap.eia[i]);
-    }
-    if(attach_req.ue_network_cap.uea_present)
-    {
+        // Store UE capabilities
         for(i=0; i<8; i++)
         {
-            (*user)->set_uea_support(i, attach_req.ue_network_cap.uea[i]);
+            (*user)->set_eea_support(i, attach_req.ue_network_cap.eea[i]);
+            (*user)->set_eia_support(i, attach_req.ue_network_cap.eia[i]);
         }
-    }
-    if(attach_req.ue_network_cap.uia_present)
-    {
-        for(i=1; i<8; i++)
+        if(attach_req.ue_network_cap.uea_present)
         {
-            (*user)->set_uia_support(i, attach_req.ue_network_cap.uia[i]);
+            for(i=0; i<8; i++)
+            {
+                (*user)->set_uea_support(i, attach_req.ue_network_cap.uea[i]);
+            }
         }
-    }
-    if(attach_req.ms_network_cap_present)
-    {
-        for(i=1; i<8; i++)
+        if(attach_req.ue_network_cap.uia_present)
         {
-            (*user)->set_gea_support(i, attach_req.ms_network_cap.gea[i]);
+            for(i=1; i<8; i++)
+            {
+                (*user)->set_uia_support(i, attach_req.ue_network_cap.uia[i]);
+            }
+        }
+        if(attach_req.ms_network_cap_present)
+        {
+            for(i=1; i<8; i++)
+            {
+                (*user)->set_gea_support(i, attach_req.ms_network_cap.gea[i]);
+            }
         }
-    }
 
-    // Send an info message
-    if(LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI == attach_req.eps_mobile_id.type_of_id)
-    {
-        if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(&attach_req.eps_mobile_id.guti, &act_user))
+        // Send an info message
+        if(LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI == attach_req.eps_mobile_id.type_of_id)
         {
-            if(act_user != (*user))
+            if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(&attach_req.eps_mobile_id.guti, &act_user))
+            {
+                if(act_user != (*user))
+                {
+                    (*user)->get_srb0(&tmp_rb);
+                    act_user->copy_rb(tmp_rb);
+                    (*user)->get_srb1(&tmp_rb);
+                    act_user->copy_rb(tmp_rb);
+                    user_mgr->transfer_c_rnti(*user, act_user);
+                    *user = act_user;
+                    (*user)->get_srb1(rb);
+                }
+                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                                          __FILE__,
+                                          __LINE__,
+                                          "IMSI=%015llu is associated with RNTI=%u, RB=%s",
+                                          imsi_num,
+                                          (*user)->get_c_rnti(),
+                                          LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
+                (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_ATTACH_ACCEPT);
+            }else{
+                if((*user)->is_id_set())
+                {
+                    if((*user)->get_eea_support(0) && (*user)->get_eia_support(2))
+                    {
+                        (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_AUTHENTICATE);
+                    }else{
+                        (*user)->set_emm_cause(LIBLTE_MME_EMM_CAUSE_UE_SECURITY_CAPABILITIES_MISMATCH);
+                        (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_REJECT);
+                    }
+                }else{
+                    (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_ID_REQUEST_IMSI);
+                }
+            }
+        }else if(LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI == attach_req.eps_mobile_id.type_of_id){
+            for(i=0; i<15; i++)
             {
-                (*user)->get_srb0(&tmp_rb);
-                act_user->copy_rb(tmp_rb);
-                (*user)->get_srb1(&tmp_rb);
-                act_user->copy_rb(tmp_rb);
-                user_mgr->transfer_c_rnti(*user, act_user);
-                *user = act_user;
-                (*user)->get_srb1(rb);
+                imsi_num *= 10;
+                imsi_num += attach_req.eps_mobile_id.imsi[i];
             }
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                       LTE_FDD_ENB_DEBUG_LEVEL_MME,
@@ -468,76 +560,48 @@ void LTE_fdd_enb_mme::parse_attach_request(LIBLTE_BYTE_MSG_STRUCT  *msg,
                                       imsi_num,
                                       (*user)->get_c_rnti(),
                                       LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
-            (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_ATTACH_ACCEPT);
-        }else{
-            if((*user)->is_id_set())
+            if(hss->is_imsi_allowed(imsi_num))
             {
                 if((*user)->get_eea_support(0) && (*user)->get_eia_support(2))
                 {
                     (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_AUTHENTICATE);
+                    (*user)->set_id(hss->get_user_id_from_imsi(imsi_num));
                 }else{
                     (*user)->set_emm_cause(LIBLTE_MME_EMM_CAUSE_UE_SECURITY_CAPABILITIES_MISMATCH);
                     (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_REJECT);
                 }
             }else{
-                (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_ID_REQUEST_IMSI);
-            }
-        }
-    }else if(LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI == attach_req.eps_mobile_id.type_of_id){
-        for(i=0; i<15; i++)
-        {
-            imsi_num *= 10;
-            imsi_num += attach_req.eps_mobile_id.imsi[i];
-        }
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "IMSI=%015llu is associated with RNTI=%u, RB=%s",
-                                  imsi_num,
-                                  (*user)->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
-        if(hss->is_imsi_allowed(imsi_num))
-        {
-            if((*user)->get_eea_support(0) && (*user)->get_eia_support(2))
-            {
-                (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_AUTHENTICATE);
-                (*user)->set_id(hss->get_user_id_from_imsi(imsi_num));
-            }else{
-                (*user)->set_emm_cause(LIBLTE_MME_EMM_CAUSE_UE_SECURITY_CAPABILITIES_MISMATCH);
+                (*user)->set_temp_id(imsi_num);
                 (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_REJECT);
             }
         }else{
-            (*user)->set_temp_id(imsi_num);
-            (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_REJECT);
-        }
-    }else{
-        for(i=0; i<15; i++)
-        {
-            imei_num *= 10;
-            imei_num += attach_req.eps_mobile_id.imei[i];
-        }
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "IMEI=%015llu is associated with RNTI=%u, RB=%s",
-                                  imei_num,
-                                  (*user)->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
-        if(hss->is_imei_allowed(imei_num))
-        {
-            if((*user)->get_eea_support(0) && (*user)->get_eia_support(2))
+            for(i=0; i<15; i++)
+            {
+                imei_num *= 10;
+                imei_num += attach_req.eps_mobile_id.imei[i];
+            }
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                                      __FILE__,
+                                      __LINE__,
+                                      "IMEI=%015llu is associated with RNTI=%u, RB=%s",
+                                      imei_num,
+                                      (*user)->get_c_rnti(),
+                                      LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
+            if(hss->is_imei_allowed(imei_num))
             {
-                (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_AUTHENTICATE);
-                (*user)->set_id(hss->get_user_id_from_imei(imei_num));
+                if((*user)->get_eea_support(0) && (*user)->get_eia_support(2))
+                {
+                    (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_AUTHENTICATE);
+                    (*user)->set_id(hss->get_user_id_from_imei(imei_num));
+                }else{
+                    (*user)->set_emm_cause(LIBLTE_MME_EMM_CAUSE_UE_SECURITY_CAPABILITIES_MISMATCH);
+                    (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_REJECT);
+                }
             }else{
-                (*user)->set_emm_cause(LIBLTE_MME_EMM_CAUSE_UE_SECURITY_CAPABILITIES_MISMATCH);
+                (*user)->set_temp_id(imei_num);
                 (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_REJECT);
             }
-        }else{
-            (*user)->set_temp_id(imei_num);
-            (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_REJECT);
         }
     }
 }
@@ -547,6 +611,7 @@ void LTE_fdd_enb_mme::parse_authentication_failure(LIBLTE_BYTE_MSG_STRUCT *msg,
 {
     LTE_fdd_enb_interface                        *interface = LTE_fdd_enb_interface::get_instance();
     LTE_fdd_enb_hss                              *hss       = LTE_fdd_enb_hss::get_instance();
+    LTE_fdd_enb_cnfg_reader                       cnfg;
     LIBLTE_MME_AUTHENTICATION_FAILURE_MSG_STRUCT  auth_fail;
 
     interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
@@ -561,11 +626,10 @@ void LTE_fdd_enb_mme::parse_authentication_failure(LIBLTE_BYTE_MSG_STRUCT *msg,
     liblte_mme_unpack_authentication_failure_msg(msg, &auth_fail);
 
     if(LIBLTE_MME_EMM_CAUSE_SYNCH_FAILURE == auth_fail.emm_cause &&
-       auth_fail.auth_fail_param_present)
+       auth_fail.auth_fail_param_present                    &&
+       NULL != user->get_pending_auth_vec())
     {
-        sys_info_mutex.lock();
-        hss->security_resynch(user->get_id(), sys_info.mcc, sys_info.mnc, auth_fail.auth_fail_param);
-        sys_info_mutex.unlock();
+        hss->security_resynch(user->get_id(), cnfg.sys_info->mcc, cnfg.sys_info->mnc, user->get_pending_auth_vec()->rand, auth_fail.auth_fail_param);
     }else{
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                   LTE_FDD_ENB_DEBUG_LEVEL_MME,
@@ -583,8 +647,7 @@ void LTE_fdd_enb_mme::parse_authentication_response(LIBLTE_BYTE_MSG_STRUCT *msg,
                                                     LTE_fdd_enb_rb         *rb)
 {
     LTE_fdd_enb_interface                         *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_fdd_enb_hss                               *hss       = LTE_fdd_enb_hss::get_instance();
-    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT      *auth_vec  = NULL;
+    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT      *auth_vec  = user->get_pending_auth_vec();
     LIBLTE_MME_AUTHENTICATION_RESPONSE_MSG_STRUCT  auth_resp;
     uint32                                         i;
     bool                                           res_match = true;
@@ -597,15 +660,15 @@ void LTE_fdd_enb_mme::parse_authentication_response(LIBLTE_BYTE_MSG_STRUCT *msg,
                               user->get_c_rnti(),
                               LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
-    // Unpack the message
-    liblte_mme_unpack_authentication_response_msg(msg, &auth_resp);
+    // Unpack the message, a malformed one never matches and a short
+    // RES is compared against zeros
+    memset(auth_resp.res, 0, sizeof(auth_resp.res));
+    res_match = (LIBLTE_SUCCESS == liblte_mme_unpack_authentication_response_msg(msg, &auth_resp));
 
-    // Check RES
-    auth_vec = hss->get_auth_vec(user->get_id());
+    // Check RES against the vector sent to this UE
     if(NULL != auth_vec)
     {
-        res_match = true;
-        for(i=0; i<8; i++)
+        for(i=0; i<8 && res_match; i++)
         {
             if(auth_vec->res[i] != auth_resp.res[i])
             {
@@ -627,6 +690,7 @@ void LTE_fdd_enb_mme::parse_authentication_response(LIBLTE_BYTE_MSG_STRUCT *msg,
                                       user->get_c_rnti(),
                                       LTE_fdd_enb_rb_text[rb->get_rb_id()]);
             user->set_auth_vec(auth_vec);
+            user->set_pending_auth_vec(NULL);
             rb->set_mme_state(LTE_FDD_ENB_MME_STATE_ENABLE_SECURITY);
         }else{
             interface->send_ctrl_info_msg("user authentication rejected (RES MISMATCH) imsi=%s imei=%s",
@@ -834,10 +898,8 @@ void LTE_fdd_enb_mme::parse_service_request(LIBLTE_BYTE_MSG_STRUCT *msg,
     LTE_fdd_enb_interface                    *interface = LTE_fdd_enb_interface::get_instance();
     LTE_fdd_enb_hss                          *hss       = LTE_fdd_enb_hss::get_instance();
     LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT *auth_vec  = user->get_auth_vec();
-    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT *hss_auth_vec;
     LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT      cmd_ready;
     LIBLTE_MME_SERVICE_REQUEST_MSG_STRUCT     service_req;
-    uint32                                    i;
 
     interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                               LTE_FDD_ENB_DEBUG_LEVEL_MME,
@@ -847,8 +909,12 @@ void LTE_fdd_enb_mme::parse_service_request(LIBLTE_BYTE_MSG_STRUCT *msg,
                               user->get_c_rnti(),
                               LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
-    // Unpack the message
-    liblte_mme_unpack_service_request_msg(msg, &service_req);
+    // Unpack the message, a truncated one is treated as "no key is available"
+    if(LIBLTE_SUCCESS != liblte_mme_unpack_service_request_msg(msg, &service_req))
+    {
+        service_req.ksi_and_seq_num.ksi     = 7;
+        service_req.ksi_and_seq_num.seq_num = 0;
+    }
 
     // Set the procedure
     rb->set_mme_procedure(LTE_FDD_ENB_MME_PROC_SERVICE_REQUEST);
@@ -884,12 +950,7 @@ void LTE_fdd_enb_mme::parse_service_request(LIBLTE_BYTE_MSG_STRUCT *msg,
 
             // Resolve sequence number mismatch
             auth_vec->nas_count_ul = service_req.ksi_and_seq_num.seq_num;
-            hss_auth_vec           = hss->regenerate_enb_security_data(user->get_id(), auth_vec->nas_count_ul);
-            for(i=0; i<32; i++)
-            {
-                auth_vec->k_rrc_enc[i] = hss_auth_vec->k_rrc_enc[i];
-                auth_vec->k_rrc_int[i] = hss_auth_vec->k_rrc_int[i];
-            }
+            hss->regenerate_enb_security_data(auth_vec, auth_vec->nas_count_ul);
         }
 
         // Set the state
@@ -958,83 +1019,93 @@ void LTE_fdd_enb_mme::parse_pdn_connectivity_request(LIBLTE_BYTE_MSG_STRUCT *msg
                               LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Unpack the message
-    liblte_mme_unpack_pdn_connectivity_request_msg(msg, &pdn_con_req);
-
-    // Store the EPS Bearer ID
-    user->set_eps_bearer_id(pdn_con_req.eps_bearer_id);
+    if(LIBLTE_SUCCESS != liblte_mme_unpack_pdn_connectivity_request_msg(msg, &pdn_con_req))
+    {
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Malformed PDN Connectivity Request for RNTI=%u and RB=%s",
+                                  user->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    }else{
+        // Store the EPS Bearer ID
+        user->set_eps_bearer_id(pdn_con_req.eps_bearer_id);
 
-    // Store the Procedure Transaction ID
-    user->set_proc_transaction_id(pdn_con_req.proc_transaction_id);
+        // Store the Procedure Transaction ID
+        user->set_proc_transaction_id(pdn_con_req.proc_transaction_id);
 
-    // Store the PDN Type
-    user->set_pdn_type(pdn_con_req.pdn_type);
+        // Store the PDN Type
+        user->set_pdn_type(pdn_con_req.pdn_type);
 
-    // Store the ESM Information Transfer Flag
-//    if(pdn_con_req.esm_info_transfer_flag_present &&
-//       LIBLTE_MME_ESM_INFO_TRANSFER_FLAG_REQUIRED == pdn_con_req.esm_info_transfer_flag)
-//    {
-//        user->set_esm_info_transfer(true);
-//    }else{
-        user->set_esm_info_transfer(false);
-//    }
+        // Store the ESM Information Transfer Flag
+//        if(pdn_con_req.esm_info_transfer_flag_present &&
+//           LIBLTE_MME_ESM_INFO_TRANSFER_FLAG_REQUIRED == pdn_con_req.esm_info_transfer_flag)
+//        {
+//            user->set_esm_info_transfer(true);
+//        }else{
+            user->set_esm_info_transfer(false);
+//        }
 
-    if(pdn_con_req.protocol_cnfg_opts_present)
-    {
-        pco_resp.N_opts = 0;
-        for(i=0; i<pdn_con_req.protocol_cnfg_opts.N_opts; i++)
+        if(pdn_con_req.protocol_cnfg_opts_present)
         {
-            if(LIBLTE_MME_CONFIGURATION_PROTOCOL_OPTIONS_IPCP == pdn_con_req.protocol_cnfg_opts.opt[i].id)
+            pco_resp.N_opts = 0;
+            for(i=0; i<pdn_con_req.protocol_cnfg_opts.N_opts; i++)
             {
-                if(0x01 == pdn_con_req.protocol_cnfg_opts.opt[i].contents[0] &&
-                   0x81 == pdn_con_req.protocol_cnfg_opts.opt[i].contents[4] &&
-                   0x83 == pdn_con_req.protocol_cnfg_opts.opt[i].contents[10])
+                if(LIBLTE_MME_CONFIGURATION_PROTOCOL_OPTIONS_IPCP == pdn_con_req.protocol_cnfg_opts.opt[i].id)
                 {
-                    pco_resp.opt[pco_resp.N_opts].id           = LIBLTE_MME_CONFIGURATION_PROTOCOL_OPTIONS_IPCP;
-                    pco_resp.opt[pco_resp.N_opts].len          = 16;
-                    pco_resp.opt[pco_resp.N_opts].contents[0]  = 0x03;
-                    pco_resp.opt[pco_resp.N_opts].contents[1]  = pdn_con_req.protocol_cnfg_opts.opt[i].contents[1];
-                    pco_resp.opt[pco_resp.N_opts].contents[2]  = 0x00;
-                    pco_resp.opt[pco_resp.N_opts].contents[3]  = 0x10;
-                    pco_resp.opt[pco_resp.N_opts].contents[4]  = 0x81;
-                    pco_resp.opt[pco_resp.N_opts].contents[5]  = 0x06;
-                    pco_resp.opt[pco_resp.N_opts].contents[6]  = (dns_addr >> 24) & 0xFF;
-                    pco_resp.opt[pco_resp.N_opts].contents[7]  = (dns_addr >> 16) & 0xFF;
-                    pco_resp.opt[pco_resp.N_opts].contents[8]  = (dns_addr >> 8) & 0xFF;
-                    pco_resp.opt[pco_resp.N_opts].contents[9]  = dns_addr & 0xFF;
-                    pco_resp.opt[pco_resp.N_opts].contents[10] = 0x83;
-                    pco_resp.opt[pco_resp.N_opts].contents[11] = 0x06;
-                    pco_resp.opt[pco_resp.N_opts].contents[12] = (dns_addr >> 24) & 0xFF;
-                    pco_resp.opt[pco_resp.N_opts].contents[13] = (dns_addr >> 16) & 0xFF;
-                    pco_resp.opt[pco_resp.N_opts].contents[14] = (dns_addr >> 8) & 0xFF;
-                    pco_resp.opt[pco_resp.N_opts].contents[15] = dns_addr & 0xFF;
+                    if(16   <= pdn_con_req.protocol_cnfg_opts.opt[i].len         &&
+                       0x01 == pdn_con_req.protocol_cnfg_opts.opt[i].contents[0] &&
+                       0x81 == pdn_con_req.protocol_cnfg_opts.opt[i].contents[4] &&
+                       0x83 == pdn_con_req.protocol_cnfg_opts.opt[i].contents[10])
+                    {
+                        pco_resp.opt[pco_resp.N_opts].id           = LIBLTE_MME_CONFIGURATION_PROTOCOL_OPTIONS_IPCP;
+                        pco_resp.opt[pco_resp.N_opts].len          = 16;
+                        pco_resp.opt[pco_resp.N_opts].contents[0]  = 0x03;
+                        pco_resp.opt[pco_resp.N_opts].contents[1]  = pdn_con_req.protocol_cnfg_opts.opt[i].contents[1];
+                        pco_resp.opt[pco_resp.N_opts].contents[2]  = 0x00;
+                        pco_resp.opt[pco_resp.N_opts].contents[3]  = 0x10;
+                        pco_resp.opt[pco_resp.N_opts].contents[4]  = 0x81;
+                        pco_resp.opt[pco_resp.N_opts].contents[5]  = 0x06;
+                        pco_resp.opt[pco_resp.N_opts].contents[6]  = (dns_addr >> 24) & 0xFF;
+                        pco_resp.opt[pco_resp.N_opts].contents[7]  = (dns_addr >> 16) & 0xFF;
+                        pco_resp.opt[pco_resp.N_opts].contents[8]  = (dns_addr >> 8) & 0xFF;
+                        pco_resp.opt[pco_resp.N_opts].contents[9]  = dns_addr & 0xFF;
+                        pco_resp.opt[pco_resp.N_opts].contents[10] = 0x83;
+                        pco_resp.opt[pco_resp.N_opts].contents[11] = 0x06;
+                        pco_resp.opt[pco_resp.N_opts].contents[12] = (dns_addr >> 24) & 0xFF;
+                        pco_resp.opt[pco_resp.N_opts].contents[13] = (dns_addr >> 16) & 0xFF;
+                        pco_resp.opt[pco_resp.N_opts].contents[14] = (dns_addr >> 8) & 0xFF;
+                        pco_resp.opt[pco_resp.N_opts].contents[15] = dns_addr & 0xFF;
+                        pco_resp.N_opts++;
+                    }else{
+                        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                                                  __FILE__,
+                                                  __LINE__,
+                                                  "Unknown PCO");
+                    }
+                }else if(LIBLTE_MME_ADDITIONAL_PARAMETERS_UL_DNS_SERVER_IPV4_ADDRESS_REQUEST == pdn_con_req.protocol_cnfg_opts.opt[i].id){
+                    pco_resp.opt[pco_resp.N_opts].id          = LIBLTE_MME_ADDITIONAL_PARAMETERS_DL_DNS_SERVER_IPV4_ADDRESS;
+                    pco_resp.opt[pco_resp.N_opts].len         = 4;
+                    pco_resp.opt[pco_resp.N_opts].contents[0] = (dns_addr >> 24) & 0xFF;
+                    pco_resp.opt[pco_resp.N_opts].contents[1] = (dns_addr >> 16) & 0xFF;
+                    pco_resp.opt[pco_resp.N_opts].contents[2] = (dns_addr >> 8) & 0xFF;
+                    pco_resp.opt[pco_resp.N_opts].contents[3] = dns_addr & 0xFF;
                     pco_resp.N_opts++;
+                }else if(LIBLTE_MME_ADDITIONAL_PARAMETERS_UL_IP_ADDRESS_ALLOCATION_VIA_NAS_SIGNALLING == pdn_con_req.protocol_cnfg_opts.opt[i].id){
+                    // Nothing to do
                 }else{
                     interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                               LTE_FDD_ENB_DEBUG_LEVEL_MME,
                                               __FILE__,
                                               __LINE__,
-                                              "Unknown PCO");
+                                              "Invalid PCO ID (%04X)",
+                                              pdn_con_req.protocol_cnfg_opts.opt[i].id);
                 }
-            }else if(LIBLTE_MME_ADDITIONAL_PARAMETERS_UL_DNS_SERVER_IPV4_ADDRESS_REQUEST == pdn_con_req.protocol_cnfg_opts.opt[i].id){
-                pco_resp.opt[pco_resp.N_opts].id          = LIBLTE_MME_ADDITIONAL_PARAMETERS_DL_DNS_SERVER_IPV4_ADDRESS;
-                pco_resp.opt[pco_resp.N_opts].len         = 4;
-                pco_resp.opt[pco_resp.N_opts].contents[0] = (dns_addr >> 24) & 0xFF;
-                pco_resp.opt[pco_resp.N_opts].contents[1] = (dns_addr >> 16) & 0xFF;
-                pco_resp.opt[pco_resp.N_opts].contents[2] = (dns_addr >> 8) & 0xFF;
-                pco_resp.opt[pco_resp.N_opts].contents[3] = dns_addr & 0xFF;
-                pco_resp.N_opts++;
-            }else if(LIBLTE_MME_ADDITIONAL_PARAMETERS_UL_IP_ADDRESS_ALLOCATION_VIA_NAS_SIGNALLING == pdn_con_req.protocol_cnfg_opts.opt[i].id){
-                // Nothing to do
-            }else{
-                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                          __FILE__,
-                                          __LINE__,
-                                          "Invalid PCO ID (%04X)",
-                                          pdn_con_req.protocol_cnfg_opts.opt[i].id);
             }
+            user->set_protocol_cnfg_opts(&pco_resp);
         }
-        user->set_protocol_cnfg_opts(&pco_resp);
     }
 }
 
@@ -1044,8 +1115,10 @@ void LTE_fdd_enb_mme::parse_pdn_connectivity_request(LIBLTE_BYTE_MSG_STRUCT *msg
 void LTE_fdd_enb_mme::attach_sm(LTE_fdd_enb_user *user,
                                 LTE_fdd_enb_rb   *rb)
 {
-    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_fdd_enb_hss       *hss       = LTE_fdd_enb_hss::get_instance();
+    LTE_fdd_enb_interface                    *interface = LTE_fdd_enb_interface::get_instance();
+    LTE_fdd_enb_hss                          *hss       = LTE_fdd_enb_hss::get_instance();
+    LTE_fdd_enb_cnfg_reader                   cnfg;
+    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT  auth_vec;
 
     switch(rb->get_mme_state())
     {
@@ -1057,7 +1130,17 @@ void LTE_fdd_enb_mme::attach_sm(LTE_fdd_enb_user *user,
         send_attach_reject(user, rb);
         break;
     case LTE_FDD_ENB_MME_STATE_AUTHENTICATE:
-        send_authentication_request(user, rb);
+        if(hss->generate_security_data(user->get_id(), cnfg.sys_info->mcc, cnfg.sys_info->mnc, user, rb, &auth_vec))
+        {
+            user->set_pending_auth_vec(&auth_vec);
+            send_authentication_request(user, rb);
+        }else{
+            // Continued by handle_auth_vec_ready
+            rb->set_mme_state(LTE_FDD_ENB_MME_STATE_WAIT_FOR_AUTH_VEC);
+        }
+        break;
+    case LTE_FDD_ENB_MME_STATE_WAIT_FOR_AUTH_VEC:
+        // Nothing to do until the HSS has a vector
         break;
     case LTE_FDD_ENB_MME_STATE_AUTH_REJECTED:
         send_authentication_reject(user, rb);
@@ -1127,14 +1210,20 @@ void LTE_fdd_enb_mme::service_req_sm(LTE_fdd_enb_user *user,
 void LTE_fdd_enb_mme::send_attach_accept(LTE_fdd_enb_user *user,
                                          LTE_fdd_enb_rb   *rb)
 {
-    LTE_fdd_enb_interface                                             *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_fdd_enb_user_mgr                                              *user_mgr  = LTE_fdd_enb_user_mgr::get_instance();
-    LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT                               cmd_ready;
-    LIBLTE_MME_ATTACH_ACCEPT_MSG_STRUCT                                attach_accept;
-    LIBLTE_MME_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_MSG_STRUCT  act_def_eps_bearer_context_req;
-    LIBLTE_MME_PROTOCOL_CONFIG_OPTIONS_STRUCT                         *pco = user->get_protocol_cnfg_opts();
-    LIBLTE_BYTE_MSG_STRUCT                                             msg;
-    uint32                                                             ip_addr;
+    LTE_fdd_enb_interface                         *interface = LTE_fdd_enb_interface::get_instance();
+    LTE_fdd_enb_user_mgr                          *user_mgr  = LTE_fdd_enb_user_mgr::get_instance();
+    LTE_fdd_enb_cnfg_reader                        cnfg;
+    LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT           cmd_ready;
+    LIBLTE_MME_NAS_BUILDER_STRUCT                  builder;
+    LIBLTE_MME_GPRS_TIMER_STRUCT                   t3412;
+    LIBLTE_MME_TRACKING_AREA_IDENTITY_LIST_STRUCT  tai_list;
+    LIBLTE_MME_EPS_QUALITY_OF_SERVICE_STRUCT       eps_qos;
+    LIBLTE_MME_ACCESS_POINT_NAME_STRUCT            apn;
+    LIBLTE_MME_PDN_ADDRESS_STRUCT                  pdn_addr;
+    LIBLTE_MME_EPS_MOBILE_ID_STRUCT                guti;
+    LIBLTE_MME_PROTOCOL_CONFIG_OPTIONS_STRUCT     *pco = user->get_protocol_cnfg_opts();
+    LIBLTE_BYTE_MSG_STRUCT                         msg;
+    uint32                                         ip_addr;
 
     // Assign IP address to user
     user->set_ip_addr(get_next_ip_addr());
@@ -1142,84 +1231,83 @@ void LTE_fdd_enb_mme::send_attach_accept(LTE_fdd_enb_user *user,
 
     if(0 == user->get_eps_bearer_id())
     {
-        act_def_eps_bearer_context_req.eps_bearer_id = 5;
         user->set_eps_bearer_id(5);
-    }else{
-        act_def_eps_bearer_context_req.eps_bearer_id = user->get_eps_bearer_id();
     }
     if(0 == user->get_proc_transaction_id())
     {
-        act_def_eps_bearer_context_req.proc_transaction_id = 1;
         user->set_proc_transaction_id(1);
-    }else{
-        act_def_eps_bearer_context_req.proc_transaction_id = user->get_proc_transaction_id();
     }
-    act_def_eps_bearer_context_req.eps_qos.qci            = 9;
-    act_def_eps_bearer_context_req.eps_qos.br_present     = false;
-    act_def_eps_bearer_context_req.eps_qos.br_ext_present = false;
-    act_def_eps_bearer_context_req.apn.apn                = "www.openLTE.com";
-    act_def_eps_bearer_context_req.pdn_addr.pdn_type      = LIBLTE_MME_PDN_TYPE_IPV4;
-    act_def_eps_bearer_context_req.pdn_addr.addr[0]       = (ip_addr >> 24) & 0xFF;
-    act_def_eps_bearer_context_req.pdn_addr.addr[1]       = (ip_addr >> 16) & 0xFF;
-    act_def_eps_bearer_context_req.pdn_addr.addr[2]       = (ip_addr >> 8) & 0xFF;
-    act_def_eps_bearer_context_req.pdn_addr.addr[3]       = ip_addr & 0xFF;
-    act_def_eps_bearer_context_req.transaction_id_present = false;
-    act_def_eps_bearer_context_req.negotiated_qos_present = false;
-    act_def_eps_bearer_context_req.llc_sapi_present       = false;
-    act_def_eps_bearer_context_req.radio_prio_present     = false;
-    act_def_eps_bearer_context_req.packet_flow_id_present = false;
-    act_def_eps_bearer_context_req.apn_ambr_present       = false;
-    if(LIBLTE_MME_PDN_TYPE_IPV4 == user->get_pdn_type())
+
+    // Attach Accept, built directly into the output message
+    liblte_mme_nas_builder_start(&msg,
+                                 LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED,
+                                 user->get_auth_vec()->nas_count_dl,
+                                 &builder);
+    liblte_mme_nas_builder_add_emm_header(&builder, LIBLTE_MME_MSG_TYPE_ATTACH_ACCEPT);
+
+    // EPS Attach Result & Spare Half Octet
+    *builder.msg_ptr = 0;
+    liblte_mme_pack_eps_attach_result_ie(user->get_attach_type(), 0, &builder.msg_ptr);
+    builder.msg_ptr++;
+
+    // T3412 Value
+    t3412.unit  = LIBLTE_MME_GPRS_TIMER_DEACTIVATED;
+    t3412.value = 0;
+    liblte_mme_pack_gprs_timer_ie(&t3412, &builder.msg_ptr);
+
+    // TAI List
+    tai_list.N_tais     = 1;
+    tai_list.tai[0].mcc = cnfg.sys_info->mcc;
+    tai_list.tai[0].mnc = cnfg.sys_info->mnc;
+    tai_list.tai[0].tac = cnfg.sys_info->sib1.tracking_area_code;
+    liblte_mme_pack_tracking_area_identity_list_ie(&tai_list, &builder.msg_ptr);
+
+    // ESM Message Container, holding the Activate Default EPS Bearer Context Request
+    liblte_mme_nas_builder_open_esm_msg_container(&builder);
+    liblte_mme_nas_builder_add_esm_header(&builder,
+                                          user->get_eps_bearer_id(),
+                                          user->get_proc_transaction_id(),
+                                          LIBLTE_MME_MSG_TYPE_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST);
+    eps_qos.qci            = LTE_FDD_ENB_DEF_BEARER_QCI;
+    eps_qos.br_present     = false;
+    eps_qos.br_ext_present = false;
+    liblte_mme_pack_eps_quality_of_service_ie(&eps_qos, &builder.msg_ptr);
+    apn.apn = "www.openLTE.com";
+    liblte_mme_pack_access_point_name_ie(&apn, &builder.msg_ptr);
+    pdn_addr.pdn_type = LIBLTE_MME_PDN_TYPE_IPV4;
+    pdn_addr.addr[0]  = (ip_addr >> 24) & 0xFF;
+    pdn_addr.addr[1]  = (ip_addr >> 16) & 0xFF;
+    pdn_addr.addr[2]  = (ip_addr >> 8) & 0xFF;
+    pdn_addr.addr[3]  = ip_addr & 0xFF;
+    liblte_mme_pack_pdn_address_ie(&pdn_addr, &builder.msg_ptr);
+    if(LIBLTE_MME_PDN_TYPE_IPV4 != user->get_pdn_type())
     {
-        act_def_eps_bearer_context_req.esm_cause_present = false;
-    }else{
-        act_def_eps_bearer_context_req.esm_cause_present = true;
-        act_def_eps_bearer_context_req.esm_cause         = LIBLTE_MME_ESM_CAUSE_PDN_TYPE_IPV4_ONLY_ALLOWED;
+        liblte_mme_nas_builder_add_iei(&builder, LIBLTE_MME_ESM_CAUSE_IEI);
+        liblte_mme_pack_esm_cause_ie(LIBLTE_MME_ESM_CAUSE_PDN_TYPE_IPV4_ONLY_ALLOWED, &builder.msg_ptr);
     }
     if(0 != pco->N_opts)
     {
-        act_def_eps_bearer_context_req.protocol_cnfg_opts_present = true;
-        memcpy(&act_def_eps_bearer_context_req.protocol_cnfg_opts, pco, sizeof(LIBLTE_MME_PROTOCOL_CONFIG_OPTIONS_STRUCT));
-    }else{
-        act_def_eps_bearer_context_req.protocol_cnfg_opts_present = false;
+        liblte_mme_nas_builder_add_iei(&builder, LIBLTE_MME_PROTOCOL_CONFIGURATION_OPTIONS_IEI);
+        liblte_mme_pack_protocol_config_options_ie(pco, &builder.msg_ptr);
     }
-    act_def_eps_bearer_context_req.connectivity_type_present = false;
-    liblte_mme_pack_activate_default_eps_bearer_context_request_msg(&act_def_eps_bearer_context_req,
-                                                                    &attach_accept.esm_msg);
-
-    sys_info_mutex.lock();
-    attach_accept.eps_attach_result                   = user->get_attach_type();
-    attach_accept.t3412.unit                          = LIBLTE_MME_GPRS_TIMER_DEACTIVATED;
-    attach_accept.tai_list.N_tais                     = 1;
-    attach_accept.tai_list.tai[0].mcc                 = sys_info.mcc;
-    attach_accept.tai_list.tai[0].mnc                 = sys_info.mnc;
-    attach_accept.tai_list.tai[0].tac                 = sys_info.sib1.tracking_area_code;
-    attach_accept.guti_present                        = true;
-    attach_accept.guti.type_of_id                     = LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI;
-    attach_accept.guti.guti.mcc                       = sys_info.mcc;
-    attach_accept.guti.guti.mnc                       = sys_info.mnc;
-    attach_accept.guti.guti.mme_group_id              = 0;
-    attach_accept.guti.guti.mme_code                  = 0;
-    attach_accept.guti.guti.m_tmsi                    = user_mgr->get_next_m_tmsi();
-    attach_accept.lai_present                         = false;
-    attach_accept.ms_id_present                       = false;
-    attach_accept.emm_cause_present                   = false;
-    attach_accept.t3402_present                       = false;
-    attach_accept.t3423_present                       = false;
-    attach_accept.equivalent_plmns_present            = false;
-    attach_accept.emerg_num_list_present              = false;
-    attach_accept.eps_network_feature_support_present = false;
-    attach_accept.additional_update_result_present    = false;
-    attach_accept.t3412_ext_present                   = false;
-    sys_info_mutex.unlock();
-    user->set_guti(&attach_accept.guti.guti);
-    liblte_mme_pack_attach_accept_msg(&attach_accept,
-                                      LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED,
-                                      user->get_auth_vec()->k_nas_int,
-                                      user->get_auth_vec()->nas_count_dl,
-                                      LIBLTE_SECURITY_DIRECTION_DOWNLINK,
-                                      rb->get_rb_id()-1,
-                                      &msg);
+    liblte_mme_nas_builder_close_esm_msg_container(&builder);
+
+    // GUTI
+    guti.type_of_id        = LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI;
+    guti.guti.mcc          = cnfg.sys_info->mcc;
+    guti.guti.mnc          = cnfg.sys_info->mnc;
+    guti.guti.mme_group_id = 0;
+    guti.guti.mme_code     = 0;
+    guti.guti.m_tmsi       = user_mgr->get_next_m_tmsi();
+    liblte_mme_nas_builder_add_iei(&builder, LIBLTE_MME_GUTI_IEI);
+    liblte_mme_pack_eps_mobile_id_ie(&guti, &builder.msg_ptr);
+    user->set_guti(&guti.guti);
+
+    liblte_mme_nas_builder_finish(&builder,
+                                  user->get_auth_vec()->k_nas_int,
+                                  user->get_auth_vec()->nas_count_dl,
+                                  LIBLTE_SECURITY_DIRECTION_DOWNLINK,
+                                  rb->get_rb_id()-1);
     user->increment_nas_count_dl();
     interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                               LTE_FDD_ENB_DEBUG_LEVEL_MME,
@@ -1237,11 +1325,11 @@ void LTE_fdd_enb_mme::send_attach_accept(LTE_fdd_enb_user *user,
     cmd_ready.user = user;
     cmd_ready.rb   = rb;
     cmd_ready.cmd  = LTE_FDD_ENB_RRC_CMD_SETUP_DEF_DRB;
-    LTE_fdd_enb_msgq::send(mme_rrc_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_RRC_CMD_READY,
-                           LTE_FDD_ENB_DEST_LAYER_RRC,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&cmd_ready,
-                           sizeof(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT));
+    worker_mgr->send(cmd_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_RRC_CMD_READY,
+                     LTE_FDD_ENB_DEST_LAYER_RRC,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&cmd_ready,
+                     sizeof(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT));
 }
 void LTE_fdd_enb_mme::send_attach_reject(LTE_fdd_enb_user *user,
                                          LTE_fdd_enb_rb   *rb)
@@ -1279,11 +1367,11 @@ void LTE_fdd_enb_mme::send_attach_reject(LTE_fdd_enb_user *user,
     // Signal RRC for NAS message
     nas_msg_ready.user = user;
     nas_msg_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(mme_rrc_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY,
-                           LTE_FDD_ENB_DEST_LAYER_RRC,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
-                           sizeof(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT));
+    worker_mgr->send(nas_msg_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY,
+                     LTE_FDD_ENB_DEST_LAYER_RRC,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
+                     sizeof(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT));
 
     send_rrc_command(user, rb, LTE_FDD_ENB_RRC_CMD_RELEASE);
 }
@@ -1311,11 +1399,11 @@ void LTE_fdd_enb_mme::send_authentication_reject(LTE_fdd_enb_user *user,
     // Signal RRC for NAS message
     nas_msg_ready.user = user;
     nas_msg_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(mme_rrc_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY,
-                           LTE_FDD_ENB_DEST_LAYER_RRC,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
-                           sizeof(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT));
+    worker_mgr->send(nas_msg_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY,
+                     LTE_FDD_ENB_DEST_LAYER_RRC,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
+                     sizeof(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT));
 
     send_rrc_command(user, rb, LTE_FDD_ENB_RRC_CMD_RELEASE);
 }
@@ -1323,17 +1411,12 @@ void LTE_fdd_enb_mme::send_authentication_request(LTE_fdd_enb_user *user,
                                                   LTE_fdd_enb_rb   *rb)
 {
     LTE_fdd_enb_interface                        *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_fdd_enb_hss                              *hss       = LTE_fdd_enb_hss::get_instance();
-    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT     *auth_vec  = NULL;
+    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT     *auth_vec  = user->get_pending_auth_vec();
     LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT      nas_msg_ready;
     LIBLTE_MME_AUTHENTICATION_REQUEST_MSG_STRUCT  auth_req;
     LIBLTE_BYTE_MSG_STRUCT                        msg;
     uint32                                        i;
 
-    sys_info_mutex.lock();
-    hss->generate_security_data(user->get_id(), sys_info.mcc, sys_info.mnc);
-    sys_info_mutex.unlock();
-    auth_vec = hss->get_auth_vec(user->get_id());
     if(NULL != auth_vec)
     {
         for(i=0; i<16; i++)
@@ -1359,11 +1442,11 @@ void LTE_fdd_enb_mme::send_authentication_request(LTE_fdd_enb_user *user,
         // Signal RRC
         nas_msg_ready.user = user;
         nas_msg_ready.rb   = rb;
-        LTE_fdd_enb_msgq::send(mme_rrc_mq,
-                               LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY,
-                               LTE_FDD_ENB_DEST_LAYER_RRC,
-                               (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
-                               sizeof(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT));
+        worker_mgr->send(nas_msg_ready.user,
+                         LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY,
+                         LTE_FDD_ENB_DEST_LAYER_RRC,
+                         (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
+                         sizeof(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT));
     }
 }
 void LTE_fdd_enb_mme::send_identity_request(LTE_fdd_enb_user *user,
@@ -1392,11 +1475,11 @@ void LTE_fdd_enb_mme::send_identity_request(LTE_fdd_enb_user *user,
     // Signal RRC
     nas_msg_ready.user = user;
     nas_msg_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(mme_rrc_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY,
-                           LTE_FDD_ENB_DEST_LAYER_RRC,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
-                           sizeof(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT));
+    worker_mgr->send(nas_msg_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY,
+                     LTE_FDD_ENB_DEST_LAYER_RRC,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
+                     sizeof(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT));
 }
 void LTE_fdd_enb_mme::send_security_mode_command(LTE_fdd_enb_user *user,
                                                  LTE_fdd_enb_rb   *rb)
@@ -1464,11 +1547,11 @@ void LTE_fdd_enb_mme::send_security_mode_command(LTE_fdd_enb_user *user,
     // Signal RRC
     nas_msg_ready.user = user;
     nas_msg_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(mme_rrc_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY,
-                           LTE_FDD_ENB_DEST_LAYER_RRC,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
-                           sizeof(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT));
+    worker_mgr->send(nas_msg_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY,
+                     LTE_FDD_ENB_DEST_LAYER_RRC,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
+                     sizeof(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT));
 }
 void LTE_fdd_enb_mme::send_service_reject(LTE_fdd_enb_user *user,
                                           LTE_fdd_enb_rb   *rb,
@@ -1503,11 +1586,11 @@ void LTE_fdd_enb_mme::send_service_reject(LTE_fdd_enb_user *user,
 
     nas_msg_ready.user = user;
     nas_msg_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(mme_rrc_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY,
-                           LTE_FDD_ENB_DEST_LAYER_RRC,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
-                           sizeof(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT));
+    worker_mgr->send(nas_msg_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY,
+                     LTE_FDD_ENB_DEST_LAYER_RRC,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
+                     sizeof(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT));
 }
 void LTE_fdd_enb_mme::send_activate_dedicated_eps_bearer_context_request(LTE_fdd_enb_user *user,
                                                                          LTE_fdd_enb_rb   *rb)
@@ -1527,11 +1610,11 @@ void LTE_fdd_enb_mme::send_activate_dedicated_eps_bearer_context_request(LTE_fdd
     }
     act_ded_eps_bearer_context_req.proc_transaction_id                       = 0;
     act_ded_eps_bearer_context_req.linked_eps_bearer_id                      = user->get_eps_bearer_id();
-    act_ded_eps_bearer_context_req.eps_qos.qci                               = 4;
-    act_ded_eps_bearer_context_req.eps_qos.mbr_ul                            = 0x68;
-    act_ded_eps_bearer_context_req.eps_qos.mbr_dl                            = 0x68;
-    act_ded_eps_bearer_context_req.eps_qos.gbr_ul                            = 0x48;
-    act_ded_eps_bearer_context_req.eps_qos.gbr_dl                            = 0x48;
+    act_ded_eps_bearer_context_req.eps_qos.qci                               = LTE_FDD_ENB_DED_BEARER_QCI;
+    act_ded_eps_bearer_context_req.eps_qos.mbr_ul                            = LTE_FDD_ENB_DED_BEARER_MBR;
+    act_ded_eps_bearer_context_req.eps_qos.mbr_dl                            = LTE_FDD_ENB_DED_BEARER_MBR;
+    act_ded_eps_bearer_context_req.eps_qos.gbr_ul                            = LTE_FDD_ENB_DED_BEARER_GBR;
+    act_ded_eps_bearer_context_req.eps_qos.gbr_dl                            = LTE_FDD_ENB_DED_BEARER_GBR;
     act_ded_eps_bearer_context_req.eps_qos.br_present                        = true;
     act_ded_eps_bearer_context_req.eps_qos.mbr_ul_ext                        = 0x00;
     act_ded_eps_bearer_context_req.eps_qos.mbr_dl_ext                        = 0x00;
@@ -1584,11 +1667,11 @@ void LTE_fdd_enb_mme::send_activate_dedicated_eps_bearer_context_request(LTE_fdd
     cmd_ready.user = user;
     cmd_ready.rb   = rb;
     cmd_ready.cmd  = LTE_FDD_ENB_RRC_CMD_SETUP_DED_DRB;
-    LTE_fdd_enb_msgq::send(mme_rrc_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_RRC_CMD_READY,
-                           LTE_FDD_ENB_DEST_LAYER_RRC,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&cmd_ready,
-                           sizeof(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT));
+    worker_mgr->send(cmd_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_RRC_CMD_READY,
+                     LTE_FDD_ENB_DEST_LAYER_RRC,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&cmd_ready,
+                     sizeof(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT));
 }
 void LTE_fdd_enb_mme::send_esm_information_request(LTE_fdd_enb_user *user,
                                                    LTE_fdd_enb_rb   *rb)
@@ -1630,11 +1713,11 @@ void LTE_fdd_enb_mme::send_esm_information_request(LTE_fdd_enb_user *user,
     // Signal RRC
     nas_msg_ready.user = user;
     nas_msg_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(mme_rrc_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY,
-                           LTE_FDD_ENB_DEST_LAYER_RRC,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
-                           sizeof(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT));
+    worker_mgr->send(nas_msg_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY,
+                     LTE_FDD_ENB_DEST_LAYER_RRC,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
+                     sizeof(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT));
 }
 void LTE_fdd_enb_mme::send_rrc_command(LTE_fdd_enb_user         *user,
                                        LTE_fdd_enb_rb           *rb,
@@ -1646,11 +1729,11 @@ void LTE_fdd_enb_mme::send_rrc_command(LTE_fdd_enb_user         *user,
     cmd_ready.user = user;
     cmd_ready.rb   = rb;
     cmd_ready.cmd  = cmd;
-    LTE_fdd_enb_msgq::send(mme_rrc_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_RRC_CMD_READY,
-                           LTE_FDD_ENB_DEST_LAYER_RRC,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&cmd_ready,
-                           sizeof(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT));
+    worker_mgr->send(cmd_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_RRC_CMD_READY,
+                     LTE_FDD_ENB_DEST_LAYER_RRC,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&cmd_ready,
+                     sizeof(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT));
 
     if(LTE_FDD_ENB_RRC_CMD_RELEASE == cmd)
     {
@@ -1664,7 +1747,8 @@ void LTE_fdd_enb_mme::send_rrc_command(LTE_fdd_enb_user         *user,
 /*****************/
 uint32 LTE_fdd_enb_mme::get_next_ip_addr(void)
 {
-    uint32 ip_addr = next_ip_addr;
+    boost::mutex::scoped_lock lock(ip_addr_mutex);
+    uint32                    ip_addr = next_ip_addr;
 
     next_ip_addr++;
     if((next_ip_addr & 0xFF) == 0xFF)
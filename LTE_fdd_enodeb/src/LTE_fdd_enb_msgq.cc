@@ -138,6 +138,7 @@ void LTE_fdd_enb_msgq::send(boost::interprocess::message_queue *mq,
 
     msg->type       = type;
     msg->dest_layer = dest_layer;
+    msg->user       = NULL;
     if(msg_content != NULL)
     {
         memcpy(&msg->msg, msg_content, msg_content_size);
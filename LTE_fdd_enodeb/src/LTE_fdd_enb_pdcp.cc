@@ -43,6 +43,7 @@
 #include "LTE_fdd_enb_rlc.h"
 #include "LTE_fdd_enb_interface.h"
 #include "liblte_pdcp.h"
+#include "liblte_rohc.h"
 #include "liblte_security.h"
 
 /*******************************************************************************
@@ -109,25 +110,13 @@ LTE_fdd_enb_pdcp::~LTE_fdd_enb_pdcp()
 void LTE_fdd_enb_pdcp::start(void)
 {
     boost::mutex::scoped_lock lock(start_mutex);
-    LTE_fdd_enb_msgq_cb       rlc_cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_pdcp, &LTE_fdd_enb_pdcp::handle_rlc_msg>, this);
-    LTE_fdd_enb_msgq_cb       rrc_cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_pdcp, &LTE_fdd_enb_pdcp::handle_rrc_msg>, this);
-    LTE_fdd_enb_msgq_cb       gw_cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_pdcp, &LTE_fdd_enb_pdcp::handle_gw_msg>, this);
 
     if(!started)
     {
-        started       = true;
-        rlc_comm_msgq = new LTE_fdd_enb_msgq("rlc_pdcp_mq",
-                                             rlc_cb);
-        rrc_comm_msgq = new LTE_fdd_enb_msgq("rrc_pdcp_mq",
-                                             rrc_cb);
-        gw_comm_msgq  = new LTE_fdd_enb_msgq("gw_pdcp_mq",
-                                             gw_cb);
-        pdcp_rlc_mq   = new boost::interprocess::message_queue(boost::interprocess::open_only,
-                                                               "pdcp_rlc_mq");
-        pdcp_rrc_mq   = new boost::interprocess::message_queue(boost::interprocess::open_only,
-                                                               "pdcp_rrc_mq");
-        pdcp_gw_mq    = new boost::interprocess::message_queue(boost::interprocess::open_only,
-                                                               "pdcp_gw_mq");
+        started    = true;
+        worker_mgr = LTE_fdd_enb_worker_mgr::get_instance();
+        pdcp_gw_mq = new boost::interprocess::message_queue(boost::interprocess::open_only,
+                                                            "pdcp_gw_mq");
     }
 }
 void LTE_fdd_enb_pdcp::stop(void)
@@ -137,8 +126,6 @@ void LTE_fdd_enb_pdcp::stop(void)
     if(started)
     {
         started = false;
-        delete rlc_comm_msgq;
-        delete rrc_comm_msgq;
     }
 }
 
@@ -170,7 +157,8 @@ void LTE_fdd_enb_pdcp::handle_rlc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
         }
     }else{
         // Forward message to RRC
-        pdcp_rrc_mq->send(&msg, sizeof(msg), 0);
+        worker_mgr->send(msg->user, msg->type, msg->dest_layer, &msg->msg, sizeof(LTE_FDD_ENB_MESSAGE_UNION));
+        delete msg;
     }
 }
 void LTE_fdd_enb_pdcp::handle_rrc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
@@ -198,7 +186,8 @@ void LTE_fdd_enb_pdcp::handle_rrc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
         }
     }else{
         // Forward message to RLC
-        pdcp_rlc_mq->send(&msg, sizeof(msg), 0);
+        worker_mgr->send(msg->user, msg->type, msg->dest_layer, &msg->msg, sizeof(LTE_FDD_ENB_MESSAGE_UNION));
+        delete msg;
     }
 }
 void LTE_fdd_enb_pdcp::handle_gw_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
@@ -234,18 +223,6 @@ void LTE_fdd_enb_pdcp::handle_gw_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
     }
 }
 
-/****************************/
-/*    External Interface    */
-/****************************/
-void LTE_fdd_enb_pdcp::update_sys_info(void)
-{
-    LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
-
-    sys_info_mutex.lock();
-    cnfg_db->get_sys_info(sys_info);
-    sys_info_mutex.unlock();
-}
-
 /******************************/
 /*    RLC Message Handlers    */
 /******************************/
@@ -256,7 +233,11 @@ void LTE_fdd_enb_pdcp::handle_pdu_ready(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT *p
     LTE_FDD_ENB_GW_DATA_READY_MSG_STRUCT      gw_data_ready;
     LIBLTE_PDCP_CONTROL_PDU_STRUCT            contents;
     LIBLTE_PDCP_DATA_PDU_WITH_LONG_SN_STRUCT  data_contents;
+    LIBLTE_PDCP_ROHC_FEEDBACK_PDU_STRUCT      feedback_contents;
     LIBLTE_BYTE_MSG_STRUCT                   *pdu;
+    LIBLTE_BYTE_MSG_STRUCT                   *ip_pkt;
+    LIBLTE_BYTE_MSG_STRUCT                    feedback;
+    LIBLTE_BYTE_MSG_STRUCT                    rohc_pkt;
     LIBLTE_BIT_MSG_STRUCT                     rrc_pdu;
     uint8                                    *pdu_ptr;
     uint32                                    i;
@@ -288,12 +269,13 @@ void LTE_fdd_enb_pdcp::handle_pdu_ready(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT *p
             // Signal RRC
             rrc_pdu_ready.user = pdu_ready->user;
             rrc_pdu_ready.rb   = pdu_ready->rb;
-            LTE_fdd_enb_msgq::send(pdcp_rrc_mq,
-                                   LTE_FDD_ENB_MESSAGE_TYPE_RRC_PDU_READY,
-                                   LTE_FDD_ENB_DEST_LAYER_RRC,
-                                   (LTE_FDD_ENB_MESSAGE_UNION *)&rrc_pdu_ready,
-                                   sizeof(LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT));
+            worker_mgr->send(rrc_pdu_ready.user,
+                             LTE_FDD_ENB_MESSAGE_TYPE_RRC_PDU_READY,
+                             LTE_FDD_ENB_DEST_LAYER_RRC,
+                             (LTE_FDD_ENB_MESSAGE_UNION *)&rrc_pdu_ready,
+                             sizeof(LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT));
         }else if(LTE_FDD_ENB_RB_SRB1 == pdu_ready->rb->get_rb_id()){
+            decipher_pdu(pdu_ready->rb, pdu, 5);
             liblte_pdcp_unpack_control_pdu(pdu, &contents);
 
             // FIXME: Verify SN
@@ -304,12 +286,13 @@ void LTE_fdd_enb_pdcp::handle_pdu_ready(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT *p
             // Signal RRC
             rrc_pdu_ready.user = pdu_ready->user;
             rrc_pdu_ready.rb   = pdu_ready->rb;
-            LTE_fdd_enb_msgq::send(pdcp_rrc_mq,
-                                   LTE_FDD_ENB_MESSAGE_TYPE_RRC_PDU_READY,
-                                   LTE_FDD_ENB_DEST_LAYER_RRC,
-                                   (LTE_FDD_ENB_MESSAGE_UNION *)&rrc_pdu_ready,
-                                   sizeof(LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT));
+            worker_mgr->send(rrc_pdu_ready.user,
+                             LTE_FDD_ENB_MESSAGE_TYPE_RRC_PDU_READY,
+                             LTE_FDD_ENB_DEST_LAYER_RRC,
+                             (LTE_FDD_ENB_MESSAGE_UNION *)&rrc_pdu_ready,
+                             sizeof(LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT));
         }else if(LTE_FDD_ENB_RB_SRB2 == pdu_ready->rb->get_rb_id()){
+            decipher_pdu(pdu_ready->rb, pdu, 5);
             liblte_pdcp_unpack_control_pdu(pdu, &contents);
 
             // FIXME: Verify SN
@@ -320,27 +303,75 @@ void LTE_fdd_enb_pdcp::handle_pdu_ready(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT *p
             // Signal RRC
             rrc_pdu_ready.user = pdu_ready->user;
             rrc_pdu_ready.rb   = pdu_ready->rb;
-            LTE_fdd_enb_msgq::send(pdcp_rrc_mq,
-                                   LTE_FDD_ENB_MESSAGE_TYPE_RRC_PDU_READY,
-                                   LTE_FDD_ENB_DEST_LAYER_RRC,
-                                   (LTE_FDD_ENB_MESSAGE_UNION *)&rrc_pdu_ready,
-                                   sizeof(LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT));
+            worker_mgr->send(rrc_pdu_ready.user,
+                             LTE_FDD_ENB_MESSAGE_TYPE_RRC_PDU_READY,
+                             LTE_FDD_ENB_DEST_LAYER_RRC,
+                             (LTE_FDD_ENB_MESSAGE_UNION *)&rrc_pdu_ready,
+                             sizeof(LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT));
+        }else if(LTE_FDD_ENB_RB_DRB1                    == pdu_ready->rb->get_rb_id() &&
+                 LIBLTE_PDCP_D_C_CONTROL_PDU            == ((pdu->msg[0] >> 7) & 0x01)){
+            // Control PDUs are not ciphered and do not use an SN
+            if(pdu_ready->rb->get_pdcp_rohc() &&
+               LIBLTE_SUCCESS == liblte_pdcp_unpack_rohc_feedback_pdu(pdu, &feedback_contents))
+            {
+                liblte_rohc_comp_handle_feedback(pdu_ready->rb->get_pdcp_rohc_comp(), &feedback_contents.feedback);
+            }else{
+                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                          LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                                          __FILE__,
+                                          __LINE__,
+                                          pdu,
+                                          "Received unsupported control PDU for RNTI=%u and RB=%s",
+                                          pdu_ready->user->get_c_rnti(),
+                                          LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
+            }
         }else if(LTE_FDD_ENB_RB_DRB1 == pdu_ready->rb->get_rb_id()){
+            decipher_pdu(pdu_ready->rb, pdu, 12);
             liblte_pdcp_unpack_data_pdu_with_long_sn(pdu, &data_contents);
 
             // FIXME: Verify SN
 
-            // Queue the SDU for GW
-            pdu_ready->rb->queue_gw_data_msg(&data_contents.data);
-
-            // Signal GW
-            gw_data_ready.user = pdu_ready->user;
-            gw_data_ready.rb   = pdu_ready->rb;
-            LTE_fdd_enb_msgq::send(pdcp_gw_mq,
-                                   LTE_FDD_ENB_MESSAGE_TYPE_GW_DATA_READY,
-                                   LTE_FDD_ENB_DEST_LAYER_GW,
-                                   (LTE_FDD_ENB_MESSAGE_UNION *)&gw_data_ready,
-                                   sizeof(LTE_FDD_ENB_GW_DATA_READY_MSG_STRUCT));
+            ip_pkt = &data_contents.data;
+            if(pdu_ready->rb->get_pdcp_rohc())
+            {
+                // Packets that fail decompression are dropped, the
+                // feedback asks the UE to repair the context
+                ip_pkt = &rohc_pkt;
+                if(LIBLTE_SUCCESS != liblte_rohc_decompress(pdu_ready->rb->get_pdcp_rohc_decomp(),
+                                                            &data_contents.data,
+                                                            &rohc_pkt,
+                                                            &feedback))
+                {
+                    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                              LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                                              __FILE__,
+                                              __LINE__,
+                                              &data_contents.data,
+                                              "ROHC decompression failed for RNTI=%u and RB=%s",
+                                              pdu_ready->user->get_c_rnti(),
+                                              LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
+                    ip_pkt = NULL;
+                }
+                if(0 != feedback.N_bytes)
+                {
+                    send_rohc_feedback(pdu_ready->user, pdu_ready->rb, &feedback);
+                }
+            }
+
+            if(NULL != ip_pkt)
+            {
+                // Queue the SDU for GW
+                pdu_ready->rb->queue_gw_data_msg(ip_pkt);
+
+                // Signal GW
+                gw_data_ready.user = pdu_ready->user;
+                gw_data_ready.rb   = pdu_ready->rb;
+                LTE_fdd_enb_msgq::send(pdcp_gw_mq,
+                                       LTE_FDD_ENB_MESSAGE_TYPE_GW_DATA_READY,
+                                       LTE_FDD_ENB_DEST_LAYER_GW,
+                                       (LTE_FDD_ENB_MESSAGE_UNION *)&gw_data_ready,
+                                       sizeof(LTE_FDD_ENB_GW_DATA_READY_MSG_STRUCT));
+            }
         }else{
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                       LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
@@ -416,11 +447,11 @@ void LTE_fdd_enb_pdcp::handle_sdu_ready(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT *s
             // Signal RLC
             rlc_sdu_ready.user = sdu_ready->user;
             rlc_sdu_ready.rb   = sdu_ready->rb;
-            LTE_fdd_enb_msgq::send(pdcp_rlc_mq,
-                                   LTE_FDD_ENB_MESSAGE_TYPE_RLC_SDU_READY,
-                                   LTE_FDD_ENB_DEST_LAYER_RLC,
-                                   (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_sdu_ready,
-                                   sizeof(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT));
+            worker_mgr->send(rlc_sdu_ready.user,
+                             LTE_FDD_ENB_MESSAGE_TYPE_RLC_SDU_READY,
+                             LTE_FDD_ENB_DEST_LAYER_RLC,
+                             (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_sdu_ready,
+                             sizeof(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT));
 
             // Delete the SDU
             sdu_ready->rb->delete_next_pdcp_sdu();
@@ -432,9 +463,7 @@ void LTE_fdd_enb_pdcp::handle_sdu_ready(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT *s
             {
                 liblte_pdcp_pack_control_pdu(&contents,
                                              sdu,
-                                             sdu_ready->user->get_auth_vec()->k_rrc_int,
-                                             LIBLTE_SECURITY_DIRECTION_DOWNLINK,
-                                             sdu_ready->rb->get_rb_id()-1,
+                                             sdu_ready->rb->get_pdcp_integrity_ctx(LIBLTE_SECURITY_DIRECTION_DOWNLINK),
                                              &pdu);
             }else{
                 liblte_pdcp_pack_control_pdu(&contents,
@@ -442,6 +471,13 @@ void LTE_fdd_enb_pdcp::handle_sdu_ready(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT *s
                                              &pdu);
             }
 
+            // Cipher everything after the header, including MAC-I
+            liblte_security_cipher(sdu_ready->rb->get_pdcp_cipher_ctx(LIBLTE_SECURITY_DIRECTION_DOWNLINK),
+                                   contents.count,
+                                   &pdu.msg[1],
+                                   (pdu.N_bytes-1)*8,
+                                   &pdu.msg[1]);
+
             // Increment the SN
             sdu_ready->rb->set_pdcp_tx_count(contents.count + 1);
 
@@ -460,11 +496,11 @@ void LTE_fdd_enb_pdcp::handle_sdu_ready(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT *s
             // Signal RLC
             rlc_sdu_ready.user = sdu_ready->user;
             rlc_sdu_ready.rb   = sdu_ready->rb;
-            LTE_fdd_enb_msgq::send(pdcp_rlc_mq,
-                                   LTE_FDD_ENB_MESSAGE_TYPE_RLC_SDU_READY,
-                                   LTE_FDD_ENB_DEST_LAYER_RLC,
-                                   (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_sdu_ready,
-                                   sizeof(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT));
+            worker_mgr->send(rlc_sdu_ready.user,
+                             LTE_FDD_ENB_MESSAGE_TYPE_RLC_SDU_READY,
+                             LTE_FDD_ENB_DEST_LAYER_RLC,
+                             (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_sdu_ready,
+                             sizeof(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT));
 
             // Delete the SDU
             sdu_ready->rb->delete_next_pdcp_sdu();
@@ -497,55 +533,88 @@ void LTE_fdd_enb_pdcp::handle_data_sdu_ready(LTE_FDD_ENB_PDCP_DATA_SDU_READY_MSG
     LTE_fdd_enb_interface                    *interface = LTE_fdd_enb_interface::get_instance();
     LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT      rlc_sdu_ready;
     LIBLTE_PDCP_DATA_PDU_WITH_LONG_SN_STRUCT  contents;
-    LIBLTE_BYTE_MSG_STRUCT                    pdu;
+    LIBLTE_SECURITY_CIPHER_PDU_STRUCT         cipher_pdu[LTE_FDD_ENB_PDCP_CIPHER_BATCH_SIZE];
+    LIBLTE_BYTE_MSG_STRUCT                    data_pdu[LTE_FDD_ENB_PDCP_CIPHER_BATCH_SIZE];
+    LIBLTE_BYTE_MSG_STRUCT                    rohc_pkt;
     LIBLTE_BYTE_MSG_STRUCT                   *sdu;
+    LIBLTE_BYTE_MSG_STRUCT                   *data;
+    uint32                                    N_pdus = 0;
+    uint32                                    i;
 
+    // SDUs queued behind this one are handled in the same batch, so a
+    // signal can find its SDU already sent
     if(LTE_FDD_ENB_ERROR_NONE == data_sdu_ready->rb->get_next_pdcp_data_sdu(&sdu))
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                  __FILE__,
-                                  __LINE__,
-                                  sdu,
-                                  "Received data SDU from GW for RNTI=%u and RB=%s",
-                                  data_sdu_ready->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()]);
-
         if(data_sdu_ready->rb->get_rb_id()       >= LTE_FDD_ENB_RB_DRB1 &&
            data_sdu_ready->rb->get_pdcp_config() == LTE_FDD_ENB_PDCP_CONFIG_LONG_SN)
         {
-            // Pack the data PDU
-            contents.count = data_sdu_ready->rb->get_pdcp_tx_count();
-            liblte_pdcp_pack_data_pdu_with_long_sn(&contents,
-                                                   sdu,
-                                                   &pdu);
+            do
+            {
+                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                          LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                                          __FILE__,
+                                          __LINE__,
+                                          sdu,
+                                          "Received data SDU from GW for RNTI=%u and RB=%s",
+                                          data_sdu_ready->user->get_c_rnti(),
+                                          LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()]);
+
+                // Compress the headers
+                data = sdu;
+                if(data_sdu_ready->rb->get_pdcp_rohc() &&
+                   LIBLTE_SUCCESS == liblte_rohc_compress(data_sdu_ready->rb->get_pdcp_rohc_comp(), sdu, &rohc_pkt))
+                {
+                    data = &rohc_pkt;
+                }
 
-            // Increment the SN
-            data_sdu_ready->rb->set_pdcp_tx_count(contents.count + 1);
+                // Pack the data PDU
+                contents.count = data_sdu_ready->rb->get_pdcp_tx_count();
+                liblte_pdcp_pack_data_pdu_with_long_sn(&contents,
+                                                       data,
+                                                       &data_pdu[N_pdus]);
 
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                      __FILE__,
-                                      __LINE__,
-                                      &pdu,
-                                      "Sending PDU for RNTI=%u and RB=%s",
-                                      data_sdu_ready->user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()]);
+                // Increment the SN
+                data_sdu_ready->rb->set_pdcp_tx_count(contents.count + 1);
 
-            // Queue the PDU for RLC
-            data_sdu_ready->rb->queue_rlc_sdu(&pdu);
+                // Everything after the header is ciphered
+                cipher_pdu[N_pdus].msg    = &data_pdu[N_pdus].msg[2];
+                cipher_pdu[N_pdus].N_bits = (data_pdu[N_pdus].N_bytes-2)*8;
+                cipher_pdu[N_pdus].count  = contents.count;
+                N_pdus++;
 
-            // Signal RLC
-            rlc_sdu_ready.user = data_sdu_ready->user;
-            rlc_sdu_ready.rb   = data_sdu_ready->rb;
-            LTE_fdd_enb_msgq::send(pdcp_rlc_mq,
-                                   LTE_FDD_ENB_MESSAGE_TYPE_RLC_SDU_READY,
-                                   LTE_FDD_ENB_DEST_LAYER_RLC,
-                                   (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_sdu_ready,
-                                   sizeof(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT));
+                // Delete the SDU
+                data_sdu_ready->rb->delete_next_pdcp_data_sdu();
+            }while(N_pdus < LTE_FDD_ENB_PDCP_CIPHER_BATCH_SIZE &&
+                   LTE_FDD_ENB_ERROR_NONE == data_sdu_ready->rb->get_next_pdcp_data_sdu(&sdu));
 
-            // Delete the SDU
-            data_sdu_ready->rb->delete_next_pdcp_data_sdu();
+            // Cipher the batch
+            liblte_security_cipher_batch(data_sdu_ready->rb->get_pdcp_cipher_ctx(LIBLTE_SECURITY_DIRECTION_DOWNLINK),
+                                         cipher_pdu,
+                                         N_pdus);
+
+            for(i=0; i<N_pdus; i++)
+            {
+                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                          LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                                          __FILE__,
+                                          __LINE__,
+                                          &data_pdu[i],
+                                          "Sending PDU for RNTI=%u and RB=%s",
+                                          data_sdu_ready->user->get_c_rnti(),
+                                          LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()]);
+
+                // Queue the PDU for RLC
+                data_sdu_ready->rb->queue_rlc_sdu(&data_pdu[i]);
+
+                // Signal RLC
+                rlc_sdu_ready.user = data_sdu_ready->user;
+                rlc_sdu_ready.rb   = data_sdu_ready->rb;
+                worker_mgr->send(rlc_sdu_ready.user,
+                                 LTE_FDD_ENB_MESSAGE_TYPE_RLC_SDU_READY,
+                                 LTE_FDD_ENB_DEST_LAYER_RLC,
+                                 (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_sdu_ready,
+                                 sizeof(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT));
+            }
         }else{
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                       LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
@@ -555,13 +624,77 @@ void LTE_fdd_enb_pdcp::handle_data_sdu_ready(LTE_FDD_ENB_PDCP_DATA_SDU_READY_MSG
                                       LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()],
                                       data_sdu_ready->user->get_c_rnti());
         }
-    }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received data SDU ready from GW with no data, RNTI=%u, RB=%s",
-                                  data_sdu_ready->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()]);
     }
 }
+
+/*****************/
+/*    Helpers    */
+/*****************/
+void LTE_fdd_enb_pdcp::decipher_pdu(LTE_fdd_enb_rb         *rb,
+                                    LIBLTE_BYTE_MSG_STRUCT *pdu,
+                                    uint32                  N_sn_bits)
+{
+    uint32 N_hdr_bytes = (N_sn_bits + 7) / 8;
+    uint32 sn_mask     = (1 << N_sn_bits) - 1;
+    uint32 next_count  = rb->get_pdcp_rx_count();
+    uint32 sn          = 0;
+    uint32 count;
+    uint32 i;
+
+    if(pdu->N_bytes > N_hdr_bytes)
+    {
+        for(i=0; i<N_hdr_bytes; i++)
+        {
+            sn = (sn << 8) | pdu->msg[i];
+        }
+        sn &= sn_mask;
+
+        // Increment the HFN when the SN wraps
+        // 36.323 v10.1.0 Section 5.1.2.1
+        count = (next_count & ~sn_mask) | sn;
+        if(sn < (next_count & sn_mask))
+        {
+            count += sn_mask + 1;
+        }
+        rb->set_pdcp_rx_count(count + 1);
+
+        liblte_security_cipher(rb->get_pdcp_cipher_ctx(LIBLTE_SECURITY_DIRECTION_UPLINK),
+                               count,
+                               &pdu->msg[N_hdr_bytes],
+                               (pdu->N_bytes-N_hdr_bytes)*8,
+                               &pdu->msg[N_hdr_bytes]);
+    }
+}
+void LTE_fdd_enb_pdcp::send_rohc_feedback(LTE_fdd_enb_user       *user,
+                                          LTE_fdd_enb_rb         *rb,
+                                          LIBLTE_BYTE_MSG_STRUCT *feedback)
+{
+    LTE_fdd_enb_interface                *interface = LTE_fdd_enb_interface::get_instance();
+    LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT  rlc_sdu_ready;
+    LIBLTE_PDCP_ROHC_FEEDBACK_PDU_STRUCT  contents;
+    LIBLTE_BYTE_MSG_STRUCT                pdu;
+
+    // Interspersed feedback is sent as a control PDU, which is not ciphered
+    liblte_pdcp_pack_rohc_feedback_pdu(&contents, feedback, &pdu);
+
+    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                              __FILE__,
+                              __LINE__,
+                              &pdu,
+                              "Sending ROHC feedback for RNTI=%u and RB=%s",
+                              user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+
+    // Queue the PDU for RLC
+    rb->queue_rlc_sdu(&pdu);
+
+    // Signal RLC
+    rlc_sdu_ready.user = user;
+    rlc_sdu_ready.rb   = rb;
+    worker_mgr->send(rlc_sdu_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_RLC_SDU_READY,
+                     LTE_FDD_ENB_DEST_LAYER_RLC,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_sdu_ready,
+                     sizeof(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT));
+}
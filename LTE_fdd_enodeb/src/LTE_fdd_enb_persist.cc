@@ -0,0 +1,194 @@
+#line 2 "LTE_fdd_enb_persist.cc" // Make __FILE__ omit the path
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_persist.cc
+
+    Description: Contains all the implementations for the LTE FDD eNodeB
+                 write-behind file persistence.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_persist.h"
+#include <unistd.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+/******************/
+/*    Callback    */
+/******************/
+LTE_fdd_enb_persist_cb::LTE_fdd_enb_persist_cb()
+{
+}
+LTE_fdd_enb_persist_cb::LTE_fdd_enb_persist_cb(FuncType f, void* o)
+{
+    func = f;
+    obj  = o;
+}
+bool LTE_fdd_enb_persist_cb::operator()(FILE *file)
+{
+    return (*func)(obj, file);
+}
+
+/********************************/
+/*    Constructor/Destructor    */
+/********************************/
+LTE_fdd_enb_persist::LTE_fdd_enb_persist(std::string            _file_name,
+                                         uint32                 _delay_m_seconds,
+                                         LTE_fdd_enb_persist_cb _cb)
+{
+    cb              = _cb;
+    file_name       = _file_name;
+    tmp_file_name   = _file_name + ".tmp";
+    delay_m_seconds = _delay_m_seconds;
+    dirty           = false;
+    not_done        = true;
+
+    pthread_create(&thread, NULL, &write_thread, this);
+}
+LTE_fdd_enb_persist::~LTE_fdd_enb_persist()
+{
+    dirty_mutex.lock();
+    not_done = false;
+    dirty_cond.notify_one();
+    dirty_mutex.unlock();
+    pthread_join(thread, NULL);
+
+    // Don't lose changes made inside the last window
+    flush();
+}
+
+/****************************/
+/*    External Interface    */
+/****************************/
+void LTE_fdd_enb_persist::mark_dirty(void)
+{
+    boost::mutex::scoped_lock lock(dirty_mutex);
+
+    if(!dirty)
+    {
+        dirty = true;
+        dirty_cond.notify_one();
+    }
+}
+void LTE_fdd_enb_persist::flush(void)
+{
+    boost::mutex::scoped_lock lock(write_mutex);
+    bool                      write;
+
+    // Clear dirty before writing, so changes made during the write are
+    // picked up by the next one
+    dirty_mutex.lock();
+    write = dirty;
+    dirty = false;
+    dirty_mutex.unlock();
+
+    if(write)
+    {
+        write_file();
+    }
+}
+void LTE_fdd_enb_persist::remove_file(void)
+{
+    boost::mutex::scoped_lock lock(write_mutex);
+
+    dirty_mutex.lock();
+    dirty = false;
+    dirty_mutex.unlock();
+
+    remove(file_name.c_str());
+}
+
+/****************/
+/*    Writer    */
+/****************/
+void* LTE_fdd_enb_persist::write_thread(void *inputs)
+{
+    LTE_fdd_enb_persist       *persist = (LTE_fdd_enb_persist *)inputs;
+    boost::mutex::scoped_lock  lock(persist->dirty_mutex);
+
+    while(persist->not_done)
+    {
+        if(persist->dirty)
+        {
+            // Let a burst of changes pile up behind a single write
+            lock.unlock();
+            usleep(persist->delay_m_seconds*1000);
+            persist->flush();
+            lock.lock();
+        }else{
+            persist->dirty_cond.wait(lock);
+        }
+    }
+
+    return(NULL);
+}
+void LTE_fdd_enb_persist::write_file(void)
+{
+    FILE *file = NULL;
+    bool  ok;
+
+    file = fopen(tmp_file_name.c_str(), "w");
+
+    if(NULL != file)
+    {
+        ok = cb(file);
+        if(0 != fflush(file) ||
+           0 != fsync(fileno(file)))
+        {
+            ok = false;
+        }
+        if(0 != fclose(file))
+        {
+            ok = false;
+        }
+
+        if(ok)
+        {
+            rename(tmp_file_name.c_str(), file_name.c_str());
+        }else{
+            remove(tmp_file_name.c_str());
+        }
+    }
+}
@@ -112,20 +112,18 @@ LTE_fdd_enb_phy::~LTE_fdd_enb_phy()
 /********************/
 void LTE_fdd_enb_phy::start(LTE_fdd_enb_interface *iface)
 {
-    LTE_fdd_enb_radio   *radio = LTE_fdd_enb_radio::get_instance();
-    LTE_fdd_enb_msgq_cb  cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_phy, &LTE_fdd_enb_phy::handle_mac_msg>, this);
-    LIBLTE_PHY_FS_ENUM   fs;
-    uint32               i;
-    uint32               j;
-    uint32               k;
-    uint32               samp_rate;
-    uint8                prach_cnfg_idx;
+    LTE_fdd_enb_radio       *radio = LTE_fdd_enb_radio::get_instance();
+    LTE_fdd_enb_msgq_cb      cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_phy, &LTE_fdd_enb_phy::handle_mac_msg>, this);
+    LTE_fdd_enb_cnfg_reader  cnfg;
+    LIBLTE_PHY_FS_ENUM       fs;
+    uint32                   i;
+    uint32                   j;
+    uint32                   k;
+    uint32                   samp_rate;
+    uint8                    prach_cnfg_idx;
 
     if(!started)
     {
-        // Get the latest sys info
-        update_sys_info();
-
         // Initialize phy
         samp_rate = radio->get_sample_rate();
         if(30720000 == samp_rate)
@@ -149,22 +147,25 @@ void LTE_fdd_enb_phy::start(LTE_fdd_enb_interface *iface)
         }
         liblte_phy_init(&phy_struct,
                         fs,
-                        sys_info.N_id_cell,
-                        sys_info.N_ant,
-                        sys_info.N_rb_dl,
-                        sys_info.N_sc_rb_dl,
-                        liblte_rrc_phich_resource_num[sys_info.mib.phich_config.res]);
+                        cnfg.sys_info->N_id_cell,
+                        cnfg.sys_info->N_ant,
+                        cnfg.sys_info->N_rb_dl,
+                        cnfg.sys_info->N_sc_rb_dl,
+                        liblte_rrc_phich_resource_num[cnfg.sys_info->mib.phich_config.res]);
         liblte_phy_ul_init(phy_struct,
-                           sys_info.N_id_cell,
-                           sys_info.sib2.rr_config_common_sib.prach_cnfg.root_sequence_index,
-                           sys_info.sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_config_index>>4,
-                           sys_info.sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.zero_correlation_zone_config,
-                           sys_info.sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.high_speed_flag,
-                           sys_info.sib2.rr_config_common_sib.pusch_cnfg.ul_rs.group_assignment_pusch,
-                           sys_info.sib2.rr_config_common_sib.pusch_cnfg.ul_rs.group_hopping_enabled,
-                           sys_info.sib2.rr_config_common_sib.pusch_cnfg.ul_rs.sequence_hopping_enabled,
-                           sys_info.sib2.rr_config_common_sib.pusch_cnfg.ul_rs.cyclic_shift,
-                           0);
+                           cnfg.sys_info->N_id_cell,
+                           cnfg.sys_info->sib2.rr_config_common_sib.prach_cnfg.root_sequence_index,
+                           cnfg.sys_info->sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_config_index>>4,
+                           cnfg.sys_info->sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.zero_correlation_zone_config,
+                           cnfg.sys_info->sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.high_speed_flag,
+                           cnfg.sys_info->sib2.rr_config_common_sib.pusch_cnfg.ul_rs.group_assignment_pusch,
+                           cnfg.sys_info->sib2.rr_config_common_sib.pusch_cnfg.ul_rs.group_hopping_enabled,
+                           cnfg.sys_info->sib2.rr_config_common_sib.pusch_cnfg.ul_rs.sequence_hopping_enabled,
+                           cnfg.sys_info->sib2.rr_config_common_sib.pusch_cnfg.ul_rs.cyclic_shift,
+                           0,
+                           liblte_rrc_delta_pucch_shift_num[cnfg.sys_info->sib2.rr_config_common_sib.pucch_cnfg.delta_pucch_shift],
+                           cnfg.sys_info->sib2.rr_config_common_sib.pucch_cnfg.n_rb_cqi,
+                           cnfg.sys_info->sib2.rr_config_common_sib.pucch_cnfg.n_cs_an);
 
         // Downlink
         for(i=0; i<10; i++)
@@ -174,6 +175,8 @@ void LTE_fdd_enb_phy::start(LTE_fdd_enb_interface *iface)
             dl_schedule[i].ul_allocations.N_alloc = 0;
             ul_schedule[i].current_tti            = i;
             ul_schedule[i].decodes.N_alloc        = 0;
+            ul_schedule[i].N_pucch                = 0;
+            N_dl_ack[i]                           = 0;
         }
         pcfich.cfi = 2; // FIXME: Make this dynamic every subfr
         for(i=0; i<10; i++)
@@ -192,10 +195,17 @@ void LTE_fdd_enb_phy::start(LTE_fdd_enb_interface *iface)
         dl_current_tti       = 0;
         last_rts_current_tti = 0;
         late_subfr           = false;
+        sys_info_version     = cnfg.cnfg->sys_info_version;
+        mib_pcap_sent        = false;
+        sib1_pcap_sent       = false;
+        for(i=0; i<4; i++)
+        {
+            sib_pcap_sent[i] = false;
+        }
 
         // Uplink
         ul_current_tti = (LTE_FDD_ENB_CURRENT_TTI_MAX + 1) - 2;
-        prach_cnfg_idx = sys_info.sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_config_index;
+        prach_cnfg_idx = cnfg.sys_info->sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_config_index;
         if(prach_cnfg_idx ==  0 ||
            prach_cnfg_idx ==  1 ||
            prach_cnfg_idx ==  2 ||
@@ -307,23 +317,15 @@ void LTE_fdd_enb_phy::stop(void)
 /****************************/
 /*    External Interface    */
 /****************************/
-void LTE_fdd_enb_phy::update_sys_info(void)
-{
-    LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
-
-    sys_info_mutex.lock();
-    cnfg_db->get_sys_info(sys_info);
-    sys_info_mutex.unlock();
-}
 uint32 LTE_fdd_enb_phy::get_n_cce(void)
 {
-    boost::mutex::scoped_lock lock(sys_info_mutex);
-    uint32                    N_cce;
+    LTE_fdd_enb_cnfg_reader cnfg;
+    uint32                  N_cce;
 
     liblte_phy_get_n_cce(phy_struct,
-                         liblte_rrc_phich_resource_num[sys_info.mib.phich_config.res],
+                         liblte_rrc_phich_resource_num[cnfg.sys_info->mib.phich_config.res],
                          pdcch.N_symbs,
-                         sys_info.N_ant,
+                         cnfg.sys_info->N_ant,
                          &N_cce);
 
     return(N_cce);
@@ -465,18 +467,32 @@ void LTE_fdd_enb_phy::handle_ul_schedule(LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_
 void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
 {
     LTE_fdd_enb_radio                    *radio = LTE_fdd_enb_radio::get_instance();
-    boost::mutex::scoped_lock             lock(sys_info_mutex);
+    LTE_fdd_enb_cnfg_reader               cnfg;
     LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT  rts;
+    LIBLTE_RRC_MIB_STRUCT                 mib;
     uint32                                p;
     uint32                                i;
     uint32                                j;
     uint32                                last_prb = 0;
+    uint32                                N_sib_alloc;
     uint32                                act_noutput_items;
     uint32                                sfn   = dl_current_tti/10;
     uint32                                subfn = dl_current_tti%10;
 
+    // Send the system information to pcap again whenever it changes
+    if(sys_info_version != cnfg.cnfg->sys_info_version)
+    {
+        sys_info_version = cnfg.cnfg->sys_info_version;
+        mib_pcap_sent    = false;
+        sib1_pcap_sent   = false;
+        for(i=0; i<4; i++)
+        {
+            sib_pcap_sent[i] = false;
+        }
+    }
+
     // Initialize the output to all zeros
-    for(p=0; p<sys_info.N_ant; p++)
+    for(p=0; p<cnfg.sys_info->N_ant; p++)
     {
         for(i=0; i<14; i++)
         {
@@ -495,44 +511,45 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
     {
         liblte_phy_map_pss(phy_struct,
                            &dl_subframe,
-                           sys_info.N_id_2,
-                           sys_info.N_ant);
+                           cnfg.sys_info->N_id_2,
+                           cnfg.sys_info->N_ant);
         liblte_phy_map_sss(phy_struct,
                            &dl_subframe,
-                           sys_info.N_id_1,
-                           sys_info.N_id_2,
-                           sys_info.N_ant);
+                           cnfg.sys_info->N_id_1,
+                           cnfg.sys_info->N_id_2,
+                           cnfg.sys_info->N_ant);
     }
 
     // Handle CRS
     liblte_phy_map_crs(phy_struct,
                        &dl_subframe,
-                       sys_info.N_id_cell,
-                       sys_info.N_ant);
+                       cnfg.sys_info->N_id_cell,
+                       cnfg.sys_info->N_ant);
 
     // Handle PBCH
     if(0 == dl_subframe.num)
     {
-        sys_info.mib.sfn_div_4 = sfn/4;
-        liblte_rrc_pack_bcch_bch_msg(&sys_info.mib,
+        memcpy(&mib, &cnfg.sys_info->mib, sizeof(LIBLTE_RRC_MIB_STRUCT));
+        mib.sfn_div_4 = sfn/4;
+        liblte_rrc_pack_bcch_bch_msg(&mib,
                                      &dl_rrc_msg);
-        if(!sys_info.mib_pcap_sent)
+        if(!mib_pcap_sent)
         {
             interface->send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
                                      0xFFFFFFFF,
                                      dl_current_tti,
                                      dl_rrc_msg.msg,
                                      dl_rrc_msg.N_bits);
-            if(!sys_info.continuous_sib_pcap)
+            if(!cnfg.sys_info->continuous_sib_pcap)
             {
-                sys_info.mib_pcap_sent = true;
+                mib_pcap_sent = true;
             }
         }
         liblte_phy_bch_channel_encode(phy_struct,
                                       dl_rrc_msg.msg,
                                       dl_rrc_msg.N_bits,
-                                      sys_info.N_id_cell,
-                                      sys_info.N_ant,
+                                      cnfg.sys_info->N_id_cell,
+                                      cnfg.sys_info->N_ant,
                                       &dl_subframe,
                                       sfn);
     }
@@ -543,22 +560,22 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
        0 == (sfn % 2))
     {
         // SIB1
-        if(!sys_info.sib1_pcap_sent)
+        if(!sib1_pcap_sent)
         {
             interface->send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
                                      LIBLTE_MAC_SI_RNTI,
                                      dl_current_tti,
-                                     sys_info.sib1_alloc.msg.msg,
-                                     sys_info.sib1_alloc.msg.N_bits);
-            if(!sys_info.continuous_sib_pcap)
+                                     cnfg.sys_info->sib1_alloc.msg.msg,
+                                     cnfg.sys_info->sib1_alloc.msg.N_bits);
+            if(!cnfg.sys_info->continuous_sib_pcap)
             {
-                sys_info.sib1_pcap_sent = true;
+                sib1_pcap_sent = true;
             }
         }
-        memcpy(&pdcch.alloc[pdcch.N_alloc], &sys_info.sib1_alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+        memcpy(&pdcch.alloc[pdcch.N_alloc], &cnfg.sys_info->sib1_alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
         liblte_phy_get_tbs_mcs_and_n_prb_for_dl(pdcch.alloc[pdcch.N_alloc].msg.N_bits,
                                                 dl_subframe.num,
-                                                sys_info.N_rb_dl,
+                                                cnfg.sys_info->N_rb_dl,
                                                 pdcch.alloc[pdcch.N_alloc].rnti,
                                                 &pdcch.alloc[pdcch.N_alloc].tbs,
                                                 &pdcch.alloc[pdcch.N_alloc].mcs,
@@ -566,28 +583,28 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
         pdcch.alloc[pdcch.N_alloc].rv_idx = (uint32)ceilf(1.5 * ((sfn / 2) % 4)) % 4; //36.321 section 5.3.1
         pdcch.N_alloc++;
     }
-    if((0 * sys_info.si_win_len)%10   <= dl_subframe.num &&
-       (1 * sys_info.si_win_len)%10   >  dl_subframe.num &&
-       ((0 * sys_info.si_win_len)/10) == (sfn % sys_info.si_periodicity_T))
+    if((0 * cnfg.sys_info->si_win_len)%10   <= dl_subframe.num &&
+       (1 * cnfg.sys_info->si_win_len)%10   >  dl_subframe.num &&
+       ((0 * cnfg.sys_info->si_win_len)/10) == (sfn % cnfg.sys_info->si_periodicity_T))
     {
         // SIs in 1st scheduling info list entry
-        if(!sys_info.sib_pcap_sent[0])
+        if(!sib_pcap_sent[0])
         {
             interface->send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
                                      LIBLTE_MAC_SI_RNTI,
                                      dl_current_tti,
-                                     sys_info.sib_alloc[0].msg.msg,
-                                     sys_info.sib_alloc[0].msg.N_bits);
-            if(!sys_info.continuous_sib_pcap)
+                                     cnfg.sys_info->sib_alloc[0].msg.msg,
+                                     cnfg.sys_info->sib_alloc[0].msg.N_bits);
+            if(!cnfg.sys_info->continuous_sib_pcap)
             {
-                sys_info.sib_pcap_sent[0] = true;
+                sib_pcap_sent[0] = true;
             }
         }
-        memcpy(&pdcch.alloc[pdcch.N_alloc], &sys_info.sib_alloc[0], sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+        memcpy(&pdcch.alloc[pdcch.N_alloc], &cnfg.sys_info->sib_alloc[0], sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
         // FIXME: This was a hack to allow SIB2 decoding with 1.4MHz BW due to overlap with MIB
         if(LIBLTE_SUCCESS == liblte_phy_get_tbs_mcs_and_n_prb_for_dl(pdcch.alloc[pdcch.N_alloc].msg.N_bits,
                                                                      dl_subframe.num,
-                                                                     sys_info.N_rb_dl,
+                                                                     cnfg.sys_info->N_rb_dl,
                                                                      pdcch.alloc[pdcch.N_alloc].rnti,
                                                                      &pdcch.alloc[pdcch.N_alloc].tbs,
                                                                      &pdcch.alloc[pdcch.N_alloc].mcs,
@@ -596,28 +613,28 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
             pdcch.N_alloc++;
         }
     }
-    for(i=1; i<sys_info.sib1.N_sched_info; i++)
+    for(i=1; i<cnfg.sys_info->sib1.N_sched_info; i++)
     {
-        if(0                              != sys_info.sib_alloc[i].msg.N_bits &&
-           (i * sys_info.si_win_len)%10   == dl_subframe.num                  &&
-           ((i * sys_info.si_win_len)/10) == (sfn % sys_info.si_periodicity_T))
+        if(0                              != cnfg.sys_info->sib_alloc[i].msg.N_bits &&
+           (i * cnfg.sys_info->si_win_len)%10   == dl_subframe.num                  &&
+           ((i * cnfg.sys_info->si_win_len)/10) == (sfn % cnfg.sys_info->si_periodicity_T))
         {
-            if(!sys_info.sib_pcap_sent[i])
+            if(!sib_pcap_sent[i])
             {
                 interface->send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
                                          LIBLTE_MAC_SI_RNTI,
                                          dl_current_tti,
-                                         sys_info.sib_alloc[i].msg.msg,
-                                         sys_info.sib_alloc[i].msg.N_bits);
-                if(!sys_info.continuous_sib_pcap)
+                                         cnfg.sys_info->sib_alloc[i].msg.msg,
+                                         cnfg.sys_info->sib_alloc[i].msg.N_bits);
+                if(!cnfg.sys_info->continuous_sib_pcap)
                 {
-                    sys_info.sib_pcap_sent[i] = true;
+                    sib_pcap_sent[i] = true;
                 }
             }
-            memcpy(&pdcch.alloc[pdcch.N_alloc], &sys_info.sib_alloc[i], sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+            memcpy(&pdcch.alloc[pdcch.N_alloc], &cnfg.sys_info->sib_alloc[i], sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
             liblte_phy_get_tbs_mcs_and_n_prb_for_dl(pdcch.alloc[pdcch.N_alloc].msg.N_bits,
                                                     dl_subframe.num,
-                                                    sys_info.N_rb_dl,
+                                                    cnfg.sys_info->N_rb_dl,
                                                     pdcch.alloc[pdcch.N_alloc].rnti,
                                                     &pdcch.alloc[pdcch.N_alloc].tbs,
                                                     &pdcch.alloc[pdcch.N_alloc].mcs,
@@ -627,6 +644,7 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
     }
 
     // Handle user data
+    N_sib_alloc = pdcch.N_alloc;
     dl_sched_mutex.lock();
     if(dl_schedule[dl_current_tti%10].current_tti == dl_current_tti)
     {
@@ -651,8 +669,9 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
     }
     dl_sched_mutex.unlock();
 
-    // Handle PDCCH and PDSCH
-    for(i=0; i<pdcch.N_alloc; i++)
+    // Handle PDCCH and PDSCH, the MAC has already placed the user data
+    // around the low PRBs it left for the SIBs
+    for(i=0; i<N_sib_alloc; i++)
     {
         for(j=0; j<pdcch.alloc[i].N_prb; j++)
         {
@@ -667,22 +686,37 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
                                   __FILE__,
                                   __LINE__,
                                   "More PRBs allocated than are available");
+        N_dl_ack[subfn] = 0;
     }else{
         liblte_phy_pdcch_channel_encode(phy_struct,
                                         &pcfich,
                                         &phich[subfn],
                                         &pdcch,
-                                        sys_info.N_id_cell,
-                                        sys_info.N_ant,
-                                        liblte_rrc_phich_resource_num[sys_info.mib.phich_config.res],
-                                        sys_info.mib.phich_config.dur,
+                                        cnfg.sys_info->N_id_cell,
+                                        cnfg.sys_info->N_ant,
+                                        liblte_rrc_phich_resource_num[cnfg.sys_info->mib.phich_config.res],
+                                        cnfg.sys_info->mib.phich_config.dur,
                                         &dl_subframe);
+
+        // Save the first CCE of each C-RNTI DL allocation to find its HARQ-ACK on PUCCH
+        N_dl_ack[subfn] = 0;
+        for(i=0; i<pdcch.N_alloc; i++)
+        {
+            if(LIBLTE_PHY_CHAN_TYPE_DLSCH == pdcch.alloc[i].chan_type &&
+               LIBLTE_MAC_C_RNTI_START    <= pdcch.alloc[i].rnti      &&
+               LIBLTE_MAC_C_RNTI_END      >= pdcch.alloc[i].rnti)
+            {
+                dl_ack_rnti[subfn][N_dl_ack[subfn]]  = pdcch.alloc[i].rnti;
+                dl_ack_n_cce[subfn][N_dl_ack[subfn]] = pdcch.alloc[i].n_cce;
+                N_dl_ack[subfn]++;
+            }
+        }
         if(0 != pdcch.N_alloc)
         {
             liblte_phy_pdsch_channel_encode(phy_struct,
                                             &pdcch,
-                                            sys_info.N_id_cell,
-                                            sys_info.N_ant,
+                                            cnfg.sys_info->N_id_cell,
+                                            cnfg.sys_info->N_ant,
                                             &dl_subframe);
         }
         // Clear PHICH
@@ -695,7 +729,7 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
         }
     }
 
-    for(p=0; p<sys_info.N_ant; p++)
+    for(p=0; p<cnfg.sys_info->N_ant; p++)
     {
         liblte_phy_create_dl_subframe(phy_struct,
                                       &dl_subframe,
@@ -730,12 +764,13 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
 /****************/
 void LTE_fdd_enb_phy::process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf)
 {
-    uint32 N_skipped_subfrs = 0;
-    uint32 sfn;
-    uint32 i;
-    uint32 I_prb_ra;
-    uint32 n_group_phich;
-    uint32 n_seq_phich;
+    LTE_fdd_enb_cnfg_reader cnfg;
+    uint32                  N_skipped_subfrs = 0;
+    uint32                  sfn;
+    uint32                  i;
+    uint32                  I_prb_ra;
+    uint32                  n_group_phich;
+    uint32                  n_seq_phich;
 
     // Check the received current_tti
     if(rx_buf->current_tti != ul_current_tti)
@@ -766,7 +801,7 @@ void LTE_fdd_enb_phy::process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf)
                 liblte_phy_detect_prach(phy_struct,
                                         rx_buf->i_buf,
                                         rx_buf->q_buf,
-                                        sys_info.sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_freq_offset,
+                                        cnfg.sys_info->sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_freq_offset,
                                         &prach_decode.num_preambles,
                                         prach_decode.preamble,
                                         prach_decode.timing_adv);
@@ -780,18 +815,21 @@ void LTE_fdd_enb_phy::process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf)
         }
     }
 
-    // Handle PUCCH
-    // FIXME
-
-    // Handle PUSCH
+    // Handle PUCCH and PUSCH
     ul_sched_mutex.lock();
-    if(0 != ul_schedule[ul_subframe.num].decodes.N_alloc)
+    if(0 != ul_schedule[ul_subframe.num].decodes.N_alloc ||
+       0 != ul_schedule[ul_subframe.num].N_pucch)
     {
         if(LIBLTE_SUCCESS == liblte_phy_get_ul_subframe(phy_struct,
                                                         rx_buf->i_buf,
                                                         rx_buf->q_buf,
                                                         &ul_subframe))
         {
+            for(i=0; i<ul_schedule[ul_subframe.num].N_pucch; i++)
+            {
+                decode_pucch(&ul_schedule[ul_subframe.num].pucch[i]);
+            }
+
             for(i=0; i<ul_schedule[ul_subframe.num].decodes.N_alloc; i++)
             {
                 // Determine PHICH indecies
@@ -799,38 +837,149 @@ void LTE_fdd_enb_phy::process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf)
                 n_group_phich = I_prb_ra % phy_struct->N_group_phich;
                 n_seq_phich   = (I_prb_ra/phy_struct->N_group_phich) % (2*phy_struct->N_sf_phich);
 
-                // Attempt decode
-                if(LIBLTE_SUCCESS == liblte_phy_pusch_channel_decode(phy_struct,
-                                                                     &ul_subframe,
-                                                                     &ul_schedule[ul_subframe.num].decodes.alloc[i],
-                                                                     sys_info.N_id_cell,
-                                                                     1,
-                                                                     pusch_decode.msg.msg,
-                                                                     &pusch_decode.msg.N_bits))
+                // Attempt decode, combining with earlier transmissions of this HARQ process
+                pusch_decode.crc_pass = false;
+                if(LIBLTE_SUCCESS == liblte_phy_pusch_channel_decode_harq(phy_struct,
+                                                                          &ul_subframe,
+                                                                          &ul_schedule[ul_subframe.num].decodes.alloc[i],
+                                                                          cnfg.sys_info->N_id_cell,
+                                                                          1,
+                                                                          ul_schedule[ul_subframe.num].soft_buffer[i],
+                                                                          pusch_decode.msg.msg,
+                                                                          &pusch_decode.msg.N_bits))
                 {
-                    pusch_decode.current_tti = ul_current_tti;
-                    pusch_decode.rnti        = ul_schedule[ul_subframe.num].decodes.alloc[i].rnti;
-
-                    LTE_fdd_enb_msgq::send(phy_mac_mq,
-                                           LTE_FDD_ENB_MESSAGE_TYPE_PUSCH_DECODE,
-                                           LTE_FDD_ENB_DEST_LAYER_MAC,
-                                           (LTE_FDD_ENB_MESSAGE_UNION *)&pusch_decode,
-                                           sizeof(LTE_FDD_ENB_PUSCH_DECODE_MSG_STRUCT));
+                    pusch_decode.crc_pass = true;
 
                     // Add ACK to PHICH
                     phich[(ul_subframe.num + 4) % 10].present[n_group_phich][n_seq_phich] = true;
                     phich[(ul_subframe.num + 4) % 10].b[n_group_phich][n_seq_phich]       = 1;
                 }else{
+                    pusch_decode.msg.N_bits = 0;
+
                     // Add NACK to PHICH
                     phich[(ul_subframe.num + 4) % 10].present[n_group_phich][n_seq_phich] = true;
                     phich[(ul_subframe.num + 4) % 10].b[n_group_phich][n_seq_phich]       = 0;
                 }
+
+                // Report the result so MAC can drive the HARQ process
+                pusch_decode.current_tti = ul_current_tti;
+                pusch_decode.rnti        = ul_schedule[ul_subframe.num].decodes.alloc[i].rnti;
+                LTE_fdd_enb_msgq::send(phy_mac_mq,
+                                       LTE_FDD_ENB_MESSAGE_TYPE_PUSCH_DECODE,
+                                       LTE_FDD_ENB_DEST_LAYER_MAC,
+                                       (LTE_FDD_ENB_MESSAGE_UNION *)&pusch_decode,
+                                       sizeof(LTE_FDD_ENB_PUSCH_DECODE_MSG_STRUCT));
             }
         }
     }
     ul_schedule[ul_subframe.num].decodes.N_alloc = 0;
+    ul_schedule[ul_subframe.num].N_pucch         = 0;
     ul_sched_mutex.unlock();
 
     // Update counters
     ul_current_tti = (ul_current_tti + 1) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
 }
+void LTE_fdd_enb_phy::decode_pucch(LTE_FDD_ENB_PUCCH_SCHEDULE_STRUCT *pucch_sched)
+{
+    LTE_fdd_enb_cnfg_reader cnfg;
+    uint32                  dl_subfn = (ul_subframe.num + 6) % 10;
+    uint32                  n_cce    = 0;
+    uint32                  i;
+    bool                    dl_found = false;
+
+    pucch_decode.current_tti      = ul_current_tti;
+    pucch_decode.rnti             = pucch_sched->rnti;
+    pucch_decode.cqi              = 0;
+    pucch_decode.harq_ack_present = false;
+    pucch_decode.harq_ack         = false;
+    pucch_decode.sr_present       = false;
+    pucch_decode.cqi_present      = false;
+    pucch.rnti                    = pucch_sched->rnti;
+
+    if(pucch_sched->harq_ack)
+    {
+        for(i=0; i<N_dl_ack[dl_subfn]; i++)
+        {
+            if(pucch_sched->rnti == dl_ack_rnti[dl_subfn][i])
+            {
+                n_cce    = dl_ack_n_cce[dl_subfn][i];
+                dl_found = true;
+            }
+        }
+    }
+
+    if(dl_found)
+    {
+        // With a positive SR the HARQ-ACK is sent on the SR resource, 3GPP TS 36.213 v10.3.0 section 10.1
+        if(pucch_sched->sr)
+        {
+            pucch.format  = LIBLTE_PHY_PUCCH_FORMAT_1A;
+            pucch.n_pucch = pucch_sched->n_1_pucch_sr;
+            if(LIBLTE_SUCCESS == liblte_phy_pucch_channel_decode(phy_struct,
+                                                                 &ul_subframe,
+                                                                 &pucch,
+                                                                 cnfg.sys_info->N_id_cell))
+            {
+                pucch_decode.sr_present       = true;
+                pucch_decode.harq_ack_present = true;
+                pucch_decode.harq_ack         = (1 == pucch.bits[0]);
+            }
+        }
+        if(!pucch_decode.harq_ack_present)
+        {
+            // A missed detection is reported as a NACK (DTX)
+            pucch.format                  = LIBLTE_PHY_PUCCH_FORMAT_1A;
+            pucch.n_pucch                 = n_cce + cnfg.sys_info->sib2.rr_config_common_sib.pucch_cnfg.n1_pucch_an;
+            pucch_decode.harq_ack_present = true;
+            if(LIBLTE_SUCCESS == liblte_phy_pucch_channel_decode(phy_struct,
+                                                                 &ul_subframe,
+                                                                 &pucch,
+                                                                 cnfg.sys_info->N_id_cell))
+            {
+                pucch_decode.harq_ack = (1 == pucch.bits[0]);
+            }
+        }
+    }else if(pucch_sched->sr){
+        // Only a positive SR is transmitted, 3GPP TS 36.213 v10.3.0 section 10.1
+        pucch.format  = LIBLTE_PHY_PUCCH_FORMAT_1;
+        pucch.n_pucch = pucch_sched->n_1_pucch_sr;
+        if(LIBLTE_SUCCESS == liblte_phy_pucch_channel_decode(phy_struct,
+                                                             &ul_subframe,
+                                                             &pucch,
+                                                             cnfg.sys_info->N_id_cell))
+        {
+            pucch_decode.sr_present = true;
+        }
+    }
+    if(!dl_found                &&
+       !pucch_decode.sr_present &&
+       pucch_sched->cqi)
+    {
+        // Wideband CQI, 3GPP TS 36.212 v10.1.0 section 5.2.3.3.1
+        pucch.format  = LIBLTE_PHY_PUCCH_FORMAT_2;
+        pucch.n_pucch = pucch_sched->n_2_pucch;
+        pucch.N_bits  = 4;
+        if(LIBLTE_SUCCESS == liblte_phy_pucch_channel_decode(phy_struct,
+                                                             &ul_subframe,
+                                                             &pucch,
+                                                             cnfg.sys_info->N_id_cell))
+        {
+            pucch_decode.cqi_present = true;
+            for(i=0; i<4; i++)
+            {
+                pucch_decode.cqi = (pucch_decode.cqi << 1) | pucch.bits[i];
+            }
+        }
+    }
+
+    if(pucch_decode.harq_ack_present ||
+       pucch_decode.sr_present       ||
+       pucch_decode.cqi_present)
+    {
+        LTE_fdd_enb_msgq::send(phy_mac_mq,
+                               LTE_FDD_ENB_MESSAGE_TYPE_PUCCH_DECODE,
+                               LTE_FDD_ENB_DEST_LAYER_MAC,
+                               (LTE_FDD_ENB_MESSAGE_UNION *)&pucch_decode,
+                               sizeof(LTE_FDD_ENB_PUCCH_DECODE_MSG_STRUCT));
+    }
+}
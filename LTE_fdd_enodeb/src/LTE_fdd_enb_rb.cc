@@ -76,6 +76,8 @@
 LTE_fdd_enb_rb::LTE_fdd_enb_rb(LTE_FDD_ENB_RB_ENUM  _rb,
                                LTE_fdd_enb_user    *_user)
 {
+    uint32 i;
+
     rb   = _rb;
     user = _user;
 
@@ -123,25 +125,37 @@ LTE_fdd_enb_rb::LTE_fdd_enb_rb(LTE_FDD_ENB_RB_ENUM  _rb,
     // PDCP
     pdcp_rx_count = 0;
     pdcp_tx_count = 0;
+    set_pdcp_cipher(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_EEA0, NULL);
+    set_pdcp_rohc(false);
 
     // RLC
-    rlc_am_reception_buffer.clear();
-    rlc_am_transmission_buffer.clear();
-    rlc_um_reception_buffer.clear();
-    rlc_vrr                 = 0;
-    rlc_vrmr                = rlc_vrr + LIBLTE_RLC_AM_WINDOW_SIZE;
-    rlc_vrh                 = 0;
-    rlc_first_am_segment_sn = 0xFFFF;
-    rlc_last_am_segment_sn  = 0xFFFF;
-    rlc_vta                 = 0;
-    rlc_vtms                = rlc_vta + LIBLTE_RLC_AM_WINDOW_SIZE;
-    rlc_vts                 = 0;
-    rlc_vruh                = 0;
-    rlc_vrur                = 0;
-    rlc_um_window_size      = 512;
-    rlc_first_um_segment_sn = 0xFFFF;
-    rlc_last_um_segment_sn  = 0xFFFF;
-    rlc_vtus                = 0;
+    for(i=0; i<LTE_FDD_ENB_RLC_SN_MOD; i++)
+    {
+        rlc_rx_window[i].data = NULL;
+        rlc_tx_window[i]      = NULL;
+    }
+    memset(rlc_rx_map, 0, sizeof(rlc_rx_map));
+    rlc_rx_N_ahead         = 0;
+    rlc_tx_window_N_pdus   = 0;
+    rlc_tx_sdu_offset      = 0;
+    rlc_tx_sdu_queue_bytes = 0;
+    rlc_vrr                = 0;
+    rlc_vrmr               = rlc_vrr + LIBLTE_RLC_AM_WINDOW_SIZE;
+    rlc_vrh                = 0;
+    rlc_vta                = 0;
+    rlc_vtms               = rlc_vta + LIBLTE_RLC_AM_WINDOW_SIZE;
+    rlc_vts                = 0;
+    rlc_vruh               = 0;
+    rlc_um_window_size     = 512;
+    rlc_vtus               = 0;
+    rlc_rx_next_sn         = 0;
+    rlc_rx_next_seg        = 0;
+    rlc_rx_sdu_sn          = 0;
+    rlc_rx_sdu_seg         = 0;
+    rlc_rx_release_sn      = 0;
+    rlc_rx_sdu_started     = false;
+    rlc_tx_aqm             = false;
+    liblte_qos_codel_init(&rlc_tx_codel, LIBLTE_QOS_CODEL_TARGET_US, LIBLTE_QOS_CODEL_INTERVAL_US);
 
     // MAC
     mac_con_res_id = 0;
@@ -150,16 +164,34 @@ LTE_fdd_enb_rb::LTE_fdd_enb_rb(LTE_FDD_ENB_RB_ENUM  _rb,
     avail_qos[0] = (LTE_FDD_ENB_QOS_STRUCT){ 0,  0};
     avail_qos[1] = (LTE_FDD_ENB_QOS_STRUCT){20, 22};
     qos          = LTE_FDD_ENB_QOS_NONE;
+
+    // Signalling bearers have no QCI and are always served first
+    qci = 0;
+    liblte_qos_get_qci(LIBLTE_QOS_QCI_DEFAULT, &qci_char);
+    liblte_qos_token_bucket_init(&gbr_bucket, 0, LIBLTE_QOS_TOKEN_BUCKET_BURST_MS, 0);
+    liblte_qos_token_bucket_init(&mbr_bucket, 0, LIBLTE_QOS_TOKEN_BUCKET_BURST_MS, 0);
 }
 LTE_fdd_enb_rb::~LTE_fdd_enb_rb()
 {
     LTE_fdd_enb_timer_mgr *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
+    uint32                 i;
 
     timer_mgr->stop_timer(ul_sched_timer_id);
     if(LTE_FDD_ENB_INVALID_TIMER_ID != t_poll_retransmit_timer_id)
     {
         timer_mgr->stop_timer(t_poll_retransmit_timer_id);
     }
+
+    // RLC
+    for(i=0; i<LTE_FDD_ENB_RLC_SN_MOD; i++)
+    {
+        delete rlc_rx_window[i].data;
+        delete rlc_tx_window[i];
+    }
+    for(i=0; i<rlc_tx_pool.size(); i++)
+    {
+        delete rlc_tx_pool[i];
+    }
 }
 
 /******************/
@@ -191,15 +223,15 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_gw_data_msg(void)
 /*************/
 void LTE_fdd_enb_rb::queue_mme_nas_msg(LIBLTE_BYTE_MSG_STRUCT *nas_msg)
 {
-    queue_msg(nas_msg, &mme_nas_msg_queue_mutex, &mme_nas_msg_queue);
+    queue_msg(nas_msg, NULL, &mme_nas_msg_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_mme_nas_msg(LIBLTE_BYTE_MSG_STRUCT **nas_msg)
 {
-    return(get_next_msg(&mme_nas_msg_queue_mutex, &mme_nas_msg_queue, nas_msg));
+    return(get_next_msg(NULL, &mme_nas_msg_queue, nas_msg));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_mme_nas_msg(void)
 {
-    return(delete_next_msg(&mme_nas_msg_queue_mutex, &mme_nas_msg_queue));
+    return(delete_next_msg(NULL, &mme_nas_msg_queue));
 }
 void LTE_fdd_enb_rb::set_mme_procedure(LTE_FDD_ENB_MME_PROC_ENUM procedure)
 {
@@ -247,27 +279,27 @@ LTE_FDD_ENB_MME_STATE_ENUM LTE_fdd_enb_rb::get_mme_state(void)
 /*************/
 void LTE_fdd_enb_rb::queue_rrc_pdu(LIBLTE_BIT_MSG_STRUCT *pdu)
 {
-    queue_msg(pdu, &rrc_pdu_queue_mutex, &rrc_pdu_queue);
+    queue_msg(pdu, NULL, &rrc_pdu_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_rrc_pdu(LIBLTE_BIT_MSG_STRUCT **pdu)
 {
-    return(get_next_msg(&rrc_pdu_queue_mutex, &rrc_pdu_queue, pdu));
+    return(get_next_msg(NULL, &rrc_pdu_queue, pdu));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_rrc_pdu(void)
 {
-    return(delete_next_msg(&rrc_pdu_queue_mutex, &rrc_pdu_queue));
+    return(delete_next_msg(NULL, &rrc_pdu_queue));
 }
 void LTE_fdd_enb_rb::queue_rrc_nas_msg(LIBLTE_BYTE_MSG_STRUCT *nas_msg)
 {
-    queue_msg(nas_msg, &rrc_nas_msg_queue_mutex, &rrc_nas_msg_queue);
+    queue_msg(nas_msg, NULL, &rrc_nas_msg_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_rrc_nas_msg(LIBLTE_BYTE_MSG_STRUCT **nas_msg)
 {
-    return(get_next_msg(&rrc_nas_msg_queue_mutex, &rrc_nas_msg_queue, nas_msg));
+    return(get_next_msg(NULL, &rrc_nas_msg_queue, nas_msg));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_rrc_nas_msg(void)
 {
-    return(delete_next_msg(&rrc_nas_msg_queue_mutex, &rrc_nas_msg_queue));
+    return(delete_next_msg(NULL, &rrc_nas_msg_queue));
 }
 void LTE_fdd_enb_rb::set_rrc_procedure(LTE_FDD_ENB_RRC_PROC_ENUM procedure)
 {
@@ -321,27 +353,27 @@ void LTE_fdd_enb_rb::set_rrc_transaction_id(uint8 transaction_id)
 /**************/
 void LTE_fdd_enb_rb::queue_pdcp_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu)
 {
-    queue_msg(pdu, &pdcp_pdu_queue_mutex, &pdcp_pdu_queue);
+    queue_msg(pdu, NULL, &pdcp_pdu_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_pdcp_pdu(LIBLTE_BYTE_MSG_STRUCT **pdu)
 {
-    return(get_next_msg(&pdcp_pdu_queue_mutex, &pdcp_pdu_queue, pdu));
+    return(get_next_msg(NULL, &pdcp_pdu_queue, pdu));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_pdcp_pdu(void)
 {
-    return(delete_next_msg(&pdcp_pdu_queue_mutex, &pdcp_pdu_queue));
+    return(delete_next_msg(NULL, &pdcp_pdu_queue));
 }
 void LTE_fdd_enb_rb::queue_pdcp_sdu(LIBLTE_BIT_MSG_STRUCT *sdu)
 {
-    queue_msg(sdu, &pdcp_sdu_queue_mutex, &pdcp_sdu_queue);
+    queue_msg(sdu, NULL, &pdcp_sdu_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_pdcp_sdu(LIBLTE_BIT_MSG_STRUCT **sdu)
 {
-    return(get_next_msg(&pdcp_sdu_queue_mutex, &pdcp_sdu_queue, sdu));
+    return(get_next_msg(NULL, &pdcp_sdu_queue, sdu));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_pdcp_sdu(void)
 {
-    return(delete_next_msg(&pdcp_sdu_queue_mutex, &pdcp_sdu_queue));
+    return(delete_next_msg(NULL, &pdcp_sdu_queue));
 }
 void LTE_fdd_enb_rb::queue_pdcp_data_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu)
 {
@@ -379,6 +411,69 @@ void LTE_fdd_enb_rb::set_pdcp_tx_count(uint32 tx_count)
 {
     pdcp_tx_count = tx_count;
 }
+void LTE_fdd_enb_rb::set_pdcp_cipher(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM  alg,
+                                     uint8                                       *key_256)
+{
+    uint8 *key = NULL;
+
+    // The 128 bit key is the least significant half of the derived key
+    if(NULL != key_256)
+    {
+        key = &key_256[16];
+    }
+
+    // BEARER is the radio bearer identity minus one
+    liblte_security_cipher_init(&pdcp_ul_cipher, alg, key, rb-1, LIBLTE_SECURITY_DIRECTION_UPLINK);
+    liblte_security_cipher_init(&pdcp_dl_cipher, alg, key, rb-1, LIBLTE_SECURITY_DIRECTION_DOWNLINK);
+}
+LIBLTE_SECURITY_CIPHER_CTX_STRUCT* LTE_fdd_enb_rb::get_pdcp_cipher_ctx(uint8 direction)
+{
+    LIBLTE_SECURITY_CIPHER_CTX_STRUCT *ctx = &pdcp_dl_cipher;
+
+    if(LIBLTE_SECURITY_DIRECTION_UPLINK == direction)
+    {
+        ctx = &pdcp_ul_cipher;
+    }
+
+    return(ctx);
+}
+void LTE_fdd_enb_rb::set_pdcp_integrity(uint8 *key_256)
+{
+    // The 128 bit key is the least significant half of the derived key,
+    // BEARER is the radio bearer identity minus one
+    liblte_security_128_eia2_init(&pdcp_ul_integrity, &key_256[16], rb-1, LIBLTE_SECURITY_DIRECTION_UPLINK);
+    liblte_security_128_eia2_init(&pdcp_dl_integrity, &key_256[16], rb-1, LIBLTE_SECURITY_DIRECTION_DOWNLINK);
+}
+LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT* LTE_fdd_enb_rb::get_pdcp_integrity_ctx(uint8 direction)
+{
+    LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT *ctx = &pdcp_dl_integrity;
+
+    if(LIBLTE_SECURITY_DIRECTION_UPLINK == direction)
+    {
+        ctx = &pdcp_ul_integrity;
+    }
+
+    return(ctx);
+}
+void LTE_fdd_enb_rb::set_pdcp_rohc(bool enable)
+{
+    // Contexts start empty, the UE sends feedback to move to O-mode
+    pdcp_rohc = enable;
+    liblte_rohc_comp_init(&pdcp_rohc_comp, LTE_FDD_ENB_ROHC_MAX_CID, LTE_FDD_ENB_ROHC_PROFILES);
+    liblte_rohc_decomp_init(&pdcp_rohc_decomp, LTE_FDD_ENB_ROHC_MAX_CID, LTE_FDD_ENB_ROHC_PROFILES, true);
+}
+bool LTE_fdd_enb_rb::get_pdcp_rohc(void)
+{
+    return(pdcp_rohc);
+}
+LIBLTE_ROHC_COMP_STRUCT* LTE_fdd_enb_rb::get_pdcp_rohc_comp(void)
+{
+    return(&pdcp_rohc_comp);
+}
+LIBLTE_ROHC_DECOMP_STRUCT* LTE_fdd_enb_rb::get_pdcp_rohc_decomp(void)
+{
+    return(&pdcp_rohc_decomp);
+}
 
 /*************/
 /*    RLC    */
@@ -395,17 +490,125 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_rlc_pdu(void)
 {
     return(delete_next_msg(&rlc_pdu_queue_mutex, &rlc_pdu_queue));
 }
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::release_next_rlc_pdu(void)
+{
+    boost::mutex::scoped_lock lock(rlc_pdu_queue_mutex);
+    LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
+
+    // The PDU is now owned by the reception window
+    if(0 != rlc_pdu_queue.size())
+    {
+        rlc_pdu_queue.pop_front();
+        err = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
 void LTE_fdd_enb_rb::queue_rlc_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu)
 {
-    queue_msg(sdu, &rlc_sdu_queue_mutex, &rlc_sdu_queue);
+    queue_msg(sdu, NULL, &rlc_sdu_queue);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_rlc_sdu(LIBLTE_BYTE_MSG_STRUCT **sdu)
 {
-    return(get_next_msg(&rlc_sdu_queue_mutex, &rlc_sdu_queue, sdu));
+    return(get_next_msg(NULL, &rlc_sdu_queue, sdu));
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_rlc_sdu(void)
 {
-    return(delete_next_msg(&rlc_sdu_queue_mutex, &rlc_sdu_queue));
+    return(delete_next_msg(NULL, &rlc_sdu_queue));
+}
+bool LTE_fdd_enb_rb::queue_rlc_tx_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu)
+{
+    boost::mutex::scoped_lock  lock(rlc_tx_sdu_queue_mutex);
+    LIBLTE_BYTE_MSG_STRUCT    *loc_sdu;
+    bool                       was_empty = (0 == rlc_tx_sdu_queue.size());
+
+    loc_sdu = new LIBLTE_BYTE_MSG_STRUCT;
+    memcpy(loc_sdu, sdu, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+
+    // The enqueue time gives the sojourn time for queue management
+    rlc_tx_sdu_queue.push_back(loc_sdu);
+    rlc_tx_sdu_time_queue.push_back(liblte_qos_get_time_us());
+    rlc_tx_sdu_queue_bytes += loc_sdu->N_bytes;
+
+    return(was_empty);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_rlc_tx_sdu(LIBLTE_BYTE_MSG_STRUCT **sdu)
+{
+    boost::mutex::scoped_lock  lock(rlc_tx_sdu_queue_mutex);
+    LIBLTE_BYTE_MSG_STRUCT    *loc_sdu;
+    LTE_FDD_ENB_ERROR_ENUM     err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
+    uint64                     now;
+
+    // CoDel drops SDUs as they reach the head of the queue, like the
+    // PDCP discard timer does, but never once a segment has been sent
+    if(rlc_tx_aqm &&
+       0 == rlc_tx_sdu_offset)
+    {
+        now = liblte_qos_get_time_us();
+        while(0 != rlc_tx_sdu_queue.size() &&
+              liblte_qos_codel_drop(&rlc_tx_codel,
+                                    now,
+                                    now - rlc_tx_sdu_time_queue.front(),
+                                    rlc_tx_sdu_queue_bytes))
+        {
+            loc_sdu                 = rlc_tx_sdu_queue.front();
+            rlc_tx_sdu_queue_bytes -= loc_sdu->N_bytes;
+            rlc_tx_sdu_queue.pop_front();
+            rlc_tx_sdu_time_queue.pop_front();
+            delete loc_sdu;
+        }
+    }
+
+    if(0 != rlc_tx_sdu_queue.size())
+    {
+        *sdu = rlc_tx_sdu_queue.front();
+        err  = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_rlc_tx_sdu(void)
+{
+    boost::mutex::scoped_lock  lock(rlc_tx_sdu_queue_mutex);
+    LIBLTE_BYTE_MSG_STRUCT    *loc_sdu;
+    LTE_FDD_ENB_ERROR_ENUM     err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
+
+    rlc_tx_sdu_offset = 0;
+    if(0 != rlc_tx_sdu_queue.size())
+    {
+        loc_sdu                 = rlc_tx_sdu_queue.front();
+        rlc_tx_sdu_queue_bytes -= loc_sdu->N_bytes;
+        rlc_tx_sdu_queue.pop_front();
+        rlc_tx_sdu_time_queue.pop_front();
+        delete loc_sdu;
+        err = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
+uint32 LTE_fdd_enb_rb::get_rlc_tx_queue_bytes(uint32 *N_sdus)
+{
+    boost::mutex::scoped_lock lock(rlc_tx_sdu_queue_mutex);
+
+    *N_sdus = rlc_tx_sdu_queue.size();
+
+    return(rlc_tx_sdu_queue_bytes - rlc_tx_sdu_offset);
+}
+uint32 LTE_fdd_enb_rb::get_rlc_tx_N_drops(void)
+{
+    return(rlc_tx_codel.N_drops);
+}
+uint32 LTE_fdd_enb_rb::get_rlc_tx_sdu_offset(void)
+{
+    return(rlc_tx_sdu_offset);
+}
+void LTE_fdd_enb_rb::set_rlc_tx_sdu_offset(uint32 offset)
+{
+    rlc_tx_sdu_offset = offset;
+}
+boost::mutex* LTE_fdd_enb_rb::get_rlc_tx_mutex(void)
+{
+    return(&rlc_tx_mutex);
 }
 LTE_FDD_ENB_RLC_CONFIG_ENUM LTE_fdd_enb_rb::get_rlc_config(void)
 {
@@ -422,17 +625,12 @@ void LTE_fdd_enb_rb::set_rlc_vrr(uint16 vrr)
 }
 void LTE_fdd_enb_rb::update_rlc_vrr(void)
 {
-    std::map<uint16, LIBLTE_BYTE_MSG_STRUCT *>::iterator iter;
-    uint32                                               i;
-    uint16                                               vrr = rlc_vrr;
-
-    for(i=vrr; i<rlc_vrh; i++)
+    // VR(R) moves past every PDU that has been received in sequence
+    while(rlc_vrr != rlc_vrh &&
+          rlc_rx_window_has(rlc_vrr))
     {
-        iter = rlc_am_reception_buffer.find(i);
-        if(rlc_am_reception_buffer.end() != iter)
-        {
-            rlc_vrr = i+1;
-        }
+        rlc_rx_N_ahead--;
+        set_rlc_vrr((rlc_vrr + 1) & LTE_FDD_ENB_RLC_SN_MASK);
     }
 }
 uint16 LTE_fdd_enb_rb::get_rlc_vrmr(void)
@@ -447,110 +645,57 @@ void LTE_fdd_enb_rb::set_rlc_vrh(uint16 vrh)
 {
     rlc_vrh = vrh;
 }
-void LTE_fdd_enb_rb::rlc_add_to_am_reception_buffer(LIBLTE_RLC_AMD_PDU_STRUCT *amd_pdu)
+bool LTE_fdd_enb_rb::rlc_add_to_am_reception_buffer(LIBLTE_RLC_AMD_PDU_STRUCT *amd_pdu,
+                                                    LIBLTE_BYTE_MSG_STRUCT    *pdu)
 {
-    std::map<uint16, LIBLTE_BYTE_MSG_STRUCT *>::iterator  iter;
-    LIBLTE_BYTE_MSG_STRUCT                               *new_pdu = NULL;
-
-    new_pdu = new LIBLTE_BYTE_MSG_STRUCT;
+    uint16 sn = amd_pdu->hdr.sn & LTE_FDD_ENB_RLC_SN_MASK;
 
-    if(NULL != new_pdu)
+    if(rlc_rx_window_has(sn))
     {
-        iter = rlc_am_reception_buffer.find(amd_pdu->hdr.sn);
-        if(rlc_am_reception_buffer.end() == iter)
-        {
-            memcpy(new_pdu, &amd_pdu->data, sizeof(LIBLTE_BYTE_MSG_STRUCT));
-            rlc_am_reception_buffer[amd_pdu->hdr.sn] = new_pdu;
-
-            if(LIBLTE_RLC_FI_FIELD_FULL_SDU == amd_pdu->hdr.fi)
-            {
-                rlc_first_am_segment_sn = amd_pdu->hdr.sn;
-                rlc_last_am_segment_sn  = amd_pdu->hdr.sn;
-            }else if(LIBLTE_RLC_FI_FIELD_FIRST_SDU_SEGMENT == amd_pdu->hdr.fi){
-                rlc_first_am_segment_sn = amd_pdu->hdr.sn;
-            }else if(LIBLTE_RLC_FI_FIELD_LAST_SDU_SEGMENT == amd_pdu->hdr.fi){
-                rlc_last_am_segment_sn = amd_pdu->hdr.sn;
-            }
-        }else{
-            delete new_pdu;
-        }
+        return(false);
     }
+
+    rlc_add_to_rx_window(sn,
+                         amd_pdu->hdr.fi,
+                         amd_pdu->hdr.N_li,
+                         amd_pdu->hdr.li,
+                         pdu,
+                         pdu->N_bytes - amd_pdu->data.N_bytes);
+    rlc_rx_N_ahead++;
+
+    return(true);
 }
 void LTE_fdd_enb_rb::rlc_get_am_reception_buffer_status(LIBLTE_RLC_STATUS_PDU_STRUCT *status)
 {
-    std::map<uint16, LIBLTE_BYTE_MSG_STRUCT *>::iterator iter;
-    uint32                                               i;
+    uint32 N_missing;
+    uint16 sn;
 
     // Fill in the ACK_SN
     status->ack_sn = rlc_vrh;
 
-    // Determine if any NACK_SNs are needed
+    // Everything between VR(R) and VR(H) that is not held is missing, so
+    // the scan stops as soon as that many NACK_SNs have been found
     status->N_nack = 0;
-    if(rlc_vrh != rlc_vrr)
+    N_missing      = ((rlc_vrh - rlc_vrr) & LTE_FDD_ENB_RLC_SN_MASK) - rlc_rx_N_ahead;
+    sn             = rlc_vrr;
+    while(status->N_nack < N_missing)
     {
-        for(i=rlc_vrr; i<rlc_vrh; i++)
+        if(0          == (sn % 32) &&
+           0xFFFFFFFF == rlc_rx_map[sn/32])
         {
-            if(i > 0x3FFFF)
-            {
-                i -= 0x3FFFF;
-            }
-
-            iter = rlc_am_reception_buffer.find(i);
-            if(rlc_am_reception_buffer.end() == iter)
+            sn = (sn + 32) & LTE_FDD_ENB_RLC_SN_MASK;
+        }else{
+            if(!rlc_rx_window_has(sn))
             {
-                status->nack_sn[status->N_nack++] = i;
+                status->nack_sn[status->N_nack++] = sn;
             }
-        }
-
-        // Update VR(R) if there are no missing frames
-        if(0 == status->N_nack)
-        {
-            set_rlc_vrr(rlc_vrh);
+            sn = (sn + 1) & LTE_FDD_ENB_RLC_SN_MASK;
         }
     }
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_am_reassemble(LIBLTE_BYTE_MSG_STRUCT *sdu)
 {
-    std::map<uint16, LIBLTE_BYTE_MSG_STRUCT *>::iterator iter;
-    LTE_FDD_ENB_ERROR_ENUM                               err = LTE_FDD_ENB_ERROR_CANT_REASSEMBLE_SDU;
-    uint32                                               i;
-    bool                                                 reassemble = true;
-
-    if(0xFFFF != rlc_first_am_segment_sn &&
-       0xFFFF != rlc_last_am_segment_sn)
-    {
-        // Make sure all segments are available
-        for(i=rlc_first_am_segment_sn; i<=rlc_last_am_segment_sn; i++)
-        {
-            iter = rlc_am_reception_buffer.find(i);
-            if(rlc_am_reception_buffer.end() == iter)
-            {
-                reassemble = false;
-            }
-        }
-
-        if(reassemble)
-        {
-            // Reorder and reassemble the SDU
-            sdu->N_bytes = 0;
-            for(i=rlc_first_am_segment_sn; i<=rlc_last_am_segment_sn; i++)
-            {
-                iter = rlc_am_reception_buffer.find(i);
-                memcpy(&sdu->msg[sdu->N_bytes], (*iter).second->msg, (*iter).second->N_bytes);
-                sdu->N_bytes += (*iter).second->N_bytes;
-                delete (*iter).second;
-                rlc_am_reception_buffer.erase(iter);
-            }
-
-            // Clear the first/last segment SNs
-            rlc_first_am_segment_sn = 0xFFFF;
-            rlc_last_am_segment_sn  = 0xFFFF;
-
-            err = LTE_FDD_ENB_ERROR_NONE;
-        }
-    }
-
-    return(err);
+    return(rlc_reassemble(sdu));
 }
 uint16 LTE_fdd_enb_rb::get_rlc_vta(void)
 {
@@ -575,48 +720,58 @@ void LTE_fdd_enb_rb::set_rlc_vts(uint16 vts)
 }
 void LTE_fdd_enb_rb::rlc_add_to_transmission_buffer(LIBLTE_RLC_AMD_PDU_STRUCT *amd_pdu)
 {
-    LIBLTE_RLC_AMD_PDU_STRUCT *new_pdu = NULL;
+    LIBLTE_RLC_AMD_PDU_STRUCT *new_pdu;
+    uint16                     sn = amd_pdu->hdr.sn & LTE_FDD_ENB_RLC_SN_MASK;
 
-    new_pdu = new LIBLTE_RLC_AMD_PDU_STRUCT;
-
-    if(NULL != new_pdu)
+    if(NULL == rlc_tx_window[sn])
     {
-        memcpy(new_pdu, amd_pdu, sizeof(LIBLTE_RLC_AMD_PDU_STRUCT));
-        rlc_am_transmission_buffer[amd_pdu->hdr.sn] = new_pdu;
+        if(0 != rlc_tx_pool.size())
+        {
+            rlc_tx_window[sn] = rlc_tx_pool.back();
+            rlc_tx_pool.pop_back();
+        }else{
+            rlc_tx_window[sn] = new LIBLTE_RLC_AMD_PDU_STRUCT;
+        }
+        rlc_tx_window_N_pdus++;
     }
+
+    new_pdu               = rlc_tx_window[sn];
+    new_pdu->data.N_bytes = amd_pdu->data.N_bytes;
+    memcpy(&new_pdu->hdr, &amd_pdu->hdr, sizeof(LIBLTE_RLC_AMD_PDU_HEADER_STRUCT));
+    memcpy(new_pdu->data.msg, amd_pdu->data.msg, amd_pdu->data.N_bytes);
 }
 void LTE_fdd_enb_rb::rlc_update_transmission_buffer(uint32 ack_sn)
 {
-    std::map<uint16, LIBLTE_RLC_AMD_PDU_STRUCT *>::iterator iter;
-    uint32                                                  i          = rlc_vta;
-    bool                                                    update_vta = true;
+    uint16 i          = rlc_vta;
+    bool   update_vta = true;
 
+    ack_sn &= LTE_FDD_ENB_RLC_SN_MASK;
     while(i != ack_sn)
     {
-        iter = rlc_am_transmission_buffer.find(i);
-        if(rlc_am_transmission_buffer.end() != iter)
+        if(NULL != rlc_tx_window[i])
         {
-            delete (*iter).second;
-            rlc_am_transmission_buffer.erase(iter);
+            rlc_tx_pool.push_back(rlc_tx_window[i]);
+            rlc_tx_window[i] = NULL;
+            rlc_tx_window_N_pdus--;
             if(update_vta)
             {
-                set_rlc_vta(i+1);
+                set_rlc_vta((i+1) & LTE_FDD_ENB_RLC_SN_MASK);
             }
         }else{
             update_vta = false;
         }
-        i++;
-        if(i >= 1024)
-        {
-            i = 0;
-        }
+        i = (i+1) & LTE_FDD_ENB_RLC_SN_MASK;
     }
 
-    if(rlc_am_transmission_buffer.size() == 0)
+    if(0 == rlc_tx_window_N_pdus)
     {
         rlc_stop_t_poll_retransmit();
     }
 }
+LIBLTE_RLC_AMD_PDU_STRUCT* LTE_fdd_enb_rb::rlc_get_transmission_buffer_pdu(uint16 sn)
+{
+    return(rlc_tx_window[sn & LTE_FDD_ENB_RLC_SN_MASK]);
+}
 void LTE_fdd_enb_rb::rlc_start_t_poll_retransmit(void)
 {
     LTE_fdd_enb_timer_mgr *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
@@ -636,116 +791,235 @@ void LTE_fdd_enb_rb::rlc_stop_t_poll_retransmit(void)
 }
 void LTE_fdd_enb_rb::handle_t_poll_retransmit_timer_expiry(uint32 timer_id)
 {
-    LTE_fdd_enb_rlc                                         *rlc  = LTE_fdd_enb_rlc::get_instance();
-    std::map<uint16, LIBLTE_RLC_AMD_PDU_STRUCT *>::iterator  iter = rlc_am_transmission_buffer.find(rlc_vta);
+    LTE_fdd_enb_rlc *rlc = LTE_fdd_enb_rlc::get_instance();
 
+    // The timer runs on the timer thread, so the timer ID is only
+    // touched under the RLC TX mutex.  An expiry that raced with a
+    // stop or restart is ignored.
+    rlc_tx_mutex.lock();
+    if(timer_id != t_poll_retransmit_timer_id)
+    {
+        rlc_tx_mutex.unlock();
+        return;
+    }
     t_poll_retransmit_timer_id = LTE_FDD_ENB_INVALID_TIMER_ID;
+    rlc_tx_mutex.unlock();
+
+    // The PDU to retransmit is picked under the lock by RLC
+    rlc->handle_retransmit(user, this);
+}
+uint16 LTE_fdd_enb_rb::get_rlc_vruh(void)
+{
+    return(rlc_vruh);
+}
+uint16 LTE_fdd_enb_rb::get_rlc_vrur(void)
+{
+    return(rlc_rx_next_sn);
+}
+uint16 LTE_fdd_enb_rb::get_rlc_um_window_size(void)
+{
+    return(rlc_um_window_size);
+}
+bool LTE_fdd_enb_rb::rlc_add_to_um_reception_buffer(LIBLTE_RLC_UMD_PDU_STRUCT *umd_pdu,
+                                                    LIBLTE_BYTE_MSG_STRUCT    *pdu)
+{
+    uint16 sn = umd_pdu->hdr.sn & LTE_FDD_ENB_RLC_SN_MASK;
+    uint16 vrul;
+
+    // A PDU at or beyond VR(UH) moves the reordering window, SNs left
+    // behind it will never be received so partial SDUs there are dropped
+    if(((sn - rlc_vruh) & LTE_FDD_ENB_RLC_SN_MASK) < rlc_um_window_size)
+    {
+        rlc_vruh = (sn + 1) & LTE_FDD_ENB_RLC_SN_MASK;
+        vrul     = (rlc_vruh - rlc_um_window_size) & LTE_FDD_ENB_RLC_SN_MASK;
+        while(((rlc_rx_next_sn - vrul) & LTE_FDD_ENB_RLC_SN_MASK) > rlc_um_window_size)
+        {
+            rlc_rx_sdu_started = false;
+            rlc_rx_next_sn     = (rlc_rx_next_sn + 1) & LTE_FDD_ENB_RLC_SN_MASK;
+            rlc_rx_next_seg    = 0;
+        }
+        rlc_release_rx_window();
+    }
 
-    if(rlc_am_transmission_buffer.end() != iter)
+    if(rlc_rx_window_has(sn))
     {
-        rlc->handle_retransmit((*iter).second, user, this);
+        return(false);
     }
+
+    rlc_add_to_rx_window(sn,
+                         umd_pdu->hdr.fi,
+                         umd_pdu->hdr.N_li,
+                         umd_pdu->hdr.li,
+                         pdu,
+                         pdu->N_bytes - umd_pdu->data.N_bytes);
+
+    return(true);
 }
-void LTE_fdd_enb_rb::set_rlc_vruh(uint16 vruh)
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_um_reassemble(LIBLTE_BYTE_MSG_STRUCT *sdu)
 {
-    rlc_vruh = vruh;
+    return(rlc_reassemble(sdu));
 }
-uint16 LTE_fdd_enb_rb::get_rlc_vruh(void)
+void LTE_fdd_enb_rb::set_rlc_vtus(uint16 vtus)
 {
-    return(rlc_vruh);
+    rlc_vtus = vtus;
 }
-void LTE_fdd_enb_rb::set_rlc_vrur(uint16 vrur)
+uint16 LTE_fdd_enb_rb::get_rlc_vtus(void)
 {
-    rlc_vrur = vrur;
+    return(rlc_vtus);
 }
-uint16 LTE_fdd_enb_rb::get_rlc_vrur(void)
+
+bool LTE_fdd_enb_rb::rlc_rx_window_has(uint16 sn)
 {
-    return(rlc_vrur);
+    return(0 != (rlc_rx_map[sn/32] & (1 << (sn%32))));
 }
-uint16 LTE_fdd_enb_rb::get_rlc_um_window_size(void)
+void LTE_fdd_enb_rb::rlc_add_to_rx_window(uint16                    sn,
+                                          LIBLTE_RLC_FI_FIELD_ENUM  fi,
+                                          uint32                    N_li,
+                                          uint16                   *li,
+                                          LIBLTE_BYTE_MSG_STRUCT   *data,
+                                          uint32                    data_offset)
 {
-    return(rlc_um_window_size);
+    LTE_FDD_ENB_RLC_RX_PDU_STRUCT *pdu     = &rlc_rx_window[sn];
+    uint32                         N_bytes = 0;
+    uint32                         i;
+
+    // Segments are read straight out of the received PDU
+    pdu->data        = data;
+    pdu->data_offset = data_offset;
+    pdu->fi          = fi;
+
+    // LIs that overrun the data field are ignored
+    for(i=0; i<N_li; i++)
+    {
+        N_bytes += li[i];
+    }
+    pdu->N_li = 0;
+    if(N_bytes < (data->N_bytes - data_offset))
+    {
+        pdu->N_li = N_li;
+        memcpy(pdu->li, li, N_li*sizeof(uint16));
+    }
+
+    rlc_rx_map[sn/32] |= 1 << (sn%32);
 }
-void LTE_fdd_enb_rb::rlc_add_to_um_reception_buffer(LIBLTE_RLC_UMD_PDU_STRUCT *umd_pdu)
+void LTE_fdd_enb_rb::rlc_release_rx_window(void)
 {
-    std::map<uint16, LIBLTE_BYTE_MSG_STRUCT *>::iterator  iter;
-    LIBLTE_BYTE_MSG_STRUCT                               *new_pdu = NULL;
+    uint16 limit = rlc_rx_next_sn;
 
-    new_pdu = new LIBLTE_BYTE_MSG_STRUCT;
+    // Keep every PDU that still holds part of the SDU being reassembled
+    if(rlc_rx_sdu_started)
+    {
+        limit = rlc_rx_sdu_sn;
+    }
 
-    if(NULL != new_pdu)
+    while(limit != rlc_rx_release_sn)
     {
-        iter = rlc_um_reception_buffer.find(umd_pdu->hdr.sn);
-        if(rlc_um_reception_buffer.end() == iter)
+        if(rlc_rx_window_has(rlc_rx_release_sn))
         {
-            memcpy(new_pdu, &umd_pdu->data, sizeof(LIBLTE_BYTE_MSG_STRUCT));
-            rlc_um_reception_buffer[umd_pdu->hdr.sn] = new_pdu;
-
-            if(LIBLTE_RLC_FI_FIELD_FULL_SDU == umd_pdu->hdr.fi)
-            {
-                rlc_first_um_segment_sn = umd_pdu->hdr.sn;
-                rlc_last_um_segment_sn  = umd_pdu->hdr.sn;
-            }else if(LIBLTE_RLC_FI_FIELD_FIRST_SDU_SEGMENT == umd_pdu->hdr.fi){
-                rlc_first_um_segment_sn = umd_pdu->hdr.sn;
-            }else if(LIBLTE_RLC_FI_FIELD_LAST_SDU_SEGMENT == umd_pdu->hdr.fi){
-                rlc_last_um_segment_sn = umd_pdu->hdr.sn;
-            }
-        }else{
-            delete new_pdu;
+            delete rlc_rx_window[rlc_rx_release_sn].data;
+            rlc_rx_window[rlc_rx_release_sn].data  = NULL;
+            rlc_rx_map[rlc_rx_release_sn/32]      &= ~(1 << (rlc_rx_release_sn%32));
         }
+        rlc_rx_release_sn = (rlc_rx_release_sn + 1) & LTE_FDD_ENB_RLC_SN_MASK;
     }
 }
-LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_um_reassemble(LIBLTE_BYTE_MSG_STRUCT *sdu)
+void LTE_fdd_enb_rb::rlc_advance_rx_cursor(void)
+{
+    rlc_rx_next_seg++;
+    if(rlc_rx_next_seg > rlc_rx_window[rlc_rx_next_sn].N_li)
+    {
+        rlc_rx_next_sn  = (rlc_rx_next_sn + 1) & LTE_FDD_ENB_RLC_SN_MASK;
+        rlc_rx_next_seg = 0;
+    }
+}
+uint32 LTE_fdd_enb_rb::rlc_get_rx_segment(uint16   sn,
+                                          uint16   seg,
+                                          uint8  **data)
+{
+    LTE_FDD_ENB_RLC_RX_PDU_STRUCT *pdu    = &rlc_rx_window[sn];
+    uint32                         offset = pdu->data_offset;
+    uint32                         N_bytes;
+    uint32                         i;
+
+    for(i=0; i<seg; i++)
+    {
+        offset += pdu->li[i];
+    }
+    *data = &pdu->data->msg[offset];
+
+    if(seg < pdu->N_li)
+    {
+        N_bytes = pdu->li[seg];
+    }else{
+        N_bytes = pdu->data->N_bytes - offset;
+    }
+
+    return(N_bytes);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_reassemble(LIBLTE_BYTE_MSG_STRUCT *sdu)
 {
-    std::map<uint16, LIBLTE_BYTE_MSG_STRUCT *>::iterator iter;
-    LTE_FDD_ENB_ERROR_ENUM                               err = LTE_FDD_ENB_ERROR_CANT_REASSEMBLE_SDU;
-    uint32                                               i;
-    bool                                                 reassemble = true;
+    LTE_FDD_ENB_RLC_RX_PDU_STRUCT *pdu;
+    LTE_FDD_ENB_ERROR_ENUM         err = LTE_FDD_ENB_ERROR_CANT_REASSEMBLE_SDU;
+    uint8                         *data;
+    uint32                         N_bytes;
+    uint16                         sn;
+    uint16                         seg;
+    bool                           first;
+    bool                           last;
+    bool                           done;
 
-    if(0xFFFF != rlc_first_um_segment_sn &&
-       0xFFFF != rlc_last_um_segment_sn)
+    // Walk the segments received in sequence until one completes an SDU
+    while(LTE_FDD_ENB_ERROR_NONE != err &&
+          rlc_rx_window_has(rlc_rx_next_sn))
     {
-        // Make sure all segments are available
-        for(i=rlc_first_um_segment_sn; i<=rlc_last_um_segment_sn; i++)
+        pdu   = &rlc_rx_window[rlc_rx_next_sn];
+        first = (0 != rlc_rx_next_seg || 0 == ((uint32)pdu->fi & 0x2));
+        last  = (pdu->N_li != rlc_rx_next_seg || 0 == ((uint32)pdu->fi & 0x1));
+
+        // Starting a new SDU drops any earlier one that lost its tail
+        if(first)
         {
-            iter = rlc_um_reception_buffer.find(i);
-            if(rlc_um_reception_buffer.end() == iter)
-            {
-                reassemble = false;
-            }
+            rlc_rx_sdu_sn      = rlc_rx_next_sn;
+            rlc_rx_sdu_seg     = rlc_rx_next_seg;
+            rlc_rx_sdu_started = true;
         }
 
-        if(reassemble)
+        if(last &&
+           rlc_rx_sdu_started)
         {
-            // Reorder and reassemble the SDU
+            // Copy each segment straight out of the window
             sdu->N_bytes = 0;
-            for(i=rlc_first_um_segment_sn; i<=rlc_last_um_segment_sn; i++)
+            sn           = rlc_rx_sdu_sn;
+            seg          = rlc_rx_sdu_seg;
+            err          = LTE_FDD_ENB_ERROR_NONE;
+            do
             {
-                iter = rlc_um_reception_buffer.find(i);
-                memcpy(&sdu->msg[sdu->N_bytes], (*iter).second->msg, (*iter).second->N_bytes);
-                sdu->N_bytes += (*iter).second->N_bytes;
-                delete (*iter).second;
-                rlc_um_reception_buffer.erase(iter);
-            }
-
-            // Clear the first/last segment SNs
-            rlc_first_um_segment_sn = 0xFFFF;
-            rlc_last_um_segment_sn  = 0xFFFF;
-
-            err = LTE_FDD_ENB_ERROR_NONE;
+                N_bytes = rlc_get_rx_segment(sn, seg, &data);
+                if(LIBLTE_MAX_MSG_SIZE >= sdu->N_bytes + N_bytes)
+                {
+                    memcpy(&sdu->msg[sdu->N_bytes], data, N_bytes);
+                    sdu->N_bytes += N_bytes;
+                }else{
+                    err = LTE_FDD_ENB_ERROR_CANT_REASSEMBLE_SDU;
+                }
+                done = (sn  == rlc_rx_next_sn &&
+                        seg == rlc_rx_next_seg);
+                seg++;
+                if(seg > rlc_rx_window[sn].N_li)
+                {
+                    sn  = (sn + 1) & LTE_FDD_ENB_RLC_SN_MASK;
+                    seg = 0;
+                }
+            }while(!done);
+            rlc_rx_sdu_started = false;
         }
+
+        rlc_advance_rx_cursor();
+        rlc_release_rx_window();
     }
 
     return(err);
 }
-void LTE_fdd_enb_rb::set_rlc_vtus(uint16 vtus)
-{
-    rlc_vtus = vtus;
-}
-uint16 LTE_fdd_enb_rb::get_rlc_vtus(void)
-{
-    return(rlc_vtus);
-}
 
 /*************/
 /*    MAC    */
@@ -762,6 +1036,10 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_mac_sdu(void)
 {
     return(delete_next_msg(&mac_sdu_queue_mutex, &mac_sdu_queue));
 }
+uint32 LTE_fdd_enb_rb::get_mac_sdu_queue_bytes(uint32 *N_sdus)
+{
+    return(get_queue_bytes(&mac_sdu_queue_mutex, &mac_sdu_queue, N_sdus));
+}
 LTE_FDD_ENB_MAC_CONFIG_ENUM LTE_fdd_enb_rb::get_mac_config(void)
 {
     return(mac_config);
@@ -851,9 +1129,15 @@ void LTE_fdd_enb_rb::queue_msg(LIBLTE_BIT_MSG_STRUCT              *msg,
                                boost::mutex                       *mutex,
                                std::list<LIBLTE_BIT_MSG_STRUCT *> *queue)
 {
-    boost::mutex::scoped_lock  lock(*mutex);
+    boost::mutex::scoped_lock  lock;
     LIBLTE_BIT_MSG_STRUCT     *loc_msg;
 
+    // Queues only used by one worker have no mutex
+    if(NULL != mutex)
+    {
+        lock = boost::mutex::scoped_lock(*mutex);
+    }
+
     loc_msg = new LIBLTE_BIT_MSG_STRUCT;
     memcpy(loc_msg, msg, sizeof(LIBLTE_BIT_MSG_STRUCT));
 
@@ -863,9 +1147,14 @@ void LTE_fdd_enb_rb::queue_msg(LIBLTE_BYTE_MSG_STRUCT              *msg,
                                boost::mutex                        *mutex,
                                std::list<LIBLTE_BYTE_MSG_STRUCT *> *queue)
 {
-    boost::mutex::scoped_lock  lock(*mutex);
+    boost::mutex::scoped_lock  lock;
     LIBLTE_BYTE_MSG_STRUCT    *loc_msg;
 
+    if(NULL != mutex)
+    {
+        lock = boost::mutex::scoped_lock(*mutex);
+    }
+
     loc_msg = new LIBLTE_BYTE_MSG_STRUCT;
     memcpy(loc_msg, msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
 
@@ -875,9 +1164,14 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_msg(boost::mutex
                                                     std::list<LIBLTE_BIT_MSG_STRUCT *>  *queue,
                                                     LIBLTE_BIT_MSG_STRUCT              **msg)
 {
-    boost::mutex::scoped_lock lock(*mutex);
+    boost::mutex::scoped_lock lock;
     LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
 
+    if(NULL != mutex)
+    {
+        lock = boost::mutex::scoped_lock(*mutex);
+    }
+
     if(0 != queue->size())
     {
         *msg = queue->front();
@@ -890,9 +1184,14 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_msg(boost::mutex
                                                     std::list<LIBLTE_BYTE_MSG_STRUCT *>  *queue,
                                                     LIBLTE_BYTE_MSG_STRUCT              **msg)
 {
-    boost::mutex::scoped_lock lock(*mutex);
+    boost::mutex::scoped_lock lock;
     LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
 
+    if(NULL != mutex)
+    {
+        lock = boost::mutex::scoped_lock(*mutex);
+    }
+
     if(0 != queue->size())
     {
         *msg = queue->front();
@@ -904,10 +1203,15 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::get_next_msg(boost::mutex
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_msg(boost::mutex                       *mutex,
                                                        std::list<LIBLTE_BIT_MSG_STRUCT *> *queue)
 {
-    boost::mutex::scoped_lock  lock(*mutex);
+    boost::mutex::scoped_lock  lock;
     LTE_FDD_ENB_ERROR_ENUM     err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
     LIBLTE_BIT_MSG_STRUCT     *msg;
 
+    if(NULL != mutex)
+    {
+        lock = boost::mutex::scoped_lock(*mutex);
+    }
+
     if(0 != queue->size())
     {
         msg = queue->front();
@@ -921,10 +1225,15 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_msg(boost::mutex
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_msg(boost::mutex                        *mutex,
                                                        std::list<LIBLTE_BYTE_MSG_STRUCT *> *queue)
 {
-    boost::mutex::scoped_lock  lock(*mutex);
+    boost::mutex::scoped_lock  lock;
     LTE_FDD_ENB_ERROR_ENUM     err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
     LIBLTE_BYTE_MSG_STRUCT    *msg;
 
+    if(NULL != mutex)
+    {
+        lock = boost::mutex::scoped_lock(*mutex);
+    }
+
     if(0 != queue->size())
     {
         msg = queue->front();
@@ -935,6 +1244,27 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_msg(boost::mutex
 
     return(err);
 }
+uint32 LTE_fdd_enb_rb::get_queue_bytes(boost::mutex                        *mutex,
+                                       std::list<LIBLTE_BYTE_MSG_STRUCT *> *queue,
+                                       uint32                              *N_msgs)
+{
+    boost::mutex::scoped_lock                     lock;
+    std::list<LIBLTE_BYTE_MSG_STRUCT *>::iterator iter;
+    uint32                                        N_bytes = 0;
+
+    if(NULL != mutex)
+    {
+        lock = boost::mutex::scoped_lock(*mutex);
+    }
+
+    for(iter=queue->begin(); iter!=queue->end(); iter++)
+    {
+        N_bytes += (*iter)->N_bytes;
+    }
+    *N_msgs = queue->size();
+
+    return(N_bytes);
+}
 void LTE_fdd_enb_rb::set_qos(LTE_FDD_ENB_QOS_ENUM _qos)
 {
     qos = _qos;
@@ -953,7 +1283,41 @@ uint32 LTE_fdd_enb_rb::get_qos_tti_freq(void)
 {
     return(avail_qos[qos].tti_frequency);
 }
-uint32 LTE_fdd_enb_rb::get_qos_bytes_per_subfn(void)
+void LTE_fdd_enb_rb::set_bearer_qos(uint8  _qci,
+                                    uint32 gbr_kbps,
+                                    uint32 mbr_kbps)
+{
+    uint64 now = liblte_qos_get_time_us();
+
+    // Operator specific QCIs are treated as the default bearer QCI
+    qci = _qci;
+    if(LIBLTE_SUCCESS != liblte_qos_get_qci(qci, &qci_char))
+    {
+        liblte_qos_get_qci(LIBLTE_QOS_QCI_DEFAULT, &qci_char);
+    }
+    if(LIBLTE_QOS_RESOURCE_TYPE_GBR != qci_char.resource_type)
+    {
+        gbr_kbps = 0;
+    }
+    liblte_qos_token_bucket_init(&gbr_bucket, gbr_kbps, LIBLTE_QOS_TOKEN_BUCKET_BURST_MS, now);
+    liblte_qos_token_bucket_init(&mbr_bucket, mbr_kbps, LIBLTE_QOS_TOKEN_BUCKET_BURST_MS, now);
+
+    // Data bearers get queue management, signalling is never dropped
+    rlc_tx_aqm = true;
+}
+uint8 LTE_fdd_enb_rb::get_qci(void)
+{
+    return(qci);
+}
+LIBLTE_QOS_QCI_STRUCT* LTE_fdd_enb_rb::get_qci_char(void)
+{
+    return(&qci_char);
+}
+LIBLTE_QOS_TOKEN_BUCKET_STRUCT* LTE_fdd_enb_rb::get_gbr_bucket(void)
+{
+    return(&gbr_bucket);
+}
+LIBLTE_QOS_TOKEN_BUCKET_STRUCT* LTE_fdd_enb_rb::get_mbr_bucket(void)
 {
-    return(avail_qos[qos].bytes_per_subfn);
+    return(&mbr_bucket);
 }
@@ -109,20 +109,13 @@ LTE_fdd_enb_rlc::~LTE_fdd_enb_rlc()
 void LTE_fdd_enb_rlc::start(void)
 {
     boost::mutex::scoped_lock lock(start_mutex);
-    LTE_fdd_enb_msgq_cb       mac_cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_rlc, &LTE_fdd_enb_rlc::handle_mac_msg>, this);
-    LTE_fdd_enb_msgq_cb       pdcp_cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_rlc, &LTE_fdd_enb_rlc::handle_pdcp_msg>, this);
 
     if(!started)
     {
-        started        = true;
-        mac_comm_msgq  = new LTE_fdd_enb_msgq("mac_rlc_mq",
-                                              mac_cb);
-        pdcp_comm_msgq = new LTE_fdd_enb_msgq("pdcp_rlc_mq",
-                                              pdcp_cb);
-        rlc_mac_mq     = new boost::interprocess::message_queue(boost::interprocess::open_only,
-                                                                "rlc_mac_mq");
-        rlc_pdcp_mq    = new boost::interprocess::message_queue(boost::interprocess::open_only,
-                                                                "rlc_pdcp_mq");
+        started    = true;
+        worker_mgr = LTE_fdd_enb_worker_mgr::get_instance();
+        rlc_mac_mq = new boost::interprocess::message_queue(boost::interprocess::open_only,
+                                                            "rlc_mac_mq");
     }
 }
 void LTE_fdd_enb_rlc::stop(void)
@@ -132,8 +125,6 @@ void LTE_fdd_enb_rlc::stop(void)
     if(started)
     {
         started = false;
-        delete mac_comm_msgq;
-        delete pdcp_comm_msgq;
     }
 }
 
@@ -165,7 +156,12 @@ void LTE_fdd_enb_rlc::handle_mac_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
         }
     }else{
         // Forward message to PDCP
-        rlc_pdcp_mq->send(&msg, sizeof(msg), 0);
+        worker_mgr->send(msg->user,
+                         msg->type,
+                         msg->dest_layer,
+                         &msg->msg,
+                         sizeof(LTE_FDD_ENB_MESSAGE_UNION));
+        delete msg;
     }
 }
 void LTE_fdd_enb_rlc::handle_pdcp_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
@@ -200,21 +196,22 @@ void LTE_fdd_enb_rlc::handle_pdcp_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
 /****************************/
 /*    External Interface    */
 /****************************/
-void LTE_fdd_enb_rlc::update_sys_info(void)
+void LTE_fdd_enb_rlc::handle_retransmit(LTE_fdd_enb_user *user,
+                                        LTE_fdd_enb_rb   *rb)
 {
-    LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
-
-    sys_info_mutex.lock();
-    cnfg_db->get_sys_info(sys_info);
-    sys_info_mutex.unlock();
-}
-void LTE_fdd_enb_rlc::handle_retransmit(LIBLTE_RLC_AMD_PDU_STRUCT *amd,
-                                        LTE_fdd_enb_user          *user,
-                                        LTE_fdd_enb_rb            *rb)
-{
-    LTE_fdd_enb_interface                *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT  mac_sdu_ready;
-    LIBLTE_BYTE_MSG_STRUCT                pdu;
+    LTE_fdd_enb_interface     *interface = LTE_fdd_enb_interface::get_instance();
+    LIBLTE_RLC_AMD_PDU_STRUCT *amd;
+    LIBLTE_BYTE_MSG_STRUCT     pdu;
+
+    // Retransmit the oldest unacknowledged PDU, it may have been
+    // acknowledged and recycled since the timer expired
+    rb->get_rlc_tx_mutex()->lock();
+    amd = rb->rlc_get_transmission_buffer_pdu(rb->get_rlc_vta());
+    if(NULL == amd)
+    {
+        rb->get_rlc_tx_mutex()->unlock();
+        return;
+    }
 
     // Pack the PDU
     amd->hdr.p = LIBLTE_RLC_P_FIELD_STATUS_REPORT_REQUESTED;
@@ -238,17 +235,56 @@ void LTE_fdd_enb_rlc::handle_retransmit(LIBLTE_RLC_AMD_PDU_STRUCT *amd,
                               liblte_rlc_p_field_text[amd->hdr.p],
                               liblte_rlc_fi_field_text[amd->hdr.fi]);
 
-    // Queue the SDU for MAC
+    // Queue the PDU for MAC, it goes out ahead of new data
     rb->queue_mac_sdu(&pdu);
+    rb->get_rlc_tx_mutex()->unlock();
+    signal_mac(user, rb);
+}
+uint32 LTE_fdd_enb_rlc::get_buffer_state(LTE_fdd_enb_rb *rb)
+{
+    boost::mutex::scoped_lock lock(*rb->get_rlc_tx_mutex());
+    uint32                    N_bytes;
+    uint32                    N_data_bytes;
+    uint32                    N_pdus;
+    uint32                    N_sdus;
+
+    // STATUS PDUs and retransmissions are sent as they are
+    N_bytes = rb->get_mac_sdu_queue_bytes(&N_pdus);
+
+    // New data goes into one PDU with an LI for every SDU but the last
+    N_data_bytes = rb->get_rlc_tx_queue_bytes(&N_sdus);
+    if(0 != N_sdus &&
+       (LTE_FDD_ENB_RLC_CONFIG_UM == rb->get_rlc_config() ||
+        am_tx_window_open(rb)))
+    {
+        N_bytes += 2 + LIBLTE_RLC_LI_FIELD_N_BYTES(N_sdus-1) + N_data_bytes;
+    }
 
-    // Signal MAC
-    mac_sdu_ready.user = user;
-    mac_sdu_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(rlc_mac_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_MAC_SDU_READY,
-                           LTE_FDD_ENB_DEST_LAYER_MAC,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&mac_sdu_ready,
-                           sizeof(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT));
+    return(N_bytes);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rlc::get_pdu(LTE_fdd_enb_user       *user,
+                                                LTE_fdd_enb_rb         *rb,
+                                                uint32                  N_bytes_max,
+                                                LIBLTE_BYTE_MSG_STRUCT *pdu)
+{
+    boost::mutex::scoped_lock  lock(*rb->get_rlc_tx_mutex());
+    LIBLTE_BYTE_MSG_STRUCT    *ctrl_pdu;
+    LTE_FDD_ENB_ERROR_ENUM     err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
+
+    // STATUS PDUs and retransmissions go ahead of new data
+    if(LTE_FDD_ENB_ERROR_NONE == rb->get_next_mac_sdu(&ctrl_pdu) &&
+       ctrl_pdu->N_bytes      <= N_bytes_max)
+    {
+        memcpy(pdu, ctrl_pdu, sizeof(LIBLTE_BYTE_MSG_STRUCT));
+        rb->delete_next_mac_sdu();
+        err = LTE_FDD_ENB_ERROR_NONE;
+    }else if(LTE_FDD_ENB_RLC_CONFIG_UM == rb->get_rlc_config()){
+        err = build_umd_pdu(user, rb, N_bytes_max, pdu);
+    }else if(LTE_FDD_ENB_RLC_CONFIG_AM == rb->get_rlc_config()){
+        err = build_amd_pdu(user, rb, N_bytes_max, pdu);
+    }
+
+    return(err);
 }
 
 /******************************/
@@ -258,6 +294,7 @@ void LTE_fdd_enb_rlc::handle_pdu_ready(LTE_FDD_ENB_RLC_PDU_READY_MSG_STRUCT *pdu
 {
     LTE_fdd_enb_interface  *interface = LTE_fdd_enb_interface::get_instance();
     LIBLTE_BYTE_MSG_STRUCT *pdu;
+    bool                    kept      = false;
 
     if(LTE_FDD_ENB_ERROR_NONE == pdu_ready->rb->get_next_rlc_pdu(&pdu))
     {
@@ -276,10 +313,10 @@ void LTE_fdd_enb_rlc::handle_pdu_ready(LTE_FDD_ENB_RLC_PDU_READY_MSG_STRUCT *pdu
             handle_tm_pdu(pdu, pdu_ready->user, pdu_ready->rb);
             break;
         case LTE_FDD_ENB_RLC_CONFIG_UM:
-            handle_um_pdu(pdu, pdu_ready->user, pdu_ready->rb);
+            kept = handle_um_pdu(pdu, pdu_ready->user, pdu_ready->rb);
             break;
         case LTE_FDD_ENB_RLC_CONFIG_AM:
-            handle_am_pdu(pdu, pdu_ready->user, pdu_ready->rb);
+            kept = handle_am_pdu(pdu, pdu_ready->user, pdu_ready->rb);
             break;
         default:
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
@@ -294,8 +331,13 @@ void LTE_fdd_enb_rlc::handle_pdu_ready(LTE_FDD_ENB_RLC_PDU_READY_MSG_STRUCT *pdu
             break;
         }
 
-        // Delete the PDU
-        pdu_ready->rb->delete_next_rlc_pdu();
+        // Delete the PDU, unless the reception window kept it for reassembly
+        if(kept)
+        {
+            pdu_ready->rb->release_next_rlc_pdu();
+        }else{
+            pdu_ready->rb->delete_next_rlc_pdu();
+        }
     }else{
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                   LTE_FDD_ENB_DEBUG_LEVEL_RLC,
@@ -316,13 +358,13 @@ void LTE_fdd_enb_rlc::handle_tm_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
     // Signal PDCP
     pdcp_pdu_ready.user = user;
     pdcp_pdu_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(rlc_pdcp_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_PDCP_PDU_READY,
-                           LTE_FDD_ENB_DEST_LAYER_PDCP,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_pdu_ready,
-                           sizeof(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT));
+    worker_mgr->send(pdcp_pdu_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_PDCP_PDU_READY,
+                     LTE_FDD_ENB_DEST_LAYER_PDCP,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_pdu_ready,
+                     sizeof(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT));
 }
-void LTE_fdd_enb_rlc::handle_um_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
+bool LTE_fdd_enb_rlc::handle_um_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
                                     LTE_fdd_enb_user       *user,
                                     LTE_fdd_enb_rb         *rb)
 {
@@ -330,21 +372,22 @@ void LTE_fdd_enb_rlc::handle_um_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
     LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT  pdcp_pdu_ready;
     LIBLTE_BYTE_MSG_STRUCT                 pdcp_pdu;
     LIBLTE_RLC_UMD_PDU_STRUCT              umd;
-    int32                                  vrul = (int32)rb->get_rlc_vruh() - (int32)rb->get_rlc_um_window_size();
+    uint16                                 vrul = (rb->get_rlc_vruh() - rb->get_rlc_um_window_size()) & LTE_FDD_ENB_RLC_SN_MASK;
     uint16                                 vrur = rb->get_rlc_vrur();
+    bool                                   kept = false;
 
     umd.hdr.sn_size = LIBLTE_RLC_UMD_SN_SIZE_10_BITS;
     liblte_rlc_unpack_umd_pdu(pdu, &umd);
 
-    if(!(vrul       <= umd.hdr.sn &&
-         umd.hdr.sn  < vrur))
+    // SNs in [VR(UH) - window, VR(UR)) have already been reassembled
+    if(((umd.hdr.sn - vrul) & LTE_FDD_ENB_RLC_SN_MASK) >= ((vrur - vrul) & LTE_FDD_ENB_RLC_SN_MASK))
     {
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                   LTE_FDD_ENB_DEBUG_LEVEL_RLC,
                                   __FILE__,
                                   __LINE__,
                                   &umd.data,
-                                  "Received UMD PDU for RNTI=%u, RB=%s, VR(UL)=%d, SN=%u, VR(UR)=%u, FI=%s",
+                                  "Received UMD PDU for RNTI=%u, RB=%s, VR(UL)=%u, SN=%u, VR(UR)=%u, FI=%s",
                                   user->get_c_rnti(),
                                   LTE_fdd_enb_rb_text[rb->get_rb_id()],
                                   vrul,
@@ -353,9 +396,10 @@ void LTE_fdd_enb_rlc::handle_um_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
                                   liblte_rlc_fi_field_text[umd.hdr.fi]);
 
         // Place RLC data PDU in reception buffer
-        rb->rlc_add_to_um_reception_buffer(&umd);
+        kept = rb->rlc_add_to_um_reception_buffer(&umd, pdu);
 
-        if(LTE_FDD_ENB_ERROR_NONE == rb->rlc_um_reassemble(&pdcp_pdu))
+        // One PDU can complete several concatenated SDUs
+        while(LTE_FDD_ENB_ERROR_NONE == rb->rlc_um_reassemble(&pdcp_pdu))
         {
             // Queue the SDU for PDCP
             rb->queue_pdcp_pdu(&pdcp_pdu);
@@ -363,11 +407,11 @@ void LTE_fdd_enb_rlc::handle_um_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
             // Signal PDCP
             pdcp_pdu_ready.user = user;
             pdcp_pdu_ready.rb   = rb;
-            LTE_fdd_enb_msgq::send(rlc_pdcp_mq,
-                                   LTE_FDD_ENB_MESSAGE_TYPE_PDCP_PDU_READY,
-                                   LTE_FDD_ENB_DEST_LAYER_PDCP,
-                                   (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_pdu_ready,
-                                   sizeof(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT));
+            worker_mgr->send(pdcp_pdu_ready.user,
+                             LTE_FDD_ENB_MESSAGE_TYPE_PDCP_PDU_READY,
+                             LTE_FDD_ENB_DEST_LAYER_PDCP,
+                             (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_pdu_ready,
+                             sizeof(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT));
         }
     }else{
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
@@ -375,15 +419,17 @@ void LTE_fdd_enb_rlc::handle_um_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
                                   __FILE__,
                                   __LINE__,
                                   &umd.data,
-                                  "Received UMD PDU for RNTI=%u, RB=%s, that is outside of the receiving window (%d <= %u < %u)",
+                                  "Received UMD PDU for RNTI=%u, RB=%s, that is outside of the receiving window (%u <= %u < %u)",
                                   user->get_c_rnti(),
                                   LTE_fdd_enb_rb_text[rb->get_rb_id()],
                                   vrul,
                                   umd.hdr.sn,
                                   vrur);
     }
+
+    return(kept);
 }
-void LTE_fdd_enb_rlc::handle_am_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
+bool LTE_fdd_enb_rlc::handle_am_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
                                     LTE_fdd_enb_user       *user,
                                     LTE_fdd_enb_rb         *rb)
 {
@@ -395,6 +441,7 @@ void LTE_fdd_enb_rlc::handle_am_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
     uint16                                 vrr  = rb->get_rlc_vrr();
     uint16                                 vrmr = rb->get_rlc_vrmr();
     uint16                                 vrh  = rb->get_rlc_vrh();
+    bool                                   kept = false;
 
     liblte_rlc_unpack_amd_pdu(pdu, &amd);
 
@@ -402,8 +449,7 @@ void LTE_fdd_enb_rlc::handle_am_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
     {
         handle_status_pdu(pdu, user, rb);
     }else{
-        if(vrr        <= amd.hdr.sn &&
-           amd.hdr.sn <  vrmr)
+        if(((amd.hdr.sn - vrr) & LTE_FDD_ENB_RLC_SN_MASK) < LIBLTE_RLC_AM_WINDOW_SIZE)
         {
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                       LTE_FDD_ENB_DEBUG_LEVEL_RLC,
@@ -422,12 +468,12 @@ void LTE_fdd_enb_rlc::handle_am_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
                                       liblte_rlc_fi_field_text[amd.hdr.fi]);
 
             // Place RLC data PDU in reception buffer
-            rb->rlc_add_to_am_reception_buffer(&amd);
+            kept = rb->rlc_add_to_am_reception_buffer(&amd, pdu);
 
             // Update VR(H)
-            if(amd.hdr.sn >= vrh)
+            if(((amd.hdr.sn - vrr) & LTE_FDD_ENB_RLC_SN_MASK) >= ((vrh - vrr) & LTE_FDD_ENB_RLC_SN_MASK))
             {
-                rb->set_rlc_vrh(amd.hdr.sn + 1);
+                rb->set_rlc_vrh((amd.hdr.sn + 1) & LTE_FDD_ENB_RLC_SN_MASK);
             }
 
             // Update VR(MS)
@@ -439,7 +485,7 @@ void LTE_fdd_enb_rlc::handle_am_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
                 rb->update_rlc_vrr();
                 // FIXME: Handle AMD PDU Segments
 
-                if(LTE_FDD_ENB_ERROR_NONE == rb->rlc_am_reassemble(&pdcp_pdu))
+                while(LTE_FDD_ENB_ERROR_NONE == rb->rlc_am_reassemble(&pdcp_pdu))
                 {
                     // Queue the SDU for PDCP
                     rb->queue_pdcp_pdu(&pdcp_pdu);
@@ -447,11 +493,11 @@ void LTE_fdd_enb_rlc::handle_am_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
                     // Signal PDCP
                     pdcp_pdu_ready.user = user;
                     pdcp_pdu_ready.rb   = rb;
-                    LTE_fdd_enb_msgq::send(rlc_pdcp_mq,
-                                           LTE_FDD_ENB_MESSAGE_TYPE_PDCP_PDU_READY,
-                                           LTE_FDD_ENB_DEST_LAYER_PDCP,
-                                           (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_pdu_ready,
-                                           sizeof(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT));
+                    worker_mgr->send(pdcp_pdu_ready.user,
+                                     LTE_FDD_ENB_MESSAGE_TYPE_PDCP_PDU_READY,
+                                     LTE_FDD_ENB_DEST_LAYER_PDCP,
+                                     (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_pdu_ready,
+                                     sizeof(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT));
                 }
             }
 
@@ -483,6 +529,8 @@ void LTE_fdd_enb_rlc::handle_am_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
             }
         }
     }
+
+    return(kept);
 }
 void LTE_fdd_enb_rlc::handle_status_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
                                         LTE_fdd_enb_user       *user,
@@ -490,13 +538,23 @@ void LTE_fdd_enb_rlc::handle_status_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
 {
     LTE_fdd_enb_interface        *interface = LTE_fdd_enb_interface::get_instance();
     LIBLTE_RLC_STATUS_PDU_STRUCT  status;
+    uint32                        N_sdus;
 
     liblte_rlc_unpack_status_pdu(pdu, &status);
 
+    rb->get_rlc_tx_mutex()->lock();
     rb->rlc_update_transmission_buffer(status.ack_sn);
 
     // FIXME: Handle NACK_SNs
 
+    // The transmitting window may have been what held new data back
+    rb->get_rlc_tx_queue_bytes(&N_sdus);
+    rb->get_rlc_tx_mutex()->unlock();
+    if(0 != N_sdus)
+    {
+        signal_mac(user, rb);
+    }
+
     interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                               LTE_FDD_ENB_DEBUG_LEVEL_RLC,
                               __FILE__,
@@ -530,10 +588,8 @@ void LTE_fdd_enb_rlc::handle_sdu_ready(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT *sdu
             handle_tm_sdu(sdu, sdu_ready->user, sdu_ready->rb);
             break;
         case LTE_FDD_ENB_RLC_CONFIG_UM:
-            handle_um_sdu(sdu, sdu_ready->user, sdu_ready->rb);
-            break;
         case LTE_FDD_ENB_RLC_CONFIG_AM:
-            handle_am_sdu(sdu, sdu_ready->user, sdu_ready->rb);
+            handle_um_am_sdu(sdu, sdu_ready->user, sdu_ready->rb);
             break;
         default:
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
@@ -561,8 +617,7 @@ void LTE_fdd_enb_rlc::handle_tm_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu,
                                     LTE_fdd_enb_user       *user,
                                     LTE_fdd_enb_rb         *rb)
 {
-    LTE_fdd_enb_interface                *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT  mac_sdu_ready;
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
 
     interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                               LTE_FDD_ENB_DEBUG_LEVEL_RLC,
@@ -575,166 +630,17 @@ void LTE_fdd_enb_rlc::handle_tm_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu,
 
     // Queue the SDU for MAC
     rb->queue_mac_sdu(sdu);
-
-    // Signal MAC
-    mac_sdu_ready.user = user;
-    mac_sdu_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(rlc_mac_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_MAC_SDU_READY,
-                           LTE_FDD_ENB_DEST_LAYER_MAC,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&mac_sdu_ready,
-                           sizeof(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT));
+    signal_mac(user, rb);
 }
-void LTE_fdd_enb_rlc::handle_um_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu,
-                                    LTE_fdd_enb_user       *user,
-                                    LTE_fdd_enb_rb         *rb)
+void LTE_fdd_enb_rlc::handle_um_am_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu,
+                                       LTE_fdd_enb_user       *user,
+                                       LTE_fdd_enb_rb         *rb)
 {
-    LTE_fdd_enb_interface                *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT  mac_sdu_ready;
-    LIBLTE_RLC_UMD_PDU_STRUCT             umd;
-    LIBLTE_BYTE_MSG_STRUCT                pdu;
-    uint32                                byte_idx        = 0;
-    uint32                                bytes_per_subfn = rb->get_qos_bytes_per_subfn();
-    uint16                                vtus            = rb->get_rlc_vtus();
-
-    if(sdu->N_bytes <= bytes_per_subfn)
+    // The SDU waits until MAC asks for a PDU that fits its grant, MAC
+    // only needs to hear about the bearer when it has nothing queued
+    if(rb->queue_rlc_tx_sdu(sdu))
     {
-        // Pack the PDU
-        umd.hdr.fi      = LIBLTE_RLC_FI_FIELD_FULL_SDU;
-        umd.hdr.sn      = vtus;
-        umd.hdr.sn_size = LIBLTE_RLC_UMD_SN_SIZE_10_BITS;
-        memcpy(&umd.data, sdu, sizeof(LIBLTE_BYTE_MSG_STRUCT));
-        rb->set_rlc_vtus(vtus+1);
-        liblte_rlc_pack_umd_pdu(&umd, &pdu);
-
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                  __FILE__,
-                                  __LINE__,
-                                  &pdu,
-                                  "Sending UMD PDU for RNTI=%u, RB=%s, SN=%u, FI=%s",
-                                  user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[rb->get_rb_id()],
-                                  umd.hdr.sn,
-                                  liblte_rlc_fi_field_text[umd.hdr.fi]);
-
-        // Queue the PDU for MAC
-        rb->queue_mac_sdu(&pdu);
-
-        // Signal MAC
-        mac_sdu_ready.user = user;
-        mac_sdu_ready.rb   = rb;
-        LTE_fdd_enb_msgq::send(rlc_mac_mq,
-                               LTE_FDD_ENB_MESSAGE_TYPE_MAC_SDU_READY,
-                               LTE_FDD_ENB_DEST_LAYER_MAC,
-                               (LTE_FDD_ENB_MESSAGE_UNION *)&mac_sdu_ready,
-                               sizeof(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT));
-    }else{
-        // Segment the message
-        while(byte_idx < sdu->N_bytes)
-        {
-            umd.hdr.fi = LIBLTE_RLC_FI_FIELD_MIDDLE_SDU_SEGMENT;
-            umd.hdr.sn = vtus;
-            if(byte_idx == 0)
-            {
-                umd.hdr.fi = LIBLTE_RLC_FI_FIELD_FIRST_SDU_SEGMENT;
-            }
-            if((sdu->N_bytes - byte_idx) >= bytes_per_subfn)
-            {
-                memcpy(&umd.data.msg[0], &sdu->msg[byte_idx], bytes_per_subfn);
-                umd.data.N_bytes  = bytes_per_subfn;
-                byte_idx         += bytes_per_subfn;
-            }else{
-                memcpy(&umd.data.msg[0], &sdu->msg[byte_idx], bytes_per_subfn);
-                umd.data.N_bytes = sdu->N_bytes - byte_idx;
-                byte_idx         = sdu->N_bytes;
-            }
-            if(byte_idx == sdu->N_bytes)
-            {
-                umd.hdr.fi = LIBLTE_RLC_FI_FIELD_LAST_SDU_SEGMENT;
-            }
-            rb->set_rlc_vtus(vtus+1);
-            vtus = rb->get_rlc_vtus();
-            liblte_rlc_pack_umd_pdu(&umd, &pdu);
-
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                      __FILE__,
-                                      __LINE__,
-                                      &pdu,
-                                      "Sending UMD PDU for RNTI=%u, RB=%s, SN=%u, FI=%s",
-                                      user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[rb->get_rb_id()],
-                                      umd.hdr.sn,
-                                      liblte_rlc_fi_field_text[umd.hdr.fi]);
-
-            // Queue the PDU for MAC
-            rb->queue_mac_sdu(&pdu);
-
-            // Signal MAC
-            mac_sdu_ready.user = user;
-            mac_sdu_ready.rb   = rb;
-            LTE_fdd_enb_msgq::send(rlc_mac_mq,
-                                   LTE_FDD_ENB_MESSAGE_TYPE_MAC_SDU_READY,
-                                   LTE_FDD_ENB_DEST_LAYER_MAC,
-                                   (LTE_FDD_ENB_MESSAGE_UNION *)&mac_sdu_ready,
-                                   sizeof(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT));
-        }
-    }
-}
-void LTE_fdd_enb_rlc::handle_am_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu,
-                                    LTE_fdd_enb_user       *user,
-                                    LTE_fdd_enb_rb         *rb)
-{
-    LIBLTE_RLC_AMD_PDU_STRUCT amd;
-    uint32                    byte_idx        = 0;
-    uint32                    bytes_per_subfn = rb->get_qos_bytes_per_subfn();
-    uint16                    vts             = rb->get_rlc_vts();
-
-    if(sdu->N_bytes <= bytes_per_subfn)
-    {
-        amd.hdr.dc = LIBLTE_RLC_DC_FIELD_DATA_PDU;
-        amd.hdr.rf = LIBLTE_RLC_RF_FIELD_AMD_PDU;
-        amd.hdr.sn = vts;
-        amd.hdr.p  = LIBLTE_RLC_P_FIELD_STATUS_REPORT_REQUESTED;
-        amd.hdr.fi = LIBLTE_RLC_FI_FIELD_FULL_SDU;
-        memcpy(&amd.data, sdu, sizeof(LIBLTE_BYTE_MSG_STRUCT));
-        rb->set_rlc_vts(vts+1);
-
-        send_amd_pdu(&amd, user, rb);
-    }else{
-        // Segment the message
-        while(byte_idx < sdu->N_bytes)
-        {
-            amd.hdr.dc = LIBLTE_RLC_DC_FIELD_DATA_PDU;
-            amd.hdr.rf = LIBLTE_RLC_RF_FIELD_AMD_PDU;
-            amd.hdr.sn = vts;
-            amd.hdr.p  = LIBLTE_RLC_P_FIELD_STATUS_REPORT_NOT_REQUESTED;
-            amd.hdr.fi = LIBLTE_RLC_FI_FIELD_MIDDLE_SDU_SEGMENT;
-            if(byte_idx == 0)
-            {
-                amd.hdr.fi = LIBLTE_RLC_FI_FIELD_FIRST_SDU_SEGMENT;
-            }
-            if((sdu->N_bytes - byte_idx) >= bytes_per_subfn)
-            {
-                memcpy(&amd.data.msg[0], &sdu->msg[byte_idx], bytes_per_subfn);
-                amd.data.N_bytes  = bytes_per_subfn;
-                byte_idx         += bytes_per_subfn;
-            }else{
-                memcpy(&amd.data.msg[0], &sdu->msg[byte_idx], sdu->N_bytes - byte_idx);
-                amd.data.N_bytes = sdu->N_bytes - byte_idx;
-                byte_idx         = sdu->N_bytes;
-            }
-            if(byte_idx == sdu->N_bytes)
-            {
-                amd.hdr.fi = LIBLTE_RLC_FI_FIELD_LAST_SDU_SEGMENT;
-                amd.hdr.p  = LIBLTE_RLC_P_FIELD_STATUS_REPORT_REQUESTED;
-            }
-            rb->set_rlc_vts(vts+1);
-            vts = rb->get_rlc_vts();
-
-            send_amd_pdu(&amd, user, rb);
-        }
+        signal_mac(user, rb);
     }
 }
 
@@ -745,9 +651,8 @@ void LTE_fdd_enb_rlc::send_status_pdu(LIBLTE_RLC_STATUS_PDU_STRUCT *status_pdu,
                                       LTE_fdd_enb_user             *user,
                                       LTE_fdd_enb_rb               *rb)
 {
-    LTE_fdd_enb_interface                *interface = LTE_fdd_enb_interface::get_instance();
-    LIBLTE_BYTE_MSG_STRUCT                mac_sdu;
-    LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT  mac_sdu_ready;
+    LTE_fdd_enb_interface  *interface = LTE_fdd_enb_interface::get_instance();
+    LIBLTE_BYTE_MSG_STRUCT  mac_sdu;
 
     // Pack the PDU
     liblte_rlc_pack_status_pdu(status_pdu, &mac_sdu);
@@ -763,8 +668,13 @@ void LTE_fdd_enb_rlc::send_status_pdu(LIBLTE_RLC_STATUS_PDU_STRUCT *status_pdu,
 
     // Queue the PDU for MAC
     rb->queue_mac_sdu(&mac_sdu);
+    signal_mac(user, rb);
+}
+void LTE_fdd_enb_rlc::signal_mac(LTE_fdd_enb_user *user,
+                                 LTE_fdd_enb_rb   *rb)
+{
+    LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT mac_sdu_ready;
 
-    // Signal MAC
     mac_sdu_ready.user = user;
     mac_sdu_ready.rb   = rb;
     LTE_fdd_enb_msgq::send(rlc_mac_mq,
@@ -773,65 +683,166 @@ void LTE_fdd_enb_rlc::send_status_pdu(LIBLTE_RLC_STATUS_PDU_STRUCT *status_pdu,
                            (LTE_FDD_ENB_MESSAGE_UNION *)&mac_sdu_ready,
                            sizeof(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT));
 }
-void LTE_fdd_enb_rlc::send_amd_pdu(LIBLTE_RLC_AMD_PDU_STRUCT *amd,
-                                   LTE_fdd_enb_user          *user,
-                                   LTE_fdd_enb_rb            *rb)
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rlc::build_umd_pdu(LTE_fdd_enb_user       *user,
+                                                      LTE_fdd_enb_rb         *rb,
+                                                      uint32                  N_bytes_max,
+                                                      LIBLTE_BYTE_MSG_STRUCT *pdu)
 {
-    LTE_fdd_enb_interface                *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT  mac_sdu_ready;
-    LIBLTE_BYTE_MSG_STRUCT                pdu;
-    uint16                                vta  = rb->get_rlc_vta();
-    uint16                                vtms = rb->get_rlc_vtms();
-
-    // Pack the PDU
-    liblte_rlc_pack_amd_pdu(amd, &pdu);
-
-    // Store
-    rb->rlc_add_to_transmission_buffer(amd);
-
-    // Start t-pollretransmit
-    rb->rlc_start_t_poll_retransmit();
-
-    if(vta         <= amd->hdr.sn &&
-       amd->hdr.sn <  vtms)
+    LTE_fdd_enb_interface     *interface = LTE_fdd_enb_interface::get_instance();
+    LIBLTE_RLC_UMD_PDU_STRUCT  umd;
+    LTE_FDD_ENB_ERROR_ENUM     err       = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
+
+    // Fixed header is 2 bytes with 10 bit SNs
+    if(2                                 <  N_bytes_max &&
+       concatenate_sdus(rb,
+                        N_bytes_max - 2,
+                        &umd.hdr.N_li,
+                        umd.hdr.li,
+                        &umd.hdr.fi,
+                        &umd.data))
     {
+        umd.hdr.sn_size = LIBLTE_RLC_UMD_SN_SIZE_10_BITS;
+        umd.hdr.sn      = rb->get_rlc_vtus();
+        rb->set_rlc_vtus((umd.hdr.sn + 1) % 1024);
+        liblte_rlc_pack_umd_pdu(&umd, pdu);
+
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                   LTE_FDD_ENB_DEBUG_LEVEL_RLC,
                                   __FILE__,
                                   __LINE__,
-                                  &pdu,
-                                  "Sending AMD PDU for RNTI=%u, RB=%s, VT(A)=%u, SN=%u, VT(MS)=%u, RF=%s, P=%s, FI=%s",
+                                  pdu,
+                                  "Sending UMD PDU for RNTI=%u, RB=%s, SN=%u, FI=%s, N_LI=%u",
                                   user->get_c_rnti(),
                                   LTE_fdd_enb_rb_text[rb->get_rb_id()],
-                                  vta,
-                                  amd->hdr.sn,
-                                  vtms,
-                                  liblte_rlc_rf_field_text[amd->hdr.rf],
-                                  liblte_rlc_p_field_text[amd->hdr.p],
-                                  liblte_rlc_fi_field_text[amd->hdr.fi]);
-
-        // Queue the SDU for MAC
-        rb->queue_mac_sdu(&pdu);
-
-        // Signal MAC
-        mac_sdu_ready.user = user;
-        mac_sdu_ready.rb   = rb;
-        LTE_fdd_enb_msgq::send(rlc_mac_mq,
-                               LTE_FDD_ENB_MESSAGE_TYPE_MAC_SDU_READY,
-                               LTE_FDD_ENB_DEST_LAYER_MAC,
-                               (LTE_FDD_ENB_MESSAGE_UNION *)&mac_sdu_ready,
-                               sizeof(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT));
-    }else{
+                                  umd.hdr.sn,
+                                  liblte_rlc_fi_field_text[umd.hdr.fi],
+                                  umd.hdr.N_li);
+
+        err = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rlc::build_amd_pdu(LTE_fdd_enb_user       *user,
+                                                      LTE_fdd_enb_rb         *rb,
+                                                      uint32                  N_bytes_max,
+                                                      LIBLTE_BYTE_MSG_STRUCT *pdu)
+{
+    LTE_fdd_enb_interface     *interface = LTE_fdd_enb_interface::get_instance();
+    LIBLTE_RLC_AMD_PDU_STRUCT  amd;
+    LTE_FDD_ENB_ERROR_ENUM     err       = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
+    uint32                     N_sdus;
+
+    if(2                                 <  N_bytes_max &&
+       am_tx_window_open(rb)                            &&
+       concatenate_sdus(rb,
+                        N_bytes_max - 2,
+                        &amd.hdr.N_li,
+                        amd.hdr.li,
+                        &amd.hdr.fi,
+                        &amd.data))
+    {
+        // Poll when this PDU empties the transmission queue
+        amd.hdr.dc = LIBLTE_RLC_DC_FIELD_DATA_PDU;
+        amd.hdr.rf = LIBLTE_RLC_RF_FIELD_AMD_PDU;
+        amd.hdr.sn = rb->get_rlc_vts();
+        amd.hdr.p  = LIBLTE_RLC_P_FIELD_STATUS_REPORT_NOT_REQUESTED;
+        rb->get_rlc_tx_queue_bytes(&N_sdus);
+        if(0 == N_sdus)
+        {
+            amd.hdr.p = LIBLTE_RLC_P_FIELD_STATUS_REPORT_REQUESTED;
+        }
+        rb->set_rlc_vts((amd.hdr.sn + 1) % 1024);
+        liblte_rlc_pack_amd_pdu(&amd, pdu);
+
+        // Store
+        rb->rlc_add_to_transmission_buffer(&amd);
+
+        // Start t-pollretransmit
+        rb->rlc_start_t_poll_retransmit();
+
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                   LTE_FDD_ENB_DEBUG_LEVEL_RLC,
                                   __FILE__,
                                   __LINE__,
-                                  &pdu,
-                                  "Can't send AMD PDU for RNTI=%u, RB=%s, outside of transmit window (%u <= %u < %u)",
+                                  pdu,
+                                  "Sending AMD PDU for RNTI=%u, RB=%s, VT(A)=%u, SN=%u, VT(MS)=%u, RF=%s, P=%s, FI=%s, N_LI=%u",
                                   user->get_c_rnti(),
                                   LTE_fdd_enb_rb_text[rb->get_rb_id()],
-                                  vta,
-                                  amd->hdr.sn,
-                                  vtms);
+                                  rb->get_rlc_vta(),
+                                  amd.hdr.sn,
+                                  rb->get_rlc_vtms(),
+                                  liblte_rlc_rf_field_text[amd.hdr.rf],
+                                  liblte_rlc_p_field_text[amd.hdr.p],
+                                  liblte_rlc_fi_field_text[amd.hdr.fi],
+                                  amd.hdr.N_li);
+
+        err = LTE_FDD_ENB_ERROR_NONE;
     }
+
+    return(err);
+}
+bool LTE_fdd_enb_rlc::concatenate_sdus(LTE_fdd_enb_rb           *rb,
+                                       uint32                    N_bytes_max,
+                                       uint32                   *N_li,
+                                       uint16                   *li,
+                                       LIBLTE_RLC_FI_FIELD_ENUM *fi,
+                                       LIBLTE_BYTE_MSG_STRUCT   *data)
+{
+    LIBLTE_BYTE_MSG_STRUCT *sdu;
+    uint32                  offset;
+    uint32                  N_bytes;
+    uint32                  last_len  = 0;
+    bool                    first_seg = false;
+    bool                    last_seg  = false;
+
+    *N_li         = 0;
+    data->N_bytes = 0;
+    while(LTE_FDD_ENB_ERROR_NONE == rb->get_next_rlc_tx_sdu(&sdu))
+    {
+        // Every element after the first needs an LI for the one before it
+        if(0 != data->N_bytes)
+        {
+            if(LIBLTE_RLC_MAX_LI <= *N_li    ||
+               LIBLTE_RLC_LI_MAX <  last_len ||
+               N_bytes_max       <= data->N_bytes + LIBLTE_RLC_LI_FIELD_N_BYTES(*N_li + 1))
+            {
+                break;
+            }
+            li[*N_li] = last_len;
+            (*N_li)++;
+        }
+
+        // Take as much of the SDU as fits
+        offset  = rb->get_rlc_tx_sdu_offset();
+        N_bytes = sdu->N_bytes - offset;
+        if(0 == data->N_bytes)
+        {
+            first_seg = (0 != offset);
+        }
+        if(N_bytes > (N_bytes_max - data->N_bytes - LIBLTE_RLC_LI_FIELD_N_BYTES(*N_li)))
+        {
+            N_bytes = N_bytes_max - data->N_bytes - LIBLTE_RLC_LI_FIELD_N_BYTES(*N_li);
+        }
+        memcpy(&data->msg[data->N_bytes], &sdu->msg[offset], N_bytes);
+        data->N_bytes += N_bytes;
+        last_len       = N_bytes;
+        if((offset + N_bytes) == sdu->N_bytes)
+        {
+            rb->delete_next_rlc_tx_sdu();
+        }else{
+            rb->set_rlc_tx_sdu_offset(offset + N_bytes);
+            last_seg = true;
+            break;
+        }
+    }
+
+    // FI bit 1 flags a PDU starting mid SDU, bit 0 one ending mid SDU
+    *fi = (LIBLTE_RLC_FI_FIELD_ENUM)(((first_seg ? 1 : 0) << 1) | (last_seg ? 1 : 0));
+
+    return(0 != data->N_bytes);
+}
+bool LTE_fdd_enb_rlc::am_tx_window_open(LTE_fdd_enb_rb *rb)
+{
+    return(((rb->get_rlc_vts() - rb->get_rlc_vta()) & 0x3FF) < LIBLTE_RLC_AM_WINDOW_SIZE);
 }
@@ -113,20 +113,11 @@ LTE_fdd_enb_rrc::~LTE_fdd_enb_rrc()
 void LTE_fdd_enb_rrc::start(void)
 {
     boost::mutex::scoped_lock lock(start_mutex);
-    LTE_fdd_enb_msgq_cb       pdcp_cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_rrc, &LTE_fdd_enb_rrc::handle_pdcp_msg>, this);
-    LTE_fdd_enb_msgq_cb       mme_cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_rrc, &LTE_fdd_enb_rrc::handle_mme_msg>, this);
 
     if(!started)
     {
-        started        = true;
-        pdcp_comm_msgq = new LTE_fdd_enb_msgq("pdcp_rrc_mq",
-                                              pdcp_cb);
-        mme_comm_msgq  = new LTE_fdd_enb_msgq("mme_rrc_mq",
-                                              mme_cb);
-        rrc_pdcp_mq    = new boost::interprocess::message_queue(boost::interprocess::open_only,
-                                                                "rrc_pdcp_mq");
-        rrc_mme_mq     = new boost::interprocess::message_queue(boost::interprocess::open_only,
-                                                                "rrc_mme_mq");
+        started    = true;
+        worker_mgr = LTE_fdd_enb_worker_mgr::get_instance();
     }
 }
 void LTE_fdd_enb_rrc::stop(void)
@@ -136,8 +127,6 @@ void LTE_fdd_enb_rrc::stop(void)
     if(started)
     {
         started = false;
-        delete pdcp_comm_msgq;
-        delete mme_comm_msgq;
     }
 }
 
@@ -169,7 +158,8 @@ void LTE_fdd_enb_rrc::handle_pdcp_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
         }
     }else{
         // Forward message to MME
-        rrc_mme_mq->send(&msg, sizeof(msg), 0);
+        worker_mgr->send(msg->user, msg->type, msg->dest_layer, &msg->msg, sizeof(LTE_FDD_ENB_MESSAGE_UNION));
+        delete msg;
     }
 }
 void LTE_fdd_enb_rrc::handle_mme_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
@@ -201,22 +191,11 @@ void LTE_fdd_enb_rrc::handle_mme_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
         }
     }else{
         // Forward message to PDCP
-        rrc_pdcp_mq->send(&msg, sizeof(msg), 0);
+        worker_mgr->send(msg->user, msg->type, msg->dest_layer, &msg->msg, sizeof(LTE_FDD_ENB_MESSAGE_UNION));
+        delete msg;
     }
 }
 
-/****************************/
-/*    External Interface    */
-/****************************/
-void LTE_fdd_enb_rrc::update_sys_info(void)
-{
-    LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
-
-    sys_info_mutex.lock();
-    cnfg_db->get_sys_info(sys_info);
-    sys_info_mutex.unlock();
-}
-
 /*******************************/
 /*    PDCP Message Handlers    */
 /*******************************/
@@ -303,11 +282,14 @@ void LTE_fdd_enb_rrc::handle_nas_msg(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT *n
 }
 void LTE_fdd_enb_rrc::handle_cmd(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT *cmd)
 {
-    LTE_fdd_enb_interface  *interface = LTE_fdd_enb_interface::get_instance();
-    LIBLTE_BYTE_MSG_STRUCT *msg;
-    LTE_fdd_enb_rb         *srb2 = NULL;
-    LTE_fdd_enb_rb         *drb1 = NULL;
-    LTE_fdd_enb_rb         *drb2 = NULL;
+    LTE_fdd_enb_interface   *interface = LTE_fdd_enb_interface::get_instance();
+    LTE_fdd_enb_cnfg_reader  cnfg;
+    LIBLTE_BYTE_MSG_STRUCT  *msg;
+    LTE_fdd_enb_rb          *srb2        = NULL;
+    LTE_fdd_enb_rb          *drb1        = NULL;
+    LTE_fdd_enb_rb          *drb2        = NULL;
+    int64                    enable_rohc = cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_ENABLE_ROHC];
+    int64                    ue_ambr_dl  = cnfg.cnfg->param_int64[LTE_FDD_ENB_PARAM_UE_AMBR_DL];
 
     interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                               LTE_FDD_ENB_DEBUG_LEVEL_RRC,
@@ -336,6 +318,8 @@ void LTE_fdd_enb_rrc::handle_cmd(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT *cmd)
             srb2->set_mme_procedure(cmd->rb->get_mme_procedure());
             srb2->set_mme_state(cmd->rb->get_mme_state());
             srb2->set_qos(cmd->rb->get_qos());
+            srb2->set_pdcp_cipher(cmd->user->get_cipher_alg(), cmd->user->get_auth_vec()->k_rrc_enc);
+            srb2->set_pdcp_integrity(cmd->user->get_auth_vec()->k_rrc_int);
 
             // Configure DRB1
             drb1->set_eps_bearer_id(cmd->user->get_eps_bearer_id());
@@ -343,6 +327,10 @@ void LTE_fdd_enb_rrc::handle_cmd(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT *cmd)
             drb1->set_lc_id(3);
             drb1->set_log_chan_group(2);
             drb1->set_qos(cmd->rb->get_qos());
+            drb1->set_pdcp_cipher(cmd->user->get_cipher_alg(), cmd->user->get_auth_vec()->k_up_enc);
+            drb1->set_pdcp_rohc(enable_rohc);
+            drb1->set_bearer_qos(LTE_FDD_ENB_DEF_BEARER_QCI, 0, 0);
+            cmd->user->set_dl_ambr(ue_ambr_dl);
 
             if(LTE_FDD_ENB_ERROR_NONE == cmd->rb->get_next_rrc_nas_msg(&msg))
             {
@@ -370,6 +358,8 @@ void LTE_fdd_enb_rrc::handle_cmd(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT *cmd)
             srb2->set_mme_procedure(cmd->rb->get_mme_procedure());
             srb2->set_mme_state(cmd->rb->get_mme_state());
             srb2->set_qos(cmd->rb->get_qos());
+            srb2->set_pdcp_cipher(cmd->user->get_cipher_alg(), cmd->user->get_auth_vec()->k_rrc_enc);
+            srb2->set_pdcp_integrity(cmd->user->get_auth_vec()->k_rrc_int);
 
             // Configure DRB1
             drb1->set_eps_bearer_id(cmd->user->get_eps_bearer_id());
@@ -377,6 +367,10 @@ void LTE_fdd_enb_rrc::handle_cmd(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT *cmd)
             drb1->set_lc_id(3);
             drb1->set_log_chan_group(2);
             drb1->set_qos(cmd->rb->get_qos());
+            drb1->set_pdcp_cipher(cmd->user->get_cipher_alg(), cmd->user->get_auth_vec()->k_up_enc);
+            drb1->set_pdcp_rohc(enable_rohc);
+            drb1->set_bearer_qos(LTE_FDD_ENB_DEF_BEARER_QCI, 0, 0);
+            cmd->user->set_dl_ambr(ue_ambr_dl);
 
             // Configure DRB2
             drb2->set_eps_bearer_id(cmd->user->get_eps_bearer_id()+1);
@@ -384,6 +378,11 @@ void LTE_fdd_enb_rrc::handle_cmd(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT *cmd)
             drb2->set_lc_id(4);
             drb2->set_log_chan_group(3);
             drb2->set_qos(cmd->rb->get_qos());
+            drb2->set_pdcp_cipher(cmd->user->get_cipher_alg(), cmd->user->get_auth_vec()->k_up_enc);
+            drb2->set_pdcp_rohc(enable_rohc);
+            drb2->set_bearer_qos(LTE_FDD_ENB_DED_BEARER_QCI,
+                                 liblte_qos_bit_rate_kbps(LTE_FDD_ENB_DED_BEARER_GBR, 0),
+                                 liblte_qos_bit_rate_kbps(LTE_FDD_ENB_DED_BEARER_MBR, 0));
 
             if(LTE_FDD_ENB_ERROR_NONE == cmd->rb->get_next_rrc_nas_msg(&msg))
             {
@@ -617,11 +616,11 @@ void LTE_fdd_enb_rrc::parse_ul_dcch_message(LIBLTE_BIT_MSG_STRUCT *msg,
         // Signal MME
         nas_msg_ready.user = user;
         nas_msg_ready.rb   = rb;
-        LTE_fdd_enb_msgq::send(rrc_mme_mq,
-                               LTE_FDD_ENB_MESSAGE_TYPE_MME_NAS_MSG_READY,
-                               LTE_FDD_ENB_DEST_LAYER_MME,
-                               (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
-                               sizeof(LTE_FDD_ENB_MME_NAS_MSG_READY_MSG_STRUCT));
+        worker_mgr->send(nas_msg_ready.user,
+                         LTE_FDD_ENB_MESSAGE_TYPE_MME_NAS_MSG_READY,
+                         LTE_FDD_ENB_DEST_LAYER_MME,
+                         (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
+                         sizeof(LTE_FDD_ENB_MME_NAS_MSG_READY_MSG_STRUCT));
         break;
     case LIBLTE_RRC_UL_DCCH_MSG_TYPE_UL_INFO_TRANSFER:
         if(LIBLTE_RRC_UL_INFORMATION_TRANSFER_TYPE_NAS == rb->ul_dcch_msg.msg.ul_info_transfer.dedicated_info_type)
@@ -632,11 +631,11 @@ void LTE_fdd_enb_rrc::parse_ul_dcch_message(LIBLTE_BIT_MSG_STRUCT *msg,
             // Signal MME
             nas_msg_ready.user = user;
             nas_msg_ready.rb   = rb;
-            LTE_fdd_enb_msgq::send(rrc_mme_mq,
-                                   LTE_FDD_ENB_MESSAGE_TYPE_MME_NAS_MSG_READY,
-                                   LTE_FDD_ENB_DEST_LAYER_MME,
-                                   (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
-                                   sizeof(LTE_FDD_ENB_MME_NAS_MSG_READY_MSG_STRUCT));
+            worker_mgr->send(nas_msg_ready.user,
+                             LTE_FDD_ENB_MESSAGE_TYPE_MME_NAS_MSG_READY,
+                             LTE_FDD_ENB_DEST_LAYER_MME,
+                             (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
+                             sizeof(LTE_FDD_ENB_MME_NAS_MSG_READY_MSG_STRUCT));
         }else{
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                       LTE_FDD_ENB_DEBUG_LEVEL_RRC,
@@ -648,15 +647,18 @@ void LTE_fdd_enb_rrc::parse_ul_dcch_message(LIBLTE_BIT_MSG_STRUCT *msg,
         }
         break;
     case LIBLTE_RRC_UL_DCCH_MSG_TYPE_SECURITY_MODE_COMPLETE:
+        // Start ciphering, Security Mode Command and Complete are sent in clear
+        rb->set_pdcp_cipher(user->get_cipher_alg(), user->get_auth_vec()->k_rrc_enc);
+
         // Signal RRC
         cmd_resp.user     = user;
         cmd_resp.rb       = rb;
         cmd_resp.cmd_resp = LTE_FDD_ENB_MME_RRC_CMD_RESP_SECURITY;
-        LTE_fdd_enb_msgq::send(rrc_mme_mq,
-                               LTE_FDD_ENB_MESSAGE_TYPE_MME_RRC_CMD_RESP,
-                               LTE_FDD_ENB_DEST_LAYER_MME,
-                               (LTE_FDD_ENB_MESSAGE_UNION *)&cmd_resp,
-                               sizeof(LTE_FDD_ENB_MME_RRC_CMD_RESP_MSG_STRUCT));
+        worker_mgr->send(cmd_resp.user,
+                         LTE_FDD_ENB_MESSAGE_TYPE_MME_RRC_CMD_RESP,
+                         LTE_FDD_ENB_DEST_LAYER_MME,
+                         (LTE_FDD_ENB_MESSAGE_UNION *)&cmd_resp,
+                         sizeof(LTE_FDD_ENB_MME_RRC_CMD_RESP_MSG_STRUCT));
         break;
     case LIBLTE_RRC_UL_DCCH_MSG_TYPE_RRC_CON_RECONFIG_COMPLETE:
         rb->set_qos(LTE_FDD_ENB_QOS_NONE);
@@ -704,11 +706,11 @@ void LTE_fdd_enb_rrc::send_dl_info_transfer(LTE_fdd_enb_user       *user,
     // Signal PDCP
     pdcp_sdu_ready.user = user;
     pdcp_sdu_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(rrc_pdcp_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_PDCP_SDU_READY,
-                           LTE_FDD_ENB_DEST_LAYER_PDCP,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_sdu_ready,
-                           sizeof(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT));
+    worker_mgr->send(pdcp_sdu_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_PDCP_SDU_READY,
+                     LTE_FDD_ENB_DEST_LAYER_PDCP,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_sdu_ready,
+                     sizeof(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT));
 }
 void LTE_fdd_enb_rrc::send_rrc_con_reconfig(LTE_fdd_enb_user       *user,
                                             LTE_fdd_enb_rb         *rb,
@@ -756,7 +758,17 @@ void LTE_fdd_enb_rrc::send_rrc_con_reconfig(LTE_fdd_enb_user       *user,
         rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.rlc_am_status_report_required_present   = false;
         rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.rlc_um_pdcp_sn_size_present             = true;
         rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.rlc_um_pdcp_sn_size                     = LIBLTE_RRC_PDCP_SN_SIZE_12_BITS;
-        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_rohc                    = false;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_rohc                    = drb1->get_pdcp_rohc();
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_max_cid                 = LTE_FDD_ENB_ROHC_MAX_CID;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0001            = true;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0002            = true;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0003            = true;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0004            = false;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0006            = false;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0101            = false;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0102            = false;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0103            = false;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0104            = false;
         rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].rlc_cnfg_present                                  = true;
         rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].rlc_cnfg.rlc_mode                                 = LIBLTE_RRC_RLC_MODE_UM_BI;
         rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].rlc_cnfg.ul_um_bi_rlc.sn_field_len                = LIBLTE_RRC_SN_FIELD_LENGTH_SIZE10;
@@ -786,7 +798,17 @@ void LTE_fdd_enb_rrc::send_rrc_con_reconfig(LTE_fdd_enb_user       *user,
         rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.rlc_am_status_report_required_present   = false;
         rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.rlc_um_pdcp_sn_size_present             = true;
         rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.rlc_um_pdcp_sn_size                     = LIBLTE_RRC_PDCP_SN_SIZE_12_BITS;
-        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_rohc                    = false;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_rohc                    = drb2->get_pdcp_rohc();
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_max_cid                 = LTE_FDD_ENB_ROHC_MAX_CID;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0001            = true;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0002            = true;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0003            = true;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0004            = false;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0006            = false;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0101            = false;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0102            = false;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0103            = false;
+        rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].pdcp_cnfg.hdr_compression_profile_0104            = false;
         rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].rlc_cnfg_present                                  = true;
         rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].rlc_cnfg.rlc_mode                                 = LIBLTE_RRC_RLC_MODE_UM_BI;
         rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[idx].rlc_cnfg.ul_um_bi_rlc.sn_field_len                = LIBLTE_RRC_SN_FIELD_LENGTH_SIZE10;
@@ -826,11 +848,11 @@ void LTE_fdd_enb_rrc::send_rrc_con_reconfig(LTE_fdd_enb_user       *user,
     // Signal PDCP
     pdcp_sdu_ready.user = user;
     pdcp_sdu_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(rrc_pdcp_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_PDCP_SDU_READY,
-                           LTE_FDD_ENB_DEST_LAYER_PDCP,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_sdu_ready,
-                           sizeof(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT));
+    worker_mgr->send(pdcp_sdu_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_PDCP_SDU_READY,
+                     LTE_FDD_ENB_DEST_LAYER_PDCP,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_sdu_ready,
+                     sizeof(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT));
 }
 void LTE_fdd_enb_rrc::send_rrc_con_release(LTE_fdd_enb_user *user,
                                            LTE_fdd_enb_rb   *rb)
@@ -858,19 +880,32 @@ void LTE_fdd_enb_rrc::send_rrc_con_release(LTE_fdd_enb_user *user,
     // Signal PDCP
     pdcp_sdu_ready.user = user;
     pdcp_sdu_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(rrc_pdcp_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_PDCP_SDU_READY,
-                           LTE_FDD_ENB_DEST_LAYER_PDCP,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_sdu_ready,
-                           sizeof(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT));
+    worker_mgr->send(pdcp_sdu_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_PDCP_SDU_READY,
+                     LTE_FDD_ENB_DEST_LAYER_PDCP,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_sdu_ready,
+                     sizeof(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT));
 }
 void LTE_fdd_enb_rrc::send_rrc_con_setup(LTE_fdd_enb_user *user,
                                          LTE_fdd_enb_rb   *rb)
 {
-    LTE_fdd_enb_interface                 *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT  pdcp_sdu_ready;
-    LIBLTE_RRC_CONNECTION_SETUP_STRUCT    *rrc_con_setup;
-    LIBLTE_BIT_MSG_STRUCT                  pdcp_sdu;
+    LTE_fdd_enb_interface                       *interface = LTE_fdd_enb_interface::get_instance();
+    LTE_fdd_enb_cnfg_reader                      cnfg;
+    LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT        pdcp_sdu_ready;
+    LIBLTE_RRC_CONNECTION_SETUP_STRUCT          *rrc_con_setup;
+    LIBLTE_RRC_PHYSICAL_CONFIG_DEDICATED_STRUCT *phy_cnfg_ded;
+    LTE_FDD_ENB_PUCCH_CNFG_STRUCT                pucch_cnfg;
+    LIBLTE_BIT_MSG_STRUCT                        pdcp_sdu;
+    uint32                                       k;
+
+    // Derive the PUCCH resources from the C-RNTI so no two users share an
+    // SR or CQI occasion on the same resource
+    k                           = user->get_c_rnti() - LIBLTE_MAC_C_RNTI_START;
+    pucch_cnfg.sr_cnfg_idx      = 5 + (k % 10);
+    pucch_cnfg.n_1_pucch_sr     = (k / 10) % cnfg.sys_info->sib2.rr_config_common_sib.pucch_cnfg.n1_pucch_an;
+    pucch_cnfg.cqi_pmi_cnfg_idx = 17 + ((k + 5) % 20);
+    pucch_cnfg.n_2_pucch_cqi    = 2 * ((k / 20) % 6);
+    user->set_pucch_cnfg(&pucch_cnfg);
 
     rb->dl_ccch_msg.msg_type                                                                  = LIBLTE_RRC_DL_CCCH_MSG_TYPE_RRC_CON_SETUP;
     rrc_con_setup                                                                             = (LIBLTE_RRC_CONNECTION_SETUP_STRUCT *)&rb->dl_ccch_msg.msg.rrc_con_setup;
@@ -887,7 +922,7 @@ void LTE_fdd_enb_rrc::send_rrc_con_setup(LTE_fdd_enb_user *user,
     rrc_con_setup->rr_cnfg.mac_main_cnfg.default_value                                        = false;
     rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg_present                    = true;
     rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg.max_harq_tx_present        = true;
-    rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg.max_harq_tx                = LIBLTE_RRC_MAX_HARQ_TX_N1;
+    rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg.max_harq_tx                = LIBLTE_RRC_MAX_HARQ_TX_N4;
     rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg.periodic_bsr_timer_present = false;
     rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg.retx_bsr_timer             = LIBLTE_RRC_RETRANSMISSION_BSR_TIMER_SF1280;
     rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg.tti_bundling               = false;
@@ -895,8 +930,32 @@ void LTE_fdd_enb_rrc::send_rrc_con_setup(LTE_fdd_enb_user *user,
     rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.phr_cnfg_present                      = false;
     rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.time_alignment_timer                  = LIBLTE_RRC_TIME_ALIGNMENT_TIMER_SF500;
     rrc_con_setup->rr_cnfg.sps_cnfg_present                                                   = false;
-    rrc_con_setup->rr_cnfg.phy_cnfg_ded_present                                               = false;
+    rrc_con_setup->rr_cnfg.phy_cnfg_ded_present                                               = true;
     rrc_con_setup->rr_cnfg.rlf_timers_and_constants_present                                   = false;
+    phy_cnfg_ded                                                                              = &rrc_con_setup->rr_cnfg.phy_cnfg_ded;
+    phy_cnfg_ded->pdsch_cnfg_ded_present                                                      = false;
+    phy_cnfg_ded->pucch_cnfg_ded_present                                                      = false;
+    phy_cnfg_ded->pusch_cnfg_ded_present                                                      = false;
+    phy_cnfg_ded->ul_pwr_ctrl_ded_present                                                     = false;
+    phy_cnfg_ded->tpc_pdcch_cnfg_pucch_present                                                = false;
+    phy_cnfg_ded->tpc_pdcch_cnfg_pusch_present                                                = false;
+    phy_cnfg_ded->cqi_report_cnfg_present                                                     = true;
+    phy_cnfg_ded->cqi_report_cnfg.report_mode_aperiodic_present                               = false;
+    phy_cnfg_ded->cqi_report_cnfg.nom_pdsch_rs_epre_offset                                    = 0;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic_present                                     = true;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic_setup_present                               = true;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic.pucch_resource_idx                          = pucch_cnfg.n_2_pucch_cqi;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic.pmi_cnfg_idx                                = pucch_cnfg.cqi_pmi_cnfg_idx;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic.format_ind_periodic                         = LIBLTE_RRC_CQI_FORMAT_INDICATOR_PERIODIC_WIDEBAND_CQI;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic.ri_cnfg_idx_present                         = false;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic.simult_ack_nack_and_cqi                     = false;
+    phy_cnfg_ded->srs_ul_cnfg_ded_present                                                     = false;
+    phy_cnfg_ded->antenna_info_present                                                        = false;
+    phy_cnfg_ded->sched_request_cnfg_present                                                  = true;
+    phy_cnfg_ded->sched_request_cnfg.setup_present                                            = true;
+    phy_cnfg_ded->sched_request_cnfg.sr_pucch_resource_idx                                    = pucch_cnfg.n_1_pucch_sr;
+    phy_cnfg_ded->sched_request_cnfg.sr_cnfg_idx                                              = pucch_cnfg.sr_cnfg_idx;
+    phy_cnfg_ded->sched_request_cnfg.dsr_trans_max                                            = LIBLTE_RRC_DSR_TRANS_MAX_N64;
     liblte_rrc_pack_dl_ccch_msg(&rb->dl_ccch_msg, &pdcp_sdu);
     interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                               LTE_FDD_ENB_DEBUG_LEVEL_RRC,
@@ -913,22 +972,47 @@ void LTE_fdd_enb_rrc::send_rrc_con_setup(LTE_fdd_enb_user *user,
     // Signal PDCP
     pdcp_sdu_ready.user = user;
     pdcp_sdu_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(rrc_pdcp_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_PDCP_SDU_READY,
-                           LTE_FDD_ENB_DEST_LAYER_PDCP,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_sdu_ready,
-                           sizeof(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT));
+    worker_mgr->send(pdcp_sdu_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_PDCP_SDU_READY,
+                     LTE_FDD_ENB_DEST_LAYER_PDCP,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_sdu_ready,
+                     sizeof(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT));
 }
 void LTE_fdd_enb_rrc::send_security_mode_command(LTE_fdd_enb_user *user,
                                                  LTE_fdd_enb_rb   *rb)
 {
-    LTE_fdd_enb_interface                 *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT  pdcp_sdu_ready;
-    LIBLTE_BIT_MSG_STRUCT                  pdcp_sdu;
+    LTE_fdd_enb_interface                       *interface  = LTE_fdd_enb_interface::get_instance();
+    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT    *auth_vec   = user->get_auth_vec();
+    LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT        pdcp_sdu_ready;
+    LIBLTE_BIT_MSG_STRUCT                        pdcp_sdu;
+    LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM  cipher_alg = LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_EEA0;
+
+    // Select the strongest ciphering algorithm the UE supports
+    if(user->get_eea_support(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA2))
+    {
+        cipher_alg = LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA2;
+    }else if(user->get_eea_support(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA1)){
+        cipher_alg = LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA1;
+    }else if(user->get_eea_support(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA3)){
+        cipher_alg = LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA3;
+    }
+    user->set_cipher_alg(cipher_alg);
+
+    // Derive the AS keys for the selected algorithms
+    liblte_security_generate_k_rrc(auth_vec->k_enb,
+                                   cipher_alg,
+                                   LIBLTE_SECURITY_INTEGRITY_ALGORITHM_ID_128_EIA2,
+                                   auth_vec->k_rrc_enc,
+                                   auth_vec->k_rrc_int);
+    liblte_security_generate_k_up(auth_vec->k_enb,
+                                  cipher_alg,
+                                  LIBLTE_SECURITY_INTEGRITY_ALGORITHM_ID_128_EIA2,
+                                  auth_vec->k_up_enc,
+                                  auth_vec->k_up_int);
 
     rb->dl_dcch_msg.msg_type                                  = LIBLTE_RRC_DL_DCCH_MSG_TYPE_SECURITY_MODE_COMMAND;
     rb->dl_dcch_msg.msg.security_mode_cmd.rrc_transaction_id  = rb->get_rrc_transaction_id();
-    rb->dl_dcch_msg.msg.security_mode_cmd.sec_algs.cipher_alg = LIBLTE_RRC_CIPHERING_ALGORITHM_EEA0;
+    rb->dl_dcch_msg.msg.security_mode_cmd.sec_algs.cipher_alg = (LIBLTE_RRC_CIPHERING_ALGORITHM_ENUM)cipher_alg;
     rb->dl_dcch_msg.msg.security_mode_cmd.sec_algs.int_alg    = LIBLTE_RRC_INTEGRITY_PROT_ALGORITHM_EIA2;
     liblte_rrc_pack_dl_dcch_msg(&rb->dl_dcch_msg, &pdcp_sdu);
     interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
@@ -941,6 +1025,7 @@ void LTE_fdd_enb_rrc::send_security_mode_command(LTE_fdd_enb_user *user,
                               LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Configure PDCP for security
+    rb->set_pdcp_integrity(auth_vec->k_rrc_int);
     rb->set_pdcp_config(LTE_FDD_ENB_PDCP_CONFIG_SECURITY);
 
     // Queue the PDU for PDCP
@@ -949,9 +1034,9 @@ void LTE_fdd_enb_rrc::send_security_mode_command(LTE_fdd_enb_user *user,
     // Signal PDCP
     pdcp_sdu_ready.user = user;
     pdcp_sdu_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(rrc_pdcp_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_PDCP_SDU_READY,
-                           LTE_FDD_ENB_DEST_LAYER_PDCP,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_sdu_ready,
-                           sizeof(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT));
+    worker_mgr->send(pdcp_sdu_ready.user,
+                     LTE_FDD_ENB_MESSAGE_TYPE_PDCP_SDU_READY,
+                     LTE_FDD_ENB_DEST_LAYER_PDCP,
+                     (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_sdu_ready,
+                     sizeof(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT));
 }
@@ -43,7 +43,9 @@
 
 #include "LTE_fdd_enb_user.h"
 #include "LTE_fdd_enb_user_mgr.h"
+#include "LTE_fdd_enb_hss.h"
 #include "LTE_fdd_enb_timer_mgr.h"
+#include "LTE_fdd_enb_phy.h"
 #include "liblte_mme.h"
 #include <boost/lexical_cast.hpp>
 
@@ -77,11 +79,14 @@ LTE_fdd_enb_user::LTE_fdd_enb_user()
     id_set      = false;
     guti_set    = false;
     temp_id     = 0;
+    gen         = 0;
     c_rnti_set  = false;
     ip_addr_set = false;
 
     // Security
-    auth_vec_set = false;
+    auth_vec_set         = false;
+    pending_auth_vec_set = false;
+    cipher_alg           = LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_EEA0;
 
     // Capabilities
     for(i=0; i<8; i++)
@@ -115,15 +120,39 @@ LTE_fdd_enb_user::LTE_fdd_enb_user()
     protocol_cnfg_opts.N_opts = 0;
 
     // MAC
-    dl_ndi = false;
-    ul_ndi = false;
+    for(i=0; i<LTE_FDD_ENB_N_HARQ_PROCS; i++)
+    {
+        dl_harq_proc[i].ndi                  = false;
+        dl_harq_proc[i].active               = false;
+        ul_harq_proc[i].ndi                  = false;
+        ul_harq_proc[i].active               = false;
+        ul_harq_proc[i].soft_buffer.pool     = NULL;
+        ul_harq_proc[i].soft_buffer.N_chunks = 0;
+    }
+    liblte_mac_sched_ue_init(&dl_sched_ue, 0);
+    liblte_mac_sched_ue_init(&ul_sched_ue, 0);
+    set_dl_ambr(0);
+    liblte_qos_drr_init(&dl_drr, LTE_FDD_ENB_RB_N_ITEMS - LTE_FDD_ENB_RB_DRB1);
+    pucch_cnfg_set = false;
+    dl_cqi         = 0;
 
     // Generic
     delete_at_idle = false;
+    sim_ue         = false;
 }
 LTE_fdd_enb_user::~LTE_fdd_enb_user()
 {
-    uint32 i;
+    LTE_fdd_enb_hss *hss = LTE_fdd_enb_hss::get_instance();
+    uint32           i;
+
+    // Security
+    if(id_set)
+    {
+        hss->cancel_security_data(&id, gen);
+    }
+
+    // MAC
+    init_harq_procs();
 
     // Radio Bearers
     for(i=0; i<31; i++)
@@ -140,7 +169,14 @@ LTE_fdd_enb_user::~LTE_fdd_enb_user()
 /********************/
 void LTE_fdd_enb_user::init(void)
 {
-    uint32 i;
+    LTE_fdd_enb_hss *hss = LTE_fdd_enb_hss::get_instance();
+    uint32           i;
+
+    // Security, a vector still being made belongs to the old connection
+    if(id_set)
+    {
+        hss->cancel_security_data(&id, gen);
+    }
 
     // Radio Bearers
     for(i=0; i<31; i++)
@@ -166,8 +202,13 @@ void LTE_fdd_enb_user::init(void)
     protocol_cnfg_opts.N_opts = 0;
 
     // MAC
-    dl_ndi = false;
-    ul_ndi = false;
+    init_harq_procs();
+    liblte_mac_sched_ue_init(&dl_sched_ue, 0);
+    liblte_mac_sched_ue_init(&ul_sched_ue, 0);
+    set_dl_ambr(0);
+    liblte_qos_drr_init(&dl_drr, LTE_FDD_ENB_RB_N_ITEMS - LTE_FDD_ENB_RB_DRB1);
+    pucch_cnfg_set = false;
+    dl_cqi         = 0;
 
     // Identity
     c_rnti     = 0xFFFF;
@@ -211,6 +252,14 @@ uint64 LTE_fdd_enb_user::get_temp_id(void)
 {
     return(temp_id);
 }
+void LTE_fdd_enb_user::set_gen(uint32 _gen)
+{
+    gen = _gen;
+}
+uint32 LTE_fdd_enb_user::get_gen(void)
+{
+    return(gen);
+}
 std::string LTE_fdd_enb_user::get_imsi_str(void)
 {
     return(boost::lexical_cast<std::string>(id.imsi));
@@ -273,6 +322,29 @@ LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT* LTE_fdd_enb_user::get_auth_vec(void)
 {
     return(&auth_vec);
 }
+void LTE_fdd_enb_user::set_pending_auth_vec(LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT *av)
+{
+    // Vector of an authentication in progress, it only becomes the
+    // user's vector once the UE has answered with the right RES
+    if(NULL != av)
+    {
+        memcpy(&pending_auth_vec, av, sizeof(LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT));
+        pending_auth_vec_set = true;
+    }else{
+        pending_auth_vec_set = false;
+    }
+}
+LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT* LTE_fdd_enb_user::get_pending_auth_vec(void)
+{
+    LTE_FDD_ENB_AUTHENTICATION_VECTOR_STRUCT *av = NULL;
+
+    if(pending_auth_vec_set)
+    {
+        av = &pending_auth_vec;
+    }
+
+    return(av);
+}
 void LTE_fdd_enb_user::increment_nas_count_dl(void)
 {
     if(auth_vec_set)
@@ -291,6 +363,14 @@ bool LTE_fdd_enb_user::is_auth_vec_set(void)
 {
     return(auth_vec_set);
 }
+void LTE_fdd_enb_user::set_cipher_alg(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM alg)
+{
+    cipher_alg = alg;
+}
+LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM LTE_fdd_enb_user::get_cipher_alg(void)
+{
+    return(cipher_alg);
+}
 
 /**********************/
 /*    Capabilities    */
@@ -447,7 +527,7 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user::setup_drb(LTE_FDD_ENB_RB_ENUM   drb_id,
     {
         if(NULL == drb[drb_id-LTE_FDD_ENB_RB_DRB1])
         {
-            drb[drb_id-LTE_FDD_ENB_RB_DRB1] = new LTE_fdd_enb_rb(LTE_FDD_ENB_RB_DRB1, this);
+            drb[drb_id-LTE_FDD_ENB_RB_DRB1] = new LTE_fdd_enb_rb(drb_id, this);
             err                             = LTE_FDD_ENB_ERROR_NONE;
         }
         *rb = drb[drb_id-LTE_FDD_ENB_RB_DRB1];
@@ -589,21 +669,132 @@ LIBLTE_MME_PROTOCOL_CONFIG_OPTIONS_STRUCT* LTE_fdd_enb_user::get_protocol_cnfg_o
 /*************/
 /*    MAC    */
 /*************/
-bool LTE_fdd_enb_user::get_dl_ndi(void)
+LTE_FDD_ENB_DL_HARQ_PROC_STRUCT* LTE_fdd_enb_user::get_dl_harq_proc(uint32 proc)
+{
+    return(&dl_harq_proc[proc % LTE_FDD_ENB_N_HARQ_PROCS]);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user::get_free_dl_harq_proc(uint32  current_tti,
+                                                               uint32 *proc)
+{
+    LTE_FDD_ENB_ERROR_ENUM err = LTE_FDD_ENB_ERROR_NO_FREE_HARQ_PROC;
+    uint32                 elapsed;
+    uint32                 i;
+
+    for(i=0; i<LTE_FDD_ENB_N_HARQ_PROCS; i++)
+    {
+        if(dl_harq_proc[i].active)
+        {
+            // A process that never received feedback is treated as ACKed
+            elapsed = (current_tti + LTE_FDD_ENB_CURRENT_TTI_MAX + 1 - dl_harq_proc[i].tx_tti) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+            if(LTE_FDD_ENB_DL_HARQ_FEEDBACK_TIMEOUT <= elapsed)
+            {
+                dl_harq_proc[i].active = false;
+            }
+        }
+        if(!dl_harq_proc[i].active &&
+           LTE_FDD_ENB_ERROR_NONE != err)
+        {
+            *proc = i;
+            err   = LTE_FDD_ENB_ERROR_NONE;
+        }
+    }
+
+    return(err);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user::find_dl_harq_proc(uint32  tx_tti,
+                                                           uint32 *proc)
 {
-    return(dl_ndi);
+    LTE_FDD_ENB_ERROR_ENUM err = LTE_FDD_ENB_ERROR_HARQ_PROC_NOT_FOUND;
+    uint32                 i;
+
+    for(i=0; i<LTE_FDD_ENB_N_HARQ_PROCS; i++)
+    {
+        if(dl_harq_proc[i].active &&
+           dl_harq_proc[i].tx_tti == tx_tti)
+        {
+            *proc = i;
+            err   = LTE_FDD_ENB_ERROR_NONE;
+            break;
+        }
+    }
+
+    return(err);
 }
-void LTE_fdd_enb_user::flip_dl_ndi(void)
+void LTE_fdd_enb_user::release_dl_harq_proc(uint32 proc)
 {
-    dl_ndi ^= 1;
+    dl_harq_proc[proc % LTE_FDD_ENB_N_HARQ_PROCS].active = false;
 }
-bool LTE_fdd_enb_user::get_ul_ndi(void)
+LTE_FDD_ENB_UL_HARQ_PROC_STRUCT* LTE_fdd_enb_user::get_ul_harq_proc(uint32 proc)
 {
-    return(ul_ndi);
+    return(&ul_harq_proc[proc % LTE_FDD_ENB_N_HARQ_PROCS]);
 }
-void LTE_fdd_enb_user::flip_ul_ndi(void)
+void LTE_fdd_enb_user::release_ul_harq_proc(uint32 proc)
 {
-    ul_ndi ^= 1;
+    LTE_fdd_enb_user_mgr            *user_mgr = LTE_fdd_enb_user_mgr::get_instance();
+    LTE_FDD_ENB_UL_HARQ_PROC_STRUCT *harq     = &ul_harq_proc[proc % LTE_FDD_ENB_N_HARQ_PROCS];
+
+    if(NULL != harq->soft_buffer.pool)
+    {
+        user_mgr->free_soft_buffer(&harq->soft_buffer);
+    }
+    harq->active = false;
+}
+void LTE_fdd_enb_user::init_harq_procs(void)
+{
+    uint32 i;
+
+    for(i=0; i<LTE_FDD_ENB_N_HARQ_PROCS; i++)
+    {
+        release_dl_harq_proc(i);
+        release_ul_harq_proc(i);
+        dl_harq_proc[i].ndi = false;
+        ul_harq_proc[i].ndi = false;
+    }
+}
+void LTE_fdd_enb_user::set_pucch_cnfg(LTE_FDD_ENB_PUCCH_CNFG_STRUCT *cnfg)
+{
+    memcpy(&pucch_cnfg, cnfg, sizeof(LTE_FDD_ENB_PUCCH_CNFG_STRUCT));
+    pucch_cnfg_set = true;
+}
+LTE_FDD_ENB_PUCCH_CNFG_STRUCT* LTE_fdd_enb_user::get_pucch_cnfg(void)
+{
+    return(&pucch_cnfg);
+}
+bool LTE_fdd_enb_user::is_pucch_cnfg_set(void)
+{
+    return(pucch_cnfg_set);
+}
+void LTE_fdd_enb_user::set_dl_cqi(uint8 cqi)
+{
+    dl_cqi = cqi;
+}
+uint8 LTE_fdd_enb_user::get_dl_cqi(void)
+{
+    return(dl_cqi);
+}
+LIBLTE_MAC_SCHED_UE_STRUCT* LTE_fdd_enb_user::get_dl_sched_ue(void)
+{
+    return(&dl_sched_ue);
+}
+LIBLTE_MAC_SCHED_UE_STRUCT* LTE_fdd_enb_user::get_ul_sched_ue(void)
+{
+    return(&ul_sched_ue);
+}
+void LTE_fdd_enb_user::set_dl_ambr(uint32 ambr_kbps)
+{
+    // An AMBR of 0 leaves the non-GBR bearers unlimited
+    liblte_qos_token_bucket_init(&dl_ambr_bucket,
+                                 ambr_kbps,
+                                 LIBLTE_QOS_TOKEN_BUCKET_BURST_MS,
+                                 liblte_qos_get_time_us());
+}
+LIBLTE_QOS_TOKEN_BUCKET_STRUCT* LTE_fdd_enb_user::get_dl_ambr_bucket(void)
+{
+    return(&dl_ambr_bucket);
+}
+LIBLTE_QOS_DRR_STRUCT* LTE_fdd_enb_user::get_dl_drr(void)
+{
+    return(&dl_drr);
 }
 
 /*****************/
@@ -617,6 +808,19 @@ bool LTE_fdd_enb_user::get_delete_at_idle(void)
 {
     return(delete_at_idle);
 }
+void LTE_fdd_enb_user::set_sim_ue(uint32 idx)
+{
+    sim_ue_idx = idx;
+    sim_ue     = true;
+}
+bool LTE_fdd_enb_user::is_sim_ue(void)
+{
+    return(sim_ue);
+}
+uint32 LTE_fdd_enb_user::get_sim_ue(void)
+{
+    return(sim_ue_idx);
+}
 void LTE_fdd_enb_user::handle_timer_expiry(uint32 timer_id)
 {
     LTE_fdd_enb_user_mgr *user_mgr = LTE_fdd_enb_user_mgr::get_instance();
@@ -98,10 +98,16 @@ void LTE_fdd_enb_user_mgr::cleanup(void)
 LTE_fdd_enb_user_mgr::LTE_fdd_enb_user_mgr()
 {
     next_m_tmsi = 1;
+    next_gen    = 0;
     next_c_rnti = LIBLTE_MAC_C_RNTI_START;
+
+    // HARQ soft buffer storage
+    soft_buffer_pool = NULL;
+    liblte_phy_soft_buffer_pool_init(&soft_buffer_pool, LTE_FDD_ENB_SOFT_BUFFER_POOL_SIZE);
 }
 LTE_fdd_enb_user_mgr::~LTE_fdd_enb_user_mgr()
 {
+    liblte_phy_soft_buffer_pool_cleanup(soft_buffer_pool);
 }
 
 /****************************/
@@ -176,8 +182,10 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::release_c_rnti(uint16 c_rnti)
                                   "C-RNTI=%u released",
                                   c_rnti);
 
-        // Initialize or delete the user
-        if((*iter).second->is_id_set())
+        // Initialize or delete the user, simulated UEs can't be paged so
+        // they are always deleted
+        if((*iter).second->is_id_set() &&
+           !(*iter).second->is_sim_ue())
         {
             (*iter).second->init();
         }else{
@@ -211,11 +219,15 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::transfer_c_rnti(LTE_fdd_enb_user *o
     boost::mutex::scoped_lock                     lock(c_rnti_mutex);
     std::map<uint16, LTE_fdd_enb_user*>::iterator iter = c_rnti_map.find(old_user->get_c_rnti());
     LTE_FDD_ENB_ERROR_ENUM                        err  = LTE_FDD_ENB_ERROR_C_RNTI_NOT_FOUND;
+    LTE_FDD_ENB_PUCCH_CNFG_STRUCT                 pucch_cnfg;
     uint16                                        c_rnti;
+    bool                                          pucch_cnfg_set;
 
     if(c_rnti_map.end() != iter)
     {
-        c_rnti = old_user->get_c_rnti();
+        c_rnti         = old_user->get_c_rnti();
+        pucch_cnfg_set = old_user->is_pucch_cnfg_set();
+        memcpy(&pucch_cnfg, old_user->get_pucch_cnfg(), sizeof(LTE_FDD_ENB_PUCCH_CNFG_STRUCT));
 
         // Cleanup the old user
         if(old_user->is_id_set())
@@ -230,6 +242,10 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::transfer_c_rnti(LTE_fdd_enb_user *o
         c_rnti_map.erase(iter);
         c_rnti_map[c_rnti] = new_user;
         new_user->set_c_rnti(c_rnti);
+        if(pucch_cnfg_set)
+        {
+            new_user->set_pucch_cnfg(&pucch_cnfg);
+        }
 
         err = LTE_FDD_ENB_ERROR_NONE;
     }
@@ -285,6 +301,7 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::add_user(LTE_fdd_enb_user **user)
 
             // Store user
             user_mutex.lock();
+            new_user->set_gen(next_gen++);
             user_list.push_back(new_user);
             user_mutex.unlock();
 
@@ -417,6 +434,21 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::find_user(uint32             ip_add
 
     return(err);
 }
+void LTE_fdd_enb_user_mgr::get_pucch_users(std::list<LTE_fdd_enb_user*> *users)
+{
+    boost::mutex::scoped_lock              lock(user_mutex);
+    std::list<LTE_fdd_enb_user*>::iterator iter;
+
+    users->clear();
+    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    {
+        if((*iter)->is_c_rnti_set() &&
+           (*iter)->is_pucch_cnfg_set())
+        {
+            users->push_back(*iter);
+        }
+    }
+}
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::del_user(LTE_fdd_enb_user *user)
 {
     boost::mutex::scoped_lock               lock(user_mutex);
@@ -552,6 +584,26 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::del_user(LIBLTE_MME_EPS_MOBILE_ID_G
 
     return(err);
 }
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::alloc_soft_buffer(uint32                         tbs,
+                                                               LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer)
+{
+    boost::mutex::scoped_lock lock(soft_buffer_mutex);
+    LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_NO_FREE_SOFT_BUFFER;
+
+    if(NULL           != soft_buffer_pool &&
+       LIBLTE_SUCCESS == liblte_phy_soft_buffer_alloc(soft_buffer_pool, tbs, soft_buffer))
+    {
+        err = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
+void LTE_fdd_enb_user_mgr::free_soft_buffer(LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer)
+{
+    boost::mutex::scoped_lock lock(soft_buffer_mutex);
+
+    liblte_phy_soft_buffer_free(soft_buffer);
+}
 
 /**********************/
 /*    C-RNTI Timer    */
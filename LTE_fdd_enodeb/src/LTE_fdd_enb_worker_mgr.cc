@@ -0,0 +1,369 @@
+#line 2 "LTE_fdd_enb_worker_mgr.cc" // Make __FILE__ omit the path
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_worker_mgr.cc
+
+    Description: Contains all the implementations for the LTE FDD eNodeB
+                 protocol worker manager.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_worker_mgr.h"
+#include "LTE_fdd_enb_cnfg_db.h"
+#include "LTE_fdd_enb_rlc.h"
+#include "LTE_fdd_enb_pdcp.h"
+#include "LTE_fdd_enb_rrc.h"
+#include "LTE_fdd_enb_mme.h"
+#include "LTE_fdd_enb_attach_storm.h"
+#include <boost/lexical_cast.hpp>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+LTE_fdd_enb_worker_mgr* LTE_fdd_enb_worker_mgr::instance = NULL;
+boost::mutex            worker_mgr_instance_mutex;
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+/*******************/
+/*    Singleton    */
+/*******************/
+LTE_fdd_enb_worker_mgr* LTE_fdd_enb_worker_mgr::get_instance(void)
+{
+    boost::mutex::scoped_lock lock(worker_mgr_instance_mutex);
+
+    if(NULL == instance)
+    {
+        instance = new LTE_fdd_enb_worker_mgr();
+    }
+
+    return(instance);
+}
+void LTE_fdd_enb_worker_mgr::cleanup(void)
+{
+    boost::mutex::scoped_lock lock(worker_mgr_instance_mutex);
+
+    if(NULL != instance)
+    {
+        delete instance;
+        instance = NULL;
+    }
+}
+
+/********************************/
+/*    Constructor/Destructor    */
+/********************************/
+LTE_fdd_enb_worker_mgr::LTE_fdd_enb_worker_mgr()
+{
+    started   = false;
+    N_workers = 0;
+    pthread_key_create(&worker_key, NULL);
+}
+LTE_fdd_enb_worker_mgr::~LTE_fdd_enb_worker_mgr()
+{
+    stop();
+    pthread_key_delete(worker_key);
+}
+
+/********************/
+/*    Start/Stop    */
+/********************/
+void LTE_fdd_enb_worker_mgr::start(void)
+{
+    boost::mutex::scoped_lock  lock(start_mutex);
+    LTE_fdd_enb_cnfg_db       *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
+    int64                      n_workers;
+    uint32                     i;
+
+    if(!started)
+    {
+        started = true;
+        cnfg_db->get_param(LTE_FDD_ENB_PARAM_N_WORKERS, n_workers);
+        N_workers = n_workers;
+        for(i=0; i<N_workers; i++)
+        {
+            worker[i].mq_name = "worker_" + boost::lexical_cast<std::string>(i) + "_mq";
+            worker[i].N_drops = 0;
+            boost::interprocess::message_queue::remove(worker[i].mq_name.c_str());
+            worker[i].mq      = new boost::interprocess::message_queue(boost::interprocess::create_only,
+                                                                       worker[i].mq_name.c_str(),
+                                                                       LTE_FDD_ENB_WORKER_MSGQ_N_MSGS,
+                                                                       sizeof(LTE_FDD_ENB_MESSAGE_STRUCT *));
+            pthread_create(&worker[i].rx_thread, NULL, &receive_thread, &worker[i]);
+        }
+    }
+}
+void LTE_fdd_enb_worker_mgr::stop(void)
+{
+    boost::mutex::scoped_lock lock(start_mutex);
+    uint32                    i;
+
+    if(started)
+    {
+        started = false;
+        for(i=0; i<N_workers; i++)
+        {
+            LTE_fdd_enb_msgq::send(worker[i].mq,
+                                   LTE_FDD_ENB_MESSAGE_TYPE_KILL,
+                                   LTE_FDD_ENB_DEST_LAYER_ANY,
+                                   NULL,
+                                   0);
+            pthread_join(worker[i].rx_thread, NULL);
+
+            while(0 != worker[i].local_queue.size())
+            {
+                delete worker[i].local_queue.front();
+                worker[i].local_queue.pop_front();
+            }
+            while(0 != worker[i].ovfl_queue.size())
+            {
+                delete worker[i].ovfl_queue.front();
+                worker[i].ovfl_queue.pop_front();
+            }
+            delete worker[i].mq;
+            boost::interprocess::message_queue::remove(worker[i].mq_name.c_str());
+        }
+        N_workers = 0;
+    }
+}
+
+/****************************/
+/*    External Interface    */
+/****************************/
+void LTE_fdd_enb_worker_mgr::send(LTE_fdd_enb_user              *user,
+                                  LTE_FDD_ENB_MESSAGE_TYPE_ENUM  type,
+                                  LTE_FDD_ENB_DEST_LAYER_ENUM    dest_layer,
+                                  LTE_FDD_ENB_MESSAGE_UNION     *msg_content,
+                                  uint32                         msg_content_size)
+{
+    queue_msg(get_worker(user), user, type, dest_layer, msg_content, msg_content_size);
+}
+void LTE_fdd_enb_worker_mgr::send(uint16                         c_rnti,
+                                  LTE_FDD_ENB_MESSAGE_TYPE_ENUM  type,
+                                  LTE_FDD_ENB_DEST_LAYER_ENUM    dest_layer,
+                                  LTE_FDD_ENB_MESSAGE_UNION     *msg_content,
+                                  uint32                         msg_content_size)
+{
+    // For senders that must not touch the user, the receiving layer
+    // looks it up by C-RNTI on the worker that owns it
+    queue_msg(c_rnti % N_workers, NULL, type, dest_layer, msg_content, msg_content_size);
+}
+uint32 LTE_fdd_enb_worker_mgr::get_worker(LTE_fdd_enb_user *user)
+{
+    uint32 idx = 0;
+
+    // The C-RNTI follows a connection when its user is replaced by an
+    // already known one, so the connection's state stays on one worker
+    if(NULL != user &&
+       user->is_c_rnti_set())
+    {
+        idx = user->get_c_rnti() % N_workers;
+    }
+
+    return(idx);
+}
+
+/*****************/
+/*    Workers    */
+/*****************/
+void* LTE_fdd_enb_worker_mgr::receive_thread(void *inputs)
+{
+    LTE_FDD_ENB_WORKER_STRUCT  *wkr        = (LTE_FDD_ENB_WORKER_STRUCT *)inputs;
+    LTE_fdd_enb_worker_mgr     *worker_mgr = LTE_fdd_enb_worker_mgr::get_instance();
+    LTE_FDD_ENB_MESSAGE_STRUCT *msg        = NULL;
+    std::size_t                 rx_size;
+    uint32                      prio;
+    bool                        not_done   = true;
+
+    pthread_setspecific(worker_mgr->worker_key, wkr);
+
+    while(not_done)
+    {
+        // Wait for a message from MAC or the GW
+        wkr->mq->receive(&msg, sizeof(msg), rx_size, prio);
+
+        // Move waiting messages into the space that just opened up
+        wkr->ovfl_mutex.lock();
+        while(0 != wkr->ovfl_queue.size() &&
+              wkr->mq->try_send(&wkr->ovfl_queue.front(), sizeof(msg), 0))
+        {
+            wkr->ovfl_queue.pop_front();
+        }
+        wkr->ovfl_mutex.unlock();
+
+        if(sizeof(msg) == rx_size)
+        {
+            if(LTE_FDD_ENB_MESSAGE_TYPE_KILL == msg->type)
+            {
+                not_done = false;
+                delete msg;
+            }else{
+                worker_mgr->handle_msg(msg);
+
+                // Run everything it caused for this worker's users
+                while(0 != wkr->local_queue.size())
+                {
+                    msg = wkr->local_queue.front();
+                    wkr->local_queue.pop_front();
+                    worker_mgr->handle_msg(msg);
+                }
+            }
+        }else{
+            // FIXME: Use print_debug_msg
+            printf("ERROR %s Invalid message size received: %u\n",
+                   wkr->mq_name.c_str(),
+                   (uint32)rx_size);
+        }
+    }
+
+    return(NULL);
+}
+void LTE_fdd_enb_worker_mgr::queue_msg(uint32                         idx,
+                                       LTE_fdd_enb_user              *user,
+                                       LTE_FDD_ENB_MESSAGE_TYPE_ENUM  type,
+                                       LTE_FDD_ENB_DEST_LAYER_ENUM    dest_layer,
+                                       LTE_FDD_ENB_MESSAGE_UNION     *msg_content,
+                                       uint32                         msg_content_size)
+{
+    LTE_fdd_enb_interface      *interface = LTE_fdd_enb_interface::get_instance();
+    LTE_FDD_ENB_WORKER_STRUCT  *cur       = (LTE_FDD_ENB_WORKER_STRUCT *)pthread_getspecific(worker_key);
+    LTE_FDD_ENB_WORKER_STRUCT  *dst       = &worker[idx];
+    LTE_FDD_ENB_MESSAGE_STRUCT *msg;
+    bool                        dropped   = false;
+
+    msg             = new LTE_FDD_ENB_MESSAGE_STRUCT;
+    msg->type       = type;
+    msg->dest_layer = dest_layer;
+    msg->user       = user;
+    memcpy(&msg->msg, msg_content, msg_content_size);
+
+    // Messages for the worker's own users are handled as soon as the
+    // current one is done, without a trip through the message queue
+    if(cur == dst)
+    {
+        dst->local_queue.push_back(msg);
+    }else{
+        // MAC, the timers, and the HSS must not wait for a busy worker.
+        // Once anything is in the overflow queue new messages go behind
+        // it, so a user's messages stay in order.
+        dst->ovfl_mutex.lock();
+        if(0 == dst->ovfl_queue.size() &&
+           dst->mq->try_send(&msg, sizeof(msg), 0))
+        {
+            // Sent
+        }else if(LTE_FDD_ENB_WORKER_OVFL_N_MSGS > dst->ovfl_queue.size()){
+            dst->ovfl_queue.push_back(msg);
+        }else{
+            dst->N_drops++;
+            dropped = true;
+        }
+        dst->ovfl_mutex.unlock();
+
+        if(dropped)
+        {
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_IFACE,
+                                      __FILE__,
+                                      __LINE__,
+                                      "%s is full, dropped %s",
+                                      dst->mq_name.c_str(),
+                                      LTE_fdd_enb_message_type_text[type]);
+            delete msg;
+        }
+    }
+}
+void LTE_fdd_enb_worker_mgr::handle_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
+{
+    LTE_fdd_enb_interface    *interface    = LTE_fdd_enb_interface::get_instance();
+    LTE_fdd_enb_rlc          *rlc          = LTE_fdd_enb_rlc::get_instance();
+    LTE_fdd_enb_pdcp         *pdcp         = LTE_fdd_enb_pdcp::get_instance();
+    LTE_fdd_enb_rrc          *rrc          = LTE_fdd_enb_rrc::get_instance();
+    LTE_fdd_enb_mme          *mme          = LTE_fdd_enb_mme::get_instance();
+    LTE_fdd_enb_attach_storm *attach_storm = LTE_fdd_enb_attach_storm::get_instance();
+
+    switch(msg->type)
+    {
+    case LTE_FDD_ENB_MESSAGE_TYPE_RLC_PDU_READY:
+        rlc->handle_mac_msg(msg);
+        break;
+    case LTE_FDD_ENB_MESSAGE_TYPE_RLC_SDU_READY:
+        rlc->handle_pdcp_msg(msg);
+        break;
+    case LTE_FDD_ENB_MESSAGE_TYPE_PDCP_PDU_READY:
+        pdcp->handle_rlc_msg(msg);
+        break;
+    case LTE_FDD_ENB_MESSAGE_TYPE_PDCP_SDU_READY:
+        pdcp->handle_rrc_msg(msg);
+        break;
+    case LTE_FDD_ENB_MESSAGE_TYPE_PDCP_DATA_SDU_READY:
+        pdcp->handle_gw_msg(msg);
+        break;
+    case LTE_FDD_ENB_MESSAGE_TYPE_RRC_PDU_READY:
+        rrc->handle_pdcp_msg(msg);
+        break;
+    case LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY:
+    case LTE_FDD_ENB_MESSAGE_TYPE_RRC_CMD_READY:
+        // Simulated UEs have no radio, they are answered by the attach storm
+        if(msg->msg.rrc_nas_msg_ready.user->is_sim_ue())
+        {
+            attach_storm->handle_mme_msg(msg);
+        }else{
+            rrc->handle_mme_msg(msg);
+        }
+        break;
+    case LTE_FDD_ENB_MESSAGE_TYPE_MME_NAS_MSG_READY:
+    case LTE_FDD_ENB_MESSAGE_TYPE_MME_RRC_CMD_RESP:
+        mme->handle_rrc_msg(msg);
+        break;
+    case LTE_FDD_ENB_MESSAGE_TYPE_MME_AUTH_VEC_READY:
+        mme->handle_hss_msg(msg);
+        break;
+    default:
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_IFACE,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Received invalid worker message %s",
+                                  LTE_fdd_enb_message_type_text[msg->type]);
+        delete msg;
+        break;
+    }
+}
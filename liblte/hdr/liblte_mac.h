@@ -438,4 +438,132 @@ LIBLTE_ERROR_ENUM liblte_mac_pack_random_access_response_pdu(LIBLTE_MAC_RAR_STRU
 LIBLTE_ERROR_ENUM liblte_mac_unpack_random_access_response_pdu(LIBLTE_BIT_MSG_STRUCT *pdu,
                                                                LIBLTE_MAC_RAR_STRUCT *rar);
 
+/*******************************************************************************
+                              SCHEDULER DECLARATIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: Resource Allocation
+
+    Description: Tracks the PRBs of a subframe that are in use and
+                 allocates free PRBs using resource allocation types
+                 0, 1, and 2
+
+    Document Reference: 36.213 v10.3.0 Section 7.1.6
+
+    Notes: Type 1 allocations use a shift of 0 and type 2
+           allocations are localized
+*********************************************************************/
+// Defines
+#define LIBLTE_MAC_N_RB_MAX            110
+#define LIBLTE_MAC_PRB_MASK_N_WORDS    ((LIBLTE_MAC_N_RB_MAX + 31) / 32)
+// Enums
+typedef enum{
+    LIBLTE_MAC_RA_TYPE_0 = 0,
+    LIBLTE_MAC_RA_TYPE_1,
+    LIBLTE_MAC_RA_TYPE_2,
+    LIBLTE_MAC_RA_TYPE_N_ITEMS,
+}LIBLTE_MAC_RA_TYPE_ENUM;
+static const char liblte_mac_ra_type_text[LIBLTE_MAC_RA_TYPE_N_ITEMS][20] = {"Type 0", "Type 1", "Type 2"};
+// Structs
+typedef struct{
+    uint32 word[LIBLTE_MAC_PRB_MASK_N_WORDS];
+    uint32 N_rb;
+    uint32 P;
+}LIBLTE_MAC_PRB_MASK_STRUCT;
+typedef struct{
+    LIBLTE_MAC_RA_TYPE_ENUM ra_type;
+    uint32                  prb[LIBLTE_MAC_N_RB_MAX];
+    uint32                  N_prb;
+    uint32                  rbg_bitmap;
+    uint32                  subset;
+    uint32                  riv;
+}LIBLTE_MAC_RB_ALLOC_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_mac_prb_mask_init(LIBLTE_MAC_PRB_MASK_STRUCT *mask,
+                                           uint32                      N_rb);
+LIBLTE_ERROR_ENUM liblte_mac_prb_mask_set(LIBLTE_MAC_PRB_MASK_STRUCT *mask,
+                                          uint32                      prb_start,
+                                          uint32                      N_prb);
+LIBLTE_ERROR_ENUM liblte_mac_prb_mask_set_list(LIBLTE_MAC_PRB_MASK_STRUCT *mask,
+                                               uint32                     *prb,
+                                               uint32                      N_prb);
+bool liblte_mac_prb_mask_is_free(LIBLTE_MAC_PRB_MASK_STRUCT *mask,
+                                 uint32                     *prb,
+                                 uint32                      N_prb);
+uint32 liblte_mac_prb_mask_n_free(LIBLTE_MAC_PRB_MASK_STRUCT *mask);
+LIBLTE_ERROR_ENUM liblte_mac_alloc_prbs(LIBLTE_MAC_PRB_MASK_STRUCT *mask,
+                                        LIBLTE_MAC_RA_TYPE_ENUM     ra_type,
+                                        uint32                      N_prb_min,
+                                        uint32                      N_prb_max,
+                                        LIBLTE_MAC_RB_ALLOC_STRUCT *rb_alloc);
+
+/*********************************************************************
+    Name: Scheduler
+
+    Description: Picks the users served in a TTI using a round robin,
+                 maximum C/I, or proportional fair policy and
+                 allocates their PRBs from a PRB mask
+
+    Document Reference: N/A
+
+    Notes: Users with a HARQ retransmission pending are always
+           served first, followed by users owed data on a GBR
+           bearer.  The policy metric is scaled by qos_weight,
+           which callers derive from the priority of the bearers
+           with data.  The achievable rate of a user is
+           estimated from its wideband CQI using the spectral
+           efficiencies of 36.213 v10.3.0 table 7.2.3-1
+*********************************************************************/
+// Defines
+#define LIBLTE_MAC_SCHED_N_UE_MAX        256
+#define LIBLTE_MAC_SCHED_PF_WINDOW_TTIS  100
+// Enums
+typedef enum{
+    LIBLTE_MAC_SCHED_POLICY_ROUND_ROBIN = 0,
+    LIBLTE_MAC_SCHED_POLICY_MAX_CI,
+    LIBLTE_MAC_SCHED_POLICY_PROPORTIONAL_FAIR,
+    LIBLTE_MAC_SCHED_POLICY_N_ITEMS,
+}LIBLTE_MAC_SCHED_POLICY_ENUM;
+static const char liblte_mac_sched_policy_text[LIBLTE_MAC_SCHED_POLICY_N_ITEMS][20] = {"Round Robin",
+                                                                                       "Max C/I",
+                                                                                       "Proportional Fair"};
+// Structs
+typedef struct{
+    float  avg_tput;
+    float  qos_weight;
+    uint32 last_tti;
+    uint32 N_prb_min;
+    uint32 N_prb_max;
+    uint16 rnti;
+    uint8  cqi;
+    bool   retx;
+    bool   gbr;
+}LIBLTE_MAC_SCHED_UE_STRUCT;
+typedef struct{
+    LIBLTE_MAC_RB_ALLOC_STRUCT rb_alloc;
+    uint32                     ue_idx;
+    uint32                     N_bits;
+}LIBLTE_MAC_SCHED_GRANT_STRUCT;
+typedef struct{
+    LIBLTE_MAC_SCHED_POLICY_ENUM policy;
+    LIBLTE_MAC_RA_TYPE_ENUM      ra_type;
+    float                        pf_alpha;
+    uint32                       tti;
+}LIBLTE_MAC_SCHED_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_mac_sched_init(LIBLTE_MAC_SCHED_STRUCT      *sched,
+                                        LIBLTE_MAC_SCHED_POLICY_ENUM  policy,
+                                        LIBLTE_MAC_RA_TYPE_ENUM       ra_type);
+LIBLTE_ERROR_ENUM liblte_mac_sched_ue_init(LIBLTE_MAC_SCHED_UE_STRUCT *ue,
+                                           uint16                      rnti);
+uint32 liblte_mac_sched_bits_per_prb(uint8 cqi);
+LIBLTE_ERROR_ENUM liblte_mac_sched_run(LIBLTE_MAC_SCHED_STRUCT       *sched,
+                                       LIBLTE_MAC_SCHED_UE_STRUCT    *ue,
+                                       uint32                         N_ue,
+                                       LIBLTE_MAC_PRB_MASK_STRUCT    *mask,
+                                       uint32                         N_grant_max,
+                                       LIBLTE_MAC_SCHED_GRANT_STRUCT *grant,
+                                       uint32                        *N_grant);
+
 #endif /* __LIBLTE_MAC_H__ */
@@ -3976,4 +3976,49 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_pdn_disconnect_request_msg(LIBLTE_MME_PDN_DISC
 LIBLTE_ERROR_ENUM liblte_mme_unpack_pdn_disconnect_request_msg(LIBLTE_BYTE_MSG_STRUCT                       *msg,
                                                                LIBLTE_MME_PDN_DISCONNECT_REQUEST_MSG_STRUCT *pdn_discon_req);
 
+/*******************************************************************************
+                              MESSAGE BUILDER DECLARATIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: NAS Message Builder
+
+    Description: Serializes a NAS message directly into the output
+                 buffer.  IEs are written with the IE pack functions
+                 on the builder's msg_ptr, and an ESM message is
+                 written in place inside its ESM message container
+                 rather than packed separately and copied in.
+
+    Document Reference: 24.301 v10.2.0 Sections 9.1 and 9.9.3.15
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+typedef struct{
+    LIBLTE_BYTE_MSG_STRUCT *msg;
+    uint8                  *msg_ptr;
+    uint8                  *container_ptr;
+    uint8                   sec_hdr_type;
+}LIBLTE_MME_NAS_BUILDER_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_mme_nas_builder_start(LIBLTE_BYTE_MSG_STRUCT        *msg,
+                                               uint8                          sec_hdr_type,
+                                               uint32                         count,
+                                               LIBLTE_MME_NAS_BUILDER_STRUCT *builder);
+LIBLTE_ERROR_ENUM liblte_mme_nas_builder_add_emm_header(LIBLTE_MME_NAS_BUILDER_STRUCT *builder,
+                                                        uint8                          msg_type);
+LIBLTE_ERROR_ENUM liblte_mme_nas_builder_add_esm_header(LIBLTE_MME_NAS_BUILDER_STRUCT *builder,
+                                                        uint8                          eps_bearer_id,
+                                                        uint8                          proc_transaction_id,
+                                                        uint8                          msg_type);
+LIBLTE_ERROR_ENUM liblte_mme_nas_builder_add_iei(LIBLTE_MME_NAS_BUILDER_STRUCT *builder,
+                                                 uint8                          iei);
+LIBLTE_ERROR_ENUM liblte_mme_nas_builder_open_esm_msg_container(LIBLTE_MME_NAS_BUILDER_STRUCT *builder);
+LIBLTE_ERROR_ENUM liblte_mme_nas_builder_close_esm_msg_container(LIBLTE_MME_NAS_BUILDER_STRUCT *builder);
+LIBLTE_ERROR_ENUM liblte_mme_nas_builder_finish(LIBLTE_MME_NAS_BUILDER_STRUCT *builder,
+                                                uint8                         *key_256,
+                                                uint32                         count,
+                                                uint8                          direction,
+                                                uint8                          rb_id);
+
 #endif /* __LIBLTE_MME_H__ */
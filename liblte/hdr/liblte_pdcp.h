@@ -40,6 +40,7 @@
 *******************************************************************************/
 
 #include "liblte_common.h"
+#include "liblte_security.h"
 
 /*******************************************************************************
                               DEFINES
@@ -147,6 +148,13 @@ LIBLTE_ERROR_ENUM liblte_pdcp_pack_control_pdu(LIBLTE_PDCP_CONTROL_PDU_STRUCT *c
                                                uint8                           direction,
                                                uint8                           rb_id,
                                                LIBLTE_BYTE_MSG_STRUCT         *pdu);
+LIBLTE_ERROR_ENUM liblte_pdcp_pack_control_pdu(LIBLTE_PDCP_CONTROL_PDU_STRUCT       *contents,
+                                               LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT *ctx,
+                                               LIBLTE_BYTE_MSG_STRUCT               *pdu);
+LIBLTE_ERROR_ENUM liblte_pdcp_pack_control_pdu(LIBLTE_PDCP_CONTROL_PDU_STRUCT       *contents,
+                                               LIBLTE_BIT_MSG_STRUCT                *data,
+                                               LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT *ctx,
+                                               LIBLTE_BYTE_MSG_STRUCT               *pdu);
 LIBLTE_ERROR_ENUM liblte_pdcp_unpack_control_pdu(LIBLTE_BYTE_MSG_STRUCT         *pdu,
                                                  LIBLTE_PDCP_CONTROL_PDU_STRUCT *contents);
 
@@ -190,8 +198,17 @@ LIBLTE_ERROR_ENUM liblte_pdcp_unpack_data_pdu_with_long_sn(LIBLTE_BYTE_MSG_STRUC
 // Defines
 // Enums
 // Structs
+typedef struct{
+    LIBLTE_BYTE_MSG_STRUCT feedback;
+}LIBLTE_PDCP_ROHC_FEEDBACK_PDU_STRUCT;
 // Functions
-// FIXME
+LIBLTE_ERROR_ENUM liblte_pdcp_pack_rohc_feedback_pdu(LIBLTE_PDCP_ROHC_FEEDBACK_PDU_STRUCT *contents,
+                                                     LIBLTE_BYTE_MSG_STRUCT               *pdu);
+LIBLTE_ERROR_ENUM liblte_pdcp_pack_rohc_feedback_pdu(LIBLTE_PDCP_ROHC_FEEDBACK_PDU_STRUCT *contents,
+                                                     LIBLTE_BYTE_MSG_STRUCT               *feedback,
+                                                     LIBLTE_BYTE_MSG_STRUCT               *pdu);
+LIBLTE_ERROR_ENUM liblte_pdcp_unpack_rohc_feedback_pdu(LIBLTE_BYTE_MSG_STRUCT               *pdu,
+                                                       LIBLTE_PDCP_ROHC_FEEDBACK_PDU_STRUCT *contents);
 
 /*********************************************************************
     PDU Type: PDCP Control PDU for PDCP status report
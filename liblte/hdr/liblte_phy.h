@@ -109,13 +109,20 @@
 // FIXME: Add Extended CP
 
 // N_ant
-#define LIBLTE_PHY_N_ANT_MAX 4
+#define LIBLTE_PHY_N_ANT_MAX    4
+#define LIBLTE_PHY_N_RX_ANT_MAX 4
+
+// DL channel estimation
+#define LIBLTE_PHY_DL_CE_N_CRS_SYMBS_MAX 5
+#define LIBLTE_PHY_DL_CE_WIENER_N_TAPS   4
 
 // Symbol, CP, Slot, Subframe, and Frame timing
 // Generic
 #define LIBLTE_PHY_SFN_MAX           1023
 #define LIBLTE_PHY_N_SLOTS_PER_SUBFR 2
 #define LIBLTE_PHY_N_SUBFR_PER_FRAME 10
+#define LIBLTE_PHY_N_SLOTS_PER_FRAME (LIBLTE_PHY_N_SLOTS_PER_SUBFR*LIBLTE_PHY_N_SUBFR_PER_FRAME)
+#define LIBLTE_PHY_N_SYMB_PER_SLOT_UL 7
 // 20MHz and 15MHz bandwidths
 #define LIBLTE_PHY_N_SAMPS_PER_SYMB_30_72MHZ  2048
 #define LIBLTE_PHY_N_SAMPS_CP_L_0_30_72MHZ    160
@@ -168,7 +175,8 @@ static const char liblte_phy_fs_text[LIBLTE_PHY_FS_N_ITEMS][20] = {"1.92", "3.84
 
 typedef enum{
     LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY = 0,
-    LIBLTE_PHY_PRE_CODER_TYPE_SPATIAL_MULTIPLEXING,
+    LIBLTE_PHY_PRE_CODER_TYPE_SPATIAL_MULTIPLEXING, // Closed loop, transmission mode 4
+    LIBLTE_PHY_PRE_CODER_TYPE_LARGE_DELAY_CDD,      // Open loop, transmission mode 3
 }LIBLTE_PHY_PRE_CODER_TYPE_ENUM;
 
 typedef enum{
@@ -178,10 +186,16 @@ typedef enum{
     LIBLTE_PHY_MODULATION_TYPE_64QAM,
 }LIBLTE_PHY_MODULATION_TYPE_ENUM;
 
+typedef enum{
+    LIBLTE_PHY_DL_CE_INTERP_LINEAR = 0,
+    LIBLTE_PHY_DL_CE_INTERP_WIENER,
+}LIBLTE_PHY_DL_CE_INTERP_ENUM;
+
 typedef enum{
     LIBLTE_PHY_CHAN_TYPE_DLSCH = 0,
     LIBLTE_PHY_CHAN_TYPE_PCH,
     LIBLTE_PHY_CHAN_TYPE_ULSCH,
+    LIBLTE_PHY_CHAN_TYPE_PUCCH,
 }LIBLTE_PHY_CHAN_TYPE_ENUM;
 
 typedef struct{
@@ -190,6 +204,19 @@ typedef struct{
     float rx_symb_im[16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
     float rx_ce_re[LIBLTE_PHY_N_ANT_MAX][16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
     float rx_ce_im[LIBLTE_PHY_N_ANT_MAX][16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float rx_noise_var[LIBLTE_PHY_N_RB_DL_20MHZ];
+
+    // Receive channel estimate state (rx_ce_re/im are filled per RB on demand)
+    float  rx_ce_rs_re[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_DL_CE_N_CRS_SYMBS_MAX][LIBLTE_PHY_N_RB_DL_20MHZ*2];
+    float  rx_ce_rs_im[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_DL_CE_N_CRS_SYMBS_MAX][LIBLTE_PHY_N_RB_DL_20MHZ*2];
+    float  rx_ce_freq_re[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_DL_CE_N_CRS_SYMBS_MAX][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float  rx_ce_freq_im[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_DL_CE_N_CRS_SYMBS_MAX][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float  rx_ce_wiener_w[6][LIBLTE_PHY_DL_CE_WIENER_N_TAPS];
+    uint32 rx_ce_v_shift;
+    uint16 rx_ce_valid[LIBLTE_PHY_N_RB_DL_20MHZ];
+    uint8  rx_ce_N_ant;
+    bool   rx_ce_freq_valid[LIBLTE_PHY_N_RB_DL_20MHZ];
+    bool   rx_ce_wiener;
 
     // Transmit
     float tx_symb_re[LIBLTE_PHY_N_ANT_MAX][16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
@@ -212,8 +239,28 @@ typedef struct{
 *********************************************************************/
 // Defines
 #define LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN 0xFFFF
+#define LIBLTE_PHY_PDCCH_N_SYMBS_MAX      4
+#define LIBLTE_PHY_PDCCH_N_REG_MAX        800
+#define LIBLTE_PHY_PDCCH_N_CCE_MAX        (LIBLTE_PHY_PDCCH_N_REG_MAX/9)
+#define LIBLTE_PHY_PDCCH_N_CAND_BATCH     8
+#define LIBLTE_PHY_DCI_N_BITS_MAX         100
+#define LIBLTE_PHY_VDB_N_STATES_MAX       64
+#define LIBLTE_PHY_VDB_N_STEPS_MAX        (LIBLTE_PHY_DCI_N_BITS_MAX+16)
+#define LIBLTE_PHY_PUCCH_N_CQI_BITS_MAX   13
+#define LIBLTE_PHY_PUCCH_N_CQI_CW         (1<<LIBLTE_PHY_PUCCH_N_CQI_BITS_MAX)
+#define LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS 20
 // Enums
 // Structs
+typedef struct{
+    uint32 N_id_cell;
+    uint32 N_rb_dl;
+    uint32 N_reg_phich;
+    uint32 N_reg;
+    uint32 N_cce;
+    uint16 re_idx[LIBLTE_PHY_PDCCH_N_REG_MAX*4];
+    uint8  N_ant;
+    bool   valid;
+}LIBLTE_PHY_PDCCH_REG_MAP_STRUCT;
 typedef struct{
     // PUSCH
     fftwf_complex *transform_precoding_in;
@@ -256,6 +303,16 @@ typedef struct{
     float  dmrs_1_im[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX][LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
     uint32 dmrs_c[1120];
 
+    // PUCCH
+    float  pucch_r_re[LIBLTE_PHY_N_SLOTS_PER_FRAME][LIBLTE_PHY_N_SC_RB_UL][LIBLTE_PHY_N_SC_RB_UL];
+    float  pucch_r_im[LIBLTE_PHY_N_SLOTS_PER_FRAME][LIBLTE_PHY_N_SC_RB_UL][LIBLTE_PHY_N_SC_RB_UL];
+    float  pucch_cqi_cw[LIBLTE_PHY_PUCCH_N_CQI_CW][LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS];
+    uint32 pucch_n_cs_cell[LIBLTE_PHY_N_SLOTS_PER_FRAME][LIBLTE_PHY_N_SYMB_PER_SLOT_UL];
+    uint32 pucch_c[LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS];
+    uint32 pucch_delta_shift;
+    uint32 pucch_N_rb_2;
+    uint32 pucch_N_cs_1;
+
     // PRACH
     fftwf_complex *prach_dft_in;
     fftwf_complex *prach_dft_out;
@@ -286,21 +343,24 @@ typedef struct{
     bool           prach_hs_flag;
 
     // PDSCH
-    float  pdsch_y_est_re[5000];
-    float  pdsch_y_est_im[5000];
-    float  pdsch_c_est_re[LIBLTE_PHY_N_ANT_MAX][5000];
-    float  pdsch_c_est_im[LIBLTE_PHY_N_ANT_MAX][5000];
+    float  pdsch_y_est_re[LIBLTE_PHY_N_RX_ANT_MAX][5000];
+    float  pdsch_y_est_im[LIBLTE_PHY_N_RX_ANT_MAX][5000];
+    float  pdsch_c_est_re[LIBLTE_PHY_N_RX_ANT_MAX][LIBLTE_PHY_N_ANT_MAX][5000];
+    float  pdsch_c_est_im[LIBLTE_PHY_N_RX_ANT_MAX][LIBLTE_PHY_N_ANT_MAX][5000];
+    float  pdsch_g_re[LIBLTE_PHY_N_RX_ANT_MAX][LIBLTE_PHY_N_ANT_MAX][5000];
+    float  pdsch_g_im[LIBLTE_PHY_N_RX_ANT_MAX][LIBLTE_PHY_N_ANT_MAX][5000];
+    float  pdsch_noise_var[5000];
     float  pdsch_y_re[LIBLTE_PHY_N_ANT_MAX][5000];
     float  pdsch_y_im[LIBLTE_PHY_N_ANT_MAX][5000];
-    float  pdsch_x_re[10000];
-    float  pdsch_x_im[10000];
-    float  pdsch_d_re[10000];
-    float  pdsch_d_im[10000];
-    float  pdsch_descramb_bits[10000];
-    uint32 pdsch_c[10000];
-    uint8  pdsch_encode_bits[10000];
-    uint8  pdsch_scramb_bits[10000];
-    int8   pdsch_soft_bits[10000];
+    float  pdsch_x_re[LIBLTE_PHY_N_ANT_MAX*5000];
+    float  pdsch_x_im[LIBLTE_PHY_N_ANT_MAX*5000];
+    float  pdsch_d_re[LIBLTE_PHY_N_ANT_MAX*5000];
+    float  pdsch_d_im[LIBLTE_PHY_N_ANT_MAX*5000];
+    float  pdsch_descramb_bits[LIBLTE_PHY_N_ANT_MAX*10000];
+    uint32 pdsch_c[LIBLTE_PHY_N_ANT_MAX*10000];
+    uint8  pdsch_encode_bits[LIBLTE_PHY_N_ANT_MAX*10000];
+    uint8  pdsch_scramb_bits[LIBLTE_PHY_N_ANT_MAX*10000];
+    int8   pdsch_soft_bits[LIBLTE_PHY_N_ANT_MAX*10000];
 
     // BCH
     float  bch_y_est_re[240];
@@ -324,51 +384,36 @@ typedef struct{
     int8   bch_soft_bits[480];
 
     // PDCCH
-    // FIXME: Sizes
-    float  pdcch_reg_y_est_re[550][4];
-    float  pdcch_reg_y_est_im[550][4];
-    float  pdcch_reg_c_est_re[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_reg_c_est_im[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_shift_y_est_re[550][4];
-    float  pdcch_shift_y_est_im[550][4];
-    float  pdcch_shift_c_est_re[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_shift_c_est_im[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_perm_y_est_re[550][4];
-    float  pdcch_perm_y_est_im[550][4];
-    float  pdcch_perm_c_est_re[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_perm_c_est_im[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_cce_y_est_re[50][576];
-    float  pdcch_cce_y_est_im[50][576];
-    float  pdcch_cce_c_est_re[LIBLTE_PHY_N_ANT_MAX][50][576];
-    float  pdcch_cce_c_est_im[LIBLTE_PHY_N_ANT_MAX][50][576];
+    LIBLTE_PHY_PDCCH_REG_MAP_STRUCT pdcch_reg_map[LIBLTE_PHY_PDCCH_N_SYMBS_MAX];
+    float  pdcch_cce_y_est_re[LIBLTE_PHY_PDCCH_N_CCE_MAX][36];
+    float  pdcch_cce_y_est_im[LIBLTE_PHY_PDCCH_N_CCE_MAX][36];
+    float  pdcch_cce_c_est_re[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_CCE_MAX][36];
+    float  pdcch_cce_c_est_im[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_CCE_MAX][36];
     float  pdcch_y_est_re[576];
     float  pdcch_y_est_im[576];
     float  pdcch_c_est_re[LIBLTE_PHY_N_ANT_MAX][576];
     float  pdcch_c_est_im[LIBLTE_PHY_N_ANT_MAX][576];
     float  pdcch_y_re[LIBLTE_PHY_N_ANT_MAX][576];
     float  pdcch_y_im[LIBLTE_PHY_N_ANT_MAX][576];
-    float  pdcch_cce_re[LIBLTE_PHY_N_ANT_MAX][50][576];
-    float  pdcch_cce_im[LIBLTE_PHY_N_ANT_MAX][50][576];
-    float  pdcch_reg_re[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_reg_im[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_perm_re[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_perm_im[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_shift_re[LIBLTE_PHY_N_ANT_MAX][550][4];
-    float  pdcch_shift_im[LIBLTE_PHY_N_ANT_MAX][550][4];
+    float  pdcch_cce_re[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_CCE_MAX][36];
+    float  pdcch_cce_im[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_CCE_MAX][36];
     float  pdcch_x_re[576];
     float  pdcch_x_im[576];
     float  pdcch_d_re[576];
     float  pdcch_d_im[576];
     float  pdcch_descramb_bits[576];
-    uint32 pdcch_c[1152];
-    uint32 pdcch_permute_map[550][550];
-    uint16 pdcch_reg_vec[550];
-    uint16 pdcch_reg_perm_vec[550];
+    float  pdcch_cce_y_energy[LIBLTE_PHY_PDCCH_N_CCE_MAX];
+    float  pdcch_cce_c_energy[LIBLTE_PHY_PDCCH_N_CCE_MAX];
+    float  pdcch_cand_bits[LIBLTE_PHY_PDCCH_N_CAND_BATCH][576];
+    uint32 pdcch_c[LIBLTE_PHY_PDCCH_N_CCE_MAX*72];
+    uint16 pdcch_reg_re_idx[LIBLTE_PHY_PDCCH_N_REG_MAX*4];
     uint8  pdcch_dci[100]; // FIXME: This is a guess at worst case
+    uint8  pdcch_cand_dci_1a[LIBLTE_PHY_PDCCH_N_CAND_BATCH][LIBLTE_PHY_DCI_N_BITS_MAX];
+    uint8  pdcch_cand_dci_1c[LIBLTE_PHY_PDCCH_N_CAND_BATCH][LIBLTE_PHY_DCI_N_BITS_MAX];
     uint8  pdcch_encode_bits[576];
     uint8  pdcch_scramb_bits[576];
     int8   pdcch_soft_bits[576];
-    bool   pdcch_cce_used[50];
+    bool   pdcch_cce_used[LIBLTE_PHY_PDCCH_N_CCE_MAX];
 
     // PHICH
     uint32 N_group_phich;
@@ -379,8 +424,7 @@ typedef struct{
     float crs_im[14][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
     float dl_ce_crs_re[16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
     float dl_ce_crs_im[16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float dl_ce_mag[5][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float dl_ce_ang[5][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    LIBLTE_PHY_DL_CE_INTERP_ENUM dl_ce_interp;
 
     // PSS
     float pss_mod_re_n1[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
@@ -429,53 +473,57 @@ typedef struct{
     fftwf_plan     samps_to_symbs_ul_plan;
 
     // Viterbi decode
-    float vd_path_metric[128][2048];
+    float vd_path_metric[128][6160];
     float vd_br_metric[128][2];
     float vd_p_metric[128][2];
     float vd_br_weight[128][2];
-    float vd_w_metric[128][2048];
-    float vd_tb_state[2048];
-    float vd_tb_weight[2048];
+    float vd_w_metric[128][6160];
+    float vd_tb_state[6160];
+    float vd_tb_weight[6160];
     uint8 vd_st_output[128][2][3];
 
-    // Turbo encode
-    uint8 te_z[6144];
-    uint8 te_fb1[6144];
+    // Viterbi decode batch
+    float vdb_d_bits[LIBLTE_PHY_PDCCH_N_CAND_BATCH][3*LIBLTE_PHY_VDB_N_STEPS_MAX];
+    float vdb_path_metric[LIBLTE_PHY_VDB_N_STEPS_MAX+1][LIBLTE_PHY_VDB_N_STATES_MAX][LIBLTE_PHY_PDCCH_N_CAND_BATCH];
+    float vdb_br_metric[8][LIBLTE_PHY_PDCCH_N_CAND_BATCH];
+    float vdb_w_metric[LIBLTE_PHY_PDCCH_N_CAND_BATCH];
+    uint8 vdb_tb_state[LIBLTE_PHY_VDB_N_STEPS_MAX+1];
+    uint8 vdb_st_output[LIBLTE_PHY_VDB_N_STATES_MAX][2];
+    uint8 vdb_c_bits[LIBLTE_PHY_PDCCH_N_CAND_BATCH][LIBLTE_PHY_VDB_N_STEPS_MAX];
+
+    // Turbo encode (bit serial)
+    uint8 te_z[6148];
+    uint8 te_fb1[6148];
     uint8 te_c_prime[6144];
-    uint8 te_z_prime[6144];
-    uint8 te_x_prime[6144];
+    uint8 te_z_prime[6148];
+    uint8 te_x_prime[6148];
 
     // Turbo decode
-    int8 td_vitdec_in[18432];
-    int8 td_in_int[6144];
-    int8 td_in_calc_1[6144];
-    int8 td_in_calc_2[6144];
-    int8 td_in_calc_3[6144];
-    int8 td_in_int_1[6144];
-    int8 td_int_calc_1[6144];
-    int8 td_int_calc_2[6144];
-    int8 td_in_act_1[6144];
-    int8 td_fb_1[6144];
-    int8 td_int_act_1[6144];
-    int8 td_int_act_2[6144];
-    int8 td_fb_int_1[6144];
-    int8 td_fb_int_2[6144];
+    float td_sys[6144];
+    float td_sys_int[6144];
+    float td_par_1[6144];
+    float td_par_2[6144];
+    float td_apriori[6144];
+    float td_extrinsic[6144];
+    float td_llr[6144];
+    float td_beta[6148][8];
+    uint8 td_hard[6144];
 
     // Rate Match Turbo
-    uint8 rmt_tmp[6144];
-    uint8 rmt_sb_mat[32][192];
-    uint8 rmt_sb_perm_mat[32][192];
-    uint8 rmt_y[6144];
-    uint8 rmt_w[18432];
+    uint8 rmt_tmp[6176];
+    uint8 rmt_sb_mat[193][32];
+    uint8 rmt_sb_perm_mat[193][32];
+    uint8 rmt_y[6176];
+    uint8 rmt_w[18528];
 
     // Rate Unmatch Turbo
-    float rut_tmp[6144];
-    float rut_sb_mat[32][192];
-    float rut_sb_perm_mat[32][192];
-    float rut_y[6144];
-    float rut_w_dum[18432];
-    float rut_w[18432];
-    float rut_v[3][6144];
+    float rut_tmp[6176];
+    float rut_sb_mat[193][32];
+    float rut_sb_perm_mat[193][32];
+    float rut_y[6176];
+    float rut_w_dum[18528];
+    float rut_w[18528];
+    float rut_v[3][6176];
 
     // Rate Match Conv
     uint8 rmc_tmp[1024];
@@ -496,7 +544,7 @@ typedef struct{
     float  ulsch_y_idx[92160];
     float  ulsch_y_mat[92160];
     float  ulsch_rx_d_bits[75376];
-    float  ulsch_rx_e_bits[5][18432];
+    float  ulsch_rx_e_bits[5][28800];
     float  ulsch_rx_f_bits[92160];
     float  ulsch_rx_g_bits[92160];
     uint32 ulsch_N_c_bits[5];
@@ -504,25 +552,26 @@ typedef struct{
     uint8  ulsch_b_bits[30720];
     uint8  ulsch_c_bits[5][6144];
     uint8  ulsch_tx_d_bits[75376];
-    uint8  ulsch_tx_e_bits[5][18432];
+    uint8  ulsch_tx_e_bits[5][28800];
     uint8  ulsch_tx_f_bits[92160];
     uint8  ulsch_tx_g_bits[92160];
 
     // DLSCH
     // FIXME: Sizes
     float  dlsch_rx_d_bits[75376];
-    float  dlsch_rx_e_bits[5][18432];
+    float  dlsch_rx_e_bits[5][LIBLTE_PHY_N_ANT_MAX*10000];
     uint32 dlsch_N_c_bits[5];
     uint32 dlsch_N_e_bits[5];
     uint8  dlsch_b_bits[30720];
     uint8  dlsch_c_bits[5][6144];
     uint8  dlsch_tx_d_bits[75376];
-    uint8  dlsch_tx_e_bits[5][18432];
+    uint8  dlsch_tx_e_bits[5][LIBLTE_PHY_N_ANT_MAX*10000];
 
     // DCI
     float dci_rx_d_bits[576];
     uint8 dci_tx_d_bits[576];
     uint8 dci_c_bits[192];
+    uint8 dci_calc_p_bits[LIBLTE_PHY_PDCCH_N_CAND_BATCH][16];
 
     // Generic
     float  rx_symb_re[LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
@@ -560,7 +609,10 @@ LIBLTE_ERROR_ENUM liblte_phy_ul_init(LIBLTE_PHY_STRUCT *phy_struct,
                                      bool               group_hopping_enabled,
                                      bool               sequence_hopping_enabled,
                                      uint8              cyclic_shift,
-                                     uint8              cyclic_shift_dci);
+                                     uint8              cyclic_shift_dci,
+                                     uint32             pucch_delta_shift,
+                                     uint32             pucch_n_rb_cqi,
+                                     uint32             pucch_n_cs_an);
 
 /*********************************************************************
     Name: liblte_phy_cleanup
@@ -590,6 +642,95 @@ LIBLTE_ERROR_ENUM liblte_phy_ul_cleanup(LIBLTE_PHY_STRUCT *phy_struct);
 LIBLTE_ERROR_ENUM liblte_phy_update_n_rb_dl(LIBLTE_PHY_STRUCT *phy_struct,
                                             uint32             N_rb_dl);
 
+/*********************************************************************
+    Name: liblte_phy_soft_buffer_pool_init
+
+    Description: Allocates a pool of HARQ soft buffer memory.
+
+    Document Reference: N/A
+
+    Notes: The pool is split into fixed size chunks of int8 LLRs
+           which are handed out to soft buffers by
+           liblte_phy_soft_buffer_alloc.  The pool is not thread
+           safe, callers sharing a pool must serialize access.
+*********************************************************************/
+// Defines
+#define LIBLTE_PHY_SOFT_BUFFER_CHUNK_LEN    2048
+#define LIBLTE_PHY_SOFT_BUFFER_N_CB_MAX     5
+#define LIBLTE_PHY_SOFT_BUFFER_N_CHUNKS_MAX 46 // 5 code blocks of 3*(6144+4) LLRs
+// Enums
+// Structs
+typedef struct{
+    int8   *llr;
+    uint32 *free_chunk;
+    uint32  N_chunks;
+    uint32  N_free_chunks;
+}LIBLTE_PHY_SOFT_BUFFER_POOL_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_soft_buffer_pool_init(LIBLTE_PHY_SOFT_BUFFER_POOL_STRUCT **pool,
+                                                   uint32                               N_bytes);
+
+/*********************************************************************
+    Name: liblte_phy_soft_buffer_pool_cleanup
+
+    Description: Frees a pool of HARQ soft buffer memory.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_soft_buffer_pool_cleanup(LIBLTE_PHY_SOFT_BUFFER_POOL_STRUCT *pool);
+
+/*********************************************************************
+    Name: liblte_phy_soft_buffer_alloc
+
+    Description: Allocates a HARQ soft buffer for a transport block
+                 from a soft buffer pool.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 sections 5.1.2 and
+                        5.1.4.1
+
+    Notes: The soft buffer holds the circular buffer of every code
+           block of the transport block as int8 LLRs.  Returns
+           LIBLTE_ERROR_INVALID_INPUTS when the pool does not have
+           enough free chunks, in which case the transport block
+           should be decoded without combining.
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+typedef struct{
+    LIBLTE_PHY_SOFT_BUFFER_POOL_STRUCT *pool;
+    float                               scale[LIBLTE_PHY_SOFT_BUFFER_N_CB_MAX];
+    uint32                              cb_offset[LIBLTE_PHY_SOFT_BUFFER_N_CB_MAX];
+    uint32                              N_llr[LIBLTE_PHY_SOFT_BUFFER_N_CB_MAX];
+    uint32                              chunk[LIBLTE_PHY_SOFT_BUFFER_N_CHUNKS_MAX];
+    uint32                              N_chunks;
+    uint32                              N_codeblocks;
+    uint32                              tbs;
+    uint32                              N_tx;
+}LIBLTE_PHY_SOFT_BUFFER_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_soft_buffer_alloc(LIBLTE_PHY_SOFT_BUFFER_POOL_STRUCT *pool,
+                                               uint32                              tbs,
+                                               LIBLTE_PHY_SOFT_BUFFER_STRUCT      *soft_buffer);
+
+/*********************************************************************
+    Name: liblte_phy_soft_buffer_free
+
+    Description: Returns the memory of a HARQ soft buffer to its
+                 soft buffer pool.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_soft_buffer_free(LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer);
+
 /*********************************************************************
     Name: liblte_phy_pusch_channel_encode
 
@@ -630,7 +771,10 @@ typedef struct{
     uint32                          prb[LIBLTE_PHY_N_SLOTS_PER_SUBFR][LIBLTE_PHY_N_RB_DL_MAX];
     uint32                          N_codewords;
     uint32                          N_layers;
+    uint32                          codebook_idx;
     uint32                          tx_mode;
+    uint32                          harq_process;
+    uint32                          n_cce;
     uint16                          rnti;
     uint8                           mcs;
     uint8                           tpc;
@@ -663,6 +807,93 @@ LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_decode(LIBLTE_PHY_STRUCT            *
                                                   uint8                        *out_bits,
                                                   uint32                       *N_out_bits);
 
+/*********************************************************************
+    Name: liblte_phy_pusch_channel_decode_harq
+
+    Description: Demodulates and decodes the Physical Uplink Shared
+                 Channel, combining the received LLRs with those
+                 of earlier transmissions of the transport block
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3
+                        3GPP TS 36.212 v10.1.0 section 5.1.4.1.2
+
+    Notes: soft_buffer must have been allocated for alloc->tbs, a
+           NULL soft_buffer decodes without combining
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_decode_harq(LIBLTE_PHY_STRUCT             *phy_struct,
+                                                       LIBLTE_PHY_SUBFRAME_STRUCT    *subframe,
+                                                       LIBLTE_PHY_ALLOCATION_STRUCT  *alloc,
+                                                       uint32                         N_id_cell,
+                                                       uint8                          N_ant,
+                                                       LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer,
+                                                       uint8                         *out_bits,
+                                                       uint32                        *N_out_bits);
+
+/*********************************************************************
+    Name: liblte_phy_pucch_channel_encode
+
+    Description: Encodes and modulates the Physical Uplink Control
+                 Channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4
+                        3GPP TS 36.212 v10.1.0 section 5.2.3.3
+
+    Notes: Formats 1, 1a, 1b, and 2 with normal cyclic prefix
+*********************************************************************/
+// Defines
+#define LIBLTE_PHY_PUCCH_N_BITS_MAX LIBLTE_PHY_PUCCH_N_CQI_BITS_MAX
+// Enums
+typedef enum{
+    LIBLTE_PHY_PUCCH_FORMAT_1 = 0,
+    LIBLTE_PHY_PUCCH_FORMAT_1A,
+    LIBLTE_PHY_PUCCH_FORMAT_1B,
+    LIBLTE_PHY_PUCCH_FORMAT_2,
+    LIBLTE_PHY_PUCCH_FORMAT_N_ITEMS,
+}LIBLTE_PHY_PUCCH_FORMAT_ENUM;
+static const char liblte_phy_pucch_format_text[LIBLTE_PHY_PUCCH_FORMAT_N_ITEMS][20] = {"1", "1a", "1b", "2"};
+// Structs
+typedef struct{
+    LIBLTE_PHY_PUCCH_FORMAT_ENUM format;
+    float                        detect_metric;
+    uint32                       n_pucch;
+    uint32                       N_bits;
+    uint16                       rnti;
+    uint8                        bits[LIBLTE_PHY_PUCCH_N_BITS_MAX];
+}LIBLTE_PHY_PUCCH_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_pucch_channel_encode(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                  LIBLTE_PHY_PUCCH_STRUCT    *pucch,
+                                                  uint32                      N_id_cell,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT *subframe);
+
+/*********************************************************************
+    Name: liblte_phy_pucch_channel_decode
+
+    Description: Demodulates and decodes the Physical Uplink Control
+                 Channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4
+                        3GPP TS 36.212 v10.1.0 section 5.2.3.3
+
+    Notes: format, n_pucch, N_bits (format 2), and rnti (format 2)
+           must be set by the caller.  Returns LIBLTE_SUCCESS only
+           if the PUCCH was detected, detect_metric is the ratio of
+           the DMRS correlation energy to the received energy
+*********************************************************************/
+// Defines
+#define LIBLTE_PHY_PUCCH_DETECT_THRESH 0.2
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_pucch_channel_decode(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                                  LIBLTE_PHY_PUCCH_STRUCT    *pucch,
+                                                  uint32                      N_id_cell);
+
 /*********************************************************************
     Name: liblte_phy_generate_prach
 
@@ -706,15 +937,30 @@ LIBLTE_ERROR_ENUM liblte_phy_detect_prach(LIBLTE_PHY_STRUCT *phy_struct,
                  Channel
 
     Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3 and 6.4
+
+    Notes: For LIBLTE_PHY_PRE_CODER_TYPE_SPATIAL_MULTIPLEXING and
+           LIBLTE_PHY_PRE_CODER_TYPE_LARGE_DELAY_CDD allocations, a
+           single codeword is mapped onto alloc.N_layers layers.
+           Closed loop spatial multiplexing uses the pre-coding matrix
+           given by alloc.codebook_idx.
 *********************************************************************/
 // Defines
 #define LIBLTE_PHY_PDCCH_MAX_ALLOC 10
 // Enums
 // Structs
 typedef struct{
-    LIBLTE_PHY_ALLOCATION_STRUCT alloc[LIBLTE_PHY_PDCCH_MAX_ALLOC];
-    uint32                       N_symbs;
-    uint32                       N_alloc;
+    uint32 N_cand;         // Candidates in the searched search spaces
+    uint32 N_cand_pruned;  // Candidates rejected on CCE energy or overlap
+    uint32 N_cand_decoded; // Candidates demodulated
+    uint32 N_viterbi;      // DCI Viterbi decodes
+    uint32 N_dci;          // DCIs found for the wanted RNTIs
+    bool   early_term;     // Search stopped once all wanted RNTIs were found
+}LIBLTE_PHY_PDCCH_DECODE_STATS_STRUCT;
+typedef struct{
+    LIBLTE_PHY_ALLOCATION_STRUCT         alloc[LIBLTE_PHY_PDCCH_MAX_ALLOC];
+    LIBLTE_PHY_PDCCH_DECODE_STATS_STRUCT stats;
+    uint32                               N_symbs;
+    uint32                               N_alloc;
 }LIBLTE_PHY_PDCCH_STRUCT;
 // Functions
 LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *phy_struct,
@@ -744,6 +990,38 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_decode(LIBLTE_PHY_STRUCT            *
                                                   uint8                        *out_bits,
                                                   uint32                       *N_out_bits);
 
+/*********************************************************************
+    Name: liblte_phy_pdsch_channel_decode_multi_rx
+
+    Description: Demodulates and decodes the Physical Downlink Shared
+                 Channel received on one or more receive antennas
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3 and 6.4
+
+    Notes: subframe holds one received subframe per receive antenna.
+           Transmit diversity is maximum ratio combined across the
+           receive antennas, spatial multiplexing and large delay CDD
+           are detected with an unbiased MMSE detector using the
+           per-RB noise variance from the channel estimate.  When
+           soft_buffer is not NULL the received LLRs are combined
+           with those of earlier transmissions of the transport
+           block before turbo decoding.
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_decode_multi_rx(LIBLTE_PHY_STRUCT             *phy_struct,
+                                                           LIBLTE_PHY_SUBFRAME_STRUCT   **subframe,
+                                                           uint8                          N_rx,
+                                                           LIBLTE_PHY_ALLOCATION_STRUCT  *alloc,
+                                                           uint32                         N_pdcch_symbs,
+                                                           uint32                         N_id_cell,
+                                                           uint8                          N_ant,
+                                                           LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer,
+                                                           uint8                         *out_bits,
+                                                           uint32                        *N_out_bits);
+
 /*********************************************************************
     Name: liblte_phy_bch_channel_encode
 
@@ -851,6 +1129,46 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
                                                   LIBLTE_PHY_PHICH_STRUCT        *phich,
                                                   LIBLTE_PHY_PDCCH_STRUCT        *pdcch);
 
+/*********************************************************************
+    Name: liblte_phy_pdcch_channel_decode_rntis
+
+    Description: Demodulates and decodes all of the Physical Downlink
+                 Control Channels (PCFICH, PHICH, and PDCCH), blind
+                 decoding the PDCCH for a list of wanted RNTIs
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.7, 6.8, and
+                        6.9
+                        3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
+                        3GPP TS 36.213 v10.3.0 section 9.1.1
+
+    Notes: The common search space is searched for all wanted RNTIs
+           and the UE specific search spaces are searched for wanted
+           C-RNTIs.  Candidates whose CCE energy is below
+           LIBLTE_PHY_PDCCH_CAND_ENERGY_THRESH of the energy expected
+           from the channel estimate are not decoded.  The search
+           stops once a DCI has been found for every wanted RNTI.
+           With no wanted RNTIs, the common search space is searched
+           for SI-RNTI, P-RNTI, and RA-RNTIs.  Uplink grants (DCI 0)
+           are returned with a chan_type of LIBLTE_PHY_CHAN_TYPE_ULSCH.
+*********************************************************************/
+// Defines
+#define LIBLTE_PHY_PDCCH_MAX_RNTIS          32
+#define LIBLTE_PHY_PDCCH_CAND_ENERGY_THRESH 0.25
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode_rntis(LIBLTE_PHY_STRUCT              *phy_struct,
+                                                        LIBLTE_PHY_SUBFRAME_STRUCT     *subframe,
+                                                        uint32                          N_id_cell,
+                                                        uint8                           N_ant,
+                                                        float                           phich_res,
+                                                        LIBLTE_RRC_PHICH_DURATION_ENUM  phich_dur,
+                                                        uint16                         *rnti_list,
+                                                        uint32                          N_rnti,
+                                                        LIBLTE_PHY_PCFICH_STRUCT       *pcfich,
+                                                        LIBLTE_PHY_PHICH_STRUCT        *phich,
+                                                        LIBLTE_PHY_PDCCH_STRUCT        *pdcch);
+
 /*********************************************************************
     Name: liblte_phy_map_crs
 
@@ -994,6 +1312,11 @@ LIBLTE_ERROR_ENUM liblte_phy_create_dl_subframe(LIBLTE_PHY_STRUCT          *phy_
                  particular downlink subframe
 
     Document Reference: 3GPP TS 36.211 v10.1.0
+
+    NOTES: Only the CRS least squares estimates and the per RB noise
+           variance are computed here, rx_ce_re/im are filled for
+           the RBs and symbols used by the PBCH, PCFICH, PDCCH, and
+           PDSCH decoders when those run
 *********************************************************************/
 // Defines
 // Enums
@@ -1008,6 +1331,21 @@ LIBLTE_ERROR_ENUM liblte_phy_get_dl_subframe_and_ce(LIBLTE_PHY_STRUCT          *
                                                     uint8                       N_ant,
                                                     LIBLTE_PHY_SUBFRAME_STRUCT *subframe);
 
+/*********************************************************************
+    Name: liblte_phy_set_dl_ce_interp
+
+    Description: Selects the frequency interpolation used for the
+                 downlink channel estimates
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_dl_ce_interp(LIBLTE_PHY_STRUCT            *phy_struct,
+                                              LIBLTE_PHY_DL_CE_INTERP_ENUM  interp);
+
 /*********************************************************************
     Name: liblte_phy_get_ul_subframe
 
@@ -1069,6 +1407,25 @@ LIBLTE_ERROR_ENUM liblte_phy_get_tbs_and_n_prb_for_dl(uint32  N_bits,
                                                       uint32 *tbs,
                                                       uint32 *N_prb);
 
+/*********************************************************************
+    Name: liblte_phy_get_tbs_for_dl
+
+    Description: Determines the transport block size carried by the
+                 specified number of PRBs according to the specified
+                 modulation and coding scheme
+
+    Document Reference: 3GPP TS 36.213 v10.3.0 section 7.1.7
+
+    NOTES: Currently only supports single layer transport blocks
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_get_tbs_for_dl(uint32  N_prb,
+                                            uint8   mcs,
+                                            uint32 *tbs);
+
 /*********************************************************************
     Name: liblte_phy_get_tbs_mcs_and_n_prb_for_ul
 
@@ -1088,6 +1445,24 @@ LIBLTE_ERROR_ENUM liblte_phy_get_tbs_mcs_and_n_prb_for_ul(uint32  N_bits,
                                                           uint8  *mcs,
                                                           uint32 *N_prb);
 
+/*********************************************************************
+    Name: liblte_phy_get_n_prb_for_pucch
+
+    Description: Determines the number of PRBs at each edge of the
+                 UL band that are occupied by PUCCH
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_get_n_prb_for_pucch(uint32  delta_shift,
+                                                 uint32  N_rb_2,
+                                                 uint32  N_cs_1,
+                                                 uint32  n_1_pucch_max,
+                                                 uint32 *N_prb);
+
 /*********************************************************************
     Name: liblte_phy_get_n_cce
 
@@ -1106,4 +1481,101 @@ LIBLTE_ERROR_ENUM liblte_phy_get_n_cce(LIBLTE_PHY_STRUCT *phy_struct,
                                        uint8              N_ant,
                                        uint32            *N_cce);
 
+/*********************************************************************
+    Name: liblte_phy_turbo_encode
+
+    Description: Turbo encodes a single code block, using either the
+                 lookup table encoder (as used by the DLSCH and ULSCH
+                 encoders) or the original bit serial encoder
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+
+    Notes: Intended for benchmarking and verifying the encoders
+*********************************************************************/
+// Defines
+// Enums
+typedef enum{
+    LIBLTE_PHY_TURBO_ENCODER_LUT = 0,
+    LIBLTE_PHY_TURBO_ENCODER_BIT_SERIAL,
+    LIBLTE_PHY_TURBO_ENCODER_N_ITEMS,
+}LIBLTE_PHY_TURBO_ENCODER_ENUM;
+static const char liblte_phy_turbo_encoder_text[LIBLTE_PHY_TURBO_ENCODER_N_ITEMS][20] = {"LUT", "Bit Serial"};
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_turbo_encode(LIBLTE_PHY_STRUCT             *phy_struct,
+                                          LIBLTE_PHY_TURBO_ENCODER_ENUM  encoder,
+                                          uint8                         *c_bits,
+                                          uint32                         N_c_bits,
+                                          uint8                         *d_bits,
+                                          uint32                        *N_d_bits);
+
+/*********************************************************************
+    Name: liblte_phy_dl_pre_code
+
+    Description: Maps a block of downlink layers onto the antenna
+                 ports using the single antenna, transmit diversity,
+                 closed loop spatial multiplexing, or large delay CDD
+                 pre-coder
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4
+
+    Notes: Intended for benchmarking and verifying the pre-coders.
+           Layer l is read from x[l*M_layer_symb] and antenna port p
+           is written to y[p*y_len].
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_dl_pre_code(LIBLTE_PHY_STRUCT              *phy_struct,
+                                         LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                                         float                          *x_re,
+                                         float                          *x_im,
+                                         uint32                          M_layer_symb,
+                                         uint8                           N_ant,
+                                         uint32                          N_layers,
+                                         uint32                          codebook_idx,
+                                         float                          *y_re,
+                                         float                          *y_im,
+                                         uint32                          y_len,
+                                         uint32                         *M_ap_symb);
+
+/*********************************************************************
+    Name: liblte_phy_dl_pre_decode
+
+    Description: Recovers a block of downlink layers from the symbols
+                 received on one or more receive antennas
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4
+
+    Notes: Intended for benchmarking and verifying the pre-decoders.
+           Receive antenna r is read from y[r*y_len] and the channel
+           from antenna port p to receive antenna r is read from
+           h[(r*LIBLTE_PHY_N_ANT_MAX+p)*h_len].  noise_var is only
+           used for spatial multiplexing and large delay CDD and
+           holds one value per resource element.  At most 5000
+           resource elements can be pre-decoded at a time.
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_dl_pre_decode(LIBLTE_PHY_STRUCT              *phy_struct,
+                                           LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                                           float                          *y_re,
+                                           float                          *y_im,
+                                           uint32                          y_len,
+                                           float                          *h_re,
+                                           float                          *h_im,
+                                           uint32                          h_len,
+                                           float                          *noise_var,
+                                           uint32                          M_ap_symb,
+                                           uint8                           N_rx,
+                                           uint8                           N_ant,
+                                           uint32                          N_layers,
+                                           uint32                          codebook_idx,
+                                           float                          *x_re,
+                                           float                          *x_im,
+                                           uint32                         *M_layer_symb);
+
 #endif /* __LIBLTE_PHY_H__ */
@@ -0,0 +1,250 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_qos.h
+
+    Description: Contains all the definitions for the bearer QoS library
+                 used to share the downlink between radio bearers.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+#ifndef __LIBLTE_QOS_H__
+#define __LIBLTE_QOS_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_common.h"
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              DECLARATIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Parameter: Resource Type
+
+    Description: Whether a bearer has a guaranteed bit rate.
+
+    Document Reference: 23.203 v10.3.0 Section 6.1.7.2
+*********************************************************************/
+// Defines
+// Enums
+typedef enum{
+    LIBLTE_QOS_RESOURCE_TYPE_GBR = 0,
+    LIBLTE_QOS_RESOURCE_TYPE_NON_GBR,
+    LIBLTE_QOS_RESOURCE_TYPE_N_ITEMS,
+}LIBLTE_QOS_RESOURCE_TYPE_ENUM;
+static const char liblte_qos_resource_type_text[LIBLTE_QOS_RESOURCE_TYPE_N_ITEMS][20] = {"GBR",
+                                                                                         "Non-GBR"};
+// Structs
+// Functions
+
+/*********************************************************************
+    Name: liblte_qos_get_qci
+
+    Description: Returns the standardized characteristics of a QCI.
+                 Priority 1 is the highest, the packet error loss rate
+                 is 10^-loss_rate_exp.
+
+    Document Reference: 23.203 v10.3.0 Table 6.1.7
+*********************************************************************/
+// Defines
+#define LIBLTE_QOS_QCI_MIN            1
+#define LIBLTE_QOS_QCI_MAX            9
+#define LIBLTE_QOS_QCI_DEFAULT        9
+#define LIBLTE_QOS_N_PRIORITY_LEVELS  9
+// Enums
+// Structs
+typedef struct{
+    LIBLTE_QOS_RESOURCE_TYPE_ENUM resource_type;
+    uint32                        delay_budget_ms;
+    uint8                         priority;
+    uint8                         loss_rate_exp;
+}LIBLTE_QOS_QCI_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_qos_get_qci(uint8                  qci,
+                                     LIBLTE_QOS_QCI_STRUCT *qci_char);
+
+/*********************************************************************
+    Name: liblte_qos_bit_rate_kbps
+
+    Description: Decodes a maximum or guaranteed bit rate octet and
+                 its extension octet into kbps.  Returns 0 for a bit
+                 rate of 0kbps.
+
+    Document Reference: 24.301 v10.2.0 Section 9.9.4.3
+                        24.008 v10.2.0 Section 10.5.6.5
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+uint32 liblte_qos_bit_rate_kbps(uint8 br,
+                                uint8 br_ext);
+
+/*********************************************************************
+    Name: Token Bucket
+
+    Description: Meters a bearer or a user against a bit rate.  The
+                 bucket fills at rate_kbps up to a depth of burst_ms
+                 worth of data and may be overdrawn by the last SDU
+                 served, which is paid back before anything else is
+                 allowed through.
+
+    Document Reference: N/A
+
+    Notes: Tokens are kept in millibits, as kbps times microseconds
+           is exactly millibits
+*********************************************************************/
+// Defines
+#define LIBLTE_QOS_TOKEN_BUCKET_BURST_MS 100
+// Enums
+// Structs
+typedef struct{
+    int64  tokens;
+    int64  depth;
+    uint64 last_us;
+    uint32 rate_kbps;
+}LIBLTE_QOS_TOKEN_BUCKET_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_qos_token_bucket_init(LIBLTE_QOS_TOKEN_BUCKET_STRUCT *tb,
+                                               uint32                          rate_kbps,
+                                               uint32                          burst_ms,
+                                               uint64                          now_us);
+void liblte_qos_token_bucket_update(LIBLTE_QOS_TOKEN_BUCKET_STRUCT *tb,
+                                    uint64                          now_us);
+uint32 liblte_qos_token_bucket_bytes(LIBLTE_QOS_TOKEN_BUCKET_STRUCT *tb);
+void liblte_qos_token_bucket_consume(LIBLTE_QOS_TOKEN_BUCKET_STRUCT *tb,
+                                     uint32                          N_bytes);
+
+/*********************************************************************
+    Name: Deficit Round Robin
+
+    Description: Shares capacity between flows in proportion to their
+                 quanta.  The caller marks the flows that are
+                 backlogged, asks which flow to serve and how many
+                 bytes it may send, and charges the flow for what it
+                 actually sent.  A flow keeps the turn until its
+                 deficit is used up or it runs out of data.
+
+    Document Reference: Shreedhar and Varghese, "Efficient Fair
+                        Queuing using Deficit Round Robin", 1995
+
+    Notes: Deficits survive between calls so a flow that could only
+           send part of its quantum in one TTI catches up in the next
+*********************************************************************/
+// Defines
+#define LIBLTE_QOS_DRR_N_FLOWS_MAX   8
+#define LIBLTE_QOS_DRR_BASE_QUANTUM  128
+#define LIBLTE_QOS_DRR_QUANTUM(priority) (LIBLTE_QOS_DRR_BASE_QUANTUM * (LIBLTE_QOS_N_PRIORITY_LEVELS + 1 - (priority)))
+// Enums
+// Structs
+typedef struct{
+    int32  deficit;
+    uint32 quantum;
+    bool   backlogged;
+}LIBLTE_QOS_DRR_FLOW_STRUCT;
+typedef struct{
+    LIBLTE_QOS_DRR_FLOW_STRUCT flow[LIBLTE_QOS_DRR_N_FLOWS_MAX];
+    uint32                     N_flows;
+    uint32                     cur;
+}LIBLTE_QOS_DRR_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_qos_drr_init(LIBLTE_QOS_DRR_STRUCT *drr,
+                                      uint32                 N_flows);
+LIBLTE_ERROR_ENUM liblte_qos_drr_set_quantum(LIBLTE_QOS_DRR_STRUCT *drr,
+                                             uint32                 flow,
+                                             uint32                 quantum);
+LIBLTE_ERROR_ENUM liblte_qos_drr_select(LIBLTE_QOS_DRR_STRUCT *drr,
+                                        uint32                *flow,
+                                        uint32                *N_bytes);
+LIBLTE_ERROR_ENUM liblte_qos_drr_charge(LIBLTE_QOS_DRR_STRUCT *drr,
+                                        uint32                 flow,
+                                        uint32                 N_bytes,
+                                        bool                   empty);
+
+/*********************************************************************
+    Name: CoDel
+
+    Description: Controlled delay active queue management.  Called
+                 for the packet at the head of a queue as it is
+                 dequeued, with the time it has spent queued, and
+                 returns whether to drop it.  Packets are dropped
+                 once the sojourn time has stayed above target for a
+                 whole interval, at a rate growing with the square
+                 root of the number of drops until the queue drains
+                 below target.
+
+    Document Reference: RFC8289
+*********************************************************************/
+// Defines
+#define LIBLTE_QOS_CODEL_TARGET_US   5000
+#define LIBLTE_QOS_CODEL_INTERVAL_US 100000
+#define LIBLTE_QOS_CODEL_MTU         1500
+// Enums
+// Structs
+typedef struct{
+    uint64 target_us;
+    uint64 interval_us;
+    uint64 first_above_us;
+    uint64 drop_next_us;
+    uint32 count;
+    uint32 last_count;
+    uint32 N_drops;
+    bool   dropping;
+}LIBLTE_QOS_CODEL_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_qos_codel_init(LIBLTE_QOS_CODEL_STRUCT *codel,
+                                        uint64                   target_us,
+                                        uint64                   interval_us);
+bool liblte_qos_codel_drop(LIBLTE_QOS_CODEL_STRUCT *codel,
+                           uint64                   now_us,
+                           uint64                   sojourn_us,
+                           uint32                   N_bytes_queued);
+
+/*********************************************************************
+    Name: liblte_qos_get_time_us
+
+    Description: Returns a monotonic time in microseconds for
+                 timestamping queued SDUs and refilling token buckets.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+uint64 liblte_qos_get_time_us(void);
+
+#endif /* __LIBLTE_QOS_H__ */
@@ -100,6 +100,27 @@ static const char liblte_rlc_fi_field_text[LIBLTE_RLC_FI_FIELD_N_ITEMS][20] = {"
 // Structs
 // Functions
 
+/*********************************************************************
+    Parameter: Length Indicator (LI)
+
+    Description: The LI field indicates the length in bytes of the
+                 corresponding Data field element present in the
+                 UMD or AMD PDU.  Every Data field element except the
+                 last one has an LI field, each preceded by an E
+                 field.
+
+    Document Reference: 36.322 v10.0.0 Sections 6.2.2.4 & 6.2.2.5
+*********************************************************************/
+// Defines
+#define LIBLTE_RLC_LI_MAX  2047
+#define LIBLTE_RLC_MAX_LI  32
+// Number of bytes taken by N_li E/LI pairs, including the 4 bits of
+// padding that follow an odd number of LIs
+#define LIBLTE_RLC_LI_FIELD_N_BYTES(N_li) (((N_li)*12 + 7)/8)
+// Enums
+// Structs
+// Functions
+
 /*********************************************************************
     Parameter: Last Segment Flag (LSF)
 
@@ -257,7 +278,9 @@ static const char liblte_rlc_umd_sn_size_text[LIBLTE_RLC_UMD_SN_SIZE_N_ITEMS][20
 typedef struct{
     LIBLTE_RLC_FI_FIELD_ENUM    fi;
     LIBLTE_RLC_UMD_SN_SIZE_ENUM sn_size;
+    uint32                      N_li;
     uint16                      sn;
+    uint16                      li[LIBLTE_RLC_MAX_LI];
 }LIBLTE_RLC_UMD_PDU_HEADER_STRUCT;
 typedef struct{
     LIBLTE_RLC_UMD_PDU_HEADER_STRUCT hdr;
@@ -285,7 +308,9 @@ typedef struct{
     LIBLTE_RLC_RF_FIELD_ENUM rf;
     LIBLTE_RLC_P_FIELD_ENUM  p;
     LIBLTE_RLC_FI_FIELD_ENUM fi;
+    uint32                   N_li;
     uint16                   sn;
+    uint16                   li[LIBLTE_RLC_MAX_LI];
 }LIBLTE_RLC_AMD_PDU_HEADER_STRUCT;
 typedef struct{
     LIBLTE_RLC_AMD_PDU_HEADER_STRUCT hdr;
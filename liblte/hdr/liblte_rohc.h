@@ -0,0 +1,349 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_rohc.h
+
+    Description: Contains all the definitions for the RObust Header
+                 Compression library used by PDCP.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+#ifndef __LIBLTE_ROHC_H__
+#define __LIBLTE_ROHC_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_common.h"
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+// Only small CIDs are supported
+#define LIBLTE_ROHC_MAX_CID             15
+#define LIBLTE_ROHC_N_CONTEXTS          (LIBLTE_ROHC_MAX_CID + 1)
+#define LIBLTE_ROHC_WLSB_WINDOW_SIZE    4
+#define LIBLTE_ROHC_MAX_FEEDBACK_SIZE   8
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              DECLARATIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Parameter: Profile
+
+    Description: Identifies the header compression profile used by a
+                 context.  The enum values are the profile identifiers.
+
+    Document Reference: RFC3095 Section 8
+*********************************************************************/
+// Defines
+// Enums
+typedef enum{
+    LIBLTE_ROHC_PROFILE_UNCOMPRESSED = 0,
+    LIBLTE_ROHC_PROFILE_RTP,
+    LIBLTE_ROHC_PROFILE_UDP,
+    LIBLTE_ROHC_PROFILE_ESP,
+    LIBLTE_ROHC_PROFILE_N_ITEMS,
+}LIBLTE_ROHC_PROFILE_ENUM;
+static const char liblte_rohc_profile_text[LIBLTE_ROHC_PROFILE_N_ITEMS][20] = {"Uncompressed",
+                                                                               "RTP/UDP/IP",
+                                                                               "UDP/IP",
+                                                                               "ESP/IP"};
+// Structs
+// Functions
+
+/*********************************************************************
+    Parameter: Mode
+
+    Description: Mode of operation of a context.  A context starts in
+                 unidirectional mode and moves to optimistic mode when
+                 the decompressor acknowledges with mode O.
+
+    Document Reference: RFC3095 Section 4.4
+*********************************************************************/
+// Defines
+// Enums
+typedef enum{
+    LIBLTE_ROHC_MODE_U = 0,
+    LIBLTE_ROHC_MODE_O,
+    LIBLTE_ROHC_MODE_N_ITEMS,
+}LIBLTE_ROHC_MODE_ENUM;
+static const char liblte_rohc_mode_text[LIBLTE_ROHC_MODE_N_ITEMS][20] = {"U-mode",
+                                                                         "O-mode"};
+// Structs
+// Functions
+
+/*********************************************************************
+    Parameter: Compressor State
+
+    Description: Initialization and Refresh, First Order, and Second
+                 Order compressor states.
+
+    Document Reference: RFC3095 Section 4.3.1
+*********************************************************************/
+// Defines
+// Enums
+typedef enum{
+    LIBLTE_ROHC_COMP_STATE_IR = 0,
+    LIBLTE_ROHC_COMP_STATE_FO,
+    LIBLTE_ROHC_COMP_STATE_SO,
+    LIBLTE_ROHC_COMP_STATE_N_ITEMS,
+}LIBLTE_ROHC_COMP_STATE_ENUM;
+static const char liblte_rohc_comp_state_text[LIBLTE_ROHC_COMP_STATE_N_ITEMS][20] = {"IR",
+                                                                                     "FO",
+                                                                                     "SO"};
+// Structs
+// Functions
+
+/*********************************************************************
+    Parameter: Decompressor State
+
+    Description: No Context, Static Context, and Full Context
+                 decompressor states.
+
+    Document Reference: RFC3095 Section 4.3.2
+*********************************************************************/
+// Defines
+// Enums
+typedef enum{
+    LIBLTE_ROHC_DECOMP_STATE_NC = 0,
+    LIBLTE_ROHC_DECOMP_STATE_SC,
+    LIBLTE_ROHC_DECOMP_STATE_FC,
+    LIBLTE_ROHC_DECOMP_STATE_N_ITEMS,
+}LIBLTE_ROHC_DECOMP_STATE_ENUM;
+static const char liblte_rohc_decomp_state_text[LIBLTE_ROHC_DECOMP_STATE_N_ITEMS][20] = {"No Context",
+                                                                                         "Static Context",
+                                                                                         "Full Context"};
+// Structs
+// Functions
+
+/*********************************************************************
+    Parameter: Packet Type
+
+    Description: ROHC packet types produced by the compressor.
+
+    Document Reference: RFC3095 Sections 5.7 and 5.10
+*********************************************************************/
+// Defines
+// Enums
+typedef enum{
+    LIBLTE_ROHC_PACKET_TYPE_IR = 0,
+    LIBLTE_ROHC_PACKET_TYPE_IR_DYN,
+    LIBLTE_ROHC_PACKET_TYPE_UO_0,
+    LIBLTE_ROHC_PACKET_TYPE_UO_1,
+    LIBLTE_ROHC_PACKET_TYPE_UOR_2,
+    LIBLTE_ROHC_PACKET_TYPE_NORMAL,
+    LIBLTE_ROHC_PACKET_TYPE_N_ITEMS,
+}LIBLTE_ROHC_PACKET_TYPE_ENUM;
+static const char liblte_rohc_packet_type_text[LIBLTE_ROHC_PACKET_TYPE_N_ITEMS][20] = {"IR",
+                                                                                       "IR-DYN",
+                                                                                       "UO-0",
+                                                                                       "UO-1",
+                                                                                       "UOR-2",
+                                                                                       "Normal"};
+// Structs
+// Functions
+
+/*********************************************************************
+    Parameter: Header Fields
+
+    Description: The IPv4, UDP, RTP, and ESP header fields of a flow
+                 that are kept in a compressor or decompressor context.
+
+    Document Reference: RFC3095 Sections 5.7.7 and 5.11
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+typedef struct{
+    // Static chain
+    uint32 src_addr;
+    uint32 dst_addr;
+    uint32 ssrc_spi;
+    uint16 src_port;
+    uint16 dst_port;
+    uint8  protocol;
+    // Dynamic chain
+    uint32 sn;
+    uint32 ts;
+    uint32 ts_stride;
+    uint16 ip_id;
+    uint16 ip_id_offset;
+    uint16 udp_checksum;
+    uint8  tos;
+    uint8  ttl;
+    uint8  rtp_flags;
+    uint8  rtp_pt;
+    bool   rtp_m;
+    bool   df;
+    bool   rnd;
+    // CRC-3 and CRC-7 over the CRC-STATIC header octets, indexed
+    // by the RTP marker bit
+    uint8  crc3_static[2];
+    uint8  crc7_static[2];
+}LIBLTE_ROHC_FLOW_STRUCT;
+// Functions
+
+/*********************************************************************
+    Name: liblte_rohc_comp_init
+
+    Description: Sets up a compressor for CIDs 0 to max_cid using the
+                 profiles set in the profiles bit mask, where bit N is
+                 profile 0x000N.  Flows that do not match an enabled
+                 profile are carried by the uncompressed profile.  All
+                 contexts are held in the compressor struct, so nothing
+                 is allocated while compressing.
+
+    Document Reference: RFC3095 Sections 4 and 5
+*********************************************************************/
+// Defines
+#define LIBLTE_ROHC_L                   3
+#define LIBLTE_ROHC_IR_TIMEOUT          700
+#define LIBLTE_ROHC_FO_TIMEOUT          300
+// Enums
+// Structs
+typedef struct{
+    LIBLTE_ROHC_FLOW_STRUCT     flow;
+    uint32                      sn_window[LIBLTE_ROHC_WLSB_WINDOW_SIZE];
+    uint32                      ts_window[LIBLTE_ROHC_WLSB_WINDOW_SIZE];
+    uint32                      ip_id_offset_window[LIBLTE_ROHC_WLSB_WINDOW_SIZE];
+    uint32                      N_window;
+    uint32                      window_idx;
+    uint32                      last_sn;
+    uint32                      last_ts;
+    uint32                      N_state_pkts;
+    uint32                      N_pkts_since_ir;
+    uint32                      N_pkts_since_fo;
+    uint32                      N_ip_id_jumps;
+    uint32                      last_used;
+    LIBLTE_ROHC_PROFILE_ENUM    profile;
+    LIBLTE_ROHC_COMP_STATE_ENUM state;
+    LIBLTE_ROHC_MODE_ENUM       mode;
+    bool                        in_use;
+}LIBLTE_ROHC_COMP_CONTEXT_STRUCT;
+typedef struct{
+    LIBLTE_ROHC_COMP_CONTEXT_STRUCT ctx[LIBLTE_ROHC_N_CONTEXTS];
+    uint32                          N_pkts[LIBLTE_ROHC_PACKET_TYPE_N_ITEMS];
+    uint32                          max_cid;
+    uint32                          profiles;
+    uint32                          clock;
+    uint32                          last_cid;
+}LIBLTE_ROHC_COMP_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_rohc_comp_init(LIBLTE_ROHC_COMP_STRUCT *comp,
+                                        uint32                   max_cid,
+                                        uint32                   profiles);
+
+/*********************************************************************
+    Name: liblte_rohc_compress
+
+    Description: Compresses one IP packet into a ROHC packet.
+
+    Document Reference: RFC3095 Sections 5.3 to 5.7, 5.10, and 5.11
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_rohc_compress(LIBLTE_ROHC_COMP_STRUCT *comp,
+                                       LIBLTE_BYTE_MSG_STRUCT  *ip_pkt,
+                                       LIBLTE_BYTE_MSG_STRUCT  *rohc_pkt);
+
+/*********************************************************************
+    Name: liblte_rohc_comp_handle_feedback
+
+    Description: Applies a ROHC feedback packet received from the peer
+                 decompressor.  ACK moves a context to optimistic mode
+                 and the SO state, NACK triggers IR-DYN packets, and
+                 STATIC-NACK triggers IR packets.
+
+    Document Reference: RFC3095 Sections 5.2.2, 5.4.1, and 5.7.6
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_rohc_comp_handle_feedback(LIBLTE_ROHC_COMP_STRUCT *comp,
+                                                   LIBLTE_BYTE_MSG_STRUCT  *feedback);
+
+/*********************************************************************
+    Name: liblte_rohc_decomp_init
+
+    Description: Sets up a decompressor for CIDs 0 to max_cid using the
+                 profiles set in the profiles bit mask.  When feedback
+                 is true, the decompressor requests optimistic mode and
+                 produces ACK and NACK feedback.
+
+    Document Reference: RFC3095 Sections 4 and 5
+*********************************************************************/
+// Defines
+#define LIBLTE_ROHC_DECOMP_N_CRC_FAIL   3
+// Enums
+// Structs
+typedef struct{
+    LIBLTE_ROHC_FLOW_STRUCT       flow;
+    uint32                        N_crc_fail;
+    LIBLTE_ROHC_PROFILE_ENUM      profile;
+    LIBLTE_ROHC_DECOMP_STATE_ENUM state;
+}LIBLTE_ROHC_DECOMP_CONTEXT_STRUCT;
+typedef struct{
+    LIBLTE_ROHC_DECOMP_CONTEXT_STRUCT ctx[LIBLTE_ROHC_N_CONTEXTS];
+    uint32                            max_cid;
+    uint32                            profiles;
+    bool                              feedback;
+}LIBLTE_ROHC_DECOMP_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_rohc_decomp_init(LIBLTE_ROHC_DECOMP_STRUCT *decomp,
+                                          uint32                     max_cid,
+                                          uint32                     profiles,
+                                          bool                       feedback);
+
+/*********************************************************************
+    Name: liblte_rohc_decompress
+
+    Description: Decompresses one ROHC packet into an IP packet.  Any
+                 feedback for the peer compressor is returned in
+                 feedback, which is left empty when there is none.
+                 Packets that fail their CRC are dropped and return
+                 LIBLTE_ERROR_INVALID_CRC.
+
+    Document Reference: RFC3095 Sections 5.3 to 5.7, 5.10, and 5.11
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_rohc_decompress(LIBLTE_ROHC_DECOMP_STRUCT *decomp,
+                                         LIBLTE_BYTE_MSG_STRUCT    *rohc_pkt,
+                                         LIBLTE_BYTE_MSG_STRUCT    *ip_pkt,
+                                         LIBLTE_BYTE_MSG_STRUCT    *feedback);
+
+#endif /* __LIBLTE_ROHC_H__ */
@@ -3056,14 +3056,14 @@ typedef enum{
     LIBLTE_RRC_CIPHERING_ALGORITHM_EEA0 = 0,
     LIBLTE_RRC_CIPHERING_ALGORITHM_EEA1,
     LIBLTE_RRC_CIPHERING_ALGORITHM_EEA2,
-    LIBLTE_RRC_CIPHERING_ALGORITHM_SPARE5,
+    LIBLTE_RRC_CIPHERING_ALGORITHM_EEA3_V1130,
     LIBLTE_RRC_CIPHERING_ALGORITHM_SPARE4,
     LIBLTE_RRC_CIPHERING_ALGORITHM_SPARE3,
     LIBLTE_RRC_CIPHERING_ALGORITHM_SPARE2,
     LIBLTE_RRC_CIPHERING_ALGORITHM_SPARE1,
     LIBLTE_RRC_CIPHERING_ALGORITHM_N_ITEMS,
 }LIBLTE_RRC_CIPHERING_ALGORITHM_ENUM;
-static const char liblte_rrc_ciphering_algorithm_text[LIBLTE_RRC_CIPHERING_ALGORITHM_N_ITEMS][20] = { "EEA0",  "EEA1",  "EEA2", "SPARE",
+static const char liblte_rrc_ciphering_algorithm_text[LIBLTE_RRC_CIPHERING_ALGORITHM_N_ITEMS][20] = { "EEA0",  "EEA1",  "EEA2",  "EEA3",
                                                                                                      "SPARE", "SPARE", "SPARE", "SPARE"};
 typedef enum{
     LIBLTE_RRC_INTEGRITY_PROT_ALGORITHM_EIA0_V920 = 0,
@@ -6329,6 +6329,7 @@ LIBLTE_ERROR_ENUM liblte_rrc_unpack_counter_check_msg(LIBLTE_BIT_MSG_STRUCT
     Document Reference: 36.331 v10.0.0 Sections 6.2.1 and 6.2.2
 *********************************************************************/
 // Defines
+#define LIBLTE_RRC_MIB_N_BITS 24
 // Enums
 typedef enum{
     LIBLTE_RRC_DL_BANDWIDTH_6 = 0,
@@ -99,11 +99,13 @@ typedef enum{
     LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_EEA0 = 0,
     LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA1,
     LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA2,
+    LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA3,
     LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_N_ITEMS,
 }LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM;
 static const char liblte_security_ciphering_algorithm_id_text[LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_N_ITEMS][20] = {"EEA0",
                                                                                                                      "128-EEA1",
-                                                                                                                     "128-EEA2"};
+                                                                                                                     "128-EEA2",
+                                                                                                                     "128-EEA3"};
 typedef enum{
     LIBLTE_SECURITY_INTEGRITY_ALGORITHM_ID_EIA0 = 0,
     LIBLTE_SECURITY_INTEGRITY_ALGORITHM_ID_128_EIA1,
@@ -185,6 +187,239 @@ LIBLTE_ERROR_ENUM liblte_security_128_eia2(uint8                 *key,
                                            LIBLTE_BIT_MSG_STRUCT *msg,
                                            uint8                 *mac);
 
+/*********************************************************************
+    Name: liblte_security_128_eia2_init
+
+    Description: Sets up an EIA2 integrity context for one bearer and
+                 direction.  The AES round keys and the CMAC subkeys
+                 K1 and K2 only depend on the key, so they are
+                 computed here once instead of for every message.
+
+    Document Reference: 33.401 v10.0.0 Annex B.2.3
+                        RFC4493 Section 2.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+typedef struct{
+    uint32 rk[44];
+    uint32 k1[4];
+    uint32 k2[4];
+    uint8  bearer;
+    uint8  direction;
+}LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_security_128_eia2_init(LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT *ctx,
+                                                uint8                                *key,
+                                                uint8                                 bearer,
+                                                uint8                                 direction);
+
+/*********************************************************************
+    Name: liblte_security_128_eia2
+
+    Description: 128-bit integrity algorithm EIA2 using a context from
+                 liblte_security_128_eia2_init.  Computes the MAC over
+                 the first N_bits of msg.
+
+    Document Reference: 33.401 v10.0.0 Annex B.2.3
+                        RFC4493
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_security_128_eia2(LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT *ctx,
+                                           uint32                                count,
+                                           uint8                                *msg,
+                                           uint32                                N_bits,
+                                           uint8                                *mac);
+
+/*********************************************************************
+    Name: liblte_security_128_eia2_batch
+
+    Description: Computes the EIA2 MAC of a batch of messages using a
+                 context from liblte_security_128_eia2_init.  Each
+                 message carries its own COUNT and receives its own
+                 MAC.
+
+    Document Reference: 33.401 v10.0.0 Annex B.2.3
+                        RFC4493
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+typedef struct{
+    uint8  *msg;
+    uint32  N_bits;
+    uint32  count;
+    uint8   mac[4];
+}LIBLTE_SECURITY_INTEGRITY_MSG_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_security_128_eia2_batch(LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT *ctx,
+                                                 LIBLTE_SECURITY_INTEGRITY_MSG_STRUCT *msg,
+                                                 uint32                                N_msgs);
+
+/*********************************************************************
+    Name: liblte_security_128_eea1
+
+    Description: 128-bit encryption algorithm EEA1 (SNOW 3G).  Ciphers
+                 or deciphers N_bits of msg into out, trailing bits of
+                 the last byte of out are set to zero.
+
+    Document Reference: 33.401 v10.0.0 Annex B.1.2
+                        35.215 v10.0.0 Section 4
+                        35.216 v10.0.0 Section 3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_security_128_eea1(uint8  *key,
+                                           uint32  count,
+                                           uint8   bearer,
+                                           uint8   direction,
+                                           uint8  *msg,
+                                           uint32  N_bits,
+                                           uint8  *out);
+
+/*********************************************************************
+    Name: liblte_security_128_eea2
+
+    Description: 128-bit encryption algorithm EEA2 (AES-128 in
+                 counter mode).  Ciphers or deciphers N_bits of msg
+                 into out, trailing bits of the last byte of out are
+                 set to zero.
+
+    Document Reference: 33.401 v10.0.0 Annex B.1.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_security_128_eea2(uint8  *key,
+                                           uint32  count,
+                                           uint8   bearer,
+                                           uint8   direction,
+                                           uint8  *msg,
+                                           uint32  N_bits,
+                                           uint8  *out);
+
+/*********************************************************************
+    Name: liblte_security_128_eea3
+
+    Description: 128-bit encryption algorithm EEA3 (ZUC).  Ciphers or
+                 deciphers N_bits of msg into out, trailing bits of
+                 the last byte of out are set to zero.
+
+    Document Reference: 33.401 v11.5.0 Annex B.1.4
+                        35.221 v11.0.0 Section 3
+                        35.222 v11.0.0 Section 3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_security_128_eea3(uint8  *key,
+                                           uint32  count,
+                                           uint8   bearer,
+                                           uint8   direction,
+                                           uint8  *msg,
+                                           uint32  N_bits,
+                                           uint8  *out);
+
+/*********************************************************************
+    Name: liblte_security_cipher_init
+
+    Description: Sets up a ciphering context for one bearer and
+                 direction.  The key dependent state (AES round keys
+                 for EEA2, key loaded LFSR for EEA1 and EEA3) is
+                 computed here once, so ciphering a PDU only has to
+                 mix in COUNT.  EEA0 contexts leave PDUs untouched.
+
+    Document Reference: 33.401 v10.0.0 Section 7.2.9
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+typedef struct{
+    uint32                                      rk[44];
+    uint32                                      lfsr[16];
+    LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM alg;
+    uint8                                       bearer;
+    uint8                                       direction;
+}LIBLTE_SECURITY_CIPHER_CTX_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_security_cipher_init(LIBLTE_SECURITY_CIPHER_CTX_STRUCT           *ctx,
+                                              LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM  alg,
+                                              uint8                                       *key,
+                                              uint8                                        bearer,
+                                              uint8                                        direction);
+
+/*********************************************************************
+    Name: liblte_security_cipher
+
+    Description: Ciphers or deciphers N_bits of msg into out using a
+                 context from liblte_security_cipher_init.  msg and out
+                 may be the same buffer.
+
+    Document Reference: 33.401 v10.0.0 Annex B.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_security_cipher(LIBLTE_SECURITY_CIPHER_CTX_STRUCT *ctx,
+                                         uint32                             count,
+                                         uint8                             *msg,
+                                         uint32                             N_bits,
+                                         uint8                             *out);
+
+/*********************************************************************
+    Name: liblte_security_cipher_batch
+
+    Description: Ciphers or deciphers a batch of PDUs in place using a
+                 context from liblte_security_cipher_init.  Each PDU
+                 carries its own COUNT, which lets PDCP hand over every
+                 PDU queued for a bearer in one call.
+
+    Document Reference: 33.401 v10.0.0 Annex B.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+typedef struct{
+    uint8  *msg;
+    uint32  N_bits;
+    uint32  count;
+}LIBLTE_SECURITY_CIPHER_PDU_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_security_cipher_batch(LIBLTE_SECURITY_CIPHER_CTX_STRUCT *ctx,
+                                               LIBLTE_SECURITY_CIPHER_PDU_STRUCT *pdu,
+                                               uint32                             N_pdus);
+
+/*********************************************************************
+    Name: liblte_security_milenage_init
+
+    Description: Sets up a Milenage context for one subscriber.  The
+                 AES round keys and OPc only depend on K and OP, so
+                 they are computed here once instead of in every
+                 Milenage function.  A NULL op uses the library's
+                 default OP.
+
+    Document Reference: 35.206 v10.0.0 Annex 3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+typedef struct{
+    uint32 rk[44];
+    uint32 op_c[4];
+}LIBLTE_SECURITY_MILENAGE_CTX_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_security_milenage_init(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                                                uint8                               *k,
+                                                uint8                               *op);
+
 /*********************************************************************
     Name: liblte_security_milenage_f1
 
@@ -204,6 +439,11 @@ LIBLTE_ERROR_ENUM liblte_security_milenage_f1(uint8 *k,
                                               uint8 *sqn,
                                               uint8 *amf,
                                               uint8 *mac_a);
+LIBLTE_ERROR_ENUM liblte_security_milenage_f1(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                                              uint8                               *rand,
+                                              uint8                               *sqn,
+                                              uint8                               *amf,
+                                              uint8                               *mac_a);
 
 /*********************************************************************
     Name: liblte_security_milenage_f1_star
@@ -224,6 +464,11 @@ LIBLTE_ERROR_ENUM liblte_security_milenage_f1_star(uint8 *k,
                                                    uint8 *sqn,
                                                    uint8 *amf,
                                                    uint8 *mac_s);
+LIBLTE_ERROR_ENUM liblte_security_milenage_f1_star(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                                                   uint8                               *rand,
+                                                   uint8                               *sqn,
+                                                   uint8                               *amf,
+                                                   uint8                               *mac_s);
 
 /*********************************************************************
     Name: liblte_security_milenage_f2345
@@ -245,6 +490,12 @@ LIBLTE_ERROR_ENUM liblte_security_milenage_f2345(uint8 *k,
                                                  uint8 *ck,
                                                  uint8 *ik,
                                                  uint8 *ak);
+LIBLTE_ERROR_ENUM liblte_security_milenage_f2345(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                                                 uint8                               *rand,
+                                                 uint8                               *res,
+                                                 uint8                               *ck,
+                                                 uint8                               *ik,
+                                                 uint8                               *ak);
 
 /*********************************************************************
     Name: liblte_security_milenage_f5_star
@@ -262,5 +513,36 @@ LIBLTE_ERROR_ENUM liblte_security_milenage_f2345(uint8 *k,
 LIBLTE_ERROR_ENUM liblte_security_milenage_f5_star(uint8 *k,
                                                    uint8 *rand,
                                                    uint8 *ak);
+LIBLTE_ERROR_ENUM liblte_security_milenage_f5_star(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                                                   uint8                               *rand,
+                                                   uint8                               *ak);
+
+/*********************************************************************
+    Name: liblte_security_milenage_batch
+
+    Description: Computes F1 and F2345 for a batch of authentication
+                 vectors, each with its own subscriber context from
+                 liblte_security_milenage_init, which lets the HSS
+                 generate vectors for many subscribers in one call.
+
+    Document Reference: 35.206 v10.0.0 Annex 3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+typedef struct{
+    LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx;
+    uint8                                rand[16];
+    uint8                                sqn[6];
+    uint8                                amf[2];
+    uint8                                mac_a[8];
+    uint8                                res[8];
+    uint8                                ck[16];
+    uint8                                ik[16];
+    uint8                                ak[6];
+}LIBLTE_SECURITY_MILENAGE_VECTOR_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_security_milenage_batch(LIBLTE_SECURITY_MILENAGE_VECTOR_STRUCT *vec,
+                                                 uint32                                  N_vecs);
 
 #endif /* __LIBLTE_SECURITY_H__ */
@@ -40,6 +40,7 @@
 *******************************************************************************/
 
 #include "liblte_mac.h"
+#include <stdlib.h>
 
 /*******************************************************************************
                               DEFINES
@@ -50,6 +51,12 @@
                               TYPEDEFS
 *******************************************************************************/
 
+typedef struct{
+    float  metric;
+    uint32 tier;
+    uint32 idx;
+}SCHED_METRIC_STRUCT;
+
 
 /*******************************************************************************
                               GLOBAL VARIABLES
@@ -72,6 +79,31 @@ uint32 truncated_short_bsr_min_buffer_size[64] = {     0,      0,     10,     12
                                                    14099,  16507,  19325,  22624,  26487,  31009,  36304,  42502,
                                                    49759,  58255,  68201,  79864,  93479, 109439, 128125, 150000};
 
+// Spectral efficiency (x1024) per CQI index 36.213 v10.3.0 Table 7.2.3-1
+uint32 cqi_efficiency[16] = {   0,  156,  240,  386,  616,  898, 1204, 1512,
+                             1960, 2464, 2796, 3402, 3996, 4632, 5238, 5688};
+
+/*******************************************************************************
+                              LOCAL FUNCTION PROTOTYPES
+*******************************************************************************/
+
+/*********************************************************************
+    Name: prb_mask_is_prb_free
+
+    Description: Checks whether a single PRB of a PRB mask is free
+*********************************************************************/
+bool prb_mask_is_prb_free(LIBLTE_MAC_PRB_MASK_STRUCT *mask,
+                          uint32                      prb);
+
+/*********************************************************************
+    Name: sched_metric_compare
+
+    Description: qsort comparison function that orders scheduler
+                 metrics from highest to lowest
+*********************************************************************/
+int sched_metric_compare(const void *a,
+                         const void *b);
+
 /*******************************************************************************
                               CONTROL ELEMENT FUNCTIONS
 *******************************************************************************/
@@ -932,3 +964,483 @@ LIBLTE_ERROR_ENUM liblte_mac_unpack_random_access_response_pdu(LIBLTE_BIT_MSG_ST
 
     return(err);
 }
+
+/*******************************************************************************
+                              SCHEDULER FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: Resource Allocation
+
+    Description: Tracks the PRBs of a subframe that are in use and
+                 allocates free PRBs using resource allocation types
+                 0, 1, and 2
+
+    Document Reference: 36.213 v10.3.0 Section 7.1.6
+
+    Notes: Type 1 allocations use a shift of 0 and type 2
+           allocations are localized
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_mac_prb_mask_init(LIBLTE_MAC_PRB_MASK_STRUCT *mask,
+                                           uint32                      N_rb)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+
+    if(mask != NULL              &&
+       N_rb != 0                 &&
+       N_rb <= LIBLTE_MAC_N_RB_MAX)
+    {
+        for(i=0; i<LIBLTE_MAC_PRB_MASK_N_WORDS; i++)
+        {
+            mask->word[i] = 0;
+        }
+        mask->N_rb = N_rb;
+
+        // Resource block group size 36.213 v10.3.0 Table 7.1.6.1-1
+        if(N_rb <= 10)
+        {
+            mask->P = 1;
+        }else if(N_rb <= 26){
+            mask->P = 2;
+        }else if(N_rb <= 63){
+            mask->P = 3;
+        }else{
+            mask->P = 4;
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_mac_prb_mask_set(LIBLTE_MAC_PRB_MASK_STRUCT *mask,
+                                          uint32                      prb_start,
+                                          uint32                      N_prb)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+
+    if(mask != NULL &&
+       (prb_start + N_prb) <= mask->N_rb)
+    {
+        for(i=prb_start; i<(prb_start + N_prb); i++)
+        {
+            mask->word[i/32] |= 1 << (i%32);
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_mac_prb_mask_set_list(LIBLTE_MAC_PRB_MASK_STRUCT *mask,
+                                               uint32                     *prb,
+                                               uint32                      N_prb)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+
+    if(mask != NULL &&
+       prb  != NULL)
+    {
+        err = LIBLTE_SUCCESS;
+        for(i=0; i<N_prb; i++)
+        {
+            if(prb[i] < mask->N_rb)
+            {
+                mask->word[prb[i]/32] |= 1 << (prb[i]%32);
+            }else{
+                err = LIBLTE_ERROR_INVALID_INPUTS;
+            }
+        }
+    }
+
+    return(err);
+}
+bool liblte_mac_prb_mask_is_free(LIBLTE_MAC_PRB_MASK_STRUCT *mask,
+                                 uint32                     *prb,
+                                 uint32                      N_prb)
+{
+    uint32 i;
+    bool   free = true;
+
+    for(i=0; i<N_prb; i++)
+    {
+        if(!prb_mask_is_prb_free(mask, prb[i]))
+        {
+            free = false;
+        }
+    }
+
+    return(free);
+}
+uint32 liblte_mac_prb_mask_n_free(LIBLTE_MAC_PRB_MASK_STRUCT *mask)
+{
+    uint32 N_free = 0;
+    uint32 i;
+
+    for(i=0; i<mask->N_rb; i++)
+    {
+        if(prb_mask_is_prb_free(mask, i))
+        {
+            N_free++;
+        }
+    }
+
+    return(N_free);
+}
+LIBLTE_ERROR_ENUM liblte_mac_alloc_prbs(LIBLTE_MAC_PRB_MASK_STRUCT *mask,
+                                        LIBLTE_MAC_RA_TYPE_ENUM     ra_type,
+                                        uint32                      N_prb_min,
+                                        uint32                      N_prb_max,
+                                        LIBLTE_MAC_RB_ALLOC_STRUCT *rb_alloc)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            P;
+    uint32            N_rbg;
+    uint32            N_type1;
+    uint32            N_free;
+    uint32            best_N_free;
+    uint32            log2_P;
+    uint32            run_start;
+    uint32            run_len;
+    uint32            best_start;
+    uint32            best_len;
+    uint32            prb;
+    uint32            g;
+    uint32            i;
+    uint32            p;
+    bool              rbg_free;
+
+    if(mask      != NULL      &&
+       rb_alloc  != NULL      &&
+       N_prb_min != 0         &&
+       N_prb_min <= N_prb_max)
+    {
+        P                    = mask->P;
+        rb_alloc->ra_type    = ra_type;
+        rb_alloc->N_prb      = 0;
+        rb_alloc->rbg_bitmap = 0;
+        rb_alloc->subset     = 0;
+        rb_alloc->riv        = 0;
+
+        // Type 1 needs at least two RBG subsets, fall back to type 0
+        if(LIBLTE_MAC_RA_TYPE_1 == ra_type &&
+           1                    == P)
+        {
+            ra_type = LIBLTE_MAC_RA_TYPE_0;
+        }
+
+        if(LIBLTE_MAC_RA_TYPE_0 == ra_type)
+        {
+            // Whole RBGs, lowest first, until the maximum is reached
+            N_rbg = (mask->N_rb + P - 1) / P;
+            for(g=0; g<N_rbg && rb_alloc->N_prb<N_prb_max; g++)
+            {
+                rbg_free = true;
+                for(prb=g*P; prb<(g+1)*P && prb<mask->N_rb; prb++)
+                {
+                    if(!prb_mask_is_prb_free(mask, prb))
+                    {
+                        rbg_free = false;
+                    }
+                }
+                if(rbg_free)
+                {
+                    for(prb=g*P; prb<(g+1)*P && prb<mask->N_rb; prb++)
+                    {
+                        rb_alloc->prb[rb_alloc->N_prb++] = prb;
+                    }
+                    rb_alloc->rbg_bitmap |= 1 << (N_rbg - 1 - g);
+                }
+            }
+        }else if(LIBLTE_MAC_RA_TYPE_1 == ra_type){
+            // Pick the RBG subset with the most free addressable PRBs
+            log2_P = 0;
+            while((uint32)(1 << log2_P) < P)
+            {
+                log2_P++;
+            }
+            N_type1     = (mask->N_rb + P - 1)/P - log2_P - 1;
+            best_N_free = 0;
+            for(p=0; p<P; p++)
+            {
+                N_free = 0;
+                for(i=0; i<N_type1; i++)
+                {
+                    prb = (i/P)*P*P + p*P + (i%P);
+                    if(prb < mask->N_rb &&
+                       prb_mask_is_prb_free(mask, prb))
+                    {
+                        N_free++;
+                    }
+                }
+                if(N_free > best_N_free)
+                {
+                    best_N_free      = N_free;
+                    rb_alloc->subset = p;
+                }
+            }
+            for(i=0; i<N_type1 && rb_alloc->N_prb<N_prb_max; i++)
+            {
+                prb = (i/P)*P*P + rb_alloc->subset*P + (i%P);
+                if(prb < mask->N_rb &&
+                   prb_mask_is_prb_free(mask, prb))
+                {
+                    rb_alloc->prb[rb_alloc->N_prb++]  = prb;
+                    rb_alloc->rbg_bitmap             |= 1 << (N_type1 - 1 - i);
+                }
+            }
+        }else{
+            // First run of free PRBs long enough, otherwise the longest run
+            best_start = 0;
+            best_len   = 0;
+            run_start  = 0;
+            run_len    = 0;
+            for(prb=0; prb<mask->N_rb && best_len<N_prb_max; prb++)
+            {
+                if(prb_mask_is_prb_free(mask, prb))
+                {
+                    if(0 == run_len)
+                    {
+                        run_start = prb;
+                    }
+                    run_len++;
+                    if(run_len > best_len)
+                    {
+                        best_start = run_start;
+                        best_len   = run_len;
+                    }
+                }else{
+                    run_len = 0;
+                }
+            }
+            for(i=0; i<best_len && i<N_prb_max; i++)
+            {
+                rb_alloc->prb[rb_alloc->N_prb++] = best_start + i;
+            }
+            if(0 != rb_alloc->N_prb)
+            {
+                if((rb_alloc->N_prb - 1) <= (mask->N_rb / 2))
+                {
+                    rb_alloc->riv = mask->N_rb*(rb_alloc->N_prb - 1) + best_start;
+                }else{
+                    rb_alloc->riv = mask->N_rb*(mask->N_rb - rb_alloc->N_prb + 1) + (mask->N_rb - 1 - best_start);
+                }
+            }
+        }
+
+        if(rb_alloc->N_prb >= N_prb_min)
+        {
+            liblte_mac_prb_mask_set_list(mask, rb_alloc->prb, rb_alloc->N_prb);
+            err = LIBLTE_SUCCESS;
+        }else{
+            rb_alloc->N_prb = 0;
+            err             = LIBLTE_ERROR_DECODE_FAIL;
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: Scheduler
+
+    Description: Picks the users served in a TTI using a round robin,
+                 maximum C/I, or proportional fair policy and
+                 allocates their PRBs from a PRB mask
+
+    Document Reference: N/A
+
+    Notes: Users with a HARQ retransmission pending are always
+           served first, followed by users owed data on a GBR
+           bearer.  The policy metric is scaled by qos_weight,
+           which callers derive from the priority of the bearers
+           with data.  The achievable rate of a user is
+           estimated from its wideband CQI using the spectral
+           efficiencies of 36.213 v10.3.0 table 7.2.3-1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_mac_sched_init(LIBLTE_MAC_SCHED_STRUCT      *sched,
+                                        LIBLTE_MAC_SCHED_POLICY_ENUM  policy,
+                                        LIBLTE_MAC_RA_TYPE_ENUM       ra_type)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(sched   != NULL                            &&
+       policy  <  LIBLTE_MAC_SCHED_POLICY_N_ITEMS &&
+       ra_type <  LIBLTE_MAC_RA_TYPE_N_ITEMS)
+    {
+        sched->policy   = policy;
+        sched->ra_type  = ra_type;
+        sched->pf_alpha = 1.0 / LIBLTE_MAC_SCHED_PF_WINDOW_TTIS;
+        sched->tti      = 0;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_mac_sched_ue_init(LIBLTE_MAC_SCHED_UE_STRUCT *ue,
+                                           uint16                      rnti)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(ue != NULL)
+    {
+        ue->avg_tput   = 0;
+        ue->qos_weight = 1;
+        ue->last_tti   = 0;
+        ue->N_prb_min  = 0;
+        ue->N_prb_max  = 0;
+        ue->rnti       = rnti;
+        ue->cqi        = 0;
+        ue->retx       = false;
+        ue->gbr        = false;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+uint32 liblte_mac_sched_bits_per_prb(uint8 cqi)
+{
+    // Assume 120 data REs per PRB pair, i.e. 2 control symbols and reference signals removed
+    return((cqi_efficiency[cqi & 0xF] * 120) / 1024);
+}
+LIBLTE_ERROR_ENUM liblte_mac_sched_run(LIBLTE_MAC_SCHED_STRUCT       *sched,
+                                       LIBLTE_MAC_SCHED_UE_STRUCT    *ue,
+                                       uint32                         N_ue,
+                                       LIBLTE_MAC_PRB_MASK_STRUCT    *mask,
+                                       uint32                         N_grant_max,
+                                       LIBLTE_MAC_SCHED_GRANT_STRUCT *grant,
+                                       uint32                        *N_grant)
+{
+    LIBLTE_ERROR_ENUM   err = LIBLTE_ERROR_INVALID_INPUTS;
+    SCHED_METRIC_STRUCT metric[LIBLTE_MAC_SCHED_N_UE_MAX];
+    float               served[LIBLTE_MAC_SCHED_N_UE_MAX];
+    float               rate;
+    uint32              N_metric = 0;
+    uint32              i;
+    uint32              idx;
+
+    if(sched   != NULL                      &&
+       ue      != NULL                      &&
+       N_ue    <= LIBLTE_MAC_SCHED_N_UE_MAX &&
+       mask    != NULL                      &&
+       grant   != NULL                      &&
+       N_grant != NULL)
+    {
+        sched->tti++;
+        *N_grant = 0;
+
+        // Rank the users that have something to send
+        for(i=0; i<N_ue; i++)
+        {
+            served[i] = 0;
+            if(0 != ue[i].N_prb_max)
+            {
+                // Out of range users still get the lowest rate so they are not starved
+                rate = (float)liblte_mac_sched_bits_per_prb(ue[i].cqi < 1 ? 1 : ue[i].cqi);
+                if(LIBLTE_MAC_SCHED_POLICY_ROUND_ROBIN == sched->policy)
+                {
+                    metric[N_metric].metric = (float)(sched->tti - ue[i].last_tti);
+                }else if(LIBLTE_MAC_SCHED_POLICY_MAX_CI == sched->policy){
+                    metric[N_metric].metric = rate;
+                }else{
+                    metric[N_metric].metric = rate / (ue[i].avg_tput + 1);
+                }
+                metric[N_metric].metric *= ue[i].qos_weight;
+
+                // Retransmissions, then GBR bearers, outrank any metric
+                metric[N_metric].tier = 0;
+                if(ue[i].retx)
+                {
+                    metric[N_metric].tier = 2;
+                }else if(ue[i].gbr){
+                    metric[N_metric].tier = 1;
+                }
+                metric[N_metric].idx = i;
+                N_metric++;
+            }
+        }
+        qsort(metric, N_metric, sizeof(SCHED_METRIC_STRUCT), sched_metric_compare);
+
+        // Serve users in metric order until PRBs or grants run out
+        for(i=0; i<N_metric && *N_grant<N_grant_max; i++)
+        {
+            idx = metric[i].idx;
+            if(LIBLTE_SUCCESS == liblte_mac_alloc_prbs(mask,
+                                                       sched->ra_type,
+                                                       ue[idx].N_prb_min,
+                                                       ue[idx].N_prb_max,
+                                                       &grant[*N_grant].rb_alloc))
+            {
+                grant[*N_grant].ue_idx = idx;
+                grant[*N_grant].N_bits = grant[*N_grant].rb_alloc.N_prb * liblte_mac_sched_bits_per_prb(ue[idx].cqi);
+                served[idx]            = (float)grant[*N_grant].N_bits;
+                ue[idx].last_tti       = sched->tti;
+                (*N_grant)++;
+            }
+        }
+
+        // Update the average throughput of every backlogged user
+        for(i=0; i<N_ue; i++)
+        {
+            if(0 != ue[i].N_prb_max)
+            {
+                ue[i].avg_tput = (1 - sched->pf_alpha)*ue[i].avg_tput + sched->pf_alpha*served[i];
+            }
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*******************************************************************************
+                              LOCAL FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: prb_mask_is_prb_free
+
+    Description: Checks whether a single PRB of a PRB mask is free
+*********************************************************************/
+bool prb_mask_is_prb_free(LIBLTE_MAC_PRB_MASK_STRUCT *mask,
+                          uint32                      prb)
+{
+    return(0 == (mask->word[prb/32] & (1 << (prb%32))));
+}
+
+/*********************************************************************
+    Name: sched_metric_compare
+
+    Description: qsort comparison function that orders scheduler
+                 metrics from highest to lowest
+*********************************************************************/
+int sched_metric_compare(const void *a,
+                         const void *b)
+{
+    const SCHED_METRIC_STRUCT *m_a = (const SCHED_METRIC_STRUCT *)a;
+    const SCHED_METRIC_STRUCT *m_b = (const SCHED_METRIC_STRUCT *)b;
+    int                        ret = 0;
+
+    if(m_a->tier > m_b->tier)
+    {
+        ret = -1;
+    }else if(m_a->tier < m_b->tier){
+        ret = 1;
+    }else if(m_a->metric > m_b->metric){
+        ret = -1;
+    }else if(m_a->metric < m_b->metric){
+        ret = 1;
+    }else if(m_a->idx < m_b->idx){
+        ret = -1;
+    }else if(m_a->idx > m_b->idx){
+        ret = 1;
+    }
+
+    return(ret);
+}
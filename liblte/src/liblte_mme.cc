@@ -55,6 +55,25 @@
 *******************************************************************************/
 
 
+/*******************************************************************************
+                              LOCAL FUNCTION PROTOTYPES
+*******************************************************************************/
+
+/*********************************************************************
+    Name: check_ie_size
+
+    Description: Checks that an IE fits within the message.  The IE
+                 starts with N_fixed octets, followed by an N_len
+                 octet length indicator and the contents it gives.
+                 A fixed size IE has an N_len of 0.
+
+    Document Reference: 24.007 v10.0.0 Section 11.2.1.1
+*********************************************************************/
+LIBLTE_ERROR_ENUM check_ie_size(uint8  *ie_ptr,
+                                uint8  *msg_end,
+                                uint32  N_fixed,
+                                uint32  N_len);
+
 /*******************************************************************************
                               INFORMATION ELEMENT FUNCTIONS
 *******************************************************************************/
@@ -295,27 +314,47 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_mobile_id_ie(LIBLTE_MME_MOBILE_ID_STRUCT  *mob
     LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_INPUTS;
     uint8             *id;
     uint32             i;
+    bool               odd = false;
 
     if(mobile_id != NULL &&
        ie_ptr    != NULL)
     {
         if(LIBLTE_MME_MOBILE_ID_TYPE_IMSI == mobile_id->type_of_id)
         {
-            id = mobile_id->imsi;
+            id  = mobile_id->imsi;
+            odd = true;
         }else if(LIBLTE_MME_MOBILE_ID_TYPE_IMEI == mobile_id->type_of_id){
-            id = mobile_id->imei;
+            id  = mobile_id->imei;
+            odd = true;
+        }else if(LIBLTE_MME_MOBILE_ID_TYPE_IMEISV == mobile_id->type_of_id){
+            id  = mobile_id->imeisv;
+            odd = false;
         }else{
             // FIXME: Not handling these IDs
             return(err);
         }
 
-        **ie_ptr  = (id[0] << 4) | (1 << 3) | mobile_id->type_of_id;
+        if(odd)
+        {
+            **ie_ptr = 8;
+        }else{
+            **ie_ptr = 9;
+        }
+        *ie_ptr += 1;
+
+        **ie_ptr  = (id[0] << 4) | (odd << 3) | mobile_id->type_of_id;
         *ie_ptr  += 1;
         for(i=0; i<7; i++)
         {
             (*ie_ptr)[i] = (id[i*2+2] << 4) | id[i*2+1];
         }
-        *ie_ptr += 7;
+        if(odd)
+        {
+            *ie_ptr += 7;
+        }else{
+            (*ie_ptr)[i]  = 0xF0 | id[i*2+1];
+            *ie_ptr      += 8;
+        }
 
         err = LIBLTE_SUCCESS;
     }
@@ -1403,6 +1442,8 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_eps_mobile_id_ie(LIBLTE_MME_EPS_MOBILE_ID_STRU
                 id = eps_mobile_id->imei;
             }
 
+            **ie_ptr  = 8;
+            *ie_ptr  += 1;
             **ie_ptr  = (id[0] << 4) | (1 << 3) | eps_mobile_id->type_of_id;
             *ie_ptr  += 1;
             for(i=0; i<7; i++)
@@ -2637,7 +2678,7 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_tracking_area_identity_list_ie(uint8
         while(length < sent_length)
         {
             type    = (LIBLTE_MME_TRACKING_AREA_IDENTITY_LIST_TYPE_ENUM)(((*ie_ptr)[length] >> 5) & 0x03);
-            N_elems = (*ie_ptr)[length++] & 0x1F;
+            N_elems = ((*ie_ptr)[length++] & 0x1F) + 1;
             if(LIBLTE_MME_TRACKING_AREA_IDENTITY_LIST_TYPE_ONE_PLMN_NON_CONSECUTIVE_TACS == type)
             {
                 mcc  = ((*ie_ptr)[length] & 0x0F)*100;
@@ -3095,7 +3136,7 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_ue_security_capabilities_ie(uint8
         }else{
             ue_sec_cap->gea_present = false;
         }
-        *ie_ptr += length;
+        *ie_ptr += length + 1;
 
         err = LIBLTE_SUCCESS;
     }
@@ -3509,7 +3550,8 @@ LIBLTE_ERROR_ENUM liblte_mme_pack_access_point_name_ie(LIBLTE_MME_ACCESS_POINT_N
         label_len    = 0;
         while(apn->apn.length() > apn_idx)
         {
-            (*ie_ptr)[1+apn_idx+1] = (uint8)apn_str[apn_idx++];
+            (*ie_ptr)[1+apn_idx+1] = (uint8)apn_str[apn_idx];
+            apn_idx++;
             label_len++;
 
             if(apn_str[apn_idx] == '.')
@@ -3771,7 +3813,7 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_eps_quality_of_service_ie(uint8
         {
             qos->br_present     = false;
             qos->br_ext_present = false;
-        }else if((*ie_ptr)[1] == 5){
+        }else if((*ie_ptr)[0] == 5){
             qos->br_present     = true;
             qos->br_ext_present = false;
         }else{
@@ -4134,7 +4176,7 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_pdn_address_ie(uint8
                 pdn_addr->addr[i] = (*ie_ptr)[2+i];
             }
         }
-        *ie_ptr += (*ie_ptr)[0];
+        *ie_ptr += (*ie_ptr)[0] + 1;
 
         err = LIBLTE_SUCCESS;
     }
@@ -4236,22 +4278,31 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_protocol_config_options_ie(uint8
     if(ie_ptr             != NULL &&
        protocol_cnfg_opts != NULL)
     {
+        err                        = LIBLTE_SUCCESS;
         idx                        = 2;
         protocol_cnfg_opts->N_opts = 0;
-        while(idx < (*ie_ptr)[0])
-        {
-            protocol_cnfg_opts->opt[protocol_cnfg_opts->N_opts].id   = (*ie_ptr)[idx++] << 8;
-            protocol_cnfg_opts->opt[protocol_cnfg_opts->N_opts].id  |= (*ie_ptr)[idx++];
-            protocol_cnfg_opts->opt[protocol_cnfg_opts->N_opts].len  = (*ie_ptr)[idx++];
-            for(i=0; i<protocol_cnfg_opts->opt[protocol_cnfg_opts->N_opts].len; i++)
+        while(LIBLTE_SUCCESS == err &&
+              idx            <  (*ie_ptr)[0])
+        {
+            // Each option must fit within the IE and the options struct
+            if(LIBLTE_MME_MAX_PROTOCOL_CONFIG_OPTIONS >  protocol_cnfg_opts->N_opts    &&
+               (*ie_ptr)[0]                           >= idx + 2                       &&
+               (*ie_ptr)[0]                           >= idx + 2 + (*ie_ptr)[idx+2]    &&
+               LIBLTE_MME_MAX_PROTOCOL_CONFIG_LEN     >= (*ie_ptr)[idx+2])
             {
-                protocol_cnfg_opts->opt[protocol_cnfg_opts->N_opts].contents[i] = (*ie_ptr)[idx++];
+                protocol_cnfg_opts->opt[protocol_cnfg_opts->N_opts].id   = (*ie_ptr)[idx++] << 8;
+                protocol_cnfg_opts->opt[protocol_cnfg_opts->N_opts].id  |= (*ie_ptr)[idx++];
+                protocol_cnfg_opts->opt[protocol_cnfg_opts->N_opts].len  = (*ie_ptr)[idx++];
+                for(i=0; i<protocol_cnfg_opts->opt[protocol_cnfg_opts->N_opts].len; i++)
+                {
+                    protocol_cnfg_opts->opt[protocol_cnfg_opts->N_opts].contents[i] = (*ie_ptr)[idx++];
+                }
+                protocol_cnfg_opts->N_opts++;
+            }else{
+                err = LIBLTE_ERROR_DECODE_FAIL;
             }
-            protocol_cnfg_opts->N_opts++;
         }
         *ie_ptr += (*ie_ptr)[0] + 1;
-
-        err = LIBLTE_SUCCESS;
     }
 
     return(err);
@@ -5472,6 +5523,7 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_attach_request_msg(LIBLTE_BYTE_MSG_STRUCT
 {
     LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
     uint8             *msg_ptr = msg->msg;
+    uint8             *msg_end = msg->msg + msg->N_bytes;
     uint8              sec_hdr_type;
 
     if(msg        != NULL &&
@@ -5490,160 +5542,228 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_attach_request_msg(LIBLTE_BYTE_MSG_STRUCT
         msg_ptr++;
 
         // EPS Attach Type & NAS Key Set Identifier
-        liblte_mme_unpack_eps_attach_type_ie(&msg_ptr, 0, &attach_req->eps_attach_type);
-        liblte_mme_unpack_nas_key_set_id_ie(&msg_ptr, 4, &attach_req->nas_ksi);
-        msg_ptr++;
+        err = check_ie_size(msg_ptr, msg_end, 1, 0);
+        if(LIBLTE_SUCCESS == err)
+        {
+            liblte_mme_unpack_eps_attach_type_ie(&msg_ptr, 0, &attach_req->eps_attach_type);
+            liblte_mme_unpack_nas_key_set_id_ie(&msg_ptr, 4, &attach_req->nas_ksi);
+            msg_ptr++;
 
-        // EPS Mobile ID
-        liblte_mme_unpack_eps_mobile_id_ie(&msg_ptr, &attach_req->eps_mobile_id);
+            // EPS Mobile ID
+            err = check_ie_size(msg_ptr, msg_end, 0, 1);
+        }
+        if(LIBLTE_SUCCESS == err)
+        {
+            liblte_mme_unpack_eps_mobile_id_ie(&msg_ptr, &attach_req->eps_mobile_id);
 
-        // UE Network Capability
-        liblte_mme_unpack_ue_network_capability_ie(&msg_ptr, &attach_req->ue_network_cap);
+            // UE Network Capability
+            err = check_ie_size(msg_ptr, msg_end, 0, 1);
+        }
+        if(LIBLTE_SUCCESS == err)
+        {
+            liblte_mme_unpack_ue_network_capability_ie(&msg_ptr, &attach_req->ue_network_cap);
 
-        // ESM Message Container
-        liblte_mme_unpack_esm_message_container_ie(&msg_ptr, &attach_req->esm_msg);
+            // ESM Message Container
+            err = check_ie_size(msg_ptr, msg_end, 0, 2);
+        }
+        if(LIBLTE_SUCCESS == err)
+        {
+            liblte_mme_unpack_esm_message_container_ie(&msg_ptr, &attach_req->esm_msg);
+        }
 
         // Old P-TMSI Signature
-        if(LIBLTE_MME_P_TMSI_SIGNATURE_IEI == *msg_ptr)
+        attach_req->old_p_tmsi_signature_present = false;
+        if(LIBLTE_SUCCESS                  == err     &&
+           msg_ptr                         <  msg_end &&
+           LIBLTE_MME_P_TMSI_SIGNATURE_IEI == *msg_ptr)
         {
-            msg_ptr++;
-            liblte_mme_unpack_p_tmsi_signature_ie(&msg_ptr, &attach_req->old_p_tmsi_signature);
-            attach_req->old_p_tmsi_signature_present = true;
-        }else{
-            attach_req->old_p_tmsi_signature_present = false;
+            err = check_ie_size(msg_ptr, msg_end, 4, 0);
+            if(LIBLTE_SUCCESS == err)
+            {
+                msg_ptr++;
+                liblte_mme_unpack_p_tmsi_signature_ie(&msg_ptr, &attach_req->old_p_tmsi_signature);
+                attach_req->old_p_tmsi_signature_present = true;
+            }
         }
 
         // Additional GUTI
-        if(LIBLTE_MME_ADDITIONAL_GUTI_IEI == *msg_ptr)
+        attach_req->additional_guti_present = false;
+        if(LIBLTE_SUCCESS                 == err     &&
+           msg_ptr                        <  msg_end &&
+           LIBLTE_MME_ADDITIONAL_GUTI_IEI == *msg_ptr)
         {
-            msg_ptr++;
-            liblte_mme_unpack_eps_mobile_id_ie(&msg_ptr, &attach_req->additional_guti);
-            attach_req->additional_guti_present = true;
-        }else{
-            attach_req->additional_guti_present = false;
+            err = check_ie_size(msg_ptr, msg_end, 1, 1);
+            if(LIBLTE_SUCCESS == err)
+            {
+                msg_ptr++;
+                liblte_mme_unpack_eps_mobile_id_ie(&msg_ptr, &attach_req->additional_guti);
+                attach_req->additional_guti_present = true;
+            }
         }
 
         // Last Visited Registered TAI
-        if(LIBLTE_MME_LAST_VISITED_REGISTERED_TAI_IEI == *msg_ptr)
+        attach_req->last_visited_registered_tai_present = false;
+        if(LIBLTE_SUCCESS                             == err     &&
+           msg_ptr                                    <  msg_end &&
+           LIBLTE_MME_LAST_VISITED_REGISTERED_TAI_IEI == *msg_ptr)
         {
-            msg_ptr++;
-            liblte_mme_unpack_tracking_area_id_ie(&msg_ptr, &attach_req->last_visited_registered_tai);
-            attach_req->last_visited_registered_tai_present = true;
-        }else{
-            attach_req->last_visited_registered_tai_present = false;
+            err = check_ie_size(msg_ptr, msg_end, 6, 0);
+            if(LIBLTE_SUCCESS == err)
+            {
+                msg_ptr++;
+                liblte_mme_unpack_tracking_area_id_ie(&msg_ptr, &attach_req->last_visited_registered_tai);
+                attach_req->last_visited_registered_tai_present = true;
+            }
         }
 
         // DRX Parameter
-        if(LIBLTE_MME_DRX_PARAMETER_IEI == *msg_ptr)
+        attach_req->drx_param_present = false;
+        if(LIBLTE_SUCCESS               == err     &&
+           msg_ptr                      <  msg_end &&
+           LIBLTE_MME_DRX_PARAMETER_IEI == *msg_ptr)
         {
-            msg_ptr++;
-            liblte_mme_unpack_drx_parameter_ie(&msg_ptr, &attach_req->drx_param);
-            attach_req->drx_param_present = true;
-        }else{
-            attach_req->drx_param_present = false;
+            err = check_ie_size(msg_ptr, msg_end, 3, 0);
+            if(LIBLTE_SUCCESS == err)
+            {
+                msg_ptr++;
+                liblte_mme_unpack_drx_parameter_ie(&msg_ptr, &attach_req->drx_param);
+                attach_req->drx_param_present = true;
+            }
         }
 
         // MS Network Capability
-        if(LIBLTE_MME_MS_NETWORK_CAPABILITY_IEI == *msg_ptr)
+        attach_req->ms_network_cap_present = false;
+        if(LIBLTE_SUCCESS                       == err     &&
+           msg_ptr                              <  msg_end &&
+           LIBLTE_MME_MS_NETWORK_CAPABILITY_IEI == *msg_ptr)
         {
-            msg_ptr++;
-            liblte_mme_unpack_ms_network_capability_ie(&msg_ptr, &attach_req->ms_network_cap);
-            attach_req->ms_network_cap_present = true;
-        }else{
-            attach_req->ms_network_cap_present = false;
+            err = check_ie_size(msg_ptr, msg_end, 1, 1);
+            if(LIBLTE_SUCCESS == err)
+            {
+                msg_ptr++;
+                liblte_mme_unpack_ms_network_capability_ie(&msg_ptr, &attach_req->ms_network_cap);
+                attach_req->ms_network_cap_present = true;
+            }
         }
 
         // Old Location Area ID
-        if(LIBLTE_MME_LOCATION_AREA_IDENTIFICATION_IEI == *msg_ptr)
+        attach_req->old_lai_present = false;
+        if(LIBLTE_SUCCESS                              == err     &&
+           msg_ptr                                     <  msg_end &&
+           LIBLTE_MME_LOCATION_AREA_IDENTIFICATION_IEI == *msg_ptr)
         {
-            msg_ptr++;
-            liblte_mme_unpack_location_area_id_ie(&msg_ptr, &attach_req->old_lai);
-            attach_req->old_lai_present = true;
-        }else{
-            attach_req->old_lai_present = false;
+            err = check_ie_size(msg_ptr, msg_end, 6, 0);
+            if(LIBLTE_SUCCESS == err)
+            {
+                msg_ptr++;
+                liblte_mme_unpack_location_area_id_ie(&msg_ptr, &attach_req->old_lai);
+                attach_req->old_lai_present = true;
+            }
         }
 
         // TMSI Status
-        if((LIBLTE_MME_TMSI_STATUS_IEI << 4) == (*msg_ptr & 0xF0))
+        attach_req->tmsi_status_present = false;
+        if(LIBLTE_SUCCESS                    == err     &&
+           msg_ptr                           <  msg_end &&
+           (LIBLTE_MME_TMSI_STATUS_IEI << 4) == (*msg_ptr & 0xF0))
         {
             liblte_mme_unpack_tmsi_status_ie(&msg_ptr, 0, &attach_req->tmsi_status);
             msg_ptr++;
             attach_req->tmsi_status_present = true;
-        }else{
-            attach_req->tmsi_status_present = false;
         }
 
         // Mobile Station Classmark 2
-        if(LIBLTE_MME_MS_CLASSMARK_2_IEI == *msg_ptr)
+        attach_req->ms_cm2_present = false;
+        if(LIBLTE_SUCCESS                == err     &&
+           msg_ptr                       <  msg_end &&
+           LIBLTE_MME_MS_CLASSMARK_2_IEI == *msg_ptr)
         {
-            msg_ptr++;
-            liblte_mme_unpack_mobile_station_classmark_2_ie(&msg_ptr, &attach_req->ms_cm2);
-            attach_req->ms_cm2_present = true;
-        }else{
-            attach_req->ms_cm2_present = false;
+            err = check_ie_size(msg_ptr, msg_end, 1, 1);
+            if(LIBLTE_SUCCESS == err)
+            {
+                msg_ptr++;
+                liblte_mme_unpack_mobile_station_classmark_2_ie(&msg_ptr, &attach_req->ms_cm2);
+                attach_req->ms_cm2_present = true;
+            }
         }
 
         // Mobile Station Classmark 3
-        if(LIBLTE_MME_MS_CLASSMARK_3_IEI == *msg_ptr)
+        attach_req->ms_cm3_present = false;
+        if(LIBLTE_SUCCESS                == err     &&
+           msg_ptr                       <  msg_end &&
+           LIBLTE_MME_MS_CLASSMARK_3_IEI == *msg_ptr)
         {
-            msg_ptr++;
-            liblte_mme_unpack_mobile_station_classmark_3_ie(&msg_ptr, &attach_req->ms_cm3);
-            attach_req->ms_cm3_present = true;
-        }else{
-            attach_req->ms_cm3_present = false;
+            err = check_ie_size(msg_ptr, msg_end, 1, 1);
+            if(LIBLTE_SUCCESS == err)
+            {
+                msg_ptr++;
+                liblte_mme_unpack_mobile_station_classmark_3_ie(&msg_ptr, &attach_req->ms_cm3);
+                attach_req->ms_cm3_present = true;
+            }
         }
 
         // Supported Codecs
-        if(LIBLTE_MME_SUPPORTED_CODEC_LIST_IEI == *msg_ptr)
+        attach_req->supported_codecs_present = false;
+        if(LIBLTE_SUCCESS                      == err     &&
+           msg_ptr                             <  msg_end &&
+           LIBLTE_MME_SUPPORTED_CODEC_LIST_IEI == *msg_ptr)
         {
-            msg_ptr++;
-            liblte_mme_unpack_supported_codec_list_ie(&msg_ptr, &attach_req->supported_codecs);
-            attach_req->supported_codecs_present = true;
-        }else{
-            attach_req->supported_codecs_present = false;
+            err = check_ie_size(msg_ptr, msg_end, 1, 1);
+            if(LIBLTE_SUCCESS == err)
+            {
+                msg_ptr++;
+                liblte_mme_unpack_supported_codec_list_ie(&msg_ptr, &attach_req->supported_codecs);
+                attach_req->supported_codecs_present = true;
+            }
         }
 
         // Additional Update Type
-        if((LIBLTE_MME_ADDITIONAL_UPDATE_TYPE_IEI << 4) == (*msg_ptr & 0xF0))
+        attach_req->additional_update_type_present = false;
+        if(LIBLTE_SUCCESS                               == err     &&
+           msg_ptr                                      <  msg_end &&
+           (LIBLTE_MME_ADDITIONAL_UPDATE_TYPE_IEI << 4) == (*msg_ptr & 0xF0))
         {
             liblte_mme_unpack_additional_update_type_ie(&msg_ptr, 0, &attach_req->additional_update_type);
             msg_ptr++;
             attach_req->additional_update_type_present = true;
-        }else{
-            attach_req->additional_update_type_present = false;
         }
 
         // Voice Domain Preference and UE's Usage Setting
-        if(LIBLTE_MME_VOICE_DOMAIN_PREF_AND_UE_USAGE_SETTING_IEI == *msg_ptr)
+        attach_req->voice_domain_pref_and_ue_usage_setting_present = false;
+        if(LIBLTE_SUCCESS                                        == err     &&
+           msg_ptr                                               <  msg_end &&
+           LIBLTE_MME_VOICE_DOMAIN_PREF_AND_UE_USAGE_SETTING_IEI == *msg_ptr)
         {
-            msg_ptr++;
-            liblte_mme_unpack_voice_domain_pref_and_ue_usage_setting_ie(&msg_ptr, &attach_req->voice_domain_pref_and_ue_usage_setting);
-            attach_req->voice_domain_pref_and_ue_usage_setting_present = true;
-        }else{
-            attach_req->voice_domain_pref_and_ue_usage_setting_present = false;
+            err = check_ie_size(msg_ptr, msg_end, 1, 1);
+            if(LIBLTE_SUCCESS == err)
+            {
+                msg_ptr++;
+                liblte_mme_unpack_voice_domain_pref_and_ue_usage_setting_ie(&msg_ptr, &attach_req->voice_domain_pref_and_ue_usage_setting);
+                attach_req->voice_domain_pref_and_ue_usage_setting_present = true;
+            }
         }
 
         // Device Properties
-        if((LIBLTE_MME_ATTACH_REQUEST_DEVICE_PROPERTIES_IEI << 4) == (*msg_ptr & 0xF0))
+        attach_req->device_properties_present = false;
+        if(LIBLTE_SUCCESS                                         == err     &&
+           msg_ptr                                                <  msg_end &&
+           (LIBLTE_MME_ATTACH_REQUEST_DEVICE_PROPERTIES_IEI << 4) == (*msg_ptr & 0xF0))
         {
             liblte_mme_unpack_device_properties_ie(&msg_ptr, 0, &attach_req->device_properties);
             msg_ptr++;
             attach_req->device_properties_present = true;
-        }else{
-            attach_req->device_properties_present = false;
         }
 
         // Old GUTI Type
-        if((LIBLTE_MME_GUTI_TYPE_IEI << 4) == (*msg_ptr & 0xF0))
+        attach_req->old_guti_type_present = false;
+        if(LIBLTE_SUCCESS                  == err     &&
+           msg_ptr                         <  msg_end &&
+           (LIBLTE_MME_GUTI_TYPE_IEI << 4) == (*msg_ptr & 0xF0))
         {
             liblte_mme_unpack_guti_type_ie(&msg_ptr, 0, &attach_req->old_guti_type);
             msg_ptr++;
             attach_req->old_guti_type_present = true;
-        }else{
-            attach_req->old_guti_type_present = false;
         }
-
-        err = LIBLTE_SUCCESS;
     }
 
     return(err);
@@ -5919,6 +6039,7 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_authentication_response_msg(LIBLTE_BYTE_MSG_
 {
     LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
     uint8             *msg_ptr = msg->msg;
+    uint8             *msg_end = msg->msg + msg->N_bytes;
     uint8              sec_hdr_type;
 
     if(msg       != NULL &&
@@ -5936,10 +6057,17 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_authentication_response_msg(LIBLTE_BYTE_MSG_
         // Skip Message Type
         msg_ptr++;
 
-        // Authentication Response Parameter (RES)
-        liblte_mme_unpack_authentication_response_parameter_ie(&msg_ptr, auth_resp->res);
-
-        err = LIBLTE_SUCCESS;
+        // Authentication Response Parameter (RES), at most 16 octets
+        err = check_ie_size(msg_ptr, msg_end, 0, 1);
+        if(LIBLTE_SUCCESS == err &&
+           16             <  msg_ptr[0])
+        {
+            err = LIBLTE_ERROR_DECODE_FAIL;
+        }
+        if(LIBLTE_SUCCESS == err)
+        {
+            liblte_mme_unpack_authentication_response_parameter_ie(&msg_ptr, auth_resp->res);
+        }
     }
 
     return(err);
@@ -7409,6 +7537,7 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_service_request_msg(LIBLTE_BYTE_MSG_STRUCT
 {
     LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
     uint8             *msg_ptr = msg->msg;
+    uint8             *msg_end = msg->msg + msg->N_bytes;
 
     if(msg         != NULL &&
        service_req != NULL)
@@ -7416,13 +7545,13 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_service_request_msg(LIBLTE_BYTE_MSG_STRUCT
         // Protocol Discriminator and Security Header Type
         msg_ptr++;
 
-        // KSI and Sequence Number
-        liblte_mme_unpack_ksi_and_sequence_number_ie(&msg_ptr, &service_req->ksi_and_seq_num);
-
-        // Short MAC
-        liblte_mme_unpack_short_mac_ie(&msg_ptr, &service_req->short_mac);
-
-        err = LIBLTE_SUCCESS;
+        // KSI and Sequence Number & Short MAC
+        err = check_ie_size(msg_ptr, msg_end, 3, 0);
+        if(LIBLTE_SUCCESS == err)
+        {
+            liblte_mme_unpack_ksi_and_sequence_number_ie(&msg_ptr, &service_req->ksi_and_seq_num);
+            liblte_mme_unpack_short_mac_ie(&msg_ptr, &service_req->short_mac);
+        }
     }
 
     return(err);
@@ -10167,67 +10296,83 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_pdn_connectivity_request_msg(LIBLTE_BYTE_MSG
 {
     LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
     uint8             *msg_ptr = msg->msg;
+    uint8             *msg_end = msg->msg + msg->N_bytes;
 
     if(msg         != NULL &&
        pdn_con_req != NULL)
     {
-        // EPS Bearer ID
-        pdn_con_req->eps_bearer_id = (*msg_ptr >> 4);
-        msg_ptr++;
+        // EPS Bearer ID, Procedure Transaction ID, Message Type, Request Type & PDN Type
+        err = check_ie_size(msg_ptr, msg_end, 4, 0);
+        if(LIBLTE_SUCCESS == err)
+        {
+            // EPS Bearer ID
+            pdn_con_req->eps_bearer_id = (*msg_ptr >> 4);
+            msg_ptr++;
 
-        // Procedure Transaction ID
-        pdn_con_req->proc_transaction_id = *msg_ptr;
-        msg_ptr++;
+            // Procedure Transaction ID
+            pdn_con_req->proc_transaction_id = *msg_ptr;
+            msg_ptr++;
 
-        // Skip Message Type
-        msg_ptr++;
+            // Skip Message Type
+            msg_ptr++;
 
-        // Request Type & PDN Type
-        liblte_mme_unpack_request_type_ie(&msg_ptr, 0, &pdn_con_req->request_type);
-        liblte_mme_unpack_pdn_type_ie(&msg_ptr, 4, &pdn_con_req->pdn_type);
-        msg_ptr++;
+            // Request Type & PDN Type
+            liblte_mme_unpack_request_type_ie(&msg_ptr, 0, &pdn_con_req->request_type);
+            liblte_mme_unpack_pdn_type_ie(&msg_ptr, 4, &pdn_con_req->pdn_type);
+            msg_ptr++;
+        }
 
         // ESM Information Transfer Flag
-        if((LIBLTE_MME_ESM_INFO_TRANSFER_FLAG_IEI << 4) == (*msg_ptr & 0xF0))
+        pdn_con_req->esm_info_transfer_flag_present = false;
+        if(LIBLTE_SUCCESS                               == err     &&
+           msg_ptr                                      <  msg_end &&
+           (LIBLTE_MME_ESM_INFO_TRANSFER_FLAG_IEI << 4) == (*msg_ptr & 0xF0))
         {
             liblte_mme_unpack_esm_info_transfer_flag_ie(&msg_ptr, 0, &pdn_con_req->esm_info_transfer_flag);
             msg_ptr++;
             pdn_con_req->esm_info_transfer_flag_present = true;
-        }else{
-            pdn_con_req->esm_info_transfer_flag_present = false;
         }
 
         // Access Point Name
-        if(LIBLTE_MME_ACCESS_POINT_NAME_IEI == *msg_ptr)
+        pdn_con_req->apn_present = false;
+        if(LIBLTE_SUCCESS                   == err     &&
+           msg_ptr                          <  msg_end &&
+           LIBLTE_MME_ACCESS_POINT_NAME_IEI == *msg_ptr)
         {
-            msg_ptr++;
-            liblte_mme_unpack_access_point_name_ie(&msg_ptr, &pdn_con_req->apn);
-            pdn_con_req->apn_present = true;
-        }else{
-            pdn_con_req->apn_present = false;
+            err = check_ie_size(msg_ptr, msg_end, 1, 1);
+            if(LIBLTE_SUCCESS == err)
+            {
+                msg_ptr++;
+                liblte_mme_unpack_access_point_name_ie(&msg_ptr, &pdn_con_req->apn);
+                pdn_con_req->apn_present = true;
+            }
         }
 
         // Protocol Configuration Options
-        if(LIBLTE_MME_PROTOCOL_CONFIGURATION_OPTIONS_IEI == *msg_ptr)
+        pdn_con_req->protocol_cnfg_opts_present = false;
+        if(LIBLTE_SUCCESS                                == err     &&
+           msg_ptr                                       <  msg_end &&
+           LIBLTE_MME_PROTOCOL_CONFIGURATION_OPTIONS_IEI == *msg_ptr)
         {
-            msg_ptr++;
-            liblte_mme_unpack_protocol_config_options_ie(&msg_ptr, &pdn_con_req->protocol_cnfg_opts);
-            pdn_con_req->protocol_cnfg_opts_present = true;
-        }else{
-            pdn_con_req->protocol_cnfg_opts_present = false;
+            err = check_ie_size(msg_ptr, msg_end, 1, 1);
+            if(LIBLTE_SUCCESS == err)
+            {
+                msg_ptr++;
+                err = liblte_mme_unpack_protocol_config_options_ie(&msg_ptr, &pdn_con_req->protocol_cnfg_opts);
+                pdn_con_req->protocol_cnfg_opts_present = true;
+            }
         }
 
         // Device Properties
-        if((LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_DEVICE_PROPERTIES_IEI << 4) == (*msg_ptr & 0xF0))
+        pdn_con_req->device_properties_present = false;
+        if(LIBLTE_SUCCESS                                                   == err     &&
+           msg_ptr                                                          <  msg_end &&
+           (LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_DEVICE_PROPERTIES_IEI << 4) == (*msg_ptr & 0xF0))
         {
             liblte_mme_unpack_device_properties_ie(&msg_ptr, 0, &pdn_con_req->device_properties);
             msg_ptr++;
             pdn_con_req->device_properties_present = true;
-        }else{
-            pdn_con_req->device_properties_present = false;
         }
-
-        err = LIBLTE_SUCCESS;
     }
 
     return(err);
@@ -10409,3 +10554,224 @@ LIBLTE_ERROR_ENUM liblte_mme_unpack_pdn_disconnect_request_msg(LIBLTE_BYTE_MSG_S
 
     return(err);
 }
+
+/*******************************************************************************
+                              MESSAGE BUILDER FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: NAS Message Builder
+
+    Description: Serializes a NAS message directly into the output
+                 buffer.
+
+    Document Reference: 24.301 v10.2.0 Sections 9.1 and 9.9.3.15
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_mme_nas_builder_start(LIBLTE_BYTE_MSG_STRUCT        *msg,
+                                               uint8                          sec_hdr_type,
+                                               uint32                         count,
+                                               LIBLTE_MME_NAS_BUILDER_STRUCT *builder)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(msg     != NULL &&
+       builder != NULL)
+    {
+        builder->msg           = msg;
+        builder->msg_ptr       = msg->msg;
+        builder->container_ptr = NULL;
+        builder->sec_hdr_type  = sec_hdr_type;
+
+        if(LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS != sec_hdr_type)
+        {
+            // Protocol Discriminator and Security Header Type
+            *builder->msg_ptr = (sec_hdr_type << 4) | (LIBLTE_MME_PD_EPS_MOBILITY_MANAGEMENT);
+            builder->msg_ptr++;
+
+            // MAC will be filled in by liblte_mme_nas_builder_finish
+            builder->msg_ptr += 4;
+
+            // Sequence Number
+            *builder->msg_ptr = count & 0xFF;
+            builder->msg_ptr++;
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_mme_nas_builder_add_emm_header(LIBLTE_MME_NAS_BUILDER_STRUCT *builder,
+                                                        uint8                          msg_type)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(builder != NULL)
+    {
+        // Protocol Discriminator and Security Header Type
+        *builder->msg_ptr = (LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS << 4) | (LIBLTE_MME_PD_EPS_MOBILITY_MANAGEMENT);
+        builder->msg_ptr++;
+
+        // Message Type
+        *builder->msg_ptr = msg_type;
+        builder->msg_ptr++;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_mme_nas_builder_add_esm_header(LIBLTE_MME_NAS_BUILDER_STRUCT *builder,
+                                                        uint8                          eps_bearer_id,
+                                                        uint8                          proc_transaction_id,
+                                                        uint8                          msg_type)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(builder != NULL)
+    {
+        // Protocol Discriminator and EPS Bearer ID
+        *builder->msg_ptr = (eps_bearer_id << 4) | (LIBLTE_MME_PD_EPS_SESSION_MANAGEMENT);
+        builder->msg_ptr++;
+
+        // Procedure Transaction ID
+        *builder->msg_ptr = proc_transaction_id;
+        builder->msg_ptr++;
+
+        // Message Type
+        *builder->msg_ptr = msg_type;
+        builder->msg_ptr++;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_mme_nas_builder_add_iei(LIBLTE_MME_NAS_BUILDER_STRUCT *builder,
+                                                 uint8                          iei)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(builder != NULL)
+    {
+        *builder->msg_ptr = iei;
+        builder->msg_ptr++;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_mme_nas_builder_open_esm_msg_container(LIBLTE_MME_NAS_BUILDER_STRUCT *builder)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(builder                != NULL &&
+       builder->container_ptr == NULL)
+    {
+        // Length is filled in by liblte_mme_nas_builder_close_esm_msg_container
+        builder->container_ptr  = builder->msg_ptr;
+        builder->msg_ptr       += 2;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_mme_nas_builder_close_esm_msg_container(LIBLTE_MME_NAS_BUILDER_STRUCT *builder)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            N_bytes;
+
+    if(builder                != NULL &&
+       builder->container_ptr != NULL)
+    {
+        N_bytes                   = builder->msg_ptr - builder->container_ptr - 2;
+        builder->container_ptr[0] = N_bytes >> 8;
+        builder->container_ptr[1] = N_bytes & 0xFF;
+        builder->container_ptr    = NULL;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_mme_nas_builder_finish(LIBLTE_MME_NAS_BUILDER_STRUCT *builder,
+                                                uint8                         *key_256,
+                                                uint32                         count,
+                                                uint8                          direction,
+                                                uint8                          rb_id)
+{
+    LIBLTE_ERROR_ENUM       err = LIBLTE_ERROR_INVALID_INPUTS;
+    LIBLTE_BYTE_MSG_STRUCT *msg;
+
+    if(builder                != NULL &&
+       builder->container_ptr == NULL &&
+       (key_256               != NULL ||
+        builder->sec_hdr_type == LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS))
+    {
+        msg = builder->msg;
+
+        // Fill in the number of bytes used
+        msg->N_bytes = builder->msg_ptr - msg->msg;
+
+        if(LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS != builder->sec_hdr_type)
+        {
+            // Calculate MAC
+            liblte_security_128_eia2(&key_256[16],
+                                     count,
+                                     rb_id,
+                                     direction,
+                                     &msg->msg[5],
+                                     msg->N_bytes-5,
+                                     &msg->msg[1]);
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*******************************************************************************
+                              LOCAL FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: check_ie_size
+
+    Description: Checks that an IE fits within the message.  The IE
+                 starts with N_fixed octets, followed by an N_len
+                 octet length indicator and the contents it gives.
+                 A fixed size IE has an N_len of 0.
+
+    Document Reference: 24.007 v10.0.0 Section 11.2.1.1
+*********************************************************************/
+LIBLTE_ERROR_ENUM check_ie_size(uint8  *ie_ptr,
+                                uint8  *msg_end,
+                                uint32  N_fixed,
+                                uint32  N_len)
+{
+    LIBLTE_ERROR_ENUM err    = LIBLTE_ERROR_DECODE_FAIL;
+    uint32            N_left = 0;
+    uint32            size   = N_fixed + N_len;
+    uint32            i;
+
+    if(ie_ptr < msg_end)
+    {
+        N_left = msg_end - ie_ptr;
+    }
+    if(size <= N_left)
+    {
+        for(i=0; i<N_len; i++)
+        {
+            size += ie_ptr[N_fixed+i] << (8*(N_len-1-i));
+        }
+        if(size <= N_left)
+        {
+            err = LIBLTE_SUCCESS;
+        }
+    }
+
+    return(err);
+}
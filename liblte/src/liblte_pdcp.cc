@@ -37,7 +37,6 @@
 *******************************************************************************/
 
 #include "liblte_pdcp.h"
-#include "liblte_security.h"
 
 /*******************************************************************************
                               DEFINES
@@ -88,6 +87,28 @@ LIBLTE_ERROR_ENUM liblte_pdcp_pack_control_pdu(LIBLTE_PDCP_CONTROL_PDU_STRUCT *c
                                                uint8                           direction,
                                                uint8                           rb_id,
                                                LIBLTE_BYTE_MSG_STRUCT         *pdu)
+{
+    LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT  ctx;
+    LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT *ctx_ptr = NULL;
+
+    if(NULL != key_256)
+    {
+        liblte_security_128_eia2_init(&ctx, &key_256[16], rb_id, direction);
+        ctx_ptr = &ctx;
+    }
+
+    return(liblte_pdcp_pack_control_pdu(contents, data, ctx_ptr, pdu));
+}
+LIBLTE_ERROR_ENUM liblte_pdcp_pack_control_pdu(LIBLTE_PDCP_CONTROL_PDU_STRUCT       *contents,
+                                               LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT *ctx,
+                                               LIBLTE_BYTE_MSG_STRUCT               *pdu)
+{
+    return(liblte_pdcp_pack_control_pdu(contents, &contents->data, ctx, pdu));
+}
+LIBLTE_ERROR_ENUM liblte_pdcp_pack_control_pdu(LIBLTE_PDCP_CONTROL_PDU_STRUCT       *contents,
+                                               LIBLTE_BIT_MSG_STRUCT                *data,
+                                               LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT *ctx,
+                                               LIBLTE_BYTE_MSG_STRUCT               *pdu)
 {
     LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
     uint8             *pdu_ptr = pdu->msg;
@@ -121,7 +142,7 @@ LIBLTE_ERROR_ENUM liblte_pdcp_pack_control_pdu(LIBLTE_PDCP_CONTROL_PDU_STRUCT *c
         }
 
         // MAC
-        if(NULL == key_256)
+        if(NULL == ctx)
         {
             *pdu_ptr = (LIBLTE_PDCP_CONTROL_MAC_I >> 24) & 0xFF;
             pdu_ptr++;
@@ -132,13 +153,10 @@ LIBLTE_ERROR_ENUM liblte_pdcp_pack_control_pdu(LIBLTE_PDCP_CONTROL_PDU_STRUCT *c
             *pdu_ptr = LIBLTE_PDCP_CONTROL_MAC_I & 0xFF;
             pdu_ptr++;
         }else{
-            pdu->N_bytes = pdu_ptr - pdu->msg;
-            liblte_security_128_eia2(&key_256[16],
+            liblte_security_128_eia2(ctx,
                                      contents->count,
-                                     rb_id,
-                                     direction,
                                      pdu->msg,
-                                     pdu->N_bytes,
+                                     (pdu_ptr - pdu->msg)*8,
                                      pdu_ptr);
             pdu_ptr += 4;
         }
@@ -257,7 +275,66 @@ LIBLTE_ERROR_ENUM liblte_pdcp_unpack_data_pdu_with_long_sn(LIBLTE_BYTE_MSG_STRUC
 
     Document Reference: 36.323 v10.1.0 Section 6.2.5
 *********************************************************************/
-// FIXME
+LIBLTE_ERROR_ENUM liblte_pdcp_pack_rohc_feedback_pdu(LIBLTE_PDCP_ROHC_FEEDBACK_PDU_STRUCT *contents,
+                                                     LIBLTE_BYTE_MSG_STRUCT               *pdu)
+{
+    return(liblte_pdcp_pack_rohc_feedback_pdu(contents, &contents->feedback, pdu));
+}
+LIBLTE_ERROR_ENUM liblte_pdcp_pack_rohc_feedback_pdu(LIBLTE_PDCP_ROHC_FEEDBACK_PDU_STRUCT *contents,
+                                                     LIBLTE_BYTE_MSG_STRUCT               *feedback,
+                                                     LIBLTE_BYTE_MSG_STRUCT               *pdu)
+{
+    LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
+    uint8             *pdu_ptr = pdu->msg;
+
+    if(contents != NULL &&
+       feedback != NULL &&
+       pdu      != NULL)
+    {
+        // Header
+        *pdu_ptr = (LIBLTE_PDCP_D_C_CONTROL_PDU << 7) | (LIBLTE_PDCP_PDU_TYPE_INTERSPERSED_ROHC_FEEDBACK_PACKET << 4);
+        pdu_ptr++;
+
+        // Feedback
+        memcpy(pdu_ptr, feedback->msg, feedback->N_bytes);
+        pdu_ptr += feedback->N_bytes;
+
+        // Fill in the number of bytes used
+        pdu->N_bytes = pdu_ptr - pdu->msg;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_pdcp_unpack_rohc_feedback_pdu(LIBLTE_BYTE_MSG_STRUCT               *pdu,
+                                                       LIBLTE_PDCP_ROHC_FEEDBACK_PDU_STRUCT *contents)
+{
+    LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
+    uint8             *pdu_ptr = pdu->msg;
+
+    if(pdu      != NULL &&
+       contents != NULL &&
+       pdu->N_bytes > 1)
+    {
+        err = LIBLTE_ERROR_DECODE_FAIL;
+
+        // Header
+        if(LIBLTE_PDCP_D_C_CONTROL_PDU                           == ((*pdu_ptr >> 7) & 0x01) &&
+           LIBLTE_PDCP_PDU_TYPE_INTERSPERSED_ROHC_FEEDBACK_PACKET == ((*pdu_ptr >> 4) & 0x07))
+        {
+            pdu_ptr++;
+
+            // Feedback
+            memcpy(contents->feedback.msg, pdu_ptr, pdu->N_bytes-1);
+            contents->feedback.N_bytes = pdu->N_bytes-1;
+
+            err = LIBLTE_SUCCESS;
+        }
+    }
+
+    return(err);
+}
 
 /*********************************************************************
     PDU Type: PDCP Control PDU for PDCP status report
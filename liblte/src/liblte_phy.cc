@@ -248,6 +248,39 @@ int32 W_1_5_5_2_1_1_1[8][4] = {{ 1, 1,-1,-1},
 // N_1_DMRS table from 3GPP TS 36.211 v10.1.0 table 5.5.2.1.1-2
 uint32 N_1_DMRS_5_5_2_1_1_2[8] = {0,2,3,4,6,8,9,10};
 
+// PUCCH orthogonal sequences table from 3GPP TS 36.211 v10.1.0 table 5.4.1-2
+float PUCCH_W_5_4_1_2[3][4] = {{ 1, 1, 1, 1},
+                               { 1,-1, 1,-1},
+                               { 1,-1,-1, 1}};
+
+// PUCCH DMRS orthogonal sequences table (normal CP) from 3GPP TS 36.211 v10.1.0 table 5.5.2.2.1-2,
+// values are phases in units of 2*pi/3
+uint32 PUCCH_DMRS_W_5_5_2_2_1_2[3][3] = {{0, 0, 0},
+                                         {0, 1, 2},
+                                         {0, 2, 1}};
+
+// Basis sequences for the (20, A) code from 3GPP TS 36.212 v10.1.0 table 5.2.3.3-1
+uint8 CQI_M_5_2_3_3_1[20][13] = {{1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0},
+                                 {1, 1, 1, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0},
+                                 {1, 0, 0, 1, 0, 0, 1, 0, 1, 1, 1, 1, 1},
+                                 {1, 0, 1, 1, 0, 0, 0, 0, 1, 0, 1, 1, 1},
+                                 {1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1, 1, 1},
+                                 {1, 1, 0, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1},
+                                 {1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 1, 1},
+                                 {1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 1, 1, 1},
+                                 {1, 1, 0, 1, 1, 0, 0, 1, 0, 1, 1, 1, 1},
+                                 {1, 0, 1, 1, 1, 0, 1, 0, 0, 1, 1, 1, 1},
+                                 {1, 0, 1, 0, 0, 1, 1, 1, 0, 1, 1, 1, 1},
+                                 {1, 1, 1, 0, 0, 1, 1, 0, 1, 0, 1, 1, 1},
+                                 {1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 1, 1, 1},
+                                 {1, 1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 1},
+                                 {1, 0, 0, 0, 1, 1, 0, 1, 0, 0, 1, 0, 1},
+                                 {1, 1, 0, 0, 1, 1, 1, 1, 0, 1, 1, 0, 1},
+                                 {1, 1, 1, 0, 1, 1, 1, 0, 0, 1, 0, 1, 1},
+                                 {1, 0, 0, 1, 1, 1, 0, 0, 1, 0, 0, 1, 1},
+                                 {1, 1, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0},
+                                 {1, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0}};
+
 // PRACH N_cs unrestricted set values from 3GPP TS 36.211 v10.1.0 table 5.7.2-2
 uint32 PRACH_5_7_2_2_URS[16] = {0,13,15,18,22,26,32,38,46,59,76,93,119,167,279,419};
 
@@ -433,6 +466,18 @@ uint32 TURBO_INT_F2_TABLE[188] = { 10, 12, 42, 16, 18, 20, 22, 24, 26, 84, 90, 3
                                   234,158, 80, 96,902,166,336,170, 86,174,176,178,120,
                                   182,184,186, 94,190,480};
 
+// Turbo Internal Interleaver permutations for every K in TURBO_INT_K_TABLE, generated once by turbo_tables_pre_calc
+#define TURBO_INT_PERM_SIZE 355248
+uint32 TURBO_INT_PERM_OFFSET[TURBO_INT_K_TABLE_SIZE];
+uint16 TURBO_INT_PERM[TURBO_INT_PERM_SIZE];
+int16  TURBO_INT_K_IDX[(6144/8)+1]; // Index into TURBO_INT_K_TABLE for K/8, -1 for invalid K
+
+// Turbo constituent encoder lookup tables indexed by [state][8 input bits], generated once by turbo_tables_pre_calc
+uint8 TURBO_CE_PARITY_LUT[8][256];
+uint8 TURBO_CE_STATE_LUT[8][256];
+uint8 TURBO_BYTE_TO_BITS_LUT[256][8];
+bool  TURBO_TABLES_READY = false;
+
 // Transport Block Size from 3GPP TS 36.213 v10.3.0 table 7.1.7.2.1-1
 uint32 TBS_71721[27][110] = {{   16,   32,   56,   88,  120,  152,  176,  208,  224,  256,  288,
                                 328,  344,  376,  392,  424,  456,  488,  504,  536,  568,  600,
@@ -709,6 +754,77 @@ uint32 TBS_71721[27][110] = {{   16,   32,   56,   88,  120,  152,  176,  208,
 uint32 TBS_71723[32] = {  40,  56,  72, 120, 136, 144, 176, 208, 224, 256, 280, 296, 328, 336, 392, 488,
                          552, 600, 632, 696, 776, 840, 904,1000,1064,1128,1224,1288,1384,1480,1608,1736};
 
+// Downlink CRS symbols (symbols 14 and 15 are in the next subframe) and v for each antenna port from 3GPP TS 36.211 v10.1.0 section 6.10.1.2
+uint32 DL_CE_N_CRS_SYMBS[LIBLTE_PHY_N_ANT_MAX] = {5, 5, 3, 3};
+uint32 DL_CE_CRS_SYMB[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_DL_CE_N_CRS_SYMBS_MAX] = {{0, 4, 7, 11, 14},
+                                                                                {0, 4, 7, 11, 14},
+                                                                                {1, 8, 15, 0, 0},
+                                                                                {1, 8, 15, 0, 0}};
+uint32 DL_CE_CRS_V[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_DL_CE_N_CRS_SYMBS_MAX] = {{0, 3, 0, 3, 0},
+                                                                             {3, 0, 3, 0, 3},
+                                                                             {0, 3, 0, 0, 0},
+                                                                             {3, 6, 3, 0, 0}};
+
+// Two antenna port codebook for spatial multiplexing, indexed by [v-1][codebook index][antenna port][layer], from 3GPP TS 36.211 v10.1.0 table 6.3.4.2.3-1
+float SM_CODEBOOK_2_RE[2][4][2][2] = {{{{0.70710678, 0}, { 0.70710678,  0}},
+                                       {{0.70710678, 0}, {-0.70710678,  0}},
+                                       {{0.70710678, 0}, { 0,           0}},
+                                       {{0.70710678, 0}, { 0,           0}}},
+                                      {{{0.70710678, 0}, { 0,           0.70710678}},
+                                       {{0.5,        0.5}, { 0.5,        -0.5}},
+                                       {{0.5,        0.5}, { 0,           0}},
+                                       {{0,          0}, { 0,           0}}}};
+float SM_CODEBOOK_2_IM[2][4][2][2] = {{{{0,          0}, { 0,           0}},
+                                       {{0,          0}, { 0,           0}},
+                                       {{0,          0}, { 0.70710678,  0}},
+                                       {{0,          0}, {-0.70710678,  0}}},
+                                      {{{0,          0}, { 0,           0}},
+                                       {{0,          0}, { 0,           0}},
+                                       {{0,          0}, { 0.5,        -0.5}},
+                                       {{0,          0}, { 0,           0}}}};
+
+// Four antenna port codebook vectors u_n and layer columns of W_n, indexed by [v-1][codebook index], from 3GPP TS 36.211 v10.1.0 table 6.3.4.2.3-2
+float SM_CODEBOOK_4_U_RE[16][4] = {{1, -1,          -1, -1},
+                                   {1,  0,           1,  0},
+                                   {1,  1,          -1,  1},
+                                   {1,  0,           1,  0},
+                                   {1, -0.70710678,  0,  0.70710678},
+                                   {1,  0.70710678,  0, -0.70710678},
+                                   {1,  0.70710678,  0, -0.70710678},
+                                   {1, -0.70710678,  0,  0.70710678},
+                                   {1, -1,           1,  1},
+                                   {1,  0,          -1,  0},
+                                   {1,  1,           1, -1},
+                                   {1,  0,          -1,  0},
+                                   {1, -1,          -1,  1},
+                                   {1, -1,           1, -1},
+                                   {1,  1,          -1, -1},
+                                   {1,  1,           1,  1}};
+float SM_CODEBOOK_4_U_IM[16][4] = {{0,  0,           0,  0},
+                                   {0, -1,           0,  1},
+                                   {0,  0,           0,  0},
+                                   {0,  1,           0, -1},
+                                   {0, -0.70710678, -1, -0.70710678},
+                                   {0, -0.70710678,  1, -0.70710678},
+                                   {0,  0.70710678, -1,  0.70710678},
+                                   {0,  0.70710678,  1,  0.70710678},
+                                   {0,  0,           0,  0},
+                                   {0, -1,           0, -1},
+                                   {0,  0,           0,  0},
+                                   {0,  1,           0,  1},
+                                   {0,  0,           0,  0},
+                                   {0,  0,           0,  0},
+                                   {0,  0,           0,  0},
+                                   {0,  0,           0,  0}};
+uint8 SM_CODEBOOK_4_COLS[4][16][4] = {{{0}, {0}, {0}, {0}, {0}, {0}, {0}, {0},
+                                       {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}},
+                                      {{0, 3}, {0, 1}, {0, 1}, {0, 1}, {0, 3}, {0, 3}, {0, 2}, {0, 2},
+                                       {0, 1}, {0, 3}, {0, 2}, {0, 2}, {0, 1}, {0, 2}, {0, 2}, {0, 1}},
+                                      {{0, 1, 3}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 3}, {0, 1, 3}, {0, 2, 3}, {0, 2, 3},
+                                       {0, 1, 3}, {0, 2, 3}, {0, 1, 2}, {0, 2, 3}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}},
+                                      {{0, 1, 2, 3}, {0, 1, 2, 3}, {2, 1, 0, 3}, {2, 1, 0, 3}, {0, 1, 2, 3}, {0, 1, 2, 3}, {0, 2, 1, 3}, {0, 2, 1, 3},
+                                       {0, 1, 2, 3}, {0, 1, 2, 3}, {0, 2, 1, 3}, {0, 2, 1, 3}, {0, 1, 2, 3}, {0, 2, 1, 3}, {2, 1, 0, 3}, {0, 1, 2, 3}}};
+
 /*******************************************************************************
                               LOCAL FUNCTION PROTOTYPES
 *******************************************************************************/
@@ -901,6 +1017,45 @@ void generate_dmrs_pusch(LIBLTE_PHY_STRUCT *phy_struct,
                          float             *dmrs_1_re,
                          float             *dmrs_1_im);
 
+/*********************************************************************
+    Name: pucch_seq_gen
+
+    Description: Generates the cyclically shifted base sequences and
+                 the cell specific cyclic shifts for all PUCCH slots
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void pucch_seq_gen(LIBLTE_PHY_STRUCT *phy_struct,
+                   uint32             N_id_cell,
+                   bool               group_hopping_enabled);
+
+/*********************************************************************
+    Name: pucch_calc_resources
+
+    Description: Determines the PRB, orthogonal sequence index, and
+                 cyclic shifts used by a PUCCH resource in each slot
+                 of a subframe
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 5.4.1, 5.4.2,
+                        and 5.4.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void pucch_calc_resources(LIBLTE_PHY_STRUCT            *phy_struct,
+                          LIBLTE_PHY_PUCCH_FORMAT_ENUM  format,
+                          uint32                        n_pucch,
+                          uint32                        N_subfr,
+                          uint32                       *prb,
+                          uint32                       *n_oc,
+                          uint32                       *n_prime,
+                          uint32                        n_cs[][LIBLTE_PHY_N_SYMB_PER_SLOT_UL]);
+
 /*********************************************************************
     Name: prach_preamble_seq_gen
 
@@ -950,7 +1105,7 @@ void layer_mapper_dl(float                          *d_re,
 
     Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.3
 
-    NOTES: Currently only supports single antenna or TX diversity
+    NOTES: Spatial multiplexing only supports a single codeword
 *********************************************************************/
 // Defines
 #define RX_NULL_SYMB 10000
@@ -976,7 +1131,8 @@ void layer_demapper_dl(float                          *x_re,
 
     Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4
 
-    NOTES: Currently only supports signle antenna or TX diversity
+    NOTES: Spatial multiplexing and large delay CDD only support a
+           single codeword
 *********************************************************************/
 // Defines
 // Enums
@@ -986,7 +1142,9 @@ void pre_coder_dl(float                          *x_re,
                   float                          *x_im,
                   uint32                          M_layer_symb,
                   uint8                           N_ant,
+                  uint32                          N_layers,
                   LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                  uint32                          codebook_idx,
                   float                          *y_re,
                   float                          *y_im,
                   uint32                          y_len,
@@ -996,11 +1154,12 @@ void pre_coder_dl(float                          *x_re,
     Name: pre_decoder_and_matched_filter_dl
 
     Description: Matched filters and unmaps a block of vectors from
-                 resources on each downlink antenna port
+                 resources on each downlink antenna port, combining
+                 one or more receive antennas
 
     Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4
 
-    NOTES: Currently only supports signle antenna or TX diversity
+    NOTES: Currently only supports single antenna or TX diversity
 *********************************************************************/
 // Defines
 // Enums
@@ -1008,16 +1167,118 @@ void pre_coder_dl(float                          *x_re,
 // Functions
 void pre_decoder_and_matched_filter_dl(float                          *y_re,
                                        float                          *y_im,
+                                       uint32                          y_len,
                                        float                          *h_re,
                                        float                          *h_im,
                                        uint32                          h_len,
                                        uint32                          M_ap_symb,
+                                       uint8                           N_rx,
                                        uint8                           N_ant,
                                        LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
                                        float                          *x_re,
                                        float                          *x_im,
                                        uint32                         *M_layer_symb);
 
+/*********************************************************************
+    Name: sfbc_combine_dl
+
+    Description: Combines the pairs of resource elements of one
+                 space frequency block code, accumulating over the
+                 receive antennas
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void sfbc_combine_dl(float  *y_re,
+                     float  *y_im,
+                     float  *h0_re,
+                     float  *h0_im,
+                     float  *h1_re,
+                     float  *h1_im,
+                     uint32  stride,
+                     uint32  N_pairs,
+                     float  *x0_re,
+                     float  *x0_im,
+                     float  *x1_re,
+                     float  *x1_im,
+                     float  *h_norm);
+
+/*********************************************************************
+    Name: pre_decoder_mmse_dl
+
+    Description: Detects the layers of a spatially multiplexed block
+                 of vectors with an unbiased MMSE detector
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3.4.2.1 and
+                        6.3.4.2.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void pre_decoder_mmse_dl(LIBLTE_PHY_STRUCT              *phy_struct,
+                         float                          *y_re,
+                         float                          *y_im,
+                         uint32                          y_len,
+                         float                          *h_re,
+                         float                          *h_im,
+                         uint32                          h_len,
+                         float                          *noise_var,
+                         uint32                          M_ap_symb,
+                         uint8                           N_rx,
+                         uint8                           N_ant,
+                         uint32                          N_layers,
+                         LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                         uint32                          codebook_idx,
+                         float                          *x_re,
+                         float                          *x_im,
+                         uint32                         *M_layer_symb);
+
+/*********************************************************************
+    Name: dl_pre_coder_is_valid
+
+    Description: Checks a spatial multiplexing or large delay CDD
+                 layer and codebook configuration
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+bool dl_pre_coder_is_valid(uint8                           N_ant,
+                           uint32                          N_layers,
+                           LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                           uint32                          codebook_idx);
+
+/*********************************************************************
+    Name: get_dl_pre_coding_matrices
+
+    Description: Determines the pre-coding matrices used for spatial
+                 multiplexing, returning the number of matrices before
+                 they repeat.  Resource element i uses matrix
+                 (i % N_matrices)
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3.4.2.1 and
+                        6.3.4.2.2
+
+    Notes: For large delay CDD the returned matrices are W(i)D(i)U
+*********************************************************************/
+// Defines
+#define DL_PRE_CODER_N_MATRICES_MAX 16
+// Enums
+// Structs
+// Functions
+uint32 get_dl_pre_coding_matrices(uint8                           N_ant,
+                                  uint32                          N_layers,
+                                  LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                                  uint32                          codebook_idx,
+                                  float                           w_re[DL_PRE_CODER_N_MATRICES_MAX][LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_N_ANT_MAX],
+                                  float                           w_im[DL_PRE_CODER_N_MATRICES_MAX][LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_N_ANT_MAX]);
+
 /*********************************************************************
     Name: pcfich_channel_map
 
@@ -1054,19 +1315,91 @@ void pcfich_channel_demap(LIBLTE_PHY_STRUCT          *phy_struct,
                           uint32                     *N_bits);
 
 /*********************************************************************
-    Name: pdcch_permute_pre_calc
+    Name: pdcch_reg_map_get
 
-    Description: Pre calculates the PDCCH REG permutation.
+    Description: Returns the PDCCH REG to resource element map for
+                 the current cell configuration, calculating it if
+                 the cached map does not match.
 
     Document Reference: 3GPP TS 36.211 v10.1.0 section 6.8.5
+                        3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void pdcch_permute_pre_calc(LIBLTE_PHY_STRUCT *phy_struct,
-                            uint32             N_ant,
-                            float              phich_res);
+LIBLTE_PHY_PDCCH_REG_MAP_STRUCT* pdcch_reg_map_get(LIBLTE_PHY_STRUCT        *phy_struct,
+                                                   LIBLTE_PHY_PCFICH_STRUCT *pcfich,
+                                                   LIBLTE_PHY_PHICH_STRUCT  *phich,
+                                                   uint32                    N_id_cell,
+                                                   uint8                     N_ant,
+                                                   uint32                    N_symbs);
+
+/*********************************************************************
+    Name: pdcch_add_candidate
+
+    Description: Adds a PDCCH candidate to the list of candidates to
+                 blind decode, merging duplicates.
+
+    Document Reference: 3GPP TS 36.213 v10.3.0 section 9.1.1
+*********************************************************************/
+// Defines
+#define PDCCH_MAX_CANDIDATES (2*LIBLTE_PHY_PDCCH_N_CCE_MAX)
+// Enums
+// Structs
+typedef struct{
+    float  score;
+    uint32 cce;
+    uint32 L;
+    bool   css;
+}PDCCH_CANDIDATE_STRUCT;
+// Functions
+void pdcch_add_candidate(PDCCH_CANDIDATE_STRUCT *cand,
+                         uint32                 *N_cand,
+                         uint32                  cce,
+                         uint32                  L,
+                         bool                    css);
+
+/*********************************************************************
+    Name: pdcch_rnti_wanted
+
+    Description: Determines whether a DCI masked with an RNTI is
+                 wanted by the PDCCH blind decoder.
+
+    Document Reference: 3GPP TS 36.213 v10.3.0 section 9.1.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+bool pdcch_rnti_wanted(uint16  rnti,
+                       bool    css,
+                       uint16 *rnti_list,
+                       uint32  N_rnti,
+                       bool   *rnti_found,
+                       uint32 *rnti_idx);
+
+/*********************************************************************
+    Name: pdcch_blind_decode
+
+    Description: Blind decodes the PDCCH CCEs for the wanted RNTIs.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
+                        3GPP TS 36.213 v10.3.0 section 9.1.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM pdcch_blind_decode(LIBLTE_PHY_STRUCT       *phy_struct,
+                                     uint8                    N_ant,
+                                     uint32                   N_cce,
+                                     uint32                   subfr_num,
+                                     uint16                  *rnti_list,
+                                     uint32                   N_rnti,
+                                     uint32                   dci_1a_size,
+                                     uint32                   dci_1c_size,
+                                     LIBLTE_PHY_PDCCH_STRUCT *pdcch);
 
 /*********************************************************************
     Name: phich_channel_map
@@ -1423,6 +1756,27 @@ void viterbi_decode(LIBLTE_PHY_STRUCT *phy_struct,
                     uint8             *c_bits,
                     uint32            *N_c_bits);
 
+/*********************************************************************
+    Name: viterbi_decode_batch
+
+    Description: Viterbi decodes a batch of convolutionally coded
+                 input bit arrays of the same length using the
+                 provided parameters
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void viterbi_decode_batch(LIBLTE_PHY_STRUCT *phy_struct,
+                          uint32             N_cand,
+                          uint32             N_d_bits,
+                          uint32             constraint_len,
+                          uint32             rate,
+                          uint32            *g,
+                          uint32            *N_c_bits);
+
 /*********************************************************************
     Name: viterbi_decode_siso
 
@@ -1445,15 +1799,32 @@ void viterbi_decode_siso(LIBLTE_PHY_STRUCT *phy_struct,
                          int8              *c_bits,
                          uint32            *N_c_bits);
 
+/*********************************************************************
+    Name: turbo_tables_pre_calc
+
+    Description: Generates the turbo internal interleaver permutations
+                 for all K and the constituent encoder lookup tables
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void turbo_tables_pre_calc(void);
+
 /*********************************************************************
     Name: turbo_encode
 
     Description: Turbo encodes a bit array using the LTE Parallel
-                 Concatenated Convolutional Code
+                 Concatenated Convolutional Code, processing 8 input
+                 bits per step through the constituent encoder lookup
+                 tables
 
     Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 
-    Notes: Currently not handling filler bits
+    Notes: The first N_fill_bits of c_bits are filler bits, which
+           are encoded as 0 and marked NULL in d0 and d1
 *********************************************************************/
 // Defines
 // Enums
@@ -1466,36 +1837,47 @@ void turbo_encode(LIBLTE_PHY_STRUCT *phy_struct,
                   uint8             *d_bits,
                   uint32            *N_d_bits);
 
+/*********************************************************************
+    Name: turbo_encode_bit_serial
+
+    Description: Turbo encodes a bit array using the LTE Parallel
+                 Concatenated Convolutional Code, one bit at a time
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+
+    Notes: Currently not handling filler bits, only used as a
+           reference for turbo_encode
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void turbo_encode_bit_serial(LIBLTE_PHY_STRUCT *phy_struct,
+                             uint8             *c_bits,
+                             uint32             N_c_bits,
+                             uint32             N_fill_bits,
+                             uint8             *d_bits,
+                             uint32            *N_d_bits);
+
 /*********************************************************************
     Name: turbo_decode
 
     Description: Turbo decodes data according to the LTE Parallel
-                 Concatenated Convolutional Code.  The design of this
-                 decoder is based on the conversion of the constituent
-                 coder from:
-                                   -------->+---------------->+---- out
-                                   |        ^                 ^
-                           in_act  |   |-|  |   |-|      |-|  |
-                 in --->+------------->|D|----->|D|----->|D|---
-                        ^              |-|      |-|  |   |-|  |
-                        |                            v        |
-                        -----------------------------+<--------
-                 to:
-                           ------->+---------------->+------------- out
-                           |       ^                 ^
-                           |  |-|  |   |-|      |-|  |       
-                 in_act ------|D|----->|D|----->|D|---         
-                           |  |-|      |-|  |   |-|  |          
-                           |                v        v         
-                           ---------------->+------->+------------- in
-                 in_act can be determined using viterbi decoding and
-                 a second copy of in can be calculated using in_act
+                 Concatenated Convolutional Code.  The two constituent
+                 codes are decoded with the max-log-MAP algorithm and
+                 exchange extrinsic information for up to
+                 TURBO_DEC_N_ITER_MAX iterations.
 
     Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 
-    Notes: Currently not handling filler bits
+    Notes: d_bits holds d0, d1, and d2 interleaved, a positive value
+           is a 0.  Bits marked RX_NULL_BIT were not received and
+           are treated as erasures.  Decoding stops early once an
+           iteration does not change the hard decisions.
 *********************************************************************/
 // Defines
+#define TURBO_DEC_N_ITER_MAX 8
+#define TURBO_DEC_EXT_SCALE  0.75
 // Enums
 // Structs
 // Functions
@@ -1506,6 +1888,31 @@ void turbo_decode(LIBLTE_PHY_STRUCT *phy_struct,
                   uint8             *c_bits,
                   uint32            *N_c_bits);
 
+/*********************************************************************
+    Name: turbo_constituent_decode
+
+    Description: Max-log-MAP decoder for one constituent code of the
+                 LTE Parallel Concatenated Convolutional Code
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+
+    Notes: The trellis starts in state 0 and is terminated by the
+           three tail bits.  llr receives the a posteriori LLR of
+           each input bit.
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void turbo_constituent_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                              float             *sys,
+                              float             *apriori,
+                              float             *par,
+                              float             *tail_x,
+                              float             *tail_z,
+                              uint32             K,
+                              float             *llr);
+
 /*********************************************************************
     Name: turbo_constituent_encoder
 
@@ -1612,6 +2019,25 @@ void rate_unmatch_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
                         float                     *d_bits,
                         uint32                    *N_d_bits);
 
+/*********************************************************************
+    Name: soft_buffer_combine
+
+    Description: Combines the rate unmatched LLRs of a code block with
+                 the LLRs stored in a HARQ soft buffer
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1.2
+
+    Notes: The combined LLRs are written back to d_bits
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void soft_buffer_combine(LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer,
+                         uint32                         cb,
+                         float                         *d_bits,
+                         uint32                         N_d_bits);
+
 /*********************************************************************
     Name: rate_match_conv
 
@@ -1683,6 +2109,8 @@ void code_block_concatenation(uint8  *e_bits,
 void code_block_deconcatenation(float  *f_bits,
                                 uint32  N_f_bits,
                                 uint32  tbs,
+                                uint32  N_l,
+                                uint32  Q_m,
                                 float  *e_bits,
                                 uint32 *N_e_bits,
                                 uint32  N_e_bits_max,
@@ -1816,16 +2244,17 @@ void ulsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM ulsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                       float             *in_bits,
-                                       uint32             N_in_bits,
-                                       uint32             tbs,
-                                       uint32             tx_mode,
-                                       uint32             N_l,
-                                       uint32             Q_m,
-                                       uint32             rv_idx,
-                                       uint8             *out_bits,
-                                       uint32            *N_out_bits);
+LIBLTE_ERROR_ENUM ulsch_channel_decode(LIBLTE_PHY_STRUCT             *phy_struct,
+                                       float                         *in_bits,
+                                       uint32                         N_in_bits,
+                                       uint32                         tbs,
+                                       uint32                         tx_mode,
+                                       uint32                         N_l,
+                                       uint32                         Q_m,
+                                       uint32                         rv_idx,
+                                       LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer,
+                                       uint8                         *out_bits,
+                                       uint32                        *N_out_bits);
 
 /*********************************************************************
     Name: bch_channel_encode
@@ -1899,16 +2328,19 @@ void dlsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM dlsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                       float             *in_bits,
-                                       uint32             N_in_bits,
-                                       uint32             tbs,
-                                       uint32             tx_mode,
-                                       uint32             rv_idx,
-                                       uint32             M_dl_harq,
-                                       uint32             N_soft,
-                                       uint8             *out_bits,
-                                       uint32            *N_out_bits);
+LIBLTE_ERROR_ENUM dlsch_channel_decode(LIBLTE_PHY_STRUCT             *phy_struct,
+                                       float                         *in_bits,
+                                       uint32                         N_in_bits,
+                                       uint32                         tbs,
+                                       uint32                         tx_mode,
+                                       uint32                         rv_idx,
+                                       uint32                         N_l,
+                                       uint32                         Q_m,
+                                       uint32                         M_dl_harq,
+                                       uint32                         N_soft,
+                                       LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer,
+                                       uint8                         *out_bits,
+                                       uint32                        *N_out_bits);
 
 /*********************************************************************
     Name: dci_channel_encode
@@ -1952,6 +2384,49 @@ LIBLTE_ERROR_ENUM dci_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
                                      uint32             N_out_bits,
                                      uint16            *rnti_found);
 
+/*********************************************************************
+    Name: dci_channel_decode_masked_rnti
+
+    Description: Channel decodes the Downlink Control Information
+                 channel and recovers the RNTI that the CRC was
+                 masked with
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void dci_channel_decode_masked_rnti(LIBLTE_PHY_STRUCT *phy_struct,
+                                    float             *in_bits,
+                                    uint32             N_in_bits,
+                                    uint8              ue_ant,
+                                    uint8             *out_bits,
+                                    uint32             N_out_bits,
+                                    uint16            *masked_rnti);
+
+/*********************************************************************
+    Name: dci_channel_decode_batch
+
+    Description: Channel decodes a batch of PDCCH candidates for the
+                 same Downlink Control Information size and recovers
+                 the RNTI that each CRC was masked with
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void dci_channel_decode_batch(LIBLTE_PHY_STRUCT *phy_struct,
+                              uint32            *slot,
+                              uint32            *N_in_bits,
+                              uint32             N_cand,
+                              uint8              ue_ant,
+                              uint8            (*out_bits)[LIBLTE_PHY_DCI_N_BITS_MAX],
+                              uint32             N_out_bits,
+                              uint16            *masked_rnti);
+
 /*********************************************************************
     Name: dci_0_pack
 
@@ -1990,13 +2465,20 @@ void dci_0_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
                         3GPP TS 36.213 v10.3.0 section 8.1.1
                         3GPP TS 36.213 v10.3.0 section 8.6
 
-    Notes: N/A
+    Notes: Currently only handles non-hopping single-cluster
+           assignments
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-// FIXME
+void dci_0_unpack(uint8                           *in_bits,
+                  uint32                           N_in_bits,
+                  LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
+                  uint16                           rnti,
+                  uint32                           N_rb_ul,
+                  uint8                            N_ant,
+                  LIBLTE_PHY_ALLOCATION_STRUCT    *alloc);
 
 /*********************************************************************
     Name: dci_1a_pack
@@ -2031,8 +2513,7 @@ void dci_1a_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
                         3GPP TS 36.213 v10.3.0 section 7.1.6.3
                         3GPP TS 36.213 v10.3.0 section 7.1.7
 
-    Notes: Currently only handles SI-RNTI, P-RNTI, or RA-RNTI and
-           localized virtual resource blocks
+    Notes: Currently only handles localized virtual resource blocks
 *********************************************************************/
 // Defines
 // Enums
@@ -2118,6 +2599,39 @@ LIBLTE_ERROR_ENUM cfi_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
                                      uint32             N_in_bits,
                                      uint32            *cfi);
 
+/*********************************************************************
+    Name: cqi_channel_encode
+
+    Description: Channel encodes channel quality information for
+                 PUCCH format 2
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.3.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void cqi_channel_encode(uint8  *in_bits,
+                        uint32  N_in_bits,
+                        uint8  *out_bits);
+
+/*********************************************************************
+    Name: cqi_channel_decode
+
+    Description: Channel decodes channel quality information for
+                 PUCCH format 2
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.3.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void cqi_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                        float             *in_bits,
+                        uint32             N_out_bits,
+                        uint8             *out_bits);
+
 /*********************************************************************
     Name: get_ul_ce
 
@@ -2179,10 +2693,32 @@ uint32 get_num_bits_in_prb(uint32                          N_subframe,
                            LIBLTE_PHY_MODULATION_TYPE_ENUM mod_type);
 
 /*********************************************************************
-    Name: wrap_phase
+    Name: dl_ce_calc_wiener_weights
+
+    Description: Calculates the frequency domain Wiener interpolation
+                 weights for the downlink channel estimates
+
+    Document Reference: N/A
+
+    Notes: Assumes an exponential power delay profile, whose real
+           frequency correlation is 1/(1 + (2*pi*delta_f*tau_rms)^2)
+*********************************************************************/
+// Defines
+#define DL_CE_WIENER_TAU_RMS  1.0e-6 // Seconds
+#define DL_CE_WIENER_MIN_NSR  1.0e-3
+#define DL_CE_SC_SPACING      15000
+// Enums
+// Structs
+// Functions
+void dl_ce_calc_wiener_weights(LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                               float                       noise_to_signal);
+
+/*********************************************************************
+    Name: dl_ce_calc
 
-    Description: Checks the phase difference between two angles and
-                 wraps one to make the difference less than 2*pi.
+    Description: Interpolates the downlink CRS estimates into channel
+                 estimates for the specified symbols and PRBs, skipping
+                 any that have already been calculated for this subframe
 
     Document Reference: N/A
 *********************************************************************/
@@ -2190,8 +2726,12 @@ uint32 get_num_bits_in_prb(uint32                          N_subframe,
 // Enums
 // Structs
 // Functions
-void wrap_phase(float *phase_1,
-                float  phase_2);
+void dl_ce_calc(LIBLTE_PHY_STRUCT          *phy_struct,
+                LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                uint32                      first_symb,
+                uint32                      N_symbs,
+                uint32                      first_prb,
+                uint32                      N_prb);
 
 /*******************************************************************************
                               LIBRARY FUNCTIONS
@@ -2284,10 +2824,17 @@ LIBLTE_ERROR_ENUM liblte_phy_init(LIBLTE_PHY_STRUCT  **phy_struct,
             (*phy_struct)->N_sf_phich    = 2;
         }
 
-        // PDCCH Permutation
-        pdcch_permute_pre_calc(*phy_struct,
-                               N_ant,
-                               phich_res);
+        // Turbo Tables
+        turbo_tables_pre_calc();
+
+        // PDCCH REG Maps
+        for(i=0; i<LIBLTE_PHY_PDCCH_N_SYMBS_MAX; i++)
+        {
+            (*phy_struct)->pdcch_reg_map[i].valid = false;
+        }
+
+        // DL Channel Estimation
+        (*phy_struct)->dl_ce_interp = LIBLTE_PHY_DL_CE_INTERP_LINEAR;
 
         // CRS Storage
         if(LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN != N_id_cell)
@@ -2340,13 +2887,19 @@ LIBLTE_ERROR_ENUM liblte_phy_ul_init(LIBLTE_PHY_STRUCT *phy_struct,
                                      bool               group_hopping_enabled,
                                      bool               sequence_hopping_enabled,
                                      uint8              cyclic_shift,
-                                     uint8              cyclic_shift_dci)
+                                     uint8              cyclic_shift_dci,
+                                     uint32             pucch_delta_shift,
+                                     uint32             pucch_n_rb_cqi,
+                                     uint32             pucch_n_cs_an)
 {
     LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
     uint32            i;
     uint32            j;
+    uint8             cw_bits[LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS];
+    uint8             msg_bits[LIBLTE_PHY_PUCCH_N_CQI_BITS_MAX];
 
-    if(phy_struct != NULL)
+    if(phy_struct        != NULL &&
+       pucch_delta_shift != 0)
     {
         // PUSCH
         phy_struct->transform_precoding_in  = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL);
@@ -2392,6 +2945,28 @@ LIBLTE_ERROR_ENUM liblte_phy_ul_init(LIBLTE_PHY_STRUCT *phy_struct,
             }
         }
 
+        // PUCCH
+        phy_struct->pucch_delta_shift = pucch_delta_shift;
+        phy_struct->pucch_N_rb_2      = pucch_n_rb_cqi;
+        phy_struct->pucch_N_cs_1      = pucch_n_cs_an;
+        pucch_seq_gen(phy_struct,
+                      N_id_cell,
+                      group_hopping_enabled);
+        for(i=0; i<LIBLTE_PHY_PUCCH_N_CQI_CW; i++)
+        {
+            for(j=0; j<LIBLTE_PHY_PUCCH_N_CQI_BITS_MAX; j++)
+            {
+                msg_bits[j] = (i >> j) & 1;
+            }
+            cqi_channel_encode(msg_bits,
+                               LIBLTE_PHY_PUCCH_N_CQI_BITS_MAX,
+                               cw_bits);
+            for(j=0; j<LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS; j++)
+            {
+                phy_struct->pucch_cqi_cw[i][j] = 1 - 2*(float)cw_bits[j];
+            }
+        }
+
         // PRACH
         prach_preamble_seq_gen(phy_struct,
                                prach_root_seq_idx,
@@ -2566,6 +3141,7 @@ LIBLTE_ERROR_ENUM liblte_phy_update_n_rb_dl(LIBLTE_PHY_STRUCT *phy_struct,
 {
     LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
     uint32            used_subcarriers;
+    uint32            i;
 
     if(phy_struct != NULL)
     {
@@ -2617,6 +3193,12 @@ LIBLTE_ERROR_ENUM liblte_phy_update_n_rb_dl(LIBLTE_PHY_STRUCT *phy_struct,
             phy_struct->N_rb_dl      = N_rb_dl;
             phy_struct->N_rb_ul      = N_rb_dl;
             phy_struct->FFT_pad_size = (phy_struct->FFT_size - used_subcarriers)/2;
+
+            // PDCCH REG maps depend on the bandwidth
+            for(i=0; i<LIBLTE_PHY_PDCCH_N_SYMBS_MAX; i++)
+            {
+                phy_struct->pdcch_reg_map[i].valid = false;
+            }
         }
     }
 
@@ -2624,50 +3206,253 @@ LIBLTE_ERROR_ENUM liblte_phy_update_n_rb_dl(LIBLTE_PHY_STRUCT *phy_struct,
 }
 
 /*********************************************************************
-    Name: liblte_phy_pusch_channel_encode
+    Name: liblte_phy_soft_buffer_pool_init
 
-    Description: Encodes and modulates the Physical Uplink Shared
-                 Channel
+    Description: Allocates a pool of HARQ soft buffer memory.
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3
+    Document Reference: N/A
 
-    Notes: Only handling normal CP and N_ant=1
+    Notes: The pool is split into fixed size chunks of int8 LLRs
+           which are handed out to soft buffers by
+           liblte_phy_soft_buffer_alloc.  The pool is not thread
+           safe, callers sharing a pool must serialize access.
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_encode(LIBLTE_PHY_STRUCT            *phy_struct,
-                                                  LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
-                                                  uint32                        N_id_cell,
-                                                  uint8                         N_ant,
-                                                  LIBLTE_PHY_SUBFRAME_STRUCT   *subframe)
+LIBLTE_ERROR_ENUM liblte_phy_soft_buffer_pool_init(LIBLTE_PHY_SOFT_BUFFER_POOL_STRUCT **pool,
+                                                   uint32                               N_bytes)
 {
     LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
     uint32            i;
-    uint32            j;
-    uint32            p;
-    uint32            L;
-    uint32            idx;
-    uint32            c_init;
-    uint32            N_bits;
-    uint32            M_symb;
-    uint32            M_layer_symb;
-    uint32            M_ap_symb;
-    uint32            M_pusch_sc = alloc->N_prb*phy_struct->N_sc_rb_ul;
-    uint32            Q_m;
-    uint32            N_ul_symb = 7; // FIXME: Only handling normal CP
 
-    if(phy_struct != NULL &&
-       alloc      != NULL &&
-       subframe   != NULL)
+    if(pool    != NULL &&
+       N_bytes >= LIBLTE_PHY_SOFT_BUFFER_CHUNK_LEN)
     {
-        // Determine Q_m
-        if(LIBLTE_PHY_MODULATION_TYPE_BPSK == alloc->mod_type)
+        *pool                  = (LIBLTE_PHY_SOFT_BUFFER_POOL_STRUCT *)malloc(sizeof(LIBLTE_PHY_SOFT_BUFFER_POOL_STRUCT));
+        (*pool)->N_chunks      = N_bytes/LIBLTE_PHY_SOFT_BUFFER_CHUNK_LEN;
+        (*pool)->llr           = (int8 *)malloc(sizeof(int8)*(*pool)->N_chunks*LIBLTE_PHY_SOFT_BUFFER_CHUNK_LEN);
+        (*pool)->free_chunk    = (uint32 *)malloc(sizeof(uint32)*(*pool)->N_chunks);
+        (*pool)->N_free_chunks = (*pool)->N_chunks;
+        for(i=0; i<(*pool)->N_chunks; i++)
         {
-            Q_m = 1;
-        }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == alloc->mod_type){
-            Q_m = 2;
-        }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == alloc->mod_type){
-            Q_m = 4;
-        }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == alloc->mod_type
-            Q_m = 6;
+            (*pool)->free_chunk[i] = i;
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_soft_buffer_pool_cleanup
+
+    Description: Frees a pool of HARQ soft buffer memory.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_soft_buffer_pool_cleanup(LIBLTE_PHY_SOFT_BUFFER_POOL_STRUCT *pool)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(pool != NULL)
+    {
+        free(pool->llr);
+        free(pool->free_chunk);
+        free(pool);
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_soft_buffer_alloc
+
+    Description: Allocates a HARQ soft buffer for a transport block
+                 from a soft buffer pool.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 sections 5.1.2 and
+                        5.1.4.1
+
+    Notes: The soft buffer holds the circular buffer of every code
+           block of the transport block as int8 LLRs.  Returns
+           LIBLTE_ERROR_INVALID_INPUTS when the pool does not have
+           enough free chunks, in which case the transport block
+           should be decoded without combining.
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_soft_buffer_alloc(LIBLTE_PHY_SOFT_BUFFER_POOL_STRUCT *pool,
+                                               uint32                              tbs,
+                                               LIBLTE_PHY_SOFT_BUFFER_STRUCT      *soft_buffer)
+{
+    LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            Z       = 6144;
+    uint32            L;
+    uint32            B;
+    uint32            C;
+    uint32            B_prime;
+    uint32            K_plus  = 0;
+    uint32            K_minus = 0;
+    uint32            C_minus = 0;
+    uint32            K_r;
+    uint32            N_llr;
+    uint32            N_chunks;
+    uint32            r;
+    int32             i;
+
+    if(pool        != NULL &&
+       soft_buffer != NULL)
+    {
+        soft_buffer->pool = NULL;
+
+        // Determine C, K+, K-, and C- as in code_block_segmentation
+        B = tbs + 24;
+        if(B <= Z)
+        {
+            L = 0;
+            C = 1;
+        }else{
+            L = 24;
+            C = (uint32)ceilf((float)B/(float)(Z-L));
+        }
+        if(C > LIBLTE_PHY_SOFT_BUFFER_N_CB_MAX)
+        {
+            return(err);
+        }
+        B_prime = B + C*L;
+        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+        {
+            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
+            {
+                K_plus = TURBO_INT_K_TABLE[i];
+                break;
+            }
+        }
+        if(C > 1)
+        {
+            for(i=TURBO_INT_K_TABLE_SIZE-1; i>=0; i--)
+            {
+                if(TURBO_INT_K_TABLE[i] < K_plus)
+                {
+                    K_minus = TURBO_INT_K_TABLE[i];
+                    break;
+                }
+            }
+            C_minus = (C*K_plus - B_prime)/(K_plus - K_minus);
+        }
+
+        // Each code block stores its three turbo coded streams
+        N_llr = 0;
+        for(r=0; r<C; r++)
+        {
+            if(r < C_minus)
+            {
+                K_r = K_minus;
+            }else{
+                K_r = K_plus;
+            }
+            soft_buffer->cb_offset[r] = N_llr;
+            soft_buffer->N_llr[r]     = 3*(K_r + 4);
+            soft_buffer->scale[r]     = 0;
+            N_llr                    += soft_buffer->N_llr[r];
+        }
+        N_chunks = (N_llr + LIBLTE_PHY_SOFT_BUFFER_CHUNK_LEN - 1)/LIBLTE_PHY_SOFT_BUFFER_CHUNK_LEN;
+        if(N_chunks > pool->N_free_chunks)
+        {
+            return(err);
+        }
+
+        // Take chunks from the free list and clear them
+        for(r=0; r<N_chunks; r++)
+        {
+            soft_buffer->chunk[r] = pool->free_chunk[--pool->N_free_chunks];
+            memset(&pool->llr[soft_buffer->chunk[r]*LIBLTE_PHY_SOFT_BUFFER_CHUNK_LEN], 0, LIBLTE_PHY_SOFT_BUFFER_CHUNK_LEN);
+        }
+        soft_buffer->pool         = pool;
+        soft_buffer->N_chunks     = N_chunks;
+        soft_buffer->N_codeblocks = C;
+        soft_buffer->tbs          = tbs;
+        soft_buffer->N_tx         = 0;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_soft_buffer_free
+
+    Description: Returns the memory of a HARQ soft buffer to its
+                 soft buffer pool.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_soft_buffer_free(LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+
+    if(soft_buffer       != NULL &&
+       soft_buffer->pool != NULL)
+    {
+        for(i=0; i<soft_buffer->N_chunks; i++)
+        {
+            soft_buffer->pool->free_chunk[soft_buffer->pool->N_free_chunks++] = soft_buffer->chunk[i];
+        }
+        soft_buffer->pool     = NULL;
+        soft_buffer->N_chunks = 0;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_pusch_channel_encode
+
+    Description: Encodes and modulates the Physical Uplink Shared
+                 Channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3
+
+    Notes: Only handling normal CP and N_ant=1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_encode(LIBLTE_PHY_STRUCT            *phy_struct,
+                                                  LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
+                                                  uint32                        N_id_cell,
+                                                  uint8                         N_ant,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT   *subframe)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            p;
+    uint32            L;
+    uint32            idx;
+    uint32            c_init;
+    uint32            N_bits;
+    uint32            M_symb;
+    uint32            M_layer_symb;
+    uint32            M_ap_symb;
+    uint32            M_pusch_sc = alloc->N_prb*phy_struct->N_sc_rb_ul;
+    uint32            Q_m;
+    uint32            N_ul_symb = 7; // FIXME: Only handling normal CP
+
+    if(phy_struct != NULL &&
+       alloc      != NULL &&
+       subframe   != NULL)
+    {
+        // Determine Q_m
+        if(LIBLTE_PHY_MODULATION_TYPE_BPSK == alloc->mod_type)
+        {
+            Q_m = 1;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == alloc->mod_type){
+            Q_m = 2;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == alloc->mod_type){
+            Q_m = 4;
+        }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == alloc->mod_type
+            Q_m = 6;
         }
 
         // Encode the PUSCH
@@ -2777,6 +3562,37 @@ LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_decode(LIBLTE_PHY_STRUCT            *
                                                   uint8                         N_ant,
                                                   uint8                        *out_bits,
                                                   uint32                       *N_out_bits)
+{
+    return(liblte_phy_pusch_channel_decode_harq(phy_struct,
+                                                subframe,
+                                                alloc,
+                                                N_id_cell,
+                                                N_ant,
+                                                NULL,
+                                                out_bits,
+                                                N_out_bits));
+}
+
+/*********************************************************************
+    Name: liblte_phy_pusch_channel_decode_harq
+
+    Description: Demodulates and decodes the Physical Uplink Shared
+                 Channel, combining the received LLRs with those
+                 of earlier transmissions of the transport block
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3
+                        3GPP TS 36.212 v10.1.0 section 5.1.4.1.2
+
+    Notes: Only handles normal CP
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_decode_harq(LIBLTE_PHY_STRUCT             *phy_struct,
+                                                       LIBLTE_PHY_SUBFRAME_STRUCT    *subframe,
+                                                       LIBLTE_PHY_ALLOCATION_STRUCT  *alloc,
+                                                       uint32                         N_id_cell,
+                                                       uint8                          N_ant,
+                                                       LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer,
+                                                       uint8                         *out_bits,
+                                                       uint32                        *N_out_bits)
 {
     LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
     uint32            i;
@@ -2896,6 +3712,7 @@ LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_decode(LIBLTE_PHY_STRUCT            *
                                                   alloc->N_layers,
                                                   Q_m,
                                                   alloc->rv_idx,
+                                                  soft_buffer,
                                                   out_bits,
                                                   N_out_bits))
         {
@@ -2907,75 +3724,151 @@ LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_decode(LIBLTE_PHY_STRUCT            *
 }
 
 /*********************************************************************
-    Name: liblte_phy_generate_prach
+    Name: liblte_phy_pucch_channel_encode
 
-    Description: Generates the baseband signal for a PRACH
+    Description: Encodes and modulates the Physical Uplink Control
+                 Channel
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.3
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4
+                        3GPP TS 36.212 v10.1.0 section 5.2.3.3
+
+    Notes: Only handles normal CP
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_generate_prach(LIBLTE_PHY_STRUCT *phy_struct,
-                                            uint32             preamble_idx,
-                                            uint32             freq_offset,
-                                            float             *samps_re,
-                                            float             *samps_im)
+LIBLTE_ERROR_ENUM liblte_phy_pucch_channel_encode(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                  LIBLTE_PHY_PUCCH_STRUCT    *pucch,
+                                                  uint32                      N_id_cell,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
 {
     LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    float             d_re[LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS/2];
+    float             d_im[LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS/2];
+    float             w_re;
+    float             w_im;
+    float             z_re;
+    float             z_im;
+    float            *r_re;
+    float            *r_im;
+    uint32            prb[LIBLTE_PHY_N_SLOTS_PER_SUBFR];
+    uint32            n_oc[LIBLTE_PHY_N_SLOTS_PER_SUBFR];
+    uint32            n_prime[LIBLTE_PHY_N_SLOTS_PER_SUBFR];
+    uint32            n_cs[LIBLTE_PHY_N_SLOTS_PER_SUBFR][LIBLTE_PHY_N_SYMB_PER_SLOT_UL];
+    uint32            c_init;
+    uint32            M_symb;
+    uint32            d_idx;
+    uint32            m;
     uint32            i;
-    uint32            idx;
-    uint32            N_ra_prb;
-    uint32            k_0;
-    uint32            K;
-    uint32            start;
+    uint32            k;
+    uint32            L;
+    uint8             bits[LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS];
 
-    if(phy_struct != NULL &&
-       samps_re   != NULL &&
-       samps_im   != NULL &&
+    if(phy_struct    != NULL                            &&
+       pucch         != NULL                            &&
+       subframe      != NULL                            &&
+       pucch->format  < LIBLTE_PHY_PUCCH_FORMAT_N_ITEMS &&
+       pucch->N_bits <= LIBLTE_PHY_PUCCH_N_BITS_MAX     &&
        phy_struct->ul_init)
     {
-        // Calculate PRACH parameters
-        N_ra_prb = freq_offset;
-        k_0      = N_ra_prb*phy_struct->N_sc_rb_ul - phy_struct->N_rb_ul*phy_struct->N_sc_rb_ul/2 + (phy_struct->FFT_size/2);
-        K        = 15000/phy_struct->prach_delta_f_RA;
-
-        for(i=0; i<phy_struct->prach_N_zc; i++)
-        {
-            phy_struct->prach_dft_in[i][0] = phy_struct->prach_x_u_v_re[preamble_idx][i];
-            phy_struct->prach_dft_in[i][1] = phy_struct->prach_x_u_v_im[preamble_idx][i];
-        }
-        fftwf_execute(phy_struct->prach_dft_plan);
-        for(i=0; i<phy_struct->prach_T_fft; i++)
-        {
-            phy_struct->prach_fft_in[i][0] = 0;
-            phy_struct->prach_fft_in[i][1] = 0;
-        }
-        start = phy_struct->prach_phi + (K*k_0) + (K/2);
-        for(i=0; i<phy_struct->prach_N_zc; i++)
-        {
-            idx                              = (i+start+phy_struct->prach_T_fft/2)%phy_struct->prach_T_fft;
-            phy_struct->prach_fft_in[idx][0] = phy_struct->prach_dft_out[(i+phy_struct->prach_N_zc/2)%phy_struct->prach_N_zc][0];
-            phy_struct->prach_fft_in[idx][1] = phy_struct->prach_dft_out[(i+phy_struct->prach_N_zc/2)%phy_struct->prach_N_zc][1];
-        }
-        fftwf_execute(phy_struct->prach_ifft_plan);
-        if(phy_struct->prach_T_fft == phy_struct->prach_T_seq)
-        {
-            for(i=0; i<phy_struct->prach_T_fft; i++)
+        pucch_calc_resources(phy_struct,
+                             pucch->format,
+                             pucch->n_pucch,
+                             subframe->num,
+                             prb,
+                             n_oc,
+                             n_prime,
+                             n_cs);
+
+        // Determine d
+        if(LIBLTE_PHY_PUCCH_FORMAT_2 == pucch->format)
+        {
+            cqi_channel_encode(pucch->bits, pucch->N_bits, bits);
+            c_init = (subframe->num + 1)*(2*N_id_cell + 1)*65536 + pucch->rnti;
+            generate_prs_c(c_init, LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS, phy_struct->pucch_c);
+            for(i=0; i<LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS; i++)
             {
-                samps_re[phy_struct->prach_T_cp+i] = phy_struct->prach_fft_out[i][0];
-                samps_im[phy_struct->prach_T_cp+i] = phy_struct->prach_fft_out[i][1];
+                bits[i] ^= phy_struct->pucch_c[i];
             }
-        }else{
-            for(i=0; i<phy_struct->prach_T_fft; i++)
+            modulation_mapper(bits,
+                              LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS,
+                              LIBLTE_PHY_MODULATION_TYPE_QPSK,
+                              d_re,
+                              d_im,
+                              &M_symb);
+        }else if(LIBLTE_PHY_PUCCH_FORMAT_1A == pucch->format){
+            d_re[0] = (pucch->bits[0] == 0) ? 1 : -1;
+            d_im[0] = 0;
+        }else if(LIBLTE_PHY_PUCCH_FORMAT_1B == pucch->format){
+            switch((pucch->bits[0] << 1) | pucch->bits[1])
             {
-                samps_re[phy_struct->prach_T_cp+i]                         = phy_struct->prach_fft_out[i][0];
-                samps_im[phy_struct->prach_T_cp+i]                         = phy_struct->prach_fft_out[i][1];
-                samps_re[phy_struct->prach_T_cp+phy_struct->prach_T_fft+i] = phy_struct->prach_fft_out[i][0];
-                samps_im[phy_struct->prach_T_cp+phy_struct->prach_T_fft+i] = phy_struct->prach_fft_out[i][1];
+            case 0:
+                d_re[0] = 1;
+                d_im[0] = 0;
+                break;
+            case 1:
+                d_re[0] = 0;
+                d_im[0] = -1;
+                break;
+            case 2:
+                d_re[0] = 0;
+                d_im[0] = 1;
+                break;
+            case 3:
+            default:
+                d_re[0] = -1;
+                d_im[0] = 0;
+                break;
             }
+        }else{ // LIBLTE_PHY_PUCCH_FORMAT_1 == pucch->format
+            d_re[0] = 1;
+            d_im[0] = 0;
         }
-        for(i=0; i<phy_struct->prach_T_cp; i++)
+
+        // Map to physical resources
+        d_idx = 0;
+        for(i=0; i<LIBLTE_PHY_N_SLOTS_PER_SUBFR; i++)
         {
-            samps_re[i] = samps_re[phy_struct->prach_T_seq+i];
-            samps_im[i] = samps_im[phy_struct->prach_T_seq+i];
+            for(L=0; L<LIBLTE_PHY_N_SYMB_PER_SLOT_UL; L++)
+            {
+                if(LIBLTE_PHY_PUCCH_FORMAT_2 == pucch->format)
+                {
+                    if(1 == L || 5 == L)
+                    {
+                        // DMRS
+                        w_re = 1;
+                        w_im = 0;
+                    }else{
+                        w_re = d_re[d_idx];
+                        w_im = d_im[d_idx];
+                        d_idx++;
+                    }
+                }else{
+                    if(L >= 2 && L <= 4)
+                    {
+                        // DMRS
+                        w_re = cos(2*M_PI*PUCCH_DMRS_W_5_5_2_2_1_2[n_oc[i]][L-2]/3);
+                        w_im = sin(2*M_PI*PUCCH_DMRS_W_5_5_2_2_1_2[n_oc[i]][L-2]/3);
+                    }else{
+                        m    = (L < 2) ? L : (L - 3);
+                        w_re = PUCCH_W_5_4_1_2[n_oc[i]][m]*d_re[0];
+                        w_im = PUCCH_W_5_4_1_2[n_oc[i]][m]*d_im[0];
+                        if((n_prime[i] % 2) == 1)
+                        {
+                            // S(n_s) = j
+                            z_re = -w_im;
+                            w_im = w_re;
+                            w_re = z_re;
+                        }
+                    }
+                }
+                r_re = phy_struct->pucch_r_re[subframe->num*LIBLTE_PHY_N_SLOTS_PER_SUBFR + i][n_cs[i][L]];
+                r_im = phy_struct->pucch_r_im[subframe->num*LIBLTE_PHY_N_SLOTS_PER_SUBFR + i][n_cs[i][L]];
+                for(k=0; k<LIBLTE_PHY_N_SC_RB_UL; k++)
+                {
+                    z_re = w_re*r_re[k] - w_im*r_im[k];
+                    z_im = w_re*r_im[k] + w_im*r_re[k];
+                    subframe->tx_symb_re[0][i*LIBLTE_PHY_N_SYMB_PER_SLOT_UL + L][prb[i]*LIBLTE_PHY_N_SC_RB_UL + k] = z_re;
+                    subframe->tx_symb_im[0][i*LIBLTE_PHY_N_SYMB_PER_SLOT_UL + L][prb[i]*LIBLTE_PHY_N_SC_RB_UL + k] = z_im;
+                }
+            }
         }
 
         err = LIBLTE_SUCCESS;
@@ -2985,27 +3878,307 @@ LIBLTE_ERROR_ENUM liblte_phy_generate_prach(LIBLTE_PHY_STRUCT *phy_struct,
 }
 
 /*********************************************************************
-    Name: liblte_phy_detect_prach
+    Name: liblte_phy_pucch_channel_decode
 
-    Description: Detects PRACHs from baseband I/Q
+    Description: Demodulates and decodes the Physical Uplink Control
+                 Channel
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.2 and 5.7.3
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4
+                        3GPP TS 36.212 v10.1.0 section 5.2.3.3
 
-    Notes: Currently only supports detection of one preamble
+    Notes: Only handles normal CP.  Each symbol is despread with its
+           cyclically shifted base sequence, the DMRS symbols of a
+           slot are combined into a single channel estimate, and the
+           data symbols are equalized with that estimate.
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_detect_prach(LIBLTE_PHY_STRUCT *phy_struct,
-                                          float             *samps_re,
-                                          float             *samps_im,
-                                          uint32             freq_offset,
-                                          uint32            *N_det_pre,
-                                          uint32            *det_pre,
-                                          uint32            *det_ta)
+LIBLTE_ERROR_ENUM liblte_phy_pucch_channel_decode(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                                  LIBLTE_PHY_PUCCH_STRUCT    *pucch,
+                                                  uint32                      N_id_cell)
 {
     LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    float             max_val;
-    float             abs_corr;
-    float             ave_val;
-    int32             N_neg_RA_shift;
+    float             y_re[LIBLTE_PHY_N_SLOTS_PER_SUBFR][LIBLTE_PHY_N_SYMB_PER_SLOT_UL];
+    float             y_im[LIBLTE_PHY_N_SLOTS_PER_SUBFR][LIBLTE_PHY_N_SYMB_PER_SLOT_UL];
+    float             soft_bits[LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS];
+    float             h_re;
+    float             h_im;
+    float             w_re;
+    float             w_im;
+    float             z_re;
+    float             z_im;
+    float             acc_re    = 0;
+    float             acc_im    = 0;
+    float             h_energy  = 0;
+    float             rx_energy = 0;
+    float            *rx_re;
+    float            *rx_im;
+    float            *r_re;
+    float            *r_im;
+    uint32            prb[LIBLTE_PHY_N_SLOTS_PER_SUBFR];
+    uint32            n_oc[LIBLTE_PHY_N_SLOTS_PER_SUBFR];
+    uint32            n_prime[LIBLTE_PHY_N_SLOTS_PER_SUBFR];
+    uint32            n_cs[LIBLTE_PHY_N_SLOTS_PER_SUBFR][LIBLTE_PHY_N_SYMB_PER_SLOT_UL];
+    uint32            c_init;
+    uint32            N_dmrs;
+    uint32            d_idx;
+    uint32            m;
+    uint32            i;
+    uint32            k;
+    uint32            L;
+    bool              dmrs;
+
+    if(phy_struct    != NULL                            &&
+       subframe      != NULL                            &&
+       pucch         != NULL                            &&
+       pucch->format  < LIBLTE_PHY_PUCCH_FORMAT_N_ITEMS &&
+       pucch->N_bits <= LIBLTE_PHY_PUCCH_N_BITS_MAX     &&
+       phy_struct->ul_init)
+    {
+        pucch_calc_resources(phy_struct,
+                             pucch->format,
+                             pucch->n_pucch,
+                             subframe->num,
+                             prb,
+                             n_oc,
+                             n_prime,
+                             n_cs);
+        if(LIBLTE_PHY_PUCCH_FORMAT_2 == pucch->format)
+        {
+            N_dmrs = 2;
+        }else{
+            N_dmrs = 3;
+        }
+
+        // Despread every symbol
+        for(i=0; i<LIBLTE_PHY_N_SLOTS_PER_SUBFR; i++)
+        {
+            for(L=0; L<LIBLTE_PHY_N_SYMB_PER_SLOT_UL; L++)
+            {
+                if(LIBLTE_PHY_PUCCH_FORMAT_2 == pucch->format)
+                {
+                    dmrs = (1 == L || 5 == L);
+                }else{
+                    dmrs = (L >= 2 && L <= 4);
+                }
+                rx_re = &subframe->rx_symb_re[i*LIBLTE_PHY_N_SYMB_PER_SLOT_UL + L][prb[i]*LIBLTE_PHY_N_SC_RB_UL];
+                rx_im = &subframe->rx_symb_im[i*LIBLTE_PHY_N_SYMB_PER_SLOT_UL + L][prb[i]*LIBLTE_PHY_N_SC_RB_UL];
+                r_re  = phy_struct->pucch_r_re[subframe->num*LIBLTE_PHY_N_SLOTS_PER_SUBFR + i][n_cs[i][L]];
+                r_im  = phy_struct->pucch_r_im[subframe->num*LIBLTE_PHY_N_SLOTS_PER_SUBFR + i][n_cs[i][L]];
+                z_re  = 0;
+                z_im  = 0;
+                for(k=0; k<LIBLTE_PHY_N_SC_RB_UL; k++)
+                {
+                    z_re += rx_re[k]*r_re[k] + rx_im[k]*r_im[k];
+                    z_im += rx_im[k]*r_re[k] - rx_re[k]*r_im[k];
+                    if(dmrs)
+                    {
+                        rx_energy += rx_re[k]*rx_re[k] + rx_im[k]*rx_im[k];
+                    }
+                }
+                y_re[i][L] = z_re/LIBLTE_PHY_N_SC_RB_UL;
+                y_im[i][L] = z_im/LIBLTE_PHY_N_SC_RB_UL;
+            }
+        }
+        rx_energy /= LIBLTE_PHY_N_SLOTS_PER_SUBFR*N_dmrs*LIBLTE_PHY_N_SC_RB_UL;
+
+        // Estimate the channel and equalize the data symbols of each slot
+        d_idx = 0;
+        for(i=0; i<LIBLTE_PHY_N_SLOTS_PER_SUBFR; i++)
+        {
+            if(LIBLTE_PHY_PUCCH_FORMAT_2 == pucch->format)
+            {
+                h_re = (y_re[i][1] + y_re[i][5])/N_dmrs;
+                h_im = (y_im[i][1] + y_im[i][5])/N_dmrs;
+                for(L=0; L<LIBLTE_PHY_N_SYMB_PER_SLOT_UL; L++)
+                {
+                    if(1 != L && 5 != L)
+                    {
+                        soft_bits[d_idx*2]   = y_re[i][L]*h_re + y_im[i][L]*h_im;
+                        soft_bits[d_idx*2+1] = y_im[i][L]*h_re - y_re[i][L]*h_im;
+                        d_idx++;
+                    }
+                }
+            }else{
+                h_re = 0;
+                h_im = 0;
+                for(m=0; m<N_dmrs; m++)
+                {
+                    w_re  = cos(2*M_PI*PUCCH_DMRS_W_5_5_2_2_1_2[n_oc[i]][m]/3);
+                    w_im  = sin(2*M_PI*PUCCH_DMRS_W_5_5_2_2_1_2[n_oc[i]][m]/3);
+                    h_re += y_re[i][m+2]*w_re + y_im[i][m+2]*w_im;
+                    h_im += y_im[i][m+2]*w_re - y_re[i][m+2]*w_im;
+                }
+                h_re /= N_dmrs;
+                h_im /= N_dmrs;
+                for(m=0; m<4; m++)
+                {
+                    L    = (m < 2) ? m : (m + 3);
+                    w_re = PUCCH_W_5_4_1_2[n_oc[i]][m]*h_re;
+                    w_im = PUCCH_W_5_4_1_2[n_oc[i]][m]*h_im;
+                    if((n_prime[i] % 2) == 1)
+                    {
+                        // S(n_s) = j
+                        z_re = -w_im;
+                        w_im = w_re;
+                        w_re = z_re;
+                    }
+                    acc_re += y_re[i][L]*w_re + y_im[i][L]*w_im;
+                    acc_im += y_im[i][L]*w_re - y_re[i][L]*w_im;
+                }
+            }
+            h_energy += h_re*h_re + h_im*h_im;
+        }
+        h_energy /= LIBLTE_PHY_N_SLOTS_PER_SUBFR;
+
+        // Detect
+        if(rx_energy > 0)
+        {
+            pucch->detect_metric = h_energy/rx_energy;
+        }else{
+            pucch->detect_metric = 0;
+        }
+
+        // Demodulate
+        if(LIBLTE_PHY_PUCCH_FORMAT_2 == pucch->format)
+        {
+            c_init = (subframe->num + 1)*(2*N_id_cell + 1)*65536 + pucch->rnti;
+            generate_prs_c(c_init, LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS, phy_struct->pucch_c);
+            for(i=0; i<LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS; i++)
+            {
+                soft_bits[i] *= 1 - 2*(float)phy_struct->pucch_c[i];
+            }
+            cqi_channel_decode(phy_struct,
+                               soft_bits,
+                               pucch->N_bits,
+                               pucch->bits);
+        }else if(LIBLTE_PHY_PUCCH_FORMAT_1A == pucch->format){
+            pucch->N_bits  = 1;
+            pucch->bits[0] = (acc_re < 0) ? 1 : 0;
+        }else if(LIBLTE_PHY_PUCCH_FORMAT_1B == pucch->format){
+            pucch->N_bits = 2;
+            if(fabs(acc_re) >= fabs(acc_im))
+            {
+                pucch->bits[0] = (acc_re < 0) ? 1 : 0;
+                pucch->bits[1] = pucch->bits[0];
+            }else{
+                pucch->bits[0] = (acc_im > 0) ? 1 : 0;
+                pucch->bits[1] = 1 - pucch->bits[0];
+            }
+        }else{ // LIBLTE_PHY_PUCCH_FORMAT_1 == pucch->format
+            pucch->N_bits = 0;
+        }
+
+        if(pucch->detect_metric >= LIBLTE_PHY_PUCCH_DETECT_THRESH)
+        {
+            err = LIBLTE_SUCCESS;
+        }else{
+            err = LIBLTE_ERROR_DECODE_FAIL;
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_generate_prach
+
+    Description: Generates the baseband signal for a PRACH
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.3
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_generate_prach(LIBLTE_PHY_STRUCT *phy_struct,
+                                            uint32             preamble_idx,
+                                            uint32             freq_offset,
+                                            float             *samps_re,
+                                            float             *samps_im)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            idx;
+    uint32            N_ra_prb;
+    uint32            k_0;
+    uint32            K;
+    uint32            start;
+
+    if(phy_struct != NULL &&
+       samps_re   != NULL &&
+       samps_im   != NULL &&
+       phy_struct->ul_init)
+    {
+        // Calculate PRACH parameters
+        N_ra_prb = freq_offset;
+        k_0      = N_ra_prb*phy_struct->N_sc_rb_ul - phy_struct->N_rb_ul*phy_struct->N_sc_rb_ul/2 + (phy_struct->FFT_size/2);
+        K        = 15000/phy_struct->prach_delta_f_RA;
+
+        for(i=0; i<phy_struct->prach_N_zc; i++)
+        {
+            phy_struct->prach_dft_in[i][0] = phy_struct->prach_x_u_v_re[preamble_idx][i];
+            phy_struct->prach_dft_in[i][1] = phy_struct->prach_x_u_v_im[preamble_idx][i];
+        }
+        fftwf_execute(phy_struct->prach_dft_plan);
+        for(i=0; i<phy_struct->prach_T_fft; i++)
+        {
+            phy_struct->prach_fft_in[i][0] = 0;
+            phy_struct->prach_fft_in[i][1] = 0;
+        }
+        start = phy_struct->prach_phi + (K*k_0) + (K/2);
+        for(i=0; i<phy_struct->prach_N_zc; i++)
+        {
+            idx                              = (i+start+phy_struct->prach_T_fft/2)%phy_struct->prach_T_fft;
+            phy_struct->prach_fft_in[idx][0] = phy_struct->prach_dft_out[(i+phy_struct->prach_N_zc/2)%phy_struct->prach_N_zc][0];
+            phy_struct->prach_fft_in[idx][1] = phy_struct->prach_dft_out[(i+phy_struct->prach_N_zc/2)%phy_struct->prach_N_zc][1];
+        }
+        fftwf_execute(phy_struct->prach_ifft_plan);
+        if(phy_struct->prach_T_fft == phy_struct->prach_T_seq)
+        {
+            for(i=0; i<phy_struct->prach_T_fft; i++)
+            {
+                samps_re[phy_struct->prach_T_cp+i] = phy_struct->prach_fft_out[i][0];
+                samps_im[phy_struct->prach_T_cp+i] = phy_struct->prach_fft_out[i][1];
+            }
+        }else{
+            for(i=0; i<phy_struct->prach_T_fft; i++)
+            {
+                samps_re[phy_struct->prach_T_cp+i]                         = phy_struct->prach_fft_out[i][0];
+                samps_im[phy_struct->prach_T_cp+i]                         = phy_struct->prach_fft_out[i][1];
+                samps_re[phy_struct->prach_T_cp+phy_struct->prach_T_fft+i] = phy_struct->prach_fft_out[i][0];
+                samps_im[phy_struct->prach_T_cp+phy_struct->prach_T_fft+i] = phy_struct->prach_fft_out[i][1];
+            }
+        }
+        for(i=0; i<phy_struct->prach_T_cp; i++)
+        {
+            samps_re[i] = samps_re[phy_struct->prach_T_seq+i];
+            samps_im[i] = samps_im[phy_struct->prach_T_seq+i];
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_detect_prach
+
+    Description: Detects PRACHs from baseband I/Q
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.2 and 5.7.3
+
+    Notes: Currently only supports detection of one preamble
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_detect_prach(LIBLTE_PHY_STRUCT *phy_struct,
+                                          float             *samps_re,
+                                          float             *samps_im,
+                                          uint32             freq_offset,
+                                          uint32            *N_det_pre,
+                                          uint32            *det_pre,
+                                          uint32            *det_ta)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    float             max_val;
+    float             abs_corr;
+    float             ave_val;
+    int32             N_neg_RA_shift;
     uint32            i;
     uint32            j;
     uint32            u;
@@ -3194,6 +4367,9 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *ph
     uint32            c_init;
     uint32            N_bits_tot;
     uint32            N_bits;
+    uint32            N_layers;
+    uint32            N_l;
+    uint32            Q_m;
     uint32            M_symb;
     uint32            M_layer_symb;
     uint32            M_ap_symb;
@@ -3228,10 +4404,45 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *ph
             last_sc  = (53*phy_struct->N_sc_rb_dl)-1;
         }
 
+        err = LIBLTE_SUCCESS;
         for(alloc_idx=0; alloc_idx<pdcch->N_alloc; alloc_idx++)
         {
             if(pdcch->alloc[alloc_idx].chan_type == LIBLTE_PHY_CHAN_TYPE_DLSCH)
             {
+                // Determine the number of layers, N_l is 2 for transmit
+                // diversity (3GPP TS 36.212 v10.1.0 section 5.3.2.5)
+                if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY == pdcch->alloc[alloc_idx].pre_coder_type)
+                {
+                    N_layers = N_ant;
+                    if(N_ant == 1)
+                    {
+                        N_l = 1;
+                    }else{
+                        N_l = 2;
+                    }
+                }else if(dl_pre_coder_is_valid(N_ant,
+                                               pdcch->alloc[alloc_idx].N_layers,
+                                               pdcch->alloc[alloc_idx].pre_coder_type,
+                                               pdcch->alloc[alloc_idx].codebook_idx)){
+                    N_layers = pdcch->alloc[alloc_idx].N_layers;
+                    N_l      = N_layers;
+                }else{
+                    err = LIBLTE_ERROR_INVALID_INPUTS;
+                    continue;
+                }
+
+                // Determine Q_m
+                if(LIBLTE_PHY_MODULATION_TYPE_BPSK == pdcch->alloc[alloc_idx].mod_type)
+                {
+                    Q_m = 1;
+                }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == pdcch->alloc[alloc_idx].mod_type){
+                    Q_m = 2;
+                }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == pdcch->alloc[alloc_idx].mod_type){
+                    Q_m = 4;
+                }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == pdcch->alloc[alloc_idx].mod_type
+                    Q_m = 6;
+                }
+
                 // Determine the number of bits available for transmission
                 N_bits_tot = 0;
                 for(i=0; i<pdcch->alloc[alloc_idx].N_prb; i++)
@@ -3243,6 +4454,10 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *ph
                                                       N_ant,
                                                       pdcch->alloc[alloc_idx].mod_type);
                 }
+                if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY != pdcch->alloc[alloc_idx].pre_coder_type)
+                {
+                    N_bits_tot *= N_layers;
+                }
                 // Encode the PDSCH
                 dlsch_channel_encode(phy_struct,
                                      pdcch->alloc[alloc_idx].msg.msg,
@@ -3251,8 +4466,8 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *ph
                                      pdcch->alloc[alloc_idx].tx_mode,
                                      pdcch->alloc[alloc_idx].rv_idx,
                                      N_bits_tot,
-                                     2,
-                                     2,
+                                     N_l,
+                                     Q_m,
                                      8,
                                      250368,
                                      phy_struct->pdsch_encode_bits,
@@ -3273,7 +4488,7 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *ph
                 layer_mapper_dl(phy_struct->pdsch_d_re,
                                 phy_struct->pdsch_d_im,
                                 M_symb,
-                                N_ant,
+                                N_layers,
                                 1,
                                 pdcch->alloc[alloc_idx].pre_coder_type,
                                 phy_struct->pdsch_x_re,
@@ -3283,7 +4498,9 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *ph
                              phy_struct->pdsch_x_im,
                              M_layer_symb,
                              N_ant,
+                             N_layers,
                              pdcch->alloc[alloc_idx].pre_coder_type,
+                             pdcch->alloc[alloc_idx].codebook_idx,
                              phy_struct->pdsch_y_re[0],
                              phy_struct->pdsch_y_im[0],
                              5000,
@@ -3348,7 +4565,6 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *ph
                 }
             }
         }
-        err = LIBLTE_SUCCESS;
     }
 
     return(err);
@@ -3370,28 +4586,106 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_decode(LIBLTE_PHY_STRUCT            *
                                                   uint8                         N_ant,
                                                   uint8                        *out_bits,
                                                   uint32                       *N_out_bits)
+{
+    return(liblte_phy_pdsch_channel_decode_multi_rx(phy_struct,
+                                                    &subframe,
+                                                    1,
+                                                    alloc,
+                                                    N_pdcch_symbs,
+                                                    N_id_cell,
+                                                    N_ant,
+                                                    NULL,
+                                                    out_bits,
+                                                    N_out_bits));
+}
+
+/*********************************************************************
+    Name: liblte_phy_pdsch_channel_decode_multi_rx
+
+    Description: Demodulates and decodes the Physical Downlink Shared
+                 Channel received on one or more receive antennas
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3 and 6.4
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_decode_multi_rx(LIBLTE_PHY_STRUCT             *phy_struct,
+                                                           LIBLTE_PHY_SUBFRAME_STRUCT   **subframe,
+                                                           uint8                          N_rx,
+                                                           LIBLTE_PHY_ALLOCATION_STRUCT  *alloc,
+                                                           uint32                         N_pdcch_symbs,
+                                                           uint32                         N_id_cell,
+                                                           uint8                          N_ant,
+                                                           LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer,
+                                                           uint8                         *out_bits,
+                                                           uint32                        *N_out_bits)
 {
     LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
     uint32            i;
     uint32            j;
     uint32            p;
+    uint32            r;
     uint32            L;
     uint32            prb_idx;
     uint32            idx;
     uint32            c_init;
+    uint32            N_layers;
+    uint32            N_l;
+    uint32            Q_m;
     uint32            M_layer_symb;
     uint32            M_symb;
     uint32            N_bits;
     uint32            first_sc;
     uint32            last_sc;
-
-    if(phy_struct != NULL &&
-       subframe   != NULL &&
-       N_id_cell  >= 0    &&
-       N_id_cell  <= 503  &&
-       out_bits   != NULL &&
+    uint32            sc;
+    float             noise_var;
+    float             h_pow;
+    float             snr_weight;
+
+    if(phy_struct != NULL                    &&
+       subframe   != NULL                    &&
+       N_rx       >= 1                       &&
+       N_rx       <= LIBLTE_PHY_N_RX_ANT_MAX &&
+       alloc      != NULL                    &&
+       N_id_cell  >= 0                       &&
+       N_id_cell  <= 503                     &&
+       out_bits   != NULL                    &&
        N_out_bits != NULL)
     {
+        for(r=0; r<N_rx; r++)
+        {
+            if(subframe[r] == NULL)
+            {
+                return(err);
+            }
+        }
+        // Determine the number of layers, N_l is 2 for transmit
+        // diversity (3GPP TS 36.212 v10.1.0 section 5.3.2.5)
+        if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY == alloc->pre_coder_type)
+        {
+            N_layers = N_ant;
+            if(N_ant == 1)
+            {
+                N_l = 1;
+            }else{
+                N_l = 2;
+            }
+        }else if(dl_pre_coder_is_valid(N_ant, alloc->N_layers, alloc->pre_coder_type, alloc->codebook_idx)){
+            N_layers = alloc->N_layers;
+            N_l      = N_layers;
+        }else{
+            return(err);
+        }
+
+        // Determine Q_m
+        if(LIBLTE_PHY_MODULATION_TYPE_BPSK == alloc->mod_type)
+        {
+            Q_m = 1;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == alloc->mod_type){
+            Q_m = 2;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == alloc->mod_type){
+            Q_m = 4;
+        }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == alloc->mod_type
+            Q_m = 6;
+        }
         err = LIBLTE_ERROR_DECODE_FAIL;
 
         // Determine first and last PBCH, PSS, and SSS subcarriers
@@ -3416,15 +4710,32 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_decode(LIBLTE_PHY_STRUCT            *
             last_sc  = (53*phy_struct->N_sc_rb_dl)-1;
         }
 
+        // Estimate the channel for the allocated PRBs
+        for(r=0; r<N_rx; r++)
+        {
+            for(prb_idx=0; prb_idx<alloc->N_prb; prb_idx++)
+            {
+                dl_ce_calc(phy_struct, subframe[r], N_pdcch_symbs, 7-N_pdcch_symbs, alloc->prb[0][prb_idx], 1);
+                dl_ce_calc(phy_struct, subframe[r], 7, 7, alloc->prb[1][prb_idx], 1);
+            }
+        }
+
         // Extract resource elements and channel estimate 3GPP TS 36.211 v10.1.0 section 6.3.5
         idx = 0;
         for(L=N_pdcch_symbs; L<14; L++)
         {
             for(prb_idx=0; prb_idx<alloc->N_prb; prb_idx++)
             {
-                i = alloc->prb[L/7][prb_idx];
+                i         = alloc->prb[L/7][prb_idx];
+                noise_var = 0;
+                for(r=0; r<N_rx; r++)
+                {
+                    noise_var += subframe[r]->rx_noise_var[i];
+                }
+                noise_var /= N_rx;
                 for(j=0; j<phy_struct->N_sc_rb_dl; j++)
                 {
+                    sc = i*phy_struct->N_sc_rb_dl+j;
                     if(N_ant           == 1 &&
                        (L % 7)         == 0 &&
                        (N_id_cell % 6) == (j % 6))
@@ -3444,54 +4755,81 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_decode(LIBLTE_PHY_STRUCT            *
                              (L % 7)         == 1 &&
                              (N_id_cell % 3) == (j % 3)){
                         // Skip CRS
-                    }else if(subframe->num                == 0        &&
-                             (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                             (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                             L                            >= 7        &&
-                             L                            <= 10){
+                    }else if(subframe[0]->num == 0        &&
+                             sc               >= first_sc &&
+                             sc               <= last_sc  &&
+                             L                >= 7        &&
+                             L                <= 10){
                         // Skip PBCH
-                    }else if((subframe->num               == 0        ||
-                              subframe->num               == 5)       &&
-                             (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                             (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                             L                            == 6){
+                    }else if((subframe[0]->num == 0        ||
+                              subframe[0]->num == 5)       &&
+                             sc                >= first_sc &&
+                             sc                <= last_sc  &&
+                             L                 == 6){
                         // Skip PSS
-                    }else if((subframe->num               == 0        ||
-                              subframe->num               == 5)       &&
-                             (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                             (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                             L                            == 5){
+                    }else if((subframe[0]->num == 0        ||
+                              subframe[0]->num == 5)       &&
+                             sc                >= first_sc &&
+                             sc                <= last_sc  &&
+                             L                 == 5){
                         // Skip SSS
                     }else{
-                        phy_struct->pdsch_y_est_re[idx] = subframe->rx_symb_re[L][i*phy_struct->N_sc_rb_dl+j];
-                        phy_struct->pdsch_y_est_im[idx] = subframe->rx_symb_im[L][i*phy_struct->N_sc_rb_dl+j];
-                        for(p=0; p<N_ant; p++)
+                        for(r=0; r<N_rx; r++)
                         {
-                            phy_struct->pdsch_c_est_re[p][idx] = subframe->rx_ce_re[p][L][i*phy_struct->N_sc_rb_dl+j];
-                            phy_struct->pdsch_c_est_im[p][idx] = subframe->rx_ce_im[p][L][i*phy_struct->N_sc_rb_dl+j];
+                            phy_struct->pdsch_y_est_re[r][idx] = subframe[r]->rx_symb_re[L][sc];
+                            phy_struct->pdsch_y_est_im[r][idx] = subframe[r]->rx_symb_im[L][sc];
+                            for(p=0; p<N_ant; p++)
+                            {
+                                phy_struct->pdsch_c_est_re[r][p][idx] = subframe[r]->rx_ce_re[p][L][sc];
+                                phy_struct->pdsch_c_est_im[r][p][idx] = subframe[r]->rx_ce_im[p][L][sc];
+                            }
                         }
+                        phy_struct->pdsch_noise_var[idx] = noise_var;
                         idx++;
                     }
                 }
             }
         }
 
-        pre_decoder_and_matched_filter_dl(phy_struct->pdsch_y_est_re,
-                                          phy_struct->pdsch_y_est_im,
-                                          phy_struct->pdsch_c_est_re[0],
-                                          phy_struct->pdsch_c_est_im[0],
-                                          5000,
-                                          idx,
-                                          N_ant,
-                                          alloc->pre_coder_type,
-                                          phy_struct->pdsch_x_re,
-                                          phy_struct->pdsch_x_im,
-                                          &M_layer_symb);
+        if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY == alloc->pre_coder_type)
+        {
+            pre_decoder_and_matched_filter_dl(phy_struct->pdsch_y_est_re[0],
+                                              phy_struct->pdsch_y_est_im[0],
+                                              5000,
+                                              phy_struct->pdsch_c_est_re[0][0],
+                                              phy_struct->pdsch_c_est_im[0][0],
+                                              5000,
+                                              idx,
+                                              N_rx,
+                                              N_ant,
+                                              alloc->pre_coder_type,
+                                              phy_struct->pdsch_x_re,
+                                              phy_struct->pdsch_x_im,
+                                              &M_layer_symb);
+        }else{
+            pre_decoder_mmse_dl(phy_struct,
+                                phy_struct->pdsch_y_est_re[0],
+                                phy_struct->pdsch_y_est_im[0],
+                                5000,
+                                phy_struct->pdsch_c_est_re[0][0],
+                                phy_struct->pdsch_c_est_im[0][0],
+                                5000,
+                                phy_struct->pdsch_noise_var,
+                                idx,
+                                N_rx,
+                                N_ant,
+                                N_layers,
+                                alloc->pre_coder_type,
+                                alloc->codebook_idx,
+                                phy_struct->pdsch_x_re,
+                                phy_struct->pdsch_x_im,
+                                &M_layer_symb);
+        }
         layer_demapper_dl(phy_struct->pdsch_x_re,
                           phy_struct->pdsch_x_im,
                           M_layer_symb,
-                          N_ant,
-                          alloc->N_codewords,
+                          N_layers,
+                          1,
                           alloc->pre_coder_type,
                           phy_struct->pdsch_d_re,
                           phy_struct->pdsch_d_im,
@@ -3503,20 +4841,52 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_decode(LIBLTE_PHY_STRUCT            *
                             phy_struct->pdsch_soft_bits,
                             &N_bits);
         // FIXME: Only handling 1 codeword
-        c_init = (alloc->rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
+        c_init = (alloc->rnti << 14) | (0 << 13) | (subframe[0]->num << 9) | N_id_cell;
         generate_prs_c(c_init, N_bits, phy_struct->pdsch_c);
         for(i=0; i<N_bits; i++)
         {
             phy_struct->pdsch_descramb_bits[i] = (float)phy_struct->pdsch_soft_bits[i]*(1-2*(float)phy_struct->pdsch_c[i]);
         }
+        if(soft_buffer != NULL)
+        {
+            // Weight the equalized soft bits by the average SNR of this
+            // transmission, so a transmission through a deep fade counts
+            // for less when combined with the others
+            h_pow     = 0;
+            noise_var = 0;
+            for(i=0; i<idx; i++)
+            {
+                for(r=0; r<N_rx; r++)
+                {
+                    for(p=0; p<N_ant; p++)
+                    {
+                        h_pow += (phy_struct->pdsch_c_est_re[r][p][i]*phy_struct->pdsch_c_est_re[r][p][i] +
+                                  phy_struct->pdsch_c_est_im[r][p][i]*phy_struct->pdsch_c_est_im[r][p][i]);
+                    }
+                }
+                noise_var += phy_struct->pdsch_noise_var[i];
+            }
+            snr_weight = 1;
+            if(noise_var > 0)
+            {
+                snr_weight = h_pow/(N_ant*noise_var);
+            }
+            for(i=0; i<N_bits; i++)
+            {
+                phy_struct->pdsch_descramb_bits[i] *= snr_weight;
+            }
+        }
         if(LIBLTE_SUCCESS == dlsch_channel_decode(phy_struct,
                                                   phy_struct->pdsch_descramb_bits,
                                                   N_bits,
                                                   alloc->tbs,
                                                   alloc->tx_mode,
                                                   alloc->rv_idx,
+                                                  N_l,
+                                                  Q_m,
                                                   8,
                                                   250368, // FIXME: Using N_soft from a cat 1 UE (3GPP TS 36.306)
+                                                  soft_buffer,
                                                   out_bits,
                                                   N_out_bits))
         {
@@ -3598,7 +4968,9 @@ LIBLTE_ERROR_ENUM liblte_phy_bch_channel_encode(LIBLTE_PHY_STRUCT          *phy_
                      phy_struct->bch_x_im,
                      M_layer_symb,
                      N_ant,
+                     N_ant,
                      LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                     0,
                      phy_struct->bch_y_re[0],
                      phy_struct->bch_y_im[0],
                      240,
@@ -3657,6 +5029,8 @@ LIBLTE_ERROR_ENUM liblte_phy_bch_channel_decode(LIBLTE_PHY_STRUCT          *phy_
     uint32            M_layer_symb;
     uint32            M_symb;
     uint32            N_bits;
+    uint32            first_prb;
+    uint32            last_prb;
 
     if(phy_struct != NULL &&
        subframe   != NULL &&
@@ -3669,6 +5043,11 @@ LIBLTE_ERROR_ENUM liblte_phy_bch_channel_decode(LIBLTE_PHY_STRUCT          *phy_
     {
         err = LIBLTE_ERROR_DECODE_FAIL;
 
+        // Estimate the channel for the PRBs holding the PBCH
+        first_prb = (phy_struct->N_sc_rb_dl*phy_struct->N_rb_dl/2 - 36)/phy_struct->N_sc_rb_dl;
+        last_prb  = (phy_struct->N_sc_rb_dl*phy_struct->N_rb_dl/2 + 35)/phy_struct->N_sc_rb_dl;
+        dl_ce_calc(phy_struct, subframe, 7, 4, first_prb, last_prb-first_prb+1);
+
         // Unmap PBCH and channel estimates from resource elements
         idx = 0;
         for(i=0; i<72; i++)
@@ -3712,10 +5091,12 @@ LIBLTE_ERROR_ENUM liblte_phy_bch_channel_decode(LIBLTE_PHY_STRUCT          *phy_
             {
                 pre_decoder_and_matched_filter_dl(phy_struct->bch_y_est_re,
                                                   phy_struct->bch_y_est_im,
+                                                  240,
                                                   phy_struct->bch_c_est_re[0],
                                                   phy_struct->bch_c_est_im[0],
                                                   240,
                                                   240,
+                                                  1,
                                                   p,
                                                   LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
                                                   phy_struct->bch_x_re,
@@ -3793,36 +5174,30 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
                                                   LIBLTE_RRC_PHICH_DURATION_ENUM  phich_dur,
                                                   LIBLTE_PHY_SUBFRAME_STRUCT     *subframe)
 {
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
-    uint32            k;
-    uint32            p;
-    uint32            idx;
-    uint32            a_idx;
-    uint32            css_idx;
-    uint32            uss_idx;
-    uint32            actual_idx;
-    uint32            c_init;
-    uint32            N_bits;
-    uint32            M_symb;
-    uint32            M_layer_symb;
-    uint32            M_ap_symb;
-    uint32            N_reg_rb;
-    uint32            N_reg_pdcch;
-    uint32            N_cce_pdcch;
-    uint32            N_reg_cce;
-    uint32            dci_size;
-    uint32            N_dummy;
-    uint32            C_cc_sb;
-    uint32            R_cc_sb;
-    uint32            K_pi;
-    uint32            shift_idx;
-    uint32            k_prime;
-    uint32            l_prime;
-    uint32            m_prime;
-    uint32            Y_k;
-    bool              valid_reg;
+    LIBLTE_ERROR_ENUM                err = LIBLTE_ERROR_INVALID_INPUTS;
+    LIBLTE_PHY_PDCCH_REG_MAP_STRUCT *reg_map;
+    float                           *tx_re;
+    float                           *tx_im;
+    float                           *cce_re;
+    float                           *cce_im;
+    uint32                           i;
+    uint32                           j;
+    uint32                           p;
+    uint32                           idx;
+    uint32                           a_idx;
+    uint32                           css_idx;
+    uint32                           uss_idx;
+    uint32                           actual_idx;
+    uint32                           c_init;
+    uint32                           N_bits;
+    uint32                           M_symb;
+    uint32                           M_layer_symb;
+    uint32                           M_ap_symb;
+    uint32                           N_reg_pdcch;
+    uint32                           N_cce_pdcch;
+    uint32                           N_reg_cce;
+    uint32                           dci_size;
+    uint32                           Y_k;
 
     if(phy_struct != NULL &&
        pcfich     != NULL &&
@@ -3848,15 +5223,10 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
                 pdcch->N_symbs++;
             }
             // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.8.1
-            N_reg_rb    = 3;
+            reg_map     = pdcch_reg_map_get(phy_struct, pcfich, phich, N_id_cell, N_ant, pdcch->N_symbs);
             N_reg_cce   = 9;
-            N_reg_pdcch = pdcch->N_symbs*(phy_struct->N_rb_dl*N_reg_rb) - phy_struct->N_rb_dl - pcfich->N_reg - phich->N_reg;
-            if(N_ant == 4)
-            {
-                // Remove CRS
-                N_reg_pdcch -= phy_struct->N_rb_dl;
-            }
-            N_cce_pdcch = N_reg_pdcch/N_reg_cce;
+            N_reg_pdcch = reg_map->N_reg;
+            N_cce_pdcch = reg_map->N_cce;
 
             // Initialize the search space
             for(p=0; p<N_ant; p++)
@@ -3943,7 +5313,9 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
                                          phy_struct->pdcch_x_im,
                                          M_layer_symb,
                                          N_ant,
+                                         N_ant,
                                          LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                                         0,
                                          phy_struct->pdcch_y_re[0],
                                          phy_struct->pdcch_y_im[0],
                                          576,
@@ -3962,6 +5334,7 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
                                     phy_struct->pdcch_cce_used[4*css_idx+i] = true;
                                 }
                             }
+                            pdcch->alloc[a_idx].n_cce = 4*css_idx;
                             break;
                         }
                     }
@@ -4004,7 +5377,9 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
 //                                         phy_struct->pdcch_x_im,
 //                                         M_layer_symb,
 //                                         N_ant,
+//                                         N_ant,
 //                                         LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+//                                         0,
 //                                         phy_struct->pdcch_y_re[0],
 //                                         phy_struct->pdcch_y_im[0],
 //                                         576,
@@ -4028,150 +5403,24 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
 //                    }
 //                }
             }
-            // Construct REGs
-            for(p=0; p<N_ant; p++)
-            {
-                for(i=0; i<N_cce_pdcch; i++)
-                {
-                    for(j=0; j<N_reg_cce; j++)
-                    {
-                        for(k=0; k<4; k++)
-                        {
-                            phy_struct->pdcch_reg_re[p][i*N_reg_cce+j][k] = phy_struct->pdcch_cce_re[p][i][j*4+k];
-                            phy_struct->pdcch_reg_im[p][i*N_reg_cce+j][k] = phy_struct->pdcch_cce_im[p][i][j*4+k];
-                        }
-                    }
-                }
-            }
-            // Permute the REGs, 3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
-            for(p=0; p<N_ant; p++)
-            {
-                for(i=0; i<N_reg_pdcch; i++)
-                {
-                    for(j=0; j<4; j++)
-                    {
-                        phy_struct->pdcch_perm_re[p][i][j] = phy_struct->pdcch_reg_re[p][phy_struct->pdcch_permute_map[N_reg_pdcch][i]][j];
-                        phy_struct->pdcch_perm_im[p][i][j] = phy_struct->pdcch_reg_im[p][phy_struct->pdcch_permute_map[N_reg_pdcch][i]][j];
-                    }
-                }
-            }
-            // Cyclic shift the REGs
+            // Map the REGs to resource elements, 3GPP TS 36.211 v10.1.0 section 6.8.5,
+            // REGs that are not part of a CCE are transmitted as <NIL>
             for(p=0; p<N_ant; p++)
             {
-                for(i=0; i<N_reg_pdcch; i++)
+                tx_re  = &subframe->tx_symb_re[p][0][0];
+                tx_im  = &subframe->tx_symb_im[p][0][0];
+                cce_re = &phy_struct->pdcch_cce_re[p][0][0];
+                cce_im = &phy_struct->pdcch_cce_im[p][0][0];
+                for(i=0; i<N_cce_pdcch*N_reg_cce*4; i++)
                 {
-                    shift_idx = (i+N_id_cell) % N_reg_pdcch;
-                    for(j=0; j<4; j++)
-                    {
-                        phy_struct->pdcch_shift_re[p][i][j] = phy_struct->pdcch_perm_re[p][shift_idx][j];
-                        phy_struct->pdcch_shift_im[p][i][j] = phy_struct->pdcch_perm_im[p][shift_idx][j];
-                    }
+                    tx_re[reg_map->re_idx[i]] = cce_re[i];
+                    tx_im[reg_map->re_idx[i]] = cce_im[i];
                 }
-            }
-            // Map the REGs to resource elements, 3GPP TS 36.211 v10.1.0 section 6.8.5
-            // Step 1 and 2
-            m_prime = 0;
-            k_prime = 0;
-            // Step 10
-            while(k_prime < (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl))
-            {
-                // Step 3
-                l_prime = 0;
-                // Step 8
-                while(l_prime < pdcch->N_symbs)
+                for(i=N_cce_pdcch*N_reg_cce*4; i<N_reg_pdcch*4; i++)
                 {
-                    if(l_prime == 0)
-                    {
-                        // Step 4
-                        // Avoid PCFICH and PHICH
-                        valid_reg = true;
-                        for(i=0; i<pcfich->N_reg; i++)
-                        {
-                            if(k_prime == pcfich->k[i])
-                            {
-                                valid_reg = false;
-                            }
-                        }
-                        for(i=0; i<phich->N_reg; i++)
-                        {
-                            if(k_prime == phich->k[i])
-                            {
-                                valid_reg = false;
-                            }
-                        }
-                        if((k_prime % 6) == 0 && valid_reg == true)
-                        {
-                            if(m_prime < N_reg_pdcch)
-                            {
-                                // Step 5
-                                idx = 0;
-                                for(i=0; i<6; i++)
-                                {
-                                    // Avoid CRS
-                                    if((N_id_cell % 3) != (i % 3))
-                                    {
-                                        for(p=0; p<N_ant; p++)
-                                        {
-                                            subframe->tx_symb_re[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_re[p][m_prime][idx];
-                                            subframe->tx_symb_im[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_im[p][m_prime][idx];
-                                        }
-                                        idx++;
-                                    }
-                                }
-                                // Step 6
-                                m_prime++;
-                            }
-                        }
-                    }else if(l_prime == 1 && N_ant == 4){
-                        // Step 4
-                        if((k_prime % 6) == 0)
-                        {
-                            if(m_prime < N_reg_pdcch)
-                            {
-                                // Step 5
-                                idx = 0;
-                                for(i=0; i<6; i++)
-                                {
-                                    // Avoid CRS
-                                    if((N_id_cell % 3) != (i % 3))
-                                    {
-                                        for(p=0; p<N_ant; p++)
-                                        {
-                                            subframe->tx_symb_re[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_re[p][m_prime][idx];
-                                            subframe->tx_symb_im[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_im[p][m_prime][idx];
-                                        }
-                                        idx++;
-                                    }
-                                }
-                                // Step 6
-                                m_prime++;
-                            }
-                        }
-                    }else{
-                        // Step 4
-                        if((k_prime % 4) == 0)
-                        {
-                            if(m_prime < N_reg_pdcch)
-                            {
-                                // Step 5
-                                for(i=0; i<4; i++)
-                                {
-                                    for(p=0; p<N_ant; p++)
-                                    {
-                                        subframe->tx_symb_re[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_re[p][m_prime][i];
-                                        subframe->tx_symb_im[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_im[p][m_prime][i];
-                                    }
-                                }
-                                // Step 6
-                                m_prime++;
-                            }
-                        }
-                    }
-                    // Step 7
-                    l_prime++;
+                    tx_re[reg_map->re_idx[i]] = 0;
+                    tx_im[reg_map->re_idx[i]] = 0;
                 }
-                // Step 9
-                k_prime++;
             }
         }
 
@@ -4201,38 +5450,65 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
                                                   LIBLTE_PHY_PHICH_STRUCT        *phich,
                                                   LIBLTE_PHY_PDCCH_STRUCT        *pdcch)
 {
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
-    uint32            k;
-    uint32            p;
-    uint32            idx;
-    uint32            c_init;
-    uint32            M_layer_symb;
-    uint32            M_symb;
-    uint32            N_bits;
-    uint32            k_prime;
-    uint32            l_prime;
-    uint32            m_prime;
-    uint32            dci_1a_size;
-    uint32            dci_1c_size;
-    uint32            N_reg_rb;
-    uint32            shift_idx;
-    uint32            C_cc_sb;
-    uint32            R_cc_sb;
-    uint32            K_pi;
-    uint32            N_dummy;
-    uint32            N_reg_pdcch;
-    uint32            N_cce_pdcch;
-    uint32            N_reg_cce;
-    uint16            rnti = 0;
-    bool              valid_reg;
+    return(liblte_phy_pdcch_channel_decode_rntis(phy_struct,
+                                                 subframe,
+                                                 N_id_cell,
+                                                 N_ant,
+                                                 phich_res,
+                                                 phich_dur,
+                                                 NULL,
+                                                 0,
+                                                 pcfich,
+                                                 phich,
+                                                 pdcch));
+}
 
-    if(phy_struct != NULL &&
-       subframe   != NULL &&
-       pcfich     != NULL &&
-       phich      != NULL &&
-       pdcch      != NULL)
+/*********************************************************************
+    Name: liblte_phy_pdcch_channel_decode_rntis
+
+    Description: Demodulates and decodes all of the Physical Downlink
+                 Control Channels (PCFICH, PHICH, and PDCCH), blind
+                 decoding the PDCCH for a list of wanted RNTIs
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.7, 6.8, and
+                        6.9
+                        3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
+                        3GPP TS 36.213 v10.3.0 section 9.1.1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode_rntis(LIBLTE_PHY_STRUCT              *phy_struct,
+                                                        LIBLTE_PHY_SUBFRAME_STRUCT     *subframe,
+                                                        uint32                          N_id_cell,
+                                                        uint8                           N_ant,
+                                                        float                           phich_res,
+                                                        LIBLTE_RRC_PHICH_DURATION_ENUM  phich_dur,
+                                                        uint16                         *rnti_list,
+                                                        uint32                          N_rnti,
+                                                        LIBLTE_PHY_PCFICH_STRUCT       *pcfich,
+                                                        LIBLTE_PHY_PHICH_STRUCT        *phich,
+                                                        LIBLTE_PHY_PDCCH_STRUCT        *pdcch)
+{
+    LIBLTE_ERROR_ENUM                err = LIBLTE_ERROR_INVALID_INPUTS;
+    LIBLTE_PHY_PDCCH_REG_MAP_STRUCT *reg_map;
+    float                           *rx_re;
+    float                           *rx_im;
+    float                           *cce_re;
+    float                           *cce_im;
+    uint32                           i;
+    uint32                           p;
+    uint32                           c_init;
+    uint32                           N_bits;
+    uint32                           dci_1a_size;
+    uint32                           dci_1c_size;
+    uint32                           N_cce_pdcch;
+    uint32                           N_reg_cce;
+
+    if(phy_struct != NULL                       &&
+       subframe   != NULL                       &&
+       pcfich     != NULL                       &&
+       phich      != NULL                       &&
+       pdcch      != NULL                       &&
+       N_rnti     <= LIBLTE_PHY_PDCCH_MAX_RNTIS &&
+       (rnti_list != NULL || N_rnti == 0))
     {
         // PCFICH
         pcfich_channel_demap(phy_struct, subframe, N_id_cell, N_ant, pcfich, &N_bits);
@@ -4256,270 +5532,36 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
             pdcch->N_symbs++;
         }
         // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.8.1
-        N_reg_rb    = 3;
-        N_reg_pdcch = pdcch->N_symbs*(phy_struct->N_rb_dl*N_reg_rb) - phy_struct->N_rb_dl - pcfich->N_reg - phich->N_reg;
-        if(N_ant == 4)
-        {
-            // Remove CRS
-            N_reg_pdcch -= phy_struct->N_rb_dl;
-        }
-        N_cce_pdcch = N_reg_pdcch/9;
-        // Extract resource elements and channel estimate, 3GPP TS 36.211 v10.1.0 section 6.8.5
-        // Step 1 and 2
-        m_prime = 0;
-        k_prime = 0;
-        // Step 10
-        while(k_prime < (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl))
-        {
-            // Step 3
-            l_prime = 0;
-            // Step 8
-            while(l_prime < pdcch->N_symbs)
-            {
-                if(l_prime == 0)
-                {
-                    // Step 4
-                    // Avoid PCFICH and PHICH
-                    valid_reg = true;
-                    for(i=0; i<pcfich->N_reg; i++)
-                    {
-                        if(k_prime == pcfich->k[i])
-                        {
-                            valid_reg = false;
-                        }
-                    }
-                    for(i=0; i<phich->N_reg; i++)
-                    {
-                        if(k_prime == phich->k[i])
-                        {
-                            valid_reg = false;
-                        }
-                    }
-                    if((k_prime % 6) == 0 && valid_reg == true)
-                    {
-                        if(m_prime < N_reg_pdcch)
-                        {
-                            // Step 5
-                            idx = 0;
-                            for(i=0; i<6; i++)
-                            {
-                                // Avoid CRS
-                                if((N_id_cell % 3) != (i % 3))
-                                {
-                                    phy_struct->pdcch_reg_y_est_re[m_prime][idx] = subframe->rx_symb_re[l_prime][k_prime+i];
-                                    phy_struct->pdcch_reg_y_est_im[m_prime][idx] = subframe->rx_symb_im[l_prime][k_prime+i];
-                                    for(p=0; p<N_ant; p++)
-                                    {
-                                        phy_struct->pdcch_reg_c_est_re[p][m_prime][idx] = subframe->rx_ce_re[p][l_prime][k_prime+i];
-                                        phy_struct->pdcch_reg_c_est_im[p][m_prime][idx] = subframe->rx_ce_im[p][l_prime][k_prime+i];
-                                    }
-                                    idx++;
-                                }
-                            }
-                            // Step 6
-                            m_prime++;
-                        }
-                    }
-                }else if(l_prime == 1 && N_ant == 4){
-                    // Step 4
-                    if((k_prime % 6) == 0)
-                    {
-                        if(m_prime < N_reg_pdcch)
-                        {
-                            // Step 5
-                            idx = 0;
-                            for(i=0; i<6; i++)
-                            {
-                                // Avoid CRS
-                                if((N_id_cell % 3) != (i % 3))
-                                {
-                                    phy_struct->pdcch_reg_y_est_re[m_prime][idx] = subframe->rx_symb_re[l_prime][k_prime+i];
-                                    phy_struct->pdcch_reg_y_est_im[m_prime][idx] = subframe->rx_symb_im[l_prime][k_prime+i];
-                                    for(p=0; p<N_ant; p++)
-                                    {
-                                        phy_struct->pdcch_reg_c_est_re[p][m_prime][idx] = subframe->rx_ce_re[p][l_prime][k_prime+i];
-                                        phy_struct->pdcch_reg_c_est_im[p][m_prime][idx] = subframe->rx_ce_im[p][l_prime][k_prime+i];
-                                    }
-                                    idx++;
-                                }
-                            }
-                            // Step 6
-                            m_prime++;
-                        }
-                    }
-                }else{
-                    // Step 4
-                    if((k_prime % 4) == 0)
-                    {
-                        if(m_prime < N_reg_pdcch)
-                        {
-                            // Step 5
-                            for(i=0; i<4; i++)
-                            {
-                                phy_struct->pdcch_reg_y_est_re[m_prime][i] = subframe->rx_symb_re[l_prime][k_prime+i];
-                                phy_struct->pdcch_reg_y_est_im[m_prime][i] = subframe->rx_symb_im[l_prime][k_prime+i];
-                                for(p=0; p<N_ant; p++)
-                                {
-                                    phy_struct->pdcch_reg_c_est_re[p][m_prime][i] = subframe->rx_ce_re[p][l_prime][k_prime+i];
-                                    phy_struct->pdcch_reg_c_est_im[p][m_prime][i] = subframe->rx_ce_im[p][l_prime][k_prime+i];
-                                }
-                            }
-                            // Step 6
-                            m_prime++;
-                        }
-                    }
-                }
-                // Step 7
-                l_prime++;
-            }
-            // Step 9
-            k_prime++;
-        }
-        // Undo cyclic shift of the REGs
-        for(i=0; i<N_reg_pdcch; i++)
-        {
-            shift_idx = (i+N_id_cell) % N_reg_pdcch;
-            for(j=0; j<4; j++)
-            {
-                phy_struct->pdcch_shift_y_est_re[shift_idx][j] = phy_struct->pdcch_reg_y_est_re[i][j];
-                phy_struct->pdcch_shift_y_est_im[shift_idx][j] = phy_struct->pdcch_reg_y_est_im[i][j];
-                for(p=0; p<N_ant; p++)
-                {
-                    phy_struct->pdcch_shift_c_est_re[p][shift_idx][j] = phy_struct->pdcch_reg_c_est_re[p][i][j];
-                    phy_struct->pdcch_shift_c_est_im[p][shift_idx][j] = phy_struct->pdcch_reg_c_est_im[p][i][j];
-                }
-            }
-        }
-        // Undo permutation of the REGs, 3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
-        for(i=0; i<N_reg_pdcch; i++)
-        {
-            phy_struct->pdcch_reg_vec[i] = i;
-        }
-        // In order to recreate circular buffer, a dummy block must be
-        // sub block interleaved to determine where NULL bits are to be
-        // inserted
-        // Step 1
-        C_cc_sb = 32;
-        // Step 2
-        R_cc_sb = 0;
-        while(N_reg_pdcch > (C_cc_sb*R_cc_sb))
-        {
-            R_cc_sb++;
-        }
-        // Step 3
-        if(N_reg_pdcch < (C_cc_sb*R_cc_sb))
-        {
-            N_dummy = C_cc_sb*R_cc_sb - N_reg_pdcch;
-        }else{
-            N_dummy = 0;
-        }
-        for(i=0; i<N_dummy; i++)
-        {
-            phy_struct->ruc_tmp[i] = RX_NULL_BIT;
-        }
-        for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
-        {
-            phy_struct->ruc_tmp[i] = 0;
-        }
-        idx = 0;
-        for(i=0; i<R_cc_sb; i++)
-        {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_sb_mat[i][j] = phy_struct->ruc_tmp[idx++];
-            }
-        }
-        // Step 4
-        for(i=0; i<R_cc_sb; i++)
-        {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]];
-            }
-        }
-        // Step 5
-        idx = 0;
-        for(j=0; j<C_cc_sb; j++)
-        {
-            for(i=0; i<R_cc_sb; i++)
-            {
-                phy_struct->ruc_v[0][idx++] = phy_struct->ruc_sb_perm_mat[i][j];
-            }
-        }
-        // Recreate circular buffer
-        K_pi = R_cc_sb*C_cc_sb;
-        k    = 0;
-        j    = 0;
-        while(k < N_reg_pdcch)
-        {
-            if(phy_struct->ruc_v[0][j%K_pi] != RX_NULL_BIT)
-            {
-                phy_struct->ruc_v[0][j%K_pi] = phy_struct->pdcch_reg_vec[k++];
-            }
-            j++;
-        }
-        // Sub block deinterleaving
-        // Step 5
-        idx = 0;
-        for(j=0; j<C_cc_sb; j++)
-        {
-            for(i=0; i<R_cc_sb; i++)
-            {
-                phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_v[0][idx++];
-            }
-        }
-        // Step 4
-        for(i=0; i<R_cc_sb; i++)
-        {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]] = phy_struct->ruc_sb_perm_mat[i][j];
-            }
-        }
-        // Step 3
-        idx = 0;
-        for(i=0; i<R_cc_sb; i++)
-        {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_tmp[idx++] = phy_struct->ruc_sb_mat[i][j];
-            }
+        reg_map     = pdcch_reg_map_get(phy_struct, pcfich, phich, N_id_cell, N_ant, pdcch->N_symbs);
+        N_reg_cce   = 9;
+        N_cce_pdcch = reg_map->N_cce;
+        // Extract resource elements and channel estimate into CCEs, 3GPP TS 36.211 v10.1.0 section 6.8.5
+        dl_ce_calc(phy_struct, subframe, 0, pdcch->N_symbs, 0, phy_struct->N_rb_dl);
+        rx_re  = &subframe->rx_symb_re[0][0];
+        rx_im  = &subframe->rx_symb_im[0][0];
+        cce_re = &phy_struct->pdcch_cce_y_est_re[0][0];
+        cce_im = &phy_struct->pdcch_cce_y_est_im[0][0];
+        for(i=0; i<N_cce_pdcch*N_reg_cce*4; i++)
+        {
+            cce_re[i] = rx_re[reg_map->re_idx[i]];
+            cce_im[i] = rx_im[reg_map->re_idx[i]];
         }
-        for(i=0; i<N_reg_pdcch; i++)
-        {
-            for(j=0; j<4; j++)
-            {
-                phy_struct->pdcch_perm_y_est_re[i][j] = phy_struct->pdcch_shift_y_est_re[(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
-                phy_struct->pdcch_perm_y_est_im[i][j] = phy_struct->pdcch_shift_y_est_im[(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
-                for(p=0; p<N_ant; p++)
-                {
-                    phy_struct->pdcch_perm_c_est_re[p][i][j] = phy_struct->pdcch_shift_c_est_re[p][(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
-                    phy_struct->pdcch_perm_c_est_im[p][i][j] = phy_struct->pdcch_shift_c_est_im[p][(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
-                }
-            }
-        }
-        // Construct CCEs
-        N_reg_cce = 9;
-        for(i=0; i<N_cce_pdcch; i++)
+        for(p=0; p<N_ant; p++)
         {
-            for(j=0; j<N_reg_cce; j++)
+            rx_re  = &subframe->rx_ce_re[p][0][0];
+            rx_im  = &subframe->rx_ce_im[p][0][0];
+            cce_re = &phy_struct->pdcch_cce_c_est_re[p][0][0];
+            cce_im = &phy_struct->pdcch_cce_c_est_im[p][0][0];
+            for(i=0; i<N_cce_pdcch*N_reg_cce*4; i++)
             {
-                for(k=0; k<4; k++)
-                {
-                    phy_struct->pdcch_cce_y_est_re[i][j*4+k] = phy_struct->pdcch_perm_y_est_re[i*N_reg_cce+j][k];
-                    phy_struct->pdcch_cce_y_est_im[i][j*4+k] = phy_struct->pdcch_perm_y_est_im[i*N_reg_cce+j][k];
-                    for(p=0; p<N_ant; p++)
-                    {
-                        phy_struct->pdcch_cce_c_est_re[p][i][j*4+k] = phy_struct->pdcch_perm_c_est_re[p][i*N_reg_cce+j][k];
-                        phy_struct->pdcch_cce_c_est_im[p][i][j*4+k] = phy_struct->pdcch_perm_c_est_im[p][i*N_reg_cce+j][k];
-                    }
-                }
+                cce_re[i] = rx_re[reg_map->re_idx[i]];
+                cce_im[i] = rx_im[reg_map->re_idx[i]];
             }
         }
 
         // Generate the scrambling sequence
         c_init = (subframe->num << 9) + N_id_cell;
-        generate_prs_c(c_init, 1152, phy_struct->pdcch_c);
+        generate_prs_c(c_init, N_cce_pdcch*N_reg_cce*4*2, phy_struct->pdcch_c);
 
         // Determine the size of DCI 1A and 1C FIXME: Clean this up
         if(phy_struct->N_rb_dl == 6)
@@ -4543,256 +5585,16 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT
             dci_1c_size = 15;
         }
 
-        // Try decoding DCI 1A and 1C for SI in the common search space
-        pdcch->N_alloc = 0;
-        for(i=0; i<4; i++)
-        {
-            idx = 0;
-            for(j=0; j<4; j++)
-            {
-                for(k=0; k<36; k++)
-                {
-                    phy_struct->pdcch_y_est_re[idx] = phy_struct->pdcch_cce_y_est_re[i*4+j][k];
-                    phy_struct->pdcch_y_est_im[idx] = phy_struct->pdcch_cce_y_est_im[i*4+j][k];
-                    for(p=0; p<N_ant; p++)
-                    {
-                        phy_struct->pdcch_c_est_re[p][idx] = phy_struct->pdcch_cce_c_est_re[p][i*4+j][k];
-                        phy_struct->pdcch_c_est_im[p][idx] = phy_struct->pdcch_cce_c_est_im[p][i*4+j][k];
-                    }
-                    idx++;
-                }
-            }
-
-            pre_decoder_and_matched_filter_dl(phy_struct->pdcch_y_est_re,
-                                              phy_struct->pdcch_y_est_im,
-                                              phy_struct->pdcch_c_est_re[0],
-                                              phy_struct->pdcch_c_est_im[0],
-                                              576,
-                                              idx,
-                                              N_ant,
-                                              LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                                              phy_struct->pdcch_x_re,
-                                              phy_struct->pdcch_x_im,
-                                              &M_layer_symb);
-            layer_demapper_dl(phy_struct->pdcch_x_re,
-                              phy_struct->pdcch_x_im,
-                              M_layer_symb,
-                              N_ant,
-                              1,
-                              LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                              phy_struct->pdcch_d_re,
-                              phy_struct->pdcch_d_im,
-                              &M_symb);
-            modulation_demapper(phy_struct->pdcch_d_re,
-                                phy_struct->pdcch_d_im,
-                                M_symb,
-                                LIBLTE_PHY_MODULATION_TYPE_QPSK,
-                                phy_struct->pdcch_soft_bits,
-                                &N_bits);
-            for(j=0; j<N_bits; j++)
-            {
-                phy_struct->pdcch_descramb_bits[j] = (float)phy_struct->pdcch_soft_bits[j]*(1-2*(float)phy_struct->pdcch_c[i*288+j]);
-            }
-            if(pdcch->N_alloc  <  LIBLTE_PHY_PDCCH_MAX_ALLOC &&
-               (LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_SI_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1a_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_P_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1a_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_RA_RNTI_START,
-                                                     LIBLTE_MAC_RA_RNTI_END - LIBLTE_MAC_RA_RNTI_START + 1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1a_size,
-                                                     &rnti)))
-            {
-                err = LIBLTE_SUCCESS;
-                dci_1a_unpack(phy_struct->pdcch_dci,
-                              dci_1a_size,
-                              LIBLTE_PHY_DCI_CA_NOT_PRESENT,
-                              rnti,
-                              phy_struct->N_rb_dl,
-                              N_ant,
-                              &pdcch->alloc[pdcch->N_alloc++]);
-            }
-            if(pdcch->N_alloc  <  LIBLTE_PHY_PDCCH_MAX_ALLOC &&
-               (LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_SI_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1c_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_P_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1c_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_RA_RNTI_START,
-                                                     LIBLTE_MAC_RA_RNTI_END - LIBLTE_MAC_RA_RNTI_START + 1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1c_size,
-                                                     &rnti)))
-            {
-                err = LIBLTE_SUCCESS;
-                dci_1c_unpack(phy_struct->pdcch_dci,
-                              dci_1c_size,
-                              rnti,
-                              phy_struct->N_rb_dl,
-                              N_ant,
-                              &pdcch->alloc[pdcch->N_alloc++]);
-            }
-        }
-        for(i=0; i<2; i++)
-        {
-            idx = 0;
-            for(j=0; j<8; j++)
-            {
-                for(k=0; k<36; k++)
-                {
-                    phy_struct->pdcch_y_est_re[idx] = phy_struct->pdcch_cce_y_est_re[i*8+j][k];
-                    phy_struct->pdcch_y_est_im[idx] = phy_struct->pdcch_cce_y_est_im[i*8+j][k];
-                    for(p=0; p<N_ant; p++)
-                    {
-                        phy_struct->pdcch_c_est_re[p][idx] = phy_struct->pdcch_cce_c_est_re[p][i*8+j][k];
-                        phy_struct->pdcch_c_est_im[p][idx] = phy_struct->pdcch_cce_c_est_im[p][i*8+j][k];
-                    }
-                    idx++;
-                }
-            }
-
-            pre_decoder_and_matched_filter_dl(phy_struct->pdcch_y_est_re,
-                                              phy_struct->pdcch_y_est_im,
-                                              phy_struct->pdcch_c_est_re[0],
-                                              phy_struct->pdcch_c_est_im[0],
-                                              576,
-                                              idx,
-                                              N_ant,
-                                              LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                                              phy_struct->pdcch_x_re,
-                                              phy_struct->pdcch_x_im,
-                                              &M_layer_symb);
-            layer_demapper_dl(phy_struct->pdcch_x_re,
-                              phy_struct->pdcch_x_im,
-                              M_layer_symb,
-                              N_ant,
-                              1,
-                              LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                              phy_struct->pdcch_d_re,
-                              phy_struct->pdcch_d_im,
-                              &M_symb);
-            modulation_demapper(phy_struct->pdcch_d_re,
-                                phy_struct->pdcch_d_im,
-                                M_symb,
-                                LIBLTE_PHY_MODULATION_TYPE_QPSK,
-                                phy_struct->pdcch_soft_bits,
-                                &N_bits);
-            for(j=0; j<N_bits; j++)
-            {
-                phy_struct->pdcch_descramb_bits[j] = (float)phy_struct->pdcch_soft_bits[j]*(1-2*(float)phy_struct->pdcch_c[i*576+j]);
-            }
-            if(pdcch->N_alloc  <  LIBLTE_PHY_PDCCH_MAX_ALLOC &&
-               (LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_SI_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1a_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_P_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1a_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_RA_RNTI_START,
-                                                     LIBLTE_MAC_RA_RNTI_END - LIBLTE_MAC_RA_RNTI_START + 1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1a_size,
-                                                     &rnti)))
-            {
-                err = LIBLTE_SUCCESS;
-                dci_1a_unpack(phy_struct->pdcch_dci,
-                              dci_1a_size,
-                              LIBLTE_PHY_DCI_CA_NOT_PRESENT,
-                              rnti,
-                              phy_struct->N_rb_dl,
-                              N_ant,
-                              &pdcch->alloc[pdcch->N_alloc++]);
-            }
-            if(pdcch->N_alloc  <  LIBLTE_PHY_PDCCH_MAX_ALLOC &&
-               (LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_SI_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1c_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_P_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1c_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_RA_RNTI_START,
-                                                     LIBLTE_MAC_RA_RNTI_END - LIBLTE_MAC_RA_RNTI_START + 1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1c_size,
-                                                     &rnti)))
-            {
-                err = LIBLTE_SUCCESS;
-                dci_1c_unpack(phy_struct->pdcch_dci,
-                              dci_1c_size,
-                              rnti,
-                              phy_struct->N_rb_dl,
-                              N_ant,
-                              &pdcch->alloc[pdcch->N_alloc++]);
-            }
-        }
+        // Blind decode the DCIs
+        err = pdcch_blind_decode(phy_struct,
+                                 N_ant,
+                                 N_cce_pdcch,
+                                 subframe->num,
+                                 rnti_list,
+                                 N_rnti,
+                                 dci_1a_size,
+                                 dci_1c_size,
+                                 pdcch);
     }
 
     return(err);
@@ -5015,8 +5817,12 @@ LIBLTE_ERROR_ENUM liblte_phy_find_pss_and_fine_timing(LIBLTE_PHY_STRUCT *phy_str
         {
             for(j=0; j<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; j++)
             {
-                phy_struct->pss_mod_re[i][j] = 0;
-                phy_struct->pss_mod_im[i][j] = 0;
+                phy_struct->pss_mod_re_n1[i][j] = 0;
+                phy_struct->pss_mod_im_n1[i][j] = 0;
+                phy_struct->pss_mod_re[i][j]    = 0;
+                phy_struct->pss_mod_im[i][j]    = 0;
+                phy_struct->pss_mod_re_p1[i][j] = 0;
+                phy_struct->pss_mod_im_p1[i][j] = 0;
             }
             generate_pss(i, pss_re, pss_im);
             for(j=0; j<62; j++)
@@ -5581,23 +6387,20 @@ LIBLTE_ERROR_ENUM liblte_phy_get_dl_subframe_and_ce(LIBLTE_PHY_STRUCT          *
     float             *sym_im;
     float             *rs_re;
     float             *rs_im;
-    float              tmp_re;
-    float              tmp_im;
-    float              frac_mag = 0;
-    float              frac_ang = 0;
-    float              ce_mag;
-    float              ce_ang;
+    float             *h_re;
+    float             *h_im;
+    float              e_re;
+    float              e_im;
+    float              sig_pow   = 0;
+    float              noise_pow = 0;
     uint32             v_shift         = N_id_cell % 6;
     uint32             subfr_start_idx = frame_start_idx + subfr_num*phy_struct->N_samps_per_subfr;
-    uint32             N_sym;
-    uint32             m_prime;
+    uint32             N_rs            = 2*phy_struct->N_rb_dl;
+    uint32             N_crs_symbs     = 0;
+    uint32             off;
     uint32             i;
     uint32             j;
-    uint32             k = 0;
     uint32             p;
-    uint32             v[5];
-    uint32             sym[5];
-    uint32             z;
 
     if(phy_struct != NULL &&
        i_samps    != NULL &&
@@ -5631,232 +6434,95 @@ LIBLTE_ERROR_ENUM liblte_phy_get_dl_subframe_and_ce(LIBLTE_PHY_STRUCT          *
         generate_crs((subfr_num*2+2)%20, 0, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[14], phy_struct->dl_ce_crs_im[14]);
         generate_crs((subfr_num*2+2)%20, 1, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[15], phy_struct->dl_ce_crs_im[15]);
 
-        // Determine channel estimates
-        for(p=0; p<N_ant; p++)
+        // Invalidate any channel estimates from a previous subframe
+        subframe->rx_ce_N_ant   = N_ant;
+        subframe->rx_ce_v_shift = v_shift;
+        subframe->rx_ce_wiener  = (LIBLTE_PHY_DL_CE_INTERP_WIENER == phy_struct->dl_ce_interp);
+        for(i=0; i<phy_struct->N_rb_dl; i++)
         {
-            // Define v, sym, and N_sym
-            if(p == 0)
-            {
-                v[0]   = 0;
-                v[1]   = 3;
-                v[2]   = 0;
-                v[3]   = 3;
-                v[4]   = 0;
-                sym[0] = 0;
-                sym[1] = 4;
-                sym[2] = 7;
-                sym[3] = 11;
-                sym[4] = 14;
-                N_sym  = 5;
-            }else if(p == 1){
-                v[0]   = 3;
-                v[1]   = 0;
-                v[2]   = 3;
-                v[3]   = 0;
-                v[4]   = 3;
-                sym[0] = 0;
-                sym[1] = 4;
-                sym[2] = 7;
-                sym[3] = 11;
-                sym[4] = 14;
-                N_sym  = 5;
-            }else if(p == 2){
-                v[0]   = 0;
-                v[1]   = 3;
-                v[2]   = 0;
-                sym[0] = 1;
-                sym[1] = 8;
-                sym[2] = 15;
-                N_sym  = 3;
-            }else{ // p == 3
-                v[0]   = 3;
-                v[1]   = 6;
-                v[2]   = 3;
-                sym[0] = 1;
-                sym[1] = 8;
-                sym[2] = 15;
-                N_sym  = 3;
-            }
+            subframe->rx_noise_var[i]     = 0;
+            subframe->rx_ce_valid[i]      = 0;
+            subframe->rx_ce_freq_valid[i] = false;
+        }
 
-            for(i=0; i<N_sym; i++)
+        // Determine least squares channel estimates at the CRSs
+        for(p=0; p<N_ant; p++)
+        {
+            for(i=0; i<DL_CE_N_CRS_SYMBS[p]; i++)
             {
-                sym_re = &subframe->rx_symb_re[sym[i]][0];
-                sym_im = &subframe->rx_symb_im[sym[i]][0];
-                rs_re  = &phy_struct->dl_ce_crs_re[sym[i]][0];
-                rs_im  = &phy_struct->dl_ce_crs_im[sym[i]][0];
-
-                for(j=0; j<2*phy_struct->N_rb_dl; j++)
+                off    = (DL_CE_CRS_V[p][i] + v_shift) % 6;
+                sym_re = &subframe->rx_symb_re[DL_CE_CRS_SYMB[p][i]][off];
+                sym_im = &subframe->rx_symb_im[DL_CE_CRS_SYMB[p][i]][off];
+                rs_re  = &phy_struct->dl_ce_crs_re[DL_CE_CRS_SYMB[p][i]][LIBLTE_PHY_N_RB_DL_MAX - phy_struct->N_rb_dl];
+                rs_im  = &phy_struct->dl_ce_crs_im[DL_CE_CRS_SYMB[p][i]][LIBLTE_PHY_N_RB_DL_MAX - phy_struct->N_rb_dl];
+                h_re   = &subframe->rx_ce_rs_re[p][i][0];
+                h_im   = &subframe->rx_ce_rs_im[p][i][0];
+                for(j=0; j<N_rs; j++)
                 {
-                    k                           = 6*j + (v[i] + v_shift)%6;
-                    m_prime                     = j + LIBLTE_PHY_N_RB_DL_MAX - phy_struct->N_rb_dl;
-                    tmp_re                      = sym_re[k]*rs_re[m_prime] + sym_im[k]*rs_im[m_prime];
-                    tmp_im                      = sym_im[k]*rs_re[m_prime] - sym_re[k]*rs_im[m_prime];
-                    phy_struct->dl_ce_mag[i][k] = sqrt(tmp_re*tmp_re + tmp_im*tmp_im);
-                    phy_struct->dl_ce_ang[i][k] = atan2f(tmp_im, tmp_re);
-
-                    // Unwrap phase
-                    if(j > 0)
-                    {
-                        wrap_phase(&phy_struct->dl_ce_ang[i][k], phy_struct->dl_ce_ang[i][k-6]);
-
-                        // Linearly interpolate between CRSs
-                        frac_mag = (phy_struct->dl_ce_mag[i][k] - phy_struct->dl_ce_mag[i][k-6])/6;
-                        frac_ang = (phy_struct->dl_ce_ang[i][k] - phy_struct->dl_ce_ang[i][k-6])/6;
-                        for(z=1; z<6; z++)
-                        {
-                            phy_struct->dl_ce_mag[i][k-z] = phy_struct->dl_ce_mag[i][k-(z-1)] - frac_mag;
-                            phy_struct->dl_ce_ang[i][k-z] = phy_struct->dl_ce_ang[i][k-(z-1)] - frac_ang;
-                        }
-                    }
-
-                    // Linearly interpolate before 1st CRS
-                    if(j == 1)
-                    {
-                        for(z=1; z<((v[i] + v_shift)%6)+1; z++)
-                        {
-                            phy_struct->dl_ce_mag[i][k-6-z] = phy_struct->dl_ce_mag[i][k-6-(z-1)] - frac_mag;
-                            phy_struct->dl_ce_ang[i][k-6-z] = phy_struct->dl_ce_ang[i][k-6-(z-1)] - frac_ang;
-                        }
-                    }
+                    h_re[j]  = sym_re[6*j]*rs_re[j] + sym_im[6*j]*rs_im[j];
+                    h_im[j]  = sym_im[6*j]*rs_re[j] - sym_re[6*j]*rs_im[j];
+                    sig_pow += h_re[j]*h_re[j] + h_im[j]*h_im[j];
                 }
 
-                // Linearly interpolate after last CRS
-                for(z=1; z<(5-(v[i] + v_shift)%6)+1; z++)
+                // Estimate noise from the second difference of the CRS estimates,
+                // which has 1.5 times the noise variance for a locally linear channel
+                for(j=1; j<(N_rs - 1); j++)
                 {
-                    phy_struct->dl_ce_mag[i][k+z] = phy_struct->dl_ce_mag[i][k+(z-1)] - frac_mag;
-                    phy_struct->dl_ce_ang[i][k+z] = phy_struct->dl_ce_ang[i][k+(z-1)] - frac_ang;
+                    e_re                         = h_re[j] - (h_re[j-1] + h_re[j+1])/2;
+                    e_im                         = h_im[j] - (h_im[j-1] + h_im[j+1])/2;
+                    subframe->rx_noise_var[j/2] += (e_re*e_re + e_im*e_im)/1.5;
                 }
+                N_crs_symbs++;
             }
-
-            // Linearly interpolate between symbols to construct all channel estimates
-            if(N_sym == 3)
+        }
+        for(i=0; i<phy_struct->N_rb_dl; i++)
+        {
+            if(i == 0 || i == (phy_struct->N_rb_dl - 1))
             {
-                for(j=0; j<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; j++)
-                {
-                    // Construct symbol 1 and 8 channel estimates directly
-                    subframe->rx_ce_re[p][1][j] = phy_struct->dl_ce_mag[0][j]*cosf(phy_struct->dl_ce_ang[0][j]);
-                    subframe->rx_ce_im[p][1][j] = phy_struct->dl_ce_mag[0][j]*sinf(phy_struct->dl_ce_ang[0][j]);
-                    subframe->rx_ce_re[p][8][j] = phy_struct->dl_ce_mag[1][j]*cosf(phy_struct->dl_ce_ang[1][j]);
-                    subframe->rx_ce_im[p][8][j] = phy_struct->dl_ce_mag[1][j]*sinf(phy_struct->dl_ce_ang[1][j]);
-
-                    // Interpolate for symbol 2, 3, 4, 5, 6, and 7 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[1][j] - phy_struct->dl_ce_mag[0][j])/7;
-                    wrap_phase(&phy_struct->dl_ce_ang[1][j], phy_struct->dl_ce_ang[0][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[1][j] - phy_struct->dl_ce_ang[0][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 7;
-                    ce_mag    = phy_struct->dl_ce_mag[1][j];
-                    ce_ang    = phy_struct->dl_ce_ang[1][j];
-                    for(z=7; z>1; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
+                subframe->rx_noise_var[i] /= N_crs_symbs;
+            }else{
+                subframe->rx_noise_var[i] /= 2*N_crs_symbs;
+            }
+            noise_pow += subframe->rx_noise_var[i];
+        }
+        noise_pow /= phy_struct->N_rb_dl;
+        sig_pow    = sig_pow/(N_crs_symbs*N_rs) - noise_pow;
 
-                    // Interpolate for symbol 0 channel estimate
-                    // FIXME: Use previous slot to do this correctly
-                    ce_mag                      = phy_struct->dl_ce_mag[0][j] - frac_mag;
-                    ce_ang                      = phy_struct->dl_ce_ang[0][j] - frac_ang;
-                    subframe->rx_ce_re[p][0][j] = ce_mag*cosf(ce_ang);
-                    subframe->rx_ce_im[p][0][j] = ce_mag*sinf(ce_ang);
-
-                    // Interpolate for symbol 9, 10, 11, 12, and 13 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[2][j] - phy_struct->dl_ce_mag[1][j])/7;
-                    wrap_phase(&phy_struct->dl_ce_ang[2][j], phy_struct->dl_ce_ang[1][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[2][j] - phy_struct->dl_ce_ang[1][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 7;
-                    ce_mag    = phy_struct->dl_ce_mag[2][j] - frac_mag;
-                    ce_ang    = phy_struct->dl_ce_ang[2][j] - frac_ang;
-                    for(z=13; z>8; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
-                }
+        // Calculate Wiener interpolation weights for this subframe's noise to signal ratio
+        if(subframe->rx_ce_wiener)
+        {
+            if(sig_pow <= 0 || (noise_pow/sig_pow) < DL_CE_WIENER_MIN_NSR)
+            {
+                dl_ce_calc_wiener_weights(subframe, DL_CE_WIENER_MIN_NSR);
             }else{
-                for(j=0; j<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; j++)
-                {
-                    // Construct symbol 0, 4, 7, and 11 channel estimates directly
-                    subframe->rx_ce_re[p][0][j]  = phy_struct->dl_ce_mag[0][j]*cosf(phy_struct->dl_ce_ang[0][j]);
-                    subframe->rx_ce_im[p][0][j]  = phy_struct->dl_ce_mag[0][j]*sinf(phy_struct->dl_ce_ang[0][j]);
-                    subframe->rx_ce_re[p][4][j]  = phy_struct->dl_ce_mag[1][j]*cosf(phy_struct->dl_ce_ang[1][j]);
-                    subframe->rx_ce_im[p][4][j]  = phy_struct->dl_ce_mag[1][j]*sinf(phy_struct->dl_ce_ang[1][j]);
-                    subframe->rx_ce_re[p][7][j]  = phy_struct->dl_ce_mag[2][j]*cosf(phy_struct->dl_ce_ang[2][j]);
-                    subframe->rx_ce_im[p][7][j]  = phy_struct->dl_ce_mag[2][j]*sinf(phy_struct->dl_ce_ang[2][j]);
-                    subframe->rx_ce_re[p][11][j] = phy_struct->dl_ce_mag[3][j]*cosf(phy_struct->dl_ce_ang[3][j]);
-                    subframe->rx_ce_im[p][11][j] = phy_struct->dl_ce_mag[3][j]*sinf(phy_struct->dl_ce_ang[3][j]);
-
-                    // Interpolate for symbol 1, 2, and 3 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[1][j] - phy_struct->dl_ce_mag[0][j])/4;
-                    wrap_phase(&phy_struct->dl_ce_ang[1][j], phy_struct->dl_ce_ang[0][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[1][j] - phy_struct->dl_ce_ang[0][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 4;
-                    ce_mag    = phy_struct->dl_ce_mag[1][j];
-                    ce_ang    = phy_struct->dl_ce_ang[1][j];
-                    for(z=3; z>0; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
+                dl_ce_calc_wiener_weights(subframe, noise_pow/sig_pow);
+            }
+        }
 
-                    // Interpolate for symbol 5 and 6 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[2][j] - phy_struct->dl_ce_mag[1][j])/3;
-                    wrap_phase(&phy_struct->dl_ce_ang[2][j], phy_struct->dl_ce_ang[1][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[2][j] - phy_struct->dl_ce_ang[1][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 3;
-                    ce_mag    = phy_struct->dl_ce_mag[2][j];
-                    ce_ang    = phy_struct->dl_ce_ang[2][j];
-                    for(z=6; z>4; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
+        err = LIBLTE_SUCCESS;
+    }
 
-                    // Interpolate for symbol 8, 9, and 10 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[3][j] - phy_struct->dl_ce_mag[2][j])/4;
-                    wrap_phase(&phy_struct->dl_ce_ang[3][j], phy_struct->dl_ce_ang[2][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[3][j] - phy_struct->dl_ce_ang[2][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 4;
-                    ce_mag    = phy_struct->dl_ce_mag[3][j];
-                    ce_ang    = phy_struct->dl_ce_ang[3][j];
-                    for(z=10; z>7; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
+    return(err);
+}
 
-                    // Interpolate for symbol 12 and 13 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[4][j] - phy_struct->dl_ce_mag[3][j])/3;
-                    wrap_phase(&phy_struct->dl_ce_ang[4][j], phy_struct->dl_ce_ang[3][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[4][j] - phy_struct->dl_ce_ang[3][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 3;
-                    ce_mag    = phy_struct->dl_ce_mag[4][j];
-                    ce_ang    = phy_struct->dl_ce_ang[4][j];
-                    for(z=13; z>11; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
-                }
-            }
-        }
+/*********************************************************************
+    Name: liblte_phy_set_dl_ce_interp
+
+    Description: Selects the frequency interpolation used for the
+                 downlink channel estimates
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_dl_ce_interp(LIBLTE_PHY_STRUCT            *phy_struct,
+                                              LIBLTE_PHY_DL_CE_INTERP_ENUM  interp)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct != NULL                           &&
+       (interp    == LIBLTE_PHY_DL_CE_INTERP_LINEAR ||
+        interp    == LIBLTE_PHY_DL_CE_INTERP_WIENER))
+    {
+        phy_struct->dl_ce_interp = interp;
 
         err = LIBLTE_SUCCESS;
     }
@@ -6031,6 +6697,46 @@ LIBLTE_ERROR_ENUM liblte_phy_get_tbs_and_n_prb_for_dl(uint32  N_bits,
     return(err);
 }
 
+/*********************************************************************
+    Name: liblte_phy_get_tbs_for_dl
+
+    Description: Determines the transport block size carried by the
+                 specified number of PRBs according to the specified
+                 modulation and coding scheme
+
+    Document Reference: 3GPP TS 36.213 v10.3.0 section 7.1.7
+
+    NOTES: Currently only supports single layer transport blocks
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_get_tbs_for_dl(uint32  N_prb,
+                                            uint8   mcs,
+                                            uint32 *tbs)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            I_tbs;
+
+    if(tbs   != NULL &&
+       N_prb >= 1    &&
+       N_prb <= 110  &&
+       mcs   <= 28)
+    {
+        // Determine I_tbs
+        if(9 >= mcs)
+        {
+            I_tbs = mcs;
+        }else if(16 >= mcs){
+            I_tbs = mcs - 1;
+        }else{
+            I_tbs = mcs - 2;
+        }
+
+        *tbs = TBS_71721[I_tbs][N_prb-1];
+        err  = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
 /*********************************************************************
     Name: liblte_phy_get_tbs_mcs_and_n_prb_for_ul
 
@@ -6098,6 +6804,57 @@ LIBLTE_ERROR_ENUM liblte_phy_get_tbs_mcs_and_n_prb_for_ul(uint32  N_bits,
     return(err);
 }
 
+/*********************************************************************
+    Name: liblte_phy_get_n_prb_for_pucch
+
+    Description: Determines the number of PRBs at each edge of the
+                 UL band that are occupied by PUCCH
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4.3
+
+    Notes: Only handles normal CP
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_get_n_prb_for_pucch(uint32  delta_shift,
+                                                 uint32  N_rb_2,
+                                                 uint32  N_cs_1,
+                                                 uint32  n_1_pucch_max,
+                                                 uint32 *N_prb)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            c   = 3;
+    uint32            N_m;
+    uint32            m;
+
+    if(delta_shift != 0 &&
+       N_prb       != NULL)
+    {
+        // Format 2 and mixed resource blocks
+        N_m = N_rb_2;
+        if(N_cs_1 != 0)
+        {
+            N_m++;
+        }
+
+        // Format 1, 1a, and 1b resource blocks
+        if(n_1_pucch_max      != 0 &&
+           (n_1_pucch_max - 1) >= c*N_cs_1/delta_shift)
+        {
+            m = ((n_1_pucch_max - 1 - c*N_cs_1/delta_shift) / (c*LIBLTE_PHY_N_SC_RB_UL/delta_shift)) + N_rb_2 + ((N_cs_1 + 7) / 8);
+            if((m + 1) > N_m)
+            {
+                N_m = m + 1;
+            }
+        }
+
+        // Each pair of m values occupies one PRB at each band edge
+        *N_prb = (N_m + 1) / 2;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
 /*********************************************************************
     Name: liblte_phy_get_n_cce
 
@@ -6128,26 +6885,229 @@ LIBLTE_ERROR_ENUM liblte_phy_get_n_cce(LIBLTE_PHY_STRUCT *phy_struct,
     *N_cce = N_reg_pdcch/N_reg_cce;
 }
 
-/*******************************************************************************
-                              LOCAL FUNCTIONS
-*******************************************************************************/
-
 /*********************************************************************
-    Name: layer_mapper_ul
+    Name: liblte_phy_turbo_encode
 
-    Description: Maps complex-valued modulation symbols onto one or
-                 several uplink layers
+    Description: Turbo encodes a single code block, using either the
+                 lookup table encoder (as used by the DLSCH and ULSCH
+                 encoders) or the original bit serial encoder
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3.2A
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 
-    Notes: Currently only supports single antenna
+    Notes: Intended for benchmarking and verifying the encoders
 *********************************************************************/
-void layer_mapper_ul(float  *d_re,
-                     float  *d_im,
-                     uint32  M_symb,
-                     uint8   N_ant,
-                     uint32  N_codewords,
-                     float  *x_re,
+LIBLTE_ERROR_ENUM liblte_phy_turbo_encode(LIBLTE_PHY_STRUCT             *phy_struct,
+                                          LIBLTE_PHY_TURBO_ENCODER_ENUM  encoder,
+                                          uint8                         *c_bits,
+                                          uint32                         N_c_bits,
+                                          uint8                         *d_bits,
+                                          uint32                        *N_d_bits)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct                  != NULL &&
+       c_bits                      != NULL &&
+       d_bits                      != NULL &&
+       N_d_bits                    != NULL &&
+       (N_c_bits % 8)              == 0    &&
+       N_c_bits                    <= 6144 &&
+       TURBO_INT_K_IDX[N_c_bits/8] != -1)
+    {
+        if(LIBLTE_PHY_TURBO_ENCODER_LUT == encoder)
+        {
+            turbo_encode(phy_struct, c_bits, N_c_bits, 0, d_bits, N_d_bits);
+        }else{
+            turbo_encode_bit_serial(phy_struct, c_bits, N_c_bits, 0, d_bits, N_d_bits);
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_dl_pre_code
+
+    Description: Maps a block of downlink layers onto the antenna
+                 ports using the single antenna, transmit diversity,
+                 closed loop spatial multiplexing, or large delay CDD
+                 pre-coder
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4
+
+    Notes: Intended for benchmarking and verifying the pre-coders
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_dl_pre_code(LIBLTE_PHY_STRUCT              *phy_struct,
+                                         LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                                         float                          *x_re,
+                                         float                          *x_im,
+                                         uint32                          M_layer_symb,
+                                         uint8                           N_ant,
+                                         uint32                          N_layers,
+                                         uint32                          codebook_idx,
+                                         float                          *y_re,
+                                         float                          *y_im,
+                                         uint32                          y_len,
+                                         uint32                         *M_ap_symb)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct   != NULL &&
+       x_re         != NULL &&
+       x_im         != NULL &&
+       y_re         != NULL &&
+       y_im         != NULL &&
+       M_ap_symb    != NULL &&
+       M_layer_symb != 0    &&
+       (N_ant       == 1    ||
+        N_ant       == 2    ||
+        N_ant       == 4))
+    {
+        if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY == type)
+        {
+            if(N_layers           == N_ant &&
+               N_ant*M_layer_symb <= y_len)
+            {
+                err = LIBLTE_SUCCESS;
+            }
+        }else if(dl_pre_coder_is_valid(N_ant, N_layers, type, codebook_idx) &&
+                 M_layer_symb <= y_len){
+            err = LIBLTE_SUCCESS;
+        }
+
+        if(LIBLTE_SUCCESS == err)
+        {
+            pre_coder_dl(x_re,
+                         x_im,
+                         M_layer_symb,
+                         N_ant,
+                         N_layers,
+                         type,
+                         codebook_idx,
+                         y_re,
+                         y_im,
+                         y_len,
+                         M_ap_symb);
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_dl_pre_decode
+
+    Description: Recovers a block of downlink layers from the symbols
+                 received on one or more receive antennas
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4
+
+    Notes: Intended for benchmarking and verifying the pre-decoders
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_dl_pre_decode(LIBLTE_PHY_STRUCT              *phy_struct,
+                                           LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                                           float                          *y_re,
+                                           float                          *y_im,
+                                           uint32                          y_len,
+                                           float                          *h_re,
+                                           float                          *h_im,
+                                           uint32                          h_len,
+                                           float                          *noise_var,
+                                           uint32                          M_ap_symb,
+                                           uint8                           N_rx,
+                                           uint8                           N_ant,
+                                           uint32                          N_layers,
+                                           uint32                          codebook_idx,
+                                           float                          *x_re,
+                                           float                          *x_im,
+                                           uint32                         *M_layer_symb)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct   != NULL                    &&
+       y_re         != NULL                    &&
+       y_im         != NULL                    &&
+       h_re         != NULL                    &&
+       h_im         != NULL                    &&
+       x_re         != NULL                    &&
+       x_im         != NULL                    &&
+       M_layer_symb != NULL                    &&
+       M_ap_symb    != 0                       &&
+       M_ap_symb    <= 5000                    &&
+       M_ap_symb    <= y_len                   &&
+       M_ap_symb    <= h_len                   &&
+       N_rx         >= 1                       &&
+       N_rx         <= LIBLTE_PHY_N_RX_ANT_MAX &&
+       (N_ant       == 1                       ||
+        N_ant       == 2                       ||
+        N_ant       == 4))
+    {
+        if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY == type)
+        {
+            if(N_layers == N_ant)
+            {
+                pre_decoder_and_matched_filter_dl(y_re,
+                                                  y_im,
+                                                  y_len,
+                                                  h_re,
+                                                  h_im,
+                                                  h_len,
+                                                  M_ap_symb,
+                                                  N_rx,
+                                                  N_ant,
+                                                  type,
+                                                  x_re,
+                                                  x_im,
+                                                  M_layer_symb);
+                err = LIBLTE_SUCCESS;
+            }
+        }else if(noise_var != NULL &&
+                 dl_pre_coder_is_valid(N_ant, N_layers, type, codebook_idx)){
+            pre_decoder_mmse_dl(phy_struct,
+                                y_re,
+                                y_im,
+                                y_len,
+                                h_re,
+                                h_im,
+                                h_len,
+                                noise_var,
+                                M_ap_symb,
+                                N_rx,
+                                N_ant,
+                                N_layers,
+                                type,
+                                codebook_idx,
+                                x_re,
+                                x_im,
+                                M_layer_symb);
+            err = LIBLTE_SUCCESS;
+        }
+    }
+
+    return(err);
+}
+
+/*******************************************************************************
+                              LOCAL FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: layer_mapper_ul
+
+    Description: Maps complex-valued modulation symbols onto one or
+                 several uplink layers
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3.2A
+
+    Notes: Currently only supports single antenna
+*********************************************************************/
+void layer_mapper_ul(float  *d_re,
+                     float  *d_im,
+                     uint32  M_symb,
+                     uint8   N_ant,
+                     uint32  N_codewords,
+                     float  *x_re,
                      float  *x_im,
                      uint32 *M_layer_symb)
 {
@@ -6606,6 +7566,164 @@ void generate_dmrs_pusch(LIBLTE_PHY_STRUCT *phy_struct,
     // FIXME: Add precoding to arrive at r_tilda
 }
 
+/*********************************************************************
+    Name: pucch_seq_gen
+
+    Description: Generates the cyclically shifted base sequences and
+                 the cell specific cyclic shifts for all PUCCH slots
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4
+*********************************************************************/
+void pucch_seq_gen(LIBLTE_PHY_STRUCT *phy_struct,
+                   uint32             N_id_cell,
+                   bool               group_hopping_enabled)
+{
+    uint32 N_s;
+    uint32 L;
+    uint32 i;
+    uint32 n_cs;
+
+    // Calculate n_cs_cell
+    generate_prs_c(N_id_cell,
+                   8*LIBLTE_PHY_N_SYMB_PER_SLOT_UL*LIBLTE_PHY_N_SLOTS_PER_FRAME,
+                   phy_struct->dmrs_c);
+    for(N_s=0; N_s<LIBLTE_PHY_N_SLOTS_PER_FRAME; N_s++)
+    {
+        for(L=0; L<LIBLTE_PHY_N_SYMB_PER_SLOT_UL; L++)
+        {
+            phy_struct->pucch_n_cs_cell[N_s][L] = 0;
+            for(i=0; i<8; i++)
+            {
+                phy_struct->pucch_n_cs_cell[N_s][L] += phy_struct->dmrs_c[8*LIBLTE_PHY_N_SYMB_PER_SLOT_UL*N_s + 8*L + i] << i;
+            }
+        }
+    }
+
+    // Generate r_u_v for every cyclic shift
+    for(N_s=0; N_s<LIBLTE_PHY_N_SLOTS_PER_FRAME; N_s++)
+    {
+        for(n_cs=0; n_cs<LIBLTE_PHY_N_SC_RB_UL; n_cs++)
+        {
+            generate_ul_rs(phy_struct,
+                           N_s,
+                           N_id_cell,
+                           LIBLTE_PHY_CHAN_TYPE_PUCCH,
+                           0,
+                           1,
+                           2*M_PI*n_cs/LIBLTE_PHY_N_SC_RB_UL,
+                           group_hopping_enabled,
+                           false,
+                           phy_struct->pucch_r_re[N_s][n_cs],
+                           phy_struct->pucch_r_im[N_s][n_cs]);
+        }
+    }
+}
+
+/*********************************************************************
+    Name: pucch_calc_resources
+
+    Description: Determines the PRB, orthogonal sequence index, and
+                 cyclic shifts used by a PUCCH resource in each slot
+                 of a subframe
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 5.4.1, 5.4.2,
+                        and 5.4.3
+
+    Notes: Only handles normal CP
+*********************************************************************/
+void pucch_calc_resources(LIBLTE_PHY_STRUCT            *phy_struct,
+                          LIBLTE_PHY_PUCCH_FORMAT_ENUM  format,
+                          uint32                        n_pucch,
+                          uint32                        N_subfr,
+                          uint32                       *prb,
+                          uint32                       *n_oc,
+                          uint32                       *n_prime,
+                          uint32                        n_cs[][LIBLTE_PHY_N_SYMB_PER_SLOT_UL])
+{
+    uint32 c           = 3;
+    uint32 d           = 2;
+    uint32 delta_shift = phy_struct->pucch_delta_shift;
+    uint32 N_cs_1      = phy_struct->pucch_N_cs_1;
+    uint32 N_sc        = LIBLTE_PHY_N_SC_RB_UL;
+    uint32 N_prime;
+    uint32 N_s;
+    uint32 L;
+    uint32 m;
+    uint32 h;
+    uint32 i;
+
+    if(LIBLTE_PHY_PUCCH_FORMAT_2 == format)
+    {
+        // Determine n_prime
+        if(n_pucch < N_sc*phy_struct->pucch_N_rb_2)
+        {
+            n_prime[0] = n_pucch % N_sc;
+            n_prime[1] = ((N_sc*(n_prime[0] + 1)) % (N_sc + 1)) - 1;
+        }else{
+            n_prime[0] = (n_pucch + N_cs_1 + 1) % N_sc;
+            n_prime[1] = (N_sc + ((N_sc - 2 - (n_pucch % N_sc)) % N_sc)) % N_sc;
+        }
+
+        // Determine n_cs
+        for(i=0; i<LIBLTE_PHY_N_SLOTS_PER_SUBFR; i++)
+        {
+            N_s     = N_subfr*LIBLTE_PHY_N_SLOTS_PER_SUBFR + i;
+            n_oc[i] = 0;
+            for(L=0; L<LIBLTE_PHY_N_SYMB_PER_SLOT_UL; L++)
+            {
+                n_cs[i][L] = (phy_struct->pucch_n_cs_cell[N_s][L] + n_prime[i]) % N_sc;
+            }
+        }
+
+        // Determine m
+        m = n_pucch / N_sc;
+    }else{
+        // Determine N_prime and n_prime
+        if(n_pucch < c*N_cs_1/delta_shift)
+        {
+            N_prime    = N_cs_1;
+            n_prime[0] = n_pucch;
+            h          = (n_prime[0] + d) % (c*N_prime/delta_shift);
+            n_prime[1] = (h/c) + (h % c)*N_prime/delta_shift;
+        }else{
+            N_prime    = N_sc;
+            n_prime[0] = (n_pucch - c*N_cs_1/delta_shift) % (c*N_sc/delta_shift);
+            n_prime[1] = ((c*(n_prime[0] + 1)) % (c*N_sc/delta_shift + 1)) - 1;
+        }
+
+        // Determine n_oc and n_cs
+        for(i=0; i<LIBLTE_PHY_N_SLOTS_PER_SUBFR; i++)
+        {
+            N_s     = N_subfr*LIBLTE_PHY_N_SLOTS_PER_SUBFR + i;
+            n_oc[i] = n_prime[i]*delta_shift/N_prime;
+            for(L=0; L<LIBLTE_PHY_N_SYMB_PER_SLOT_UL; L++)
+            {
+                n_cs[i][L] = (phy_struct->pucch_n_cs_cell[N_s][L] +
+                              ((n_prime[i]*delta_shift + (n_oc[i] % delta_shift)) % N_prime)) % N_sc;
+            }
+        }
+
+        // Determine m
+        if(n_pucch < c*N_cs_1/delta_shift)
+        {
+            m = phy_struct->pucch_N_rb_2;
+        }else{
+            m = ((n_pucch - c*N_cs_1/delta_shift) / (c*N_sc/delta_shift)) + phy_struct->pucch_N_rb_2 + ((N_cs_1 + 7) / 8);
+        }
+    }
+
+    // Map m to a PRB in each slot
+    for(i=0; i<LIBLTE_PHY_N_SLOTS_PER_SUBFR; i++)
+    {
+        if(((m + i) % 2) == 0)
+        {
+            prb[i] = m/2;
+        }else{
+            prb[i] = phy_struct->N_rb_ul - 1 - (m/2);
+        }
+    }
+}
+
 /*********************************************************************
     Name: prach_preamble_seq_gen
 
@@ -6948,7 +8066,7 @@ void layer_mapper_dl(float                          *d_re,
 
     Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.3
 
-    NOTES: Currently only supports single antenna or TX diversity
+    NOTES: Spatial multiplexing only supports a single codeword
 *********************************************************************/
 void layer_demapper_dl(float                          *x_re,
                        float                          *x_im,
@@ -6965,7 +8083,6 @@ void layer_demapper_dl(float                          *x_re,
     uint32  i;
     uint32  p;
 
-    // FIXME: Only supports TX diversity
     // Index all arrays
     for(p=0; p<N_ant; p++)
     {
@@ -6973,12 +8090,13 @@ void layer_demapper_dl(float                          *x_re,
         x_im_ptr[p] = &x_im[p*M_layer_symb];
     }
 
-    // 3GPP TS 36.211 v10.1.0 sections 6.3.3.1 and 6.3.3.3
+    // 3GPP TS 36.211 v10.1.0 sections 6.3.3.1, 6.3.3.2, and 6.3.3.3
     *M_symb = M_layer_symb*N_ant;
-    if(N_ant                       == 4            &&
-       x_re_ptr[2][M_layer_symb-1] == RX_NULL_SYMB &&
-       x_im_ptr[2][M_layer_symb-1] == RX_NULL_SYMB &&
-       x_re_ptr[3][M_layer_symb-1] == RX_NULL_SYMB &&
+    if(type                        == LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY &&
+       N_ant                       == 4                                      &&
+       x_re_ptr[2][M_layer_symb-1] == RX_NULL_SYMB                           &&
+       x_im_ptr[2][M_layer_symb-1] == RX_NULL_SYMB                           &&
+       x_re_ptr[3][M_layer_symb-1] == RX_NULL_SYMB                           &&
        x_im_ptr[3][M_layer_symb-1] == RX_NULL_SYMB)
     {
         *M_symb = *M_symb - 2;
@@ -7001,13 +8119,16 @@ void layer_demapper_dl(float                          *x_re,
 
     Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4
 
-    NOTES: Currently only supports signle antenna or TX diversity
+    NOTES: Spatial multiplexing and large delay CDD only support a
+           single codeword
 *********************************************************************/
 void pre_coder_dl(float                          *x_re,
                   float                          *x_im,
                   uint32                          M_layer_symb,
                   uint8                           N_ant,
+                  uint32                          N_layers,
                   LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                  uint32                          codebook_idx,
                   float                          *y_re,
                   float                          *y_im,
                   uint32                          y_len,
@@ -7017,8 +8138,13 @@ void pre_coder_dl(float                          *x_re,
     float  *x_im_ptr[N_ant];
     float  *y_re_ptr[N_ant];
     float  *y_im_ptr[N_ant];
+    float   w_re[DL_PRE_CODER_N_MATRICES_MAX][LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_N_ANT_MAX];
+    float   w_im[DL_PRE_CODER_N_MATRICES_MAX][LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_N_ANT_MAX];
     float   one_over_sqrt_2 = 1/sqrt(2);
+    uint32  N_matrices;
     uint32  i;
+    uint32  k;
+    uint32  l;
     uint32  p;
 
     // Index all arrays
@@ -7039,10 +8165,10 @@ void pre_coder_dl(float                          *x_re,
             y_re_ptr[0][i] = x_re_ptr[0][i];
             y_im_ptr[0][i] = x_im_ptr[0][i];
         }
-    }else if(N_ant == 2){
-        if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY == type)
+    }else if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY == type){
+        // 3GPP TS 36.211 v10.1.0 section 6.3.4.3
+        if(N_ant == 2)
         {
-            // 3GPP TS 36.211 v10.1.0 section 6.3.4.3
             *M_ap_symb = 2*M_layer_symb;
             for(i=0; i<M_layer_symb; i++)
             {
@@ -7055,13 +8181,7 @@ void pre_coder_dl(float                          *x_re,
                 y_re_ptr[1][2*i+1] = +one_over_sqrt_2 * x_re_ptr[0][i];
                 y_im_ptr[1][2*i+1] = -one_over_sqrt_2 * x_im_ptr[0][i];
             }
-        }else{
-            // FIXME: Currently only supporting TX Diversity
-        }
-    }else{
-        if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY == type)
-        {
-            // 3GPP TS 36.211 v10.1.0 section 6.3.4.3
+        }else{ // N_ant == 4
             if(x_re_ptr[2][M_layer_symb-1] == TX_NULL_SYMB &&
                x_im_ptr[2][M_layer_symb-1] == TX_NULL_SYMB &&
                x_re_ptr[3][M_layer_symb-1] == TX_NULL_SYMB &&
@@ -7106,8 +8226,29 @@ void pre_coder_dl(float                          *x_re,
                 y_re_ptr[3][4*i+3] = +one_over_sqrt_2 * x_re_ptr[2][i];
                 y_im_ptr[3][4*i+3] = -one_over_sqrt_2 * x_im_ptr[2][i];
             }
-        }else{
-            // FIXME: Currently only supporting TX Diversity
+        }
+    }else{
+        // 3GPP TS 36.211 v10.1.0 sections 6.3.4.2.1 and 6.3.4.2.2
+        N_matrices = get_dl_pre_coding_matrices(N_ant, N_layers, type, codebook_idx, w_re, w_im);
+        *M_ap_symb = M_layer_symb;
+        for(p=0; p<N_ant; p++)
+        {
+            for(i=0; i<M_layer_symb; i++)
+            {
+                y_re_ptr[p][i] = 0;
+                y_im_ptr[p][i] = 0;
+            }
+            for(l=0; l<N_layers; l++)
+            {
+                for(k=0; k<N_matrices; k++)
+                {
+                    for(i=k; i<M_layer_symb; i+=N_matrices)
+                    {
+                        y_re_ptr[p][i] += w_re[k][p][l]*x_re_ptr[l][i] - w_im[k][p][l]*x_im_ptr[l][i];
+                        y_im_ptr[p][i] += w_re[k][p][l]*x_im_ptr[l][i] + w_im[k][p][l]*x_re_ptr[l][i];
+                    }
+                }
+            }
         }
     }
 }
@@ -7116,7 +8257,8 @@ void pre_coder_dl(float                          *x_re,
     Name: pre_decoder_and_matched_filter_dl
 
     Description: Matched filters and unmaps a block of vectors from
-                 resources on each downlink antenna port
+                 resources on each downlink antenna port, combining
+                 one or more receive antennas
 
     Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4
 
@@ -7124,10 +8266,12 @@ void pre_coder_dl(float                          *x_re,
 *********************************************************************/
 void pre_decoder_and_matched_filter_dl(float                          *y_re,
                                        float                          *y_im,
+                                       uint32                          y_len,
                                        float                          *h_re,
                                        float                          *h_im,
                                        uint32                          h_len,
                                        uint32                          M_ap_symb,
+                                       uint8                           N_rx,
                                        uint8                           N_ant,
                                        LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
                                        float                          *x_re,
@@ -7138,198 +8282,667 @@ void pre_decoder_and_matched_filter_dl(float                          *y_re,
     float  *h_im_ptr[N_ant];
     float  *x_re_ptr[N_ant];
     float  *x_im_ptr[N_ant];
-    float   h0_abs;
-    float   h1_abs;
-    float   h2_abs;
-    float   h3_abs;
-    float   h_norm;
-    float   h_norm_0_2;
-    float   h_norm_1_3;
+    float  *y_re_ptr;
+    float  *y_im_ptr;
+    float   h_norm[2][M_ap_symb+1];
+    float   sqrt_2 = sqrt(2);
+    float   scale;
     uint32  i;
     uint32  p;
+    uint32  r;
 
-    // Index all arrays
+    // Determine the number of layer symbols
+    if(N_ant == 1)
+    {
+        *M_layer_symb = M_ap_symb;
+    }else if(N_ant == 2){
+        *M_layer_symb = M_ap_symb/2;
+    }else{ // N_ant == 4
+        *M_layer_symb = (M_ap_symb+2)/4;
+    }
+
+    // Index and clear the layers
     for(p=0; p<N_ant; p++)
     {
-        h_re_ptr[p] = &h_re[p*h_len];
-        h_im_ptr[p] = &h_im[p*h_len];
-        x_re_ptr[p] = &x_re[p*(M_ap_symb/N_ant)];
-        x_im_ptr[p] = &x_im[p*(M_ap_symb/N_ant)];
+        x_re_ptr[p] = &x_re[p*(*M_layer_symb)];
+        x_im_ptr[p] = &x_im[p*(*M_layer_symb)];
+        for(i=0; i<*M_layer_symb; i++)
+        {
+            x_re_ptr[p][i] = 0;
+            x_im_ptr[p][i] = 0;
+        }
+    }
+    for(i=0; i<*M_layer_symb; i++)
+    {
+        h_norm[0][i] = 0;
+        h_norm[1][i] = 0;
+    }
+
+    // Accumulate the matched filter outputs of each receive antenna
+    for(r=0; r<N_rx; r++)
+    {
+        y_re_ptr = &y_re[r*y_len];
+        y_im_ptr = &y_im[r*y_len];
+        for(p=0; p<N_ant; p++)
+        {
+            h_re_ptr[p] = &h_re[(r*LIBLTE_PHY_N_ANT_MAX+p)*h_len];
+            h_im_ptr[p] = &h_im[(r*LIBLTE_PHY_N_ANT_MAX+p)*h_len];
+        }
+
+        if(N_ant == 1)
+        {
+            // 3GPP TS 36.211 v10.1.0 section 6.3.4.1
+            for(i=0; i<*M_layer_symb; i++)
+            {
+                x_re_ptr[0][i] += y_re_ptr[i]*h_re_ptr[0][i] + y_im_ptr[i]*h_im_ptr[0][i];
+                x_im_ptr[0][i] += y_im_ptr[i]*h_re_ptr[0][i] - y_re_ptr[i]*h_im_ptr[0][i];
+                h_norm[0][i]   += h_re_ptr[0][i]*h_re_ptr[0][i] + h_im_ptr[0][i]*h_im_ptr[0][i];
+            }
+        }else if(N_ant == 2){
+            // 3GPP TS 36.211 v10.1.0 section 6.3.4.3
+            sfbc_combine_dl(y_re_ptr,
+                            y_im_ptr,
+                            h_re_ptr[0],
+                            h_im_ptr[0],
+                            h_re_ptr[1],
+                            h_im_ptr[1],
+                            2,
+                            *M_layer_symb,
+                            x_re_ptr[0],
+                            x_im_ptr[0],
+                            x_re_ptr[1],
+                            x_im_ptr[1],
+                            h_norm[0]);
+        }else{ // N_ant == 4
+            // 3GPP TS 36.211 v10.1.0 section 6.3.4.3, antenna ports 0 and 2
+            // carry the first pair of each group of 4 and antenna ports 1
+            // and 3 carry the second pair
+            sfbc_combine_dl(y_re_ptr,
+                            y_im_ptr,
+                            h_re_ptr[0],
+                            h_im_ptr[0],
+                            h_re_ptr[2],
+                            h_im_ptr[2],
+                            4,
+                            (M_ap_symb+2)/4,
+                            x_re_ptr[0],
+                            x_im_ptr[0],
+                            x_re_ptr[1],
+                            x_im_ptr[1],
+                            h_norm[0]);
+            sfbc_combine_dl(&y_re_ptr[2],
+                            &y_im_ptr[2],
+                            &h_re_ptr[1][2],
+                            &h_im_ptr[1][2],
+                            &h_re_ptr[3][2],
+                            &h_im_ptr[3][2],
+                            4,
+                            M_ap_symb/4,
+                            x_re_ptr[2],
+                            x_im_ptr[2],
+                            x_re_ptr[3],
+                            x_im_ptr[3],
+                            h_norm[1]);
+        }
     }
 
+    // Normalize by the combined channel power
     if(N_ant == 1)
     {
-        // 3GPP TS 36.211 v10.1.0 section 6.3.4.1
-        *M_layer_symb = M_ap_symb;
         for(i=0; i<*M_layer_symb; i++)
         {
-            h_norm         = (h_re_ptr[0][i] * h_re_ptr[0][i] +
-                              h_im_ptr[0][i] * h_im_ptr[0][i]);
-            x_re_ptr[0][i] = (y_re[i]*h_re_ptr[0][i] + y_im[i]*h_im_ptr[0][i]) / h_norm;
-            x_im_ptr[0][i] = (y_im[i]*h_re_ptr[0][i] - y_re[i]*h_im_ptr[0][i]) / h_norm;
+            scale           = 1/h_norm[0][i];
+            x_re_ptr[0][i] *= scale;
+            x_im_ptr[0][i] *= scale;
         }
-    }else if(N_ant == 2){
-        // 3GPP TS 36.211 v10.1.0 section 6.3.4.3
-        *M_layer_symb = M_ap_symb/2;
+    }else{
         for(i=0; i<*M_layer_symb; i++)
         {
-            h0_abs         = (h_re_ptr[0][i*2] * h_re_ptr[0][i*2] +
-                              h_im_ptr[0][i*2] * h_im_ptr[0][i*2]);
-            h1_abs         = (h_re_ptr[1][i*2] * h_re_ptr[1][i*2] +
-                              h_im_ptr[1][i*2] * h_im_ptr[1][i*2]);
-            h_norm         = sqrt(h0_abs*h0_abs + h1_abs*h1_abs);
-            x_re_ptr[0][i] = (h_re_ptr[0][i*2] * y_re[i*2+0] +
-                              h_im_ptr[0][i*2] * y_im[i*2+0] +
-                              h_re_ptr[1][i*2] * y_re[i*2+1] +
-                              h_im_ptr[1][i*2] * y_im[i*2+1]) / h_norm;
-            x_im_ptr[0][i] = (h_re_ptr[0][i*2] * y_im[i*2+0] -
-                              h_im_ptr[0][i*2] * y_re[i*2+0] -
-                              h_re_ptr[1][i*2] * y_im[i*2+1] +
-                              h_im_ptr[1][i*2] * y_re[i*2+1]) / h_norm;
-            x_re_ptr[1][i] = (-h_re_ptr[1][i*2] * y_re[i*2+0] -
-                              h_im_ptr[1][i*2] * y_im[i*2+0] +
-                              h_re_ptr[0][i*2] * y_re[i*2+1] +
-                              h_im_ptr[0][i*2] * y_im[i*2+1]) / h_norm;
-            x_im_ptr[1][i] = (h_re_ptr[1][i*2] * y_im[i*2+0] -
-                              h_im_ptr[1][i*2] * y_re[i*2+0] +
-                              h_re_ptr[0][i*2] * y_im[i*2+1] -
-                              h_im_ptr[0][i*2] * y_re[i*2+1]) / h_norm;
+            scale           = sqrt_2/h_norm[0][i];
+            x_re_ptr[0][i] *= scale;
+            x_im_ptr[0][i] *= scale;
+            x_re_ptr[1][i] *= scale;
+            x_im_ptr[1][i] *= scale;
         }
-    }else{ // N_ant == 4
-        // 3GPP TS 36.211 v10.1.0 section 6.3.4.3
-        *M_layer_symb = M_ap_symb/4;
-        for(i=0; i<*M_layer_symb; i++)
+        if(N_ant == 4)
         {
-            h0_abs         = (h_re_ptr[0][i*4+0] * h_re_ptr[0][i*4+0] +
-                              h_im_ptr[0][i*4+0] * h_im_ptr[0][i*4+0]);
-            h1_abs         = (h_re_ptr[1][i*4+2] * h_re_ptr[1][i*4+2] +
-                              h_im_ptr[1][i*4+2] * h_im_ptr[1][i*4+2]);
-            h2_abs         = (h_re_ptr[2][i*4+0] * h_re_ptr[2][i*4+0] +
-                              h_im_ptr[2][i*4+0] * h_im_ptr[2][i*4+0]);
-            h3_abs         = (h_re_ptr[3][i*4+2] * h_re_ptr[3][i*4+2] +
-                              h_im_ptr[3][i*4+2] * h_im_ptr[3][i*4+2]);
-            h_norm_0_2     = sqrt(h0_abs*h0_abs + h2_abs*h2_abs);
-            h_norm_1_3     = sqrt(h1_abs*h1_abs + h3_abs*h3_abs);
-            x_re_ptr[0][i] = (h_re_ptr[0][i*4+0] * y_re[i*4+0] +
-                              h_im_ptr[0][i*4+0] * y_im[i*4+0] +
-                              h_re_ptr[2][i*4+0] * y_re[i*4+1] +
-                              h_im_ptr[2][i*4+0] * y_im[i*4+1]) / h_norm_0_2;
-            x_im_ptr[0][i] = (h_re_ptr[0][i*4+0] * y_im[i*4+0] -
-                              h_im_ptr[0][i*4+0] * y_re[i*4+0] -
-                              h_re_ptr[2][i*4+0] * y_im[i*4+1] +
-                              h_im_ptr[2][i*4+0] * y_re[i*4+1]) / h_norm_0_2;
-            x_re_ptr[1][i] = (-h_re_ptr[2][i*4+0] * y_re[i*4+0] -
-                              h_im_ptr[2][i*4+0] * y_im[i*4+0] +
-                              h_re_ptr[0][i*4+0] * y_re[i*4+1] +
-                              h_im_ptr[0][i*4+0] * y_im[i*4+1]) / h_norm_0_2;
-            x_im_ptr[1][i] = -(-h_re_ptr[2][i*4+0] * y_im[i*4+0] +
-                               h_im_ptr[2][i*4+0] * y_re[i*4+0] -
-                               h_re_ptr[0][i*4+0] * y_im[i*4+1] +
-                               h_im_ptr[0][i*4+0] * y_re[i*4+1]) / h_norm_0_2;
-            x_re_ptr[2][i] = (h_re_ptr[1][i*4+2] * y_re[i*4+2] +
-                              h_im_ptr[1][i*4+2] * y_im[i*4+2] +
-                              h_re_ptr[3][i*4+2] * y_re[i*4+3] +
-                              h_im_ptr[3][i*4+2] * y_im[i*4+3]) / h_norm_1_3;
-            x_im_ptr[2][i] = (h_re_ptr[1][i*4+2] * y_im[i*4+2] -
-                              h_im_ptr[1][i*4+2] * y_re[i*4+2] -
-                              h_re_ptr[3][i*4+2] * y_im[i*4+3] +
-                              h_im_ptr[3][i*4+2] * y_re[i*4+3]) / h_norm_1_3;
-            x_re_ptr[3][i] = (-h_re_ptr[3][i*4+2] * y_re[i*4+2] -
-                              h_im_ptr[3][i*4+2] * y_im[i*4+2] +
-                              h_re_ptr[1][i*4+2] * y_re[i*4+3] +
-                              h_im_ptr[1][i*4+2] * y_im[i*4+3]) / h_norm_1_3;
-            x_im_ptr[3][i] = -(-h_re_ptr[3][i*4+2] * y_im[i*4+2] +
-                               h_im_ptr[3][i*4+2] * y_re[i*4+2] -
-                               h_re_ptr[1][i*4+2] * y_im[i*4+3] +
-                               h_im_ptr[1][i*4+2] * y_re[i*4+3]) / h_norm_1_3;
-        }
-        if((M_ap_symb % 4) != 0)
-        {
-            *M_layer_symb  = (M_ap_symb+2)/4;
-            h0_abs         = (h_re_ptr[0][i*4+0] * h_re_ptr[0][i*4+0] +
-                              h_im_ptr[0][i*4+0] * h_im_ptr[0][i*4+0]);
-            h2_abs         = (h_re_ptr[2][i*4+0] * h_re_ptr[2][i*4+0] +
-                              h_im_ptr[2][i*4+0] * h_im_ptr[2][i*4+0]);
-            h_norm_0_2     = sqrt(h0_abs*h0_abs + h2_abs*h2_abs);
-            x_re_ptr[0][i] = (h_re_ptr[0][i*4+0] * y_re[i*4+0] +
-                              h_im_ptr[0][i*4+0] * y_im[i*4+0] +
-                              h_re_ptr[2][i*4+0] * y_re[i*4+1] +
-                              h_im_ptr[2][i*4+0] * y_im[i*4+1]) / h_norm_0_2;
-            x_im_ptr[0][i] = (h_re_ptr[0][i*4+0] * y_im[i*4+0] -
-                              h_im_ptr[0][i*4+0] * y_re[i*4+0] -
-                              h_re_ptr[2][i*4+0] * y_im[i*4+1] +
-                              h_im_ptr[2][i*4+0] * y_re[i*4+1]) / h_norm_0_2;
-            x_re_ptr[1][i] = (-h_re_ptr[2][i*4+0] * y_re[i*4+0] -
-                              h_im_ptr[2][i*4+0] * y_im[i*4+0] +
-                              h_re_ptr[0][i*4+0] * y_re[i*4+1] +
-                              h_im_ptr[0][i*4+0] * y_im[i*4+1]) / h_norm_0_2;
-            x_im_ptr[1][i] = (-h_re_ptr[2][i*4+0] * y_im[i*4+0] +
-                              h_im_ptr[2][i*4+0] * y_re[i*4+0] -
-                              h_re_ptr[0][i*4+0] * y_re[i*4+1] +
-                              h_im_ptr[0][i*4+0] * y_im[i*4+1]) / h_norm_0_2;
-            x_re_ptr[2][i] = RX_NULL_SYMB;
-            x_im_ptr[2][i] = RX_NULL_SYMB;
-            x_re_ptr[3][i] = RX_NULL_SYMB;
-            x_im_ptr[3][i] = RX_NULL_SYMB;
+            for(i=0; i<M_ap_symb/4; i++)
+            {
+                scale           = sqrt_2/h_norm[1][i];
+                x_re_ptr[2][i] *= scale;
+                x_im_ptr[2][i] *= scale;
+                x_re_ptr[3][i] *= scale;
+                x_im_ptr[3][i] *= scale;
+            }
+            if((M_ap_symb % 4) != 0)
+            {
+                x_re_ptr[2][i] = RX_NULL_SYMB;
+                x_im_ptr[2][i] = RX_NULL_SYMB;
+                x_re_ptr[3][i] = RX_NULL_SYMB;
+                x_im_ptr[3][i] = RX_NULL_SYMB;
+            }
         }
     }
 }
 
 /*********************************************************************
-    Name: pcfich_channel_map
+    Name: sfbc_combine_dl
 
-    Description: Channel maps the PCFICH
+    Description: Combines the pairs of resource elements of one
+                 space frequency block code, accumulating over the
+                 receive antennas
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.7
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4.3
 *********************************************************************/
-void pcfich_channel_map(LIBLTE_PHY_STRUCT          *phy_struct,
-                        LIBLTE_PHY_PCFICH_STRUCT   *pcfich,
-                        uint32                      N_id_cell,
-                        uint8                       N_ant,
-                        LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
+void sfbc_combine_dl(float  *y_re,
+                     float  *y_im,
+                     float  *h0_re,
+                     float  *h0_im,
+                     float  *h1_re,
+                     float  *h1_im,
+                     uint32  stride,
+                     uint32  N_pairs,
+                     float  *x0_re,
+                     float  *x0_im,
+                     float  *x1_re,
+                     float  *x1_im,
+                     float  *h_norm)
 {
-    uint32 N_bits;
-    uint32 M_symb;
-    uint32 M_layer_symb;
-    uint32 M_ap_symb;
-    uint32 c_init;
-    uint32 k_hat;
+    float  h0_r;
+    float  h0_i;
+    float  h1_r;
+    float  h1_i;
+    float  y0_r;
+    float  y0_i;
+    float  y1_r;
+    float  y1_i;
     uint32 i;
-    uint32 j;
-    uint32 p;
-    uint32 idx;
 
-    // Encode, 3GPP TS 36.211 v10.1.0 section 6.7
-    cfi_channel_encode(phy_struct,
-                       pcfich->cfi,
-                       phy_struct->pdcch_encode_bits,
-                       &N_bits);
-    c_init = (((subframe->num + 1)*(2*N_id_cell + 1)) << 9) + N_id_cell;
-    generate_prs_c(c_init, N_bits, phy_struct->pdcch_c);
-    for(i=0; i<N_bits; i++)
+    // The channel is assumed constant over both resource elements of a pair
+    for(i=0; i<N_pairs; i++)
     {
-        phy_struct->pdcch_scramb_bits[i] = phy_struct->pdcch_encode_bits[i] ^ phy_struct->pdcch_c[i];
+        h0_r       = h0_re[i*stride];
+        h0_i       = h0_im[i*stride];
+        h1_r       = h1_re[i*stride];
+        h1_i       = h1_im[i*stride];
+        y0_r       = y_re[i*stride];
+        y0_i       = y_im[i*stride];
+        y1_r       = y_re[i*stride+1];
+        y1_i       = y_im[i*stride+1];
+        x0_re[i]  += h0_r*y0_r + h0_i*y0_i + h1_r*y1_r + h1_i*y1_i;
+        x0_im[i]  += h0_r*y0_i - h0_i*y0_r - h1_r*y1_i + h1_i*y1_r;
+        x1_re[i]  += h0_r*y1_r + h0_i*y1_i - h1_r*y0_r - h1_i*y0_i;
+        x1_im[i]  += h0_r*y1_i - h0_i*y1_r + h1_r*y0_i - h1_i*y0_r;
+        h_norm[i] += h0_r*h0_r + h0_i*h0_i + h1_r*h1_r + h1_i*h1_i;
     }
-    modulation_mapper(phy_struct->pdcch_scramb_bits,
-                      N_bits,
-                      LIBLTE_PHY_MODULATION_TYPE_QPSK,
-                      phy_struct->pdcch_d_re,
-                      phy_struct->pdcch_d_im,
-                      &M_symb);
-    layer_mapper_dl(phy_struct->pdcch_d_re,
-                    phy_struct->pdcch_d_im,
-                    M_symb,
-                    N_ant,
-                    1,
-                    LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                    phy_struct->pdcch_x_re,
+}
+
+/*********************************************************************
+    Name: pre_decoder_mmse_dl
+
+    Description: Detects the layers of a spatially multiplexed block
+                 of vectors with an unbiased MMSE detector
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3.4.2.1 and
+                        6.3.4.2.2
+*********************************************************************/
+void pre_decoder_mmse_dl(LIBLTE_PHY_STRUCT              *phy_struct,
+                         float                          *y_re,
+                         float                          *y_im,
+                         uint32                          y_len,
+                         float                          *h_re,
+                         float                          *h_im,
+                         uint32                          h_len,
+                         float                          *noise_var,
+                         uint32                          M_ap_symb,
+                         uint8                           N_rx,
+                         uint8                           N_ant,
+                         uint32                          N_layers,
+                         LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                         uint32                          codebook_idx,
+                         float                          *x_re,
+                         float                          *x_im,
+                         uint32                         *M_layer_symb)
+{
+    float   w_re[DL_PRE_CODER_N_MATRICES_MAX][LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_N_ANT_MAX];
+    float   w_im[DL_PRE_CODER_N_MATRICES_MAX][LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_N_ANT_MAX];
+    float   a_re[LIBLTE_PHY_N_ANT_MAX][2*LIBLTE_PHY_N_ANT_MAX+1];
+    float   a_im[LIBLTE_PHY_N_ANT_MAX][2*LIBLTE_PHY_N_ANT_MAX+1];
+    float  *h_re_ptr;
+    float  *h_im_ptr;
+    float  *g_re_ptr;
+    float  *g_im_ptr;
+    float   g0_re;
+    float   g0_im;
+    float   g1_re;
+    float   g1_im;
+    float   a00;
+    float   a11;
+    float   a01_re;
+    float   a01_im;
+    float   z0_re;
+    float   z0_im;
+    float   z1_re;
+    float   z1_im;
+    float   det;
+    float   den0;
+    float   den1;
+    float   piv_re;
+    float   piv_im;
+    float   piv_abs;
+    float   f_re;
+    float   f_im;
+    float   tmp_re;
+    float   beta;
+    uint32  N_matrices;
+    uint32  N_cols;
+    uint32  i;
+    uint32  k;
+    uint32  l;
+    uint32  m;
+    uint32  n;
+    uint32  p;
+    uint32  r;
+    bool    singular;
+
+    N_matrices    = get_dl_pre_coding_matrices(N_ant, N_layers, type, codebook_idx, w_re, w_im);
+    *M_layer_symb = M_ap_symb;
+
+    // Effective channel of each layer, G = HW(i)
+    for(r=0; r<N_rx; r++)
+    {
+        for(l=0; l<N_layers; l++)
+        {
+            g_re_ptr = phy_struct->pdsch_g_re[r][l];
+            g_im_ptr = phy_struct->pdsch_g_im[r][l];
+            for(i=0; i<M_ap_symb; i++)
+            {
+                g_re_ptr[i] = 0;
+                g_im_ptr[i] = 0;
+            }
+            for(p=0; p<N_ant; p++)
+            {
+                h_re_ptr = &h_re[(r*LIBLTE_PHY_N_ANT_MAX+p)*h_len];
+                h_im_ptr = &h_im[(r*LIBLTE_PHY_N_ANT_MAX+p)*h_len];
+                for(k=0; k<N_matrices; k++)
+                {
+                    for(i=k; i<M_ap_symb; i+=N_matrices)
+                    {
+                        g_re_ptr[i] += h_re_ptr[i]*w_re[k][p][l] - h_im_ptr[i]*w_im[k][p][l];
+                        g_im_ptr[i] += h_re_ptr[i]*w_im[k][p][l] + h_im_ptr[i]*w_re[k][p][l];
+                    }
+                }
+            }
+        }
+    }
+
+    if(N_layers == 1)
+    {
+        // Unbiased MMSE reduces to maximum ratio combining
+        for(i=0; i<M_ap_symb; i++)
+        {
+            z0_re = 0;
+            z0_im = 0;
+            a00   = 0;
+            for(r=0; r<N_rx; r++)
+            {
+                g0_re  = phy_struct->pdsch_g_re[r][0][i];
+                g0_im  = phy_struct->pdsch_g_im[r][0][i];
+                z0_re += g0_re*y_re[r*y_len+i] + g0_im*y_im[r*y_len+i];
+                z0_im += g0_re*y_im[r*y_len+i] - g0_im*y_re[r*y_len+i];
+                a00   += g0_re*g0_re + g0_im*g0_im;
+            }
+            if(a00 > 0)
+            {
+                x_re[i] = z0_re/a00;
+                x_im[i] = z0_im/a00;
+            }else{
+                x_re[i] = 0;
+                x_im[i] = 0;
+            }
+        }
+    }else if(N_layers == 2){
+        // Closed form inverse of A = G^HG + noise_var*I, scaling each
+        // layer by 1/(1 - noise_var*inv(A)_kk) to remove the MMSE bias
+        for(i=0; i<M_ap_symb; i++)
+        {
+            a00    = noise_var[i];
+            a11    = noise_var[i];
+            a01_re = 0;
+            a01_im = 0;
+            z0_re  = 0;
+            z0_im  = 0;
+            z1_re  = 0;
+            z1_im  = 0;
+            for(r=0; r<N_rx; r++)
+            {
+                g0_re   = phy_struct->pdsch_g_re[r][0][i];
+                g0_im   = phy_struct->pdsch_g_im[r][0][i];
+                g1_re   = phy_struct->pdsch_g_re[r][1][i];
+                g1_im   = phy_struct->pdsch_g_im[r][1][i];
+                a00    += g0_re*g0_re + g0_im*g0_im;
+                a11    += g1_re*g1_re + g1_im*g1_im;
+                a01_re += g0_re*g1_re + g0_im*g1_im;
+                a01_im += g0_re*g1_im - g0_im*g1_re;
+                z0_re  += g0_re*y_re[r*y_len+i] + g0_im*y_im[r*y_len+i];
+                z0_im  += g0_re*y_im[r*y_len+i] - g0_im*y_re[r*y_len+i];
+                z1_re  += g1_re*y_re[r*y_len+i] + g1_im*y_im[r*y_len+i];
+                z1_im  += g1_re*y_im[r*y_len+i] - g1_im*y_re[r*y_len+i];
+            }
+            det  = a00*a11 - a01_re*a01_re - a01_im*a01_im;
+            den0 = det - noise_var[i]*a11;
+            den1 = det - noise_var[i]*a00;
+            if(den0 > 0 &&
+               den1 > 0)
+            {
+                x_re[i]           = (a11*z0_re - a01_re*z1_re + a01_im*z1_im)/den0;
+                x_im[i]           = (a11*z0_im - a01_re*z1_im - a01_im*z1_re)/den0;
+                x_re[M_ap_symb+i] = (a00*z1_re - a01_re*z0_re - a01_im*z0_im)/den1;
+                x_im[M_ap_symb+i] = (a00*z1_im - a01_re*z0_im + a01_im*z0_re)/den1;
+            }else{
+                x_re[i]           = 0;
+                x_im[i]           = 0;
+                x_re[M_ap_symb+i] = 0;
+                x_im[M_ap_symb+i] = 0;
+            }
+        }
+    }else{
+        // Gauss-Jordan elimination of [G^HG + noise_var*I | I | G^Hy],
+        // G^HG + noise_var*I is Hermitian positive definite so no
+        // pivoting is needed
+        N_cols = 2*N_layers + 1;
+        for(i=0; i<M_ap_symb; i++)
+        {
+            for(l=0; l<N_layers; l++)
+            {
+                for(m=0; m<N_cols; m++)
+                {
+                    a_re[l][m] = 0;
+                    a_im[l][m] = 0;
+                }
+                a_re[l][l]          = noise_var[i];
+                a_re[l][N_layers+l] = 1;
+                for(r=0; r<N_rx; r++)
+                {
+                    g0_re = phy_struct->pdsch_g_re[r][l][i];
+                    g0_im = phy_struct->pdsch_g_im[r][l][i];
+                    for(m=0; m<N_layers; m++)
+                    {
+                        g1_re       = phy_struct->pdsch_g_re[r][m][i];
+                        g1_im       = phy_struct->pdsch_g_im[r][m][i];
+                        a_re[l][m] += g0_re*g1_re + g0_im*g1_im;
+                        a_im[l][m] += g0_re*g1_im - g0_im*g1_re;
+                    }
+                    a_re[l][N_cols-1] += g0_re*y_re[r*y_len+i] + g0_im*y_im[r*y_len+i];
+                    a_im[l][N_cols-1] += g0_re*y_im[r*y_len+i] - g0_im*y_re[r*y_len+i];
+                }
+            }
+            singular = false;
+            for(n=0; n<N_layers; n++)
+            {
+                piv_abs = a_re[n][n]*a_re[n][n] + a_im[n][n]*a_im[n][n];
+                if(piv_abs == 0)
+                {
+                    singular = true;
+                    break;
+                }
+                piv_re = a_re[n][n]/piv_abs;
+                piv_im = -a_im[n][n]/piv_abs;
+                for(m=0; m<N_cols; m++)
+                {
+                    tmp_re     = a_re[n][m]*piv_re - a_im[n][m]*piv_im;
+                    a_im[n][m] = a_re[n][m]*piv_im + a_im[n][m]*piv_re;
+                    a_re[n][m] = tmp_re;
+                }
+                for(l=0; l<N_layers; l++)
+                {
+                    if(l != n)
+                    {
+                        f_re = a_re[l][n];
+                        f_im = a_im[l][n];
+                        for(m=0; m<N_cols; m++)
+                        {
+                            a_re[l][m] -= f_re*a_re[n][m] - f_im*a_im[n][m];
+                            a_im[l][m] -= f_re*a_im[n][m] + f_im*a_re[n][m];
+                        }
+                    }
+                }
+            }
+            for(l=0; l<N_layers; l++)
+            {
+                beta = 1 - noise_var[i]*a_re[l][N_layers+l];
+                if(!singular &&
+                   beta > 0)
+                {
+                    x_re[l*M_ap_symb+i] = a_re[l][N_cols-1]/beta;
+                    x_im[l*M_ap_symb+i] = a_im[l][N_cols-1]/beta;
+                }else{
+                    x_re[l*M_ap_symb+i] = 0;
+                    x_im[l*M_ap_symb+i] = 0;
+                }
+            }
+        }
+    }
+}
+
+/*********************************************************************
+    Name: dl_pre_coder_is_valid
+
+    Description: Checks a spatial multiplexing or large delay CDD
+                 layer and codebook configuration
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4.2
+*********************************************************************/
+bool dl_pre_coder_is_valid(uint8                           N_ant,
+                           uint32                          N_layers,
+                           LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                           uint32                          codebook_idx)
+{
+    if(LIBLTE_PHY_PRE_CODER_TYPE_SPATIAL_MULTIPLEXING == type)
+    {
+        if(N_ant == 2)
+        {
+            return((N_layers == 1 && codebook_idx < 4) ||
+                   (N_layers == 2 && codebook_idx < 3));
+        }else if(N_ant == 4){
+            return(N_layers     >= 1 &&
+                   N_layers     <= 4 &&
+                   codebook_idx <  16);
+        }
+    }else if(LIBLTE_PHY_PRE_CODER_TYPE_LARGE_DELAY_CDD == type){
+        return((N_ant    == 2  ||
+                N_ant    == 4) &&
+               N_layers  >= 2  &&
+               N_layers  <= N_ant);
+    }
+
+    return(false);
+}
+
+/*********************************************************************
+    Name: get_dl_pre_coding_matrices
+
+    Description: Determines the pre-coding matrices used for spatial
+                 multiplexing, returning the number of matrices before
+                 they repeat.  Resource element i uses matrix
+                 (i % N_matrices)
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3.4.2.1 and
+                        6.3.4.2.2
+
+    Notes: For large delay CDD the returned matrices are W(i)D(i)U
+*********************************************************************/
+uint32 get_dl_pre_coding_matrices(uint8                           N_ant,
+                                  uint32                          N_layers,
+                                  LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                                  uint32                          codebook_idx,
+                                  float                           w_re[DL_PRE_CODER_N_MATRICES_MAX][LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_N_ANT_MAX],
+                                  float                           w_im[DL_PRE_CODER_N_MATRICES_MAX][LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_N_ANT_MAX])
+{
+    float  c_re[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_N_ANT_MAX];
+    float  c_im[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_N_ANT_MAX];
+    float  one_over_sqrt_v = 1/sqrt(N_layers);
+    float  du_re;
+    float  du_im;
+    float *u_re;
+    float *u_im;
+    uint32 N_matrices;
+    uint32 n;
+    uint32 col;
+    uint32 i;
+    uint32 l;
+    uint32 m;
+    uint32 p;
+
+    if(LIBLTE_PHY_PRE_CODER_TYPE_LARGE_DELAY_CDD == type)
+    {
+        // D(i) repeats every v resource elements and, for 4 antenna
+        // ports, W(i) changes every v resource elements over 4 matrices
+        if(N_ant == 2)
+        {
+            N_matrices = N_layers;
+        }else{
+            N_matrices = 4*N_layers;
+        }
+    }else{
+        N_matrices = 1;
+    }
+
+    for(i=0; i<N_matrices; i++)
+    {
+        // Codebook index, fixed for closed loop spatial multiplexing and
+        // cycled through 12 to 15 for large delay CDD with 4 antenna ports
+        if(LIBLTE_PHY_PRE_CODER_TYPE_LARGE_DELAY_CDD != type)
+        {
+            n = codebook_idx;
+        }else if(N_ant == 2){
+            n = 0;
+        }else{
+            n = 12 + ((i/N_layers) % 4);
+        }
+
+        // Codebook matrix W
+        if(N_ant == 2)
+        {
+            for(p=0; p<2; p++)
+            {
+                for(l=0; l<N_layers; l++)
+                {
+                    c_re[p][l] = SM_CODEBOOK_2_RE[N_layers-1][n][p][l];
+                    c_im[p][l] = SM_CODEBOOK_2_IM[N_layers-1][n][p][l];
+                }
+            }
+        }else{
+            // Columns of W_n = I - 2u_nu_n^H/u_n^Hu_n, with u_n^Hu_n = 4
+            u_re = SM_CODEBOOK_4_U_RE[n];
+            u_im = SM_CODEBOOK_4_U_IM[n];
+            for(p=0; p<4; p++)
+            {
+                for(l=0; l<N_layers; l++)
+                {
+                    col        = SM_CODEBOOK_4_COLS[N_layers-1][n][l];
+                    c_re[p][l] = -(u_re[p]*u_re[col] + u_im[p]*u_im[col])/2;
+                    c_im[p][l] = -(u_im[p]*u_re[col] - u_re[p]*u_im[col])/2;
+                    if(p == col)
+                    {
+                        c_re[p][l] += 1;
+                    }
+                    c_re[p][l] *= one_over_sqrt_v;
+                    c_im[p][l] *= one_over_sqrt_v;
+                }
+            }
+        }
+
+        if(LIBLTE_PHY_PRE_CODER_TYPE_LARGE_DELAY_CDD == type)
+        {
+            // W(i)D(i)U, where (D(i)U)_ml = exp(-j2pim(i+l)/v)/sqrt(v)
+            for(p=0; p<N_ant; p++)
+            {
+                for(l=0; l<N_layers; l++)
+                {
+                    w_re[i][p][l] = 0;
+                    w_im[i][p][l] = 0;
+                    for(m=0; m<N_layers; m++)
+                    {
+                        du_re          = one_over_sqrt_v*cos(-2*M_PI*m*(i+l)/N_layers);
+                        du_im          = one_over_sqrt_v*sin(-2*M_PI*m*(i+l)/N_layers);
+                        w_re[i][p][l] += c_re[p][m]*du_re - c_im[p][m]*du_im;
+                        w_im[i][p][l] += c_re[p][m]*du_im + c_im[p][m]*du_re;
+                    }
+                }
+            }
+        }else{
+            for(p=0; p<N_ant; p++)
+            {
+                for(l=0; l<N_layers; l++)
+                {
+                    w_re[i][p][l] = c_re[p][l];
+                    w_im[i][p][l] = c_im[p][l];
+                }
+            }
+        }
+    }
+
+    return(N_matrices);
+}
+
+/*********************************************************************
+    Name: pcfich_channel_map
+
+    Description: Channel maps the PCFICH
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.7
+*********************************************************************/
+void pcfich_channel_map(LIBLTE_PHY_STRUCT          *phy_struct,
+                        LIBLTE_PHY_PCFICH_STRUCT   *pcfich,
+                        uint32                      N_id_cell,
+                        uint8                       N_ant,
+                        LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
+{
+    uint32 N_bits;
+    uint32 M_symb;
+    uint32 M_layer_symb;
+    uint32 M_ap_symb;
+    uint32 c_init;
+    uint32 k_hat;
+    uint32 i;
+    uint32 j;
+    uint32 p;
+    uint32 idx;
+
+    // Encode, 3GPP TS 36.211 v10.1.0 section 6.7
+    cfi_channel_encode(phy_struct,
+                       pcfich->cfi,
+                       phy_struct->pdcch_encode_bits,
+                       &N_bits);
+    c_init = (((subframe->num + 1)*(2*N_id_cell + 1)) << 9) + N_id_cell;
+    generate_prs_c(c_init, N_bits, phy_struct->pdcch_c);
+    for(i=0; i<N_bits; i++)
+    {
+        phy_struct->pdcch_scramb_bits[i] = phy_struct->pdcch_encode_bits[i] ^ phy_struct->pdcch_c[i];
+    }
+    modulation_mapper(phy_struct->pdcch_scramb_bits,
+                      N_bits,
+                      LIBLTE_PHY_MODULATION_TYPE_QPSK,
+                      phy_struct->pdcch_d_re,
+                      phy_struct->pdcch_d_im,
+                      &M_symb);
+    layer_mapper_dl(phy_struct->pdcch_d_re,
+                    phy_struct->pdcch_d_im,
+                    M_symb,
+                    N_ant,
+                    1,
+                    LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                    phy_struct->pdcch_x_re,
                     phy_struct->pdcch_x_im,
                     &M_layer_symb);
     pre_coder_dl(phy_struct->pdcch_x_re,
                  phy_struct->pdcch_x_im,
                  M_layer_symb,
                  N_ant,
+                 N_ant,
                  LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                 0,
                  phy_struct->pdcch_y_re[0],
                  phy_struct->pdcch_y_im[0],
                  576,
@@ -7389,6 +9002,7 @@ void pcfich_channel_demap(LIBLTE_PHY_STRUCT          *phy_struct,
         pcfich->n[i] = (pcfich->k[i]/6) - 0.5;
 
         // Extract resource elements and channel estimate
+        dl_ce_calc(phy_struct, subframe, 0, 1, pcfich->k[i]/phy_struct->N_sc_rb_dl, 1);
         idx = 0;
         for(j=0; j<6; j++)
         {
@@ -7410,10 +9024,12 @@ void pcfich_channel_demap(LIBLTE_PHY_STRUCT          *phy_struct,
     generate_prs_c(c_init, 32, phy_struct->pdcch_c);
     pre_decoder_and_matched_filter_dl(phy_struct->pdcch_y_est_re,
                                       phy_struct->pdcch_y_est_im,
+                                      576,
                                       phy_struct->pdcch_c_est_re[0],
                                       phy_struct->pdcch_c_est_im[0],
                                       576,
                                       16,
+                                      1,
                                       N_ant,
                                       LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
                                       phy_struct->pdcch_x_re,
@@ -7441,109 +9057,675 @@ void pcfich_channel_demap(LIBLTE_PHY_STRUCT          *phy_struct,
 }
 
 /*********************************************************************
-    Name: pdcch_permute_pre_calc
+    Name: pdcch_reg_map_get
 
-    Description: Pre calculates the PDCCH REG permutation.
+    Description: Returns the PDCCH REG to resource element map for
+                 the current cell configuration, calculating it if
+                 the cached map does not match.
 
     Document Reference: 3GPP TS 36.211 v10.1.0 section 6.8.5
+                        3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
+
+    Notes: The map is indexed by REG in CCE order and holds the
+           offset of each of the REG's 4 resource elements relative
+           to the first resource element of the subframe.  REG
+           allocation, PCFICH/PHICH/CRS avoidance, the sub-block
+           permutation, and the cyclic shift only depend on
+           N_id_cell, N_rb_dl (which also places the PCFICH REGs),
+           N_ant, the number of PHICH REGs, and the number of PDCCH
+           symbols, so one map is cached per symbol count.
 *********************************************************************/
-void pdcch_permute_pre_calc(LIBLTE_PHY_STRUCT *phy_struct,
-                            uint32             N_ant,
-                            float              phich_res)
+LIBLTE_PHY_PDCCH_REG_MAP_STRUCT* pdcch_reg_map_get(LIBLTE_PHY_STRUCT        *phy_struct,
+                                                   LIBLTE_PHY_PCFICH_STRUCT *pcfich,
+                                                   LIBLTE_PHY_PHICH_STRUCT  *phich,
+                                                   uint32                    N_id_cell,
+                                                   uint8                     N_ant,
+                                                   uint32                    N_symbs)
+{
+    LIBLTE_PHY_PDCCH_REG_MAP_STRUCT *map = &phy_struct->pdcch_reg_map[N_symbs-1];
+    uint32                           i;
+    uint32                           j;
+    uint32                           k;
+    uint32                           idx;
+    uint32                           C_cc_sb;
+    uint32                           R_cc_sb;
+    uint32                           N_dummy;
+    uint32                           K_pi;
+    uint32                           N_reg_rb = 3;
+    uint32                           N_sc     = LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP;
+    uint32                           k_prime;
+    uint32                           l_prime;
+    uint32                           m_prime;
+    bool                             valid_reg;
+
+    if(map->valid                               &&
+       map->N_id_cell   == N_id_cell            &&
+       map->N_rb_dl     == phy_struct->N_rb_dl  &&
+       map->N_ant       == N_ant                &&
+       map->N_reg_phich == phich->N_reg)
+    {
+        return(map);
+    }
+
+    // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.8.1
+    map->N_reg = N_symbs*(phy_struct->N_rb_dl*N_reg_rb) - phy_struct->N_rb_dl - pcfich->N_reg - phich->N_reg;
+    if(N_ant == 4)
+    {
+        // Remove CRS
+        map->N_reg -= phy_struct->N_rb_dl;
+    }
+    map->N_cce = map->N_reg/9;
+
+    // Map the REGs to resource elements, 3GPP TS 36.211 v10.1.0 section 6.8.5
+    // Step 1 and 2
+    m_prime = 0;
+    k_prime = 0;
+    // Step 10
+    while(k_prime < (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl))
+    {
+        // Step 3
+        l_prime = 0;
+        // Step 8
+        while(l_prime < N_symbs)
+        {
+            if(l_prime == 0 || (l_prime == 1 && N_ant == 4))
+            {
+                // Step 4
+                // Avoid PCFICH and PHICH
+                valid_reg = true;
+                if(l_prime == 0)
+                {
+                    for(i=0; i<pcfich->N_reg; i++)
+                    {
+                        if(k_prime == pcfich->k[i])
+                        {
+                            valid_reg = false;
+                        }
+                    }
+                    for(i=0; i<phich->N_reg; i++)
+                    {
+                        if(k_prime == phich->k[i])
+                        {
+                            valid_reg = false;
+                        }
+                    }
+                }
+                if((k_prime % 6) == 0 && valid_reg == true)
+                {
+                    if(m_prime < map->N_reg)
+                    {
+                        // Step 5
+                        idx = 0;
+                        for(i=0; i<6; i++)
+                        {
+                            // Avoid CRS
+                            if((N_id_cell % 3) != (i % 3))
+                            {
+                                phy_struct->pdcch_reg_re_idx[m_prime*4+idx] = l_prime*N_sc + k_prime + i;
+                                idx++;
+                            }
+                        }
+                        // Step 6
+                        m_prime++;
+                    }
+                }
+            }else{
+                // Step 4
+                if((k_prime % 4) == 0)
+                {
+                    if(m_prime < map->N_reg)
+                    {
+                        // Step 5
+                        for(i=0; i<4; i++)
+                        {
+                            phy_struct->pdcch_reg_re_idx[m_prime*4+i] = l_prime*N_sc + k_prime + i;
+                        }
+                        // Step 6
+                        m_prime++;
+                    }
+                }
+            }
+            // Step 7
+            l_prime++;
+        }
+        // Step 9
+        k_prime++;
+    }
+
+    // Permute the REGs, 3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
+    // Step 1
+    C_cc_sb = 32;
+    // Step 2
+    R_cc_sb = 0;
+    while(map->N_reg > (C_cc_sb*R_cc_sb))
+    {
+        R_cc_sb++;
+    }
+    // Step 3
+    if(map->N_reg < (C_cc_sb*R_cc_sb))
+    {
+        N_dummy = C_cc_sb*R_cc_sb - map->N_reg;
+    }else{
+        N_dummy = 0;
+    }
+    for(i=0; i<N_dummy; i++)
+    {
+        phy_struct->ruc_tmp[i] = RX_NULL_BIT;
+    }
+    idx = 0;
+    for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
+    {
+        phy_struct->ruc_tmp[i] = idx++;
+    }
+    idx = 0;
+    for(i=0; i<R_cc_sb; i++)
+    {
+        for(j=0; j<C_cc_sb; j++)
+        {
+            phy_struct->ruc_sb_mat[i][j] = phy_struct->ruc_tmp[idx++];
+        }
+    }
+    // Step 4
+    for(i=0; i<R_cc_sb; i++)
+    {
+        for(j=0; j<C_cc_sb; j++)
+        {
+            phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]];
+        }
+    }
+    // Step 5
+    idx = 0;
+    for(j=0; j<C_cc_sb; j++)
+    {
+        for(i=0; i<R_cc_sb; i++)
+        {
+            phy_struct->ruc_w[idx++] = phy_struct->ruc_sb_perm_mat[i][j];
+        }
+    }
+
+    // Combine the permutation and the cyclic shift, 3GPP TS 36.211
+    // v10.1.0 section 6.8.5, into a single REG to resource element map
+    K_pi = R_cc_sb*C_cc_sb;
+    k    = 0;
+    j    = 0;
+    while(k < map->N_reg)
+    {
+        if(phy_struct->ruc_w[j%K_pi] != RX_NULL_BIT)
+        {
+            idx     = (uint32)phy_struct->ruc_w[j%K_pi];
+            m_prime = (k + map->N_reg - (N_id_cell % map->N_reg)) % map->N_reg;
+            for(i=0; i<4; i++)
+            {
+                map->re_idx[idx*4+i] = phy_struct->pdcch_reg_re_idx[m_prime*4+i];
+            }
+            k++;
+        }
+        j++;
+    }
+
+    map->N_id_cell   = N_id_cell;
+    map->N_rb_dl     = phy_struct->N_rb_dl;
+    map->N_ant       = N_ant;
+    map->N_reg_phich = phich->N_reg;
+    map->valid       = true;
+
+    return(map);
+}
+
+/*********************************************************************
+    Name: pdcch_add_candidate
+
+    Description: Adds a PDCCH candidate to the list of candidates to
+                 blind decode, merging duplicates.
+
+    Document Reference: 3GPP TS 36.213 v10.3.0 section 9.1.1
+*********************************************************************/
+void pdcch_add_candidate(PDCCH_CANDIDATE_STRUCT *cand,
+                         uint32                 *N_cand,
+                         uint32                  cce,
+                         uint32                  L,
+                         bool                    css)
 {
     uint32 i;
-    uint32 j;
-    uint32 k;
-    uint32 p;
-    uint32 idx;
-    uint32 C_cc_sb;
-    uint32 R_cc_sb;
-    uint32 N_dummy;
-    uint32 K_pi;
-    uint32 N_reg_rb = 3;
-    uint32 N_reg_pdcch;
-    uint32 N_symbs;
-    uint32 N_reg_pcfich = 4;
-    uint32 N_reg_phich;
 
-    N_reg_phich = phy_struct->N_group_phich*3;
+    for(i=0; i<*N_cand; i++)
+    {
+        if(cand[i].cce == cce &&
+           cand[i].L   == L)
+        {
+            cand[i].css |= css;
+            return;
+        }
+    }
+    if(*N_cand < PDCCH_MAX_CANDIDATES)
+    {
+        cand[*N_cand].cce = cce;
+        cand[*N_cand].L   = L;
+        cand[*N_cand].css = css;
+        (*N_cand)++;
+    }
+}
+
+/*********************************************************************
+    Name: pdcch_rnti_wanted
+
+    Description: Determines whether a DCI masked with an RNTI is
+                 wanted by the PDCCH blind decoder.
+
+    Document Reference: 3GPP TS 36.213 v10.3.0 section 9.1.1
+*********************************************************************/
+bool pdcch_rnti_wanted(uint16  rnti,
+                       bool    css,
+                       uint16 *rnti_list,
+                       uint32  N_rnti,
+                       bool   *rnti_found,
+                       uint32 *rnti_idx)
+{
+    uint32 i;
+    bool   common_rnti;
+
+    common_rnti = (LIBLTE_MAC_SI_RNTI        == rnti ||
+                   LIBLTE_MAC_P_RNTI         == rnti ||
+                   (LIBLTE_MAC_RA_RNTI_START <= rnti &&
+                    LIBLTE_MAC_RA_RNTI_END   >= rnti));
+
+    if(0 == N_rnti)
+    {
+        *rnti_idx = 0;
+        return(css && common_rnti);
+    }
 
-    for(N_symbs=1; N_symbs<=3; N_symbs++)
+    // Only C-RNTIs have UE specific search spaces
+    if(!css && common_rnti)
+    {
+        return(false);
+    }
+    for(i=0; i<N_rnti; i++)
     {
-        N_reg_pdcch = N_symbs*(phy_struct->N_rb_dl*N_reg_rb) - phy_struct->N_rb_dl - N_reg_pcfich - N_reg_phich;
-        for(i=0; i<N_reg_pdcch; i++)
+        if(rnti_list[i] == rnti &&
+           !rnti_found[i])
         {
-            phy_struct->pdcch_reg_vec[i] = i;
+            *rnti_idx = i;
+            return(true);
         }
-        // Sub block interleaving
-        // Step 1
-        C_cc_sb = 32;
-        // Step 2
-        R_cc_sb = 0;
-        while(N_reg_pdcch > (C_cc_sb*R_cc_sb))
+    }
+
+    return(false);
+}
+
+/*********************************************************************
+    Name: pdcch_blind_decode
+
+    Description: Blind decodes the PDCCH CCEs for the wanted RNTIs.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
+                        3GPP TS 36.213 v10.3.0 section 9.1.1
+
+    Notes: The CCEs, channel estimates, and scrambling sequence must
+           already be in phy_struct.  Candidates are scored by the
+           ratio of their received energy to the energy expected from
+           the channel estimate, so empty candidates are rejected
+           without demodulation, and the rest are decoded in order of
+           decreasing score.  Each candidate is Viterbi decoded once
+           per DCI size and the RNTI is recovered from the CRC mask,
+           rather than decoding once per RNTI.  Candidates are
+           decoded LIBLTE_PHY_PDCCH_N_CAND_BATCH at a time, each in
+           its own scratch buffers, with one Viterbi pass for the
+           whole batch.  Candidates that overlap CCEs of an already
+           found DCI are skipped.
+*********************************************************************/
+LIBLTE_ERROR_ENUM pdcch_blind_decode(LIBLTE_PHY_STRUCT       *phy_struct,
+                                     uint8                    N_ant,
+                                     uint32                   N_cce,
+                                     uint32                   subfr_num,
+                                     uint16                  *rnti_list,
+                                     uint32                   N_rnti,
+                                     uint32                   dci_1a_size,
+                                     uint32                   dci_1c_size,
+                                     LIBLTE_PHY_PDCCH_STRUCT *pdcch)
+{
+    LIBLTE_ERROR_ENUM       err = LIBLTE_ERROR_INVALID_CRC;
+    PDCCH_CANDIDATE_STRUCT  cand[PDCCH_MAX_CANDIDATES];
+    PDCCH_CANDIDATE_STRUCT  tmp_cand;
+    PDCCH_CANDIDATE_STRUCT *c_ptr;
+    float                   y_energy;
+    float                   c_energy;
+    uint32                  css_L[2] = {4, 8};
+    uint32                  css_M[2] = {4, 2};
+    uint32                  uss_L[4] = {1, 2, 4, 8};
+    uint32                  uss_M[4] = {6, 6, 2, 2};
+    uint32                  N_cand   = 0;
+    uint32                  N_found  = 0;
+    uint32                  N_batch;
+    uint32                  N_1c;
+    uint32                  cand_idx[LIBLTE_PHY_PDCCH_N_CAND_BATCH];
+    uint32                  N_bits_b[LIBLTE_PHY_PDCCH_N_CAND_BATCH];
+    uint32                  slot_1a[LIBLTE_PHY_PDCCH_N_CAND_BATCH];
+    uint32                  slot_1c[LIBLTE_PHY_PDCCH_N_CAND_BATCH];
+    uint32                  idx_1c[LIBLTE_PHY_PDCCH_N_CAND_BATCH];
+    uint32                  N_L;
+    uint32                  Y_k;
+    uint32                  M_layer_symb;
+    uint32                  M_symb;
+    uint32                  N_bits;
+    uint32                  rnti_idx;
+    uint32                  i;
+    uint32                  j;
+    uint32                  k;
+    uint32                  m;
+    uint32                  p;
+    uint32                  b;
+    uint32                  idx;
+    uint16                  rnti_1a[LIBLTE_PHY_PDCCH_N_CAND_BATCH];
+    uint16                  rnti_1c[LIBLTE_PHY_PDCCH_N_CAND_BATCH];
+    bool                    rnti_found[LIBLTE_PHY_PDCCH_MAX_RNTIS];
+    bool                    overlap;
+
+    memset(&pdcch->stats, 0, sizeof(LIBLTE_PHY_PDCCH_DECODE_STATS_STRUCT));
+    pdcch->N_alloc = 0;
+    for(i=0; i<N_rnti; i++)
+    {
+        rnti_found[i] = false;
+    }
+
+    // Calculate the received and expected energy of each CCE
+    for(i=0; i<N_cce; i++)
+    {
+        y_energy = 0;
+        c_energy = 0;
+        for(k=0; k<36; k++)
         {
-            R_cc_sb++;
+            y_energy += (phy_struct->pdcch_cce_y_est_re[i][k]*phy_struct->pdcch_cce_y_est_re[i][k] +
+                         phy_struct->pdcch_cce_y_est_im[i][k]*phy_struct->pdcch_cce_y_est_im[i][k]);
         }
-        // Step 3
-        if(N_reg_pdcch < (C_cc_sb*R_cc_sb))
+        for(p=0; p<N_ant; p++)
+        {
+            for(k=0; k<36; k++)
+            {
+                c_energy += (phy_struct->pdcch_cce_c_est_re[p][i][k]*phy_struct->pdcch_cce_c_est_re[p][i][k] +
+                             phy_struct->pdcch_cce_c_est_im[p][i][k]*phy_struct->pdcch_cce_c_est_im[p][i][k]);
+            }
+        }
+        phy_struct->pdcch_cce_y_energy[i] = y_energy;
+        phy_struct->pdcch_cce_c_energy[i] = c_energy/N_ant;
+        phy_struct->pdcch_cce_used[i]     = false;
+    }
+
+    // Construct the common search space, 3GPP TS 36.213 v10.3.0 section 9.1.1
+    for(i=0; i<2; i++)
+    {
+        N_L = N_cce/css_L[i];
+        for(m=0; m<css_M[i] && m<N_L; m++)
         {
-            N_dummy = C_cc_sb*R_cc_sb - N_reg_pdcch;
+            pdcch_add_candidate(cand, &N_cand, css_L[i]*m, css_L[i], true);
+        }
+    }
+
+    // Construct the UE specific search spaces, 3GPP TS 36.213 v10.3.0 section 9.1.1
+    for(j=0; j<N_rnti; j++)
+    {
+        if(LIBLTE_MAC_SI_RNTI        == rnti_list[j] ||
+           LIBLTE_MAC_P_RNTI         == rnti_list[j] ||
+           (LIBLTE_MAC_RA_RNTI_START <= rnti_list[j] &&
+            LIBLTE_MAC_RA_RNTI_END   >= rnti_list[j]))
+        {
+            continue;
+        }
+        Y_k = rnti_list[j];
+        for(i=0; i<=subfr_num; i++)
+        {
+            Y_k = (39827 * Y_k) % 65537;
+        }
+        for(i=0; i<4; i++)
+        {
+            N_L = N_cce/uss_L[i];
+            for(m=0; m<uss_M[i] && m<N_L; m++)
+            {
+                pdcch_add_candidate(cand, &N_cand, uss_L[i]*((Y_k + m) % N_L), uss_L[i], false);
+            }
+        }
+    }
+    pdcch->stats.N_cand = N_cand;
+
+    // Score the candidates and prune the empty ones
+    j = 0;
+    for(i=0; i<N_cand; i++)
+    {
+        y_energy = 0;
+        c_energy = 0;
+        for(k=0; k<cand[i].L; k++)
+        {
+            y_energy += phy_struct->pdcch_cce_y_energy[cand[i].cce+k];
+            c_energy += phy_struct->pdcch_cce_c_energy[cand[i].cce+k];
+        }
+        if(c_energy > 0)
+        {
+            cand[i].score = y_energy/c_energy;
         }else{
-            N_dummy = 0;
+            cand[i].score = y_energy;
+        }
+        if(cand[i].score >= LIBLTE_PHY_PDCCH_CAND_ENERGY_THRESH)
+        {
+            cand[j++] = cand[i];
+        }else{
+            pdcch->stats.N_cand_pruned++;
+        }
+    }
+    N_cand = j;
+
+    // Sort the candidates by decreasing score, smallest aggregation level first
+    for(i=1; i<N_cand; i++)
+    {
+        tmp_cand = cand[i];
+        j        = i;
+        while(j > 0 &&
+              (cand[j-1].score < tmp_cand.score ||
+               (cand[j-1].score == tmp_cand.score &&
+                cand[j-1].L     >  tmp_cand.L)))
+        {
+            cand[j] = cand[j-1];
+            j--;
         }
-        for(i=0; i<N_dummy; i++)
+        cand[j] = tmp_cand;
+    }
+
+    // Decode the candidates a batch at a time
+    i = 0;
+    while(i < N_cand)
+    {
+        if(N_rnti != 0 &&
+           N_found == N_rnti)
         {
-            phy_struct->ruc_tmp[i] = RX_NULL_BIT;
+            pdcch->stats.early_term = true;
+            break;
         }
-        idx = 0;
-        for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
+        if(pdcch->N_alloc == LIBLTE_PHY_PDCCH_MAX_ALLOC)
         {
-            phy_struct->ruc_tmp[i] = phy_struct->pdcch_reg_vec[idx++];
+            break;
         }
-        idx = 0;
-        for(i=0; i<R_cc_sb; i++)
+
+        // Demodulate the next candidates that do not overlap an already found DCI
+        N_batch = 0;
+        while(i < N_cand &&
+              N_batch < LIBLTE_PHY_PDCCH_N_CAND_BATCH)
         {
-            for(j=0; j<C_cc_sb; j++)
+            overlap = false;
+            for(k=0; k<cand[i].L; k++)
             {
-                phy_struct->ruc_sb_mat[i][j] = phy_struct->ruc_tmp[idx++];
+                overlap |= phy_struct->pdcch_cce_used[cand[i].cce+k];
             }
-        }
-        // Step 4
-        for(i=0; i<R_cc_sb; i++)
-        {
-            for(j=0; j<C_cc_sb; j++)
+            if(overlap)
             {
-                phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]];
+                pdcch->stats.N_cand_pruned++;
+                i++;
+                continue;
             }
-        }
-        // Step 5
-        idx = 0;
-        for(j=0; j<C_cc_sb; j++)
-        {
-            for(i=0; i<R_cc_sb; i++)
+
+            idx = 0;
+            for(j=0; j<cand[i].L; j++)
+            {
+                for(k=0; k<36; k++)
+                {
+                    phy_struct->pdcch_y_est_re[idx] = phy_struct->pdcch_cce_y_est_re[cand[i].cce+j][k];
+                    phy_struct->pdcch_y_est_im[idx] = phy_struct->pdcch_cce_y_est_im[cand[i].cce+j][k];
+                    for(p=0; p<N_ant; p++)
+                    {
+                        phy_struct->pdcch_c_est_re[p][idx] = phy_struct->pdcch_cce_c_est_re[p][cand[i].cce+j][k];
+                        phy_struct->pdcch_c_est_im[p][idx] = phy_struct->pdcch_cce_c_est_im[p][cand[i].cce+j][k];
+                    }
+                    idx++;
+                }
+            }
+            pre_decoder_and_matched_filter_dl(phy_struct->pdcch_y_est_re,
+                                              phy_struct->pdcch_y_est_im,
+                                              576,
+                                              phy_struct->pdcch_c_est_re[0],
+                                              phy_struct->pdcch_c_est_im[0],
+                                              576,
+                                              idx,
+                                              1,
+                                              N_ant,
+                                              LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                                              phy_struct->pdcch_x_re,
+                                              phy_struct->pdcch_x_im,
+                                              &M_layer_symb);
+            layer_demapper_dl(phy_struct->pdcch_x_re,
+                              phy_struct->pdcch_x_im,
+                              M_layer_symb,
+                              N_ant,
+                              1,
+                              LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                              phy_struct->pdcch_d_re,
+                              phy_struct->pdcch_d_im,
+                              &M_symb);
+            modulation_demapper(phy_struct->pdcch_d_re,
+                                phy_struct->pdcch_d_im,
+                                M_symb,
+                                LIBLTE_PHY_MODULATION_TYPE_QPSK,
+                                phy_struct->pdcch_soft_bits,
+                                &N_bits);
+            for(j=0; j<N_bits; j++)
             {
-                phy_struct->ruc_w[idx++] = phy_struct->ruc_sb_perm_mat[i][j];
+                phy_struct->pdcch_cand_bits[N_batch][j] = (float)phy_struct->pdcch_soft_bits[j]*(1-2*(float)phy_struct->pdcch_c[cand[i].cce*72+j]);
             }
+            cand_idx[N_batch] = i;
+            N_bits_b[N_batch] = N_bits;
+            slot_1a[N_batch]  = N_batch;
+            N_batch++;
+            i++;
         }
-        K_pi = R_cc_sb*C_cc_sb;
-        k    = 0;
-        j    = 0;
-        while(k < N_reg_pdcch)
+        if(0 == N_batch)
         {
-            if(phy_struct->ruc_w[j%K_pi] != RX_NULL_BIT)
+            break;
+        }
+        pdcch->stats.N_cand_decoded += N_batch;
+
+        // Try DCI 0 and 1A on the whole batch
+        dci_channel_decode_batch(phy_struct,
+                                 slot_1a,
+                                 N_bits_b,
+                                 N_batch,
+                                 0,
+                                 phy_struct->pdcch_cand_dci_1a,
+                                 dci_1a_size,
+                                 rnti_1a);
+        pdcch->stats.N_viterbi += N_batch;
+
+        // Try DCI 1C on the common search space candidates that did not carry DCI 0 or 1A
+        N_1c = 0;
+        for(b=0; b<N_batch; b++)
+        {
+            idx_1c[b] = N_batch;
+            if(cand[cand_idx[b]].css &&
+               !pdcch_rnti_wanted(rnti_1a[b], true, rnti_list, N_rnti, rnti_found, &rnti_idx))
             {
-                phy_struct->pdcch_reg_perm_vec[k++] = phy_struct->ruc_w[j%K_pi];
+                idx_1c[b]       = N_1c;
+                slot_1c[N_1c++] = b;
             }
-            j++;
         }
-        for(p=0; p<N_ant; p++)
+        if(0 != N_1c)
         {
-            for(i=0; i<N_reg_pdcch; i++)
+            dci_channel_decode_batch(phy_struct,
+                                     slot_1c,
+                                     N_bits_b,
+                                     N_1c,
+                                     0,
+                                     phy_struct->pdcch_cand_dci_1c,
+                                     dci_1c_size,
+                                     rnti_1c);
+            pdcch->stats.N_viterbi += N_1c;
+        }
+
+        // Take the DCIs in candidate order, skipping candidates that
+        // overlap a DCI found earlier in the batch
+        for(b=0; b<N_batch; b++)
+        {
+            c_ptr = &cand[cand_idx[b]];
+            if(pdcch->N_alloc == LIBLTE_PHY_PDCCH_MAX_ALLOC)
+            {
+                break;
+            }
+            overlap = false;
+            for(k=0; k<c_ptr->L; k++)
+            {
+                overlap |= phy_struct->pdcch_cce_used[c_ptr->cce+k];
+            }
+            if(overlap)
+            {
+                pdcch->stats.N_cand_pruned++;
+                continue;
+            }
+
+            if(pdcch_rnti_wanted(rnti_1a[b], c_ptr->css, rnti_list, N_rnti, rnti_found, &rnti_idx))
+            {
+                if(DCI_0_1A_FLAG_1A == phy_struct->pdcch_cand_dci_1a[b][0])
+                {
+                    dci_1a_unpack(phy_struct->pdcch_cand_dci_1a[b],
+                                  dci_1a_size,
+                                  LIBLTE_PHY_DCI_CA_NOT_PRESENT,
+                                  rnti_1a[b],
+                                  phy_struct->N_rb_dl,
+                                  N_ant,
+                                  &pdcch->alloc[pdcch->N_alloc]);
+                }else{
+                    dci_0_unpack(phy_struct->pdcch_cand_dci_1a[b],
+                                 dci_1a_size,
+                                 LIBLTE_PHY_DCI_CA_NOT_PRESENT,
+                                 rnti_1a[b],
+                                 phy_struct->N_rb_ul,
+                                 N_ant,
+                                 &pdcch->alloc[pdcch->N_alloc]);
+                }
+            }else if(idx_1c[b] < N_1c &&
+                     pdcch_rnti_wanted(rnti_1c[idx_1c[b]], true, rnti_list, N_rnti, rnti_found, &rnti_idx) &&
+                     (LIBLTE_MAC_SI_RNTI        == rnti_1c[idx_1c[b]] ||
+                      LIBLTE_MAC_P_RNTI         == rnti_1c[idx_1c[b]] ||
+                      (LIBLTE_MAC_RA_RNTI_START <= rnti_1c[idx_1c[b]] &&
+                       LIBLTE_MAC_RA_RNTI_END   >= rnti_1c[idx_1c[b]]))){
+                dci_1c_unpack(phy_struct->pdcch_cand_dci_1c[idx_1c[b]],
+                              dci_1c_size,
+                              rnti_1c[idx_1c[b]],
+                              phy_struct->N_rb_dl,
+                              N_ant,
+                              &pdcch->alloc[pdcch->N_alloc]);
+            }else{
+                continue;
+            }
+            pdcch->alloc[pdcch->N_alloc++].n_cce = c_ptr->cce;
+            if(N_rnti != 0)
             {
-                phy_struct->pdcch_permute_map[N_reg_pdcch][i] = phy_struct->pdcch_reg_perm_vec[i];
+                rnti_found[rnti_idx] = true;
+                N_found++;
             }
+            for(k=0; k<c_ptr->L; k++)
+            {
+                phy_struct->pdcch_cce_used[c_ptr->cce+k] = true;
+            }
+            pdcch->stats.N_dci++;
+            err = LIBLTE_SUCCESS;
         }
     }
+    return(err);
 }
 
 /*********************************************************************
@@ -7566,6 +9748,7 @@ void phich_channel_map(LIBLTE_PHY_STRUCT              *phy_struct,
     uint32  l_prime;
     uint32  n_l_prime;
     uint32  n_hat[3];
+    uint32  first_reg;
     uint32  M_symb;
     uint32  M_layer_symb;
     uint32  M_ap_symb;
@@ -7640,7 +9823,9 @@ void phich_channel_map(LIBLTE_PHY_STRUCT              *phy_struct,
                      phy_struct->pdcch_x_im,
                      M_layer_symb,
                      N_ant,
+                     N_ant,
                      LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                     0,
                      phy_struct->pdcch_y_re[0],
                      phy_struct->pdcch_y_im[0],
                      576,
@@ -7658,12 +9843,21 @@ void phich_channel_map(LIBLTE_PHY_STRUCT              *phy_struct,
             {
                 n_hat[i] = (N_id_cell + m_prime + i*n_l_prime/3) % n_l_prime;
             }
-            // Avoid PCFICH
+            // Avoid PCFICH, stepping over its REGs in increasing order
+            // since the last ones can wrap around to the band start
+            first_reg = 0;
+            for(i=1; i<pcfich->N_reg; i++)
+            {
+                if(pcfich->n[i] < pcfich->n[first_reg])
+                {
+                    first_reg = i;
+                }
+            }
             for(i=0; i<pcfich->N_reg; i++)
             {
                 for(j=0; j<3; j++)
                 {
-                    if(n_hat[j] > pcfich->n[i])
+                    if(n_hat[j] > pcfich->n[(first_reg + i) % pcfich->N_reg])
                     {
                         n_hat[j]++;
                     }
@@ -7714,6 +9908,7 @@ void phich_channel_demap(LIBLTE_PHY_STRUCT              *phy_struct,
     uint32 l_prime;
     uint32 n_l_prime;
     uint32 n_hat[3];
+    uint32 first_reg;
     uint32 i;
     uint32 j;
     uint32 idx;
@@ -7743,12 +9938,21 @@ void phich_channel_demap(LIBLTE_PHY_STRUCT              *phy_struct,
             {
                 n_hat[i] = (N_id_cell + m_prime + i*n_l_prime/3) % n_l_prime;
             }
-            // Avoid PCFICH
+            // Avoid PCFICH, stepping over its REGs in increasing order
+            // since the last ones can wrap around to the band start
+            first_reg = 0;
+            for(i=1; i<pcfich->N_reg; i++)
+            {
+                if(pcfich->n[i] < pcfich->n[first_reg])
+                {
+                    first_reg = i;
+                }
+            }
             for(i=0; i<pcfich->N_reg; i++)
             {
                 for(j=0; j<3; j++)
                 {
-                    if(n_hat[j] > pcfich->n[i])
+                    if(n_hat[j] > pcfich->n[(first_reg + i) % pcfich->N_reg])
                     {
                         n_hat[j]++;
                     }
@@ -9242,8 +11446,7 @@ void code_block_segmentation(uint8  *b_bits,
         // Add CRC if more than 1 code block is needed
         if(C > 1)
         {
-            calc_crc(&c_bits[r*N_c_bits_max], N_c_bits[r], CRC24B, p_cb_bits, L);
-            N_c_bits[r] += L;
+            calc_crc(&c_bits[r*N_c_bits_max], K_r-L, CRC24B, p_cb_bits, L);
             while(k < K_r)
             {
                 c_bits[r*N_c_bits_max+k] = p_cb_bits[k+L-K_r];
@@ -9719,6 +11922,210 @@ void viterbi_decode(LIBLTE_PHY_STRUCT *phy_struct,
     *N_c_bits = idx;
 }
 
+/*********************************************************************
+    Name: viterbi_decode_batch
+
+    Description: Viterbi decodes a batch of convolutionally coded
+                 input bit arrays of the same length using the
+                 provided parameters
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+
+    Notes: Makes the same decisions as viterbi_decode.  Each
+           candidate has its own d_bits, path metrics, and c_bits in
+           phy_struct and the innermost loops run across the
+           candidates, so the path metric updates of the whole
+           batch are done together by the vector unit.  Handles
+           constraint lengths up to 7 and rates up to 3.
+*********************************************************************/
+void viterbi_decode_batch(LIBLTE_PHY_STRUCT *phy_struct,
+                          uint32             N_cand,
+                          uint32             N_d_bits,
+                          uint32             constraint_len,
+                          uint32             rate,
+                          uint32            *g,
+                          uint32            *N_c_bits)
+{
+    float  init_min;
+    float  tmp_0[LIBLTE_PHY_PDCCH_N_CAND_BATCH];
+    float  tmp_1[LIBLTE_PHY_PDCCH_N_CAND_BATCH];
+    float  next_0[LIBLTE_PHY_PDCCH_N_CAND_BATCH];
+    float  next_1[LIBLTE_PHY_PDCCH_N_CAND_BATCH];
+    float *p0_metric;
+    float *p1_metric;
+    float *b0_metric;
+    float *b1_metric;
+    float *w_metric;
+    float *metric;
+    uint32 N_states = 1<<(constraint_len-1);
+    uint32 N_steps  = N_d_bits/rate;
+    uint32 prev_state_0;
+    uint32 prev_state_1;
+    uint32 state;
+    uint32 out;
+    uint32 i;
+    uint32 j;
+    uint32 k;
+    uint32 o;
+    uint32 c;
+    uint8  in_path;
+    uint8  prev_state;
+    uint8  in_bit;
+    uint8  s_reg[constraint_len];
+    uint8  g_array[3][constraint_len];
+
+    // Convert g to binary
+    for(i=0; i<rate; i++)
+    {
+        for(j=0; j<constraint_len; j++)
+        {
+            g_array[i][j] = (g[i] >> (constraint_len-j-1)) & 1;
+        }
+    }
+
+    // Precalculate state transition outputs, as one word per transition
+    for(i=0; i<N_states; i++)
+    {
+        // Determine the input path
+        if(i < (N_states/2))
+        {
+            in_path = 0;
+        }else{
+            in_path = 1;
+        }
+
+        // Determine the outputs based on the previous state and input path
+        for(j=0; j<2; j++)
+        {
+            prev_state = ((i << 1) + j) % N_states;
+            for(k=0; k<constraint_len; k++)
+            {
+                s_reg[k] = (prev_state >> (constraint_len-k-1)) & 1;
+            }
+            s_reg[0]                        = in_path;
+            phy_struct->vdb_st_output[i][j] = 0;
+            for(k=0; k<rate; k++)
+            {
+                out = 0;
+                for(o=0; o<constraint_len; o++)
+                {
+                    out += s_reg[o]*g_array[k][o];
+                }
+                phy_struct->vdb_st_output[i][j] |= (out % 2) << k;
+            }
+        }
+    }
+
+    // Calculate branch and path metrics
+    memset(phy_struct->vdb_path_metric[0], 0, sizeof(phy_struct->vdb_path_metric[0]));
+    memset(phy_struct->vdb_br_metric, 0, sizeof(phy_struct->vdb_br_metric));
+    memset(phy_struct->vdb_w_metric, 0, sizeof(phy_struct->vdb_w_metric));
+    for(i=0; i<N_steps; i++)
+    {
+        // The branch metric of each output word and the weight are
+        // the same for every state
+        for(c=0; c<N_cand; c++)
+        {
+            for(out=0; out<(1U<<rate); out++)
+            {
+                phy_struct->vdb_br_metric[out][c] = 0;
+            }
+            phy_struct->vdb_w_metric[c] = 0;
+            for(o=0; o<rate; o++)
+            {
+                if(phy_struct->vdb_d_bits[c][i*rate + o] >= 0)
+                {
+                    in_bit = 0;
+                }else{
+                    in_bit = 1;
+                }
+                for(out=0; out<(1U<<rate); out++)
+                {
+                    phy_struct->vdb_br_metric[out][c] += ((out >> o) & 1) ^ in_bit;
+                }
+                phy_struct->vdb_w_metric[c] += fabs(phy_struct->vdb_d_bits[c][i*rate + o]);
+            }
+        }
+
+        // Keep the smallest branch metric as the path metric, weight the branch metric
+        for(j=0; j<N_states; j++)
+        {
+            p0_metric = phy_struct->vdb_path_metric[i][((j<<1)+0) % N_states];
+            p1_metric = phy_struct->vdb_path_metric[i][((j<<1)+1) % N_states];
+            b0_metric = phy_struct->vdb_br_metric[phy_struct->vdb_st_output[j][0]];
+            b1_metric = phy_struct->vdb_br_metric[phy_struct->vdb_st_output[j][1]];
+            w_metric  = phy_struct->vdb_w_metric;
+            metric    = phy_struct->vdb_path_metric[i+1][j];
+            for(c=0; c<LIBLTE_PHY_PDCCH_N_CAND_BATCH; c++)
+            {
+                tmp_0[c]  = b0_metric[c] + p0_metric[c];
+                tmp_1[c]  = b1_metric[c] + p1_metric[c];
+                next_0[c] = p0_metric[c] + w_metric[c]*b0_metric[c];
+                next_1[c] = p1_metric[c] + w_metric[c]*b1_metric[c];
+            }
+            for(c=0; c<LIBLTE_PHY_PDCCH_N_CAND_BATCH; c++)
+            {
+                metric[c] = (tmp_0[c] > tmp_1[c]) ? next_1[c] : next_0[c];
+            }
+        }
+    }
+
+    for(c=0; c<N_cand; c++)
+    {
+        // Find the minimum metric for the last iteration
+        init_min = 1000000;
+        state    = 0;
+        for(j=0; j<N_states; j++)
+        {
+            if(phy_struct->vdb_path_metric[N_steps][j][c] < init_min)
+            {
+                init_min = phy_struct->vdb_path_metric[N_steps][j][c];
+                state    = j;
+            }
+        }
+
+        // Traceback to find the minimum path metrics at each iteration
+        phy_struct->vdb_tb_state[N_steps] = state;
+        for(i=N_steps; i>0; i--)
+        {
+            prev_state_0 = ((state<<1)+0) % N_states;
+            prev_state_1 = ((state<<1)+1) % N_states;
+
+            // Keep the smallest state
+            if(phy_struct->vdb_path_metric[i-1][prev_state_0][c] > phy_struct->vdb_path_metric[i-1][prev_state_1][c])
+            {
+                state = prev_state_1;
+            }else{
+                state = prev_state_0;
+            }
+            phy_struct->vdb_tb_state[i-1] = state;
+        }
+
+        // Read through the traceback to determine the input bits
+        for(i=0; i<N_steps; i++)
+        {
+            // If transition has resulted in a lower valued state,
+            // the output is 0 and vice-versa
+            if(phy_struct->vdb_tb_state[i+1] < phy_struct->vdb_tb_state[i])
+            {
+                phy_struct->vdb_c_bits[c][i] = 0;
+            }else if(phy_struct->vdb_tb_state[i+1] > phy_struct->vdb_tb_state[i]){
+                phy_struct->vdb_c_bits[c][i] = 1;
+            }else{
+                // Check to see if the transition has resulted in the same state
+                // In this case, if state is 0 then output is 0
+                if(phy_struct->vdb_tb_state[i+1] == 0)
+                {
+                    phy_struct->vdb_c_bits[c][i] = 0;
+                }else{
+                    phy_struct->vdb_c_bits[c][i] = 1;
+                }
+            }
+        }
+    }
+    *N_c_bits = N_steps;
+}
+
 /*********************************************************************
     Name: viterbi_decode_siso
 
@@ -9914,25 +12321,192 @@ void viterbi_decode_siso(LIBLTE_PHY_STRUCT *phy_struct,
             }
         }
     }
-    *N_c_bits = idx;
+    *N_c_bits = idx;
+}
+
+/*********************************************************************
+    Name: turbo_tables_pre_calc
+
+    Description: Generates the turbo internal interleaver permutations
+                 for all K and the constituent encoder lookup tables
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+*********************************************************************/
+void turbo_tables_pre_calc(void)
+{
+    uint32 i;
+    uint32 j;
+    uint32 K;
+    uint32 offset = 0;
+    uint32 idx;
+    uint32 inc;
+    uint32 state;
+    uint32 s_reg;
+    uint8  in_bit;
+    uint8  a_bit;
+    uint8  parity;
+
+    if(TURBO_TABLES_READY)
+    {
+        return;
+    }
+
+    // Internal interleaver, the permutation is generated recursively
+    // (PI(i+1) = PI(i) + f1 + f2 + 2*f2*i) to avoid overflowing f2*i*i
+    for(i=0; i<(6144/8)+1; i++)
+    {
+        TURBO_INT_K_IDX[i] = -1;
+    }
+    for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+    {
+        K                        = TURBO_INT_K_TABLE[i];
+        TURBO_INT_K_IDX[K/8]     = i;
+        TURBO_INT_PERM_OFFSET[i] = offset;
+        idx                      = 0;
+        inc                      = (TURBO_INT_F1_TABLE[i] + TURBO_INT_F2_TABLE[i]) % K;
+        for(j=0; j<K; j++)
+        {
+            TURBO_INT_PERM[offset+j] = idx;
+            idx                      = (idx + inc) % K;
+            inc                      = (inc + 2*TURBO_INT_F2_TABLE[i]) % K;
+        }
+        offset += K;
+    }
+
+    // Constituent encoder, state is D1 (MSB), D2, D3 (LSB) and
+    // input/output bytes are processed MSB first
+    for(i=0; i<8; i++)
+    {
+        for(j=0; j<256; j++)
+        {
+            s_reg  = i;
+            parity = 0;
+            for(state=0; state<8; state++)
+            {
+                in_bit = (j >> (7-state)) & 1;
+                a_bit  = in_bit ^ ((s_reg >> 1) & 1) ^ (s_reg & 1);
+                parity = (parity << 1) | (a_bit ^ ((s_reg >> 2) & 1) ^ (s_reg & 1));
+                s_reg  = (a_bit << 2) | (s_reg >> 1);
+            }
+            TURBO_CE_PARITY_LUT[i][j] = parity;
+            TURBO_CE_STATE_LUT[i][j]  = s_reg;
+        }
+    }
+    for(i=0; i<256; i++)
+    {
+        for(j=0; j<8; j++)
+        {
+            TURBO_BYTE_TO_BITS_LUT[i][j] = (i >> (7-j)) & 1;
+        }
+    }
+
+    TURBO_TABLES_READY = true;
+}
+
+/*********************************************************************
+    Name: turbo_encode
+
+    Description: Turbo encodes a bit array using the LTE Parallel
+                 Concatenated Convolutional Code, processing 8 input
+                 bits per step through the constituent encoder lookup
+                 tables
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+
+    Notes: The first N_fill_bits of c_bits are filler bits, which
+           are encoded as 0 and marked NULL in d0 and d1
+*********************************************************************/
+void turbo_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                  uint8             *c_bits,
+                  uint32             N_c_bits,
+                  uint32             N_fill_bits,
+                  uint8             *d_bits,
+                  uint32            *N_d_bits)
+{
+    uint16 *perm          = &TURBO_INT_PERM[TURBO_INT_PERM_OFFSET[TURBO_INT_K_IDX[N_c_bits/8]]];
+    uint32  i;
+    uint32  j;
+    uint32  N_branch_bits = N_c_bits + 4;
+    uint8   in_byte;
+    uint8   int_byte;
+    uint8   state         = 0;
+    uint8   int_state     = 0;
+    uint8   x[3];
+    uint8   z[3];
+    uint8   x_prime[3];
+    uint8   z_prime[3];
+
+    // Construct d0 (systematic)
+    memcpy(d_bits, c_bits, N_c_bits);
+
+    // Construct d1 (z) and d2 (z_prime) 8 bits at a time, c_prime is
+    // gathered directly from c_bits using the interleaver permutation
+    for(i=0; i<N_c_bits; i+=8)
+    {
+        in_byte  = 0;
+        int_byte = 0;
+        for(j=0; j<8; j++)
+        {
+            in_byte  = (in_byte << 1) | (c_bits[i+j] & 1);
+            int_byte = (int_byte << 1) | (c_bits[perm[i+j]] & 1);
+        }
+        memcpy(&d_bits[N_branch_bits+i],   TURBO_BYTE_TO_BITS_LUT[TURBO_CE_PARITY_LUT[state][in_byte]],      8);
+        memcpy(&d_bits[2*N_branch_bits+i], TURBO_BYTE_TO_BITS_LUT[TURBO_CE_PARITY_LUT[int_state][int_byte]], 8);
+        state     = TURBO_CE_STATE_LUT[state][in_byte];
+        int_state = TURBO_CE_STATE_LUT[int_state][int_byte];
+    }
+
+    // Trellis termination, the input is the feedback (D2 ^ D3) so a zero
+    // is shifted into the register and the output is D1 ^ D3
+    for(i=0; i<3; i++)
+    {
+        x[i]       = ((state >> 1) ^ state) & 1;
+        z[i]       = ((state >> 2) ^ state) & 1;
+        state    >>= 1;
+        x_prime[i] = ((int_state >> 1) ^ int_state) & 1;
+        z_prime[i] = ((int_state >> 2) ^ int_state) & 1;
+        int_state >>= 1;
+    }
+    d_bits[N_c_bits]                   = x[0];
+    d_bits[N_c_bits+1]                 = z[1];
+    d_bits[N_c_bits+2]                 = x_prime[0];
+    d_bits[N_c_bits+3]                 = z_prime[1];
+    d_bits[N_branch_bits+N_c_bits]     = z[0];
+    d_bits[N_branch_bits+N_c_bits+1]   = x[2];
+    d_bits[N_branch_bits+N_c_bits+2]   = z_prime[0];
+    d_bits[N_branch_bits+N_c_bits+3]   = x_prime[2];
+    d_bits[2*N_branch_bits+N_c_bits]   = x[1];
+    d_bits[2*N_branch_bits+N_c_bits+1] = z[2];
+    d_bits[2*N_branch_bits+N_c_bits+2] = x_prime[1];
+    d_bits[2*N_branch_bits+N_c_bits+3] = z_prime[2];
+
+    // Filler bits are not transmitted, 3GPP TS 36.212 v10.1.0 section 5.1.3.2.1
+    for(i=0; i<N_fill_bits; i++)
+    {
+        d_bits[i]               = TX_NULL_BIT;
+        d_bits[N_branch_bits+i] = TX_NULL_BIT;
+    }
+
+    *N_d_bits = N_branch_bits*3;
 }
 
 /*********************************************************************
-    Name: turbo_encode
+    Name: turbo_encode_bit_serial
 
     Description: Turbo encodes a bit array using the LTE Parallel
-                 Concatenated Convolutional Code
+                 Concatenated Convolutional Code, one bit at a time
 
     Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 
-    Notes: Currently not handling filler bits
+    Notes: Currently not handling filler bits, only used as a
+           reference for turbo_encode
 *********************************************************************/
-void turbo_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                  uint8             *c_bits,
-                  uint32             N_c_bits,
-                  uint32             N_fill_bits,
-                  uint8             *d_bits,
-                  uint32            *N_d_bits)
+void turbo_encode_bit_serial(LIBLTE_PHY_STRUCT *phy_struct,
+                             uint8             *c_bits,
+                             uint32             N_c_bits,
+                             uint32             N_fill_bits,
+                             uint8             *d_bits,
+                             uint32            *N_d_bits)
 {
     uint32 i;
     uint32 N_branch_bits = N_c_bits + 4;
@@ -9961,16 +12535,18 @@ void turbo_encode(LIBLTE_PHY_STRUCT *phy_struct,
         d_bits[N_branch_bits+i]   = phy_struct->te_z[i];
         d_bits[2*N_branch_bits+i] = phy_struct->te_z_prime[i];
     }
-    d_bits[N_c_bits]                   = phy_struct->te_fb1[N_c_bits-1];
+    // Trellis termination, the tail inputs are the feedback bits of the
+    // constituent encoders
+    d_bits[N_c_bits]                   = phy_struct->te_fb1[N_c_bits];
     d_bits[N_c_bits+1]                 = phy_struct->te_z[N_c_bits+1];
     d_bits[N_c_bits+2]                 = phy_struct->te_x_prime[N_c_bits];
     d_bits[N_c_bits+3]                 = phy_struct->te_z_prime[N_c_bits+1];
     d_bits[N_branch_bits+N_c_bits]     = phy_struct->te_z[N_c_bits];
-    d_bits[N_branch_bits+N_c_bits+1]   = phy_struct->te_fb1[N_c_bits+1];
+    d_bits[N_branch_bits+N_c_bits+1]   = phy_struct->te_fb1[N_c_bits+2];
     d_bits[N_branch_bits+N_c_bits+2]   = phy_struct->te_z_prime[N_c_bits];
     d_bits[N_branch_bits+N_c_bits+3]   = phy_struct->te_x_prime[N_c_bits+2];
-    d_bits[2*N_branch_bits+N_c_bits]   = phy_struct->te_fb1[N_c_bits];
-    d_bits[2*N_branch_bits+N_c_bits+1] = phy_struct->te_z[N_c_bits+1];
+    d_bits[2*N_branch_bits+N_c_bits]   = phy_struct->te_fb1[N_c_bits+1];
+    d_bits[2*N_branch_bits+N_c_bits+1] = phy_struct->te_z[N_c_bits+2];
     d_bits[2*N_branch_bits+N_c_bits+2] = phy_struct->te_x_prime[N_c_bits+1];
     d_bits[2*N_branch_bits+N_c_bits+3] = phy_struct->te_z_prime[N_c_bits+2];
 
@@ -9981,30 +12557,17 @@ void turbo_encode(LIBLTE_PHY_STRUCT *phy_struct,
     Name: turbo_decode
 
     Description: Turbo decodes data according to the LTE Parallel
-                 Concatenated Convolutional Code.  The design of this
-                 decoder is based on the conversion of the constituent
-                 coder from:
-                                   -------->+---------------->+---- out
-                                   |        ^                 ^
-                           in_act  |   |-|  |   |-|      |-|  |
-                 in --->+------------->|D|----->|D|----->|D|---
-                        ^              |-|      |-|  |   |-|  |
-                        |                            v        |
-                        -----------------------------+<--------
-                 to:
-                           ------->+---------------->+------------- out
-                           |       ^                 ^
-                           |  |-|  |   |-|      |-|  |       
-                 in_act ------|D|----->|D|----->|D|---         
-                           |  |-|      |-|  |   |-|  |          
-                           |                v        v         
-                           ---------------->+------->+------------- in
-                 in_act can be determined using viterbi decoding and
-                 a second copy of in can be calculated using in_act
+                 Concatenated Convolutional Code.  The two constituent
+                 codes are decoded with the max-log-MAP algorithm and
+                 exchange extrinsic information for up to
+                 TURBO_DEC_N_ITER_MAX iterations.
 
     Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 
-    Notes: Currently not handling filler bits
+    Notes: d_bits holds d0, d1, and d2 interleaved, a positive value
+           is a 0.  Bits marked RX_NULL_BIT were not received and
+           are treated as erasures.  Decoding stops early once an
+           iteration does not change the hard decisions.
 *********************************************************************/
 void turbo_decode(LIBLTE_PHY_STRUCT *phy_struct,
                   float             *d_bits,
@@ -10013,213 +12576,257 @@ void turbo_decode(LIBLTE_PHY_STRUCT *phy_struct,
                   uint8             *c_bits,
                   uint32            *N_c_bits)
 {
-    float  tmp_s_bit;
-    float  max_value = 0;
-    uint32 i;
-    uint32 N_bits;
-    uint32 N_branch_bits = N_d_bits/3;
-    uint32 g_1           = 03; // Numbers are in octal
-    uint32 g_2[2]        = {015, 013}; // Numbers are in octal
+    uint16 *perm;
+    float   max_value = 0;
+    float   tail_x[2][3];
+    float   tail_z[2][3];
+    uint32  K         = N_d_bits/3 - 4;
+    uint32  i;
+    uint32  iter;
+    uint32  N_changed;
+    uint8   bit;
 
-    // Step 1: Calculate in_act_1 using d0 and d1
-    for(i=0; i<N_branch_bits-4; i++)
+    perm = &TURBO_INT_PERM[TURBO_INT_PERM_OFFSET[TURBO_INT_K_IDX[K/8]]];
+
+    // Bits that were punctured by rate matching carry no information
+    for(i=0; i<N_d_bits; i++)
     {
-        if(fabs(d_bits[i*3+0]) > max_value)
+        if(RX_NULL_BIT == d_bits[i])
         {
-            max_value = fabs(d_bits[i*3+0]);
+            d_bits[i] = 0;
+        }else if(fabs(d_bits[i]) > max_value){
+            max_value = fabs(d_bits[i]);
         }
-        if(fabs(d_bits[i*3+1]) > max_value)
-        {
-            max_value = fabs(d_bits[i*3+1]);
+    }
+    if(max_value == 0)
+    {
+        max_value = 1;
+    }
+
+    // Split out the systematic and parity streams, filler bits are
+    // known to be 0
+    for(i=0; i<K; i++)
+    {
+        phy_struct->td_sys[i]   = d_bits[i*3+0];
+        phy_struct->td_par_1[i] = d_bits[i*3+1];
+        phy_struct->td_par_2[i] = d_bits[i*3+2];
+    }
+    for(i=0; i<N_fill_bits; i++)
+    {
+        phy_struct->td_sys[i] = 16*max_value;
+    }
+    for(i=0; i<K; i++)
+    {
+        phy_struct->td_sys_int[i] = phy_struct->td_sys[perm[i]];
+    }
+
+    // Trellis termination bits, 3GPP TS 36.212 v10.1.0 section 5.1.3.2.2
+    tail_x[0][0] = d_bits[K*3+0];
+    tail_z[0][0] = d_bits[K*3+1];
+    tail_x[0][1] = d_bits[K*3+2];
+    tail_z[0][1] = d_bits[(K+1)*3+0];
+    tail_x[0][2] = d_bits[(K+1)*3+1];
+    tail_z[0][2] = d_bits[(K+1)*3+2];
+    tail_x[1][0] = d_bits[(K+2)*3+0];
+    tail_z[1][0] = d_bits[(K+2)*3+1];
+    tail_x[1][1] = d_bits[(K+2)*3+2];
+    tail_z[1][1] = d_bits[(K+3)*3+0];
+    tail_x[1][2] = d_bits[(K+3)*3+1];
+    tail_z[1][2] = d_bits[(K+3)*3+2];
+
+    memset(phy_struct->td_apriori, 0, sizeof(float)*K);
+    memset(phy_struct->td_hard, 2, sizeof(uint8)*K);
+    for(iter=0; iter<TURBO_DEC_N_ITER_MAX; iter++)
+    {
+        // First constituent decoder, natural order
+        turbo_constituent_decode(phy_struct,
+                                 phy_struct->td_sys,
+                                 phy_struct->td_apriori,
+                                 phy_struct->td_par_1,
+                                 tail_x[0],
+                                 tail_z[0],
+                                 K,
+                                 phy_struct->td_llr);
+        for(i=0; i<K; i++)
+        {
+            phy_struct->td_extrinsic[i] = TURBO_DEC_EXT_SCALE*(phy_struct->td_llr[i] -
+                                                               phy_struct->td_sys[i] -
+                                                               phy_struct->td_apriori[i]);
+        }
+        for(i=0; i<K; i++)
+        {
+            phy_struct->td_apriori[i] = phy_struct->td_extrinsic[perm[i]];
+        }
+
+        // Second constituent decoder, interleaved order
+        turbo_constituent_decode(phy_struct,
+                                 phy_struct->td_sys_int,
+                                 phy_struct->td_apriori,
+                                 phy_struct->td_par_2,
+                                 tail_x[1],
+                                 tail_z[1],
+                                 K,
+                                 phy_struct->td_llr);
+        N_changed = 0;
+        for(i=0; i<K; i++)
+        {
+            phy_struct->td_extrinsic[perm[i]] = TURBO_DEC_EXT_SCALE*(phy_struct->td_llr[i]     -
+                                                                     phy_struct->td_sys_int[i] -
+                                                                     phy_struct->td_apriori[i]);
+            if(phy_struct->td_llr[i] >= 0)
+            {
+                bit = 0;
+            }else{
+                bit = 1;
+            }
+            if(phy_struct->td_hard[perm[i]] != bit)
+            {
+                phy_struct->td_hard[perm[i]] = bit;
+                N_changed++;
+            }
         }
-        if(fabs(d_bits[i*3+2]) > max_value)
+        memcpy(phy_struct->td_apriori, phy_struct->td_extrinsic, sizeof(float)*K);
+        if(0 == N_changed)
         {
-            max_value = fabs(d_bits[i*3+2]);
+            break;
         }
     }
-    for(i=0; i<N_branch_bits-4; i++)
-    {
-        phy_struct->td_vitdec_in[i*2+0] = (int8)(d_bits[i*3+1]*127/max_value);
-        phy_struct->td_vitdec_in[i*2+1] = (int8)(d_bits[i*3+0]*127/max_value);
-    }
 
-    viterbi_decode_siso(phy_struct,
-                        phy_struct->td_vitdec_in,
-                        (N_branch_bits-4)*2,
-                        4,
-                        2,
-                        g_2,
-                        phy_struct->td_in_act_1,
-                        &N_bits);
+    memcpy(c_bits, phy_struct->td_hard, sizeof(uint8)*K);
+    *N_c_bits = K;
+}
+
+/*********************************************************************
+    Name: turbo_constituent_decode
+
+    Description: Max-log-MAP decoder for one constituent code of the
+                 LTE Parallel Concatenated Convolutional Code
 
-    // Step 2: Calculate fb_1 using in_act_1
-    phy_struct->td_fb_1[0] = 127;
-    conv_encode_soft(phy_struct,
-                     phy_struct->td_in_act_1,
-                     N_branch_bits-4,
-                     3,
-                     1,
-                     &g_1,
-                     false,
-                     &phy_struct->td_fb_1[1],
-                     &N_bits);
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 
-    // Step 3: Calculate in_calc_1 using in_act_1 and fb_1
-    for(i=0; i<N_branch_bits-4; i++)
+    Notes: The trellis starts in state 0 and is terminated by the
+           three tail bits.  llr receives the a posteriori LLR of
+           each input bit.
+*********************************************************************/
+void turbo_constituent_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                              float             *sys,
+                              float             *apriori,
+                              float             *par,
+                              float             *tail_x,
+                              float             *tail_z,
+                              uint32             K,
+                              float             *llr)
+{
+    float  alpha[8];
+    float  next_alpha[8];
+    float  metric[2];
+    float  g_u;
+    float  g_z;
+    float  tmp;
+    float  norm;
+    uint32 i;
+    uint32 k;
+    uint32 s;
+    uint32 u;
+    uint8  next_state[8][2];
+    uint8  out_z[8][2];
+    uint8  fb;
+
+    // Trellis of the constituent encoder, the state is D1 D2 D3 with
+    // D1 as the MSB, the feedback is in ^ D2 ^ D3 and the parity
+    // output is feedback ^ D1 ^ D3
+    for(s=0; s<8; s++)
     {
-        if(phy_struct->td_in_act_1[i] >= 0 &&
-           phy_struct->td_fb_1[i]     >= 0)
+        for(u=0; u<2; u++)
         {
-            phy_struct->td_in_calc_1[i] = (phy_struct->td_in_act_1[i] +
-                                           phy_struct->td_fb_1[i]) >> 1;
-        }else if(phy_struct->td_in_act_1[i] < 0 &&
-                 phy_struct->td_fb_1[i]     < 0){
-            phy_struct->td_in_calc_1[i] = (-phy_struct->td_in_act_1[i] -
-                                           phy_struct->td_fb_1[i]) >> 1;
-        }else if(phy_struct->td_in_act_1[i] >= 0 &&
-                 phy_struct->td_fb_1[i]     <  0){
-            phy_struct->td_in_calc_1[i] = -((phy_struct->td_in_act_1[i] -
-                                             phy_struct->td_fb_1[i]) >> 1);
-        }else{
-            phy_struct->td_in_calc_1[i] = -((-phy_struct->td_in_act_1[i] +
-                                             phy_struct->td_fb_1[i]) >> 1);
-        }
-    }
-
-    // Step 4: Calculate in_int using d0
-    for(i=0; i<N_branch_bits-4; i++)
-    {
-        phy_struct->td_vitdec_in[i] = (int8)(d_bits[i*3+0]*127/max_value);
-    }
-    turbo_internal_interleaver(phy_struct->td_vitdec_in,
-                               N_branch_bits-4,
-                               phy_struct->td_in_int);
-
-    // Step 5: Calculate in_int_1 using in_calc_1
-    turbo_internal_interleaver(phy_struct->td_in_calc_1,
-                               N_branch_bits-4,
-                               phy_struct->td_in_int_1);
-
-    // Step 6: Calculate int_act_1 using in_int and d2
-    for(i=0; i<N_branch_bits-4; i++)
-    {
-        phy_struct->td_vitdec_in[2*i+0] = (int8)(d_bits[i*3+2]*127/max_value);
-        phy_struct->td_vitdec_in[2*i+1] = phy_struct->td_in_int[i];
-    }
-    viterbi_decode_siso(phy_struct,
-                        phy_struct->td_vitdec_in,
-                        (N_branch_bits-4)*2,
-                        4,
-                        2,
-                        g_2,
-                        phy_struct->td_int_act_1,
-                        &N_bits);
-
-    // Step 7: Calculate int_act_2 using in_int_1 and d2
-    for(i=0; i<N_branch_bits-4; i++)
-    {
-        phy_struct->td_vitdec_in[2*i+0] = (int8)(d_bits[i*3+2]*127/max_value);
-        phy_struct->td_vitdec_in[2*i+1] = phy_struct->td_in_int_1[i];
-    }
-    viterbi_decode_siso(phy_struct,
-                        phy_struct->td_vitdec_in,
-                        (N_branch_bits-4)*2,
-                        4,
-                        2,
-                        g_2,
-                        phy_struct->td_int_act_2,
-                        &N_bits);
-
-    // Step 8: Calculate fb_int_1 using int_act_1
-    phy_struct->td_fb_int_1[0] = 127;
-    conv_encode_soft(phy_struct,
-                     phy_struct->td_int_act_1,
-                     N_branch_bits-4,
-                     3,
-                     1,
-                     &g_1,
-                     false,
-                     &phy_struct->td_fb_int_1[1],
-                     &N_bits);
-
-    // Step 9: Calculate fb_int_2 using int_act_2
-    phy_struct->td_fb_int_2[0] = 127;
-    conv_encode_soft(phy_struct,
-                     phy_struct->td_int_act_2,
-                     N_branch_bits-4,
-                     3,
-                     1,
-                     &g_1,
-                     false,
-                     &phy_struct->td_fb_int_2[1],
-                     &N_bits);
-
-    // Step 10: Calculate int_calc_1 using int_act_1 and fb_int_1
-    for(i=0; i<N_branch_bits-4; i++)
-    {
-        if(phy_struct->td_int_act_1[i] >= 0 &&
-           phy_struct->td_fb_int_1[i]  >= 0)
-        {
-            phy_struct->td_int_calc_1[i] = (phy_struct->td_int_act_1[i] +
-                                            phy_struct->td_fb_int_1[i]) >> 1;
-        }else if(phy_struct->td_int_act_1[i] < 0 &&
-                 phy_struct->td_fb_int_1[i]  < 0){
-            phy_struct->td_int_calc_1[i] = (-phy_struct->td_int_act_1[i] -
-                                            phy_struct->td_fb_int_1[i]) >> 1;
-        }else if(phy_struct->td_int_act_1[i] >= 0 &&
-                 phy_struct->td_fb_int_1[i]  <  0){
-            phy_struct->td_int_calc_1[i] = -((phy_struct->td_in_act_1[i] -
-                                              phy_struct->td_fb_int_1[i]) >> 1);
-        }else{
-            phy_struct->td_int_calc_1[i] = -((-phy_struct->td_in_act_1[i] +
-                                              phy_struct->td_fb_int_1[i]) >> 1);
+            fb               = u ^ ((s >> 1) & 1) ^ (s & 1);
+            next_state[s][u] = (fb << 2) | (s >> 1);
+            out_z[s][u]      = fb ^ ((s >> 2) & 1) ^ (s & 1);
         }
     }
 
-    // Step 11: Calculate int_calc_2 using int_act_2 and fb_int_2
-    for(i=0; i<N_branch_bits-4; i++)
+    // Backward recursion, starting from the terminated state
+    for(s=0; s<8; s++)
+    {
+        phy_struct->td_beta[K+3][s] = -1000000;
+    }
+    phy_struct->td_beta[K+3][0] = 0;
+    for(k=K+3; k>0; k--)
     {
-        if(phy_struct->td_int_act_2[i] >= 0 &&
-           phy_struct->td_fb_int_2[i]  >= 0)
+        i = k - 1;
+        if(i >= K)
         {
-            phy_struct->td_int_calc_2[i] = (phy_struct->td_int_act_2[i] +
-                                            phy_struct->td_fb_int_2[i]) >> 1;
-        }else if(phy_struct->td_int_act_2[i] < 0 &&
-                 phy_struct->td_fb_int_2[i]  < 0){
-            phy_struct->td_int_calc_2[i] = (-phy_struct->td_int_act_2[i] -
-                                            phy_struct->td_fb_int_2[i]) >> 1;
-        }else if(phy_struct->td_int_act_2[i] >= 0 &&
-                 phy_struct->td_fb_int_2[i]  <  0){
-            phy_struct->td_int_calc_2[i] = -((phy_struct->td_int_act_2[i] -
-                                              phy_struct->td_fb_int_2[i]) >> 1);
+            // The tail input cancels the feedback
+            g_u = tail_x[i-K]/2;
+            g_z = tail_z[i-K]/2;
+            for(s=0; s<8; s++)
+            {
+                u                         = ((s >> 1) ^ s) & 1;
+                phy_struct->td_beta[i][s] = ((1-2*(int32)u)*g_u                    +
+                                             (1-2*(int32)out_z[s][u])*g_z          +
+                                             phy_struct->td_beta[k][next_state[s][u]]);
+            }
         }else{
-            phy_struct->td_int_calc_2[i] = -((-phy_struct->td_int_act_2[i] -
-                                              phy_struct->td_fb_int_2[i]) >> 1);
+            g_u = (sys[i] + apriori[i])/2;
+            g_z = par[i]/2;
+            for(s=0; s<8; s++)
+            {
+                metric[0] = ( g_u + (1-2*(int32)out_z[s][0])*g_z +
+                             phy_struct->td_beta[k][next_state[s][0]]);
+                metric[1] = (-g_u + (1-2*(int32)out_z[s][1])*g_z +
+                             phy_struct->td_beta[k][next_state[s][1]]);
+                if(metric[0] > metric[1])
+                {
+                    phy_struct->td_beta[i][s] = metric[0];
+                }else{
+                    phy_struct->td_beta[i][s] = metric[1];
+                }
+            }
+        }
+        norm = phy_struct->td_beta[i][0];
+        for(s=0; s<8; s++)
+        {
+            phy_struct->td_beta[i][s] -= norm;
         }
     }
 
-    // Step 12: Calculate in_calc_2 using int_calc_1
-    turbo_internal_deinterleaver(phy_struct->td_int_calc_1,
-                                 N_branch_bits-4,
-                                 phy_struct->td_in_calc_2);
-
-    // Step 13: Calculate in_calc_3 using int_calc_2
-    turbo_internal_deinterleaver(phy_struct->td_int_calc_2,
-                                 N_branch_bits-4,
-                                 phy_struct->td_in_calc_3);
-
-    // Step 14: Soft combine d0, in_calc_1, in_calc_2, and in_calc_3 to get output
-    for(i=0; i<N_branch_bits-4; i++)
+    // Forward recursion, combined with the LLR of each input bit
+    for(s=0; s<8; s++)
+    {
+        alpha[s] = -1000000;
+    }
+    alpha[0] = 0;
+    for(i=0; i<K; i++)
     {
-        tmp_s_bit = ((int8)(d_bits[i*3+0]*127/max_value) +
-                     phy_struct->td_in_calc_1[i]         +
-                     phy_struct->td_in_calc_2[i]         +
-                     phy_struct->td_in_calc_3[i]);
-        if(tmp_s_bit >= 0)
+        g_u       = (sys[i] + apriori[i])/2;
+        g_z       = par[i]/2;
+        metric[0] = -1000000000;
+        metric[1] = -1000000000;
+        for(s=0; s<8; s++)
         {
-            c_bits[i] = 0;
-        }else{
-            c_bits[i] = 1;
+            next_alpha[s] = -1000000000;
+        }
+        for(s=0; s<8; s++)
+        {
+            for(u=0; u<2; u++)
+            {
+                tmp = alpha[s] + (1-2*(int32)u)*g_u + (1-2*(int32)out_z[s][u])*g_z;
+                if(tmp > next_alpha[next_state[s][u]])
+                {
+                    next_alpha[next_state[s][u]] = tmp;
+                }
+                tmp += phy_struct->td_beta[i+1][next_state[s][u]];
+                if(tmp > metric[u])
+                {
+                    metric[u] = tmp;
+                }
+            }
+        }
+        llr[i] = metric[0] - metric[1];
+        norm   = next_alpha[0];
+        for(s=0; s<8; s++)
+        {
+            alpha[s] = next_alpha[s] - norm;
         }
     }
 }
@@ -10315,78 +12922,36 @@ void turbo_internal_interleaver(uint8  *in_bits,
                                 uint32  N_in_bits,
                                 uint8  *out_bits)
 {
-    uint32 i;
-    uint32 f1 = 0;
-    uint32 f2 = 0;
-    uint32 idx;
-
-    // Determine f1 and f2
-    for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-    {
-        if(N_in_bits == TURBO_INT_K_TABLE[i])
-        {
-            f1 = TURBO_INT_F1_TABLE[i];
-            f2 = TURBO_INT_F2_TABLE[i];
-            break;
-        }
-    }
+    uint16 *perm = &TURBO_INT_PERM[TURBO_INT_PERM_OFFSET[TURBO_INT_K_IDX[N_in_bits/8]]];
+    uint32  i;
 
     for(i=0; i<N_in_bits; i++)
     {
-        idx         = (f1*i + f2*i*i) % N_in_bits;
-        out_bits[i] = in_bits[idx];
+        out_bits[i] = in_bits[perm[i]];
     }
 }
 void turbo_internal_interleaver(int8   *in_bits,
                                 uint32  N_in_bits,
                                 int8   *out_bits)
 {
-    uint32 i;
-    uint32 f1 = 0;
-    uint32 f2 = 0;
-    uint32 idx;
-
-    // Determine f1 and f2
-    for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-    {
-        if(N_in_bits == TURBO_INT_K_TABLE[i])
-        {
-            f1 = TURBO_INT_F1_TABLE[i];
-            f2 = TURBO_INT_F2_TABLE[i];
-            break;
-        }
-    }
+    uint16 *perm = &TURBO_INT_PERM[TURBO_INT_PERM_OFFSET[TURBO_INT_K_IDX[N_in_bits/8]]];
+    uint32  i;
 
     for(i=0; i<N_in_bits; i++)
     {
-        idx         = (f1*i + f2*i*i) % N_in_bits;
-        out_bits[i] = in_bits[idx];
+        out_bits[i] = in_bits[perm[i]];
     }
 }
 void turbo_internal_interleaver(float  *in_bits,
                                 uint32  N_in_bits,
                                 float  *out_bits)
 {
-    uint32 i;
-    uint32 f1 = 0;
-    uint32 f2 = 0;
-    uint32 idx;
-
-    // Determine f1 and f2
-    for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-    {
-        if(N_in_bits == TURBO_INT_K_TABLE[i])
-        {
-            f1 = TURBO_INT_F1_TABLE[i];
-            f2 = TURBO_INT_F2_TABLE[i];
-            break;
-        }
-    }
+    uint16 *perm = &TURBO_INT_PERM[TURBO_INT_PERM_OFFSET[TURBO_INT_K_IDX[N_in_bits/8]]];
+    uint32  i;
 
     for(i=0; i<N_in_bits; i++)
     {
-        idx         = (f1*i + f2*i*i) % N_in_bits;
-        out_bits[i] = in_bits[idx];
+        out_bits[i] = in_bits[perm[i]];
     }
 }
 
@@ -10402,52 +12967,24 @@ void turbo_internal_deinterleaver(float  *in_bits,
                                   uint32  N_in_bits,
                                   float  *out_bits)
 {
-    uint32 i;
-    uint32 f1 = 0;
-    uint32 f2 = 0;
-    uint32 idx;
-
-    // Determine f1 and f2
-    for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-    {
-        if(N_in_bits == TURBO_INT_K_TABLE[i])
-        {
-            f1 = TURBO_INT_F1_TABLE[i];
-            f2 = TURBO_INT_F2_TABLE[i];
-            break;
-        }
-    }
+    uint16 *perm = &TURBO_INT_PERM[TURBO_INT_PERM_OFFSET[TURBO_INT_K_IDX[N_in_bits/8]]];
+    uint32  i;
 
     for(i=0; i<N_in_bits; i++)
     {
-        idx           = (f1*i + f2*i*i) % N_in_bits;
-        out_bits[idx] = in_bits[i];
+        out_bits[perm[i]] = in_bits[i];
     }
 }
 void turbo_internal_deinterleaver(int8   *in_bits,
                                   uint32  N_in_bits,
                                   int8   *out_bits)
 {
-    uint32 i;
-    uint32 f1 = 0;
-    uint32 f2 = 0;
-    uint32 idx;
-
-    // Determine f1 and f2
-    for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-    {
-        if(N_in_bits == TURBO_INT_K_TABLE[i])
-        {
-            f1 = TURBO_INT_F1_TABLE[i];
-            f2 = TURBO_INT_F2_TABLE[i];
-            break;
-        }
-    }
+    uint16 *perm = &TURBO_INT_PERM[TURBO_INT_PERM_OFFSET[TURBO_INT_K_IDX[N_in_bits/8]]];
+    uint32  i;
 
     for(i=0; i<N_in_bits; i++)
     {
-        idx           = (f1*i + f2*i*i) % N_in_bits;
-        out_bits[idx] = in_bits[i];
+        out_bits[perm[i]] = in_bits[i];
     }
 }
 
@@ -10683,7 +13220,12 @@ void rate_unmatch_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
         d_idx = 0;
         for(i=N_dummy; i<C_tc_sb*R_tc_sb; i++)
         {
-            phy_struct->rut_tmp[i] = dummy_bits[d_idx*3+x];
+            if(TX_NULL_BIT == dummy_bits[N_dummy_bits*x+d_idx])
+            {
+                phy_struct->rut_tmp[i] = RX_NULL_BIT;
+            }else{
+                phy_struct->rut_tmp[i] = 0;
+            }
             d_idx++;
         }
         idx = 0;
@@ -10869,6 +13411,82 @@ void rate_unmatch_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
     *N_d_bits = d_idx*3;
 }
 
+/*********************************************************************
+    Name: soft_buffer_combine
+
+    Description: Combines the rate unmatched LLRs of a code block with
+                 the LLRs stored in a HARQ soft buffer
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1.2
+
+    Notes: The combined LLRs are written back to d_bits
+*********************************************************************/
+void soft_buffer_combine(LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer,
+                         uint32                         cb,
+                         float                         *d_bits,
+                         uint32                         N_d_bits)
+{
+    int8   *llr;
+    float   max_value = 0;
+    float   scale;
+    uint32  i;
+    uint32  idx;
+    int32   sum;
+
+    if(soft_buffer->pool == NULL ||
+       cb                >= soft_buffer->N_codeblocks)
+    {
+        return;
+    }
+    if(N_d_bits > soft_buffer->N_llr[cb])
+    {
+        N_d_bits = soft_buffer->N_llr[cb];
+    }
+
+    // The quantization step is fixed by the first transmission, which
+    // is scaled to a quarter of the int8 range to leave headroom for
+    // three more transmissions
+    if(soft_buffer->scale[cb] == 0)
+    {
+        for(i=0; i<N_d_bits; i++)
+        {
+            if(RX_NULL_BIT != d_bits[i] &&
+               fabs(d_bits[i]) > max_value)
+            {
+                max_value = fabs(d_bits[i]);
+            }
+        }
+        if(max_value == 0)
+        {
+            return;
+        }
+        soft_buffer->scale[cb] = 32/max_value;
+    }
+    scale = soft_buffer->scale[cb];
+
+    // Combine, bits that were not transmitted do not change the stored
+    // LLR and bits that were never transmitted are left at 0
+    idx = soft_buffer->cb_offset[cb];
+    for(i=0; i<N_d_bits; i++)
+    {
+        llr = &soft_buffer->pool->llr[soft_buffer->chunk[idx/LIBLTE_PHY_SOFT_BUFFER_CHUNK_LEN]*LIBLTE_PHY_SOFT_BUFFER_CHUNK_LEN +
+                                      idx%LIBLTE_PHY_SOFT_BUFFER_CHUNK_LEN];
+        if(RX_NULL_BIT != d_bits[i])
+        {
+            sum = *llr + (int32)lrintf(d_bits[i]*scale);
+            if(sum > 127)
+            {
+                sum = 127;
+            }else if(sum < -127){
+                sum = -127;
+            }
+            *llr = (int8)sum;
+        }
+        d_bits[i] = (float)*llr/scale;
+        idx++;
+    }
+}
+
 /*********************************************************************
     Name: rate_match_conv
 
@@ -11175,98 +13793,60 @@ void code_block_concatenation(uint8  *e_bits,
 void code_block_deconcatenation(float  *f_bits,
                                 uint32  N_f_bits,
                                 uint32  tbs,
+                                uint32  N_l,
+                                uint32  Q_m,
                                 float  *e_bits,
                                 uint32 *N_e_bits,
                                 uint32  N_e_bits_max,
                                 uint32 *N_codeblocks)
 {
     uint32 Z = 6144;
-    uint32 L;
+    uint32 L = 24;
     uint32 B;
     uint32 C;
-    uint32 F;
-    uint32 B_prime;
-    uint32 K_plus  = 0;
-    uint32 K_minus = 0;
-    uint32 K_delta;
-    uint32 C_plus;
-    uint32 C_minus;
+    uint32 G_prime;
+    uint32 lambda;
     uint32 j;
     uint32 k;
     uint32 r;
-    int32  i;
 
-    // Determine L, C, B', K+, C+, K-, and C-, 3GPP TS 36.212 v10.1.0 section 5.1.2
-    if(tbs <= Z)
+    // Determine C, 3GPP TS 36.212 v10.1.0 section 5.1.2
+    B = tbs + 24;
+    if(B <= Z)
     {
-        L       = 0;
-        C       = 1;
-        B_prime = N_f_bits;
-        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-        {
-            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
-            {
-                K_plus = TURBO_INT_K_TABLE[i];
-                break;
-            }
-        }
-        K_minus = 0;
-        C_plus  = 1;
-        C_minus = 0;
+        C = 1;
     }else{
-        B       = tbs + 24;
-        L       = 24;
-        C       = (uint32)ceilf((float)B/(float)(Z-L));
-        B_prime = B + C*L;
-        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-        {
-            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
-            {
-                K_plus = TURBO_INT_K_TABLE[i];
-                break;
-            }
-        }
-        for(i=TURBO_INT_K_TABLE_SIZE-1; i>=0; i--)
-        {
-            if(TURBO_INT_K_TABLE[i] < K_plus)
-            {
-                K_minus = TURBO_INT_K_TABLE[i];
-                break;
-            }
-        }
-        K_delta = K_plus - K_minus;
-        C_minus = (C*K_plus - B_prime)/K_delta;
-        C_plus  = C - C_minus;
+        C = (uint32)ceilf((float)B/(float)(Z-L));
     }
-    F             = C_plus*K_plus + C_minus*K_minus - B_prime;
     *N_codeblocks = C;
 
-    // Deconcatenate code blocks
-    k = 0;
-    r = 0;
-    while(r < C)
+    // Deconcatenate code blocks, the number of bits in each code block
+    // is determined as in 3GPP TS 36.212 v10.1.0 section 5.1.4.1.2
+    G_prime = N_f_bits/(N_l*Q_m);
+    lambda  = G_prime % C;
+    k       = 0;
+    for(r=0; r<C; r++)
     {
-        // Determine the K for this code block
-        if(r < C_minus)
+        if(r <= (C - lambda - 1))
         {
-            N_e_bits[r] = K_minus;
+            N_e_bits[r] = N_l*Q_m*(G_prime/C);
         }else{
-            N_e_bits[r] = K_plus;
+            N_e_bits[r] = N_l*Q_m*(uint32)ceilf((float)G_prime/(float)C);
         }
-        if(C > 1)
+
+        // Bits beyond N_e_bits_max are dropped
+        for(j=0; j<N_e_bits[r]; j++)
         {
-            N_e_bits[r] += L;
+            if(j < N_e_bits_max)
+            {
+                e_bits[r*N_e_bits_max+j] = f_bits[k];
+            }
+            k++;
         }
-        // FIXME: Not handling filler bits currently
-        N_e_bits[r] -= F;
-
-        j = 0;
-        while(j < N_e_bits[r])
+        if(N_e_bits[r] > N_e_bits_max)
         {
-            e_bits[r*N_e_bits_max+j] = f_bits[k++];
-            j++;
+            N_e_bits[r] = N_e_bits_max;
         }
-        r++;
     }
 }
 
@@ -11629,6 +14209,7 @@ void ulsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
     uint32  cb;
     uint32  N_codeblocks;
     uint32  N_fill_bits;
+    uint32  N_cb_fill_bits;
     uint32  N_d_bits;
     uint32  N_f_bits;
     uint32  N_g_bits;
@@ -11669,11 +14250,19 @@ void ulsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
 
     for(cb=0; cb<N_codeblocks; cb++)
     {
+        // Only the first code block carries filler bits
+        if(0 == cb)
+        {
+            N_cb_fill_bits = N_fill_bits;
+        }else{
+            N_cb_fill_bits = 0;
+        }
+
         // Construct d_bits
         turbo_encode(phy_struct,
                      phy_struct->ulsch_c_bits[cb],
                      phy_struct->ulsch_N_c_bits[cb],
-                     N_fill_bits,
+                     N_cb_fill_bits,
                      phy_struct->ulsch_tx_d_bits,
                      &N_d_bits);
 
@@ -11696,13 +14285,13 @@ void ulsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
                          LIBLTE_PHY_CHAN_TYPE_ULSCH,
                          rv_idx,
                          phy_struct->ulsch_N_e_bits[cb],
-                         phy_struct->ulsch_tx_e_bits[0]);
+                         phy_struct->ulsch_tx_e_bits[cb]);
     }
 
     // Determine f_bits
     code_block_concatenation(phy_struct->ulsch_tx_e_bits[0],
                              phy_struct->ulsch_N_e_bits,
-                             18432,
+                             28800,
                              N_codeblocks,
                              phy_struct->ulsch_tx_f_bits,
                              &N_f_bits);
@@ -11740,16 +14329,17 @@ void ulsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
 
     Notes: Not handling control bits
 *********************************************************************/
-LIBLTE_ERROR_ENUM ulsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                       float             *in_bits,
-                                       uint32             N_in_bits,
-                                       uint32             tbs,
-                                       uint32             tx_mode,
-                                       uint32             N_l,
-                                       uint32             Q_m,
-                                       uint32             rv_idx,
-                                       uint8             *out_bits,
-                                       uint32            *N_out_bits)
+LIBLTE_ERROR_ENUM ulsch_channel_decode(LIBLTE_PHY_STRUCT             *phy_struct,
+                                       float                         *in_bits,
+                                       uint32                         N_in_bits,
+                                       uint32                         tbs,
+                                       uint32                         tx_mode,
+                                       uint32                         N_l,
+                                       uint32                         Q_m,
+                                       uint32                         rv_idx,
+                                       LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer,
+                                       uint8                         *out_bits,
+                                       uint32                        *N_out_bits)
 {
     LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_CRC;
     uint32             i;
@@ -11763,6 +14353,7 @@ LIBLTE_ERROR_ENUM ulsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
     uint32             N_ack_bits = 0;
     uint32             N_cqi_bits = 0;
     uint32             N_fill_bits;
+    uint32             N_cb_fill_bits;
     uint32             N_codeblocks;
     uint8              calc_p_bits[24];
     uint8             *a_bits;
@@ -11807,18 +14398,28 @@ LIBLTE_ERROR_ENUM ulsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
     code_block_deconcatenation(phy_struct->ulsch_rx_f_bits,
                                N_f_bits,
                                tbs,
+                               N_l,
+                               Q_m,
                                phy_struct->ulsch_rx_e_bits[0],
                                phy_struct->ulsch_N_e_bits,
-                               18432,
+                               28800,
                                &N_codeblocks);
 
     for(cb=0; cb<N_codeblocks; cb++)
     {
+        // Only the first code block carries filler bits
+        if(0 == cb)
+        {
+            N_cb_fill_bits = N_fill_bits;
+        }else{
+            N_cb_fill_bits = 0;
+        }
+
         // Construct dummy_d_bits
         turbo_encode(phy_struct,
                      phy_struct->ulsch_c_bits[cb],
                      phy_struct->ulsch_N_c_bits[cb],
-                     N_fill_bits,
+                     N_cb_fill_bits,
                      phy_struct->ulsch_tx_d_bits,
                      &N_d_bits);
 
@@ -11837,14 +14438,27 @@ LIBLTE_ERROR_ENUM ulsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
                            phy_struct->ulsch_rx_d_bits,
                            &N_d_bits);
 
+        // Combine with earlier transmissions
+        if(soft_buffer != NULL)
+        {
+            soft_buffer_combine(soft_buffer,
+                                cb,
+                                phy_struct->ulsch_rx_d_bits,
+                                N_d_bits);
+        }
+
         // Determine c_bits
         turbo_decode(phy_struct,
                      phy_struct->ulsch_rx_d_bits,
                      N_d_bits,
-                     N_fill_bits,
+                     N_cb_fill_bits,
                      phy_struct->ulsch_c_bits[cb],
                      &phy_struct->ulsch_N_c_bits[cb]);
     }
+    if(soft_buffer != NULL)
+    {
+        soft_buffer->N_tx++;
+    }
 
     // Determine b_bits
     code_block_desegmentation(phy_struct->ulsch_c_bits[0],
@@ -12062,6 +14676,7 @@ void dlsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
     uint32  cb;
     uint32  N_codeblocks;
     uint32  N_fill_bits;
+    uint32  N_cb_fill_bits;
     uint32  N_d_bits;
     uint32  G_prime;
     uint32  lambda;
@@ -12097,11 +14712,19 @@ void dlsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
 
     for(cb=0; cb<N_codeblocks; cb++)
     {
+        // Only the first code block carries filler bits
+        if(0 == cb)
+        {
+            N_cb_fill_bits = N_fill_bits;
+        }else{
+            N_cb_fill_bits = 0;
+        }
+
         // Construct d_bits
         turbo_encode(phy_struct,
                      phy_struct->dlsch_c_bits[cb],
                      phy_struct->dlsch_N_c_bits[cb],
-                     N_fill_bits,
+                     N_cb_fill_bits,
                      phy_struct->dlsch_tx_d_bits,
                      &N_d_bits);
 
@@ -12124,12 +14747,12 @@ void dlsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
                          LIBLTE_PHY_CHAN_TYPE_DLSCH,
                          rv_idx,
                          phy_struct->dlsch_N_e_bits[cb],
-                         phy_struct->dlsch_tx_e_bits[0]);
+                         phy_struct->dlsch_tx_e_bits[cb]);
     }
 
     code_block_concatenation(phy_struct->dlsch_tx_e_bits[0],
                              phy_struct->dlsch_N_e_bits,
-                             18432,
+                             LIBLTE_PHY_N_ANT_MAX*10000,
                              N_codeblocks,
                              out_bits,
                              N_out_bits);
@@ -12142,16 +14765,19 @@ void dlsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
 
     Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.2
 *********************************************************************/
-LIBLTE_ERROR_ENUM dlsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                       float             *in_bits,
-                                       uint32             N_in_bits,
-                                       uint32             tbs,
-                                       uint32             tx_mode,
-                                       uint32             rv_idx,
-                                       uint32             M_dl_harq,
-                                       uint32             N_soft,
-                                       uint8             *out_bits,
-                                       uint32            *N_out_bits)
+LIBLTE_ERROR_ENUM dlsch_channel_decode(LIBLTE_PHY_STRUCT             *phy_struct,
+                                       float                         *in_bits,
+                                       uint32                         N_in_bits,
+                                       uint32                         tbs,
+                                       uint32                         tx_mode,
+                                       uint32                         rv_idx,
+                                       uint32                         N_l,
+                                       uint32                         Q_m,
+                                       uint32                         M_dl_harq,
+                                       uint32                         N_soft,
+                                       LIBLTE_PHY_SOFT_BUFFER_STRUCT *soft_buffer,
+                                       uint8                         *out_bits,
+                                       uint32                        *N_out_bits)
 {
     LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_CRC;
     uint32             i;
@@ -12160,6 +14786,7 @@ LIBLTE_ERROR_ENUM dlsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
     uint32             N_b_bits;
     uint32             N_d_bits;
     uint32             N_fill_bits;
+    uint32             N_cb_fill_bits;
     uint32             N_codeblocks;
     uint8              calc_p_bits[24];
     uint8             *a_bits;
@@ -12181,18 +14808,28 @@ LIBLTE_ERROR_ENUM dlsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
     code_block_deconcatenation(in_bits,
                                N_in_bits,
                                tbs,
+                               N_l,
+                               Q_m,
                                phy_struct->dlsch_rx_e_bits[0],
                                phy_struct->dlsch_N_e_bits,
-                               18432,
+                               LIBLTE_PHY_N_ANT_MAX*10000,
                                &N_codeblocks);
 
     for(cb=0; cb<N_codeblocks; cb++)
     {
+        // Only the first code block carries filler bits
+        if(0 == cb)
+        {
+            N_cb_fill_bits = N_fill_bits;
+        }else{
+            N_cb_fill_bits = 0;
+        }
+
         // Construct dummy_d_bits
         turbo_encode(phy_struct,
                      phy_struct->dlsch_c_bits[cb],
                      phy_struct->dlsch_N_c_bits[cb],
-                     N_fill_bits,
+                     N_cb_fill_bits,
                      phy_struct->dlsch_tx_d_bits,
                      &N_d_bits);
 
@@ -12211,14 +14848,27 @@ LIBLTE_ERROR_ENUM dlsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
                            phy_struct->dlsch_rx_d_bits,
                            &N_d_bits);
 
+        // Combine with earlier transmissions
+        if(soft_buffer != NULL)
+        {
+            soft_buffer_combine(soft_buffer,
+                                cb,
+                                phy_struct->dlsch_rx_d_bits,
+                                N_d_bits);
+        }
+
         // Determine c_bits
         turbo_decode(phy_struct,
                      phy_struct->dlsch_rx_d_bits,
                      N_d_bits,
-                     N_fill_bits,
+                     N_cb_fill_bits,
                      phy_struct->dlsch_c_bits[cb],
                      &phy_struct->dlsch_N_c_bits[cb]);
     }
+    if(soft_buffer != NULL)
+    {
+        soft_buffer->N_tx++;
+    }
 
     // Determine b_bits
     code_block_desegmentation(phy_struct->dlsch_c_bits[0],
@@ -12342,19 +14992,56 @@ LIBLTE_ERROR_ENUM dci_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
                                      uint32             N_out_bits,
                                      uint16            *rnti_found)
 {
-    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_CRC;
-    uint32             i;
-    uint32             j;
-    uint32             N_d_bits;
-    uint32             N_c_bits;
-    uint32             ber;
-    uint32             g[3] = {0133, 0171, 0165}; // Numbers are in octal
-    uint16             rnti;
-    uint8              x_rnti_bits[16];
-    uint8              x_as_bits[16];
-    uint8             *a_bits;
-    uint8             *p_bits;
-    uint8              calc_p_bits[16];
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_CRC;
+    uint16            rnti;
+
+    dci_channel_decode_masked_rnti(phy_struct,
+                                   in_bits,
+                                   N_in_bits,
+                                   ue_ant,
+                                   out_bits,
+                                   N_out_bits,
+                                   &rnti);
+
+    // Check CRC
+    if((uint16)(rnti - rnti_start) < rnti_range)
+    {
+        *rnti_found = rnti;
+        err         = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: dci_channel_decode_masked_rnti
+
+    Description: Channel decodes the Downlink Control Information
+                 channel and recovers the RNTI that the CRC was
+                 masked with
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
+
+    Notes: Checking the recovered RNTI against a set of RNTIs is
+           equivalent to checking the CRC once for each of them,
+           while only decoding the DCI once
+*********************************************************************/
+void dci_channel_decode_masked_rnti(LIBLTE_PHY_STRUCT *phy_struct,
+                                    float             *in_bits,
+                                    uint32             N_in_bits,
+                                    uint8              ue_ant,
+                                    uint8             *out_bits,
+                                    uint32             N_out_bits,
+                                    uint16            *masked_rnti)
+{
+    uint32  i;
+    uint32  N_d_bits;
+    uint32  N_c_bits;
+    uint32  g[3] = {0133, 0171, 0165}; // Numbers are in octal
+    uint8   x_as_bits[16];
+    uint8  *a_bits;
+    uint8  *p_bits;
+    uint8   calc_p_bits[16];
 
     // Construct UE antenna mask
     memset(x_as_bits, 0, sizeof(uint8)*16);
@@ -12388,37 +15075,97 @@ LIBLTE_ERROR_ENUM dci_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
     // Calculate p_bits
     calc_crc(a_bits, N_out_bits, CRC16, calc_p_bits, 16);
 
-    for(j=0; j<rnti_range; j++)
+    // Recover the RNTI from the CRC mask
+    *masked_rnti = 0;
+    for(i=0; i<16; i++)
     {
-        // Convert RNTI to bit array
-        for(i=0; i<16; i++)
-        {
-            rnti           = rnti_start + j;
-            x_rnti_bits[i] = (rnti >> (15-i)) & 1;
-        }
+        *masked_rnti |= (p_bits[i] ^ calc_p_bits[i] ^ x_as_bits[i]) << (15-i);
+    }
+    for(i=0; i<N_out_bits; i++)
+    {
+        out_bits[i] = a_bits[i];
+    }
+}
+
+/*********************************************************************
+    Name: dci_channel_decode_batch
+
+    Description: Channel decodes a batch of PDCCH candidates for the
+                 same Downlink Control Information size and recovers
+                 the RNTI that each CRC was masked with
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
+
+    Notes: Candidate n is read from pdcch_cand_bits[slot[n]] and is
+           rate unmatched, Viterbi decoded, and CRC checked in its own
+           scratch buffers, with the Viterbi decode of the whole
+           batch done together by viterbi_decode_batch
+*********************************************************************/
+void dci_channel_decode_batch(LIBLTE_PHY_STRUCT *phy_struct,
+                              uint32            *slot,
+                              uint32            *N_in_bits,
+                              uint32             N_cand,
+                              uint8              ue_ant,
+                              uint8            (*out_bits)[LIBLTE_PHY_DCI_N_BITS_MAX],
+                              uint32             N_out_bits,
+                              uint16            *masked_rnti)
+{
+    uint32  i;
+    uint32  n;
+    uint32  N_d_bits = 0;
+    uint32  N_c_bits;
+    uint32  g[3] = {0133, 0171, 0165}; // Numbers are in octal
+    uint8   x_as_bits[16];
+    uint8  *a_bits;
+    uint8  *p_bits;
+
+    // Construct UE antenna mask
+    memset(x_as_bits, 0, sizeof(uint8)*16);
+    if(ue_ant == 1)
+    {
+        x_as_bits[15] = 1;
+    }
+
+    // Rate unmatch each candidate to get its d_bits
+    for(n=0; n<N_cand; n++)
+    {
+        rate_unmatch_conv(phy_struct,
+                          phy_struct->pdcch_cand_bits[slot[n]],
+                          N_in_bits[slot[n]],
+                          N_out_bits+16,
+                          phy_struct->vdb_d_bits[n],
+                          &N_d_bits);
+    }
 
-        // Check CRC
-        ber = 0;
+    // Viterbi decode the d_bits of all candidates to get the c_bits
+    viterbi_decode_batch(phy_struct,
+                         N_cand,
+                         N_d_bits,
+                         7,
+                         3,
+                         g,
+                         &N_c_bits);
+
+    for(n=0; n<N_cand; n++)
+    {
+        // Recover a_bits and p_bits
+        a_bits = &phy_struct->vdb_c_bits[n][0];
+        p_bits = &phy_struct->vdb_c_bits[n][N_out_bits];
+
+        // Calculate p_bits
+        calc_crc(a_bits, N_out_bits, CRC16, phy_struct->dci_calc_p_bits[n], 16);
+
+        // Recover the RNTI from the CRC mask
+        masked_rnti[n] = 0;
         for(i=0; i<16; i++)
         {
-            ber += p_bits[i] ^ (calc_p_bits[i] ^ x_rnti_bits[i] ^ x_as_bits[i]);
-        }
-        if(ber == 0)
-        {
-            for(i=0; i<N_out_bits; i++)
-            {
-                out_bits[i] = a_bits[i];
-            }
-            err = LIBLTE_SUCCESS;
+            masked_rnti[n] |= (p_bits[i] ^ phy_struct->dci_calc_p_bits[n][i] ^ x_as_bits[i]) << (15-i);
         }
-        if(LIBLTE_SUCCESS == err)
+        for(i=0; i<N_out_bits; i++)
         {
-            *rnti_found = rnti;
-            break;
+            out_bits[n][i] = a_bits[i];
         }
     }
-
-    return(err);
 }
 
 /*********************************************************************
@@ -12517,9 +15264,96 @@ void dci_0_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
                         3GPP TS 36.213 v10.3.0 section 8.1.1
                         3GPP TS 36.213 v10.3.0 section 8.6
 
-    Notes: N/A
+    Notes: Currently only handles non-hopping single-cluster
+           assignments
 *********************************************************************/
-// FIXME
+void dci_0_unpack(uint8                           *in_bits,
+                  uint32                           N_in_bits,
+                  LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
+                  uint16                           rnti,
+                  uint32                           N_rb_ul,
+                  uint8                            N_ant,
+                  LIBLTE_PHY_ALLOCATION_STRUCT    *alloc)
+{
+    uint32  RB_start;
+    uint32  RIV;
+    uint32  RIV_length;
+    uint32  I_tbs;
+    uint32  i;
+    uint32  dci_0_1a_flag;
+    uint32  hopping;
+    uint8  *dci = in_bits;
+
+    // Carrier indicator
+    if(LIBLTE_PHY_DCI_CA_PRESENT == ca_presence)
+    {
+        liblte_bits_2_value(&dci, 3);
+        printf("WARNING: Not handling carrier indicator\n");
+    }
+
+    // Check DCI 0/1A flag 3GPP TS 36.212 v10.1.0 section 5.3.3.1.1
+    dci_0_1a_flag = liblte_bits_2_value(&dci, 1);
+    if(DCI_0_1A_FLAG_1A == dci_0_1a_flag)
+    {
+        printf("ERROR: DCI 0 flagged as DCI 1A\n");
+        return;
+    }
+
+    // Frequency hopping flag
+    hopping = liblte_bits_2_value(&dci, 1);
+    if(1 == hopping)
+    {
+        // FIXME: Only supporting non-hopping single-cluster
+        printf("WARNING: Not handling frequency hopping\n");
+    }
+
+    // Find the RIV that was sent 3GPP TS 36.213 v10.3.0 section 8.1.1
+    RIV_length   = (uint32)ceilf(logf(N_rb_ul*(N_rb_ul+1)/2)/logf(2));
+    RIV          = liblte_bits_2_value(&dci, RIV_length);
+    alloc->N_prb = RIV/N_rb_ul + 1;
+    RB_start     = RIV % N_rb_ul;
+    if((RB_start + alloc->N_prb) > N_rb_ul)
+    {
+        alloc->N_prb = N_rb_ul - alloc->N_prb + 2;
+        RB_start     = N_rb_ul - 1 - RB_start;
+    }
+    for(i=0; i<alloc->N_prb; i++)
+    {
+        alloc->prb[0][i] = RB_start + i;
+        alloc->prb[1][i] = RB_start + i;
+    }
+
+    // Extract the rest of the fields, the cyclic shift and CSI request
+    // are not used
+    alloc->mcs = liblte_bits_2_value(&dci, 5);
+    alloc->ndi = liblte_bits_2_value(&dci, 1);
+    alloc->tpc = liblte_bits_2_value(&dci, 2);
+
+    // Fill in the allocation structure 3GPP TS 36.213 v10.3.0 section 8.6
+    alloc->chan_type   = LIBLTE_PHY_CHAN_TYPE_ULSCH;
+    alloc->N_codewords = 1;
+    alloc->N_layers    = 1;
+    alloc->tx_mode     = 1;
+    alloc->rnti        = rnti;
+    alloc->rv_idx      = 0;
+    if(10 >= alloc->mcs)
+    {
+        alloc->mod_type = LIBLTE_PHY_MODULATION_TYPE_QPSK;
+        I_tbs           = alloc->mcs;
+    }else if(20 >= alloc->mcs){
+        alloc->mod_type = LIBLTE_PHY_MODULATION_TYPE_16QAM;
+        I_tbs           = alloc->mcs - 1;
+    }else if(28 >= alloc->mcs){
+        alloc->mod_type = LIBLTE_PHY_MODULATION_TYPE_64QAM;
+        I_tbs           = alloc->mcs - 2;
+    }else{
+        // Retransmissions keep the modulation and TBS of the initial transmission
+        alloc->rv_idx = alloc->mcs - 28;
+        alloc->tbs    = 0;
+        return;
+    }
+    alloc->tbs = TBS_71721[I_tbs][alloc->N_prb-1];
+}
 
 /*********************************************************************
     Name: dci_1a_pack
@@ -12606,7 +15440,7 @@ void dci_1a_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
         liblte_value_2_bits(alloc->mcs, &dci, 5);
 
         // HARQ process number, FIXME: FDD only
-        liblte_value_2_bits(0, &dci, 3);
+        liblte_value_2_bits(alloc->harq_process, &dci, 3);
 
         // New data indicator
         liblte_value_2_bits(alloc->ndi, &dci, 1);
@@ -12650,8 +15484,7 @@ void dci_1a_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
                         3GPP TS 36.213 v10.3.0 section 7.1.6.3
                         3GPP TS 36.213 v10.3.0 section 7.1.7
 
-    Notes: Currently only handles SI-RNTI, P-RNTI, or RA-RNTI and
-           localized virtual resource blocks
+    Notes: Currently only handles localized virtual resource blocks
 *********************************************************************/
 void dci_1a_unpack(uint8                           *in_bits,
                    uint32                           N_in_bits,
@@ -12740,11 +15573,72 @@ void dci_1a_unpack(uint8                           *in_bits,
         }else{
             alloc->tx_mode = 2;
         }
+        alloc->chan_type   = LIBLTE_PHY_CHAN_TYPE_DLSCH;
         alloc->N_codewords = 1;
         alloc->tbs         = TBS_71721[alloc->mcs][N_prb_1a-1];
         alloc->rnti        = rnti;
     }else{
-        printf("ERROR: Not handling DCI 1As for C-RNTI\n");
+        // Determine if RIV uses local or distributed VRBs
+        loc_or_dist = liblte_bits_2_value(&dci, 1);
+
+        // Find the RIV that was sent 3GPP TS 36.213 v10.3.0 section 7.1.6.3
+        RIV_length   = (uint32)ceilf(logf(N_rb_dl*(N_rb_dl+1)/2)/logf(2));
+        RIV          = liblte_bits_2_value(&dci, RIV_length);
+        alloc->N_prb = RIV/N_rb_dl + 1;
+        RB_start     = RIV % N_rb_dl;
+        if((RB_start + alloc->N_prb) > N_rb_dl)
+        {
+            alloc->N_prb = N_rb_dl - alloc->N_prb + 2;
+            RB_start     = N_rb_dl - 1 - RB_start;
+        }
+
+        // Extract the rest of the fields
+        alloc->mcs          = liblte_bits_2_value(&dci, 5);
+        alloc->harq_process = liblte_bits_2_value(&dci, 3);
+        alloc->ndi          = liblte_bits_2_value(&dci, 1);
+        alloc->rv_idx       = liblte_bits_2_value(&dci, 2);
+        alloc->tpc          = liblte_bits_2_value(&dci, 2);
+
+        // Parse the data
+        if(DCI_VRB_TYPE_DISTRIBUTED == loc_or_dist)
+        {
+            // FIXME: Figure out gapping
+            // FIXME: Convert to localized blocks
+        }else{
+            // Convert allocation into array of prbs
+            for(i=0; i<alloc->N_prb; i++)
+            {
+                alloc->prb[0][i] = RB_start + i;
+                alloc->prb[1][i] = RB_start + i;
+            }
+        }
+
+        // Fill in the allocation structure 3GPP TS 36.213 v10.3.0 section 7.1.7
+        if(9 >= alloc->mcs)
+        {
+            alloc->mod_type = LIBLTE_PHY_MODULATION_TYPE_QPSK;
+        }else if(16 >= alloc->mcs){
+            alloc->mod_type = LIBLTE_PHY_MODULATION_TYPE_16QAM;
+        }else{
+            alloc->mod_type = LIBLTE_PHY_MODULATION_TYPE_64QAM;
+        }
+        alloc->pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
+        if(N_ant == 1)
+        {
+            alloc->tx_mode = 1;
+        }else{
+            alloc->tx_mode = 2;
+        }
+        alloc->chan_type   = LIBLTE_PHY_CHAN_TYPE_DLSCH;
+        alloc->N_codewords = 1;
+        alloc->rnti        = rnti;
+        if(alloc->mcs < 27)
+        {
+            alloc->tbs = TBS_71721[alloc->mcs][alloc->N_prb-1];
+        }else{
+            // FIXME: Retransmissions reuse the TBS of the initial transmission
+            alloc->tbs = 0;
+        }
     }
 }
 
@@ -12964,6 +15858,7 @@ void dci_1c_unpack(uint8                        *in_bits,
         }else{
             alloc->tx_mode = 2;
         }
+        alloc->chan_type   = LIBLTE_PHY_CHAN_TYPE_DLSCH;
         alloc->N_codewords = 1;
         alloc->tbs         = TBS_71723[alloc->mcs];
         alloc->rnti        = rnti;
@@ -13073,6 +15968,73 @@ LIBLTE_ERROR_ENUM cfi_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
     return(err);
 }
 
+/*********************************************************************
+    Name: cqi_channel_encode
+
+    Description: Channel encodes channel quality information for
+                 PUCCH format 2
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.3.3
+*********************************************************************/
+void cqi_channel_encode(uint8  *in_bits,
+                        uint32  N_in_bits,
+                        uint8  *out_bits)
+{
+    uint32 i;
+    uint32 n;
+
+    for(i=0; i<LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS; i++)
+    {
+        out_bits[i] = 0;
+        for(n=0; n<N_in_bits; n++)
+        {
+            out_bits[i] ^= in_bits[n] & CQI_M_5_2_3_3_1[i][n];
+        }
+    }
+}
+
+/*********************************************************************
+    Name: cqi_channel_decode
+
+    Description: Channel decodes channel quality information for
+                 PUCCH format 2
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.3.3
+
+    Notes: Maximum likelihood decode, correlating the soft bits
+           against all 2^N_out_bits pre-computed codewords
+*********************************************************************/
+void cqi_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                        float             *in_bits,
+                        uint32             N_out_bits,
+                        uint8             *out_bits)
+{
+    float  corr;
+    float  max_corr = -1e30;
+    uint32 max_msg  = 0;
+    uint32 msg;
+    uint32 i;
+
+    for(msg=0; msg<(1U << N_out_bits); msg++)
+    {
+        corr = 0;
+        for(i=0; i<LIBLTE_PHY_PUCCH_N_CQI_CODED_BITS; i++)
+        {
+            corr += in_bits[i]*phy_struct->pucch_cqi_cw[msg][i];
+        }
+        if(corr > max_corr)
+        {
+            max_corr = corr;
+            max_msg  = msg;
+        }
+    }
+
+    for(i=0; i<N_out_bits; i++)
+    {
+        out_bits[i] = (max_msg >> i) & 1;
+    }
+}
+
 /*********************************************************************
     Name: get_ul_ce
 
@@ -13378,22 +16340,190 @@ uint32 get_num_bits_in_prb(uint32                          N_subframe,
 }
 
 /*********************************************************************
-    Name: wrap_phase
+    Name: dl_ce_calc_wiener_weights
 
-    Description: Checks the phase difference between two angles and
-                 wraps one to make the difference less than 2*pi.
+    Description: Calculates the frequency domain Wiener interpolation
+                 weights for the downlink channel estimates
 
     Document Reference: N/A
+
+    Notes: Assumes an exponential power delay profile, whose real
+           frequency correlation is 1/(1 + (2*pi*delta_f*tau_rms)^2)
 *********************************************************************/
-inline void wrap_phase(float *phase_1,
-                       float  phase_2)
+void dl_ce_calc_wiener_weights(LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                               float                       noise_to_signal)
 {
-    while((*phase_1 - phase_2) >= M_PI)
+    float  R[LIBLTE_PHY_DL_CE_WIENER_N_TAPS][LIBLTE_PHY_DL_CE_WIENER_N_TAPS+1];
+    float  x;
+    float  scale;
+    uint32 r;
+    uint32 i;
+    uint32 j;
+    uint32 z;
+
+    // Taps are the CRSs at -6, 0, 6, and 12 subcarriers from the CRS
+    // preceding the estimated subcarrier, which is r subcarriers away
+    for(r=0; r<6; r++)
     {
-        *phase_1 = *phase_1 - 2*M_PI;
+        for(i=0; i<LIBLTE_PHY_DL_CE_WIENER_N_TAPS; i++)
+        {
+            for(j=0; j<LIBLTE_PHY_DL_CE_WIENER_N_TAPS; j++)
+            {
+                x       = 2*M_PI*DL_CE_SC_SPACING*DL_CE_WIENER_TAU_RMS*6*((float)i - (float)j);
+                R[i][j] = 1/(1 + x*x);
+            }
+            R[i][i]                              += noise_to_signal;
+            x                                     = 2*M_PI*DL_CE_SC_SPACING*DL_CE_WIENER_TAU_RMS*(6*((float)i - 1) - (float)r);
+            R[i][LIBLTE_PHY_DL_CE_WIENER_N_TAPS]  = 1/(1 + x*x);
+        }
+
+        // Solve with Gauss-Jordan elimination, R is positive definite so no pivoting is needed
+        for(i=0; i<LIBLTE_PHY_DL_CE_WIENER_N_TAPS; i++)
+        {
+            scale = 1/R[i][i];
+            for(j=i; j<LIBLTE_PHY_DL_CE_WIENER_N_TAPS+1; j++)
+            {
+                R[i][j] *= scale;
+            }
+            for(z=0; z<LIBLTE_PHY_DL_CE_WIENER_N_TAPS; z++)
+            {
+                if(z != i)
+                {
+                    scale = R[z][i];
+                    for(j=i; j<LIBLTE_PHY_DL_CE_WIENER_N_TAPS+1; j++)
+                    {
+                        R[z][j] -= scale*R[i][j];
+                    }
+                }
+            }
+        }
+        for(i=0; i<LIBLTE_PHY_DL_CE_WIENER_N_TAPS; i++)
+        {
+            subframe->rx_ce_wiener_w[r][i] = R[i][LIBLTE_PHY_DL_CE_WIENER_N_TAPS];
+        }
     }
-    while((*phase_1 - phase_2) <= -M_PI)
+}
+
+/*********************************************************************
+    Name: dl_ce_calc
+
+    Description: Interpolates the downlink CRS estimates into channel
+                 estimates for the specified symbols and PRBs, skipping
+                 any that have already been calculated for this subframe
+
+    Document Reference: N/A
+*********************************************************************/
+void dl_ce_calc(LIBLTE_PHY_STRUCT          *phy_struct,
+                LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                uint32                      first_symb,
+                uint32                      N_symbs,
+                uint32                      first_prb,
+                uint32                      N_prb)
+{
+    float  *rs_re;
+    float  *rs_im;
+    float  *f0_re;
+    float  *f0_im;
+    float  *f1_re;
+    float  *f1_im;
+    float  *ce_re;
+    float  *ce_im;
+    float  *w;
+    float   t;
+    float   w0;
+    float   w1;
+    uint32  N_rs      = 2*phy_struct->N_rb_dl;
+    uint32  symb_mask = ((1 << N_symbs) - 1) << first_symb;
+    uint32  prb;
+    uint32  p;
+    uint32  i;
+    uint32  j;
+    uint32  k;
+    uint32  k_start;
+    uint32  l;
+    uint32  r;
+    uint32  off;
+
+    for(prb=first_prb; prb<(first_prb + N_prb) && prb<phy_struct->N_rb_dl; prb++)
     {
-        *phase_1 = *phase_1 + 2*M_PI;
+        if((subframe->rx_ce_valid[prb] & symb_mask) == symb_mask)
+        {
+            continue;
+        }
+        k_start = prb*phy_struct->N_sc_rb_dl;
+
+        // Interpolate the CRS estimates across frequency
+        if(!subframe->rx_ce_freq_valid[prb])
+        {
+            for(p=0; p<subframe->rx_ce_N_ant; p++)
+            {
+                for(i=0; i<DL_CE_N_CRS_SYMBS[p]; i++)
+                {
+                    off   = (DL_CE_CRS_V[p][i] + subframe->rx_ce_v_shift) % 6;
+                    rs_re = &subframe->rx_ce_rs_re[p][i][0];
+                    rs_im = &subframe->rx_ce_rs_im[p][i][0];
+                    ce_re = &subframe->rx_ce_freq_re[p][i][0];
+                    ce_im = &subframe->rx_ce_freq_im[p][i][0];
+                    for(k=k_start; k<(k_start + phy_struct->N_sc_rb_dl); k++)
+                    {
+                        // CRS j precedes subcarrier k by r subcarriers
+                        j = (k + 6 - off)/6 - 1;
+                        r = (k + 6 - off) % 6;
+                        if(subframe->rx_ce_wiener &&
+                           (k + 6 - off) >= 12    &&
+                           (j + 2)       <  N_rs)
+                        {
+                            w        = &subframe->rx_ce_wiener_w[r][0];
+                            ce_re[k] = w[0]*rs_re[j-1] + w[1]*rs_re[j] + w[2]*rs_re[j+1] + w[3]*rs_re[j+2];
+                            ce_im[k] = w[0]*rs_im[j-1] + w[1]*rs_im[j] + w[2]*rs_im[j+1] + w[3]*rs_im[j+2];
+                        }else{
+                            // Linear, extrapolating from the outermost CRSs at the band edges
+                            if(k < off)
+                            {
+                                j = 0;
+                            }else if(j > (N_rs - 2)){
+                                j = N_rs - 2;
+                            }
+                            t        = ((float)k - (float)(6*j + off))/6;
+                            ce_re[k] = rs_re[j] + t*(rs_re[j+1] - rs_re[j]);
+                            ce_im[k] = rs_im[j] + t*(rs_im[j+1] - rs_im[j]);
+                        }
+                    }
+                }
+            }
+            subframe->rx_ce_freq_valid[prb] = true;
+        }
+
+        // Interpolate between CRS symbols
+        for(l=first_symb; l<(first_symb + N_symbs); l++)
+        {
+            if((subframe->rx_ce_valid[prb] & (1 << l)) != 0)
+            {
+                continue;
+            }
+            for(p=0; p<subframe->rx_ce_N_ant; p++)
+            {
+                i = 0;
+                while(i < (DL_CE_N_CRS_SYMBS[p] - 2) &&
+                      DL_CE_CRS_SYMB[p][i+1] <= l)
+                {
+                    i++;
+                }
+                w1    = ((float)l - (float)DL_CE_CRS_SYMB[p][i])/(float)(DL_CE_CRS_SYMB[p][i+1] - DL_CE_CRS_SYMB[p][i]);
+                w0    = 1 - w1;
+                f0_re = &subframe->rx_ce_freq_re[p][i][k_start];
+                f0_im = &subframe->rx_ce_freq_im[p][i][k_start];
+                f1_re = &subframe->rx_ce_freq_re[p][i+1][k_start];
+                f1_im = &subframe->rx_ce_freq_im[p][i+1][k_start];
+                ce_re = &subframe->rx_ce_re[p][l][k_start];
+                ce_im = &subframe->rx_ce_im[p][l][k_start];
+                for(k=0; k<phy_struct->N_sc_rb_dl; k++)
+                {
+                    ce_re[k] = w0*f0_re[k] + w1*f1_re[k];
+                    ce_im[k] = w0*f0_im[k] + w1*f1_im[k];
+                }
+            }
+            subframe->rx_ce_valid[prb] |= 1 << l;
+        }
     }
 }
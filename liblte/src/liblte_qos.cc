@@ -0,0 +1,470 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_qos.cc
+
+    Description: Contains all the implementations for the bearer QoS
+                 library used to share the downlink between radio
+                 bearers.  Provides the standardized QCI table, bit rate
+                 decoding, token buckets for GBR, MBR, and AMBR
+                 metering, deficit round robin between bearers, and
+                 CoDel queue management.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_qos.h"
+#include <math.h>
+#include <time.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define QOS_MILLIBITS_PER_BYTE 8000
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+// Indexed by QCI
+static const LIBLTE_QOS_QCI_STRUCT qos_qci_table[LIBLTE_QOS_QCI_MAX + 1] = {{LIBLTE_QOS_RESOURCE_TYPE_NON_GBR,   0, 0, 0},
+                                                                            {LIBLTE_QOS_RESOURCE_TYPE_GBR,     100, 2, 2},
+                                                                            {LIBLTE_QOS_RESOURCE_TYPE_GBR,     150, 4, 3},
+                                                                            {LIBLTE_QOS_RESOURCE_TYPE_GBR,      50, 3, 3},
+                                                                            {LIBLTE_QOS_RESOURCE_TYPE_GBR,     300, 5, 6},
+                                                                            {LIBLTE_QOS_RESOURCE_TYPE_NON_GBR, 100, 1, 6},
+                                                                            {LIBLTE_QOS_RESOURCE_TYPE_NON_GBR, 300, 6, 6},
+                                                                            {LIBLTE_QOS_RESOURCE_TYPE_NON_GBR, 100, 7, 3},
+                                                                            {LIBLTE_QOS_RESOURCE_TYPE_NON_GBR, 300, 8, 6},
+                                                                            {LIBLTE_QOS_RESOURCE_TYPE_NON_GBR, 300, 9, 6}};
+
+/*******************************************************************************
+                              LOCAL FUNCTION PROTOTYPES
+*******************************************************************************/
+
+/*********************************************************************
+    Name: codel_control_law
+
+    Description: Time of the next drop, interval/sqrt(count) after t
+
+    Document Reference: RFC8289 Section 5.5
+*********************************************************************/
+uint64 codel_control_law(LIBLTE_QOS_CODEL_STRUCT *codel,
+                         uint64                   t);
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: liblte_qos_get_qci
+
+    Description: Returns the standardized characteristics of a QCI.
+                 Priority 1 is the highest, the packet error loss rate
+                 is 10^-loss_rate_exp.
+
+    Document Reference: 23.203 v10.3.0 Table 6.1.7
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_qos_get_qci(uint8                  qci,
+                                     LIBLTE_QOS_QCI_STRUCT *qci_char)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(qci_char != NULL               &&
+       qci      >= LIBLTE_QOS_QCI_MIN &&
+       qci      <= LIBLTE_QOS_QCI_MAX)
+    {
+        *qci_char = qos_qci_table[qci];
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_qos_bit_rate_kbps
+
+    Description: Decodes a maximum or guaranteed bit rate octet and
+                 its extension octet into kbps.  Returns 0 for a bit
+                 rate of 0kbps.
+
+    Document Reference: 24.301 v10.2.0 Section 9.9.4.3
+                        24.008 v10.2.0 Section 10.5.6.5
+*********************************************************************/
+uint32 liblte_qos_bit_rate_kbps(uint8 br,
+                                uint8 br_ext)
+{
+    uint32 kbps = 0;
+
+    // The extension octet overrides the bit rate octet when it is set
+    if(0 != br_ext && 0xFA >= br_ext)
+    {
+        if(0x4A >= br_ext)
+        {
+            kbps = 8600 + br_ext*100;
+        }else if(0xBA >= br_ext){
+            kbps = 16000 + (br_ext - 0x4A)*1000;
+        }else{
+            kbps = 128000 + (br_ext - 0xBA)*2000;
+        }
+    }else if(0x3F >= br){
+        kbps = br;
+    }else if(0x7F >= br){
+        kbps = 64 + (br - 0x40)*8;
+    }else if(0xFF != br){
+        kbps = 576 + (br - 0x80)*64;
+    }
+
+    return(kbps);
+}
+
+/*********************************************************************
+    Name: Token Bucket
+
+    Description: Meters a bearer or a user against a bit rate.  The
+                 bucket fills at rate_kbps up to a depth of burst_ms
+                 worth of data and may be overdrawn by the last SDU
+                 served, which is paid back before anything else is
+                 allowed through.
+
+    Document Reference: N/A
+
+    Notes: Tokens are kept in millibits, as kbps times microseconds
+           is exactly millibits
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_qos_token_bucket_init(LIBLTE_QOS_TOKEN_BUCKET_STRUCT *tb,
+                                               uint32                          rate_kbps,
+                                               uint32                          burst_ms,
+                                               uint64                          now_us)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(tb != NULL)
+    {
+        tb->rate_kbps = rate_kbps;
+        tb->depth     = (int64)rate_kbps * burst_ms * 1000;
+        tb->tokens    = tb->depth;
+        tb->last_us   = now_us;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+void liblte_qos_token_bucket_update(LIBLTE_QOS_TOKEN_BUCKET_STRUCT *tb,
+                                    uint64                          now_us)
+{
+    if(now_us > tb->last_us)
+    {
+        tb->tokens += (int64)tb->rate_kbps * (int64)(now_us - tb->last_us);
+        if(tb->tokens > tb->depth)
+        {
+            tb->tokens = tb->depth;
+        }
+        tb->last_us = now_us;
+    }
+}
+uint32 liblte_qos_token_bucket_bytes(LIBLTE_QOS_TOKEN_BUCKET_STRUCT *tb)
+{
+    uint32 N_bytes = 0;
+
+    if(0 < tb->tokens)
+    {
+        N_bytes = (tb->tokens + QOS_MILLIBITS_PER_BYTE - 1) / QOS_MILLIBITS_PER_BYTE;
+    }
+
+    return(N_bytes);
+}
+void liblte_qos_token_bucket_consume(LIBLTE_QOS_TOKEN_BUCKET_STRUCT *tb,
+                                     uint32                          N_bytes)
+{
+    tb->tokens -= (int64)N_bytes * QOS_MILLIBITS_PER_BYTE;
+}
+
+/*********************************************************************
+    Name: Deficit Round Robin
+
+    Description: Shares capacity between flows in proportion to their
+                 quanta.  The caller marks the flows that are
+                 backlogged, asks which flow to serve and how many
+                 bytes it may send, and charges the flow for what it
+                 actually sent.  A flow keeps the turn until its
+                 deficit is used up or it runs out of data.
+
+    Document Reference: Shreedhar and Varghese, "Efficient Fair
+                        Queuing using Deficit Round Robin", 1995
+
+    Notes: Deficits survive between calls so a flow that could only
+           send part of its quantum in one TTI catches up in the next
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_qos_drr_init(LIBLTE_QOS_DRR_STRUCT *drr,
+                                      uint32                 N_flows)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+
+    if(drr     != NULL                        &&
+       N_flows != 0                           &&
+       N_flows <= LIBLTE_QOS_DRR_N_FLOWS_MAX)
+    {
+        for(i=0; i<N_flows; i++)
+        {
+            drr->flow[i].deficit    = 0;
+            drr->flow[i].quantum    = LIBLTE_QOS_DRR_BASE_QUANTUM;
+            drr->flow[i].backlogged = false;
+        }
+        drr->N_flows = N_flows;
+        drr->cur     = 0;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_qos_drr_set_quantum(LIBLTE_QOS_DRR_STRUCT *drr,
+                                             uint32                 flow,
+                                             uint32                 quantum)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(drr     != NULL          &&
+       flow    <  drr->N_flows  &&
+       quantum != 0)
+    {
+        drr->flow[flow].quantum = quantum;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_qos_drr_select(LIBLTE_QOS_DRR_STRUCT *drr,
+                                        uint32                *flow,
+                                        uint32                *N_bytes)
+{
+    LIBLTE_QOS_DRR_FLOW_STRUCT *cur;
+    LIBLTE_ERROR_ENUM           err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32                      i;
+
+    if(drr     != NULL &&
+       flow    != NULL &&
+       N_bytes != NULL)
+    {
+        // Charging keeps deficits above -quantum, so one visit to a
+        // backlogged flow is always enough to give it a positive deficit
+        for(i=0; i<=drr->N_flows && LIBLTE_SUCCESS != err; i++)
+        {
+            cur = &drr->flow[drr->cur];
+            if(!cur->backlogged)
+            {
+                cur->deficit = 0;
+                drr->cur     = (drr->cur + 1) % drr->N_flows;
+                continue;
+            }
+            if(0 >= cur->deficit)
+            {
+                cur->deficit += cur->quantum;
+            }
+            if(0 < cur->deficit)
+            {
+                *flow    = drr->cur;
+                *N_bytes = cur->deficit;
+                err      = LIBLTE_SUCCESS;
+            }
+        }
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_qos_drr_charge(LIBLTE_QOS_DRR_STRUCT *drr,
+                                        uint32                 flow,
+                                        uint32                 N_bytes,
+                                        bool                   empty)
+{
+    LIBLTE_QOS_DRR_FLOW_STRUCT *cur;
+    LIBLTE_ERROR_ENUM           err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(drr  != NULL         &&
+       flow <  drr->N_flows)
+    {
+        cur           = &drr->flow[flow];
+        cur->deficit -= (int32)N_bytes;
+        if(cur->deficit <= -(int32)cur->quantum)
+        {
+            cur->deficit = 1 - (int32)cur->quantum;
+        }
+
+        // An idle flow does not bank credit
+        if(empty)
+        {
+            cur->deficit    = 0;
+            cur->backlogged = false;
+        }
+        if(empty || 0 >= cur->deficit)
+        {
+            drr->cur = (flow + 1) % drr->N_flows;
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: CoDel
+
+    Description: Controlled delay active queue management.  Called
+                 for the packet at the head of a queue as it is
+                 dequeued, with the time it has spent queued, and
+                 returns whether to drop it.  Packets are dropped
+                 once the sojourn time has stayed above target for a
+                 whole interval, at a rate growing with the square
+                 root of the number of drops until the queue drains
+                 below target.
+
+    Document Reference: RFC8289
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_qos_codel_init(LIBLTE_QOS_CODEL_STRUCT *codel,
+                                        uint64                   target_us,
+                                        uint64                   interval_us)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(codel       != NULL &&
+       interval_us != 0)
+    {
+        codel->target_us      = target_us;
+        codel->interval_us    = interval_us;
+        codel->first_above_us = 0;
+        codel->drop_next_us   = 0;
+        codel->count          = 0;
+        codel->last_count     = 0;
+        codel->N_drops        = 0;
+        codel->dropping       = false;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+bool liblte_qos_codel_drop(LIBLTE_QOS_CODEL_STRUCT *codel,
+                           uint64                   now_us,
+                           uint64                   sojourn_us,
+                           uint32                   N_bytes_queued)
+{
+    uint32 delta;
+    bool   ok_to_drop = false;
+    bool   drop       = false;
+
+    // The queue has to stay above target for a whole interval, and
+    // holding less than one MTU never counts as standing
+    if(sojourn_us     <  codel->target_us ||
+       N_bytes_queued <= LIBLTE_QOS_CODEL_MTU)
+    {
+        codel->first_above_us = 0;
+    }else if(0 == codel->first_above_us){
+        codel->first_above_us = now_us + codel->interval_us;
+    }else if(now_us >= codel->first_above_us){
+        ok_to_drop = true;
+    }
+
+    if(codel->dropping)
+    {
+        if(!ok_to_drop)
+        {
+            codel->dropping = false;
+        }else if(now_us >= codel->drop_next_us){
+            drop                = true;
+            codel->count++;
+            codel->drop_next_us = codel_control_law(codel, codel->drop_next_us);
+        }
+    }else if(ok_to_drop){
+        // Pick up near the old drop rate if the last dropping state
+        // ended recently
+        drop            = true;
+        codel->dropping = true;
+        delta           = codel->count - codel->last_count;
+        if(1 < delta &&
+           (now_us < codel->drop_next_us ||
+            (now_us - codel->drop_next_us) < 16*codel->interval_us))
+        {
+            codel->count = delta;
+        }else{
+            codel->count = 1;
+        }
+        codel->drop_next_us = codel_control_law(codel, now_us);
+        codel->last_count   = codel->count;
+    }
+
+    if(drop)
+    {
+        codel->N_drops++;
+    }
+
+    return(drop);
+}
+
+/*********************************************************************
+    Name: liblte_qos_get_time_us
+
+    Description: Returns a monotonic time in microseconds for
+                 timestamping queued SDUs and refilling token buckets.
+
+    Document Reference: N/A
+*********************************************************************/
+uint64 liblte_qos_get_time_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return((uint64)ts.tv_sec*1000000 + ts.tv_nsec/1000);
+}
+
+/*******************************************************************************
+                              LOCAL FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: codel_control_law
+
+    Description: Time of the next drop, interval/sqrt(count) after t
+
+    Document Reference: RFC8289 Section 5.5
+*********************************************************************/
+uint64 codel_control_law(LIBLTE_QOS_CODEL_STRUCT *codel,
+                         uint64                   t)
+{
+    return(t + (uint64)((double)codel->interval_us / sqrt((double)codel->count)));
+}
@@ -53,6 +53,31 @@
 *******************************************************************************/
 
 
+/*******************************************************************************
+                              LOCAL FUNCTION PROTOTYPES
+*******************************************************************************/
+
+/*********************************************************************
+    Name: pack_li_fields
+
+    Description: Packs the E/LI pairs of an UMD or AMD PDU header,
+                 padding the last byte when the number of LIs is odd
+*********************************************************************/
+void pack_li_fields(uint32   N_li,
+                    uint16  *li,
+                    uint8  **pdu_ptr);
+
+/*********************************************************************
+    Name: unpack_li_fields
+
+    Description: Unpacks the E/LI pairs of an UMD or AMD PDU header
+*********************************************************************/
+LIBLTE_ERROR_ENUM unpack_li_fields(LIBLTE_RLC_E_FIELD_ENUM   e,
+                                   uint8                   **pdu_ptr,
+                                   uint8                    *pdu_end,
+                                   uint32                   *N_li,
+                                   uint16                   *li);
+
 /*******************************************************************************
                               PDU FUNCTIONS
 *******************************************************************************/
@@ -71,28 +96,35 @@ LIBLTE_ERROR_ENUM liblte_rlc_pack_umd_pdu(LIBLTE_RLC_UMD_PDU_STRUCT *umd,
                                           LIBLTE_BYTE_MSG_STRUCT    *data,
                                           LIBLTE_BYTE_MSG_STRUCT    *pdu)
 {
-    LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
-    uint8             *pdu_ptr = pdu->msg;
+    LIBLTE_ERROR_ENUM        err     = LIBLTE_ERROR_INVALID_INPUTS;
+    uint8                   *pdu_ptr = pdu->msg;
+    LIBLTE_RLC_E_FIELD_ENUM  e;
 
     if(umd  != NULL &&
        data != NULL &&
        pdu  != NULL)
     {
         // Header
+        e = LIBLTE_RLC_E_FIELD_HEADER_NOT_EXTENDED;
+        if(0 != umd->hdr.N_li)
+        {
+            e = LIBLTE_RLC_E_FIELD_HEADER_EXTENDED;
+        }
         if(LIBLTE_RLC_UMD_SN_SIZE_5_BITS == umd->hdr.sn_size)
         {
             *pdu_ptr  = (umd->hdr.fi & 0x03) << 6;
-            *pdu_ptr |= (LIBLTE_RLC_E_FIELD_HEADER_NOT_EXTENDED & 0x01) << 5;
+            *pdu_ptr |= (e & 0x01) << 5;
             *pdu_ptr |= umd->hdr.sn & 0x1F;
             pdu_ptr++;
         }else{
             *pdu_ptr  = (umd->hdr.fi & 0x03) << 3;
-            *pdu_ptr |= (LIBLTE_RLC_E_FIELD_HEADER_NOT_EXTENDED & 0x01) << 2;
+            *pdu_ptr |= (e & 0x01) << 2;
             *pdu_ptr |= (umd->hdr.sn & 0x300) >> 8;
             pdu_ptr++;
             *pdu_ptr = umd->hdr.sn & 0xFF;
             pdu_ptr++;
         }
+        pack_li_fields(umd->hdr.N_li, umd->hdr.li, &pdu_ptr);
 
         // Data
         memcpy(pdu_ptr, data->msg, data->N_bytes);
@@ -132,17 +164,18 @@ LIBLTE_ERROR_ENUM liblte_rlc_unpack_umd_pdu(LIBLTE_BYTE_MSG_STRUCT    *pdu,
             pdu_ptr++;
         }
 
-        if(LIBLTE_RLC_E_FIELD_HEADER_EXTENDED == e)
-        {
-            // FIXME
-            printf("Not handling HEADER EXTENSION\n");
-        }
+        err = unpack_li_fields(e,
+                               &pdu_ptr,
+                               pdu->msg + pdu->N_bytes,
+                               &umd->hdr.N_li,
+                               umd->hdr.li);
 
         // Data
-        umd->data.N_bytes = pdu->N_bytes - (pdu_ptr - pdu->msg);
-        memcpy(umd->data.msg, pdu_ptr, umd->data.N_bytes);
-
-        err = LIBLTE_SUCCESS;
+        if(LIBLTE_SUCCESS == err)
+        {
+            umd->data.N_bytes = pdu->N_bytes - (pdu_ptr - pdu->msg);
+            memcpy(umd->data.msg, pdu_ptr, umd->data.N_bytes);
+        }
     }
 
     return(err);
@@ -162,23 +195,30 @@ LIBLTE_ERROR_ENUM liblte_rlc_pack_amd_pdu(LIBLTE_RLC_AMD_PDU_STRUCT *amd,
                                           LIBLTE_BYTE_MSG_STRUCT    *data,
                                           LIBLTE_BYTE_MSG_STRUCT    *pdu)
 {
-    LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
-    uint8             *pdu_ptr = pdu->msg;
+    LIBLTE_ERROR_ENUM        err     = LIBLTE_ERROR_INVALID_INPUTS;
+    uint8                   *pdu_ptr = pdu->msg;
+    LIBLTE_RLC_E_FIELD_ENUM  e;
 
     if(amd  != NULL &&
        data != NULL &&
        pdu  != NULL)
     {
         // Header
+        e = LIBLTE_RLC_E_FIELD_HEADER_NOT_EXTENDED;
+        if(0 != amd->hdr.N_li)
+        {
+            e = LIBLTE_RLC_E_FIELD_HEADER_EXTENDED;
+        }
         *pdu_ptr  = (amd->hdr.dc & 0x01) << 7;
         *pdu_ptr |= (amd->hdr.rf & 0x01) << 6;
         *pdu_ptr |= (amd->hdr.p & 0x01) << 5;
         *pdu_ptr |= (amd->hdr.fi & 0x03) << 3;
-        *pdu_ptr |= (LIBLTE_RLC_E_FIELD_HEADER_NOT_EXTENDED & 0x01) << 2;
+        *pdu_ptr |= (e & 0x01) << 2;
         *pdu_ptr |= (amd->hdr.sn & 0x300) >> 8;
         pdu_ptr++;
         *pdu_ptr = amd->hdr.sn & 0xFF;
         pdu_ptr++;
+        pack_li_fields(amd->hdr.N_li, amd->hdr.li, &pdu_ptr);
 
         // Data
         memcpy(pdu_ptr, data->msg, data->N_bytes);
@@ -223,17 +263,18 @@ LIBLTE_ERROR_ENUM liblte_rlc_unpack_amd_pdu(LIBLTE_BYTE_MSG_STRUCT    *pdu,
                 printf("Not handling AMD PDU SEGMENTS\n");
             }
 
-            if(LIBLTE_RLC_E_FIELD_HEADER_EXTENDED == e)
-            {
-                // FIXME
-                printf("Not handling HEADER EXTENSION\n");
-            }
+            err = unpack_li_fields(e,
+                                   &pdu_ptr,
+                                   pdu->msg + pdu->N_bytes,
+                                   &amd->hdr.N_li,
+                                   amd->hdr.li);
 
             // Data
-            amd->data.N_bytes = pdu->N_bytes - (pdu_ptr - pdu->msg);
-            memcpy(amd->data.msg, pdu_ptr, amd->data.N_bytes);
-
-            err = LIBLTE_SUCCESS;
+            if(LIBLTE_SUCCESS == err)
+            {
+                amd->data.N_bytes = pdu->N_bytes - (pdu_ptr - pdu->msg);
+                memcpy(amd->data.msg, pdu_ptr, amd->data.N_bytes);
+            }
         }else{
             // FIXME: Signal that this is a status PDU
         }
@@ -363,7 +404,100 @@ LIBLTE_ERROR_ENUM liblte_rlc_unpack_status_pdu(LIBLTE_BYTE_MSG_STRUCT       *pdu
                         liblte_bits_2_value(&pdu_ptr, 29);
                     }
                 }
+
+                err = LIBLTE_SUCCESS;
             }
         }
     }
+
+    return(err);
+}
+
+/*******************************************************************************
+                              LOCAL FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: pack_li_fields
+
+    Description: Packs the E/LI pairs of an UMD or AMD PDU header,
+                 padding the last byte when the number of LIs is odd
+*********************************************************************/
+void pack_li_fields(uint32   N_li,
+                    uint16  *li,
+                    uint8  **pdu_ptr)
+{
+    uint32 field;
+    uint32 i;
+
+    for(i=0; i<N_li; i++)
+    {
+        // E is set for every LI but the last
+        field = li[i] & LIBLTE_RLC_LI_MAX;
+        if((i + 1) < N_li)
+        {
+            field |= LIBLTE_RLC_E_FIELD_HEADER_EXTENDED << 11;
+        }
+
+        if(0 == (i % 2))
+        {
+            **pdu_ptr = (field >> 4) & 0xFF;
+            (*pdu_ptr)++;
+            **pdu_ptr = (field & 0x0F) << 4;
+        }else{
+            **pdu_ptr |= (field >> 8) & 0x0F;
+            (*pdu_ptr)++;
+            **pdu_ptr = field & 0xFF;
+            (*pdu_ptr)++;
+        }
+    }
+    if(0 != (N_li % 2))
+    {
+        (*pdu_ptr)++;
+    }
+}
+
+/*********************************************************************
+    Name: unpack_li_fields
+
+    Description: Unpacks the E/LI pairs of an UMD or AMD PDU header
+*********************************************************************/
+LIBLTE_ERROR_ENUM unpack_li_fields(LIBLTE_RLC_E_FIELD_ENUM   e,
+                                   uint8                   **pdu_ptr,
+                                   uint8                    *pdu_end,
+                                   uint32                   *N_li,
+                                   uint16                   *li)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_SUCCESS;
+    uint32            field;
+
+    *N_li = 0;
+    while(LIBLTE_RLC_E_FIELD_HEADER_EXTENDED == e &&
+          LIBLTE_SUCCESS                     == err)
+    {
+        if((*pdu_ptr + 1) < pdu_end &&
+           LIBLTE_RLC_MAX_LI > *N_li)
+        {
+            if(0 == (*N_li % 2))
+            {
+                field = ((*pdu_ptr)[0] << 4) | ((*pdu_ptr)[1] >> 4);
+                (*pdu_ptr)++;
+            }else{
+                field = (((*pdu_ptr)[0] & 0x0F) << 8) | (*pdu_ptr)[1];
+                (*pdu_ptr) += 2;
+            }
+            e         = (LIBLTE_RLC_E_FIELD_ENUM)((field >> 11) & 0x01);
+            li[*N_li] = field & LIBLTE_RLC_LI_MAX;
+            (*N_li)++;
+        }else{
+            err = LIBLTE_ERROR_DECODE_FAIL;
+        }
+    }
+    if(LIBLTE_SUCCESS == err &&
+       0              != (*N_li % 2))
+    {
+        (*pdu_ptr)++;
+    }
+
+    return(err);
 }
@@ -0,0 +1,2179 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_rohc.cc
+
+    Description: Contains all the implementations for the RObust Header
+                 Compression library used by PDCP.  Implements the
+                 uncompressed, RTP, UDP, and ESP profiles of RFC3095 for
+                 IPv4 with small CIDs, in U-mode and O-mode.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_rohc.h"
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define ROHC_IPV4_HDR_LEN        20
+#define ROHC_UDP_HDR_LEN         8
+#define ROHC_RTP_HDR_LEN         12
+#define ROHC_ESP_HDR_LEN         8
+#define ROHC_IP_PROTOCOL_UDP     17
+#define ROHC_IP_PROTOCOL_ESP     50
+#define ROHC_MAX_OVERHEAD        64
+#define ROHC_PACKET_PADDING      0xE0
+#define ROHC_PACKET_ADD_CID      0xE0
+#define ROHC_PACKET_FEEDBACK     0xF0
+#define ROHC_PACKET_IR_DYN       0xF8
+#define ROHC_PACKET_IR           0xFC
+#define ROHC_CRC3_INIT           0x07
+#define ROHC_CRC7_INIT           0x7F
+#define ROHC_CRC8_INIT           0xFF
+#define ROHC_ACKTYPE_ACK         0
+#define ROHC_ACKTYPE_NACK        1
+#define ROHC_ACKTYPE_STATIC_NACK 2
+#define ROHC_FEEDBACK_MODE_U     1
+#define ROHC_FEEDBACK_MODE_O     2
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+// Reflected tables for the CRC polynomials of RFC3095 Section 5.9.1
+static const uint8 crc3_table[256] = {0x00,0x06,0x01,0x07,0x02,0x04,0x03,0x05,0x04,0x02,0x05,0x03,0x06,0x00,0x07,0x01,
+                                      0x05,0x03,0x04,0x02,0x07,0x01,0x06,0x00,0x01,0x07,0x00,0x06,0x03,0x05,0x02,0x04,
+                                      0x07,0x01,0x06,0x00,0x05,0x03,0x04,0x02,0x03,0x05,0x02,0x04,0x01,0x07,0x00,0x06,
+                                      0x02,0x04,0x03,0x05,0x00,0x06,0x01,0x07,0x06,0x00,0x07,0x01,0x04,0x02,0x05,0x03,
+                                      0x03,0x05,0x02,0x04,0x01,0x07,0x00,0x06,0x07,0x01,0x06,0x00,0x05,0x03,0x04,0x02,
+                                      0x06,0x00,0x07,0x01,0x04,0x02,0x05,0x03,0x02,0x04,0x03,0x05,0x00,0x06,0x01,0x07,
+                                      0x04,0x02,0x05,0x03,0x06,0x00,0x07,0x01,0x00,0x06,0x01,0x07,0x02,0x04,0x03,0x05,
+                                      0x01,0x07,0x00,0x06,0x03,0x05,0x02,0x04,0x05,0x03,0x04,0x02,0x07,0x01,0x06,0x00,
+                                      0x06,0x00,0x07,0x01,0x04,0x02,0x05,0x03,0x02,0x04,0x03,0x05,0x00,0x06,0x01,0x07,
+                                      0x03,0x05,0x02,0x04,0x01,0x07,0x00,0x06,0x07,0x01,0x06,0x00,0x05,0x03,0x04,0x02,
+                                      0x01,0x07,0x00,0x06,0x03,0x05,0x02,0x04,0x05,0x03,0x04,0x02,0x07,0x01,0x06,0x00,
+                                      0x04,0x02,0x05,0x03,0x06,0x00,0x07,0x01,0x00,0x06,0x01,0x07,0x02,0x04,0x03,0x05,
+                                      0x05,0x03,0x04,0x02,0x07,0x01,0x06,0x00,0x01,0x07,0x00,0x06,0x03,0x05,0x02,0x04,
+                                      0x00,0x06,0x01,0x07,0x02,0x04,0x03,0x05,0x04,0x02,0x05,0x03,0x06,0x00,0x07,0x01,
+                                      0x02,0x04,0x03,0x05,0x00,0x06,0x01,0x07,0x06,0x00,0x07,0x01,0x04,0x02,0x05,0x03,
+                                      0x07,0x01,0x06,0x00,0x05,0x03,0x04,0x02,0x03,0x05,0x02,0x04,0x01,0x07,0x00,0x06};
+static const uint8 crc7_table[256] = {0x00,0x40,0x73,0x33,0x15,0x55,0x66,0x26,0x2A,0x6A,0x59,0x19,0x3F,0x7F,0x4C,0x0C,
+                                      0x54,0x14,0x27,0x67,0x41,0x01,0x32,0x72,0x7E,0x3E,0x0D,0x4D,0x6B,0x2B,0x18,0x58,
+                                      0x5B,0x1B,0x28,0x68,0x4E,0x0E,0x3D,0x7D,0x71,0x31,0x02,0x42,0x64,0x24,0x17,0x57,
+                                      0x0F,0x4F,0x7C,0x3C,0x1A,0x5A,0x69,0x29,0x25,0x65,0x56,0x16,0x30,0x70,0x43,0x03,
+                                      0x45,0x05,0x36,0x76,0x50,0x10,0x23,0x63,0x6F,0x2F,0x1C,0x5C,0x7A,0x3A,0x09,0x49,
+                                      0x11,0x51,0x62,0x22,0x04,0x44,0x77,0x37,0x3B,0x7B,0x48,0x08,0x2E,0x6E,0x5D,0x1D,
+                                      0x1E,0x5E,0x6D,0x2D,0x0B,0x4B,0x78,0x38,0x34,0x74,0x47,0x07,0x21,0x61,0x52,0x12,
+                                      0x4A,0x0A,0x39,0x79,0x5F,0x1F,0x2C,0x6C,0x60,0x20,0x13,0x53,0x75,0x35,0x06,0x46,
+                                      0x79,0x39,0x0A,0x4A,0x6C,0x2C,0x1F,0x5F,0x53,0x13,0x20,0x60,0x46,0x06,0x35,0x75,
+                                      0x2D,0x6D,0x5E,0x1E,0x38,0x78,0x4B,0x0B,0x07,0x47,0x74,0x34,0x12,0x52,0x61,0x21,
+                                      0x22,0x62,0x51,0x11,0x37,0x77,0x44,0x04,0x08,0x48,0x7B,0x3B,0x1D,0x5D,0x6E,0x2E,
+                                      0x76,0x36,0x05,0x45,0x63,0x23,0x10,0x50,0x5C,0x1C,0x2F,0x6F,0x49,0x09,0x3A,0x7A,
+                                      0x3C,0x7C,0x4F,0x0F,0x29,0x69,0x5A,0x1A,0x16,0x56,0x65,0x25,0x03,0x43,0x70,0x30,
+                                      0x68,0x28,0x1B,0x5B,0x7D,0x3D,0x0E,0x4E,0x42,0x02,0x31,0x71,0x57,0x17,0x24,0x64,
+                                      0x67,0x27,0x14,0x54,0x72,0x32,0x01,0x41,0x4D,0x0D,0x3E,0x7E,0x58,0x18,0x2B,0x6B,
+                                      0x33,0x73,0x40,0x00,0x26,0x66,0x55,0x15,0x19,0x59,0x6A,0x2A,0x0C,0x4C,0x7F,0x3F};
+static const uint8 crc8_table[256] = {0x00,0x91,0xE3,0x72,0x07,0x96,0xE4,0x75,0x0E,0x9F,0xED,0x7C,0x09,0x98,0xEA,0x7B,
+                                      0x1C,0x8D,0xFF,0x6E,0x1B,0x8A,0xF8,0x69,0x12,0x83,0xF1,0x60,0x15,0x84,0xF6,0x67,
+                                      0x38,0xA9,0xDB,0x4A,0x3F,0xAE,0xDC,0x4D,0x36,0xA7,0xD5,0x44,0x31,0xA0,0xD2,0x43,
+                                      0x24,0xB5,0xC7,0x56,0x23,0xB2,0xC0,0x51,0x2A,0xBB,0xC9,0x58,0x2D,0xBC,0xCE,0x5F,
+                                      0x70,0xE1,0x93,0x02,0x77,0xE6,0x94,0x05,0x7E,0xEF,0x9D,0x0C,0x79,0xE8,0x9A,0x0B,
+                                      0x6C,0xFD,0x8F,0x1E,0x6B,0xFA,0x88,0x19,0x62,0xF3,0x81,0x10,0x65,0xF4,0x86,0x17,
+                                      0x48,0xD9,0xAB,0x3A,0x4F,0xDE,0xAC,0x3D,0x46,0xD7,0xA5,0x34,0x41,0xD0,0xA2,0x33,
+                                      0x54,0xC5,0xB7,0x26,0x53,0xC2,0xB0,0x21,0x5A,0xCB,0xB9,0x28,0x5D,0xCC,0xBE,0x2F,
+                                      0xE0,0x71,0x03,0x92,0xE7,0x76,0x04,0x95,0xEE,0x7F,0x0D,0x9C,0xE9,0x78,0x0A,0x9B,
+                                      0xFC,0x6D,0x1F,0x8E,0xFB,0x6A,0x18,0x89,0xF2,0x63,0x11,0x80,0xF5,0x64,0x16,0x87,
+                                      0xD8,0x49,0x3B,0xAA,0xDF,0x4E,0x3C,0xAD,0xD6,0x47,0x35,0xA4,0xD1,0x40,0x32,0xA3,
+                                      0xC4,0x55,0x27,0xB6,0xC3,0x52,0x20,0xB1,0xCA,0x5B,0x29,0xB8,0xCD,0x5C,0x2E,0xBF,
+                                      0x90,0x01,0x73,0xE2,0x97,0x06,0x74,0xE5,0x9E,0x0F,0x7D,0xEC,0x99,0x08,0x7A,0xEB,
+                                      0x8C,0x1D,0x6F,0xFE,0x8B,0x1A,0x68,0xF9,0x82,0x13,0x61,0xF0,0x85,0x14,0x66,0xF7,
+                                      0xA8,0x39,0x4B,0xDA,0xAF,0x3E,0x4C,0xDD,0xA6,0x37,0x45,0xD4,0xA1,0x30,0x42,0xD3,
+                                      0xB4,0x25,0x57,0xC6,0xB3,0x22,0x50,0xC1,0xBA,0x2B,0x59,0xC8,0xBD,0x2C,0x5E,0xCF};
+
+/*******************************************************************************
+                              LOCAL FUNCTION PROTOTYPES
+*******************************************************************************/
+
+/*********************************************************************
+    Name: rohc_crc
+
+    Description: Continues a CRC-3, CRC-7, or CRC-8 over N_bytes of
+                 data.
+
+    Document Reference: RFC3095 Section 5.9.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+uint8 rohc_crc(const uint8 *table,
+               uint8        crc,
+               uint8       *data,
+               uint32       N_bytes);
+
+/*********************************************************************
+    Name: rohc_update_static_crc
+
+    Description: Computes the CRC-3 and CRC-7 over the CRC-STATIC
+                 octets of a flow, for both values of the RTP marker
+                 bit.  The CRC-STATIC octets only change through IR and
+                 IR-DYN packets, so UO packets only need to run the
+                 CRC over the CRC-DYNAMIC octets.
+
+    Document Reference: RFC3095 Section 5.9.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void rohc_update_static_crc(LIBLTE_ROHC_FLOW_STRUCT  *flow,
+                            LIBLTE_ROHC_PROFILE_ENUM  profile);
+
+/*********************************************************************
+    Name: rohc_crc_dynamic
+
+    Description: Continues a CRC from the CRC-STATIC octets over the
+                 CRC-DYNAMIC octets of an uncompressed header.
+
+    Document Reference: RFC3095 Section 5.9.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+uint8 rohc_crc_dynamic(const uint8              *table,
+                       uint8                     crc,
+                       uint8                    *hdr,
+                       LIBLTE_ROHC_PROFILE_ENUM  profile);
+
+/*********************************************************************
+    Name: rohc_wlsb_fits
+
+    Description: Checks whether the k least significant bits of value
+                 decode correctly against every reference in a W-LSB
+                 window with interpretation interval offset p.
+
+    Document Reference: RFC3095 Sections 4.5.1 and 4.5.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+bool rohc_wlsb_fits(uint32  value,
+                    uint32 *ref,
+                    uint32  N_ref,
+                    uint32  k,
+                    int32   p,
+                    uint32  mask);
+
+/*********************************************************************
+    Name: rohc_wlsb_decode
+
+    Description: Decodes the k least significant bits of a field
+                 against a reference value.
+
+    Document Reference: RFC3095 Section 4.5.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+uint32 rohc_wlsb_decode(uint32 lsb,
+                        uint32 ref,
+                        uint32 k,
+                        int32  p,
+                        uint32 mask);
+
+/*********************************************************************
+    Name: rohc_sn_p
+
+    Description: Interpretation interval offset for k bits of SN.
+
+    Document Reference: RFC3095 Section 4.5.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+int32 rohc_sn_p(uint32 k);
+
+/*********************************************************************
+    Name: rohc_ts_p
+
+    Description: Interpretation interval offset for k bits of TS.
+
+    Document Reference: RFC3095 Section 4.5.4
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+int32 rohc_ts_p(uint32 k);
+
+/*********************************************************************
+    Name: rohc_parse_ip_pkt
+
+    Description: Classifies an IP packet into a profile and fills in
+                 its header fields.  Packets with IP options, fragments,
+                 bad checksums, or unsupported protocols use the
+                 uncompressed profile.
+
+    Document Reference: RFC3095 Sections 5.7.7 and 5.11
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ROHC_PROFILE_ENUM rohc_parse_ip_pkt(LIBLTE_ROHC_COMP_STRUCT *comp,
+                                           LIBLTE_BYTE_MSG_STRUCT  *ip_pkt,
+                                           LIBLTE_ROHC_FLOW_STRUCT *flow,
+                                           uint32                  *hdr_len);
+
+/*********************************************************************
+    Name: rohc_comp_find_ctx
+
+    Description: Returns the CID of the context for a flow, setting up
+                 a free or the least recently used context when the
+                 flow is new.
+
+    Document Reference: RFC3095 Section 5.1.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+uint32 rohc_comp_find_ctx(LIBLTE_ROHC_COMP_STRUCT  *comp,
+                          LIBLTE_ROHC_PROFILE_ENUM  profile,
+                          LIBLTE_ROHC_FLOW_STRUCT  *flow);
+
+/*********************************************************************
+    Name: rohc_comp_update_flow
+
+    Description: Fills in the SN, IP-ID, and TS_STRIDE fields of a new
+                 packet from its context, returning true when a field
+                 that can only be sent in IR or IR-DYN packets changed.
+
+    Document Reference: RFC3095 Sections 4.5.3, 4.5.5, and 5.7
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+bool rohc_comp_update_flow(LIBLTE_ROHC_COMP_CONTEXT_STRUCT *ctx,
+                           LIBLTE_ROHC_FLOW_STRUCT         *flow);
+
+/*********************************************************************
+    Name: rohc_pack_static_chain
+
+    Description: Packs the static chain of an IR packet.
+
+    Document Reference: RFC3095 Sections 5.7.7 and 5.11
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void rohc_pack_static_chain(LIBLTE_ROHC_FLOW_STRUCT   *flow,
+                            LIBLTE_ROHC_PROFILE_ENUM   profile,
+                            uint8                    **ptr);
+
+/*********************************************************************
+    Name: rohc_pack_dynamic_chain
+
+    Description: Packs the dynamic chain of an IR or IR-DYN packet.
+
+    Document Reference: RFC3095 Sections 5.7.7 and 5.11
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void rohc_pack_dynamic_chain(LIBLTE_ROHC_FLOW_STRUCT   *flow,
+                             LIBLTE_ROHC_PROFILE_ENUM   profile,
+                             LIBLTE_ROHC_MODE_ENUM      mode,
+                             uint8                    **ptr);
+
+/*********************************************************************
+    Name: rohc_unpack_static_chain
+
+    Description: Unpacks the static chain of an IR packet, returning
+                 false if it does not fit in the packet.
+
+    Document Reference: RFC3095 Sections 5.7.7 and 5.11
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+bool rohc_unpack_static_chain(uint8                    **ptr,
+                              uint8                     *end,
+                              LIBLTE_ROHC_PROFILE_ENUM   profile,
+                              LIBLTE_ROHC_FLOW_STRUCT   *flow);
+
+/*********************************************************************
+    Name: rohc_unpack_dynamic_chain
+
+    Description: Unpacks the dynamic chain of an IR or IR-DYN packet,
+                 returning false if it does not fit in the packet or
+                 uses options that are not supported.
+
+    Document Reference: RFC3095 Sections 5.7.7 and 5.11
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+bool rohc_unpack_dynamic_chain(uint8                    **ptr,
+                               uint8                     *end,
+                               LIBLTE_ROHC_PROFILE_ENUM   profile,
+                               LIBLTE_ROHC_FLOW_STRUCT   *flow);
+
+/*********************************************************************
+    Name: rohc_build_ip_pkt
+
+    Description: Rebuilds the uncompressed headers of a flow followed
+                 by the payload, returning false if the packet does not
+                 fit.
+
+    Document Reference: RFC3095 Section 5.7.7
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+bool rohc_build_ip_pkt(LIBLTE_ROHC_FLOW_STRUCT  *flow,
+                       LIBLTE_ROHC_PROFILE_ENUM  profile,
+                       uint8                    *payload,
+                       uint32                    N_payload_bytes,
+                       LIBLTE_BYTE_MSG_STRUCT   *ip_pkt);
+
+/*********************************************************************
+    Name: rohc_decomp_ir
+
+    Description: Decompresses an IR or IR-DYN packet and updates the
+                 context when its CRC passes.
+
+    Document Reference: RFC3095 Sections 5.7.7 and 5.10.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM rohc_decomp_ir(LIBLTE_ROHC_DECOMP_STRUCT         *decomp,
+                                 LIBLTE_ROHC_DECOMP_CONTEXT_STRUCT *ctx,
+                                 uint8                             *start,
+                                 uint8                             *ptr,
+                                 uint8                             *end,
+                                 LIBLTE_BYTE_MSG_STRUCT            *ip_pkt);
+
+/*********************************************************************
+    Name: rohc_decomp_uo
+
+    Description: Decompresses a UO-0, UO-1, or UOR-2 packet and updates
+                 the context when its CRC passes.
+
+    Document Reference: RFC3095 Sections 5.7.1 to 5.7.4 and 5.11
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM rohc_decomp_uo(LIBLTE_ROHC_DECOMP_CONTEXT_STRUCT *ctx,
+                                 uint8                             *ptr,
+                                 uint8                             *end,
+                                 LIBLTE_BYTE_MSG_STRUCT            *ip_pkt);
+
+/*********************************************************************
+    Name: rohc_pack_feedback
+
+    Description: Packs a FEEDBACK-2 packet.
+
+    Document Reference: RFC3095 Sections 5.2.2 and 5.7.6.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void rohc_pack_feedback(uint32                  cid,
+                        uint8                   acktype,
+                        uint32                  sn,
+                        LIBLTE_BYTE_MSG_STRUCT *feedback);
+
+/*********************************************************************
+    Name: rohc_put_16/rohc_put_32/rohc_get_16/rohc_get_32
+
+    Description: Network byte order field access.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void rohc_put_16(uint32   value,
+                 uint8  **ptr);
+void rohc_put_32(uint32   value,
+                 uint8  **ptr);
+uint32 rohc_get_16(uint8 *ptr);
+uint32 rohc_get_32(uint8 *ptr);
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: liblte_rohc_comp_init
+
+    Description: Sets up a compressor for CIDs 0 to max_cid using the
+                 profiles set in the profiles bit mask, where bit N is
+                 profile 0x000N.  Flows that do not match an enabled
+                 profile are carried by the uncompressed profile.  All
+                 contexts are held in the compressor struct, so nothing
+                 is allocated while compressing.
+
+    Document Reference: RFC3095 Sections 4 and 5
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_rohc_comp_init(LIBLTE_ROHC_COMP_STRUCT *comp,
+                                        uint32                   max_cid,
+                                        uint32                   profiles)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(comp    != NULL &&
+       max_cid <= LIBLTE_ROHC_MAX_CID)
+    {
+        memset(comp, 0, sizeof(LIBLTE_ROHC_COMP_STRUCT));
+        comp->max_cid = max_cid;
+
+        // The uncompressed profile is always supported
+        comp->profiles = profiles | (1 << LIBLTE_ROHC_PROFILE_UNCOMPRESSED);
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_rohc_compress
+
+    Description: Compresses one IP packet into a ROHC packet.
+
+    Document Reference: RFC3095 Sections 5.3 to 5.7, 5.10, and 5.11
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_rohc_compress(LIBLTE_ROHC_COMP_STRUCT *comp,
+                                       LIBLTE_BYTE_MSG_STRUCT  *ip_pkt,
+                                       LIBLTE_BYTE_MSG_STRUCT  *rohc_pkt)
+{
+    LIBLTE_ROHC_COMP_CONTEXT_STRUCT *ctx;
+    LIBLTE_ROHC_FLOW_STRUCT          flow;
+    LIBLTE_ROHC_PROFILE_ENUM         profile;
+    LIBLTE_ROHC_PACKET_TYPE_ENUM     type;
+    LIBLTE_ERROR_ENUM                err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32                           ts_ref[LIBLTE_ROHC_WLSB_WINDOW_SIZE];
+    uint8                           *out;
+    uint8                           *crc_ptr;
+    uint32                           hdr_len;
+    uint32                           cid;
+    uint32                           sn_mask;
+    uint32                           stride;
+    uint32                           ts_offset = 0;
+    uint32                           ts_val    = 0;
+    uint32                           ts_bits;
+    uint32                           i;
+    uint8                            m;
+    uint8                            crc;
+    bool                             changed;
+    bool                             ts_inferable;
+    bool                             ts_fits;
+    bool                             ip_id_same;
+
+    if(comp                   != NULL &&
+       ip_pkt                 != NULL &&
+       rohc_pkt               != NULL &&
+       ip_pkt->N_bytes        >  0    &&
+       ip_pkt->N_bytes + ROHC_MAX_OVERHEAD <= LIBLTE_MAX_MSG_SIZE)
+    {
+        profile = rohc_parse_ip_pkt(comp, ip_pkt, &flow, &hdr_len);
+        cid     = rohc_comp_find_ctx(comp, profile, &flow);
+        ctx     = &comp->ctx[cid];
+        comp->clock++;
+        ctx->last_used = comp->clock;
+
+        // Periodic refreshes are only needed without feedback
+        if(LIBLTE_ROHC_MODE_U == ctx->mode)
+        {
+            if(ctx->N_pkts_since_ir >= LIBLTE_ROHC_IR_TIMEOUT)
+            {
+                ctx->state        = LIBLTE_ROHC_COMP_STATE_IR;
+                ctx->N_state_pkts = 0;
+            }else if(ctx->N_pkts_since_fo >= LIBLTE_ROHC_FO_TIMEOUT &&
+                     LIBLTE_ROHC_COMP_STATE_SO == ctx->state){
+                ctx->state        = LIBLTE_ROHC_COMP_STATE_FO;
+                ctx->N_state_pkts = 0;
+            }
+        }
+
+        // Choose the packet type
+        type = LIBLTE_ROHC_PACKET_TYPE_IR_DYN;
+        if(LIBLTE_ROHC_PROFILE_UNCOMPRESSED == profile)
+        {
+            // Normal packets must not look like a ROHC packet type
+            type = LIBLTE_ROHC_PACKET_TYPE_NORMAL;
+            if(LIBLTE_ROHC_COMP_STATE_IR       == ctx->state       ||
+               ROHC_PACKET_ADD_CID             == (ip_pkt->msg[0] & 0xF0) ||
+               ROHC_PACKET_IR_DYN              == (ip_pkt->msg[0] & 0xF8))
+            {
+                type = LIBLTE_ROHC_PACKET_TYPE_IR;
+            }
+        }else{
+            changed = rohc_comp_update_flow(ctx, &flow);
+            if(changed &&
+               LIBLTE_ROHC_COMP_STATE_IR != ctx->state)
+            {
+                ctx->state        = LIBLTE_ROHC_COMP_STATE_FO;
+                ctx->N_state_pkts = 0;
+            }
+
+            sn_mask = 0xFFFF;
+            if(LIBLTE_ROHC_PROFILE_ESP == profile)
+            {
+                sn_mask = 0xFFFFFFFF;
+            }
+
+            if(LIBLTE_ROHC_COMP_STATE_IR == ctx->state)
+            {
+                type = LIBLTE_ROHC_PACKET_TYPE_IR;
+            }else if(LIBLTE_ROHC_COMP_STATE_SO == ctx->state &&
+                     LIBLTE_ROHC_PROFILE_RTP   == profile){
+                // TS is sent scaled by TS_STRIDE once a stride is known
+                stride = flow.ts_stride;
+                ts_val = flow.ts;
+                if(0 != stride)
+                {
+                    ts_offset = flow.ts % stride;
+                    ts_val    = (flow.ts - ts_offset) / stride;
+                }
+                ts_inferable = true;
+                for(i=0; i<ctx->N_window; i++)
+                {
+                    if(0 != stride)
+                    {
+                        ts_ref[i] = (ctx->ts_window[i] - ts_offset) / stride;
+                        if((ts_ref[i] + ((flow.sn - ctx->sn_window[i]) & 0xFFFF))*stride + ts_offset != flow.ts)
+                        {
+                            ts_inferable = false;
+                        }
+                    }else{
+                        ts_ref[i] = ctx->ts_window[i];
+                        if(ts_ref[i] != flow.ts)
+                        {
+                            ts_inferable = false;
+                        }
+                    }
+                }
+
+                // UO-1 and UOR-2 carry one more bit of TS when IP-ID is random
+                ts_bits = 5;
+                if(flow.rnd)
+                {
+                    ts_bits = 6;
+                }
+                ts_fits = rohc_wlsb_fits(ts_val, ts_ref, ctx->N_window, ts_bits, rohc_ts_p(ts_bits), 0xFFFFFFFF);
+
+                if(!flow.rtp_m &&
+                   ts_inferable &&
+                   rohc_wlsb_fits(flow.sn, ctx->sn_window, ctx->N_window, 4, rohc_sn_p(4), sn_mask))
+                {
+                    type = LIBLTE_ROHC_PACKET_TYPE_UO_0;
+                }else if(ts_fits &&
+                         rohc_wlsb_fits(flow.sn, ctx->sn_window, ctx->N_window, 4, rohc_sn_p(4), sn_mask)){
+                    type = LIBLTE_ROHC_PACKET_TYPE_UO_1;
+                }else if(ts_fits &&
+                         rohc_wlsb_fits(flow.sn, ctx->sn_window, ctx->N_window, 6, rohc_sn_p(6), sn_mask)){
+                    type = LIBLTE_ROHC_PACKET_TYPE_UOR_2;
+                }
+            }else if(LIBLTE_ROHC_COMP_STATE_SO == ctx->state){
+                // UO-0 and UOR-2 infer IP-ID from the context offset
+                ip_id_same = true;
+                for(i=0; i<ctx->N_window; i++)
+                {
+                    if(ctx->ip_id_offset_window[i] != flow.ip_id_offset)
+                    {
+                        ip_id_same = false;
+                    }
+                }
+                if(flow.rnd)
+                {
+                    ip_id_same = true;
+                }
+
+                if(ip_id_same &&
+                   rohc_wlsb_fits(flow.sn, ctx->sn_window, ctx->N_window, 4, rohc_sn_p(4), sn_mask))
+                {
+                    type = LIBLTE_ROHC_PACKET_TYPE_UO_0;
+                }else if(ip_id_same &&
+                         rohc_wlsb_fits(flow.sn, ctx->sn_window, ctx->N_window, 5, rohc_sn_p(5), sn_mask)){
+                    type = LIBLTE_ROHC_PACKET_TYPE_UOR_2;
+                }else if(!flow.rnd &&
+                         rohc_wlsb_fits(flow.ip_id_offset, ctx->ip_id_offset_window, ctx->N_window, 6, 0, 0xFFFF) &&
+                         rohc_wlsb_fits(flow.sn, ctx->sn_window, ctx->N_window, 5, rohc_sn_p(5), sn_mask)){
+                    type = LIBLTE_ROHC_PACKET_TYPE_UO_1;
+                }
+            }
+        }
+
+        // Pack the header
+        out = rohc_pkt->msg;
+        if(0 != cid)
+        {
+            *out = ROHC_PACKET_ADD_CID | cid;
+            out++;
+        }
+        if(LIBLTE_ROHC_PACKET_TYPE_IR     == type ||
+           LIBLTE_ROHC_PACKET_TYPE_IR_DYN == type)
+        {
+            if(LIBLTE_ROHC_PACKET_TYPE_IR == type)
+            {
+                // Profile 0x0000 has no dynamic chain
+                *out = ROHC_PACKET_IR;
+                if(LIBLTE_ROHC_PROFILE_UNCOMPRESSED != profile)
+                {
+                    *out |= 0x01;
+                }
+            }else{
+                *out = ROHC_PACKET_IR_DYN;
+            }
+            out++;
+            *out = profile;
+            out++;
+            crc_ptr = out;
+            *out    = 0;
+            out++;
+            if(LIBLTE_ROHC_PROFILE_UNCOMPRESSED != profile)
+            {
+                if(LIBLTE_ROHC_PACKET_TYPE_IR == type)
+                {
+                    rohc_pack_static_chain(&flow, profile, &out);
+                }
+                rohc_pack_dynamic_chain(&flow, profile, ctx->mode, &out);
+            }
+            *crc_ptr = rohc_crc(crc8_table, ROHC_CRC8_INIT, rohc_pkt->msg, out - rohc_pkt->msg);
+            rohc_update_static_crc(&flow, profile);
+        }else if(LIBLTE_ROHC_PACKET_TYPE_NORMAL != type){
+            memcpy(flow.crc3_static, ctx->flow.crc3_static, sizeof(flow.crc3_static));
+            memcpy(flow.crc7_static, ctx->flow.crc7_static, sizeof(flow.crc7_static));
+            m = flow.rtp_m;
+            if(LIBLTE_ROHC_PACKET_TYPE_UO_0 == type)
+            {
+                crc = rohc_crc_dynamic(crc3_table, flow.crc3_static[m], ip_pkt->msg, profile);
+                *out = ((flow.sn & 0x0F) << 3) | crc;
+                out++;
+            }else if(LIBLTE_ROHC_PACKET_TYPE_UO_1 == type){
+                crc = rohc_crc_dynamic(crc3_table, flow.crc3_static[m], ip_pkt->msg, profile);
+                if(LIBLTE_ROHC_PROFILE_RTP == profile)
+                {
+                    if(flow.rnd)
+                    {
+                        *out = 0x80 | (ts_val & 0x3F);
+                    }else{
+                        // UO-1-TS
+                        *out = 0xA0 | (ts_val & 0x1F);
+                    }
+                    out++;
+                    *out = (m << 7) | ((flow.sn & 0x0F) << 3) | crc;
+                    out++;
+                }else{
+                    *out = 0x80 | (flow.ip_id_offset & 0x3F);
+                    out++;
+                    *out = ((flow.sn & 0x1F) << 3) | crc;
+                    out++;
+                }
+            }else{
+                crc = rohc_crc_dynamic(crc7_table, flow.crc7_static[m], ip_pkt->msg, profile);
+                if(LIBLTE_ROHC_PROFILE_RTP == profile)
+                {
+                    if(flow.rnd)
+                    {
+                        *out = 0xC0 | ((ts_val >> 1) & 0x1F);
+                        out++;
+                        *out = ((ts_val & 0x01) << 7) | (m << 6) | (flow.sn & 0x3F);
+                        out++;
+                    }else{
+                        // UOR-2-TS
+                        *out = 0xC0 | (ts_val & 0x1F);
+                        out++;
+                        *out = 0x80 | (m << 6) | (flow.sn & 0x3F);
+                        out++;
+                    }
+                }else{
+                    *out = 0xC0 | (flow.sn & 0x1F);
+                    out++;
+                }
+                *out = crc;
+                out++;
+            }
+
+            // Fields that are sent in every packet
+            if(flow.rnd)
+            {
+                rohc_put_16(flow.ip_id, &out);
+            }
+            if(LIBLTE_ROHC_PROFILE_ESP != profile &&
+               0                       != flow.udp_checksum)
+            {
+                rohc_put_16(flow.udp_checksum, &out);
+            }
+        }
+
+        // Payload
+        memcpy(out, &ip_pkt->msg[hdr_len], ip_pkt->N_bytes - hdr_len);
+        out += ip_pkt->N_bytes - hdr_len;
+
+        // Fill in the number of bytes used
+        rohc_pkt->N_bytes = out - rohc_pkt->msg;
+
+        // Update the context
+        if(flow.ts_stride != ctx->flow.ts_stride)
+        {
+            // Scaled references are only valid for one stride
+            ctx->N_window = 0;
+        }
+        ctx->flow                                = flow;
+        ctx->sn_window[ctx->window_idx]          = flow.sn;
+        ctx->ts_window[ctx->window_idx]          = flow.ts;
+        ctx->ip_id_offset_window[ctx->window_idx] = flow.ip_id_offset;
+        ctx->window_idx                          = (ctx->window_idx + 1) % LIBLTE_ROHC_WLSB_WINDOW_SIZE;
+        if(ctx->N_window < LIBLTE_ROHC_WLSB_WINDOW_SIZE)
+        {
+            ctx->N_window++;
+        }
+        ctx->last_sn = flow.sn;
+        ctx->last_ts = flow.ts;
+        ctx->N_pkts_since_ir++;
+        ctx->N_pkts_since_fo++;
+        if(LIBLTE_ROHC_PACKET_TYPE_IR == type)
+        {
+            ctx->N_pkts_since_ir = 0;
+            ctx->N_pkts_since_fo = 0;
+        }else if(LIBLTE_ROHC_PACKET_TYPE_IR_DYN == type){
+            ctx->N_pkts_since_fo = 0;
+        }
+        if(LIBLTE_ROHC_COMP_STATE_SO != ctx->state)
+        {
+            ctx->N_state_pkts++;
+            if(ctx->N_state_pkts >= LIBLTE_ROHC_L)
+            {
+                ctx->state = LIBLTE_ROHC_COMP_STATE_SO;
+            }
+        }
+        comp->N_pkts[type]++;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_rohc_comp_handle_feedback
+
+    Description: Applies a ROHC feedback packet received from the peer
+                 decompressor.  ACK moves a context to optimistic mode
+                 and the SO state, NACK triggers IR-DYN packets, and
+                 STATIC-NACK triggers IR packets.
+
+    Document Reference: RFC3095 Sections 5.2.2, 5.4.1, and 5.7.6
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_rohc_comp_handle_feedback(LIBLTE_ROHC_COMP_STRUCT *comp,
+                                                   LIBLTE_BYTE_MSG_STRUCT  *feedback)
+{
+    LIBLTE_ROHC_COMP_CONTEXT_STRUCT *ctx;
+    LIBLTE_ERROR_ENUM                err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint8                           *ptr;
+    uint8                           *end;
+    uint8                           *data;
+    uint32                           size;
+    uint32                           cid;
+    uint32                           sn;
+    uint8                            acktype;
+    uint8                            mode;
+
+    if(comp     != NULL &&
+       feedback != NULL)
+    {
+        err = LIBLTE_SUCCESS;
+        ptr = feedback->msg;
+        end = feedback->msg + feedback->N_bytes;
+        while(ptr < end &&
+              LIBLTE_SUCCESS == err)
+        {
+            // Feedback type octet and size
+            size = 0;
+            if(ROHC_PACKET_FEEDBACK == (*ptr & 0xF8))
+            {
+                size = *ptr & 0x07;
+                ptr++;
+                if(0 == size &&
+                   ptr < end)
+                {
+                    size = *ptr;
+                    ptr++;
+                }
+            }
+            if(0 == size ||
+               end - ptr < (int32)size)
+            {
+                err = LIBLTE_ERROR_DECODE_FAIL;
+            }else{
+                data = ptr;
+                ptr += size;
+
+                cid = 0;
+                if(ROHC_PACKET_ADD_CID == (*data & 0xF0))
+                {
+                    cid = *data & 0x0F;
+                    data++;
+                    size--;
+                }
+                ctx = &comp->ctx[cid];
+                if(cid  <= comp->max_cid &&
+                   size >  0             &&
+                   ctx->in_use)
+                {
+                    acktype = ROHC_ACKTYPE_ACK;
+                    mode    = 0;
+                    sn      = data[0];
+                    if(size >= 2)
+                    {
+                        // FEEDBACK-2, options are ignored
+                        acktype = (data[0] >> 6) & 0x03;
+                        mode    = (data[0] >> 4) & 0x03;
+                        sn      = ((data[0] & 0x0F) << 8) | data[1];
+                    }
+                    if(ROHC_FEEDBACK_MODE_O == mode)
+                    {
+                        ctx->mode = LIBLTE_ROHC_MODE_O;
+                    }else if(ROHC_FEEDBACK_MODE_U == mode){
+                        ctx->mode = LIBLTE_ROHC_MODE_U;
+                    }
+
+                    if(ROHC_ACKTYPE_ACK == acktype)
+                    {
+                        // An ACK of the latest packet confirms the whole context
+                        if(LIBLTE_ROHC_COMP_STATE_SO != ctx->state &&
+                           sn                        == (ctx->flow.sn & ((size >= 2) ? 0xFFF : 0xFF)))
+                        {
+                            ctx->state = LIBLTE_ROHC_COMP_STATE_SO;
+                        }
+                    }else if(ROHC_ACKTYPE_NACK == acktype){
+                        if(LIBLTE_ROHC_COMP_STATE_SO == ctx->state)
+                        {
+                            ctx->state = LIBLTE_ROHC_COMP_STATE_FO;
+                        }
+                        ctx->N_state_pkts = 0;
+                    }else if(ROHC_ACKTYPE_STATIC_NACK == acktype){
+                        ctx->state        = LIBLTE_ROHC_COMP_STATE_IR;
+                        ctx->N_state_pkts = 0;
+                    }
+                }
+            }
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_rohc_decomp_init
+
+    Description: Sets up a decompressor for CIDs 0 to max_cid using the
+                 profiles set in the profiles bit mask.  When feedback
+                 is true, the decompressor requests optimistic mode and
+                 produces ACK and NACK feedback.
+
+    Document Reference: RFC3095 Sections 4 and 5
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_rohc_decomp_init(LIBLTE_ROHC_DECOMP_STRUCT *decomp,
+                                          uint32                     max_cid,
+                                          uint32                     profiles,
+                                          bool                       feedback)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(decomp  != NULL &&
+       max_cid <= LIBLTE_ROHC_MAX_CID)
+    {
+        memset(decomp, 0, sizeof(LIBLTE_ROHC_DECOMP_STRUCT));
+        decomp->max_cid  = max_cid;
+        decomp->profiles = profiles | (1 << LIBLTE_ROHC_PROFILE_UNCOMPRESSED);
+        decomp->feedback = feedback;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_rohc_decompress
+
+    Description: Decompresses one ROHC packet into an IP packet.  Any
+                 feedback for the peer compressor is returned in
+                 feedback, which is left empty when there is none.
+                 Packets that fail their CRC are dropped and return
+                 LIBLTE_ERROR_INVALID_CRC.
+
+    Document Reference: RFC3095 Sections 5.3 to 5.7, 5.10, and 5.11
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_rohc_decompress(LIBLTE_ROHC_DECOMP_STRUCT *decomp,
+                                         LIBLTE_BYTE_MSG_STRUCT    *rohc_pkt,
+                                         LIBLTE_BYTE_MSG_STRUCT    *ip_pkt,
+                                         LIBLTE_BYTE_MSG_STRUCT    *feedback)
+{
+    LIBLTE_ROHC_DECOMP_CONTEXT_STRUCT *ctx;
+    LIBLTE_ERROR_ENUM                  err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint8                             *start;
+    uint8                             *ptr;
+    uint8                             *end;
+    uint32                             cid = 0;
+    bool                               ir  = false;
+
+    if(decomp   != NULL &&
+       rohc_pkt != NULL &&
+       ip_pkt   != NULL &&
+       feedback != NULL)
+    {
+        err               = LIBLTE_ERROR_DECODE_FAIL;
+        feedback->N_bytes = 0;
+        ptr               = rohc_pkt->msg;
+        end               = rohc_pkt->msg + rohc_pkt->N_bytes;
+
+        // Padding and Add-CID
+        while(ptr < end &&
+              ROHC_PACKET_PADDING == *ptr)
+        {
+            ptr++;
+        }
+        start = ptr;
+        if(ptr < end &&
+           ROHC_PACKET_ADD_CID == (*ptr & 0xF0))
+        {
+            cid = *ptr & 0x0F;
+            ptr++;
+        }
+
+        if(ptr < end &&
+           cid <= decomp->max_cid)
+        {
+            ctx = &decomp->ctx[cid];
+            if(ROHC_PACKET_IR     == (*ptr & 0xFE) ||
+               ROHC_PACKET_IR_DYN == *ptr)
+            {
+                ir  = true;
+                err = rohc_decomp_ir(decomp, ctx, start, ptr, end, ip_pkt);
+            }else if(LIBLTE_ROHC_DECOMP_STATE_FC           == ctx->state &&
+                     LIBLTE_ROHC_PROFILE_UNCOMPRESSED == ctx->profile){
+                memcpy(ip_pkt->msg, ptr, end - ptr);
+                ip_pkt->N_bytes = end - ptr;
+                err             = LIBLTE_SUCCESS;
+            }else if(LIBLTE_ROHC_DECOMP_STATE_FC == ctx->state){
+                err = rohc_decomp_uo(ctx, ptr, end, ip_pkt);
+            }
+
+            if(LIBLTE_SUCCESS == err)
+            {
+                ctx->N_crc_fail = 0;
+                if(ir                                     &&
+                   decomp->feedback                       &&
+                   LIBLTE_ROHC_PROFILE_UNCOMPRESSED != ctx->profile)
+                {
+                    rohc_pack_feedback(cid, ROHC_ACKTYPE_ACK, ctx->flow.sn, feedback);
+                }
+            }else{
+                // Fall back a state after repeated failures, and ask
+                // for the context to be repaired
+                ctx->N_crc_fail++;
+                if(ctx->N_crc_fail >= LIBLTE_ROHC_DECOMP_N_CRC_FAIL)
+                {
+                    ctx->N_crc_fail = 0;
+                    if(LIBLTE_ROHC_DECOMP_STATE_FC == ctx->state &&
+                       LIBLTE_ERROR_INVALID_CRC    == err)
+                    {
+                        ctx->state = LIBLTE_ROHC_DECOMP_STATE_SC;
+                    }else if(LIBLTE_ROHC_DECOMP_STATE_SC == ctx->state &&
+                             ir                                        &&
+                             LIBLTE_ERROR_INVALID_CRC    == err){
+                        ctx->state = LIBLTE_ROHC_DECOMP_STATE_NC;
+                    }
+                    if(decomp->feedback)
+                    {
+                        if(LIBLTE_ROHC_DECOMP_STATE_NC == ctx->state)
+                        {
+                            rohc_pack_feedback(cid, ROHC_ACKTYPE_STATIC_NACK, 0, feedback);
+                        }else{
+                            rohc_pack_feedback(cid, ROHC_ACKTYPE_NACK, ctx->flow.sn, feedback);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return(err);
+}
+
+/*******************************************************************************
+                              LOCAL FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: rohc_crc
+
+    Description: Continues a CRC-3, CRC-7, or CRC-8 over N_bytes of
+                 data.
+
+    Document Reference: RFC3095 Section 5.9.1
+*********************************************************************/
+uint8 rohc_crc(const uint8 *table,
+               uint8        crc,
+               uint8       *data,
+               uint32       N_bytes)
+{
+    uint32 i;
+
+    for(i=0; i<N_bytes; i++)
+    {
+        crc = table[data[i] ^ crc];
+    }
+
+    return(crc);
+}
+
+/*********************************************************************
+    Name: rohc_update_static_crc
+
+    Description: Computes the CRC-3 and CRC-7 over the CRC-STATIC
+                 octets of a flow, for both values of the RTP marker
+                 bit.  The CRC-STATIC octets only change through IR and
+                 IR-DYN packets, so UO packets only need to run the
+                 CRC over the CRC-DYNAMIC octets.
+
+    Document Reference: RFC3095 Section 5.9.2
+*********************************************************************/
+void rohc_update_static_crc(LIBLTE_ROHC_FLOW_STRUCT  *flow,
+                            LIBLTE_ROHC_PROFILE_ENUM  profile)
+{
+    uint8  buf[26];
+    uint8 *ptr = buf;
+    uint8 *m_ptr = NULL;
+    uint32 m;
+
+    // IPv4 octets 0-1, 6-9, and 12-19
+    *ptr++ = 0x45;
+    *ptr++ = flow->tos;
+    *ptr++ = flow->df ? 0x40 : 0x00;
+    *ptr++ = 0;
+    *ptr++ = flow->ttl;
+    *ptr++ = flow->protocol;
+    rohc_put_32(flow->src_addr, &ptr);
+    rohc_put_32(flow->dst_addr, &ptr);
+
+    if(LIBLTE_ROHC_PROFILE_ESP == profile)
+    {
+        // SPI
+        rohc_put_32(flow->ssrc_spi, &ptr);
+    }else{
+        // UDP octets 0-3
+        rohc_put_16(flow->src_port, &ptr);
+        rohc_put_16(flow->dst_port, &ptr);
+        if(LIBLTE_ROHC_PROFILE_RTP == profile)
+        {
+            // RTP octets 0-1 and 8-11
+            *ptr++ = flow->rtp_flags;
+            m_ptr  = ptr;
+            *ptr++ = flow->rtp_pt;
+            rohc_put_32(flow->ssrc_spi, &ptr);
+        }
+    }
+
+    for(m=0; m<2; m++)
+    {
+        if(NULL != m_ptr)
+        {
+            *m_ptr = (m << 7) | flow->rtp_pt;
+        }
+        flow->crc3_static[m] = rohc_crc(crc3_table, ROHC_CRC3_INIT, buf, ptr - buf);
+        flow->crc7_static[m] = rohc_crc(crc7_table, ROHC_CRC7_INIT, buf, ptr - buf);
+    }
+}
+
+/*********************************************************************
+    Name: rohc_crc_dynamic
+
+    Description: Continues a CRC from the CRC-STATIC octets over the
+                 CRC-DYNAMIC octets of an uncompressed header.
+
+    Document Reference: RFC3095 Section 5.9.2
+*********************************************************************/
+uint8 rohc_crc_dynamic(const uint8              *table,
+                       uint8                     crc,
+                       uint8                    *hdr,
+                       LIBLTE_ROHC_PROFILE_ENUM  profile)
+{
+    // IPv4 octets 2-5 and 10-11
+    crc = rohc_crc(table, crc, &hdr[2], 4);
+    crc = rohc_crc(table, crc, &hdr[10], 2);
+
+    if(LIBLTE_ROHC_PROFILE_ESP == profile)
+    {
+        // ESP SN
+        crc = rohc_crc(table, crc, &hdr[ROHC_IPV4_HDR_LEN + 4], 4);
+    }else{
+        // UDP octets 4-7
+        crc = rohc_crc(table, crc, &hdr[ROHC_IPV4_HDR_LEN + 4], 4);
+        if(LIBLTE_ROHC_PROFILE_RTP == profile)
+        {
+            // RTP octets 2-7
+            crc = rohc_crc(table, crc, &hdr[ROHC_IPV4_HDR_LEN + ROHC_UDP_HDR_LEN + 2], 6);
+        }
+    }
+
+    return(crc);
+}
+
+/*********************************************************************
+    Name: rohc_wlsb_fits
+
+    Description: Checks whether the k least significant bits of value
+                 decode correctly against every reference in a W-LSB
+                 window with interpretation interval offset p.
+
+    Document Reference: RFC3095 Sections 4.5.1 and 4.5.2
+*********************************************************************/
+bool rohc_wlsb_fits(uint32  value,
+                    uint32 *ref,
+                    uint32  N_ref,
+                    uint32  k,
+                    int32   p,
+                    uint32  mask)
+{
+    uint32 i;
+    bool   fits = true;
+
+    for(i=0; i<N_ref; i++)
+    {
+        if(((value - ref[i] + p) & mask) >= ((uint32)1 << k))
+        {
+            fits = false;
+        }
+    }
+
+    return(fits);
+}
+
+/*********************************************************************
+    Name: rohc_wlsb_decode
+
+    Description: Decodes the k least significant bits of a field
+                 against a reference value.
+
+    Document Reference: RFC3095 Section 4.5.1
+*********************************************************************/
+uint32 rohc_wlsb_decode(uint32 lsb,
+                        uint32 ref,
+                        uint32 k,
+                        int32  p,
+                        uint32 mask)
+{
+    uint32 base = ref - p;
+
+    return((base + ((lsb - base) & (((uint32)1 << k) - 1))) & mask);
+}
+
+/*********************************************************************
+    Name: rohc_sn_p
+
+    Description: Interpretation interval offset for k bits of SN.
+
+    Document Reference: RFC3095 Section 4.5.1
+*********************************************************************/
+int32 rohc_sn_p(uint32 k)
+{
+    int32 p = -1;
+
+    if(k > 4)
+    {
+        p = (1 << (k - 5)) - 1;
+    }
+
+    return(p);
+}
+
+/*********************************************************************
+    Name: rohc_ts_p
+
+    Description: Interpretation interval offset for k bits of TS.
+
+    Document Reference: RFC3095 Section 4.5.4
+*********************************************************************/
+int32 rohc_ts_p(uint32 k)
+{
+    return((1 << (k - 2)) - 1);
+}
+
+/*********************************************************************
+    Name: rohc_parse_ip_pkt
+
+    Description: Classifies an IP packet into a profile and fills in
+                 its header fields.  Packets with IP options, fragments,
+                 bad checksums, or unsupported protocols use the
+                 uncompressed profile.
+
+    Document Reference: RFC3095 Sections 5.7.7 and 5.11
+*********************************************************************/
+LIBLTE_ROHC_PROFILE_ENUM rohc_parse_ip_pkt(LIBLTE_ROHC_COMP_STRUCT *comp,
+                                           LIBLTE_BYTE_MSG_STRUCT  *ip_pkt,
+                                           LIBLTE_ROHC_FLOW_STRUCT *flow,
+                                           uint32                  *hdr_len)
+{
+    LIBLTE_ROHC_PROFILE_ENUM  profile = LIBLTE_ROHC_PROFILE_UNCOMPRESSED;
+    uint8                    *msg     = ip_pkt->msg;
+    uint32                    N_bytes = ip_pkt->N_bytes;
+    uint32                    sum     = 0;
+    uint32                    i;
+
+    memset(flow, 0, sizeof(LIBLTE_ROHC_FLOW_STRUCT));
+    *hdr_len = 0;
+
+    if(N_bytes >= ROHC_IPV4_HDR_LEN)
+    {
+        for(i=0; i<ROHC_IPV4_HDR_LEN; i+=2)
+        {
+            sum += rohc_get_16(&msg[i]);
+        }
+        sum = (sum & 0xFFFF) + (sum >> 16);
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+
+    // IPv4 without options or fragmentation and with a valid checksum
+    if(N_bytes                       >= ROHC_IPV4_HDR_LEN &&
+       0x45                          == msg[0]            &&
+       N_bytes                       == rohc_get_16(&msg[2]) &&
+       0                             == (rohc_get_16(&msg[6]) & 0xBFFF) &&
+       0xFFFF                        == sum)
+    {
+        flow->tos      = msg[1];
+        flow->ip_id    = rohc_get_16(&msg[4]);
+        flow->df       = (msg[6] >> 6) & 0x01;
+        flow->ttl      = msg[8];
+        flow->protocol = msg[9];
+        flow->src_addr = rohc_get_32(&msg[12]);
+        flow->dst_addr = rohc_get_32(&msg[16]);
+
+        if(ROHC_IP_PROTOCOL_UDP                  == flow->protocol &&
+           ROHC_IPV4_HDR_LEN + ROHC_UDP_HDR_LEN <= N_bytes        &&
+           N_bytes - ROHC_IPV4_HDR_LEN          == rohc_get_16(&msg[24]))
+        {
+            flow->src_port     = rohc_get_16(&msg[20]);
+            flow->dst_port     = rohc_get_16(&msg[22]);
+            flow->udp_checksum = rohc_get_16(&msg[26]);
+
+            // RTP version 2 without CSRCs or header extension, and not
+            // RTCP (payload types 72 to 76 with the marker bit set)
+            if((comp->profiles & (1 << LIBLTE_ROHC_PROFILE_RTP))                    &&
+               ROHC_IPV4_HDR_LEN + ROHC_UDP_HDR_LEN + ROHC_RTP_HDR_LEN <= N_bytes &&
+               0x80 == (msg[28] & 0xDF)                                          &&
+               ((msg[29] & 0x7F) < 72 || (msg[29] & 0x7F) > 76))
+            {
+                profile         = LIBLTE_ROHC_PROFILE_RTP;
+                *hdr_len        = ROHC_IPV4_HDR_LEN + ROHC_UDP_HDR_LEN + ROHC_RTP_HDR_LEN;
+                flow->rtp_flags = msg[28];
+                flow->rtp_m     = (msg[29] >> 7) & 0x01;
+                flow->rtp_pt    = msg[29] & 0x7F;
+                flow->sn        = rohc_get_16(&msg[30]);
+                flow->ts        = rohc_get_32(&msg[32]);
+                flow->ssrc_spi  = rohc_get_32(&msg[36]);
+            }else if(comp->profiles & (1 << LIBLTE_ROHC_PROFILE_UDP)){
+                profile  = LIBLTE_ROHC_PROFILE_UDP;
+                *hdr_len = ROHC_IPV4_HDR_LEN + ROHC_UDP_HDR_LEN;
+            }
+        }else if(ROHC_IP_PROTOCOL_ESP                        == flow->protocol &&
+                 ROHC_IPV4_HDR_LEN + ROHC_ESP_HDR_LEN       <= N_bytes        &&
+                 (comp->profiles & (1 << LIBLTE_ROHC_PROFILE_ESP))){
+            profile        = LIBLTE_ROHC_PROFILE_ESP;
+            *hdr_len       = ROHC_IPV4_HDR_LEN + ROHC_ESP_HDR_LEN;
+            flow->ssrc_spi = rohc_get_32(&msg[20]);
+            flow->sn       = rohc_get_32(&msg[24]);
+        }
+    }
+
+    return(profile);
+}
+
+/*********************************************************************
+    Name: rohc_comp_find_ctx
+
+    Description: Returns the CID of the context for a flow, setting up
+                 a free or the least recently used context when the
+                 flow is new.
+
+    Document Reference: RFC3095 Section 5.1.1
+*********************************************************************/
+uint32 rohc_comp_find_ctx(LIBLTE_ROHC_COMP_STRUCT  *comp,
+                          LIBLTE_ROHC_PROFILE_ENUM  profile,
+                          LIBLTE_ROHC_FLOW_STRUCT  *flow)
+{
+    LIBLTE_ROHC_COMP_CONTEXT_STRUCT *ctx;
+    uint32                           cid   = comp->last_cid;
+    uint32                           i     = 0;
+    bool                             found = false;
+
+    // Consecutive packets usually belong to the same flow
+    do
+    {
+        ctx = &comp->ctx[cid];
+        if(ctx->in_use &&
+           ctx->profile == profile)
+        {
+            found = true;
+            if(LIBLTE_ROHC_PROFILE_UNCOMPRESSED != profile &&
+               (ctx->flow.src_addr != flow->src_addr ||
+                ctx->flow.dst_addr != flow->dst_addr ||
+                ctx->flow.src_port != flow->src_port ||
+                ctx->flow.dst_port != flow->dst_port ||
+                ctx->flow.ssrc_spi != flow->ssrc_spi))
+            {
+                found = false;
+            }
+        }
+        if(!found)
+        {
+            cid = i;
+            i++;
+        }
+    }while(!found &&
+           cid <= comp->max_cid);
+
+    if(!found)
+    {
+        // Use a free context, or the least recently used one
+        cid = 0;
+        for(i=1; i<=comp->max_cid; i++)
+        {
+            if(comp->ctx[cid].in_use &&
+               (!comp->ctx[i].in_use ||
+                comp->ctx[i].last_used < comp->ctx[cid].last_used))
+            {
+                cid = i;
+            }
+        }
+        ctx = &comp->ctx[cid];
+        memset(ctx, 0, sizeof(LIBLTE_ROHC_COMP_CONTEXT_STRUCT));
+        ctx->flow    = *flow;
+        ctx->last_sn = flow->sn;
+        ctx->last_ts = flow->ts;
+        ctx->profile = profile;
+        ctx->state   = LIBLTE_ROHC_COMP_STATE_IR;
+        ctx->mode    = LIBLTE_ROHC_MODE_U;
+        ctx->in_use  = true;
+    }
+    comp->last_cid = cid;
+
+    return(cid);
+}
+
+/*********************************************************************
+    Name: rohc_comp_update_flow
+
+    Description: Fills in the SN, IP-ID, and TS_STRIDE fields of a new
+                 packet from its context, returning true when a field
+                 that can only be sent in IR or IR-DYN packets changed.
+
+    Document Reference: RFC3095 Sections 4.5.3, 4.5.5, and 5.7
+*********************************************************************/
+bool rohc_comp_update_flow(LIBLTE_ROHC_COMP_CONTEXT_STRUCT *ctx,
+                           LIBLTE_ROHC_FLOW_STRUCT         *flow)
+{
+    uint32 stride;
+    uint32 d_sn;
+    uint32 d_ts;
+    bool   changed = false;
+
+    // UDP has no sequence number of its own, so the compressor makes one up
+    if(LIBLTE_ROHC_PROFILE_UDP == ctx->profile)
+    {
+        flow->sn = (ctx->flow.sn + 1) & 0xFFFF;
+    }
+
+    if(flow->tos != ctx->flow.tos ||
+       flow->ttl != ctx->flow.ttl ||
+       flow->df  != ctx->flow.df)
+    {
+        changed = true;
+    }
+    if(LIBLTE_ROHC_PROFILE_ESP       != ctx->profile &&
+       (0 == flow->udp_checksum)     != (0 == ctx->flow.udp_checksum))
+    {
+        changed = true;
+    }
+    if(LIBLTE_ROHC_PROFILE_RTP == ctx->profile &&
+       (flow->rtp_flags        != ctx->flow.rtp_flags ||
+        flow->rtp_pt           != ctx->flow.rtp_pt))
+    {
+        changed = true;
+    }
+
+    // IP-ID is sent as an offset from SN unless it looks random
+    flow->ip_id_offset = (flow->ip_id - flow->sn) & 0xFFFF;
+    flow->rnd          = ctx->flow.rnd;
+    if(!ctx->flow.rnd)
+    {
+        if(flow->ip_id_offset == ctx->flow.ip_id_offset)
+        {
+            ctx->N_ip_id_jumps = 0;
+        }else if(LIBLTE_ROHC_PROFILE_RTP == ctx->profile ||
+                 !rohc_wlsb_fits(flow->ip_id_offset, ctx->ip_id_offset_window, ctx->N_window, 6, 0, 0xFFFF)){
+            ctx->N_ip_id_jumps++;
+            if(ctx->N_ip_id_jumps >= 2)
+            {
+                flow->rnd = true;
+            }
+            changed = true;
+        }
+    }
+
+    // TS_STRIDE is the TS increase per SN, and is kept while TS stays
+    // a whole number of strides away from the context
+    flow->ts_stride = ctx->flow.ts_stride;
+    if(LIBLTE_ROHC_PROFILE_RTP == ctx->profile)
+    {
+        stride = flow->ts_stride;
+        if(0 == stride ||
+           (flow->ts % stride) != (ctx->flow.ts % stride))
+        {
+            d_sn   = (flow->sn - ctx->last_sn) & 0xFFFF;
+            d_ts   = flow->ts - ctx->last_ts;
+            stride = 0;
+            if(0 != d_sn &&
+               0 != d_ts &&
+               0 == (d_ts % d_sn) &&
+               (d_ts / d_sn) < (1 << 28))
+            {
+                stride = d_ts / d_sn;
+            }
+            if(stride != flow->ts_stride)
+            {
+                flow->ts_stride = stride;
+                changed         = true;
+            }
+        }
+    }
+
+    return(changed);
+}
+
+/*********************************************************************
+    Name: rohc_pack_static_chain
+
+    Description: Packs the static chain of an IR packet.
+
+    Document Reference: RFC3095 Sections 5.7.7 and 5.11
+*********************************************************************/
+void rohc_pack_static_chain(LIBLTE_ROHC_FLOW_STRUCT   *flow,
+                            LIBLTE_ROHC_PROFILE_ENUM   profile,
+                            uint8                    **ptr)
+{
+    // IPv4
+    **ptr = 0x40;
+    (*ptr)++;
+    **ptr = flow->protocol;
+    (*ptr)++;
+    rohc_put_32(flow->src_addr, ptr);
+    rohc_put_32(flow->dst_addr, ptr);
+
+    if(LIBLTE_ROHC_PROFILE_ESP == profile)
+    {
+        // ESP
+        rohc_put_32(flow->ssrc_spi, ptr);
+    }else{
+        // UDP
+        rohc_put_16(flow->src_port, ptr);
+        rohc_put_16(flow->dst_port, ptr);
+
+        // RTP
+        if(LIBLTE_ROHC_PROFILE_RTP == profile)
+        {
+            rohc_put_32(flow->ssrc_spi, ptr);
+        }
+    }
+}
+
+/*********************************************************************
+    Name: rohc_pack_dynamic_chain
+
+    Description: Packs the dynamic chain of an IR or IR-DYN packet.
+
+    Document Reference: RFC3095 Sections 5.7.7 and 5.11
+*********************************************************************/
+void rohc_pack_dynamic_chain(LIBLTE_ROHC_FLOW_STRUCT   *flow,
+                             LIBLTE_ROHC_PROFILE_ENUM   profile,
+                             LIBLTE_ROHC_MODE_ENUM      mode,
+                             uint8                    **ptr)
+{
+    uint32 stride = flow->ts_stride;
+
+    // IPv4, with NBO set and an empty extension header list
+    **ptr = flow->tos;
+    (*ptr)++;
+    **ptr = flow->ttl;
+    (*ptr)++;
+    rohc_put_16(flow->ip_id, ptr);
+    **ptr = (flow->df << 7) | (flow->rnd << 6) | (1 << 5);
+    (*ptr)++;
+    **ptr = 0;
+    (*ptr)++;
+
+    if(LIBLTE_ROHC_PROFILE_ESP == profile)
+    {
+        // ESP
+        rohc_put_32(flow->sn, ptr);
+    }else{
+        // UDP
+        rohc_put_16(flow->udp_checksum, ptr);
+        if(LIBLTE_ROHC_PROFILE_UDP == profile)
+        {
+            rohc_put_16(flow->sn, ptr);
+        }
+
+        // RTP, with RX set to carry the mode and TS_STRIDE
+        if(LIBLTE_ROHC_PROFILE_RTP == profile)
+        {
+            **ptr = 0x80 | (flow->rtp_flags & 0x20) | 0x10;
+            (*ptr)++;
+            **ptr = (flow->rtp_m << 7) | flow->rtp_pt;
+            (*ptr)++;
+            rohc_put_16(flow->sn, ptr);
+            rohc_put_32(flow->ts, ptr);
+            **ptr = 0;
+            (*ptr)++;
+            **ptr = ((mode + 1) << 2) | ((0 != stride) ? 0x01 : 0x00);
+            (*ptr)++;
+
+            // TS_STRIDE as a self-describing variable length value
+            if(0 != stride)
+            {
+                if(stride < (1 << 7))
+                {
+                    **ptr = stride;
+                    (*ptr)++;
+                }else if(stride < (1 << 14)){
+                    rohc_put_16(0x8000 | stride, ptr);
+                }else if(stride < (1 << 21)){
+                    **ptr = 0xC0 | (stride >> 16);
+                    (*ptr)++;
+                    rohc_put_16(stride, ptr);
+                }else{
+                    rohc_put_32(0xE0000000 | stride, ptr);
+                }
+            }
+        }
+    }
+}
+
+/*********************************************************************
+    Name: rohc_unpack_static_chain
+
+    Description: Unpacks the static chain of an IR packet, returning
+                 false if it does not fit in the packet.
+
+    Document Reference: RFC3095 Sections 5.7.7 and 5.11
+*********************************************************************/
+bool rohc_unpack_static_chain(uint8                    **ptr,
+                              uint8                     *end,
+                              LIBLTE_ROHC_PROFILE_ENUM   profile,
+                              LIBLTE_ROHC_FLOW_STRUCT   *flow)
+{
+    uint8 *p  = *ptr;
+    bool   ok = false;
+
+    if(end - p >= 18 &&
+       0x40    == p[0])
+    {
+        ok             = true;
+        flow->protocol = p[1];
+        flow->src_addr = rohc_get_32(&p[2]);
+        flow->dst_addr = rohc_get_32(&p[6]);
+        if(LIBLTE_ROHC_PROFILE_ESP == profile)
+        {
+            flow->ssrc_spi = rohc_get_32(&p[10]);
+            *ptr          += 14;
+        }else{
+            flow->src_port = rohc_get_16(&p[10]);
+            flow->dst_port = rohc_get_16(&p[12]);
+            *ptr          += 14;
+            if(LIBLTE_ROHC_PROFILE_RTP == profile)
+            {
+                flow->ssrc_spi = rohc_get_32(&p[14]);
+                *ptr          += 4;
+            }
+        }
+    }
+
+    return(ok);
+}
+
+/*********************************************************************
+    Name: rohc_unpack_dynamic_chain
+
+    Description: Unpacks the dynamic chain of an IR or IR-DYN packet,
+                 returning false if it does not fit in the packet or
+                 uses options that are not supported.
+
+    Document Reference: RFC3095 Sections 5.7.7 and 5.11
+*********************************************************************/
+bool rohc_unpack_dynamic_chain(uint8                    **ptr,
+                               uint8                     *end,
+                               LIBLTE_ROHC_PROFILE_ENUM   profile,
+                               LIBLTE_ROHC_FLOW_STRUCT   *flow)
+{
+    uint8 *p  = *ptr;
+    bool   ok = false;
+
+    // IPv4, NBO must be set unless IP-ID is random
+    if(end - p >= 6 &&
+       0       == p[5] &&
+       (p[4] & 0x60) != 0x00)
+    {
+        ok          = true;
+        flow->tos   = p[0];
+        flow->ttl   = p[1];
+        flow->ip_id = rohc_get_16(&p[2]);
+        flow->df    = (p[4] >> 7) & 0x01;
+        flow->rnd   = (p[4] >> 6) & 0x01;
+        p          += 6;
+    }
+
+    if(ok &&
+       LIBLTE_ROHC_PROFILE_ESP == profile)
+    {
+        ok = false;
+        if(end - p >= 4)
+        {
+            ok       = true;
+            flow->sn = rohc_get_32(p);
+            p       += 4;
+        }
+    }else if(ok &&
+             LIBLTE_ROHC_PROFILE_UDP == profile){
+        ok = false;
+        if(end - p >= 4)
+        {
+            ok                 = true;
+            flow->udp_checksum = rohc_get_16(p);
+            flow->sn           = rohc_get_16(&p[2]);
+            p                 += 4;
+        }
+    }else if(ok &&
+             LIBLTE_ROHC_PROFILE_RTP == profile){
+        // UDP checksum, V P RX CC, M PT, SN, TS, and an empty CSRC list
+        ok = false;
+        if(end - p >= 11    &&
+           0x80 == (p[2] & 0xCF) &&
+           0    == p[10])
+        {
+            ok                 = true;
+            flow->udp_checksum = rohc_get_16(p);
+            flow->rtp_flags    = p[2] & 0xA0;
+            flow->rtp_m        = (p[3] >> 7) & 0x01;
+            flow->rtp_pt       = p[3] & 0x7F;
+            flow->sn           = rohc_get_16(&p[4]);
+            flow->ts           = rohc_get_32(&p[6]);
+            flow->ts_stride    = 0;
+            p                 += 11;
+
+            // Reserved X Mode TIS TSS, X and TIS are not supported
+            if(0x10 == (p[-9] & 0x10))
+            {
+                ok = false;
+                if(end - p >= 1 &&
+                   0 == (p[0] & 0xF2))
+                {
+                    ok = true;
+                    if(p[0] & 0x01)
+                    {
+                        p++;
+                        ok = false;
+                        if(end - p >= 1 &&
+                           0 == (p[0] & 0x80))
+                        {
+                            ok              = true;
+                            flow->ts_stride = p[0];
+                            p              += 1;
+                        }else if(end - p >= 2 &&
+                                 0x80 == (p[0] & 0xC0)){
+                            ok              = true;
+                            flow->ts_stride = rohc_get_16(p) & 0x3FFF;
+                            p              += 2;
+                        }else if(end - p >= 3 &&
+                                 0xC0 == (p[0] & 0xE0)){
+                            ok              = true;
+                            flow->ts_stride = ((p[0] & 0x1F) << 16) | rohc_get_16(&p[1]);
+                            p              += 3;
+                        }else if(end - p >= 4 &&
+                                 0xE0 == (p[0] & 0xF0)){
+                            ok              = true;
+                            flow->ts_stride = rohc_get_32(p) & 0x0FFFFFFF;
+                            p              += 4;
+                        }
+                    }else{
+                        p++;
+                    }
+                }
+            }
+        }
+    }else{
+        ok = false;
+    }
+
+    if(ok)
+    {
+        flow->ip_id_offset = (flow->ip_id - flow->sn) & 0xFFFF;
+        *ptr               = p;
+    }
+
+    return(ok);
+}
+
+/*********************************************************************
+    Name: rohc_build_ip_pkt
+
+    Description: Rebuilds the uncompressed headers of a flow followed
+                 by the payload, returning false if the packet does not
+                 fit.
+
+    Document Reference: RFC3095 Section 5.7.7
+*********************************************************************/
+bool rohc_build_ip_pkt(LIBLTE_ROHC_FLOW_STRUCT  *flow,
+                       LIBLTE_ROHC_PROFILE_ENUM  profile,
+                       uint8                    *payload,
+                       uint32                    N_payload_bytes,
+                       LIBLTE_BYTE_MSG_STRUCT   *ip_pkt)
+{
+    uint8  *ptr     = ip_pkt->msg;
+    uint32  hdr_len = ROHC_IPV4_HDR_LEN + ROHC_ESP_HDR_LEN;
+    uint32  sum     = 0;
+    uint32  i;
+    bool    ok      = false;
+
+    if(LIBLTE_ROHC_PROFILE_UDP == profile)
+    {
+        hdr_len = ROHC_IPV4_HDR_LEN + ROHC_UDP_HDR_LEN;
+    }else if(LIBLTE_ROHC_PROFILE_RTP == profile){
+        hdr_len = ROHC_IPV4_HDR_LEN + ROHC_UDP_HDR_LEN + ROHC_RTP_HDR_LEN;
+    }
+
+    if(hdr_len + N_payload_bytes <= LIBLTE_MAX_MSG_SIZE)
+    {
+        ok = true;
+
+        // IPv4
+        *ptr++ = 0x45;
+        *ptr++ = flow->tos;
+        rohc_put_16(hdr_len + N_payload_bytes, &ptr);
+        rohc_put_16(flow->ip_id, &ptr);
+        *ptr++ = flow->df ? 0x40 : 0x00;
+        *ptr++ = 0;
+        *ptr++ = flow->ttl;
+        *ptr++ = flow->protocol;
+        rohc_put_16(0, &ptr);
+        rohc_put_32(flow->src_addr, &ptr);
+        rohc_put_32(flow->dst_addr, &ptr);
+        for(i=0; i<ROHC_IPV4_HDR_LEN; i+=2)
+        {
+            sum += rohc_get_16(&ip_pkt->msg[i]);
+        }
+        sum = (sum & 0xFFFF) + (sum >> 16);
+        sum = (sum & 0xFFFF) + (sum >> 16);
+        ip_pkt->msg[10] = (~sum >> 8) & 0xFF;
+        ip_pkt->msg[11] = ~sum & 0xFF;
+
+        if(LIBLTE_ROHC_PROFILE_ESP == profile)
+        {
+            // ESP
+            rohc_put_32(flow->ssrc_spi, &ptr);
+            rohc_put_32(flow->sn, &ptr);
+        }else{
+            // UDP
+            rohc_put_16(flow->src_port, &ptr);
+            rohc_put_16(flow->dst_port, &ptr);
+            rohc_put_16(hdr_len + N_payload_bytes - ROHC_IPV4_HDR_LEN, &ptr);
+            rohc_put_16(flow->udp_checksum, &ptr);
+
+            // RTP
+            if(LIBLTE_ROHC_PROFILE_RTP == profile)
+            {
+                *ptr++ = flow->rtp_flags;
+                *ptr++ = (flow->rtp_m << 7) | flow->rtp_pt;
+                rohc_put_16(flow->sn, &ptr);
+                rohc_put_32(flow->ts, &ptr);
+                rohc_put_32(flow->ssrc_spi, &ptr);
+            }
+        }
+
+        // Payload
+        memcpy(ptr, payload, N_payload_bytes);
+        ip_pkt->N_bytes = hdr_len + N_payload_bytes;
+    }
+
+    return(ok);
+}
+
+/*********************************************************************
+    Name: rohc_decomp_ir
+
+    Description: Decompresses an IR or IR-DYN packet and updates the
+                 context when its CRC passes.
+
+    Document Reference: RFC3095 Sections 5.7.7 and 5.10.1
+*********************************************************************/
+LIBLTE_ERROR_ENUM rohc_decomp_ir(LIBLTE_ROHC_DECOMP_STRUCT         *decomp,
+                                 LIBLTE_ROHC_DECOMP_CONTEXT_STRUCT *ctx,
+                                 uint8                             *start,
+                                 uint8                             *ptr,
+                                 uint8                             *end,
+                                 LIBLTE_BYTE_MSG_STRUCT            *ip_pkt)
+{
+    LIBLTE_ROHC_FLOW_STRUCT   flow;
+    LIBLTE_ROHC_PROFILE_ENUM  profile;
+    LIBLTE_ERROR_ENUM         err    = LIBLTE_ERROR_DECODE_FAIL;
+    uint8                    *crc_ptr;
+    uint8                     type;
+    uint8                     crc;
+    uint8                     zero   = 0;
+    bool                      ok     = false;
+
+    if(end - ptr >= 3)
+    {
+        type    = ptr[0];
+        profile = (LIBLTE_ROHC_PROFILE_ENUM)ptr[1];
+        crc_ptr = &ptr[2];
+        ptr    += 3;
+        if(profile < LIBLTE_ROHC_PROFILE_N_ITEMS &&
+           (decomp->profiles & (1 << profile)))
+        {
+            if(ROHC_PACKET_IR_DYN == type)
+            {
+                // IR-DYN needs the static chain from an earlier IR
+                if(LIBLTE_ROHC_DECOMP_STATE_NC           != ctx->state   &&
+                   profile                               == ctx->profile &&
+                   LIBLTE_ROHC_PROFILE_UNCOMPRESSED != profile)
+                {
+                    flow = ctx->flow;
+                    ok   = rohc_unpack_dynamic_chain(&ptr, end, profile, &flow);
+                }
+            }else if(LIBLTE_ROHC_PROFILE_UNCOMPRESSED == profile){
+                memset(&flow, 0, sizeof(LIBLTE_ROHC_FLOW_STRUCT));
+                ok = true;
+            }else if(type & 0x01){
+                memset(&flow, 0, sizeof(LIBLTE_ROHC_FLOW_STRUCT));
+                ok = (rohc_unpack_static_chain(&ptr, end, profile, &flow) &&
+                      rohc_unpack_dynamic_chain(&ptr, end, profile, &flow));
+            }
+        }
+
+        if(ok)
+        {
+            // The CRC covers the header with the CRC field set to zero
+            crc = rohc_crc(crc8_table, ROHC_CRC8_INIT, start, crc_ptr - start);
+            crc = rohc_crc(crc8_table, crc, &zero, 1);
+            crc = rohc_crc(crc8_table, crc, crc_ptr + 1, ptr - (crc_ptr + 1));
+            err = LIBLTE_ERROR_INVALID_CRC;
+            if(crc == *crc_ptr)
+            {
+                err = LIBLTE_ERROR_DECODE_FAIL;
+                if(LIBLTE_ROHC_PROFILE_UNCOMPRESSED == profile)
+                {
+                    memcpy(ip_pkt->msg, ptr, end - ptr);
+                    ip_pkt->N_bytes = end - ptr;
+                    err             = LIBLTE_SUCCESS;
+                }else if(rohc_build_ip_pkt(&flow, profile, ptr, end - ptr, ip_pkt)){
+                    err = LIBLTE_SUCCESS;
+                }
+                if(LIBLTE_SUCCESS == err)
+                {
+                    rohc_update_static_crc(&flow, profile);
+                    ctx->flow    = flow;
+                    ctx->profile = profile;
+                    ctx->state   = LIBLTE_ROHC_DECOMP_STATE_FC;
+                }
+            }
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: rohc_decomp_uo
+
+    Description: Decompresses a UO-0, UO-1, or UOR-2 packet and updates
+                 the context when its CRC passes.
+
+    Document Reference: RFC3095 Sections 5.7.1 to 5.7.4 and 5.11
+*********************************************************************/
+LIBLTE_ERROR_ENUM rohc_decomp_uo(LIBLTE_ROHC_DECOMP_CONTEXT_STRUCT *ctx,
+                                 uint8                             *ptr,
+                                 uint8                             *end,
+                                 LIBLTE_BYTE_MSG_STRUCT            *ip_pkt)
+{
+    LIBLTE_ROHC_FLOW_STRUCT flow      = ctx->flow;
+    LIBLTE_ERROR_ENUM       err       = LIBLTE_ERROR_DECODE_FAIL;
+    uint32                  sn_mask   = 0xFFFF;
+    uint32                  stride    = flow.ts_stride;
+    uint32                  ts_offset = 0;
+    uint32                  ts_ref    = flow.ts;
+    uint32                  ts_lsb    = 0;
+    uint32                  ts_bits   = 0;
+    uint32                  ts_val;
+    uint8                   crc       = 0;
+    uint8                   crc_calc;
+    bool                    crc7      = false;
+    bool                    ok        = false;
+
+    if(LIBLTE_ROHC_PROFILE_ESP == ctx->profile)
+    {
+        sn_mask = 0xFFFFFFFF;
+    }
+    if(0 != stride)
+    {
+        ts_offset = flow.ts % stride;
+        ts_ref    = (flow.ts - ts_offset) / stride;
+    }
+    flow.rtp_m = false;
+
+    if(0 == (ptr[0] & 0x80))
+    {
+        // UO-0
+        flow.sn = rohc_wlsb_decode((ptr[0] >> 3) & 0x0F, ctx->flow.sn, 4, rohc_sn_p(4), sn_mask);
+        crc     = ptr[0] & 0x07;
+        ptr    += 1;
+        ok      = true;
+    }else if(0x80 == (ptr[0] & 0xC0) &&
+             end - ptr >= 2){
+        // UO-1
+        crc = ptr[1] & 0x07;
+        if(LIBLTE_ROHC_PROFILE_RTP == ctx->profile)
+        {
+            if(flow.rnd)
+            {
+                ok      = true;
+                ts_lsb  = ptr[0] & 0x3F;
+                ts_bits = 6;
+            }else if(ptr[0] & 0x20){
+                // UO-1-TS, UO-1-ID is not supported
+                ok      = true;
+                ts_lsb  = ptr[0] & 0x1F;
+                ts_bits = 5;
+            }
+            flow.rtp_m = (ptr[1] >> 7) & 0x01;
+            flow.sn    = rohc_wlsb_decode((ptr[1] >> 3) & 0x0F, ctx->flow.sn, 4, rohc_sn_p(4), sn_mask);
+        }else if(!flow.rnd){
+            ok                = true;
+            flow.ip_id_offset = rohc_wlsb_decode(ptr[0] & 0x3F, ctx->flow.ip_id_offset, 6, 0, 0xFFFF);
+            flow.sn           = rohc_wlsb_decode((ptr[1] >> 3) & 0x1F, ctx->flow.sn, 5, rohc_sn_p(5), sn_mask);
+        }
+        ptr += 2;
+    }else if(0xC0 == (ptr[0] & 0xE0)){
+        // UOR-2 without extensions
+        crc7 = true;
+        if(LIBLTE_ROHC_PROFILE_RTP == ctx->profile &&
+           end - ptr >= 3)
+        {
+            if(flow.rnd)
+            {
+                ok      = true;
+                ts_lsb  = ((ptr[0] & 0x1F) << 1) | ((ptr[1] >> 7) & 0x01);
+                ts_bits = 6;
+            }else if(ptr[1] & 0x80){
+                // UOR-2-TS, UOR-2-ID is not supported
+                ok      = true;
+                ts_lsb  = ptr[0] & 0x1F;
+                ts_bits = 5;
+            }
+            flow.rtp_m = (ptr[1] >> 6) & 0x01;
+            flow.sn    = rohc_wlsb_decode(ptr[1] & 0x3F, ctx->flow.sn, 6, rohc_sn_p(6), sn_mask);
+            crc        = ptr[2];
+            ptr       += 3;
+        }else if(LIBLTE_ROHC_PROFILE_RTP != ctx->profile &&
+                 end - ptr >= 2){
+            ok      = true;
+            flow.sn = rohc_wlsb_decode(ptr[0] & 0x1F, ctx->flow.sn, 5, rohc_sn_p(5), sn_mask);
+            crc     = ptr[1];
+            ptr    += 2;
+        }
+        if(crc & 0x80)
+        {
+            // Extensions are not supported
+            ok = false;
+        }
+    }
+
+    if(ok &&
+       LIBLTE_ROHC_PROFILE_RTP == ctx->profile)
+    {
+        // TS is either sent or follows SN
+        if(0 != ts_bits)
+        {
+            ts_val = rohc_wlsb_decode(ts_lsb, ts_ref, ts_bits, rohc_ts_p(ts_bits), 0xFFFFFFFF);
+        }else{
+            ts_val = ts_ref;
+            if(0 != stride)
+            {
+                ts_val += (flow.sn - ctx->flow.sn) & 0xFFFF;
+            }
+        }
+        flow.ts = ts_val;
+        if(0 != stride)
+        {
+            flow.ts = ts_val*stride + ts_offset;
+        }
+    }
+
+    // IP-ID and UDP checksum
+    if(ok)
+    {
+        if(flow.rnd)
+        {
+            ok = false;
+            if(end - ptr >= 2)
+            {
+                ok         = true;
+                flow.ip_id = rohc_get_16(ptr);
+                ptr       += 2;
+            }
+        }else{
+            flow.ip_id = (flow.sn + flow.ip_id_offset) & 0xFFFF;
+        }
+    }
+    if(ok                                   &&
+       LIBLTE_ROHC_PROFILE_ESP != ctx->profile &&
+       0                       != flow.udp_checksum)
+    {
+        ok = false;
+        if(end - ptr >= 2)
+        {
+            ok                = true;
+            flow.udp_checksum = rohc_get_16(ptr);
+            ptr              += 2;
+        }
+    }
+
+    if(ok &&
+       rohc_build_ip_pkt(&flow, ctx->profile, ptr, end - ptr, ip_pkt))
+    {
+        if(crc7)
+        {
+            crc_calc = rohc_crc_dynamic(crc7_table, flow.crc7_static[flow.rtp_m], ip_pkt->msg, ctx->profile);
+        }else{
+            crc_calc = rohc_crc_dynamic(crc3_table, flow.crc3_static[flow.rtp_m], ip_pkt->msg, ctx->profile);
+        }
+        err = LIBLTE_ERROR_INVALID_CRC;
+        if((crc & 0x7F) == crc_calc)
+        {
+            ctx->flow = flow;
+            err       = LIBLTE_SUCCESS;
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: rohc_pack_feedback
+
+    Description: Packs a FEEDBACK-2 packet.
+
+    Document Reference: RFC3095 Sections 5.2.2 and 5.7.6.1
+*********************************************************************/
+void rohc_pack_feedback(uint32                  cid,
+                        uint8                   acktype,
+                        uint32                  sn,
+                        LIBLTE_BYTE_MSG_STRUCT *feedback)
+{
+    uint8 *ptr = feedback->msg;
+
+    if(0 != cid)
+    {
+        *ptr++ = ROHC_PACKET_FEEDBACK | 3;
+        *ptr++ = ROHC_PACKET_ADD_CID | cid;
+    }else{
+        *ptr++ = ROHC_PACKET_FEEDBACK | 2;
+    }
+    *ptr++ = (acktype << 6) | (ROHC_FEEDBACK_MODE_O << 4) | ((sn >> 8) & 0x0F);
+    *ptr++ = sn & 0xFF;
+
+    feedback->N_bytes = ptr - feedback->msg;
+}
+
+/*********************************************************************
+    Name: rohc_put_16/rohc_put_32/rohc_get_16/rohc_get_32
+
+    Description: Network byte order field access.
+
+    Document Reference: N/A
+*********************************************************************/
+void rohc_put_16(uint32   value,
+                 uint8  **ptr)
+{
+    (*ptr)[0] = (value >> 8) & 0xFF;
+    (*ptr)[1] = value & 0xFF;
+    *ptr     += 2;
+}
+void rohc_put_32(uint32   value,
+                 uint8  **ptr)
+{
+    (*ptr)[0] = (value >> 24) & 0xFF;
+    (*ptr)[1] = (value >> 16) & 0xFF;
+    (*ptr)[2] = (value >> 8) & 0xFF;
+    (*ptr)[3] = value & 0xFF;
+    *ptr     += 4;
+}
+uint32 rohc_get_16(uint8 *ptr)
+{
+    return((ptr[0] << 8) | ptr[1]);
+}
+uint32 rohc_get_32(uint8 *ptr)
+{
+    return(((uint32)ptr[0] << 24) | (ptr[1] << 16) | (ptr[2] << 8) | ptr[3]);
+}
@@ -5782,8 +5782,14 @@ LIBLTE_ERROR_ENUM liblte_rrc_pack_pdcp_config_ie(LIBLTE_RRC_PDCP_CONFIG_STRUCT
             // Extension indicator
             liblte_value_2_bits(0, ie_ptr, 1);
 
+            // Optional indicator, Max CID defaults to 15
+            liblte_value_2_bits(15 != pdcp_cnfg->hdr_compression_max_cid, ie_ptr, 1);
+
             // Max CID
-            liblte_value_2_bits(pdcp_cnfg->hdr_compression_max_cid - 1, ie_ptr, 14);
+            if(15 != pdcp_cnfg->hdr_compression_max_cid)
+            {
+                liblte_value_2_bits(pdcp_cnfg->hdr_compression_max_cid - 1, ie_ptr, 14);
+            }
 
             // Profiles
             liblte_value_2_bits(pdcp_cnfg->hdr_compression_profile_0001, ie_ptr, 1);
@@ -5843,8 +5849,12 @@ LIBLTE_ERROR_ENUM liblte_rrc_unpack_pdcp_config_ie(uint8
             // Extension indicator
             liblte_bits_2_value(ie_ptr, 1);
 
-            // Max CID
-            pdcp_cnfg->hdr_compression_max_cid = liblte_bits_2_value(ie_ptr, 14) + 1;
+            // Optional indicator and Max CID, which defaults to 15
+            pdcp_cnfg->hdr_compression_max_cid = 15;
+            if(liblte_bits_2_value(ie_ptr, 1))
+            {
+                pdcp_cnfg->hdr_compression_max_cid = liblte_bits_2_value(ie_ptr, 14) + 1;
+            }
 
             // Profiles
             pdcp_cnfg->hdr_compression_profile_0001 = liblte_bits_2_value(ie_ptr, 1);
@@ -7140,12 +7150,12 @@ LIBLTE_ERROR_ENUM liblte_rrc_pack_rr_config_dedicated_ie(LIBLTE_RRC_RR_CONFIG_DE
         }
 
         // Extension
-        // Optional indicators
-        liblte_value_2_bits(rr_cnfg->rlf_timers_and_constants_present, ie_ptr, 1);
-
-        // RLF Timers and Constants
         if(rr_cnfg->rlf_timers_and_constants_present)
         {
+            // Optional indicators
+            liblte_value_2_bits(rr_cnfg->rlf_timers_and_constants_present, ie_ptr, 1);
+
+            // RLF Timers and Constants
             liblte_rrc_pack_rlf_timers_and_constants_ie(&rr_cnfg->rlf_timers_and_constants, ie_ptr);
         }
 
@@ -11020,9 +11030,9 @@ LIBLTE_ERROR_ENUM liblte_rrc_unpack_rrc_connection_reestablishment_request_msg(L
         if(!liblte_bits_2_value(&msg_ptr, 1))
         {
             // UE Identity
-            liblte_rrc_unpack_c_rnti_ie(&msg_ptr, (uint16 *)&con_reest_req->ue_id);
-            liblte_rrc_unpack_phys_cell_id_ie(&msg_ptr, (uint16 *)&con_reest_req->ue_id);
-            liblte_rrc_unpack_short_mac_i_ie(&msg_ptr, (uint16 *)&con_reest_req->ue_id);
+            liblte_rrc_unpack_c_rnti_ie(&msg_ptr, &con_reest_req->ue_id.c_rnti);
+            liblte_rrc_unpack_phys_cell_id_ie(&msg_ptr, &con_reest_req->ue_id.phys_cell_id);
+            liblte_rrc_unpack_short_mac_i_ie(&msg_ptr, &con_reest_req->ue_id.short_mac_i);
 
             // Reestablishment Cause
             con_reest_req->cause = (LIBLTE_RRC_CON_REEST_REQ_CAUSE_ENUM)liblte_bits_2_value(&msg_ptr, 2);
@@ -11772,6 +11782,7 @@ LIBLTE_ERROR_ENUM liblte_rrc_pack_paging_msg(LIBLTE_RRC_PAGING_STRUCT *page,
 
         // Fill in the number of bits used
         msg->N_bits = msg_ptr - msg->msg;
+        err = LIBLTE_SUCCESS;
     }
 
     return(err);
@@ -12147,8 +12158,9 @@ LIBLTE_ERROR_ENUM liblte_rrc_unpack_bcch_bch_msg(LIBLTE_BIT_MSG_STRUCT *msg,
     LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
     uint8             *msg_ptr = msg->msg;
 
-    if(msg != NULL &&
-       mib != NULL)
+    if(msg                   != NULL &&
+       mib                   != NULL &&
+       LIBLTE_RRC_MIB_N_BITS <= msg->N_bits)
     {
         // DL Bandwidth
         mib->dl_bw = (LIBLTE_RRC_DL_BANDWIDTH_ENUM)liblte_bits_2_value(&msg_ptr, 3);
@@ -12314,8 +12326,9 @@ LIBLTE_ERROR_ENUM liblte_rrc_unpack_pcch_msg(LIBLTE_BIT_MSG_STRUCT      *msg,
         if((msg->N_bits-(msg_ptr-msg->msg)) <= (LIBLTE_MAX_MSG_SIZE - 1))
         {
             memcpy(global_msg.msg, msg_ptr, msg->N_bits-(msg_ptr-msg->msg));
-            err = liblte_rrc_unpack_paging_msg(&global_msg,
-                                               pcch_msg);
+            global_msg.N_bits = msg->N_bits-(msg_ptr-msg->msg);
+            err               = liblte_rrc_unpack_paging_msg(&global_msg,
+                                                             pcch_msg);
         }
     }
 
@@ -43,18 +43,21 @@
                               DEFINES
 *******************************************************************************/
 
+#define ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+// SNOW 3G S-boxes S1 and S2 as one table and rotations
+#define SNOW3G_S(t, w) (t[(w) >> 24] ^ ROTR32(t[((w) >> 16) & 0xFF], 8) ^ ROTR32(t[((w) >> 8) & 0xFF], 16) ^ ROTR32(t[(w) & 0xFF], 24))
+
+// ZUC S-box and linear transforms
+#define ZUC_S(x)  ((ZUC_S0[(x) >> 24] << 24) | (ZUC_S1[((x) >> 16) & 0xFF] << 16) | (ZUC_S0[((x) >> 8) & 0xFF] << 8) | ZUC_S1[(x) & 0xFF])
+#define ZUC_L1(x) ((x) ^ ROTL32(x, 2) ^ ROTL32(x, 10) ^ ROTL32(x, 18) ^ ROTL32(x, 24))
+#define ZUC_L2(x) ((x) ^ ROTL32(x, 8) ^ ROTL32(x, 14) ^ ROTL32(x, 22) ^ ROTL32(x, 30))
 
 /*******************************************************************************
                               TYPEDEFS
 *******************************************************************************/
 
-typedef struct{
-    uint8 rk[11][4][4];
-}ROUND_KEY_STRUCT;
-
-typedef struct{
-    uint8 state[4][4];
-}STATE_STRUCT;
 
 /*******************************************************************************
                               GLOBAL VARIABLES
@@ -97,107 +100,537 @@ static const uint8 X_TIME[256] = {  0,  2,  4,  6,  8, 10, 12, 14, 16, 18, 20, 2
                                   219,217,223,221,211,209,215,213,203,201,207,205,195,193,199,197,
                                   251,249,255,253,243,241,247,245,235,233,239,237,227,225,231,229};
 
+// AES SubBytes and MixColumns for the first row, later rows are rotations
+static const uint32 AES_T[256] = {0xC66363A5,0xF87C7C84,0xEE777799,0xF67B7B8D,0xFFF2F20D,0xD66B6BBD,
+                                  0xDE6F6FB1,0x91C5C554,0x60303050,0x02010103,0xCE6767A9,0x562B2B7D,
+                                  0xE7FEFE19,0xB5D7D762,0x4DABABE6,0xEC76769A,0x8FCACA45,0x1F82829D,
+                                  0x89C9C940,0xFA7D7D87,0xEFFAFA15,0xB25959EB,0x8E4747C9,0xFBF0F00B,
+                                  0x41ADADEC,0xB3D4D467,0x5FA2A2FD,0x45AFAFEA,0x239C9CBF,0x53A4A4F7,
+                                  0xE4727296,0x9BC0C05B,0x75B7B7C2,0xE1FDFD1C,0x3D9393AE,0x4C26266A,
+                                  0x6C36365A,0x7E3F3F41,0xF5F7F702,0x83CCCC4F,0x6834345C,0x51A5A5F4,
+                                  0xD1E5E534,0xF9F1F108,0xE2717193,0xABD8D873,0x62313153,0x2A15153F,
+                                  0x0804040C,0x95C7C752,0x46232365,0x9DC3C35E,0x30181828,0x379696A1,
+                                  0x0A05050F,0x2F9A9AB5,0x0E070709,0x24121236,0x1B80809B,0xDFE2E23D,
+                                  0xCDEBEB26,0x4E272769,0x7FB2B2CD,0xEA75759F,0x1209091B,0x1D83839E,
+                                  0x582C2C74,0x341A1A2E,0x361B1B2D,0xDC6E6EB2,0xB45A5AEE,0x5BA0A0FB,
+                                  0xA45252F6,0x763B3B4D,0xB7D6D661,0x7DB3B3CE,0x5229297B,0xDDE3E33E,
+                                  0x5E2F2F71,0x13848497,0xA65353F5,0xB9D1D168,0x00000000,0xC1EDED2C,
+                                  0x40202060,0xE3FCFC1F,0x79B1B1C8,0xB65B5BED,0xD46A6ABE,0x8DCBCB46,
+                                  0x67BEBED9,0x7239394B,0x944A4ADE,0x984C4CD4,0xB05858E8,0x85CFCF4A,
+                                  0xBBD0D06B,0xC5EFEF2A,0x4FAAAAE5,0xEDFBFB16,0x864343C5,0x9A4D4DD7,
+                                  0x66333355,0x11858594,0x8A4545CF,0xE9F9F910,0x04020206,0xFE7F7F81,
+                                  0xA05050F0,0x783C3C44,0x259F9FBA,0x4BA8A8E3,0xA25151F3,0x5DA3A3FE,
+                                  0x804040C0,0x058F8F8A,0x3F9292AD,0x219D9DBC,0x70383848,0xF1F5F504,
+                                  0x63BCBCDF,0x77B6B6C1,0xAFDADA75,0x42212163,0x20101030,0xE5FFFF1A,
+                                  0xFDF3F30E,0xBFD2D26D,0x81CDCD4C,0x180C0C14,0x26131335,0xC3ECEC2F,
+                                  0xBE5F5FE1,0x359797A2,0x884444CC,0x2E171739,0x93C4C457,0x55A7A7F2,
+                                  0xFC7E7E82,0x7A3D3D47,0xC86464AC,0xBA5D5DE7,0x3219192B,0xE6737395,
+                                  0xC06060A0,0x19818198,0x9E4F4FD1,0xA3DCDC7F,0x44222266,0x542A2A7E,
+                                  0x3B9090AB,0x0B888883,0x8C4646CA,0xC7EEEE29,0x6BB8B8D3,0x2814143C,
+                                  0xA7DEDE79,0xBC5E5EE2,0x160B0B1D,0xADDBDB76,0xDBE0E03B,0x64323256,
+                                  0x743A3A4E,0x140A0A1E,0x924949DB,0x0C06060A,0x4824246C,0xB85C5CE4,
+                                  0x9FC2C25D,0xBDD3D36E,0x43ACACEF,0xC46262A6,0x399191A8,0x319595A4,
+                                  0xD3E4E437,0xF279798B,0xD5E7E732,0x8BC8C843,0x6E373759,0xDA6D6DB7,
+                                  0x018D8D8C,0xB1D5D564,0x9C4E4ED2,0x49A9A9E0,0xD86C6CB4,0xAC5656FA,
+                                  0xF3F4F407,0xCFEAEA25,0xCA6565AF,0xF47A7A8E,0x47AEAEE9,0x10080818,
+                                  0x6FBABAD5,0xF0787888,0x4A25256F,0x5C2E2E72,0x381C1C24,0x57A6A6F1,
+                                  0x73B4B4C7,0x97C6C651,0xCBE8E823,0xA1DDDD7C,0xE874749C,0x3E1F1F21,
+                                  0x964B4BDD,0x61BDBDDC,0x0D8B8B86,0x0F8A8A85,0xE0707090,0x7C3E3E42,
+                                  0x71B5B5C4,0xCC6666AA,0x904848D8,0x06030305,0xF7F6F601,0x1C0E0E12,
+                                  0xC26161A3,0x6A35355F,0xAE5757F9,0x69B9B9D0,0x17868691,0x99C1C158,
+                                  0x3A1D1D27,0x279E9EB9,0xD9E1E138,0xEBF8F813,0x2B9898B3,0x22111133,
+                                  0xD26969BB,0xA9D9D970,0x078E8E89,0x339494A7,0x2D9B9BB6,0x3C1E1E22,
+                                  0x15878792,0xC9E9E920,0x87CECE49,0xAA5555FF,0x50282878,0xA5DFDF7A,
+                                  0x038C8C8F,0x59A1A1F8,0x09898980,0x1A0D0D17,0x65BFBFDA,0xD7E6E631,
+                                  0x844242C6,0xD06868B8,0x824141C3,0x299999B0,0x5A2D2D77,0x1E0F0F11,
+                                  0x7BB0B0CB,0xA85454FC,0x6DBBBBD6,0x2C16163A};
+
+// SNOW 3G S1 and S2 for w0, w1 to w3 are rotations
+static const uint32 SNOW3G_S1_T[256] = {0xC6A56363,0xF8847C7C,0xEE997777,0xF68D7B7B,0xFF0DF2F2,0xD6BD6B6B,
+                                        0xDEB16F6F,0x9154C5C5,0x60503030,0x02030101,0xCEA96767,0x567D2B2B,
+                                        0xE719FEFE,0xB562D7D7,0x4DE6ABAB,0xEC9A7676,0x8F45CACA,0x1F9D8282,
+                                        0x8940C9C9,0xFA877D7D,0xEF15FAFA,0xB2EB5959,0x8EC94747,0xFB0BF0F0,
+                                        0x41ECADAD,0xB367D4D4,0x5FFDA2A2,0x45EAAFAF,0x23BF9C9C,0x53F7A4A4,
+                                        0xE4967272,0x9B5BC0C0,0x75C2B7B7,0xE11CFDFD,0x3DAE9393,0x4C6A2626,
+                                        0x6C5A3636,0x7E413F3F,0xF502F7F7,0x834FCCCC,0x685C3434,0x51F4A5A5,
+                                        0xD134E5E5,0xF908F1F1,0xE2937171,0xAB73D8D8,0x62533131,0x2A3F1515,
+                                        0x080C0404,0x9552C7C7,0x46652323,0x9D5EC3C3,0x30281818,0x37A19696,
+                                        0x0A0F0505,0x2FB59A9A,0x0E090707,0x24361212,0x1B9B8080,0xDF3DE2E2,
+                                        0xCD26EBEB,0x4E692727,0x7FCDB2B2,0xEA9F7575,0x121B0909,0x1D9E8383,
+                                        0x58742C2C,0x342E1A1A,0x362D1B1B,0xDCB26E6E,0xB4EE5A5A,0x5BFBA0A0,
+                                        0xA4F65252,0x764D3B3B,0xB761D6D6,0x7DCEB3B3,0x527B2929,0xDD3EE3E3,
+                                        0x5E712F2F,0x13978484,0xA6F55353,0xB968D1D1,0x00000000,0xC12CEDED,
+                                        0x40602020,0xE31FFCFC,0x79C8B1B1,0xB6ED5B5B,0xD4BE6A6A,0x8D46CBCB,
+                                        0x67D9BEBE,0x724B3939,0x94DE4A4A,0x98D44C4C,0xB0E85858,0x854ACFCF,
+                                        0xBB6BD0D0,0xC52AEFEF,0x4FE5AAAA,0xED16FBFB,0x86C54343,0x9AD74D4D,
+                                        0x66553333,0x11948585,0x8ACF4545,0xE910F9F9,0x04060202,0xFE817F7F,
+                                        0xA0F05050,0x78443C3C,0x25BA9F9F,0x4BE3A8A8,0xA2F35151,0x5DFEA3A3,
+                                        0x80C04040,0x058A8F8F,0x3FAD9292,0x21BC9D9D,0x70483838,0xF104F5F5,
+                                        0x63DFBCBC,0x77C1B6B6,0xAF75DADA,0x42632121,0x20301010,0xE51AFFFF,
+                                        0xFD0EF3F3,0xBF6DD2D2,0x814CCDCD,0x18140C0C,0x26351313,0xC32FECEC,
+                                        0xBEE15F5F,0x35A29797,0x88CC4444,0x2E391717,0x9357C4C4,0x55F2A7A7,
+                                        0xFC827E7E,0x7A473D3D,0xC8AC6464,0xBAE75D5D,0x322B1919,0xE6957373,
+                                        0xC0A06060,0x19988181,0x9ED14F4F,0xA37FDCDC,0x44662222,0x547E2A2A,
+                                        0x3BAB9090,0x0B838888,0x8CCA4646,0xC729EEEE,0x6BD3B8B8,0x283C1414,
+                                        0xA779DEDE,0xBCE25E5E,0x161D0B0B,0xAD76DBDB,0xDB3BE0E0,0x64563232,
+                                        0x744E3A3A,0x141E0A0A,0x92DB4949,0x0C0A0606,0x486C2424,0xB8E45C5C,
+                                        0x9F5DC2C2,0xBD6ED3D3,0x43EFACAC,0xC4A66262,0x39A89191,0x31A49595,
+                                        0xD337E4E4,0xF28B7979,0xD532E7E7,0x8B43C8C8,0x6E593737,0xDAB76D6D,
+                                        0x018C8D8D,0xB164D5D5,0x9CD24E4E,0x49E0A9A9,0xD8B46C6C,0xACFA5656,
+                                        0xF307F4F4,0xCF25EAEA,0xCAAF6565,0xF48E7A7A,0x47E9AEAE,0x10180808,
+                                        0x6FD5BABA,0xF0887878,0x4A6F2525,0x5C722E2E,0x38241C1C,0x57F1A6A6,
+                                        0x73C7B4B4,0x9751C6C6,0xCB23E8E8,0xA17CDDDD,0xE89C7474,0x3E211F1F,
+                                        0x96DD4B4B,0x61DCBDBD,0x0D868B8B,0x0F858A8A,0xE0907070,0x7C423E3E,
+                                        0x71C4B5B5,0xCCAA6666,0x90D84848,0x06050303,0xF701F6F6,0x1C120E0E,
+                                        0xC2A36161,0x6A5F3535,0xAEF95757,0x69D0B9B9,0x17918686,0x9958C1C1,
+                                        0x3A271D1D,0x27B99E9E,0xD938E1E1,0xEB13F8F8,0x2BB39898,0x22331111,
+                                        0xD2BB6969,0xA970D9D9,0x07898E8E,0x33A79494,0x2DB69B9B,0x3C221E1E,
+                                        0x15928787,0xC920E9E9,0x8749CECE,0xAAFF5555,0x50782828,0xA57ADFDF,
+                                        0x038F8C8C,0x59F8A1A1,0x09808989,0x1A170D0D,0x65DABFBF,0xD731E6E6,
+                                        0x84C64242,0xD0B86868,0x82C34141,0x29B09999,0x5A772D2D,0x1E110F0F,
+                                        0x7BCBB0B0,0xA8FC5454,0x6DD6BBBB,0x2C3A1616};
+
+static const uint32 SNOW3G_S2_T[256] = {0x4A6F2525,0x486C2424,0xE6957373,0xCEA96767,0xC710D7D7,0x359BAEAE,
+                                        0xB8E45C5C,0x60503030,0x2185A4A4,0xB55BEEEE,0xDCB26E6E,0xFF34CBCB,
+                                        0xFA877D7D,0x03B6B5B5,0x6DEF8282,0xDF04DBDB,0xA145E4E4,0x75FB8E8E,
+                                        0x90D84848,0x92DB4949,0x9ED14F4F,0xBAE75D5D,0xD4BE6A6A,0xF0887878,
+                                        0xE0907070,0x79F18888,0xB951E8E8,0xBEE15F5F,0xBCE25E5E,0x61E58484,
+                                        0xCAAF6565,0xAD4FE2E2,0xD901D8D8,0xBB52E9E9,0xF13DCCCC,0xB35EEDED,
+                                        0x80C04040,0x5E712F2F,0x22331111,0x50782828,0xAEF95757,0xCD1FD2D2,
+                                        0x319DACAC,0xAF4CE3E3,0x94DE4A4A,0x2A3F1515,0x362D1B1B,0x1BA2B9B9,
+                                        0x0DBFB2B2,0x69E98080,0x63E68585,0x2583A6A6,0x5C722E2E,0x04060202,
+                                        0x8EC94747,0x527B2929,0x0E090707,0x96DD4B4B,0x1C120E0E,0xEB2AC1C1,
+                                        0xA2F35151,0x3D97AAAA,0x7BF28989,0xC115D4D4,0xFD37CACA,0x02030101,
+                                        0x8CCA4646,0x0FBCB3B3,0xB758EFEF,0xD30EDDDD,0x88CC4444,0xF68D7B7B,
+                                        0xED2FC2C2,0xFE817F7F,0x15ABBEBE,0xEF2CC3C3,0x57C89F9F,0x40602020,
+                                        0x98D44C4C,0xC8AC6464,0x6FEC8383,0x2D8FA2A2,0xD0B86868,0x84C64242,
+                                        0x26351313,0x01B5B4B4,0x82C34141,0xF33ECDCD,0x1DA7BABA,0xE523C6C6,
+                                        0x1FA4BBBB,0xDAB76D6D,0x9AD74D4D,0xE2937171,0x42632121,0x8175F4F4,
+                                        0x73FE8D8D,0x09B9B0B0,0xA346E5E5,0x4FDC9393,0x956BFEFE,0x77F88F8F,
+                                        0xA543E6E6,0xF738CFCF,0x86C54343,0x8ACF4545,0x62533131,0x44662222,
+                                        0x6E593737,0x6C5A3636,0x45D39696,0x9D67FAFA,0x11ADBCBC,0x1E110F0F,
+                                        0x10180808,0xA4F65252,0x3A271D1D,0xAAFF5555,0x342E1A1A,0xE326C5C5,
+                                        0x9CD24E4E,0x46652323,0xD2BB6969,0xF48E7A7A,0x4DDF9292,0x9768FFFF,
+                                        0xB6ED5B5B,0xB4EE5A5A,0xBF54EBEB,0x5DC79A9A,0x38241C1C,0x3B92A9A9,
+                                        0xCB1AD1D1,0xFC827E7E,0x1A170D0D,0x916DFCFC,0xA0F05050,0x7DF78A8A,
+                                        0x05B3B6B6,0xC4A66262,0x8376F5F5,0x141E0A0A,0x9961F8F8,0xD10DDCDC,
+                                        0x06050303,0x78443C3C,0x18140C0C,0x724B3939,0x8B7AF1F1,0x19A1B8B8,
+                                        0x8F7CF3F3,0x7A473D3D,0x8D7FF2F2,0xC316D5D5,0x47D09797,0xCCAA6666,
+                                        0x6BEA8181,0x64563232,0x2989A0A0,0x00000000,0x0C0A0606,0xF53BCECE,
+                                        0x8573F6F6,0xBD57EAEA,0x07B0B7B7,0x2E391717,0x8770F7F7,0x71FD8C8C,
+                                        0xF28B7979,0xC513D6D6,0x2780A7A7,0x17A8BFBF,0x7FF48B8B,0x7E413F3F,
+                                        0x3E211F1F,0xA6F55353,0xC6A56363,0xEA9F7575,0x6A5F3535,0x58742C2C,
+                                        0xC0A06060,0x936EFDFD,0x4E692727,0xCF1CD3D3,0x41D59494,0x2386A5A5,
+                                        0xF8847C7C,0x2B8AA1A1,0x0A0F0505,0xB0E85858,0x5A772D2D,0x13AEBDBD,
+                                        0xDB02D9D9,0xE720C7C7,0x3798AFAF,0xD6BD6B6B,0xA8FC5454,0x161D0B0B,
+                                        0xA949E0E0,0x70483838,0x080C0404,0xF931C8C8,0x53CE9D9D,0xA740E7E7,
+                                        0x283C1414,0x0BBAB1B1,0x67E08787,0x51CD9C9C,0xD708DFDF,0xDEB16F6F,
+                                        0x9B62F9F9,0xDD07DADA,0x547E2A2A,0xE125C4C4,0xB2EB5959,0x2C3A1616,
+                                        0xE89C7474,0x4BDA9191,0x3F94ABAB,0x4C6A2626,0xC2A36161,0xEC9A7676,
+                                        0x685C3434,0x567D2B2B,0x339EADAD,0x5BC29999,0x9F64FBFB,0xE4967272,
+                                        0xB15DECEC,0x66553333,0x24361212,0xD50BDEDE,0x59C19898,0x764D3B3B,
+                                        0xE929C0C0,0x5FC49B9B,0x7C423E3E,0x30281818,0x20301010,0x744E3A3A,
+                                        0xACFA5656,0xAB4AE1E1,0xEE997777,0xFB32C9C9,0x3C221E1E,0x55CB9E9E,
+                                        0x43D69595,0x2F8CA3A3,0x49D99090,0x322B1919,0x3991A8A8,0xD8B46C6C,
+                                        0x121B0909,0xC919D0D0,0x8979F0F0,0x65E38686};
+
+// SNOW 3G multiplication and division by alpha
+static const uint32 SNOW3G_MUL_ALPHA[256] = {0x00000000,0xE19FCF13,0x6B973726,0x8A08F835,0xD6876E4C,0x3718A15F,
+                                             0xBD10596A,0x5C8F9679,0x05A7DC98,0xE438138B,0x6E30EBBE,0x8FAF24AD,
+                                             0xD320B2D4,0x32BF7DC7,0xB8B785F2,0x59284AE1,0x0AE71199,0xEB78DE8A,
+                                             0x617026BF,0x80EFE9AC,0xDC607FD5,0x3DFFB0C6,0xB7F748F3,0x566887E0,
+                                             0x0F40CD01,0xEEDF0212,0x64D7FA27,0x85483534,0xD9C7A34D,0x38586C5E,
+                                             0xB250946B,0x53CF5B78,0x1467229B,0xF5F8ED88,0x7FF015BD,0x9E6FDAAE,
+                                             0xC2E04CD7,0x237F83C4,0xA9777BF1,0x48E8B4E2,0x11C0FE03,0xF05F3110,
+                                             0x7A57C925,0x9BC80636,0xC747904F,0x26D85F5C,0xACD0A769,0x4D4F687A,
+                                             0x1E803302,0xFF1FFC11,0x75170424,0x9488CB37,0xC8075D4E,0x2998925D,
+                                             0xA3906A68,0x420FA57B,0x1B27EF9A,0xFAB82089,0x70B0D8BC,0x912F17AF,
+                                             0xCDA081D6,0x2C3F4EC5,0xA637B6F0,0x47A879E3,0x28CE449F,0xC9518B8C,
+                                             0x435973B9,0xA2C6BCAA,0xFE492AD3,0x1FD6E5C0,0x95DE1DF5,0x7441D2E6,
+                                             0x2D699807,0xCCF65714,0x46FEAF21,0xA7616032,0xFBEEF64B,0x1A713958,
+                                             0x9079C16D,0x71E60E7E,0x22295506,0xC3B69A15,0x49BE6220,0xA821AD33,
+                                             0xF4AE3B4A,0x1531F459,0x9F390C6C,0x7EA6C37F,0x278E899E,0xC611468D,
+                                             0x4C19BEB8,0xAD8671AB,0xF109E7D2,0x109628C1,0x9A9ED0F4,0x7B011FE7,
+                                             0x3CA96604,0xDD36A917,0x573E5122,0xB6A19E31,0xEA2E0848,0x0BB1C75B,
+                                             0x81B93F6E,0x6026F07D,0x390EBA9C,0xD891758F,0x52998DBA,0xB30642A9,
+                                             0xEF89D4D0,0x0E161BC3,0x841EE3F6,0x65812CE5,0x364E779D,0xD7D1B88E,
+                                             0x5DD940BB,0xBC468FA8,0xE0C919D1,0x0156D6C2,0x8B5E2EF7,0x6AC1E1E4,
+                                             0x33E9AB05,0xD2766416,0x587E9C23,0xB9E15330,0xE56EC549,0x04F10A5A,
+                                             0x8EF9F26F,0x6F663D7C,0x50358897,0xB1AA4784,0x3BA2BFB1,0xDA3D70A2,
+                                             0x86B2E6DB,0x672D29C8,0xED25D1FD,0x0CBA1EEE,0x5592540F,0xB40D9B1C,
+                                             0x3E056329,0xDF9AAC3A,0x83153A43,0x628AF550,0xE8820D65,0x091DC276,
+                                             0x5AD2990E,0xBB4D561D,0x3145AE28,0xD0DA613B,0x8C55F742,0x6DCA3851,
+                                             0xE7C2C064,0x065D0F77,0x5F754596,0xBEEA8A85,0x34E272B0,0xD57DBDA3,
+                                             0x89F22BDA,0x686DE4C9,0xE2651CFC,0x03FAD3EF,0x4452AA0C,0xA5CD651F,
+                                             0x2FC59D2A,0xCE5A5239,0x92D5C440,0x734A0B53,0xF942F366,0x18DD3C75,
+                                             0x41F57694,0xA06AB987,0x2A6241B2,0xCBFD8EA1,0x977218D8,0x76EDD7CB,
+                                             0xFCE52FFE,0x1D7AE0ED,0x4EB5BB95,0xAF2A7486,0x25228CB3,0xC4BD43A0,
+                                             0x9832D5D9,0x79AD1ACA,0xF3A5E2FF,0x123A2DEC,0x4B12670D,0xAA8DA81E,
+                                             0x2085502B,0xC11A9F38,0x9D950941,0x7C0AC652,0xF6023E67,0x179DF174,
+                                             0x78FBCC08,0x9964031B,0x136CFB2E,0xF2F3343D,0xAE7CA244,0x4FE36D57,
+                                             0xC5EB9562,0x24745A71,0x7D5C1090,0x9CC3DF83,0x16CB27B6,0xF754E8A5,
+                                             0xABDB7EDC,0x4A44B1CF,0xC04C49FA,0x21D386E9,0x721CDD91,0x93831282,
+                                             0x198BEAB7,0xF81425A4,0xA49BB3DD,0x45047CCE,0xCF0C84FB,0x2E934BE8,
+                                             0x77BB0109,0x9624CE1A,0x1C2C362F,0xFDB3F93C,0xA13C6F45,0x40A3A056,
+                                             0xCAAB5863,0x2B349770,0x6C9CEE93,0x8D032180,0x070BD9B5,0xE69416A6,
+                                             0xBA1B80DF,0x5B844FCC,0xD18CB7F9,0x301378EA,0x693B320B,0x88A4FD18,
+                                             0x02AC052D,0xE333CA3E,0xBFBC5C47,0x5E239354,0xD42B6B61,0x35B4A472,
+                                             0x667BFF0A,0x87E43019,0x0DECC82C,0xEC73073F,0xB0FC9146,0x51635E55,
+                                             0xDB6BA660,0x3AF46973,0x63DC2392,0x8243EC81,0x084B14B4,0xE9D4DBA7,
+                                             0xB55B4DDE,0x54C482CD,0xDECC7AF8,0x3F53B5EB};
+
+static const uint32 SNOW3G_DIV_ALPHA[256] = {0x00000000,0x180F40CD,0x301E8033,0x2811C0FE,0x603CA966,0x7833E9AB,
+                                             0x50222955,0x482D6998,0xC078FBCC,0xD877BB01,0xF0667BFF,0xE8693B32,
+                                             0xA04452AA,0xB84B1267,0x905AD299,0x88559254,0x29F05F31,0x31FF1FFC,
+                                             0x19EEDF02,0x01E19FCF,0x49CCF657,0x51C3B69A,0x79D27664,0x61DD36A9,
+                                             0xE988A4FD,0xF187E430,0xD99624CE,0xC1996403,0x89B40D9B,0x91BB4D56,
+                                             0xB9AA8DA8,0xA1A5CD65,0x5249BE62,0x4A46FEAF,0x62573E51,0x7A587E9C,
+                                             0x32751704,0x2A7A57C9,0x026B9737,0x1A64D7FA,0x923145AE,0x8A3E0563,
+                                             0xA22FC59D,0xBA208550,0xF20DECC8,0xEA02AC05,0xC2136CFB,0xDA1C2C36,
+                                             0x7BB9E153,0x63B6A19E,0x4BA76160,0x53A821AD,0x1B854835,0x038A08F8,
+                                             0x2B9BC806,0x339488CB,0xBBC11A9F,0xA3CE5A52,0x8BDF9AAC,0x93D0DA61,
+                                             0xDBFDB3F9,0xC3F2F334,0xEBE333CA,0xF3EC7307,0xA492D5C4,0xBC9D9509,
+                                             0x948C55F7,0x8C83153A,0xC4AE7CA2,0xDCA13C6F,0xF4B0FC91,0xECBFBC5C,
+                                             0x64EA2E08,0x7CE56EC5,0x54F4AE3B,0x4CFBEEF6,0x04D6876E,0x1CD9C7A3,
+                                             0x34C8075D,0x2CC74790,0x8D628AF5,0x956DCA38,0xBD7C0AC6,0xA5734A0B,
+                                             0xED5E2393,0xF551635E,0xDD40A3A0,0xC54FE36D,0x4D1A7139,0x551531F4,
+                                             0x7D04F10A,0x650BB1C7,0x2D26D85F,0x35299892,0x1D38586C,0x053718A1,
+                                             0xF6DB6BA6,0xEED42B6B,0xC6C5EB95,0xDECAAB58,0x96E7C2C0,0x8EE8820D,
+                                             0xA6F942F3,0xBEF6023E,0x36A3906A,0x2EACD0A7,0x06BD1059,0x1EB25094,
+                                             0x569F390C,0x4E9079C1,0x6681B93F,0x7E8EF9F2,0xDF2B3497,0xC724745A,
+                                             0xEF35B4A4,0xF73AF469,0xBF179DF1,0xA718DD3C,0x8F091DC2,0x97065D0F,
+                                             0x1F53CF5B,0x075C8F96,0x2F4D4F68,0x37420FA5,0x7F6F663D,0x676026F0,
+                                             0x4F71E60E,0x577EA6C3,0xE18D0321,0xF98243EC,0xD1938312,0xC99CC3DF,
+                                             0x81B1AA47,0x99BEEA8A,0xB1AF2A74,0xA9A06AB9,0x21F5F8ED,0x39FAB820,
+                                             0x11EB78DE,0x09E43813,0x41C9518B,0x59C61146,0x71D7D1B8,0x69D89175,
+                                             0xC87D5C10,0xD0721CDD,0xF863DC23,0xE06C9CEE,0xA841F576,0xB04EB5BB,
+                                             0x985F7545,0x80503588,0x0805A7DC,0x100AE711,0x381B27EF,0x20146722,
+                                             0x68390EBA,0x70364E77,0x58278E89,0x4028CE44,0xB3C4BD43,0xABCBFD8E,
+                                             0x83DA3D70,0x9BD57DBD,0xD3F81425,0xCBF754E8,0xE3E69416,0xFBE9D4DB,
+                                             0x73BC468F,0x6BB30642,0x43A2C6BC,0x5BAD8671,0x1380EFE9,0x0B8FAF24,
+                                             0x239E6FDA,0x3B912F17,0x9A34E272,0x823BA2BF,0xAA2A6241,0xB225228C,
+                                             0xFA084B14,0xE2070BD9,0xCA16CB27,0xD2198BEA,0x5A4C19BE,0x42435973,
+                                             0x6A52998D,0x725DD940,0x3A70B0D8,0x227FF015,0x0A6E30EB,0x12617026,
+                                             0x451FD6E5,0x5D109628,0x750156D6,0x6D0E161B,0x25237F83,0x3D2C3F4E,
+                                             0x153DFFB0,0x0D32BF7D,0x85672D29,0x9D686DE4,0xB579AD1A,0xAD76EDD7,
+                                             0xE55B844F,0xFD54C482,0xD545047C,0xCD4A44B1,0x6CEF89D4,0x74E0C919,
+                                             0x5CF109E7,0x44FE492A,0x0CD320B2,0x14DC607F,0x3CCDA081,0x24C2E04C,
+                                             0xAC977218,0xB49832D5,0x9C89F22B,0x8486B2E6,0xCCABDB7E,0xD4A49BB3,
+                                             0xFCB55B4D,0xE4BA1B80,0x17566887,0x0F59284A,0x2748E8B4,0x3F47A879,
+                                             0x776AC1E1,0x6F65812C,0x477441D2,0x5F7B011F,0xD72E934B,0xCF21D386,
+                                             0xE7301378,0xFF3F53B5,0xB7123A2D,0xAF1D7AE0,0x870CBA1E,0x9F03FAD3,
+                                             0x3EA637B6,0x26A9777B,0x0EB8B785,0x16B7F748,0x5E9A9ED0,0x4695DE1D,
+                                             0x6E841EE3,0x768B5E2E,0xFEDECC7A,0xE6D18CB7,0xCEC04C49,0xD6CF0C84,
+                                             0x9EE2651C,0x86ED25D1,0xAEFCE52F,0xB6F3A5E2};
+
+// ZUC S-boxes and key loading constants
+static const uint8 ZUC_S0[256] = {0x3E,0x72,0x5B,0x47,0xCA,0xE0,0x00,0x33,0x04,0xD1,0x54,0x98,0x09,0xB9,0x6D,0xCB,
+                                  0x7B,0x1B,0xF9,0x32,0xAF,0x9D,0x6A,0xA5,0xB8,0x2D,0xFC,0x1D,0x08,0x53,0x03,0x90,
+                                  0x4D,0x4E,0x84,0x99,0xE4,0xCE,0xD9,0x91,0xDD,0xB6,0x85,0x48,0x8B,0x29,0x6E,0xAC,
+                                  0xCD,0xC1,0xF8,0x1E,0x73,0x43,0x69,0xC6,0xB5,0xBD,0xFD,0x39,0x63,0x20,0xD4,0x38,
+                                  0x76,0x7D,0xB2,0xA7,0xCF,0xED,0x57,0xC5,0xF3,0x2C,0xBB,0x14,0x21,0x06,0x55,0x9B,
+                                  0xE3,0xEF,0x5E,0x31,0x4F,0x7F,0x5A,0xA4,0x0D,0x82,0x51,0x49,0x5F,0xBA,0x58,0x1C,
+                                  0x4A,0x16,0xD5,0x17,0xA8,0x92,0x24,0x1F,0x8C,0xFF,0xD8,0xAE,0x2E,0x01,0xD3,0xAD,
+                                  0x3B,0x4B,0xDA,0x46,0xEB,0xC9,0xDE,0x9A,0x8F,0x87,0xD7,0x3A,0x80,0x6F,0x2F,0xC8,
+                                  0xB1,0xB4,0x37,0xF7,0x0A,0x22,0x13,0x28,0x7C,0xCC,0x3C,0x89,0xC7,0xC3,0x96,0x56,
+                                  0x07,0xBF,0x7E,0xF0,0x0B,0x2B,0x97,0x52,0x35,0x41,0x79,0x61,0xA6,0x4C,0x10,0xFE,
+                                  0xBC,0x26,0x95,0x88,0x8A,0xB0,0xA3,0xFB,0xC0,0x18,0x94,0xF2,0xE1,0xE5,0xE9,0x5D,
+                                  0xD0,0xDC,0x11,0x66,0x64,0x5C,0xEC,0x59,0x42,0x75,0x12,0xF5,0x74,0x9C,0xAA,0x23,
+                                  0x0E,0x86,0xAB,0xBE,0x2A,0x02,0xE7,0x67,0xE6,0x44,0xA2,0x6C,0xC2,0x93,0x9F,0xF1,
+                                  0xF6,0xFA,0x36,0xD2,0x50,0x68,0x9E,0x62,0x71,0x15,0x3D,0xD6,0x40,0xC4,0xE2,0x0F,
+                                  0x8E,0x83,0x77,0x6B,0x25,0x05,0x3F,0x0C,0x30,0xEA,0x70,0xB7,0xA1,0xE8,0xA9,0x65,
+                                  0x8D,0x27,0x1A,0xDB,0x81,0xB3,0xA0,0xF4,0x45,0x7A,0x19,0xDF,0xEE,0x78,0x34,0x60};
+
+static const uint8 ZUC_S1[256] = {0x55,0xC2,0x63,0x71,0x3B,0xC8,0x47,0x86,0x9F,0x3C,0xDA,0x5B,0x29,0xAA,0xFD,0x77,
+                                  0x8C,0xC5,0x94,0x0C,0xA6,0x1A,0x13,0x00,0xE3,0xA8,0x16,0x72,0x40,0xF9,0xF8,0x42,
+                                  0x44,0x26,0x68,0x96,0x81,0xD9,0x45,0x3E,0x10,0x76,0xC6,0xA7,0x8B,0x39,0x43,0xE1,
+                                  0x3A,0xB5,0x56,0x2A,0xC0,0x6D,0xB3,0x05,0x22,0x66,0xBF,0xDC,0x0B,0xFA,0x62,0x48,
+                                  0xDD,0x20,0x11,0x06,0x36,0xC9,0xC1,0xCF,0xF6,0x27,0x52,0xBB,0x69,0xF5,0xD4,0x87,
+                                  0x7F,0x84,0x4C,0xD2,0x9C,0x57,0xA4,0xBC,0x4F,0x9A,0xDF,0xFE,0xD6,0x8D,0x7A,0xEB,
+                                  0x2B,0x53,0xD8,0x5C,0xA1,0x14,0x17,0xFB,0x23,0xD5,0x7D,0x30,0x67,0x73,0x08,0x09,
+                                  0xEE,0xB7,0x70,0x3F,0x61,0xB2,0x19,0x8E,0x4E,0xE5,0x4B,0x93,0x8F,0x5D,0xDB,0xA9,
+                                  0xAD,0xF1,0xAE,0x2E,0xCB,0x0D,0xFC,0xF4,0x2D,0x46,0x6E,0x1D,0x97,0xE8,0xD1,0xE9,
+                                  0x4D,0x37,0xA5,0x75,0x5E,0x83,0x9E,0xAB,0x82,0x9D,0xB9,0x1C,0xE0,0xCD,0x49,0x89,
+                                  0x01,0xB6,0xBD,0x58,0x24,0xA2,0x5F,0x38,0x78,0x99,0x15,0x90,0x50,0xB8,0x95,0xE4,
+                                  0xD0,0x91,0xC7,0xCE,0xED,0x0F,0xB4,0x6F,0xA0,0xCC,0xF0,0x02,0x4A,0x79,0xC3,0xDE,
+                                  0xA3,0xEF,0xEA,0x51,0xE6,0x6B,0x18,0xEC,0x1B,0x2C,0x80,0xF7,0x74,0xE7,0xFF,0x21,
+                                  0x5A,0x6A,0x54,0x1E,0x41,0x31,0x92,0x35,0xC4,0x33,0x07,0x0A,0xBA,0x7E,0x0E,0x34,
+                                  0x88,0xB1,0x98,0x7C,0xF3,0x3D,0x60,0x6C,0x7B,0xCA,0xD3,0x1F,0x32,0x65,0x04,0x28,
+                                  0x64,0xBE,0x85,0x9B,0x2F,0x59,0x8A,0xD7,0xB0,0x25,0xAC,0xAF,0x12,0x03,0xE2,0xF2};
+
+static const uint32 ZUC_D[16] = {0x44D7,0x26BC,0x626B,0x135E,0x5789,0x35E2,0x7135,0x09AF,
+                                 0x4D78,0x2F13,0x6BC4,0x1AF1,0x5E26,0x3C4D,0x789A,0x47AC};
+
 /*******************************************************************************
                               LOCAL FUNCTION PROTOTYPES
 *******************************************************************************/
 
 /*********************************************************************
-    Name: compute_OPc
+    Name: aes_128_key_schedule
 
-    Description: Computes OPc from OP and K.
+    Description: Computes the AES-128 round keys as big endian column
+                 words.
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: FIPS 197 Section 5.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void compute_OPc(ROUND_KEY_STRUCT *rk,
-                 uint8            *op,
-                 uint8            *op_c);
+void aes_128_key_schedule(uint8  *key,
+                          uint32 *rk);
 
 /*********************************************************************
-    Name: rijndael_key_schedule
+    Name: aes_128_encrypt
 
-    Description: Computes all Rijndael's internal subkeys from key.
+    Description: Encrypts one block, held as four big endian words,
+                 with AES-128, using a single combined SubBytes/
+                 ShiftRows/MixColumns table and rotations for the other
+                 three columns.
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: FIPS 197 Section 5.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void rijndael_key_schedule(uint8            *key,
-                           ROUND_KEY_STRUCT *rk);
+void aes_128_encrypt(uint32 *rk,
+                     uint32 *input,
+                     uint32 *output);
 
 /*********************************************************************
-    Name: rijndael_encrypt
+    Name: aes_128_encrypt_x4
 
-    Description: Computes output using input and round keys.
+    Description: Encrypts four independent blocks with AES-128, each
+                 with its own round keys, interleaving the rounds so
+                 the table lookups of one block overlap with those of
+                 the others.
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: FIPS 197 Section 5.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void rijndael_encrypt(uint8            *input,
-                      ROUND_KEY_STRUCT *rk,
-                      uint8            *output);
+void aes_128_encrypt_x4(uint32 **rk,
+                        uint32   input[4][4],
+                        uint32   output[4][4]);
 
 /*********************************************************************
-    Name: key_add
+    Name: aes_128_load_block
 
-    Description: Round key addition function.
+    Description: Loads a 16 byte block as four big endian words.
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void key_add(STATE_STRUCT     *state,
-             ROUND_KEY_STRUCT *rk,
-             uint32            round);
+void aes_128_load_block(uint8  *in,
+                        uint32 *out);
 
 /*********************************************************************
-    Name: byte_sub
+    Name: milenage_input
 
-    Description: Byte substitution transformation.
+    Description: Computes the input block of a Milenage output
+                 function, rot(x XOR OPc, r) XOR c, with the rotation
+                 given in words.
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: 35.206 v10.0.0 Section 4.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void byte_sub(STATE_STRUCT *state);
+void milenage_input(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                    uint32                              *x,
+                    uint32                               rot,
+                    uint32                               c,
+                    uint32                              *input);
 
 /*********************************************************************
-    Name: shift_row
+    Name: milenage_temp
 
-    Description: Row shift transformation.
+    Description: Computes TEMP from RAND.
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: 35.206 v10.0.0 Section 4.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void shift_row(STATE_STRUCT *state);
+void milenage_temp(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                   uint8                               *rand,
+                   uint32                              *temp);
 
 /*********************************************************************
-    Name: mix_column
+    Name: milenage_load_in1
 
-    Description: Mix column transformation.
+    Description: Constructs IN1 from SQN and AMF.
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: 35.206 v10.0.0 Section 4.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void milenage_load_in1(uint8  *sqn,
+                       uint8  *amf,
+                       uint32 *in1);
+
+/*********************************************************************
+    Name: milenage_f1_out
+
+    Description: Computes OUT1, shared by F1 and F1*, from TEMP, SQN,
+                 and AMF.
+
+    Document Reference: 35.206 v10.0.0 Section 4.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void milenage_f1_out(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                     uint32                              *temp,
+                     uint8                               *sqn,
+                     uint8                               *amf,
+                     uint32                              *out1);
+
+/*********************************************************************
+    Name: milenage_store
+
+    Description: Stores N_bytes of a block of big endian words,
+                 starting at byte offset.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void milenage_store(uint32 *in,
+                    uint32  offset,
+                    uint32  N_bytes,
+                    uint8  *out);
+
+/*********************************************************************
+    Name: snow3g_load_key
+
+    Description: Loads a 128-bit key into the SNOW 3G LFSR, leaving
+                 the IV words to be mixed in by the caller.
+
+    Document Reference: 35.216 v10.0.0 Section 4.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void snow3g_load_key(uint8  *key,
+                     uint32 *lfsr);
+
+/*********************************************************************
+    Name: snow3g_keystream
+
+    Description: Initializes SNOW 3G from a loaded LFSR and XORs
+                 N_bytes of keystream over msg.
+
+    Document Reference: 35.216 v10.0.0 Section 4
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void snow3g_keystream(uint32 *lfsr_init,
+                      uint8  *msg,
+                      uint32  N_bytes,
+                      uint8  *out);
+
+/*********************************************************************
+    Name: zuc_load_key
+
+    Description: Loads a 128-bit key and the D constants into the ZUC
+                 LFSR, leaving the IV bytes to be mixed in by the
+                 caller.
+
+    Document Reference: 35.222 v11.0.0 Section 3.5.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void zuc_load_key(uint8  *key,
+                  uint32 *lfsr);
+
+/*********************************************************************
+    Name: zuc_keystream
+
+    Description: Initializes ZUC from a loaded LFSR and XORs N_bytes
+                 of keystream over msg.
+
+    Document Reference: 35.222 v11.0.0 Section 3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void zuc_keystream(uint32 *lfsr_init,
+                   uint8  *msg,
+                   uint32  N_bytes,
+                   uint8  *out);
+
+/*********************************************************************
+    Name: cipher_pdu
+
+    Description: Ciphers or deciphers one PDU with a cipher context.
+
+    Document Reference: 33.401 v10.0.0 Annex B.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void cipher_pdu(LIBLTE_SECURITY_CIPHER_CTX_STRUCT *ctx,
+                uint32                             count,
+                uint8                             *msg,
+                uint32                             N_bits,
+                uint8                             *out);
+
+/*********************************************************************
+    Name: cmac_double
+
+    Description: Multiplies a 128-bit CMAC value, held as four big
+                 endian words, by x in GF(2^128).
+
+    Document Reference: RFC4493 Section 2.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void cmac_double(uint32 *in,
+                 uint32 *out);
+
+/*********************************************************************
+    Name: eia2_mac
+
+    Description: Computes the EIA2 MAC of one message with an
+                 integrity context.  The COUNT, BEARER, and DIRECTION
+                 header is fed to CMAC as the first two words, so the
+                 message is never copied.
+
+    Document Reference: 33.401 v10.0.0 Annex B.2.3
+                        RFC4493 Section 2.4
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void mix_column(STATE_STRUCT *state);
+void eia2_mac(LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT *ctx,
+              uint32                                count,
+              uint8                                *msg,
+              uint32                                N_bits,
+              uint8                                *mac);
 
 /*******************************************************************************
                               FUNCTIONS
@@ -468,98 +901,15 @@ LIBLTE_ERROR_ENUM liblte_security_128_eia2(uint8  *key,
                                            uint32  msg_len,
                                            uint8  *mac)
 {
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint8             M[msg_len+8+16];
-    aes_context       ctx;
-    uint32            i;
-    uint32            j;
-    uint32            n;
-    uint32            pad_bits;
-    uint8             const_zero[16] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
-    uint8             L[16];
-    uint8             K1[16];
-    uint8             K2[16];
-    uint8             T[16];
-    uint8             tmp[16];
+    LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT ctx;
+    LIBLTE_ERROR_ENUM                    err = LIBLTE_ERROR_INVALID_INPUTS;
 
     if(key != NULL &&
        msg != NULL &&
        mac != NULL)
     {
-        // Subkey L generation
-        aes_setkey_enc(&ctx, key, 128);
-        aes_crypt_ecb(&ctx, AES_ENCRYPT, const_zero, L);
-
-        // Subkey K1 generation
-        for(i=0; i<15; i++)
-        {
-            K1[i] = (L[i] << 1) | ((L[i+1] >> 7) & 0x01);
-        }
-        K1[15] = L[15] << 1;
-        if(L[0] & 0x80)
-        {
-            K1[15] ^= 0x87;
-        }
-
-        // Subkey K2 generation
-        for(i=0; i<15; i++)
-        {
-            K2[i] = (K1[i] << 1) | ((K1[i+1] >> 7) & 0x01);
-        }
-        K2[15] = K1[15] << 1;
-        if(K1[0] & 0x80)
-        {
-            K2[15] ^= 0x87;
-        }
-
-        // Construct M
-        memset(M, 0, msg_len+8+16);
-        M[0] = (count >> 24) & 0xFF;
-        M[1] = (count >> 16) & 0xFF;
-        M[2] = (count >> 8) & 0xFF;
-        M[3] = count & 0xFF;
-        M[4] = (bearer << 3) | (direction << 2);
-        for(i=0; i<msg_len; i++)
-        {
-            M[8+i] = msg[i];
-        }
-
-        // MAC generation
-        n = (uint32)(ceilf((float)(msg_len+8)/(float)(16)));
-        for(i=0; i<16; i++)
-        {
-            T[i] = 0;
-        }
-        for(i=0; i<n-1; i++)
-        {
-            for(j=0; j<16; j++)
-            {
-                tmp[j] = T[j] ^ M[i*16 + j];
-            }
-            aes_crypt_ecb(&ctx, AES_ENCRYPT, tmp, T);
-        }
-        pad_bits = ((msg_len*8) + 64) % 128;
-        if(pad_bits == 0)
-        {
-            for(j=0; j<16; j++)
-            {
-                tmp[j] = T[j] ^ K1[j] ^ M[i*16 + j];
-            }
-            aes_crypt_ecb(&ctx, AES_ENCRYPT, tmp, T);
-        }else{
-            pad_bits                       = (128 - pad_bits) - 1;
-            M[i*16 + (15 - (pad_bits/8))] |= 0x1 << (pad_bits % 8);
-            for(j=0; j<16; j++)
-            {
-                tmp[j] = T[j] ^ K2[j] ^ M[i*16 + j];
-            }
-            aes_crypt_ecb(&ctx, AES_ENCRYPT, tmp, T);
-        }
-
-        for(i=0; i<4; i++)
-        {
-            mac[i] = T[i];
-        }
+        liblte_security_128_eia2_init(&ctx, key, bearer, direction);
+        eia2_mac(&ctx, count, msg, msg_len*8, mac);
 
         err = LIBLTE_SUCCESS;
     }
@@ -573,110 +923,61 @@ LIBLTE_ERROR_ENUM liblte_security_128_eia2(uint8                 *key,
                                            LIBLTE_BIT_MSG_STRUCT *msg,
                                            uint8                 *mac)
 {
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint8             M[msg->N_bits*8+8+16];
-    aes_context       ctx;
-    uint32            i;
-    uint32            j;
-    uint32            n;
-    uint32            pad_bits;
-    uint8             const_zero[16] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
-    uint8             L[16];
-    uint8             K1[16];
-    uint8             K2[16];
-    uint8             T[16];
-    uint8             tmp[16];
+    LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT  ctx;
+    LIBLTE_ERROR_ENUM                     err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint8                                 M[LIBLTE_MAX_MSG_SIZE/8];
+    uint8                                *msg_ptr;
+    uint32                                i;
 
     if(key != NULL &&
        msg != NULL &&
        mac != NULL)
     {
-        // Subkey L generation
-        aes_setkey_enc(&ctx, key, 128);
-        aes_crypt_ecb(&ctx, AES_ENCRYPT, const_zero, L);
-
-        // Subkey K1 generation
-        for(i=0; i<15; i++)
-        {
-            K1[i] = (L[i] << 1) | ((L[i+1] >> 7) & 0x01);
-        }
-        K1[15] = L[15] << 1;
-        if(L[0] & 0x80)
+        // Pack the bits into bytes, trailing bits are masked by eia2_mac
+        msg_ptr = msg->msg;
+        for(i=0; i<(msg->N_bits+7)/8; i++)
         {
-            K1[15] ^= 0x87;
+            M[i] = liblte_bits_2_value(&msg_ptr, 8);
         }
 
-        // Subkey K2 generation
-        for(i=0; i<15; i++)
-        {
-            K2[i] = (K1[i] << 1) | ((K1[i+1] >> 7) & 0x01);
-        }
-        K2[15] = K1[15] << 1;
-        if(K1[0] & 0x80)
-        {
-            K2[15] ^= 0x87;
-        }
+        liblte_security_128_eia2_init(&ctx, key, bearer, direction);
+        eia2_mac(&ctx, count, M, msg->N_bits, mac);
 
-        // Construct M
-        memset(M, 0, msg->N_bits*8+8+16);
-        M[0] = (count >> 24) & 0xFF;
-        M[1] = (count >> 16) & 0xFF;
-        M[2] = (count >> 8) & 0xFF;
-        M[3] = count & 0xFF;
-        M[4] = (bearer << 3) | (direction << 2);
-        for(i=0; i<msg->N_bits/8; i++)
-        {
-            M[8+i] = 0;
-            for(j=0; j<8; j++)
-            {
-                M[8+i] |= msg->msg[i*8+j] << (7-j);
-            }
-        }
-        if((msg->N_bits % 8) != 0)
-        {
-            M[8+i] = 0;
-            for(j=0; j<msg->N_bits % 8; j++)
-            {
-                M[8+i] |= msg->msg[i*8+j] << (7-j);
-            }
-        }
+        err = LIBLTE_SUCCESS;
+    }
 
-        // MAC generation
-        n = (uint32)(ceilf((float)(msg->N_bits+64)/(float)(128)));
-        for(i=0; i<16; i++)
-        {
-            T[i] = 0;
-        }
-        for(i=0; i<n-1; i++)
-        {
-            for(j=0; j<16; j++)
-            {
-                tmp[j] = T[j] ^ M[i*16 + j];
-            }
-            aes_crypt_ecb(&ctx, AES_ENCRYPT, tmp, T);
-        }
-        pad_bits = (msg->N_bits + 64) % 128;
-        if(pad_bits == 0)
-        {
-            for(j=0; j<16; j++)
-            {
-                tmp[j] = T[j] ^ K1[j] ^ M[i*16 + j];
-            }
-            aes_crypt_ecb(&ctx, AES_ENCRYPT, tmp, T);
-        }else{
-            pad_bits                       = (128 - pad_bits) - 1;
-            M[i*16 + (15 - (pad_bits/8))] |= 0x1 << (pad_bits % 8);
-            for(j=0; j<16; j++)
-            {
-                tmp[j] = T[j] ^ K2[j] ^ M[i*16 + j];
-            }
-            aes_crypt_ecb(&ctx, AES_ENCRYPT, tmp, T);
-        }
+    return(err);
+}
 
-        for(i=0; i<4; i++)
-        {
-            mac[i] = T[i];
-        }
+/*********************************************************************
+    Name: liblte_security_128_eia2_init
+
+    Description: Sets up an EIA2 integrity context for one bearer and
+                 direction.
+
+    Document Reference: 33.401 v10.0.0 Annex B.2.3
+                        RFC4493 Section 2.3
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_security_128_eia2_init(LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT *ctx,
+                                                uint8                                *key,
+                                                uint8                                 bearer,
+                                                uint8                                 direction)
+{
+    LIBLTE_ERROR_ENUM err     = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            zero[4] = {0, 0, 0, 0};
+    uint32            L[4];
+
+    if(ctx != NULL &&
+       key != NULL)
+    {
+        ctx->bearer    = bearer & 0x1F;
+        ctx->direction = direction & 0x01;
+        aes_128_key_schedule(key, ctx->rk);
+
+        // Subkeys K1 and K2 from L = AES(K, 0)
+        aes_128_encrypt(ctx->rk, zero, L);
+        cmac_double(L, ctx->k1);
+        cmac_double(ctx->k1, ctx->k2);
 
         err = LIBLTE_SUCCESS;
     }
@@ -685,80 +986,56 @@ LIBLTE_ERROR_ENUM liblte_security_128_eia2(uint8                 *key,
 }
 
 /*********************************************************************
-    Name: liblte_security_milenage_f1
+    Name: liblte_security_128_eia2
 
-    Description: Milenage security function F1.  Computes network
-                 authentication code MAC-A from key K, random
-                 challenge RAND, sequence number SQN, and
-                 authentication management field AMF.
+    Description: 128-bit integrity algorithm EIA2 using a context from
+                 liblte_security_128_eia2_init.
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: 33.401 v10.0.0 Annex B.2.3
+                        RFC4493
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_security_milenage_f1(uint8 *k,
-                                              uint8 *rand,
-                                              uint8 *sqn,
-                                              uint8 *amf,
-                                              uint8 *mac_a)
+LIBLTE_ERROR_ENUM liblte_security_128_eia2(LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT *ctx,
+                                           uint32                                count,
+                                           uint8                                *msg,
+                                           uint32                                N_bits,
+                                           uint8                                *mac)
 {
     LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    ROUND_KEY_STRUCT  round_keys;
-    uint32            i;
-    uint8             op_c[16];
-    uint8             temp[16];
-    uint8             in1[16];
-    uint8             out1[16];
-    uint8             rijndael_input[16];
 
-    if(k     != NULL &&
-       rand  != NULL &&
-       sqn   != NULL &&
-       amf   != NULL &&
-       mac_a != NULL)
+    if(ctx != NULL &&
+       msg != NULL &&
+       mac != NULL)
     {
-        // Initialize the round keys
-        rijndael_key_schedule(k, &round_keys);
+        eia2_mac(ctx, count, msg, N_bits, mac);
 
-        // Compute OPc
-        compute_OPc(&round_keys, (uint8 *)OP, op_c);
+        err = LIBLTE_SUCCESS;
+    }
 
-        // Compute temp
-        for(i=0; i<16; i++)
-        {
-            rijndael_input[i] = rand[i] ^ op_c[i];
-        }
-        rijndael_encrypt(rijndael_input, &round_keys, temp);
+    return(err);
+}
 
-        // Construct in1
-        for(i=0; i<6; i++)
-        {
-            in1[i]   = sqn[i];
-            in1[i+8] = sqn[i];
-        }
-        for(i=0; i<2; i++)
-        {
-            in1[i+6]  = amf[i];
-            in1[i+14] = amf[i];
-        }
+/*********************************************************************
+    Name: liblte_security_128_eia2_batch
 
-        // Compute out1
-        for(i=0; i<16; i++)
-        {
-            rijndael_input[(i+8) % 16] = in1[i] ^ op_c[i];
-        }
-        for(i=0; i<16; i++)
-        {
-            rijndael_input[i] ^= temp[i];
-        }
-        rijndael_encrypt(rijndael_input, &round_keys, out1);
-        for(i=0; i<16; i++)
-        {
-            out1[i] ^= op_c[i];
-        }
+    Description: Computes the EIA2 MAC of a batch of messages using a
+                 context from liblte_security_128_eia2_init.
 
-        // Return MAC-A
-        for(i=0; i<8; i++)
+    Document Reference: 33.401 v10.0.0 Annex B.2.3
+                        RFC4493
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_security_128_eia2_batch(LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT *ctx,
+                                                 LIBLTE_SECURITY_INTEGRITY_MSG_STRUCT *msg,
+                                                 uint32                                N_msgs)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+
+    if(ctx != NULL &&
+       msg != NULL)
+    {
+        for(i=0; i<N_msgs; i++)
         {
-            mac_a[i] = out1[i];
+            eia2_mac(ctx, msg[i].count, msg[i].msg, msg[i].N_bits, msg[i].mac);
         }
 
         err = LIBLTE_SUCCESS;
@@ -768,81 +1045,356 @@ LIBLTE_ERROR_ENUM liblte_security_milenage_f1(uint8 *k,
 }
 
 /*********************************************************************
-    Name: liblte_security_milenage_f1_star
+    Name: liblte_security_128_eea1
 
-    Description: Milenage security function F1*.  Computes resynch
-                 authentication code MAC-S from key K, random
-                 challenge RAND, sequence number SQN, and
-                 authentication management field AMF.
+    Description: 128-bit encryption algorithm EEA1 (SNOW 3G).
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: 33.401 v10.0.0 Annex B.1.2
+                        35.215 v10.0.0 Section 4
+                        35.216 v10.0.0 Section 3
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_security_milenage_f1_star(uint8 *k,
-                                                   uint8 *rand,
-                                                   uint8 *sqn,
-                                                   uint8 *amf,
-                                                   uint8 *mac_s)
+LIBLTE_ERROR_ENUM liblte_security_128_eea1(uint8  *key,
+                                           uint32  count,
+                                           uint8   bearer,
+                                           uint8   direction,
+                                           uint8  *msg,
+                                           uint32  N_bits,
+                                           uint8  *out)
 {
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    ROUND_KEY_STRUCT  round_keys;
-    uint32            i;
-    uint8             op_c[16];
-    uint8             temp[16];
-    uint8             in1[16];
-    uint8             out1[16];
-    uint8             rijndael_input[16];
-
-    if(k     != NULL &&
-       rand  != NULL &&
-       sqn   != NULL &&
-       amf   != NULL &&
-       mac_s != NULL)
+    LIBLTE_SECURITY_CIPHER_CTX_STRUCT ctx;
+    LIBLTE_ERROR_ENUM                 err;
+
+    err = liblte_security_cipher_init(&ctx,
+                                      LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA1,
+                                      key,
+                                      bearer,
+                                      direction);
+    if(LIBLTE_SUCCESS == err)
     {
-        // Initialize the round keys
-        rijndael_key_schedule(k, &round_keys);
+        err = liblte_security_cipher(&ctx, count, msg, N_bits, out);
+    }
 
-        // Compute OPc
-        compute_OPc(&round_keys, (uint8 *)OP, op_c);
+    return(err);
+}
 
-        // Compute temp
-        for(i=0; i<16; i++)
-        {
-            rijndael_input[i] = rand[i] ^ op_c[i];
-        }
-        rijndael_encrypt(rijndael_input, &round_keys, temp);
+/*********************************************************************
+    Name: liblte_security_128_eea2
 
-        // Construct in1
-        for(i=0; i<6; i++)
-        {
-            in1[i]   = sqn[i];
-            in1[i+8] = sqn[i];
-        }
-        for(i=0; i<2; i++)
+    Description: 128-bit encryption algorithm EEA2 (AES-128 in
+                 counter mode).
+
+    Document Reference: 33.401 v10.0.0 Annex B.1.3
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_security_128_eea2(uint8  *key,
+                                           uint32  count,
+                                           uint8   bearer,
+                                           uint8   direction,
+                                           uint8  *msg,
+                                           uint32  N_bits,
+                                           uint8  *out)
+{
+    LIBLTE_SECURITY_CIPHER_CTX_STRUCT ctx;
+    LIBLTE_ERROR_ENUM                 err;
+
+    err = liblte_security_cipher_init(&ctx,
+                                      LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA2,
+                                      key,
+                                      bearer,
+                                      direction);
+    if(LIBLTE_SUCCESS == err)
+    {
+        err = liblte_security_cipher(&ctx, count, msg, N_bits, out);
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_security_128_eea3
+
+    Description: 128-bit encryption algorithm EEA3 (ZUC).
+
+    Document Reference: 33.401 v11.5.0 Annex B.1.4
+                        35.221 v11.0.0 Section 3
+                        35.222 v11.0.0 Section 3
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_security_128_eea3(uint8  *key,
+                                           uint32  count,
+                                           uint8   bearer,
+                                           uint8   direction,
+                                           uint8  *msg,
+                                           uint32  N_bits,
+                                           uint8  *out)
+{
+    LIBLTE_SECURITY_CIPHER_CTX_STRUCT ctx;
+    LIBLTE_ERROR_ENUM                 err;
+
+    err = liblte_security_cipher_init(&ctx,
+                                      LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA3,
+                                      key,
+                                      bearer,
+                                      direction);
+    if(LIBLTE_SUCCESS == err)
+    {
+        err = liblte_security_cipher(&ctx, count, msg, N_bits, out);
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_security_cipher_init
+
+    Description: Sets up a ciphering context for one bearer and
+                 direction.
+
+    Document Reference: 33.401 v10.0.0 Section 7.2.9
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_security_cipher_init(LIBLTE_SECURITY_CIPHER_CTX_STRUCT           *ctx,
+                                              LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM  alg,
+                                              uint8                                       *key,
+                                              uint8                                        bearer,
+                                              uint8                                        direction)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            iv;
+
+    if(ctx                                            != NULL &&
+       LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_N_ITEMS >  alg  &&
+       (key                                           != NULL ||
+        LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_EEA0   == alg))
+    {
+        memset(ctx, 0, sizeof(LIBLTE_SECURITY_CIPHER_CTX_STRUCT));
+        ctx->alg       = alg;
+        ctx->bearer    = bearer & 0x1F;
+        ctx->direction = direction & 0x01;
+
+        if(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA1 == alg)
         {
-            in1[i+6]  = amf[i];
-            in1[i+14] = amf[i];
+            // Load the key, IV0 and IV2 are fixed for the bearer
+            snow3g_load_key(key, ctx->lfsr);
+            iv             = (ctx->bearer << 27) | (ctx->direction << 26);
+            ctx->lfsr[15] ^= iv;
+            ctx->lfsr[10] ^= iv;
+        }else if(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA2 == alg){
+            aes_128_key_schedule(key, ctx->rk);
+        }else if(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA3 == alg){
+            // Load the key, IV4 and IV12 are fixed for the bearer
+            zuc_load_key(key, ctx->lfsr);
+            iv             = (ctx->bearer << 3) | (ctx->direction << 2);
+            ctx->lfsr[4]  |= iv;
+            ctx->lfsr[12] |= iv;
         }
 
-        // Compute out1
-        for(i=0; i<16; i++)
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_security_cipher
+
+    Description: Ciphers or deciphers N_bits of msg into out using a
+                 context from liblte_security_cipher_init.
+
+    Document Reference: 33.401 v10.0.0 Annex B.1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_security_cipher(LIBLTE_SECURITY_CIPHER_CTX_STRUCT *ctx,
+                                         uint32                             count,
+                                         uint8                             *msg,
+                                         uint32                             N_bits,
+                                         uint8                             *out)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(ctx != NULL &&
+       msg != NULL &&
+       out != NULL)
+    {
+        cipher_pdu(ctx, count, msg, N_bits, out);
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_security_cipher_batch
+
+    Description: Ciphers or deciphers a batch of PDUs in place using a
+                 context from liblte_security_cipher_init.
+
+    Document Reference: 33.401 v10.0.0 Annex B.1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_security_cipher_batch(LIBLTE_SECURITY_CIPHER_CTX_STRUCT *ctx,
+                                               LIBLTE_SECURITY_CIPHER_PDU_STRUCT *pdu,
+                                               uint32                             N_pdus)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+
+    if(ctx != NULL &&
+       pdu != NULL)
+    {
+        for(i=0; i<N_pdus; i++)
         {
-            rijndael_input[(i+8) % 16] = in1[i] ^ op_c[i];
+            cipher_pdu(ctx, pdu[i].count, pdu[i].msg, pdu[i].N_bits, pdu[i].msg);
         }
-        for(i=0; i<16; i++)
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_security_milenage_init
+
+    Description: Sets up a Milenage context for one subscriber.  The
+                 AES round keys and OPc only depend on K and OP, so
+                 they are computed here once instead of in every
+                 Milenage function.
+
+    Document Reference: 35.206 v10.0.0 Annex 3
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_security_milenage_init(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                                                uint8                               *k,
+                                                uint8                               *op)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            op_w[4];
+    uint32            i;
+
+    if(ctx != NULL &&
+       k   != NULL)
+    {
+        // Initialize the round keys
+        aes_128_key_schedule(k, ctx->rk);
+
+        // Compute OPc
+        if(op != NULL)
         {
-            rijndael_input[i] ^= temp[i];
+            aes_128_load_block(op, op_w);
+        }else{
+            aes_128_load_block((uint8 *)OP, op_w);
         }
-        rijndael_encrypt(rijndael_input, &round_keys, out1);
-        for(i=0; i<16; i++)
+        aes_128_encrypt(ctx->rk, op_w, ctx->op_c);
+        for(i=0; i<4; i++)
         {
-            out1[i] ^= op_c[i];
+            ctx->op_c[i] ^= op_w[i];
         }
 
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_security_milenage_f1
+
+    Description: Milenage security function F1.  Computes network
+                 authentication code MAC-A from key K, random
+                 challenge RAND, sequence number SQN, and
+                 authentication management field AMF.
+
+    Document Reference: 35.206 v10.0.0 Annex 3
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_security_milenage_f1(uint8 *k,
+                                              uint8 *rand,
+                                              uint8 *sqn,
+                                              uint8 *amf,
+                                              uint8 *mac_a)
+{
+    LIBLTE_SECURITY_MILENAGE_CTX_STRUCT ctx;
+    LIBLTE_ERROR_ENUM                   err;
+
+    err = liblte_security_milenage_init(&ctx, k, NULL);
+    if(LIBLTE_SUCCESS == err)
+    {
+        err = liblte_security_milenage_f1(&ctx, rand, sqn, amf, mac_a);
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_security_milenage_f1(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                                              uint8                               *rand,
+                                              uint8                               *sqn,
+                                              uint8                               *amf,
+                                              uint8                               *mac_a)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            temp[4];
+    uint32            out1[4];
+
+    if(ctx   != NULL &&
+       rand  != NULL &&
+       sqn   != NULL &&
+       amf   != NULL &&
+       mac_a != NULL)
+    {
+        milenage_temp(ctx, rand, temp);
+        milenage_f1_out(ctx, temp, sqn, amf, out1);
+
+        // Return MAC-A
+        milenage_store(out1, 0, 8, mac_a);
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_security_milenage_f1_star
+
+    Description: Milenage security function F1*.  Computes resynch
+                 authentication code MAC-S from key K, random
+                 challenge RAND, sequence number SQN, and
+                 authentication management field AMF.
+
+    Document Reference: 35.206 v10.0.0 Annex 3
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_security_milenage_f1_star(uint8 *k,
+                                                   uint8 *rand,
+                                                   uint8 *sqn,
+                                                   uint8 *amf,
+                                                   uint8 *mac_s)
+{
+    LIBLTE_SECURITY_MILENAGE_CTX_STRUCT ctx;
+    LIBLTE_ERROR_ENUM                   err;
+
+    err = liblte_security_milenage_init(&ctx, k, NULL);
+    if(LIBLTE_SUCCESS == err)
+    {
+        err = liblte_security_milenage_f1_star(&ctx, rand, sqn, amf, mac_s);
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_security_milenage_f1_star(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                                                   uint8                               *rand,
+                                                   uint8                               *sqn,
+                                                   uint8                               *amf,
+                                                   uint8                               *mac_s)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            temp[4];
+    uint32            out1[4];
+
+    if(ctx   != NULL &&
+       rand  != NULL &&
+       sqn   != NULL &&
+       amf   != NULL &&
+       mac_s != NULL)
+    {
+        milenage_temp(ctx, rand, temp);
+        milenage_f1_out(ctx, temp, sqn, amf, out1);
+
         // Return MAC-S
-        for(i=0; i<8; i++)
-        {
-            mac_s[i] = out1[i+8];
-        }
+        milenage_store(out1, 8, 8, mac_s);
 
         err = LIBLTE_SUCCESS;
     }
@@ -867,93 +1419,63 @@ LIBLTE_ERROR_ENUM liblte_security_milenage_f2345(uint8 *k,
                                                  uint8 *ik,
                                                  uint8 *ak)
 {
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    ROUND_KEY_STRUCT  round_keys;
-    uint32            i;
-    uint8             op_c[16];
-    uint8             temp[16];
-    uint8             out[16];
-    uint8             rijndael_input[16];
+    LIBLTE_SECURITY_MILENAGE_CTX_STRUCT ctx;
+    LIBLTE_ERROR_ENUM                   err;
 
-    if(k    != NULL &&
+    err = liblte_security_milenage_init(&ctx, k, NULL);
+    if(LIBLTE_SUCCESS == err)
+    {
+        err = liblte_security_milenage_f2345(&ctx, rand, res, ck, ik, ak);
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_security_milenage_f2345(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                                                 uint8                               *rand,
+                                                 uint8                               *res,
+                                                 uint8                               *ck,
+                                                 uint8                               *ik,
+                                                 uint8                               *ak)
+{
+    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            *rk[4];
+    uint32             temp[4];
+    uint32             input[4][4];
+    uint32             out[4][4];
+    uint32             i;
+
+    if(ctx  != NULL &&
        rand != NULL &&
        res  != NULL &&
        ck   != NULL &&
        ik   != NULL &&
        ak   != NULL)
     {
-        // Initialize the round keys
-        rijndael_key_schedule(k, &round_keys);
-
-        // Compute OPc
-        compute_OPc(&round_keys, (uint8 *)OP, op_c);
-
-        // Compute temp
-        for(i=0; i<16; i++)
-        {
-            rijndael_input[i] = rand[i] ^ op_c[i];
-        }
-        rijndael_encrypt(rijndael_input, &round_keys, temp);
-
-        // Compute out for RES and AK
-        for(i=0; i<16; i++)
-        {
-            rijndael_input[i] = temp[i] ^ op_c[i];
-        }
-        rijndael_input[15] ^= 1;
-        rijndael_encrypt(rijndael_input, &round_keys, out);
-        for(i=0; i<16; i++)
-        {
-            out[i] ^= op_c[i];
-        }
-
-        // Return RES
-        for(i=0; i<8; i++)
-        {
-            res[i] = out[i+8];
-        }
-
-        // Return AK
-        for(i=0; i<6; i++)
-        {
-            ak[i] = out[i];
-        }
+        milenage_temp(ctx, rand, temp);
 
-        // Compute out for CK
-        for(i=0; i<16; i++)
-        {
-            rijndael_input[(i+12) % 16] = temp[i] ^ op_c[i];
-        }
-        rijndael_input[15] ^= 2;
-        rijndael_encrypt(rijndael_input, &round_keys, out);
-        for(i=0; i<16; i++)
-        {
-            out[i] ^= op_c[i];
-        }
-
-        // Return CK
-        for(i=0; i<16; i++)
-        {
-            ck[i] = out[i];
-        }
-
-        // Compute out for IK
-        for(i=0; i<16; i++)
+        // Compute out for RES and AK, CK, and IK side by side, the
+        // fourth block is a spare copy of the first
+        milenage_input(ctx, temp, 0, 1, input[0]);
+        milenage_input(ctx, temp, 1, 2, input[1]);
+        milenage_input(ctx, temp, 2, 4, input[2]);
+        for(i=0; i<4; i++)
         {
-            rijndael_input[(i+8) % 16] = temp[i] ^ op_c[i];
+            rk[i]       = ctx->rk;
+            input[3][i] = input[0][i];
         }
-        rijndael_input[15] ^= 4;
-        rijndael_encrypt(rijndael_input, &round_keys, out);
-        for(i=0; i<16; i++)
+        aes_128_encrypt_x4(rk, input, out);
+        for(i=0; i<4; i++)
         {
-            out[i] ^= op_c[i];
+            out[0][i] ^= ctx->op_c[i];
+            out[1][i] ^= ctx->op_c[i];
+            out[2][i] ^= ctx->op_c[i];
         }
 
-        // Return IK
-        for(i=0; i<16; i++)
-        {
-            ik[i] = out[i];
-        }
+        // Return RES, AK, CK, and IK
+        milenage_store(out[0], 8, 8, res);
+        milenage_store(out[0], 0, 6, ak);
+        milenage_store(out[1], 0, 16, ck);
+        milenage_store(out[2], 0, 16, ik);
 
         err = LIBLTE_SUCCESS;
     }
@@ -973,51 +1495,137 @@ LIBLTE_ERROR_ENUM liblte_security_milenage_f2345(uint8 *k,
 LIBLTE_ERROR_ENUM liblte_security_milenage_f5_star(uint8 *k,
                                                    uint8 *rand,
                                                    uint8 *ak)
+{
+    LIBLTE_SECURITY_MILENAGE_CTX_STRUCT ctx;
+    LIBLTE_ERROR_ENUM                   err;
+
+    err = liblte_security_milenage_init(&ctx, k, NULL);
+    if(LIBLTE_SUCCESS == err)
+    {
+        err = liblte_security_milenage_f5_star(&ctx, rand, ak);
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_security_milenage_f5_star(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                                                   uint8                               *rand,
+                                                   uint8                               *ak)
 {
     LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    ROUND_KEY_STRUCT  round_keys;
+    uint32            temp[4];
+    uint32            input[4];
+    uint32            out[4];
     uint32            i;
-    uint8             op_c[16];
-    uint8             temp[16];
-    uint8             out[16];
-    uint8             rijndael_input[16];
 
-    if(k    != NULL &&
+    if(ctx  != NULL &&
        rand != NULL &&
        ak   != NULL)
     {
-        // Initialize the round keys
-        rijndael_key_schedule(k, &round_keys);
-
-        // Compute OPc
-        compute_OPc(&round_keys, (uint8 *)OP, op_c);
-
-        // Compute temp
-        for(i=0; i<16; i++)
-        {
-            rijndael_input[i] = rand[i] ^ op_c[i];
-        }
-        rijndael_encrypt(rijndael_input, &round_keys, temp);
+        milenage_temp(ctx, rand, temp);
 
         // Compute out
-        for(i=0; i<16; i++)
-        {
-            rijndael_input[(i+4) % 16] = temp[i] ^ op_c[i];
-        }
-        rijndael_input[15] ^= 8;
-        rijndael_encrypt(rijndael_input, &round_keys, out);
-        for(i=0; i<16; i++)
+        milenage_input(ctx, temp, 3, 8, input);
+        aes_128_encrypt(ctx->rk, input, out);
+        for(i=0; i<4; i++)
         {
-            out[i] ^= op_c[i];
+            out[i] ^= ctx->op_c[i];
         }
 
         // Return AK
-        for(i=0; i<6; i++)
+        milenage_store(out, 0, 6, ak);
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_security_milenage_batch
+
+    Description: Computes F1 and F2345 for a batch of authentication
+                 vectors, each with its own subscriber context.  TEMP
+                 is computed for four vectors at a time and the four
+                 output blocks of each vector are computed together,
+                 so the AES lookups of independent blocks overlap.
+
+    Document Reference: 35.206 v10.0.0 Annex 3
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_security_milenage_batch(LIBLTE_SECURITY_MILENAGE_VECTOR_STRUCT *vec,
+                                                 uint32                                  N_vecs)
+{
+    LIBLTE_SECURITY_MILENAGE_CTX_STRUCT  *ctx;
+    LIBLTE_ERROR_ENUM                     err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32                               *rk[4];
+    uint32                                input[4][4];
+    uint32                                temp[4][4];
+    uint32                                out[4][4];
+    uint32                                in1[4];
+    uint32                                i;
+    uint32                                j;
+    uint32                                l;
+
+    if(vec != NULL)
+    {
+        err = LIBLTE_SUCCESS;
+        for(i=0; i<N_vecs; i++)
         {
-            ak[i] = out[i];
+            if(vec[i].ctx == NULL)
+            {
+                err = LIBLTE_ERROR_INVALID_INPUTS;
+            }
         }
+    }
 
-        err = LIBLTE_SUCCESS;
+    if(LIBLTE_SUCCESS == err)
+    {
+        for(i=0; i<N_vecs; i+=4)
+        {
+            // Compute TEMP for up to four subscribers, unused lanes
+            // repeat the last vector
+            for(l=0; l<4; l++)
+            {
+                j     = (i+l < N_vecs) ? i+l : N_vecs-1;
+                ctx   = vec[j].ctx;
+                rk[l] = ctx->rk;
+                aes_128_load_block(vec[j].rand, in1);
+                milenage_input(ctx, in1, 0, 0, input[l]);
+            }
+            aes_128_encrypt_x4(rk, input, temp);
+
+            // Compute out1, out2, out3, and out4 of each subscriber
+            for(l=0; l<4 && i+l<N_vecs; l++)
+            {
+                ctx = vec[i+l].ctx;
+                milenage_load_in1(vec[i+l].sqn, vec[i+l].amf, in1);
+                milenage_input(ctx, in1, 2, 0, input[0]);
+                for(j=0; j<4; j++)
+                {
+                    input[0][j] ^= temp[l][j];
+                }
+                milenage_input(ctx, temp[l], 0, 1, input[1]);
+                milenage_input(ctx, temp[l], 1, 2, input[2]);
+                milenage_input(ctx, temp[l], 2, 4, input[3]);
+                for(j=0; j<4; j++)
+                {
+                    rk[j] = ctx->rk;
+                }
+                aes_128_encrypt_x4(rk, input, out);
+                for(j=0; j<4; j++)
+                {
+                    out[0][j] ^= ctx->op_c[j];
+                    out[1][j] ^= ctx->op_c[j];
+                    out[2][j] ^= ctx->op_c[j];
+                    out[3][j] ^= ctx->op_c[j];
+                }
+
+                milenage_store(out[0], 0, 8, vec[i+l].mac_a);
+                milenage_store(out[1], 8, 8, vec[i+l].res);
+                milenage_store(out[1], 0, 6, vec[i+l].ak);
+                milenage_store(out[2], 0, 16, vec[i+l].ck);
+                milenage_store(out[3], 0, 16, vec[i+l].ik);
+            }
+        }
     }
 
     return(err);
@@ -1028,216 +1636,676 @@ LIBLTE_ERROR_ENUM liblte_security_milenage_f5_star(uint8 *k,
 *******************************************************************************/
 
 /*********************************************************************
-    Name: compute_OPc
+    Name: aes_128_key_schedule
 
-    Description: Computes OPc from OP and K.
+    Description: Computes the AES-128 round keys as big endian column
+                 words.
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: FIPS 197 Section 5.2
 *********************************************************************/
-void compute_OPc(ROUND_KEY_STRUCT *rk,
-                 uint8            *op,
-                 uint8            *op_c)
+void aes_128_key_schedule(uint8  *key,
+                          uint32 *rk)
 {
     uint32 i;
+    uint32 tmp;
+    uint8  round_const = 1;
 
-    rijndael_encrypt(op, rk, op_c);
-    for(i=0; i<16; i++)
+    for(i=0; i<4; i++)
     {
-        op_c[i] ^= op[i];
+        rk[i] = (key[i*4] << 24) | (key[i*4+1] << 16) | (key[i*4+2] << 8) | key[i*4+3];
+    }
+    for(i=4; i<44; i++)
+    {
+        tmp = rk[i-1];
+        if((i % 4) == 0)
+        {
+            tmp = ((S[(tmp >> 16) & 0xFF] << 24) |
+                   (S[(tmp >> 8) & 0xFF] << 16)  |
+                   (S[tmp & 0xFF] << 8)          |
+                   S[tmp >> 24]) ^ (round_const << 24);
+            round_const = X_TIME[round_const];
+        }
+        rk[i] = rk[i-4] ^ tmp;
     }
 }
 
 /*********************************************************************
-    Name: rijndael_key_schedule
+    Name: aes_128_encrypt
 
-    Description: Computes all Rijndael's internal subkeys from key.
+    Description: Encrypts one block, held as four big endian words,
+                 with AES-128, using a single combined SubBytes/
+                 ShiftRows/MixColumns table and rotations for the other
+                 three columns.
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: FIPS 197 Section 5.1
+*********************************************************************/
+void aes_128_encrypt(uint32 *rk,
+                     uint32 *input,
+                     uint32 *output)
+{
+    uint32 s0 = input[0] ^ rk[0];
+    uint32 s1 = input[1] ^ rk[1];
+    uint32 s2 = input[2] ^ rk[2];
+    uint32 s3 = input[3] ^ rk[3];
+    uint32 t0;
+    uint32 t1;
+    uint32 t2;
+    uint32 t3;
+    uint32 r;
+
+    // Rounds 1 through 9
+    for(r=1; r<10; r++)
+    {
+        t0 = AES_T[s0 >> 24] ^ ROTR32(AES_T[(s1 >> 16) & 0xFF], 8) ^ ROTR32(AES_T[(s2 >> 8) & 0xFF], 16) ^ ROTR32(AES_T[s3 & 0xFF], 24) ^ rk[r*4];
+        t1 = AES_T[s1 >> 24] ^ ROTR32(AES_T[(s2 >> 16) & 0xFF], 8) ^ ROTR32(AES_T[(s3 >> 8) & 0xFF], 16) ^ ROTR32(AES_T[s0 & 0xFF], 24) ^ rk[r*4+1];
+        t2 = AES_T[s2 >> 24] ^ ROTR32(AES_T[(s3 >> 16) & 0xFF], 8) ^ ROTR32(AES_T[(s0 >> 8) & 0xFF], 16) ^ ROTR32(AES_T[s1 & 0xFF], 24) ^ rk[r*4+2];
+        t3 = AES_T[s3 >> 24] ^ ROTR32(AES_T[(s0 >> 16) & 0xFF], 8) ^ ROTR32(AES_T[(s1 >> 8) & 0xFF], 16) ^ ROTR32(AES_T[s2 & 0xFF], 24) ^ rk[r*4+3];
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+
+    // Round 10 has no MixColumns
+    output[0] = ((S[s0 >> 24] << 24) | (S[(s1 >> 16) & 0xFF] << 16) | (S[(s2 >> 8) & 0xFF] << 8) | S[s3 & 0xFF]) ^ rk[40];
+    output[1] = ((S[s1 >> 24] << 24) | (S[(s2 >> 16) & 0xFF] << 16) | (S[(s3 >> 8) & 0xFF] << 8) | S[s0 & 0xFF]) ^ rk[41];
+    output[2] = ((S[s2 >> 24] << 24) | (S[(s3 >> 16) & 0xFF] << 16) | (S[(s0 >> 8) & 0xFF] << 8) | S[s1 & 0xFF]) ^ rk[42];
+    output[3] = ((S[s3 >> 24] << 24) | (S[(s0 >> 16) & 0xFF] << 16) | (S[(s1 >> 8) & 0xFF] << 8) | S[s2 & 0xFF]) ^ rk[43];
+}
+
+/*********************************************************************
+    Name: aes_128_encrypt_x4
+
+    Description: Encrypts four independent blocks with AES-128, each
+                 with its own round keys, interleaving the rounds so
+                 the table lookups of one block overlap with those of
+                 the others.
+
+    Document Reference: FIPS 197 Section 5.1
 *********************************************************************/
-void rijndael_key_schedule(uint8            *key,
-                           ROUND_KEY_STRUCT *rk)
+void aes_128_encrypt_x4(uint32 **rk,
+                        uint32   input[4][4],
+                        uint32   output[4][4])
 {
+    uint32 s[4][4];
+    uint32 t[4][4];
+    uint32 l;
     uint32 i;
-    uint32 j;
-    uint8  round_const;
+    uint32 r;
 
-    // Set first round key to key
-    for(i=0; i<16; i++)
+    for(l=0; l<4; l++)
     {
-        rk->rk[0][i & 0x03][i >> 2] = key[i];
+        for(i=0; i<4; i++)
+        {
+            s[l][i] = input[l][i] ^ rk[l][i];
+        }
     }
 
-    round_const = 1;
-
-    // Compute the remaining round keys
-    for(i=1; i<11; i++)
+    // Rounds 1 through 9
+    for(r=1; r<10; r++)
     {
-        rk->rk[i][0][0] = S[rk->rk[i-1][1][3]] ^ rk->rk[i-1][0][0] ^ round_const;
-        rk->rk[i][1][0] = S[rk->rk[i-1][2][3]] ^ rk->rk[i-1][1][0];
-        rk->rk[i][2][0] = S[rk->rk[i-1][3][3]] ^ rk->rk[i-1][2][0];
-        rk->rk[i][3][0] = S[rk->rk[i-1][0][3]] ^ rk->rk[i-1][3][0];
+        for(l=0; l<4; l++)
+        {
+            for(i=0; i<4; i++)
+            {
+                t[l][i] = (AES_T[s[l][i] >> 24]                         ^
+                           ROTR32(AES_T[(s[l][(i+1)%4] >> 16) & 0xFF], 8) ^
+                           ROTR32(AES_T[(s[l][(i+2)%4] >> 8) & 0xFF], 16) ^
+                           ROTR32(AES_T[s[l][(i+3)%4] & 0xFF], 24)        ^
+                           rk[l][r*4+i]);
+            }
+        }
+        memcpy(s, t, sizeof(s));
+    }
 
-        for(j=0; j<4; j++)
+    // Round 10 has no MixColumns
+    for(l=0; l<4; l++)
+    {
+        for(i=0; i<4; i++)
         {
-            rk->rk[i][j][1] = rk->rk[i-1][j][1] ^ rk->rk[i][j][0];
-            rk->rk[i][j][2] = rk->rk[i-1][j][2] ^ rk->rk[i][j][1];
-            rk->rk[i][j][3] = rk->rk[i-1][j][3] ^ rk->rk[i][j][2];
+            output[l][i] = ((S[s[l][i] >> 24] << 24)                 |
+                            (S[(s[l][(i+1)%4] >> 16) & 0xFF] << 16) |
+                            (S[(s[l][(i+2)%4] >> 8) & 0xFF] << 8)   |
+                            S[s[l][(i+3)%4] & 0xFF]) ^ rk[l][40+i];
         }
+    }
+}
 
-        round_const = X_TIME[round_const];
+/*********************************************************************
+    Name: aes_128_load_block
+
+    Description: Loads a 16 byte block as four big endian words.
+
+    Document Reference: N/A
+*********************************************************************/
+void aes_128_load_block(uint8  *in,
+                        uint32 *out)
+{
+    uint32 i;
+
+    for(i=0; i<4; i++)
+    {
+        out[i] = ((uint32)in[i*4] << 24) | ((uint32)in[i*4+1] << 16) | ((uint32)in[i*4+2] << 8) | in[i*4+3];
     }
 }
 
 /*********************************************************************
-    Name: rijndael_encrypt
+    Name: milenage_input
 
-    Description: Computes output using input and round keys.
+    Description: Computes the input block of a Milenage output
+                 function, rot(x XOR OPc, r) XOR c, with the rotation
+                 given in words.
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: 35.206 v10.0.0 Section 4.1
+*********************************************************************/
+void milenage_input(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                    uint32                              *x,
+                    uint32                               rot,
+                    uint32                               c,
+                    uint32                              *input)
+{
+    uint32 i;
+
+    for(i=0; i<4; i++)
+    {
+        input[i] = x[(i+rot)%4] ^ ctx->op_c[(i+rot)%4];
+    }
+    input[3] ^= c;
+}
+
+/*********************************************************************
+    Name: milenage_temp
+
+    Description: Computes TEMP from RAND.
+
+    Document Reference: 35.206 v10.0.0 Section 4.1
+*********************************************************************/
+void milenage_temp(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                   uint8                               *rand,
+                   uint32                              *temp)
+{
+    uint32 rand_w[4];
+    uint32 input[4];
+
+    aes_128_load_block(rand, rand_w);
+    milenage_input(ctx, rand_w, 0, 0, input);
+    aes_128_encrypt(ctx->rk, input, temp);
+}
+
+/*********************************************************************
+    Name: milenage_load_in1
+
+    Description: Constructs IN1 from SQN and AMF.
+
+    Document Reference: 35.206 v10.0.0 Section 4.1
+*********************************************************************/
+void milenage_load_in1(uint8  *sqn,
+                       uint8  *amf,
+                       uint32 *in1)
+{
+    in1[0] = ((uint32)sqn[0] << 24) | ((uint32)sqn[1] << 16) | ((uint32)sqn[2] << 8) | sqn[3];
+    in1[1] = ((uint32)sqn[4] << 24) | ((uint32)sqn[5] << 16) | ((uint32)amf[0] << 8) | amf[1];
+    in1[2] = in1[0];
+    in1[3] = in1[1];
+}
+
+/*********************************************************************
+    Name: milenage_f1_out
+
+    Description: Computes OUT1, shared by F1 and F1*, from TEMP, SQN,
+                 and AMF.
+
+    Document Reference: 35.206 v10.0.0 Section 4.1
+*********************************************************************/
+void milenage_f1_out(LIBLTE_SECURITY_MILENAGE_CTX_STRUCT *ctx,
+                     uint32                              *temp,
+                     uint8                               *sqn,
+                     uint8                               *amf,
+                     uint32                              *out1)
+{
+    uint32 in1[4];
+    uint32 input[4];
+    uint32 i;
+
+    milenage_load_in1(sqn, amf, in1);
+    milenage_input(ctx, in1, 2, 0, input);
+    for(i=0; i<4; i++)
+    {
+        input[i] ^= temp[i];
+    }
+    aes_128_encrypt(ctx->rk, input, out1);
+    for(i=0; i<4; i++)
+    {
+        out1[i] ^= ctx->op_c[i];
+    }
+}
+
+/*********************************************************************
+    Name: milenage_store
+
+    Description: Stores N_bytes of a block of big endian words,
+                 starting at byte offset.
+
+    Document Reference: N/A
+*********************************************************************/
+void milenage_store(uint32 *in,
+                    uint32  offset,
+                    uint32  N_bytes,
+                    uint8  *out)
+{
+    uint32 i;
+
+    for(i=0; i<N_bytes; i++)
+    {
+        out[i] = (in[(offset+i)/4] >> (24 - ((offset+i)%4)*8)) & 0xFF;
+    }
+}
+
+/*********************************************************************
+    Name: snow3g_load_key
+
+    Description: Loads a 128-bit key into the SNOW 3G LFSR, leaving
+                 the IV words to be mixed in by the caller.
+
+    Document Reference: 35.216 v10.0.0 Section 4.1
+*********************************************************************/
+void snow3g_load_key(uint8  *key,
+                     uint32 *lfsr)
+{
+    uint32 k[4];
+    uint32 i;
+
+    // k3 is the most significant word of the key
+    for(i=0; i<4; i++)
+    {
+        k[3-i] = (key[i*4] << 24) | (key[i*4+1] << 16) | (key[i*4+2] << 8) | key[i*4+3];
+    }
+    for(i=0; i<4; i++)
+    {
+        lfsr[i]    = k[i] ^ 0xFFFFFFFF;
+        lfsr[4+i]  = k[i];
+        lfsr[8+i]  = k[i] ^ 0xFFFFFFFF;
+        lfsr[12+i] = k[i];
+    }
+}
+
+/*********************************************************************
+    Name: snow3g_keystream
+
+    Description: Initializes SNOW 3G from a loaded LFSR and XORs
+                 N_bytes of keystream over msg.
+
+    Document Reference: 35.216 v10.0.0 Section 4
 *********************************************************************/
-void rijndael_encrypt(uint8            *input,
-                      ROUND_KEY_STRUCT *rk,
-                      uint8            *output)
+void snow3g_keystream(uint32 *lfsr_init,
+                      uint8  *msg,
+                      uint32  N_bytes,
+                      uint8  *out)
 {
-    STATE_STRUCT state;
-    uint32       i;
-    uint32       r;
+    uint32 s[16];
+    uint32 r1 = 0;
+    uint32 r2 = 0;
+    uint32 r3 = 0;
+    uint32 f;
+    uint32 r;
+    uint32 v;
+    uint32 z;
+    uint32 p  = 0;
+    uint32 i;
+    uint32 j;
 
-    // Initialize and perform round 0
+    // The LFSR is a ring, s[(p+i)&15] is s_i
     for(i=0; i<16; i++)
     {
-        state.state[i & 0x03][i >> 2] = input[i];
+        s[i] = lfsr_init[i];
     }
-    key_add(&state, rk, 0);
 
-    // Perform rounds 1 through 9
-    for(r=1; r<=9; r++)
+    // Initialization mode, followed by one keystream mode clock
+    for(i=0; i<33; i++)
     {
-        byte_sub(&state);
-        shift_row(&state);
-        mix_column(&state);
-        key_add(&state, rk, r);
+        f  = (s[(p+15)&15] + r1) ^ r2;
+        r  = r2 + (r3 ^ s[(p+5)&15]);
+        r3 = SNOW3G_S(SNOW3G_S2_T, r2);
+        r2 = SNOW3G_S(SNOW3G_S1_T, r1);
+        r1 = r;
+        v  = (s[p] << 8) ^ SNOW3G_MUL_ALPHA[s[p] >> 24] ^ s[(p+2)&15] ^ (s[(p+11)&15] >> 8) ^ SNOW3G_DIV_ALPHA[s[(p+11)&15] & 0xFF];
+        if(i < 32)
+        {
+            v ^= f;
+        }
+        s[p] = v;
+        p    = (p + 1) & 15;
     }
 
-    // Perform round 10
-    byte_sub(&state);
-    shift_row(&state);
-    key_add(&state, rk, r);
+    // Keystream
+    for(i=0; i<N_bytes; i+=4)
+    {
+        z  = ((s[(p+15)&15] + r1) ^ r2) ^ s[p];
+        r  = r2 + (r3 ^ s[(p+5)&15]);
+        r3 = SNOW3G_S(SNOW3G_S2_T, r2);
+        r2 = SNOW3G_S(SNOW3G_S1_T, r1);
+        r1 = r;
+        v  = (s[p] << 8) ^ SNOW3G_MUL_ALPHA[s[p] >> 24] ^ s[(p+2)&15] ^ (s[(p+11)&15] >> 8) ^ SNOW3G_DIV_ALPHA[s[(p+11)&15] & 0xFF];
+        s[p] = v;
+        p    = (p + 1) & 15;
+        if(i+4 <= N_bytes)
+        {
+            out[i]   = msg[i]   ^ (z >> 24);
+            out[i+1] = msg[i+1] ^ ((z >> 16) & 0xFF);
+            out[i+2] = msg[i+2] ^ ((z >> 8) & 0xFF);
+            out[i+3] = msg[i+3] ^ (z & 0xFF);
+        }else{
+            for(j=0; i+j<N_bytes; j++)
+            {
+                out[i+j] = msg[i+j] ^ ((z >> (24 - j*8)) & 0xFF);
+            }
+        }
+    }
+}
+
+/*********************************************************************
+    Name: zuc_load_key
+
+    Description: Loads a 128-bit key and the D constants into the ZUC
+                 LFSR, leaving the IV bytes to be mixed in by the
+                 caller.
+
+    Document Reference: 35.222 v11.0.0 Section 3.5.1
+*********************************************************************/
+void zuc_load_key(uint8  *key,
+                  uint32 *lfsr)
+{
+    uint32 i;
 
-    // Return output
     for(i=0; i<16; i++)
     {
-        output[i] = state.state[i & 0x03][i >> 2];
+        lfsr[i] = (key[i] << 23) | (ZUC_D[i] << 8);
     }
 }
 
 /*********************************************************************
-    Name: key_add
+    Name: zuc_keystream
 
-    Description: Round key addition function.
+    Description: Initializes ZUC from a loaded LFSR and XORs N_bytes
+                 of keystream over msg.
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: 35.222 v11.0.0 Section 3
 *********************************************************************/
-void key_add(STATE_STRUCT     *state,
-             ROUND_KEY_STRUCT *rk,
-             uint32            round)
+void zuc_keystream(uint32 *lfsr_init,
+                   uint8  *msg,
+                   uint32  N_bytes,
+                   uint8  *out)
 {
+    uint32 s[16];
+    uint32 r1 = 0;
+    uint32 r2 = 0;
+    uint32 x0;
+    uint32 x1;
+    uint32 x2;
+    uint32 x3;
+    uint32 w;
+    uint32 w1;
+    uint32 w2;
+    uint64 v;
+    uint32 z;
+    uint32 p  = 0;
     uint32 i;
     uint32 j;
 
-    for(i=0; i<4; i++)
+    // The LFSR is a ring, s[(p+i)&15] is s_i
+    for(i=0; i<16; i++)
+    {
+        s[i] = lfsr_init[i];
+    }
+
+    // Initialization mode, followed by one work mode clock
+    for(i=0; i<33; i++)
     {
-        for(j=0; j<4; j++)
+        // Bit reorganization
+        x0 = ((s[(p+15)&15] & 0x7FFF8000) << 1) | (s[(p+14)&15] & 0xFFFF);
+        x1 = ((s[(p+11)&15] & 0xFFFF) << 16) | (s[(p+9)&15] >> 15);
+        x2 = ((s[(p+7)&15] & 0xFFFF) << 16) | (s[(p+5)&15] >> 15);
+
+        // Nonlinear function F
+        w  = (x0 ^ r1) + r2;
+        w1 = r1 + x1;
+        w2 = r2 ^ x2;
+        r1 = ZUC_L1((w1 << 16) | (w2 >> 16));
+        r1 = ZUC_S(r1);
+        r2 = ZUC_L2((w2 << 16) | (w1 >> 16));
+        r2 = ZUC_S(r2);
+
+        // LFSR, summed in 64 bits and reduced modulo 2^31-1
+        v = ((uint64)s[(p+15)&15] << 15) + ((uint64)s[(p+13)&15] << 17) + ((uint64)s[(p+10)&15] << 21) +
+            ((uint64)s[(p+4)&15] << 20) + ((uint64)s[p] << 8) + s[p];
+        if(i < 32)
+        {
+            v += w >> 1;
+        }
+        v = (v & 0x7FFFFFFF) + (v >> 31);
+        v = (v & 0x7FFFFFFF) + (v >> 31);
+        v = (v & 0x7FFFFFFF) + (v >> 31);
+        if(v == 0)
         {
-            state->state[i][j] ^= rk->rk[round][i][j];
+            v = 0x7FFFFFFF;
+        }
+        s[p] = (uint32)v;
+        p    = (p + 1) & 15;
+    }
+
+    // Keystream
+    for(i=0; i<N_bytes; i+=4)
+    {
+        x0 = ((s[(p+15)&15] & 0x7FFF8000) << 1) | (s[(p+14)&15] & 0xFFFF);
+        x1 = ((s[(p+11)&15] & 0xFFFF) << 16) | (s[(p+9)&15] >> 15);
+        x2 = ((s[(p+7)&15] & 0xFFFF) << 16) | (s[(p+5)&15] >> 15);
+        x3 = ((s[(p+2)&15] & 0xFFFF) << 16) | (s[p] >> 15);
+        z  = ((x0 ^ r1) + r2) ^ x3;
+        w1 = r1 + x1;
+        w2 = r2 ^ x2;
+        r1 = ZUC_L1((w1 << 16) | (w2 >> 16));
+        r1 = ZUC_S(r1);
+        r2 = ZUC_L2((w2 << 16) | (w1 >> 16));
+        r2 = ZUC_S(r2);
+        v  = ((uint64)s[(p+15)&15] << 15) + ((uint64)s[(p+13)&15] << 17) + ((uint64)s[(p+10)&15] << 21) +
+             ((uint64)s[(p+4)&15] << 20) + ((uint64)s[p] << 8) + s[p];
+        v  = (v & 0x7FFFFFFF) + (v >> 31);
+        v  = (v & 0x7FFFFFFF) + (v >> 31);
+        v  = (v & 0x7FFFFFFF) + (v >> 31);
+        if(v == 0)
+        {
+            v = 0x7FFFFFFF;
+        }
+        s[p] = (uint32)v;
+        p    = (p + 1) & 15;
+        if(i+4 <= N_bytes)
+        {
+            out[i]   = msg[i]   ^ (z >> 24);
+            out[i+1] = msg[i+1] ^ ((z >> 16) & 0xFF);
+            out[i+2] = msg[i+2] ^ ((z >> 8) & 0xFF);
+            out[i+3] = msg[i+3] ^ (z & 0xFF);
+        }else{
+            for(j=0; i+j<N_bytes; j++)
+            {
+                out[i+j] = msg[i+j] ^ ((z >> (24 - j*8)) & 0xFF);
+            }
         }
     }
 }
 
 /*********************************************************************
-    Name: byte_sub
+    Name: cipher_pdu
 
-    Description: Byte substitution transformation.
+    Description: Ciphers or deciphers one PDU with a cipher context.
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: 33.401 v10.0.0 Annex B.1
 *********************************************************************/
-void byte_sub(STATE_STRUCT *state)
+void cipher_pdu(LIBLTE_SECURITY_CIPHER_CTX_STRUCT *ctx,
+                uint32                             count,
+                uint8                             *msg,
+                uint32                             N_bits,
+                uint8                             *out)
 {
+    uint32 lfsr[16];
+    uint32 N_bytes = (N_bits + 7) / 8;
+    uint32 ctr[4];
+    uint32 ks[4];
     uint32 i;
     uint32 j;
 
-    for(i=0; i<4; i++)
+    if(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA1 == ctx->alg)
     {
-        for(j=0; j<4; j++)
+        // IV1 and IV3 are COUNT
+        memcpy(lfsr, ctx->lfsr, sizeof(lfsr));
+        lfsr[12] ^= count;
+        lfsr[9]  ^= count;
+        snow3g_keystream(lfsr, msg, N_bytes, out);
+    }else if(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA2 == ctx->alg){
+        // Counter block is COUNT | BEARER | DIRECTION | 0
+        ctr[0] = count;
+        ctr[1] = (ctx->bearer << 27) | (ctx->direction << 26);
+        ctr[2] = 0;
+        ctr[3] = 0;
+        for(i=0; i<N_bytes; i+=16)
         {
-            state->state[i][j] = S[state->state[i][j]];
+            aes_128_encrypt(ctx->rk, ctr, ks);
+            for(j=0; j<16 && i+j<N_bytes; j++)
+            {
+                out[i+j] = msg[i+j] ^ ((ks[j/4] >> (24 - (j%4)*8)) & 0xFF);
+            }
+            ctr[3]++;
+            if(ctr[3] == 0)
+            {
+                ctr[2]++;
+            }
+        }
+    }else if(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA3 == ctx->alg){
+        // IV0 to IV3 and IV8 to IV11 are COUNT
+        memcpy(lfsr, ctx->lfsr, sizeof(lfsr));
+        for(i=0; i<4; i++)
+        {
+            lfsr[i]   |= (count >> (24 - i*8)) & 0xFF;
+            lfsr[8+i] |= (count >> (24 - i*8)) & 0xFF;
         }
+        zuc_keystream(lfsr, msg, N_bytes, out);
+    }else if(msg != out){
+        memcpy(out, msg, N_bytes);
+    }
+
+    // Zero the bits past the end of the message
+    if((N_bits % 8) != 0)
+    {
+        out[N_bytes-1] &= 0xFF << (8 - (N_bits % 8));
     }
 }
 
 /*********************************************************************
-    Name: shift_row
+    Name: cmac_double
 
-    Description: Row shift transformation.
+    Description: Multiplies a 128-bit CMAC value, held as four big
+                 endian words, by x in GF(2^128).
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: RFC4493 Section 2.3
 *********************************************************************/
-void shift_row(STATE_STRUCT *state)
+void cmac_double(uint32 *in,
+                 uint32 *out)
 {
-    uint8 temp;
-
-    // Left rotate row 1 by 1
-    temp               = state->state[1][0];
-    state->state[1][0] = state->state[1][1];
-    state->state[1][1] = state->state[1][2];
-    state->state[1][2] = state->state[1][3];
-    state->state[1][3] = temp;
-
-    // Left rotate row 2 by 2
-    temp               = state->state[2][0];
-    state->state[2][0] = state->state[2][2];
-    state->state[2][2] = temp;
-    temp               = state->state[2][1];
-    state->state[2][1] = state->state[2][3];
-    state->state[2][3] = temp;
-
-    // Left rotate row 3 by 3
-    temp               = state->state[3][0];
-    state->state[3][0] = state->state[3][3];
-    state->state[3][3] = state->state[3][2];
-    state->state[3][2] = state->state[3][1];
-    state->state[3][1] = temp;
+    uint32 msb = in[0] >> 31;
+
+    out[0] = (in[0] << 1) | (in[1] >> 31);
+    out[1] = (in[1] << 1) | (in[2] >> 31);
+    out[2] = (in[2] << 1) | (in[3] >> 31);
+    out[3] = (in[3] << 1) ^ (msb * 0x87);
 }
 
 /*********************************************************************
-    Name: mix_column
+    Name: eia2_mac
 
-    Description: Mix column transformation.
+    Description: Computes the EIA2 MAC of one message with an
+                 integrity context.
 
-    Document Reference: 35.206 v10.0.0 Annex 3
+    Document Reference: 33.401 v10.0.0 Annex B.2.3
+                        RFC4493 Section 2.4
 *********************************************************************/
-void mix_column(STATE_STRUCT *state)
+void eia2_mac(LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT *ctx,
+              uint32                                count,
+              uint8                                *msg,
+              uint32                                N_bits,
+              uint8                                *mac)
 {
-    uint32 i;
-    uint8  temp;
-    uint8  tmp0;
-    uint8  tmp;
-
-    for(i=0; i<4; i++)
+    uint8  *ptr;
+    uint32  M[4];
+    uint32  T[4];
+    uint32  N_bytes  = (N_bits + 7) / 8;
+    uint32  N_blocks = (N_bits + 64 + 127) / 128;
+    uint32  last_bits;
+    uint32  idx;
+    uint32  i;
+    uint32  j;
+
+    // First block starts with COUNT | BEARER | DIRECTION | 0
+    T[0] = count;
+    T[1] = (ctx->bearer << 27) | (ctx->direction << 26);
+    T[2] = 0;
+    T[3] = 0;
+    ptr  = msg;
+    if(N_blocks > 1)
     {
-        temp = state->state[0][i] ^ state->state[1][i] ^ state->state[2][i] ^ state->state[3][i];
-        tmp0 = state->state[0][i];
-
-        tmp                 = X_TIME[state->state[0][i] ^ state->state[1][i]];
-        state->state[0][i] ^= temp ^ tmp;
+        T[2] = ((uint32)ptr[0] << 24) | ((uint32)ptr[1] << 16) | ((uint32)ptr[2] << 8) | ptr[3];
+        T[3] = ((uint32)ptr[4] << 24) | ((uint32)ptr[5] << 16) | ((uint32)ptr[6] << 8) | ptr[7];
+        ptr += 8;
+        aes_128_encrypt(ctx->rk, T, T);
 
-        tmp                 = X_TIME[state->state[1][i] ^ state->state[2][i]];
-        state->state[1][i] ^= temp ^ tmp;
+        // Complete blocks other than the last
+        for(i=2; i<N_blocks; i++)
+        {
+            for(j=0; j<4; j++)
+            {
+                T[j] ^= ((uint32)ptr[0] << 24) | ((uint32)ptr[1] << 16) | ((uint32)ptr[2] << 8) | ptr[3];
+                ptr  += 4;
+            }
+            aes_128_encrypt(ctx->rk, T, T);
+        }
+    }
 
-        tmp                 = X_TIME[state->state[2][i] ^ state->state[3][i]];
-        state->state[2][i] ^= temp ^ tmp;
+    // Last block, possibly partial, taken byte by byte
+    idx = ptr - msg;
+    for(i=0; i<4; i++)
+    {
+        M[i] = 0;
+    }
+    for(i=(N_blocks == 1) ? 8 : 0; i<16 && idx<N_bytes; i++)
+    {
+        M[i/4] |= (uint32)msg[idx++] << (24 - (i%4)*8);
+    }
+    last_bits = N_bits + 64 - (N_blocks - 1)*128;
+    if(last_bits == 128)
+    {
+        for(i=0; i<4; i++)
+        {
+            T[i] ^= M[i] ^ ctx->k1[i];
+        }
+    }else{
+        // Clear the bits past the end of the message and append a one bit
+        for(i=0; i<4; i++)
+        {
+            if(last_bits <= i*32)
+            {
+                M[i] = 0;
+            }else if(last_bits < (i+1)*32){
+                M[i] &= ~(0xFFFFFFFF >> (last_bits - i*32));
+            }
+        }
+        M[last_bits/32] |= 0x80000000 >> (last_bits % 32);
+        for(i=0; i<4; i++)
+        {
+            T[i] ^= M[i] ^ ctx->k2[i];
+        }
+    }
+    aes_128_encrypt(ctx->rk, T, T);
 
-        tmp                 = X_TIME[state->state[3][i] ^ tmp0];
-        state->state[3][i] ^= temp ^ tmp;
+    for(i=0; i<4; i++)
+    {
+        mac[i] = (T[0] >> (24 - i*8)) & 0xFF;
     }
 }
@@ -0,0 +1,79 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_bench_common.h
+
+    Description: Contains all the definitions for the common liblte benchmark
+                 utilities.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+#ifndef __LIBLTE_BENCH_COMMON_H__
+#define __LIBLTE_BENCH_COMMON_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "typedefs.h"
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              DECLARATIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: liblte_bench_get_time_ns
+
+    Description: Returns a monotonic timestamp in nanoseconds
+*********************************************************************/
+uint64 liblte_bench_get_time_ns(void);
+
+/*********************************************************************
+    Name: liblte_bench_rand
+
+    Description: Returns the next value of a repeatable pseudo random
+                 sequence, so that results are comparable across runs
+*********************************************************************/
+uint32 liblte_bench_rand(uint32 *seed);
+
+/*********************************************************************
+    Name: liblte_bench_random_bits
+
+    Description: Fills a bit array (one bit per byte) with pseudo
+                 random bits
+*********************************************************************/
+void liblte_bench_random_bits(uint32 *seed,
+                              uint8  *bits,
+                              uint32  N_bits);
+
+#endif /* __LIBLTE_BENCH_COMMON_H__ */
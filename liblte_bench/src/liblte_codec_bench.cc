@@ -0,0 +1,1717 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_codec_bench.cc
+
+    Description: Round trips a corpus of RRC, NAS, MAC, RLC, and PDCP
+                 messages through the public pack and unpack functions
+                 of liblte.  Every message is packed, unpacked, and
+                 repacked, and the two encodings must be identical.
+                 Reports nanoseconds per pack and per unpack and the
+                 heap bytes allocated through operator new, and
+                 optionally writes the results as JSON so that runs
+                 can be compared over time.
+
+                 Usage: liblte_codec_bench [N_msgs [results.json]]
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_bench_common.h"
+#include "liblte_rrc.h"
+#include "liblte_mme.h"
+#include "liblte_mac.h"
+#include "liblte_rlc.h"
+#include "liblte_pdcp.h"
+#include "liblte_security.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <new>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define CODEC_BENCH_DEFAULT_N_MSGS 20000
+#define CODEC_BENCH_IMSI           1010123456789ULL
+#define CODEC_BENCH_M_TMSI         0x12345678
+#define CODEC_BENCH_MCC            0xF001
+#define CODEC_BENCH_MNC            0xFF01
+#define CODEC_BENCH_NAS_MCC        1
+#define CODEC_BENCH_NAS_MNC        1
+#define CODEC_BENCH_TAC            1
+#define CODEC_BENCH_EBI            5
+#define CODEC_BENCH_PTI            1
+#define CODEC_BENCH_N_NAS_BYTES    64
+#define CODEC_BENCH_N_SDU_BYTES    300
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef enum{
+    CODEC_BENCH_LAYER_RRC = 0,
+    CODEC_BENCH_LAYER_MME,
+    CODEC_BENCH_LAYER_MAC,
+    CODEC_BENCH_LAYER_RLC,
+    CODEC_BENCH_LAYER_PDCP,
+    CODEC_BENCH_LAYER_N_ITEMS,
+}CODEC_BENCH_LAYER_ENUM;
+static const char codec_bench_layer_text[CODEC_BENCH_LAYER_N_ITEMS][8] = {"RRC", "MME", "MAC", "RLC", "PDCP"};
+
+typedef enum{
+    CODEC_BENCH_CASE_RRC_MIB = 0,
+    CODEC_BENCH_CASE_RRC_SIB1,
+    CODEC_BENCH_CASE_RRC_SIB2,
+    CODEC_BENCH_CASE_RRC_SYS_INFO,
+    CODEC_BENCH_CASE_RRC_PAGING,
+    CODEC_BENCH_CASE_RRC_CON_SETUP,
+    CODEC_BENCH_CASE_RRC_CON_REJECT,
+    CODEC_BENCH_CASE_RRC_CON_REEST,
+    CODEC_BENCH_CASE_RRC_CON_REEST_REJECT,
+    CODEC_BENCH_CASE_RRC_CON_REQUEST,
+    CODEC_BENCH_CASE_RRC_CON_REEST_REQUEST,
+    CODEC_BENCH_CASE_RRC_SECURITY_MODE_COMMAND,
+    CODEC_BENCH_CASE_RRC_CON_RECONFIG,
+    CODEC_BENCH_CASE_RRC_DL_INFO_TRANSFER,
+    CODEC_BENCH_CASE_RRC_CON_RELEASE,
+    CODEC_BENCH_CASE_RRC_UE_INFO_REQUEST,
+    CODEC_BENCH_CASE_RRC_CON_SETUP_COMPLETE,
+    CODEC_BENCH_CASE_RRC_SECURITY_MODE_COMPLETE,
+    CODEC_BENCH_CASE_RRC_SECURITY_MODE_FAILURE,
+    CODEC_BENCH_CASE_RRC_CON_RECONFIG_COMPLETE,
+    CODEC_BENCH_CASE_RRC_UL_INFO_TRANSFER,
+    CODEC_BENCH_CASE_MME_ATTACH_ACCEPT,
+    CODEC_BENCH_CASE_MME_ATTACH_COMPLETE,
+    CODEC_BENCH_CASE_MME_ATTACH_REJECT,
+    CODEC_BENCH_CASE_MME_ATTACH_REQUEST,
+    CODEC_BENCH_CASE_MME_AUTHENTICATION_FAILURE,
+    CODEC_BENCH_CASE_MME_AUTHENTICATION_REJECT,
+    CODEC_BENCH_CASE_MME_AUTHENTICATION_REQUEST,
+    CODEC_BENCH_CASE_MME_AUTHENTICATION_RESPONSE,
+    CODEC_BENCH_CASE_MME_DETACH_ACCEPT,
+    CODEC_BENCH_CASE_MME_DETACH_REQUEST,
+    CODEC_BENCH_CASE_MME_DL_NAS_TRANSPORT,
+    CODEC_BENCH_CASE_MME_EMM_STATUS,
+    CODEC_BENCH_CASE_MME_EXTENDED_SERVICE_REQUEST,
+    CODEC_BENCH_CASE_MME_GUTI_REALLOCATION_COMMAND,
+    CODEC_BENCH_CASE_MME_GUTI_REALLOCATION_COMPLETE,
+    CODEC_BENCH_CASE_MME_IDENTITY_REQUEST,
+    CODEC_BENCH_CASE_MME_IDENTITY_RESPONSE,
+    CODEC_BENCH_CASE_MME_SECURITY_MODE_COMMAND,
+    CODEC_BENCH_CASE_MME_SECURITY_MODE_COMPLETE,
+    CODEC_BENCH_CASE_MME_SECURITY_MODE_REJECT,
+    CODEC_BENCH_CASE_MME_SERVICE_REJECT,
+    CODEC_BENCH_CASE_MME_SERVICE_REQUEST,
+    CODEC_BENCH_CASE_MME_TAU_ACCEPT,
+    CODEC_BENCH_CASE_MME_TAU_COMPLETE,
+    CODEC_BENCH_CASE_MME_TAU_REJECT,
+    CODEC_BENCH_CASE_MME_UL_NAS_TRANSPORT,
+    CODEC_BENCH_CASE_MME_DL_GENERIC_NAS_TRANSPORT,
+    CODEC_BENCH_CASE_MME_UL_GENERIC_NAS_TRANSPORT,
+    CODEC_BENCH_CASE_MME_ACT_DED_EPS_BEARER_ACCEPT,
+    CODEC_BENCH_CASE_MME_ACT_DED_EPS_BEARER_REJECT,
+    CODEC_BENCH_CASE_MME_ACT_DED_EPS_BEARER_REQUEST,
+    CODEC_BENCH_CASE_MME_ACT_DEF_EPS_BEARER_ACCEPT,
+    CODEC_BENCH_CASE_MME_ACT_DEF_EPS_BEARER_REJECT,
+    CODEC_BENCH_CASE_MME_ACT_DEF_EPS_BEARER_REQUEST,
+    CODEC_BENCH_CASE_MME_BEARER_RES_ALLOC_REJECT,
+    CODEC_BENCH_CASE_MME_BEARER_RES_MOD_REJECT,
+    CODEC_BENCH_CASE_MME_DEACT_EPS_BEARER_ACCEPT,
+    CODEC_BENCH_CASE_MME_DEACT_EPS_BEARER_REQUEST,
+    CODEC_BENCH_CASE_MME_ESM_INFO_REQUEST,
+    CODEC_BENCH_CASE_MME_ESM_INFO_RESPONSE,
+    CODEC_BENCH_CASE_MME_ESM_STATUS,
+    CODEC_BENCH_CASE_MME_MOD_EPS_BEARER_ACCEPT,
+    CODEC_BENCH_CASE_MME_MOD_EPS_BEARER_REJECT,
+    CODEC_BENCH_CASE_MME_NOTIFICATION,
+    CODEC_BENCH_CASE_MME_PDN_CON_REJECT,
+    CODEC_BENCH_CASE_MME_PDN_CON_REQUEST,
+    CODEC_BENCH_CASE_MME_PDN_DISCON_REJECT,
+    CODEC_BENCH_CASE_MME_PDN_DISCON_REQUEST,
+    CODEC_BENCH_CASE_MAC_DLSCH_PDU,
+    CODEC_BENCH_CASE_MAC_ULSCH_PDU,
+    CODEC_BENCH_CASE_MAC_RAR_PDU,
+    CODEC_BENCH_CASE_RLC_UMD_PDU,
+    CODEC_BENCH_CASE_RLC_AMD_PDU,
+    CODEC_BENCH_CASE_RLC_STATUS_PDU,
+    CODEC_BENCH_CASE_PDCP_CONTROL_PDU,
+    CODEC_BENCH_CASE_PDCP_DATA_PDU_LONG_SN,
+    CODEC_BENCH_CASE_PDCP_ROHC_FEEDBACK_PDU,
+    CODEC_BENCH_CASE_N_ITEMS,
+}CODEC_BENCH_CASE_ENUM;
+
+typedef struct{
+    const char             *name;
+    CODEC_BENCH_LAYER_ENUM  layer;
+    bool                    bits;
+}CODEC_BENCH_CASE_INFO_STRUCT;
+static const CODEC_BENCH_CASE_INFO_STRUCT codec_bench_case_info[CODEC_BENCH_CASE_N_ITEMS] = {
+    {"MIB",                               CODEC_BENCH_LAYER_RRC,  true},
+    {"SIB1",                              CODEC_BENCH_LAYER_RRC,  true},
+    {"SIB2",                              CODEC_BENCH_LAYER_RRC,  true},
+    {"System Information",                CODEC_BENCH_LAYER_RRC,  true},
+    {"Paging",                            CODEC_BENCH_LAYER_RRC,  true},
+    {"RRC Connection Setup",              CODEC_BENCH_LAYER_RRC,  true},
+    {"RRC Connection Reject",             CODEC_BENCH_LAYER_RRC,  true},
+    {"RRC Connection Reest",              CODEC_BENCH_LAYER_RRC,  true},
+    {"RRC Connection Reest Reject",       CODEC_BENCH_LAYER_RRC,  true},
+    {"RRC Connection Request",            CODEC_BENCH_LAYER_RRC,  true},
+    {"RRC Connection Reest Request",      CODEC_BENCH_LAYER_RRC,  true},
+    {"Security Mode Command",             CODEC_BENCH_LAYER_RRC,  true},
+    {"RRC Connection Reconfig",           CODEC_BENCH_LAYER_RRC,  true},
+    {"DL Information Transfer",           CODEC_BENCH_LAYER_RRC,  true},
+    {"RRC Connection Release",            CODEC_BENCH_LAYER_RRC,  true},
+    {"UE Information Request",            CODEC_BENCH_LAYER_RRC,  true},
+    {"RRC Connection Setup Complete",     CODEC_BENCH_LAYER_RRC,  true},
+    {"Security Mode Complete",            CODEC_BENCH_LAYER_RRC,  true},
+    {"Security Mode Failure",             CODEC_BENCH_LAYER_RRC,  true},
+    {"RRC Connection Reconfig Complete",  CODEC_BENCH_LAYER_RRC,  true},
+    {"UL Information Transfer",           CODEC_BENCH_LAYER_RRC,  true},
+    {"Attach Accept",                     CODEC_BENCH_LAYER_MME,  false},
+    {"Attach Complete",                   CODEC_BENCH_LAYER_MME,  false},
+    {"Attach Reject",                     CODEC_BENCH_LAYER_MME,  false},
+    {"Attach Request",                    CODEC_BENCH_LAYER_MME,  false},
+    {"Authentication Failure",            CODEC_BENCH_LAYER_MME,  false},
+    {"Authentication Reject",             CODEC_BENCH_LAYER_MME,  false},
+    {"Authentication Request",            CODEC_BENCH_LAYER_MME,  false},
+    {"Authentication Response",           CODEC_BENCH_LAYER_MME,  false},
+    {"Detach Accept",                     CODEC_BENCH_LAYER_MME,  false},
+    {"Detach Request",                    CODEC_BENCH_LAYER_MME,  false},
+    {"Downlink NAS Transport",            CODEC_BENCH_LAYER_MME,  false},
+    {"EMM Status",                        CODEC_BENCH_LAYER_MME,  false},
+    {"Extended Service Request",          CODEC_BENCH_LAYER_MME,  false},
+    {"GUTI Reallocation Command",         CODEC_BENCH_LAYER_MME,  false},
+    {"GUTI Reallocation Complete",        CODEC_BENCH_LAYER_MME,  false},
+    {"Identity Request",                  CODEC_BENCH_LAYER_MME,  false},
+    {"Identity Response",                 CODEC_BENCH_LAYER_MME,  false},
+    {"Security Mode Command",             CODEC_BENCH_LAYER_MME,  false},
+    {"Security Mode Complete",            CODEC_BENCH_LAYER_MME,  false},
+    {"Security Mode Reject",              CODEC_BENCH_LAYER_MME,  false},
+    {"Service Reject",                    CODEC_BENCH_LAYER_MME,  false},
+    {"Service Request",                   CODEC_BENCH_LAYER_MME,  false},
+    {"Tracking Area Update Accept",       CODEC_BENCH_LAYER_MME,  false},
+    {"Tracking Area Update Complete",     CODEC_BENCH_LAYER_MME,  false},
+    {"Tracking Area Update Reject",       CODEC_BENCH_LAYER_MME,  false},
+    {"Uplink NAS Transport",              CODEC_BENCH_LAYER_MME,  false},
+    {"Downlink Generic NAS Transport",    CODEC_BENCH_LAYER_MME,  false},
+    {"Uplink Generic NAS Transport",      CODEC_BENCH_LAYER_MME,  false},
+    {"Act Ded EPS Bearer Ctx Accept",     CODEC_BENCH_LAYER_MME,  false},
+    {"Act Ded EPS Bearer Ctx Reject",     CODEC_BENCH_LAYER_MME,  false},
+    {"Act Ded EPS Bearer Ctx Request",    CODEC_BENCH_LAYER_MME,  false},
+    {"Act Def EPS Bearer Ctx Accept",     CODEC_BENCH_LAYER_MME,  false},
+    {"Act Def EPS Bearer Ctx Reject",     CODEC_BENCH_LAYER_MME,  false},
+    {"Act Def EPS Bearer Ctx Request",    CODEC_BENCH_LAYER_MME,  false},
+    {"Bearer Resource Alloc Reject",      CODEC_BENCH_LAYER_MME,  false},
+    {"Bearer Resource Mod Reject",        CODEC_BENCH_LAYER_MME,  false},
+    {"Deact EPS Bearer Ctx Accept",       CODEC_BENCH_LAYER_MME,  false},
+    {"Deact EPS Bearer Ctx Request",      CODEC_BENCH_LAYER_MME,  false},
+    {"ESM Information Request",           CODEC_BENCH_LAYER_MME,  false},
+    {"ESM Information Response",          CODEC_BENCH_LAYER_MME,  false},
+    {"ESM Status",                        CODEC_BENCH_LAYER_MME,  false},
+    {"Modify EPS Bearer Ctx Accept",      CODEC_BENCH_LAYER_MME,  false},
+    {"Modify EPS Bearer Ctx Reject",      CODEC_BENCH_LAYER_MME,  false},
+    {"Notification",                      CODEC_BENCH_LAYER_MME,  false},
+    {"PDN Connectivity Reject",           CODEC_BENCH_LAYER_MME,  false},
+    {"PDN Connectivity Request",          CODEC_BENCH_LAYER_MME,  false},
+    {"PDN Disconnect Reject",             CODEC_BENCH_LAYER_MME,  false},
+    {"PDN Disconnect Request",            CODEC_BENCH_LAYER_MME,  false},
+    {"DL-SCH PDU",                        CODEC_BENCH_LAYER_MAC,  true},
+    {"UL-SCH PDU",                        CODEC_BENCH_LAYER_MAC,  true},
+    {"Random Access Response",            CODEC_BENCH_LAYER_MAC,  true},
+    {"UMD PDU",                           CODEC_BENCH_LAYER_RLC,  false},
+    {"AMD PDU",                           CODEC_BENCH_LAYER_RLC,  false},
+    {"Status PDU",                        CODEC_BENCH_LAYER_RLC,  false},
+    {"Control PDU",                       CODEC_BENCH_LAYER_PDCP, false},
+    {"Data PDU long SN",                  CODEC_BENCH_LAYER_PDCP, false},
+    {"ROHC Feedback PDU",                 CODEC_BENCH_LAYER_PDCP, false}};
+
+typedef struct{
+    LIBLTE_BIT_MSG_STRUCT  bits;
+    LIBLTE_BYTE_MSG_STRUCT bytes;
+}CODEC_BENCH_MSG_STRUCT;
+
+typedef struct{
+    uint64 pack_ns;
+    uint64 unpack_ns;
+    uint64 first_alloc_bytes;
+    uint64 pack_alloc_bytes;
+    uint64 unpack_alloc_bytes;
+    uint32 N_bits;
+    bool   codec_error;
+    bool   mismatch;
+}CODEC_BENCH_RESULT_STRUCT;
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+// Index 0 holds the corpus message, index 1 the unpacked copy
+static LIBLTE_RRC_MIB_STRUCT                                             rrc_mib[2];
+static LIBLTE_RRC_BCCH_DLSCH_MSG_STRUCT                                  rrc_sib1[2];
+static LIBLTE_RRC_BCCH_DLSCH_MSG_STRUCT                                  rrc_sib2[2];
+static LIBLTE_RRC_SYS_INFO_MSG_STRUCT                                    rrc_sys_info[2];
+static LIBLTE_RRC_PCCH_MSG_STRUCT                                        rrc_paging[2];
+static LIBLTE_RRC_DL_CCCH_MSG_STRUCT                                     rrc_con_setup[2];
+static LIBLTE_RRC_DL_CCCH_MSG_STRUCT                                     rrc_con_rej[2];
+static LIBLTE_RRC_DL_CCCH_MSG_STRUCT                                     rrc_con_reest[2];
+static LIBLTE_RRC_DL_CCCH_MSG_STRUCT                                     rrc_con_reest_rej[2];
+static LIBLTE_RRC_UL_CCCH_MSG_STRUCT                                     rrc_con_req[2];
+static LIBLTE_RRC_UL_CCCH_MSG_STRUCT                                     rrc_con_reest_req[2];
+static LIBLTE_RRC_DL_DCCH_MSG_STRUCT                                     rrc_sec_mode_cmd[2];
+static LIBLTE_RRC_DL_DCCH_MSG_STRUCT                                     rrc_con_reconfig[2];
+static LIBLTE_RRC_DL_DCCH_MSG_STRUCT                                     rrc_dl_info_transfer[2];
+static LIBLTE_RRC_DL_DCCH_MSG_STRUCT                                     rrc_con_release[2];
+static LIBLTE_RRC_DL_DCCH_MSG_STRUCT                                     rrc_ue_info_req[2];
+static LIBLTE_RRC_UL_DCCH_MSG_STRUCT                                     rrc_con_setup_complete[2];
+static LIBLTE_RRC_UL_DCCH_MSG_STRUCT                                     rrc_sec_mode_complete[2];
+static LIBLTE_RRC_UL_DCCH_MSG_STRUCT                                     rrc_sec_mode_failure[2];
+static LIBLTE_RRC_UL_DCCH_MSG_STRUCT                                     rrc_con_reconfig_complete[2];
+static LIBLTE_RRC_UL_DCCH_MSG_STRUCT                                     rrc_ul_info_transfer[2];
+static LIBLTE_MME_ATTACH_ACCEPT_MSG_STRUCT                               attach_accept[2];
+static LIBLTE_MME_ATTACH_COMPLETE_MSG_STRUCT                             attach_comp[2];
+static LIBLTE_MME_ATTACH_REJECT_MSG_STRUCT                               attach_rej[2];
+static LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT                              attach_req[2];
+static LIBLTE_MME_AUTHENTICATION_FAILURE_MSG_STRUCT                      auth_fail[2];
+static LIBLTE_MME_AUTHENTICATION_REJECT_MSG_STRUCT                       auth_rej[2];
+static LIBLTE_MME_AUTHENTICATION_REQUEST_MSG_STRUCT                      auth_req[2];
+static LIBLTE_MME_AUTHENTICATION_RESPONSE_MSG_STRUCT                     auth_resp[2];
+static LIBLTE_MME_DETACH_ACCEPT_MSG_STRUCT                               detach_accept[2];
+static LIBLTE_MME_DETACH_REQUEST_MSG_STRUCT                              detach_req[2];
+static LIBLTE_MME_DOWNLINK_NAS_TRANSPORT_MSG_STRUCT                      dl_nas_transport[2];
+static LIBLTE_MME_EMM_STATUS_MSG_STRUCT                                  emm_status[2];
+static LIBLTE_MME_EXTENDED_SERVICE_REQUEST_MSG_STRUCT                    ext_service_req[2];
+static LIBLTE_MME_GUTI_REALLOCATION_COMMAND_MSG_STRUCT                   guti_realloc_cmd[2];
+static LIBLTE_MME_GUTI_REALLOCATION_COMPLETE_MSG_STRUCT                  guti_realloc_complete[2];
+static LIBLTE_MME_ID_REQUEST_MSG_STRUCT                                  id_req[2];
+static LIBLTE_MME_ID_RESPONSE_MSG_STRUCT                                 id_resp[2];
+static LIBLTE_MME_SECURITY_MODE_COMMAND_MSG_STRUCT                       sec_mode_cmd[2];
+static LIBLTE_MME_SECURITY_MODE_COMPLETE_MSG_STRUCT                      sec_mode_comp[2];
+static LIBLTE_MME_SECURITY_MODE_REJECT_MSG_STRUCT                        sec_mode_rej[2];
+static LIBLTE_MME_SERVICE_REJECT_MSG_STRUCT                              service_rej[2];
+static LIBLTE_MME_SERVICE_REQUEST_MSG_STRUCT                             service_req[2];
+static LIBLTE_MME_TRACKING_AREA_UPDATE_ACCEPT_MSG_STRUCT                 ta_update_accept[2];
+static LIBLTE_MME_TRACKING_AREA_UPDATE_COMPLETE_MSG_STRUCT               ta_update_complete[2];
+static LIBLTE_MME_TRACKING_AREA_UPDATE_REJECT_MSG_STRUCT                 ta_update_rej[2];
+static LIBLTE_MME_UPLINK_NAS_TRANSPORT_MSG_STRUCT                        ul_nas_transport[2];
+static LIBLTE_MME_DOWNLINK_GENERIC_NAS_TRANSPORT_MSG_STRUCT              dl_generic_nas_transport[2];
+static LIBLTE_MME_UPLINK_GENERIC_NAS_TRANSPORT_MSG_STRUCT                ul_generic_nas_transport[2];
+static LIBLTE_MME_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_ACCEPT_MSG_STRUCT act_ded_eps_bearer_context_accept[2];
+static LIBLTE_MME_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REJECT_MSG_STRUCT act_ded_eps_bearer_context_rej[2];
+static LIBLTE_MME_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_MSG_STRUCT act_ded_eps_bearer_context_req[2];
+static LIBLTE_MME_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_ACCEPT_MSG_STRUCT  act_def_eps_bearer_context_accept[2];
+static LIBLTE_MME_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REJECT_MSG_STRUCT  act_def_eps_bearer_context_rej[2];
+static LIBLTE_MME_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_MSG_STRUCT act_def_eps_bearer_context_req[2];
+static LIBLTE_MME_BEARER_RESOURCE_ALLOCATION_REJECT_MSG_STRUCT           bearer_res_alloc_rej[2];
+static LIBLTE_MME_BEARER_RESOURCE_MODIFICATION_REJECT_MSG_STRUCT         bearer_res_mod_rej[2];
+static LIBLTE_MME_DEACTIVATE_EPS_BEARER_CONTEXT_ACCEPT_MSG_STRUCT        deact_eps_bearer_context_accept[2];
+static LIBLTE_MME_DEACTIVATE_EPS_BEARER_CONTEXT_REQUEST_MSG_STRUCT       deact_eps_bearer_context_req[2];
+static LIBLTE_MME_ESM_INFORMATION_REQUEST_MSG_STRUCT                     esm_info_req[2];
+static LIBLTE_MME_ESM_INFORMATION_RESPONSE_MSG_STRUCT                    esm_info_resp[2];
+static LIBLTE_MME_ESM_STATUS_MSG_STRUCT                                  esm_status[2];
+static LIBLTE_MME_MODIFY_EPS_BEARER_CONTEXT_ACCEPT_MSG_STRUCT            mod_eps_bearer_context_accept[2];
+static LIBLTE_MME_MODIFY_EPS_BEARER_CONTEXT_REJECT_MSG_STRUCT            mod_eps_bearer_context_rej[2];
+static LIBLTE_MME_NOTIFICATION_MSG_STRUCT                                notification[2];
+static LIBLTE_MME_PDN_CONNECTIVITY_REJECT_MSG_STRUCT                     pdn_con_rej[2];
+static LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT                    pdn_con_req[2];
+static LIBLTE_MME_PDN_DISCONNECT_REJECT_MSG_STRUCT                       pdn_discon_rej[2];
+static LIBLTE_MME_PDN_DISCONNECT_REQUEST_MSG_STRUCT                      pdn_discon_req[2];
+static LIBLTE_MAC_PDU_STRUCT                                             mac_dlsch_pdu[2];
+static LIBLTE_MAC_PDU_STRUCT                                             mac_ulsch_pdu[2];
+static LIBLTE_MAC_RAR_STRUCT                                             mac_rar[2];
+static LIBLTE_RLC_UMD_PDU_STRUCT                                         rlc_umd[2];
+static LIBLTE_RLC_AMD_PDU_STRUCT                                         rlc_amd[2];
+static LIBLTE_RLC_STATUS_PDU_STRUCT                                      rlc_status[2];
+static LIBLTE_PDCP_CONTROL_PDU_STRUCT                                    pdcp_control[2];
+static LIBLTE_PDCP_DATA_PDU_WITH_LONG_SN_STRUCT                          pdcp_data[2];
+static LIBLTE_PDCP_ROHC_FEEDBACK_PDU_STRUCT                              pdcp_rohc_feedback[2];
+
+// Index 0 holds the packed corpus message, index 1 the repacked copy
+static CODEC_BENCH_MSG_STRUCT codec_bench_msg[2];
+static uint8                  codec_bench_key[32];
+static uint32                 codec_bench_seed = 1;
+
+static uint64 codec_bench_alloc_bytes = 0;
+static uint64 codec_bench_alloc_count = 0;
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: operator new/operator delete
+
+    Description: Counts the heap bytes the codecs allocate.  liblte
+                 only allocates through C++ containers, so counting
+                 operator new covers all of it.
+*********************************************************************/
+void *operator new(size_t size)
+{
+    void *ptr;
+
+    codec_bench_alloc_bytes += size;
+    codec_bench_alloc_count++;
+    ptr = malloc(size);
+    if(NULL == ptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return(ptr);
+}
+void operator delete(void *ptr) throw()
+{
+    free(ptr);
+}
+void operator delete(void *ptr, size_t size) throw()
+{
+    free(ptr);
+}
+
+/*********************************************************************
+    Name: codec_bench_random_bytes
+
+    Description: Fills a byte message with pseudo random bytes
+*********************************************************************/
+void codec_bench_random_bytes(LIBLTE_BYTE_MSG_STRUCT *msg,
+                              uint32                  N_bytes)
+{
+    uint32 i;
+
+    for(i=0; i<N_bytes; i++)
+    {
+        msg->msg[i] = liblte_bench_rand(&codec_bench_seed) & 0xFF;
+    }
+    msg->N_bytes = N_bytes;
+}
+
+/*********************************************************************
+    Name: codec_bench_fill_imsi
+
+    Description: Fills an array of IMSI digits
+*********************************************************************/
+void codec_bench_fill_imsi(uint8 *imsi)
+{
+    uint64 value = CODEC_BENCH_IMSI;
+    uint32 i;
+
+    for(i=0; i<15; i++)
+    {
+        imsi[14-i]  = value % 10;
+        value      /= 10;
+    }
+}
+
+/*********************************************************************
+    Name: codec_bench_fill_rrc
+
+    Description: Fills the RRC messages the way the eNodeB and a UE
+                 send them for a 10MHz band 13 cell
+*********************************************************************/
+void codec_bench_fill_rrc(void)
+{
+    LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1_STRUCT      *sib1           = (LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1_STRUCT *)&rrc_sib1[0].sibs[0].sib;
+    LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2_STRUCT      *sib2           = (LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2_STRUCT *)&rrc_sib2[0].sibs[0].sib;
+    LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_3_STRUCT      *sib3           = (LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_3_STRUCT *)&rrc_sys_info[0].sibs[1].sib;
+    LIBLTE_RRC_CONNECTION_SETUP_STRUCT           *con_setup      = &rrc_con_setup[0].msg.rrc_con_setup;
+    LIBLTE_RRC_PHYSICAL_CONFIG_DEDICATED_STRUCT  *phy_cnfg_ded   = &con_setup->rr_cnfg.phy_cnfg_ded;
+    LIBLTE_RRC_CONNECTION_RECONFIGURATION_STRUCT *con_reconfig   = &rrc_con_reconfig[0].msg.rrc_con_reconfig;
+    LIBLTE_RRC_CONNECTION_SETUP_COMPLETE_STRUCT  *con_setup_comp = &rrc_con_setup_complete[0].msg.rrc_con_setup_complete;
+    LIBLTE_RRC_PAGING_STRUCT                     *paging         = &rrc_paging[0];
+    LIBLTE_RRC_DRB_TO_ADD_MOD_STRUCT             *drb;
+    uint32                                        i;
+
+    // MIB
+    rrc_mib[0].dl_bw            = LIBLTE_RRC_DL_BANDWIDTH_50;
+    rrc_mib[0].phich_config.dur = LIBLTE_RRC_PHICH_DURATION_NORMAL;
+    rrc_mib[0].phich_config.res = LIBLTE_RRC_PHICH_RESOURCE_1;
+    rrc_mib[0].sfn_div_4        = 173;
+
+    // SIB1
+    rrc_sib1[0].N_sibs                               = 0;
+    rrc_sib1[0].sibs[0].sib_type                     = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1;
+    sib1->N_plmn_ids                                 = 1;
+    sib1->plmn_id[0].id.mcc                          = CODEC_BENCH_MCC;
+    sib1->plmn_id[0].id.mnc                          = CODEC_BENCH_MNC;
+    sib1->plmn_id[0].resv_for_oper                   = LIBLTE_RRC_NOT_RESV_FOR_OPER;
+    sib1->tracking_area_code                         = CODEC_BENCH_TAC;
+    sib1->cell_id                                    = 1;
+    sib1->cell_barred                                = LIBLTE_RRC_CELL_NOT_BARRED;
+    sib1->intra_freq_reselection                     = LIBLTE_RRC_INTRA_FREQ_RESELECTION_ALLOWED;
+    sib1->q_rx_lev_min                               = -140;
+    sib1->q_rx_lev_min_offset                        = 1;
+    sib1->p_max_present                              = true;
+    sib1->p_max                                      = 23;
+    sib1->freq_band_indicator                        = 13;
+    sib1->N_sched_info                               = 2;
+    sib1->sched_info[0].si_periodicity               = LIBLTE_RRC_SI_PERIODICITY_RF8;
+    sib1->sched_info[0].N_sib_mapping_info           = 0;
+    sib1->sched_info[1].si_periodicity               = LIBLTE_RRC_SI_PERIODICITY_RF16;
+    sib1->sched_info[1].N_sib_mapping_info           = 2;
+    sib1->sched_info[1].sib_mapping_info[0].sib_type = LIBLTE_RRC_SIB_TYPE_3;
+    sib1->sched_info[1].sib_mapping_info[1].sib_type = LIBLTE_RRC_SIB_TYPE_4;
+    sib1->tdd                                        = false;
+    sib1->si_window_length                           = LIBLTE_RRC_SI_WINDOW_LENGTH_MS2;
+    sib1->system_info_value_tag                      = 7;
+
+    // SIB2
+    rrc_sib2[0].N_sibs                                                                 = 1;
+    rrc_sib2[0].sibs[0].sib_type                                                       = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2;
+    sib2->rr_config_common_sib.rach_cnfg.num_ra_preambles                              = LIBLTE_RRC_NUMBER_OF_RA_PREAMBLES_N4;
+    sib2->rr_config_common_sib.rach_cnfg.pwr_ramping_step                              = LIBLTE_RRC_POWER_RAMPING_STEP_DB6;
+    sib2->rr_config_common_sib.rach_cnfg.preamble_init_rx_target_pwr                   = LIBLTE_RRC_PREAMBLE_INITIAL_RECEIVED_TARGET_POWER_DBM_N90;
+    sib2->rr_config_common_sib.rach_cnfg.preamble_trans_max                            = LIBLTE_RRC_PREAMBLE_TRANS_MAX_N200;
+    sib2->rr_config_common_sib.rach_cnfg.ra_resp_win_size                              = LIBLTE_RRC_RA_RESPONSE_WINDOW_SIZE_SF7;
+    sib2->rr_config_common_sib.rach_cnfg.mac_con_res_timer                             = LIBLTE_RRC_MAC_CONTENTION_RESOLUTION_TIMER_SF64;
+    sib2->rr_config_common_sib.rach_cnfg.max_harq_msg3_tx                              = 1;
+    sib2->rr_config_common_sib.bcch_cnfg.modification_period_coeff                     = LIBLTE_RRC_MODIFICATION_PERIOD_COEFF_N2;
+    sib2->rr_config_common_sib.pcch_cnfg.default_paging_cycle                          = LIBLTE_RRC_DEFAULT_PAGING_CYCLE_RF256;
+    sib2->rr_config_common_sib.pcch_cnfg.nB                                            = LIBLTE_RRC_NB_ONE_T;
+    sib2->rr_config_common_sib.prach_cnfg.prach_cnfg_info.zero_correlation_zone_config = 1;
+    sib2->rr_config_common_sib.pusch_cnfg.n_sb                                         = 1;
+    sib2->rr_config_common_sib.pusch_cnfg.hopping_mode                                 = LIBLTE_RRC_HOPPING_MODE_INTER_SUBFRAME;
+    sib2->rr_config_common_sib.pusch_cnfg.enable_64_qam                                = true;
+    sib2->rr_config_common_sib.pucch_cnfg.delta_pucch_shift                            = LIBLTE_RRC_DELTA_PUCCH_SHIFT_DS1;
+    sib2->rr_config_common_sib.pucch_cnfg.n_rb_cqi                                     = 1;
+    sib2->rr_config_common_sib.pucch_cnfg.n1_pucch_an                                  = 4;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.p0_nominal_pusch                            = -70;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.alpha                                       = LIBLTE_RRC_UL_POWER_CONTROL_ALPHA_1;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.p0_nominal_pucch                            = -96;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_1                  = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_1_0;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_1b                 = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_1B_1;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_2                  = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_2_0;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_2a                 = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_2A_0;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_2b                 = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_2B_0;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.delta_preamble_msg3                         = -2;
+    sib2->rr_config_common_sib.ul_cp_length                                            = LIBLTE_RRC_UL_CP_LENGTH_1;
+    sib2->ue_timers_and_constants.t300                                                 = LIBLTE_RRC_T300_MS1000;
+    sib2->ue_timers_and_constants.t301                                                 = LIBLTE_RRC_T301_MS1000;
+    sib2->ue_timers_and_constants.t310                                                 = LIBLTE_RRC_T310_MS1000;
+    sib2->ue_timers_and_constants.n310                                                 = LIBLTE_RRC_N310_N20;
+    sib2->ue_timers_and_constants.t311                                                 = LIBLTE_RRC_T311_MS30000;
+    sib2->ue_timers_and_constants.n311                                                 = LIBLTE_RRC_N311_N1;
+    sib2->additional_spectrum_emission                                                 = 1;
+    sib2->time_alignment_timer                                                         = LIBLTE_RRC_TIME_ALIGNMENT_TIMER_SF500;
+
+    // System Information carrying SIB2 and SIB3
+    rrc_sys_info[0].N_sibs                 = 2;
+    rrc_sys_info[0].sibs[0]                = rrc_sib2[0].sibs[0];
+    rrc_sys_info[0].sibs[1].sib_type       = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_3;
+    sib3->q_hyst                           = LIBLTE_RRC_Q_HYST_DB_4;
+    sib3->speed_state_resel_params.present = false;
+    sib3->s_non_intra_search_present       = false;
+    sib3->thresh_serving_low               = 0;
+    sib3->cell_resel_prio                  = 0;
+    sib3->q_rx_lev_min                     = sib1->q_rx_lev_min;
+    sib3->p_max_present                    = true;
+    sib3->p_max                            = sib1->p_max;
+    sib3->s_intra_search_present           = false;
+    sib3->allowed_meas_bw_present          = false;
+    sib3->presence_ant_port_1              = false;
+    sib3->neigh_cell_cnfg                  = 0;
+    sib3->t_resel_eutra                    = 0;
+    sib3->t_resel_eutra_sf_present         = false;
+
+    // Paging for two UEs, one by S-TMSI and one by IMSI
+    paging->paging_record_list_size                                = 2;
+    paging->paging_record_list[0].ue_identity.ue_identity_type     = LIBLTE_RRC_PAGING_UE_IDENTITY_TYPE_S_TMSI;
+    paging->paging_record_list[0].ue_identity.s_tmsi.mmec          = 1;
+    paging->paging_record_list[0].ue_identity.s_tmsi.m_tmsi        = CODEC_BENCH_M_TMSI;
+    paging->paging_record_list[0].cn_domain                        = LIBLTE_RRC_CN_DOMAIN_PS;
+    paging->paging_record_list[1].ue_identity.ue_identity_type     = LIBLTE_RRC_PAGING_UE_IDENTITY_TYPE_IMSI;
+    paging->paging_record_list[1].ue_identity.imsi_size            = 15;
+    codec_bench_fill_imsi(paging->paging_record_list[1].ue_identity.imsi);
+    paging->paging_record_list[1].cn_domain                        = LIBLTE_RRC_CN_DOMAIN_PS;
+    paging->system_info_modification_present                       = false;
+    paging->etws_indication_present                                = false;
+    paging->non_crit_ext_present                                   = false;
+
+    // RRC Connection Setup
+    rrc_con_setup[0].msg_type                                                             = LIBLTE_RRC_DL_CCCH_MSG_TYPE_RRC_CON_SETUP;
+    con_setup->rrc_transaction_id                                                         = 1;
+    con_setup->rr_cnfg.srb_to_add_mod_list_size                                           = 1;
+    con_setup->rr_cnfg.srb_to_add_mod_list[0].srb_id                                      = 1;
+    con_setup->rr_cnfg.srb_to_add_mod_list[0].rlc_cnfg_present                            = true;
+    con_setup->rr_cnfg.srb_to_add_mod_list[0].rlc_default_cnfg_present                    = true;
+    con_setup->rr_cnfg.srb_to_add_mod_list[0].lc_cnfg_present                             = true;
+    con_setup->rr_cnfg.srb_to_add_mod_list[0].lc_default_cnfg_present                     = true;
+    con_setup->rr_cnfg.mac_main_cnfg_present                                              = true;
+    con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg_present                    = true;
+    con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg.max_harq_tx_present        = true;
+    con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg.max_harq_tx                = LIBLTE_RRC_MAX_HARQ_TX_N4;
+    con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg.retx_bsr_timer             = LIBLTE_RRC_RETRANSMISSION_BSR_TIMER_SF1280;
+    con_setup->rr_cnfg.mac_main_cnfg.explicit_value.time_alignment_timer                  = LIBLTE_RRC_TIME_ALIGNMENT_TIMER_SF500;
+    con_setup->rr_cnfg.phy_cnfg_ded_present                                               = true;
+    phy_cnfg_ded->cqi_report_cnfg_present                                                 = true;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic_present                                 = true;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic_setup_present                           = true;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic.pucch_resource_idx                      = 2;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic.pmi_cnfg_idx                            = 22;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic.format_ind_periodic                     = LIBLTE_RRC_CQI_FORMAT_INDICATOR_PERIODIC_WIDEBAND_CQI;
+    phy_cnfg_ded->sched_request_cnfg_present                                              = true;
+    phy_cnfg_ded->sched_request_cnfg.setup_present                                        = true;
+    phy_cnfg_ded->sched_request_cnfg.sr_pucch_resource_idx                                = 1;
+    phy_cnfg_ded->sched_request_cnfg.sr_cnfg_idx                                          = 7;
+    phy_cnfg_ded->sched_request_cnfg.dsr_trans_max                                        = LIBLTE_RRC_DSR_TRANS_MAX_N64;
+
+    // RRC Connection Reject
+    rrc_con_rej[0].msg_type                  = LIBLTE_RRC_DL_CCCH_MSG_TYPE_RRC_CON_REJ;
+    rrc_con_rej[0].msg.rrc_con_rej.wait_time = 10;
+
+    // RRC Connection Reestablishment, reusing the setup configuration
+    rrc_con_reest[0].msg_type                                  = LIBLTE_RRC_DL_CCCH_MSG_TYPE_RRC_CON_REEST;
+    rrc_con_reest[0].msg.rrc_con_reest.rrc_transaction_id      = 1;
+    rrc_con_reest[0].msg.rrc_con_reest.next_hop_chaining_count = 2;
+    rrc_con_reest[0].msg.rrc_con_reest.rr_cnfg                 = con_setup->rr_cnfg;
+
+    // RRC Connection Reestablishment Reject
+    rrc_con_reest_rej[0].msg_type = LIBLTE_RRC_DL_CCCH_MSG_TYPE_RRC_CON_REEST_REJ;
+
+    // RRC Connection Request
+    rrc_con_req[0].msg_type                            = LIBLTE_RRC_UL_CCCH_MSG_TYPE_RRC_CON_REQ;
+    rrc_con_req[0].msg.rrc_con_req.ue_id_type          = LIBLTE_RRC_CON_REQ_UE_ID_TYPE_S_TMSI;
+    rrc_con_req[0].msg.rrc_con_req.ue_id.s_tmsi.mmec   = 1;
+    rrc_con_req[0].msg.rrc_con_req.ue_id.s_tmsi.m_tmsi = CODEC_BENCH_M_TMSI;
+    rrc_con_req[0].msg.rrc_con_req.cause               = LIBLTE_RRC_CON_REQ_EST_CAUSE_MO_SIGNALLING;
+
+    // RRC Connection Reestablishment Request
+    rrc_con_reest_req[0].msg_type                                 = LIBLTE_RRC_UL_CCCH_MSG_TYPE_RRC_CON_REEST_REQ;
+    rrc_con_reest_req[0].msg.rrc_con_reest_req.ue_id.c_rnti       = 0x46;
+    rrc_con_reest_req[0].msg.rrc_con_reest_req.ue_id.phys_cell_id = 1;
+    rrc_con_reest_req[0].msg.rrc_con_reest_req.ue_id.short_mac_i  = 0xBEEF;
+    rrc_con_reest_req[0].msg.rrc_con_reest_req.cause              = LIBLTE_RRC_CON_REEST_REQ_CAUSE_OTHER_FAILURE;
+
+    // Security Mode Command
+    rrc_sec_mode_cmd[0].msg_type                                  = LIBLTE_RRC_DL_DCCH_MSG_TYPE_SECURITY_MODE_COMMAND;
+    rrc_sec_mode_cmd[0].msg.security_mode_cmd.rrc_transaction_id  = 2;
+    rrc_sec_mode_cmd[0].msg.security_mode_cmd.sec_algs.cipher_alg = LIBLTE_RRC_CIPHERING_ALGORITHM_EEA0;
+    rrc_sec_mode_cmd[0].msg.security_mode_cmd.sec_algs.int_alg    = LIBLTE_RRC_INTEGRITY_PROT_ALGORITHM_EIA2;
+
+    // RRC Connection Reconfiguration adding two data bearers
+    rrc_con_reconfig[0].msg_type                                              = LIBLTE_RRC_DL_DCCH_MSG_TYPE_RRC_CON_RECONFIG;
+    con_reconfig->rrc_transaction_id                                          = 3;
+    con_reconfig->N_ded_info_nas                                              = 1;
+    codec_bench_random_bytes(&con_reconfig->ded_info_nas_list[0], CODEC_BENCH_N_NAS_BYTES);
+    con_reconfig->rr_cnfg_ded_present                                         = true;
+    con_reconfig->rr_cnfg_ded.srb_to_add_mod_list_size                        = 1;
+    con_reconfig->rr_cnfg_ded.srb_to_add_mod_list[0].srb_id                   = 2;
+    con_reconfig->rr_cnfg_ded.srb_to_add_mod_list[0].rlc_cnfg_present         = true;
+    con_reconfig->rr_cnfg_ded.srb_to_add_mod_list[0].rlc_default_cnfg_present = true;
+    con_reconfig->rr_cnfg_ded.srb_to_add_mod_list[0].lc_cnfg_present          = true;
+    con_reconfig->rr_cnfg_ded.srb_to_add_mod_list[0].lc_default_cnfg_present  = true;
+    con_reconfig->rr_cnfg_ded.drb_to_add_mod_list_size                        = 2;
+    for(i=0; i<con_reconfig->rr_cnfg_ded.drb_to_add_mod_list_size; i++)
+    {
+        drb                                                    = &con_reconfig->rr_cnfg_ded.drb_to_add_mod_list[i];
+        drb->eps_bearer_id_present                             = true;
+        drb->eps_bearer_id                                     = CODEC_BENCH_EBI + i;
+        drb->drb_id                                            = 1 + i;
+        drb->pdcp_cnfg_present                                 = true;
+        drb->pdcp_cnfg.discard_timer_present                   = true;
+        drb->pdcp_cnfg.discard_timer                           = LIBLTE_RRC_DISCARD_TIMER_INFINITY;
+        drb->pdcp_cnfg.rlc_um_pdcp_sn_size_present             = true;
+        drb->pdcp_cnfg.rlc_um_pdcp_sn_size                     = LIBLTE_RRC_PDCP_SN_SIZE_12_BITS;
+        drb->pdcp_cnfg.hdr_compression_rohc                    = (1 == i);
+        drb->pdcp_cnfg.hdr_compression_max_cid                 = 15;
+        drb->pdcp_cnfg.hdr_compression_profile_0001            = true;
+        drb->pdcp_cnfg.hdr_compression_profile_0002            = true;
+        drb->pdcp_cnfg.hdr_compression_profile_0003            = true;
+        drb->rlc_cnfg_present                                  = true;
+        drb->rlc_cnfg.rlc_mode                                 = LIBLTE_RRC_RLC_MODE_UM_BI;
+        drb->rlc_cnfg.ul_um_bi_rlc.sn_field_len                = LIBLTE_RRC_SN_FIELD_LENGTH_SIZE10;
+        drb->rlc_cnfg.dl_um_bi_rlc.sn_field_len                = LIBLTE_RRC_SN_FIELD_LENGTH_SIZE10;
+        drb->rlc_cnfg.dl_um_bi_rlc.t_reordering                = LIBLTE_RRC_T_REORDERING_MS50;
+        drb->lc_id_present                                     = true;
+        drb->lc_id                                             = 3 + i;
+        drb->lc_cnfg_present                                   = true;
+        drb->lc_cnfg.ul_specific_params_present                = true;
+        drb->lc_cnfg.ul_specific_params.priority               = 13;
+        drb->lc_cnfg.ul_specific_params.prioritized_bit_rate   = LIBLTE_RRC_PRIORITIZED_BIT_RATE_INFINITY;
+        drb->lc_cnfg.ul_specific_params.bucket_size_duration   = LIBLTE_RRC_BUCKET_SIZE_DURATION_MS100;
+        drb->lc_cnfg.ul_specific_params.log_chan_group_present = true;
+        drb->lc_cnfg.ul_specific_params.log_chan_group         = 3;
+    }
+
+    // DL Information Transfer
+    rrc_dl_info_transfer[0].msg_type                                 = LIBLTE_RRC_DL_DCCH_MSG_TYPE_DL_INFO_TRANSFER;
+    rrc_dl_info_transfer[0].msg.dl_info_transfer.rrc_transaction_id  = 0;
+    rrc_dl_info_transfer[0].msg.dl_info_transfer.dedicated_info_type = LIBLTE_RRC_DL_INFORMATION_TRANSFER_TYPE_NAS;
+    codec_bench_random_bytes(&rrc_dl_info_transfer[0].msg.dl_info_transfer.dedicated_info, CODEC_BENCH_N_NAS_BYTES);
+
+    // RRC Connection Release
+    rrc_con_release[0].msg_type                               = LIBLTE_RRC_DL_DCCH_MSG_TYPE_RRC_CON_RELEASE;
+    rrc_con_release[0].msg.rrc_con_release.rrc_transaction_id = 1;
+    rrc_con_release[0].msg.rrc_con_release.release_cause      = LIBLTE_RRC_RELEASE_CAUSE_OTHER;
+
+    // UE Information Request
+    rrc_ue_info_req[0].msg_type                           = LIBLTE_RRC_DL_DCCH_MSG_TYPE_UE_INFO_REQ;
+    rrc_ue_info_req[0].msg.ue_info_req.rrc_transaction_id = 1;
+    rrc_ue_info_req[0].msg.ue_info_req.rach_report_req    = true;
+    rrc_ue_info_req[0].msg.ue_info_req.rlf_report_req     = true;
+
+    // RRC Connection Setup Complete
+    rrc_con_setup_complete[0].msg_type     = LIBLTE_RRC_UL_DCCH_MSG_TYPE_RRC_CON_SETUP_COMPLETE;
+    con_setup_comp->rrc_transaction_id     = 1;
+    con_setup_comp->selected_plmn_id       = 1;
+    con_setup_comp->registered_mme_present = true;
+    con_setup_comp->registered_mme.mmegi   = 1;
+    con_setup_comp->registered_mme.mmec    = 1;
+    codec_bench_random_bytes(&con_setup_comp->dedicated_info_nas, CODEC_BENCH_N_NAS_BYTES);
+
+    // Security Mode Complete
+    rrc_sec_mode_complete[0].msg_type                                      = LIBLTE_RRC_UL_DCCH_MSG_TYPE_SECURITY_MODE_COMPLETE;
+    rrc_sec_mode_complete[0].msg.security_mode_complete.rrc_transaction_id = 2;
+
+    // Security Mode Failure
+    rrc_sec_mode_failure[0].msg_type                                     = LIBLTE_RRC_UL_DCCH_MSG_TYPE_SECURITY_MODE_FAILURE;
+    rrc_sec_mode_failure[0].msg.security_mode_failure.rrc_transaction_id = 2;
+
+    // RRC Connection Reconfiguration Complete
+    rrc_con_reconfig_complete[0].msg_type                                         = LIBLTE_RRC_UL_DCCH_MSG_TYPE_RRC_CON_RECONFIG_COMPLETE;
+    rrc_con_reconfig_complete[0].msg.rrc_con_reconfig_complete.rrc_transaction_id = 3;
+
+    // UL Information Transfer
+    rrc_ul_info_transfer[0].msg_type                                 = LIBLTE_RRC_UL_DCCH_MSG_TYPE_UL_INFO_TRANSFER;
+    rrc_ul_info_transfer[0].msg.ul_info_transfer.dedicated_info_type = LIBLTE_RRC_UL_INFORMATION_TRANSFER_TYPE_NAS;
+    codec_bench_random_bytes(&rrc_ul_info_transfer[0].msg.ul_info_transfer.dedicated_info, CODEC_BENCH_N_NAS_BYTES);
+}
+
+/*********************************************************************
+    Name: codec_bench_fill_pco
+
+    Description: Fills protocol configuration options with an IPCP
+                 DNS exchange and a DNS server address option
+*********************************************************************/
+void codec_bench_fill_pco(LIBLTE_MME_PROTOCOL_CONFIG_OPTIONS_STRUCT *pco,
+                          uint16                                     dns_id)
+{
+    pco->N_opts              = 2;
+    pco->opt[0].id           = LIBLTE_MME_CONFIGURATION_PROTOCOL_OPTIONS_IPCP;
+    pco->opt[0].len          = 16;
+    memset(pco->opt[0].contents, 0, 16);
+    pco->opt[0].contents[0]  = 0x01;
+    pco->opt[0].contents[3]  = 0x10;
+    pco->opt[0].contents[4]  = 0x81;
+    pco->opt[0].contents[5]  = 0x06;
+    pco->opt[0].contents[10] = 0x83;
+    pco->opt[0].contents[11] = 0x06;
+    pco->opt[1].id           = dns_id;
+    pco->opt[1].len          = 0;
+}
+
+/*********************************************************************
+    Name: codec_bench_fill_mme
+
+    Description: Fills every NAS message with the IEs an attach,
+                 service request, and bearer setup carry
+*********************************************************************/
+void codec_bench_fill_mme(void)
+{
+    LIBLTE_MME_EPS_MOBILE_ID_STRUCT  guti;
+    uint32                           i;
+
+    for(i=0; i<32; i++)
+    {
+        codec_bench_key[i] = liblte_bench_rand(&codec_bench_seed) & 0xFF;
+    }
+    memset(&guti, 0, sizeof(guti));
+    guti.type_of_id        = LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI;
+    guti.guti.mcc          = CODEC_BENCH_NAS_MCC;
+    guti.guti.mnc          = CODEC_BENCH_NAS_MNC;
+    guti.guti.mme_group_id = 1;
+    guti.guti.mme_code     = 1;
+    guti.guti.m_tmsi       = CODEC_BENCH_M_TMSI;
+
+    // ESM messages
+    act_ded_eps_bearer_context_accept[0].eps_bearer_id              = CODEC_BENCH_EBI + 1;
+    act_ded_eps_bearer_context_accept[0].proc_transaction_id        = 0;
+    act_ded_eps_bearer_context_rej[0].eps_bearer_id                 = CODEC_BENCH_EBI + 1;
+    act_ded_eps_bearer_context_rej[0].esm_cause                     = LIBLTE_MME_ESM_CAUSE_INSUFFICIENT_RESOURCES;
+    act_ded_eps_bearer_context_req[0].eps_bearer_id                 = CODEC_BENCH_EBI + 1;
+    act_ded_eps_bearer_context_req[0].linked_eps_bearer_id          = CODEC_BENCH_EBI;
+    act_ded_eps_bearer_context_req[0].eps_qos.qci                   = 1;
+    act_ded_eps_bearer_context_req[0].eps_qos.br_present            = true;
+    act_ded_eps_bearer_context_req[0].eps_qos.mbr_ul                = 0x40;
+    act_ded_eps_bearer_context_req[0].eps_qos.mbr_dl                = 0x40;
+    act_ded_eps_bearer_context_req[0].eps_qos.gbr_ul                = 0x40;
+    act_ded_eps_bearer_context_req[0].eps_qos.gbr_dl                = 0x40;
+    act_ded_eps_bearer_context_req[0].tft.tft_op_code               = LIBLTE_MME_TFT_OPERATION_CODE_CREATE_NEW_TFT;
+    act_ded_eps_bearer_context_req[0].tft.packet_filter_list_size   = 1;
+    act_ded_eps_bearer_context_req[0].tft.parameter_list_size       = 0;
+    act_ded_eps_bearer_context_req[0].tft.packet_filter_list[0].dir = LIBLTE_MME_TFT_PACKET_FILTER_DIRECTION_BIDIRECTIONAL;
+    act_ded_eps_bearer_context_req[0].tft.packet_filter_list[0].id  = 1;
+    act_ded_eps_bearer_context_req[0].tft.packet_filter_list[0].eval_precedence = 1;
+    act_ded_eps_bearer_context_req[0].tft.packet_filter_list[0].filter_size     = 2;
+    act_ded_eps_bearer_context_req[0].tft.packet_filter_list[0].filter[0]       = 0x30; // Protocol identifier
+    act_ded_eps_bearer_context_req[0].tft.packet_filter_list[0].filter[1]       = 17;   // UDP
+    act_def_eps_bearer_context_accept[0].eps_bearer_id              = CODEC_BENCH_EBI;
+    act_def_eps_bearer_context_accept[0].proc_transaction_id        = CODEC_BENCH_PTI;
+    act_def_eps_bearer_context_rej[0].eps_bearer_id                 = CODEC_BENCH_EBI;
+    act_def_eps_bearer_context_rej[0].proc_transaction_id           = CODEC_BENCH_PTI;
+    act_def_eps_bearer_context_rej[0].esm_cause                     = LIBLTE_MME_ESM_CAUSE_INSUFFICIENT_RESOURCES;
+    act_def_eps_bearer_context_req[0].eps_bearer_id                 = CODEC_BENCH_EBI;
+    act_def_eps_bearer_context_req[0].proc_transaction_id           = CODEC_BENCH_PTI;
+    act_def_eps_bearer_context_req[0].eps_qos.qci                   = 9;
+    act_def_eps_bearer_context_req[0].apn.apn                       = "www.openLTE.com";
+    act_def_eps_bearer_context_req[0].pdn_addr.pdn_type             = LIBLTE_MME_PDN_TYPE_IPV4;
+    act_def_eps_bearer_context_req[0].pdn_addr.addr[0]              = 192;
+    act_def_eps_bearer_context_req[0].pdn_addr.addr[1]              = 168;
+    act_def_eps_bearer_context_req[0].pdn_addr.addr[2]              = 1;
+    act_def_eps_bearer_context_req[0].pdn_addr.addr[3]              = 2;
+    act_def_eps_bearer_context_req[0].esm_cause_present             = true;
+    act_def_eps_bearer_context_req[0].esm_cause                     = LIBLTE_MME_ESM_CAUSE_PDN_TYPE_IPV4_ONLY_ALLOWED;
+    act_def_eps_bearer_context_req[0].protocol_cnfg_opts_present    = true;
+    codec_bench_fill_pco(&act_def_eps_bearer_context_req[0].protocol_cnfg_opts,
+                         LIBLTE_MME_ADDITIONAL_PARAMETERS_DL_DNS_SERVER_IPV4_ADDRESS);
+    bearer_res_alloc_rej[0].proc_transaction_id                     = CODEC_BENCH_PTI;
+    bearer_res_alloc_rej[0].esm_cause                               = LIBLTE_MME_ESM_CAUSE_INSUFFICIENT_RESOURCES;
+    bearer_res_mod_rej[0].proc_transaction_id                       = CODEC_BENCH_PTI;
+    bearer_res_mod_rej[0].esm_cause                                 = LIBLTE_MME_ESM_CAUSE_SERVICE_OPTION_NOT_SUPPORTED;
+    deact_eps_bearer_context_accept[0].eps_bearer_id                = CODEC_BENCH_EBI + 1;
+    deact_eps_bearer_context_req[0].eps_bearer_id                   = CODEC_BENCH_EBI + 1;
+    deact_eps_bearer_context_req[0].esm_cause                       = LIBLTE_MME_ESM_CAUSE_REGULAR_DEACTIVATION;
+    esm_info_req[0].proc_transaction_id                             = CODEC_BENCH_PTI;
+    esm_info_resp[0].proc_transaction_id                            = CODEC_BENCH_PTI;
+    esm_info_resp[0].apn_present                                    = true;
+    esm_info_resp[0].apn.apn                                        = "internet.mnc001.mcc001.gprs";
+    esm_status[0].eps_bearer_id                                     = CODEC_BENCH_EBI;
+    esm_status[0].esm_cause                                         = LIBLTE_MME_ESM_CAUSE_PTI_MISMATCH;
+    mod_eps_bearer_context_accept[0].eps_bearer_id                  = CODEC_BENCH_EBI;
+    mod_eps_bearer_context_rej[0].eps_bearer_id                     = CODEC_BENCH_EBI;
+    mod_eps_bearer_context_rej[0].esm_cause                         = LIBLTE_MME_ESM_CAUSE_INSUFFICIENT_RESOURCES;
+    notification[0].notification_ind                                = LIBLTE_MME_NOTIFICATION_INDICATOR_SRVCC_HO_CANCELLED_IMS_SESSION_REEST_REQ;
+    pdn_con_rej[0].proc_transaction_id                              = CODEC_BENCH_PTI;
+    pdn_con_rej[0].esm_cause                                        = LIBLTE_MME_ESM_CAUSE_UNKNOWN_OR_MISSING_APN;
+    pdn_con_req[0].proc_transaction_id                              = CODEC_BENCH_PTI;
+    pdn_con_req[0].pdn_type                                         = LIBLTE_MME_PDN_TYPE_IPV4V6;
+    pdn_con_req[0].request_type                                     = LIBLTE_MME_REQUEST_TYPE_INITIAL_REQUEST;
+    pdn_con_req[0].protocol_cnfg_opts_present                       = true;
+    codec_bench_fill_pco(&pdn_con_req[0].protocol_cnfg_opts,
+                         LIBLTE_MME_ADDITIONAL_PARAMETERS_UL_DNS_SERVER_IPV4_ADDRESS_REQUEST);
+    pdn_discon_rej[0].proc_transaction_id                           = CODEC_BENCH_PTI;
+    pdn_discon_rej[0].esm_cause                                     = LIBLTE_MME_ESM_CAUSE_LAST_PDN_DISCONNECTION_NOT_ALLOWED;
+    pdn_discon_req[0].proc_transaction_id                           = CODEC_BENCH_PTI;
+    pdn_discon_req[0].linked_eps_bearer_id                          = CODEC_BENCH_EBI;
+
+    // Attach Request carrying a PDN Connectivity Request
+    liblte_mme_pack_pdn_connectivity_request_msg(&pdn_con_req[0], &attach_req[0].esm_msg);
+    attach_req[0].eps_attach_type          = LIBLTE_MME_EPS_ATTACH_TYPE_EPS_ATTACH;
+    attach_req[0].nas_ksi.tsc_flag         = LIBLTE_MME_TYPE_OF_SECURITY_CONTEXT_FLAG_NATIVE;
+    attach_req[0].nas_ksi.nas_ksi          = 7;
+    attach_req[0].eps_mobile_id.type_of_id = LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI;
+    codec_bench_fill_imsi(attach_req[0].eps_mobile_id.imsi);
+    attach_req[0].ue_network_cap.eea[0]    = true;
+    attach_req[0].ue_network_cap.eea[1]    = true;
+    attach_req[0].ue_network_cap.eea[2]    = true;
+    attach_req[0].ue_network_cap.eia[1]    = true;
+    attach_req[0].ue_network_cap.eia[2]    = true;
+    attach_req[0].drx_param_present        = true;
+    attach_req[0].drx_param.non_drx_timer  = LIBLTE_MME_NON_DRX_TIMER_NO_NON_DRX_MODE;
+    attach_req[0].ms_network_cap_present   = true;
+    attach_req[0].ms_network_cap.gea[1]    = true;
+    attach_req[0].ms_network_cap.gea[2]    = true;
+    attach_req[0].ms_network_cap.ucs2      = true;
+    attach_req[0].ms_network_cap.emm_comb  = true;
+    attach_req[0].ms_network_cap.isr       = true;
+    attach_req[0].ms_network_cap.epc       = true;
+
+    // Attach Accept carrying an Activate Default EPS Bearer Context Request
+    liblte_mme_pack_activate_default_eps_bearer_context_request_msg(&act_def_eps_bearer_context_req[0],
+                                                                    &attach_accept[0].esm_msg);
+    attach_accept[0].eps_attach_result   = LIBLTE_MME_EPS_ATTACH_RESULT_EPS_ONLY;
+    attach_accept[0].t3412.unit          = LIBLTE_MME_GPRS_TIMER_UNIT_6_MINUTES;
+    attach_accept[0].t3412.value         = 9;
+    attach_accept[0].tai_list.N_tais     = 1;
+    attach_accept[0].tai_list.tai[0].mcc = CODEC_BENCH_NAS_MCC;
+    attach_accept[0].tai_list.tai[0].mnc = CODEC_BENCH_NAS_MNC;
+    attach_accept[0].tai_list.tai[0].tac = CODEC_BENCH_TAC;
+    attach_accept[0].guti_present        = true;
+    attach_accept[0].guti                = guti;
+
+    // Attach Complete carrying an Activate Default EPS Bearer Context Accept
+    liblte_mme_pack_activate_default_eps_bearer_context_accept_msg(&act_def_eps_bearer_context_accept[0],
+                                                                   &attach_comp[0].esm_msg);
+
+    // Remaining EMM messages
+    attach_rej[0].emm_cause                      = LIBLTE_MME_EMM_CAUSE_EPS_SERVICES_NOT_ALLOWED;
+    auth_fail[0].emm_cause                       = LIBLTE_MME_EMM_CAUSE_SYNCH_FAILURE;
+    auth_fail[0].auth_fail_param_present         = true;
+    auth_req[0].nas_ksi.tsc_flag                 = LIBLTE_MME_TYPE_OF_SECURITY_CONTEXT_FLAG_NATIVE;
+    auth_req[0].nas_ksi.nas_ksi                  = 0;
+    for(i=0; i<16; i++)
+    {
+        auth_fail[0].auth_fail_param[i] = liblte_bench_rand(&codec_bench_seed) & 0xFF;
+        auth_req[0].rand[i]             = liblte_bench_rand(&codec_bench_seed) & 0xFF;
+        auth_req[0].autn[i]             = liblte_bench_rand(&codec_bench_seed) & 0xFF;
+        auth_resp[0].res[i]             = liblte_bench_rand(&codec_bench_seed) & 0xFF;
+    }
+    detach_req[0].detach_type.switch_off         = LIBLTE_MME_SO_FLAG_NORMAL_DETACH;
+    detach_req[0].detach_type.type_of_detach     = LIBLTE_MME_TOD_UL_EPS_DETACH;
+    detach_req[0].nas_ksi.tsc_flag               = LIBLTE_MME_TYPE_OF_SECURITY_CONTEXT_FLAG_NATIVE;
+    detach_req[0].nas_ksi.nas_ksi                = 0;
+    detach_req[0].eps_mobile_id                  = guti;
+    codec_bench_random_bytes(&dl_nas_transport[0].nas_msg, CODEC_BENCH_N_NAS_BYTES);
+    emm_status[0].emm_cause                      = LIBLTE_MME_EMM_CAUSE_IMPLICITLY_DETACHED;
+    ext_service_req[0].service_type              = LIBLTE_MME_SERVICE_TYPE_MO_CSFB;
+    ext_service_req[0].nas_ksi.tsc_flag          = LIBLTE_MME_TYPE_OF_SECURITY_CONTEXT_FLAG_NATIVE;
+    ext_service_req[0].nas_ksi.nas_ksi           = 0;
+    ext_service_req[0].m_tmsi.type_of_id         = LIBLTE_MME_MOBILE_ID_TYPE_TMSI;
+    guti_realloc_cmd[0].guti                     = guti;
+    guti_realloc_cmd[0].tai_list_present         = true;
+    guti_realloc_cmd[0].tai_list                 = attach_accept[0].tai_list;
+    id_req[0].id_type                            = LIBLTE_MME_ID_TYPE_2_IMSI;
+    id_resp[0].mobile_id.type_of_id              = LIBLTE_MME_MOBILE_ID_TYPE_IMSI;
+    codec_bench_fill_imsi(id_resp[0].mobile_id.imsi);
+    sec_mode_cmd[0].selected_nas_sec_algs.type_of_eea = LIBLTE_MME_TYPE_OF_CIPHERING_ALGORITHM_EEA0;
+    sec_mode_cmd[0].selected_nas_sec_algs.type_of_eia = LIBLTE_MME_TYPE_OF_INTEGRITY_ALGORITHM_128_EIA2;
+    sec_mode_cmd[0].nas_ksi.tsc_flag                  = LIBLTE_MME_TYPE_OF_SECURITY_CONTEXT_FLAG_NATIVE;
+    sec_mode_cmd[0].nas_ksi.nas_ksi                   = 0;
+    sec_mode_cmd[0].ue_security_cap.eea[0]            = true;
+    sec_mode_cmd[0].ue_security_cap.eea[1]            = true;
+    sec_mode_cmd[0].ue_security_cap.eea[2]            = true;
+    sec_mode_cmd[0].ue_security_cap.eia[1]            = true;
+    sec_mode_cmd[0].ue_security_cap.eia[2]            = true;
+    sec_mode_cmd[0].imeisv_req_present                = true;
+    sec_mode_cmd[0].imeisv_req                        = LIBLTE_MME_IMEISV_REQUESTED;
+    sec_mode_comp[0].imeisv_present                   = true;
+    sec_mode_comp[0].imeisv.type_of_id                = LIBLTE_MME_MOBILE_ID_TYPE_IMEISV;
+    for(i=0; i<16; i++)
+    {
+        sec_mode_comp[0].imeisv.imeisv[i] = i % 10;
+    }
+    sec_mode_rej[0].emm_cause                         = LIBLTE_MME_EMM_CAUSE_UE_SECURITY_CAPABILITIES_MISMATCH;
+    service_rej[0].emm_cause                          = LIBLTE_MME_EMM_CAUSE_CONGESTION;
+    service_rej[0].t3442_present                      = false;
+    service_rej[0].t3446_present                      = false;
+    service_req[0].ksi_and_seq_num.ksi                = 1;
+    service_req[0].ksi_and_seq_num.seq_num            = 17;
+    service_req[0].short_mac                          = 0xBEEF;
+    ta_update_accept[0].eps_update_result             = LIBLTE_MME_EPS_UPDATE_RESULT_TA_UPDATED;
+    ta_update_accept[0].t3412_present                 = true;
+    ta_update_accept[0].t3412                         = attach_accept[0].t3412;
+    ta_update_accept[0].guti_present                  = true;
+    ta_update_accept[0].guti                          = guti;
+    ta_update_accept[0].tai_list_present              = true;
+    ta_update_accept[0].tai_list                      = attach_accept[0].tai_list;
+    ta_update_accept[0].eps_bearer_context_status_present               = true;
+    ta_update_accept[0].eps_bearer_context_status.ebi[CODEC_BENCH_EBI] = true;
+    ta_update_rej[0].emm_cause                        = LIBLTE_MME_EMM_CAUSE_TRACKING_AREA_NOT_ALLOWED;
+    codec_bench_random_bytes(&ul_nas_transport[0].nas_msg, CODEC_BENCH_N_NAS_BYTES);
+    dl_generic_nas_transport[0].generic_msg_cont_type = LIBLTE_MME_GENERIC_MESSAGE_CONTAINER_TYPE_LPP;
+    dl_generic_nas_transport[0].add_info_present      = true;
+    dl_generic_nas_transport[0].add_info.N_octets     = 4;
+    codec_bench_random_bytes(&dl_generic_nas_transport[0].generic_msg_cont, CODEC_BENCH_N_NAS_BYTES);
+    ul_generic_nas_transport[0].generic_msg_cont_type = LIBLTE_MME_GENERIC_MESSAGE_CONTAINER_TYPE_LPP;
+    ul_generic_nas_transport[0].add_info_present      = false;
+    codec_bench_random_bytes(&ul_generic_nas_transport[0].generic_msg_cont, CODEC_BENCH_N_NAS_BYTES);
+}
+
+/*********************************************************************
+    Name: codec_bench_fill_lower_layers
+
+    Description: Fills the MAC, RLC, and PDCP PDUs the eNodeB builds
+                 and receives around an RRC connection setup
+*********************************************************************/
+void codec_bench_fill_lower_layers(void)
+{
+    uint32 i;
+
+    // DL-SCH PDU: contention resolution, timing advance, and CCCH SDU
+    mac_dlsch_pdu[0].chan_type                             = LIBLTE_MAC_CHAN_TYPE_DLSCH;
+    mac_dlsch_pdu[0].N_subheaders                          = 3;
+    mac_dlsch_pdu[0].subheader[0].lcid                     = LIBLTE_MAC_DLSCH_UE_CONTENTION_RESOLUTION_ID_LCID;
+    mac_dlsch_pdu[0].subheader[0].payload.ue_con_res_id.id = 0x123456789ABCULL;
+    mac_dlsch_pdu[0].subheader[1].lcid                     = LIBLTE_MAC_DLSCH_TA_COMMAND_LCID;
+    mac_dlsch_pdu[0].subheader[1].payload.ta_command.ta    = 31;
+    mac_dlsch_pdu[0].subheader[2].lcid                     = LIBLTE_MAC_DLSCH_CCCH_LCID;
+    codec_bench_random_bytes(&mac_dlsch_pdu[0].subheader[2].payload.sdu, CODEC_BENCH_N_NAS_BYTES);
+
+    // UL-SCH PDU: short BSR, power headroom, and a DCCH SDU
+    mac_ulsch_pdu[0].chan_type                                          = LIBLTE_MAC_CHAN_TYPE_ULSCH;
+    mac_ulsch_pdu[0].N_subheaders                                       = 3;
+    mac_ulsch_pdu[0].subheader[0].lcid                                  = LIBLTE_MAC_ULSCH_SHORT_BSR_LCID;
+    mac_ulsch_pdu[0].subheader[0].payload.short_bsr.lcg_id              = 0;
+    mac_ulsch_pdu[0].subheader[0].payload.short_bsr.max_buffer_size     = 1000;
+    mac_ulsch_pdu[0].subheader[1].lcid                                  = LIBLTE_MAC_ULSCH_POWER_HEADROOM_REPORT_LCID;
+    mac_ulsch_pdu[0].subheader[1].payload.power_headroom.ph             = 40;
+    mac_ulsch_pdu[0].subheader[2].lcid                                  = LIBLTE_MAC_ULSCH_DCCH_LCID_BEGIN;
+    codec_bench_random_bytes(&mac_ulsch_pdu[0].subheader[2].payload.sdu, CODEC_BENCH_N_SDU_BYTES);
+
+    // Random Access Response
+    mac_rar[0].hdr_type       = LIBLTE_MAC_RAR_HEADER_TYPE_RAPID;
+    mac_rar[0].RAPID          = 17;
+    mac_rar[0].timing_adv_cmd = 12;
+    mac_rar[0].hopping_flag   = LIBLTE_MAC_RAR_HOPPING_DISABLED;
+    mac_rar[0].rba            = 0x1F;
+    mac_rar[0].mcs            = 4;
+    mac_rar[0].tpc_command    = LIBLTE_MAC_RAR_TPC_COMMAND_0dB;
+    mac_rar[0].ul_delay       = LIBLTE_MAC_RAR_UL_DELAY_DISABLED;
+    mac_rar[0].csi_req        = LIBLTE_MAC_RAR_CSI_REQ_DISABLED;
+    mac_rar[0].temp_c_rnti    = 0x0046;
+
+    // UMD PDU with a 10 bit SN carrying the end of one SDU and a
+    // complete second SDU
+    rlc_umd[0].hdr.fi      = LIBLTE_RLC_FI_FIELD_LAST_SDU_SEGMENT;
+    rlc_umd[0].hdr.sn_size = LIBLTE_RLC_UMD_SN_SIZE_10_BITS;
+    rlc_umd[0].hdr.sn      = 517;
+    rlc_umd[0].hdr.N_li    = 1;
+    rlc_umd[0].hdr.li[0]   = 100;
+    codec_bench_random_bytes(&rlc_umd[0].data, CODEC_BENCH_N_SDU_BYTES);
+
+    // AMD PDU polling for a status report
+    rlc_amd[0].hdr.dc   = LIBLTE_RLC_DC_FIELD_DATA_PDU;
+    rlc_amd[0].hdr.rf   = LIBLTE_RLC_RF_FIELD_AMD_PDU;
+    rlc_amd[0].hdr.p    = LIBLTE_RLC_P_FIELD_STATUS_REPORT_REQUESTED;
+    rlc_amd[0].hdr.fi   = LIBLTE_RLC_FI_FIELD_FULL_SDU;
+    rlc_amd[0].hdr.sn   = 300;
+    rlc_amd[0].hdr.N_li = 0;
+    codec_bench_random_bytes(&rlc_amd[0].data, CODEC_BENCH_N_SDU_BYTES);
+
+    // Status PDU with four missing PDUs
+    rlc_status[0].ack_sn = 310;
+    rlc_status[0].N_nack = 4;
+    for(i=0; i<rlc_status[0].N_nack; i++)
+    {
+        rlc_status[0].nack_sn[i] = 301 + 2*i;
+    }
+
+    // PDCP
+    pdcp_control[0].count = 3;
+    liblte_bench_random_bits(&codec_bench_seed, pdcp_control[0].data.msg, CODEC_BENCH_N_NAS_BYTES*8);
+    pdcp_control[0].data.N_bits = CODEC_BENCH_N_NAS_BYTES*8;
+    pdcp_data[0].count          = 1234;
+    codec_bench_random_bytes(&pdcp_data[0].data, CODEC_BENCH_N_SDU_BYTES);
+    codec_bench_random_bytes(&pdcp_rohc_feedback[0].feedback, 3);
+}
+
+/*********************************************************************
+    Name: codec_bench_pack
+
+    Description: Packs the corpus message (idx 0) or its unpacked
+                 copy (idx 1) for a case.  NAS messages are packed
+                 with a plain header, so no MAC is computed.
+*********************************************************************/
+LIBLTE_ERROR_ENUM codec_bench_pack(CODEC_BENCH_CASE_ENUM   c,
+                                   uint32                  idx,
+                                   CODEC_BENCH_MSG_STRUCT *msg)
+{
+    LIBLTE_ERROR_ENUM       err   = LIBLTE_ERROR_INVALID_INPUTS;
+    LIBLTE_BIT_MSG_STRUCT  *bits  = &msg->bits;
+    LIBLTE_BYTE_MSG_STRUCT *bytes = &msg->bytes;
+    uint8                  *key   = codec_bench_key;
+    uint8                   plain = LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS;
+    uint8                   dl    = LIBLTE_SECURITY_DIRECTION_DOWNLINK;
+    uint8                   ul    = LIBLTE_SECURITY_DIRECTION_UPLINK;
+
+    switch(c)
+    {
+    case CODEC_BENCH_CASE_RRC_MIB:
+        err = liblte_rrc_pack_bcch_bch_msg(&rrc_mib[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_SIB1:
+        err = liblte_rrc_pack_bcch_dlsch_msg(&rrc_sib1[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_SIB2:
+        err = liblte_rrc_pack_bcch_dlsch_msg(&rrc_sib2[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_SYS_INFO:
+        err = liblte_rrc_pack_sys_info_msg(&rrc_sys_info[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_PAGING:
+        err = liblte_rrc_pack_pcch_msg(&rrc_paging[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_SETUP:
+        err = liblte_rrc_pack_dl_ccch_msg(&rrc_con_setup[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_REJECT:
+        err = liblte_rrc_pack_dl_ccch_msg(&rrc_con_rej[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_REEST:
+        err = liblte_rrc_pack_dl_ccch_msg(&rrc_con_reest[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_REEST_REJECT:
+        err = liblte_rrc_pack_dl_ccch_msg(&rrc_con_reest_rej[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_REQUEST:
+        err = liblte_rrc_pack_ul_ccch_msg(&rrc_con_req[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_REEST_REQUEST:
+        err = liblte_rrc_pack_ul_ccch_msg(&rrc_con_reest_req[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_SECURITY_MODE_COMMAND:
+        err = liblte_rrc_pack_dl_dcch_msg(&rrc_sec_mode_cmd[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_RECONFIG:
+        err = liblte_rrc_pack_dl_dcch_msg(&rrc_con_reconfig[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_DL_INFO_TRANSFER:
+        err = liblte_rrc_pack_dl_dcch_msg(&rrc_dl_info_transfer[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_RELEASE:
+        err = liblte_rrc_pack_dl_dcch_msg(&rrc_con_release[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_UE_INFO_REQUEST:
+        err = liblte_rrc_pack_dl_dcch_msg(&rrc_ue_info_req[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_SETUP_COMPLETE:
+        err = liblte_rrc_pack_ul_dcch_msg(&rrc_con_setup_complete[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_SECURITY_MODE_COMPLETE:
+        err = liblte_rrc_pack_ul_dcch_msg(&rrc_sec_mode_complete[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_SECURITY_MODE_FAILURE:
+        err = liblte_rrc_pack_ul_dcch_msg(&rrc_sec_mode_failure[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_RECONFIG_COMPLETE:
+        err = liblte_rrc_pack_ul_dcch_msg(&rrc_con_reconfig_complete[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RRC_UL_INFO_TRANSFER:
+        err = liblte_rrc_pack_ul_dcch_msg(&rrc_ul_info_transfer[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_MME_ATTACH_ACCEPT:
+        err = liblte_mme_pack_attach_accept_msg(&attach_accept[idx], plain, key, 0, dl, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_ATTACH_COMPLETE:
+        err = liblte_mme_pack_attach_complete_msg(&attach_comp[idx], plain, key, 0, ul, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_ATTACH_REJECT:
+        err = liblte_mme_pack_attach_reject_msg(&attach_rej[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_ATTACH_REQUEST:
+        err = liblte_mme_pack_attach_request_msg(&attach_req[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_AUTHENTICATION_FAILURE:
+        err = liblte_mme_pack_authentication_failure_msg(&auth_fail[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_AUTHENTICATION_REJECT:
+        err = liblte_mme_pack_authentication_reject_msg(&auth_rej[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_AUTHENTICATION_REQUEST:
+        err = liblte_mme_pack_authentication_request_msg(&auth_req[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_AUTHENTICATION_RESPONSE:
+        err = liblte_mme_pack_authentication_response_msg(&auth_resp[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_DETACH_ACCEPT:
+        err = liblte_mme_pack_detach_accept_msg(&detach_accept[idx], plain, key, 0, dl, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_DETACH_REQUEST:
+        err = liblte_mme_pack_detach_request_msg(&detach_req[idx], plain, key, 0, ul, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_DL_NAS_TRANSPORT:
+        err = liblte_mme_pack_downlink_nas_transport_msg(&dl_nas_transport[idx], plain, key, 0, dl, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_EMM_STATUS:
+        err = liblte_mme_pack_emm_status_msg(&emm_status[idx], plain, key, 0, dl, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_EXTENDED_SERVICE_REQUEST:
+        err = liblte_mme_pack_extended_service_request_msg(&ext_service_req[idx], plain, key, 0, ul, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_GUTI_REALLOCATION_COMMAND:
+        err = liblte_mme_pack_guti_reallocation_command_msg(&guti_realloc_cmd[idx], plain, key, 0, dl, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_GUTI_REALLOCATION_COMPLETE:
+        err = liblte_mme_pack_guti_reallocation_complete_msg(&guti_realloc_complete[idx], plain, key, 0, ul, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_IDENTITY_REQUEST:
+        err = liblte_mme_pack_identity_request_msg(&id_req[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_IDENTITY_RESPONSE:
+        err = liblte_mme_pack_identity_response_msg(&id_resp[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_SECURITY_MODE_COMMAND:
+        err = liblte_mme_pack_security_mode_command_msg(&sec_mode_cmd[idx], plain, key, 0, dl, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_SECURITY_MODE_COMPLETE:
+        err = liblte_mme_pack_security_mode_complete_msg(&sec_mode_comp[idx], plain, key, 0, ul, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_SECURITY_MODE_REJECT:
+        err = liblte_mme_pack_security_mode_reject_msg(&sec_mode_rej[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_SERVICE_REJECT:
+        err = liblte_mme_pack_service_reject_msg(&service_rej[idx], plain, key, 0, dl, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_SERVICE_REQUEST:
+        err = liblte_mme_pack_service_request_msg(&service_req[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_TAU_ACCEPT:
+        err = liblte_mme_pack_tracking_area_update_accept_msg(&ta_update_accept[idx], plain, key, 0, dl, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_TAU_COMPLETE:
+        err = liblte_mme_pack_tracking_area_update_complete_msg(&ta_update_complete[idx], plain, key, 0, ul, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_TAU_REJECT:
+        err = liblte_mme_pack_tracking_area_update_reject_msg(&ta_update_rej[idx], plain, key, 0, dl, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_UL_NAS_TRANSPORT:
+        err = liblte_mme_pack_uplink_nas_transport_msg(&ul_nas_transport[idx], plain, key, 0, ul, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_DL_GENERIC_NAS_TRANSPORT:
+        err = liblte_mme_pack_downlink_generic_nas_transport_msg(&dl_generic_nas_transport[idx], plain, key, 0, dl, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_UL_GENERIC_NAS_TRANSPORT:
+        err = liblte_mme_pack_uplink_generic_nas_transport_msg(&ul_generic_nas_transport[idx], plain, key, 0, ul, 1, bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_ACT_DED_EPS_BEARER_ACCEPT:
+        err = liblte_mme_pack_activate_dedicated_eps_bearer_context_accept_msg(&act_ded_eps_bearer_context_accept[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_ACT_DED_EPS_BEARER_REJECT:
+        err = liblte_mme_pack_activate_dedicated_eps_bearer_context_reject_msg(&act_ded_eps_bearer_context_rej[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_ACT_DED_EPS_BEARER_REQUEST:
+        err = liblte_mme_pack_activate_dedicated_eps_bearer_context_request_msg(&act_ded_eps_bearer_context_req[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_ACT_DEF_EPS_BEARER_ACCEPT:
+        err = liblte_mme_pack_activate_default_eps_bearer_context_accept_msg(&act_def_eps_bearer_context_accept[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_ACT_DEF_EPS_BEARER_REJECT:
+        err = liblte_mme_pack_activate_default_eps_bearer_context_reject_msg(&act_def_eps_bearer_context_rej[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_ACT_DEF_EPS_BEARER_REQUEST:
+        err = liblte_mme_pack_activate_default_eps_bearer_context_request_msg(&act_def_eps_bearer_context_req[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_BEARER_RES_ALLOC_REJECT:
+        err = liblte_mme_pack_bearer_resource_allocation_reject_msg(&bearer_res_alloc_rej[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_BEARER_RES_MOD_REJECT:
+        err = liblte_mme_pack_bearer_resource_modification_reject_msg(&bearer_res_mod_rej[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_DEACT_EPS_BEARER_ACCEPT:
+        err = liblte_mme_pack_deactivate_eps_bearer_context_accept_msg(&deact_eps_bearer_context_accept[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_DEACT_EPS_BEARER_REQUEST:
+        err = liblte_mme_pack_deactivate_eps_bearer_context_request_msg(&deact_eps_bearer_context_req[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_ESM_INFO_REQUEST:
+        err = liblte_mme_pack_esm_information_request_msg(&esm_info_req[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_ESM_INFO_RESPONSE:
+        err = liblte_mme_pack_esm_information_response_msg(&esm_info_resp[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_ESM_STATUS:
+        err = liblte_mme_pack_esm_status_msg(&esm_status[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_MOD_EPS_BEARER_ACCEPT:
+        err = liblte_mme_pack_modify_eps_bearer_context_accept_msg(&mod_eps_bearer_context_accept[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_MOD_EPS_BEARER_REJECT:
+        err = liblte_mme_pack_modify_eps_bearer_context_reject_msg(&mod_eps_bearer_context_rej[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_NOTIFICATION:
+        err = liblte_mme_pack_notification_msg(&notification[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_PDN_CON_REJECT:
+        err = liblte_mme_pack_pdn_connectivity_reject_msg(&pdn_con_rej[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_PDN_CON_REQUEST:
+        err = liblte_mme_pack_pdn_connectivity_request_msg(&pdn_con_req[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_PDN_DISCON_REJECT:
+        err = liblte_mme_pack_pdn_disconnect_reject_msg(&pdn_discon_rej[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MME_PDN_DISCON_REQUEST:
+        err = liblte_mme_pack_pdn_disconnect_request_msg(&pdn_discon_req[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_MAC_DLSCH_PDU:
+        err = liblte_mac_pack_mac_pdu(&mac_dlsch_pdu[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_MAC_ULSCH_PDU:
+        err = liblte_mac_pack_mac_pdu(&mac_ulsch_pdu[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_MAC_RAR_PDU:
+        err = liblte_mac_pack_random_access_response_pdu(&mac_rar[idx], bits);
+        break;
+    case CODEC_BENCH_CASE_RLC_UMD_PDU:
+        err = liblte_rlc_pack_umd_pdu(&rlc_umd[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_RLC_AMD_PDU:
+        err = liblte_rlc_pack_amd_pdu(&rlc_amd[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_RLC_STATUS_PDU:
+        err = liblte_rlc_pack_status_pdu(&rlc_status[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_PDCP_CONTROL_PDU:
+        err = liblte_pdcp_pack_control_pdu(&pdcp_control[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_PDCP_DATA_PDU_LONG_SN:
+        err = liblte_pdcp_pack_data_pdu_with_long_sn(&pdcp_data[idx], bytes);
+        break;
+    case CODEC_BENCH_CASE_PDCP_ROHC_FEEDBACK_PDU:
+        err = liblte_pdcp_pack_rohc_feedback_pdu(&pdcp_rohc_feedback[idx], bytes);
+        break;
+    default:
+        break;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: codec_bench_unpack
+
+    Description: Unpacks a packed case into its unpacked copy (idx 1)
+*********************************************************************/
+LIBLTE_ERROR_ENUM codec_bench_unpack(CODEC_BENCH_CASE_ENUM   c,
+                                     CODEC_BENCH_MSG_STRUCT *msg)
+{
+    LIBLTE_ERROR_ENUM       err   = LIBLTE_ERROR_INVALID_INPUTS;
+    LIBLTE_BIT_MSG_STRUCT  *bits  = &msg->bits;
+    LIBLTE_BYTE_MSG_STRUCT *bytes = &msg->bytes;
+
+    switch(c)
+    {
+    case CODEC_BENCH_CASE_RRC_MIB:
+        err = liblte_rrc_unpack_bcch_bch_msg(bits, &rrc_mib[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_SIB1:
+        err = liblte_rrc_unpack_bcch_dlsch_msg(bits, &rrc_sib1[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_SIB2:
+        err = liblte_rrc_unpack_bcch_dlsch_msg(bits, &rrc_sib2[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_SYS_INFO:
+        err = liblte_rrc_unpack_sys_info_msg(bits, &rrc_sys_info[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_PAGING:
+        err = liblte_rrc_unpack_pcch_msg(bits, &rrc_paging[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_SETUP:
+        err = liblte_rrc_unpack_dl_ccch_msg(bits, &rrc_con_setup[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_REJECT:
+        err = liblte_rrc_unpack_dl_ccch_msg(bits, &rrc_con_rej[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_REEST:
+        err = liblte_rrc_unpack_dl_ccch_msg(bits, &rrc_con_reest[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_REEST_REJECT:
+        err = liblte_rrc_unpack_dl_ccch_msg(bits, &rrc_con_reest_rej[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_REQUEST:
+        err = liblte_rrc_unpack_ul_ccch_msg(bits, &rrc_con_req[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_REEST_REQUEST:
+        err = liblte_rrc_unpack_ul_ccch_msg(bits, &rrc_con_reest_req[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_SECURITY_MODE_COMMAND:
+        err = liblte_rrc_unpack_dl_dcch_msg(bits, &rrc_sec_mode_cmd[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_RECONFIG:
+        err = liblte_rrc_unpack_dl_dcch_msg(bits, &rrc_con_reconfig[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_DL_INFO_TRANSFER:
+        err = liblte_rrc_unpack_dl_dcch_msg(bits, &rrc_dl_info_transfer[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_RELEASE:
+        err = liblte_rrc_unpack_dl_dcch_msg(bits, &rrc_con_release[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_UE_INFO_REQUEST:
+        err = liblte_rrc_unpack_dl_dcch_msg(bits, &rrc_ue_info_req[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_SETUP_COMPLETE:
+        err = liblte_rrc_unpack_ul_dcch_msg(bits, &rrc_con_setup_complete[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_SECURITY_MODE_COMPLETE:
+        err = liblte_rrc_unpack_ul_dcch_msg(bits, &rrc_sec_mode_complete[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_SECURITY_MODE_FAILURE:
+        err = liblte_rrc_unpack_ul_dcch_msg(bits, &rrc_sec_mode_failure[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_CON_RECONFIG_COMPLETE:
+        err = liblte_rrc_unpack_ul_dcch_msg(bits, &rrc_con_reconfig_complete[1]);
+        break;
+    case CODEC_BENCH_CASE_RRC_UL_INFO_TRANSFER:
+        err = liblte_rrc_unpack_ul_dcch_msg(bits, &rrc_ul_info_transfer[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_ATTACH_ACCEPT:
+        err = liblte_mme_unpack_attach_accept_msg(bytes, &attach_accept[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_ATTACH_COMPLETE:
+        err = liblte_mme_unpack_attach_complete_msg(bytes, &attach_comp[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_ATTACH_REJECT:
+        err = liblte_mme_unpack_attach_reject_msg(bytes, &attach_rej[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_ATTACH_REQUEST:
+        err = liblte_mme_unpack_attach_request_msg(bytes, &attach_req[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_AUTHENTICATION_FAILURE:
+        err = liblte_mme_unpack_authentication_failure_msg(bytes, &auth_fail[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_AUTHENTICATION_REJECT:
+        err = liblte_mme_unpack_authentication_reject_msg(bytes, &auth_rej[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_AUTHENTICATION_REQUEST:
+        err = liblte_mme_unpack_authentication_request_msg(bytes, &auth_req[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_AUTHENTICATION_RESPONSE:
+        err = liblte_mme_unpack_authentication_response_msg(bytes, &auth_resp[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_DETACH_ACCEPT:
+        err = liblte_mme_unpack_detach_accept_msg(bytes, &detach_accept[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_DETACH_REQUEST:
+        err = liblte_mme_unpack_detach_request_msg(bytes, &detach_req[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_DL_NAS_TRANSPORT:
+        err = liblte_mme_unpack_downlink_nas_transport_msg(bytes, &dl_nas_transport[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_EMM_STATUS:
+        err = liblte_mme_unpack_emm_status_msg(bytes, &emm_status[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_EXTENDED_SERVICE_REQUEST:
+        err = liblte_mme_unpack_extended_service_request_msg(bytes, &ext_service_req[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_GUTI_REALLOCATION_COMMAND:
+        err = liblte_mme_unpack_guti_reallocation_command_msg(bytes, &guti_realloc_cmd[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_GUTI_REALLOCATION_COMPLETE:
+        err = liblte_mme_unpack_guti_reallocation_complete_msg(bytes, &guti_realloc_complete[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_IDENTITY_REQUEST:
+        err = liblte_mme_unpack_identity_request_msg(bytes, &id_req[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_IDENTITY_RESPONSE:
+        err = liblte_mme_unpack_identity_response_msg(bytes, &id_resp[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_SECURITY_MODE_COMMAND:
+        err = liblte_mme_unpack_security_mode_command_msg(bytes, &sec_mode_cmd[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_SECURITY_MODE_COMPLETE:
+        err = liblte_mme_unpack_security_mode_complete_msg(bytes, &sec_mode_comp[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_SECURITY_MODE_REJECT:
+        err = liblte_mme_unpack_security_mode_reject_msg(bytes, &sec_mode_rej[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_SERVICE_REJECT:
+        err = liblte_mme_unpack_service_reject_msg(bytes, &service_rej[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_SERVICE_REQUEST:
+        err = liblte_mme_unpack_service_request_msg(bytes, &service_req[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_TAU_ACCEPT:
+        err = liblte_mme_unpack_tracking_area_update_accept_msg(bytes, &ta_update_accept[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_TAU_COMPLETE:
+        err = liblte_mme_unpack_tracking_area_update_complete_msg(bytes, &ta_update_complete[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_TAU_REJECT:
+        err = liblte_mme_unpack_tracking_area_update_reject_msg(bytes, &ta_update_rej[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_UL_NAS_TRANSPORT:
+        err = liblte_mme_unpack_uplink_nas_transport_msg(bytes, &ul_nas_transport[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_DL_GENERIC_NAS_TRANSPORT:
+        err = liblte_mme_unpack_downlink_generic_nas_transport_msg(bytes, &dl_generic_nas_transport[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_UL_GENERIC_NAS_TRANSPORT:
+        err = liblte_mme_unpack_uplink_generic_nas_transport_msg(bytes, &ul_generic_nas_transport[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_ACT_DED_EPS_BEARER_ACCEPT:
+        err = liblte_mme_unpack_activate_dedicated_eps_bearer_context_accept_msg(bytes, &act_ded_eps_bearer_context_accept[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_ACT_DED_EPS_BEARER_REJECT:
+        err = liblte_mme_unpack_activate_dedicated_eps_bearer_context_reject_msg(bytes, &act_ded_eps_bearer_context_rej[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_ACT_DED_EPS_BEARER_REQUEST:
+        err = liblte_mme_unpack_activate_dedicated_eps_bearer_context_request_msg(bytes, &act_ded_eps_bearer_context_req[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_ACT_DEF_EPS_BEARER_ACCEPT:
+        err = liblte_mme_unpack_activate_default_eps_bearer_context_accept_msg(bytes, &act_def_eps_bearer_context_accept[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_ACT_DEF_EPS_BEARER_REJECT:
+        err = liblte_mme_unpack_activate_default_eps_bearer_context_reject_msg(bytes, &act_def_eps_bearer_context_rej[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_ACT_DEF_EPS_BEARER_REQUEST:
+        err = liblte_mme_unpack_activate_default_eps_bearer_context_request_msg(bytes, &act_def_eps_bearer_context_req[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_BEARER_RES_ALLOC_REJECT:
+        err = liblte_mme_unpack_bearer_resource_allocation_reject_msg(bytes, &bearer_res_alloc_rej[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_BEARER_RES_MOD_REJECT:
+        err = liblte_mme_unpack_bearer_resource_modification_reject_msg(bytes, &bearer_res_mod_rej[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_DEACT_EPS_BEARER_ACCEPT:
+        err = liblte_mme_unpack_deactivate_eps_bearer_context_accept_msg(bytes, &deact_eps_bearer_context_accept[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_DEACT_EPS_BEARER_REQUEST:
+        err = liblte_mme_unpack_deactivate_eps_bearer_context_request_msg(bytes, &deact_eps_bearer_context_req[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_ESM_INFO_REQUEST:
+        err = liblte_mme_unpack_esm_information_request_msg(bytes, &esm_info_req[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_ESM_INFO_RESPONSE:
+        err = liblte_mme_unpack_esm_information_response_msg(bytes, &esm_info_resp[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_ESM_STATUS:
+        err = liblte_mme_unpack_esm_status_msg(bytes, &esm_status[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_MOD_EPS_BEARER_ACCEPT:
+        err = liblte_mme_unpack_modify_eps_bearer_context_accept_msg(bytes, &mod_eps_bearer_context_accept[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_MOD_EPS_BEARER_REJECT:
+        err = liblte_mme_unpack_modify_eps_bearer_context_reject_msg(bytes, &mod_eps_bearer_context_rej[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_NOTIFICATION:
+        err = liblte_mme_unpack_notification_msg(bytes, &notification[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_PDN_CON_REJECT:
+        err = liblte_mme_unpack_pdn_connectivity_reject_msg(bytes, &pdn_con_rej[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_PDN_CON_REQUEST:
+        err = liblte_mme_unpack_pdn_connectivity_request_msg(bytes, &pdn_con_req[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_PDN_DISCON_REJECT:
+        err = liblte_mme_unpack_pdn_disconnect_reject_msg(bytes, &pdn_discon_rej[1]);
+        break;
+    case CODEC_BENCH_CASE_MME_PDN_DISCON_REQUEST:
+        err = liblte_mme_unpack_pdn_disconnect_request_msg(bytes, &pdn_discon_req[1]);
+        break;
+    case CODEC_BENCH_CASE_MAC_DLSCH_PDU:
+        mac_dlsch_pdu[1].chan_type = LIBLTE_MAC_CHAN_TYPE_DLSCH;
+        err                        = liblte_mac_unpack_mac_pdu(bits, &mac_dlsch_pdu[1]);
+        break;
+    case CODEC_BENCH_CASE_MAC_ULSCH_PDU:
+        mac_ulsch_pdu[1].chan_type = LIBLTE_MAC_CHAN_TYPE_ULSCH;
+        err                        = liblte_mac_unpack_mac_pdu(bits, &mac_ulsch_pdu[1]);
+        break;
+    case CODEC_BENCH_CASE_MAC_RAR_PDU:
+        err = liblte_mac_unpack_random_access_response_pdu(bits, &mac_rar[1]);
+        break;
+    case CODEC_BENCH_CASE_RLC_UMD_PDU:
+        rlc_umd[1].hdr.sn_size = LIBLTE_RLC_UMD_SN_SIZE_10_BITS;
+        err                    = liblte_rlc_unpack_umd_pdu(bytes, &rlc_umd[1]);
+        break;
+    case CODEC_BENCH_CASE_RLC_AMD_PDU:
+        err = liblte_rlc_unpack_amd_pdu(bytes, &rlc_amd[1]);
+        break;
+    case CODEC_BENCH_CASE_RLC_STATUS_PDU:
+        err = liblte_rlc_unpack_status_pdu(bytes, &rlc_status[1]);
+        break;
+    case CODEC_BENCH_CASE_PDCP_CONTROL_PDU:
+        err = liblte_pdcp_unpack_control_pdu(bytes, &pdcp_control[1]);
+        break;
+    case CODEC_BENCH_CASE_PDCP_DATA_PDU_LONG_SN:
+        err = liblte_pdcp_unpack_data_pdu_with_long_sn(bytes, &pdcp_data[1]);
+        break;
+    case CODEC_BENCH_CASE_PDCP_ROHC_FEEDBACK_PDU:
+        err = liblte_pdcp_unpack_rohc_feedback_pdu(bytes, &pdcp_rohc_feedback[1]);
+        break;
+    default:
+        break;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: codec_bench_run_case
+
+    Description: Round trips a case once to check it and to count the
+                 heap bytes of a cold unpack, then times N_msgs packs
+                 and unpacks
+*********************************************************************/
+void codec_bench_run_case(CODEC_BENCH_CASE_ENUM      c,
+                          uint32                     N_msgs,
+                          CODEC_BENCH_RESULT_STRUCT *result)
+{
+    CODEC_BENCH_MSG_STRUCT *msg    = &codec_bench_msg[0];
+    CODEC_BENCH_MSG_STRUCT *re_msg = &codec_bench_msg[1];
+    LIBLTE_ERROR_ENUM       err;
+    uint64                  start;
+    uint64                  alloc_start;
+    uint32                  i;
+
+    memset(result, 0, sizeof(CODEC_BENCH_RESULT_STRUCT));
+    memset(&msg->bits,     0, sizeof(msg->bits));
+    memset(&msg->bytes,    0, sizeof(msg->bytes));
+    memset(&re_msg->bits,  0, sizeof(re_msg->bits));
+    memset(&re_msg->bytes, 0, sizeof(re_msg->bytes));
+
+    // Round trip
+    alloc_start = codec_bench_alloc_bytes;
+    err         = codec_bench_pack(c, 0, msg);
+    if(LIBLTE_SUCCESS == err)
+    {
+        err = codec_bench_unpack(c, msg);
+    }
+    if(LIBLTE_SUCCESS == err)
+    {
+        err = codec_bench_pack(c, 1, re_msg);
+    }
+    result->first_alloc_bytes = codec_bench_alloc_bytes - alloc_start;
+    if(LIBLTE_SUCCESS != err)
+    {
+        result->codec_error = true;
+    }else if(codec_bench_case_info[c].bits){
+        result->N_bits   = msg->bits.N_bits;
+        result->mismatch = (re_msg->bits.N_bits != msg->bits.N_bits ||
+                            0                   != memcmp(re_msg->bits.msg, msg->bits.msg, msg->bits.N_bits));
+    }else{
+        result->N_bits   = msg->bytes.N_bytes*8;
+        result->mismatch = (re_msg->bytes.N_bytes != msg->bytes.N_bytes ||
+                            0                     != memcmp(re_msg->bytes.msg, msg->bytes.msg, msg->bytes.N_bytes));
+    }
+
+    // Timing
+    if(!result->codec_error)
+    {
+        alloc_start = codec_bench_alloc_bytes;
+        start       = liblte_bench_get_time_ns();
+        for(i=0; i<N_msgs; i++)
+        {
+            codec_bench_pack(c, 0, msg);
+        }
+        result->pack_ns          = liblte_bench_get_time_ns() - start;
+        result->pack_alloc_bytes = codec_bench_alloc_bytes - alloc_start;
+
+        alloc_start = codec_bench_alloc_bytes;
+        start       = liblte_bench_get_time_ns();
+        for(i=0; i<N_msgs; i++)
+        {
+            codec_bench_unpack(c, msg);
+        }
+        result->unpack_ns          = liblte_bench_get_time_ns() - start;
+        result->unpack_alloc_bytes = codec_bench_alloc_bytes - alloc_start;
+    }
+}
+
+/*********************************************************************
+    Name: codec_bench_write_json
+
+    Description: Writes one JSON object per case so that results can
+                 be diffed and plotted across runs
+*********************************************************************/
+void codec_bench_write_json(FILE                      *file,
+                            uint32                     N_msgs,
+                            CODEC_BENCH_RESULT_STRUCT *results)
+{
+    CODEC_BENCH_RESULT_STRUCT *result;
+    uint32                     c;
+
+    fprintf(file, "{\n  \"bench\": \"liblte_codec_bench\",\n  \"n_msgs\": %u,\n  \"results\": [\n", N_msgs);
+    for(c=0; c<CODEC_BENCH_CASE_N_ITEMS; c++)
+    {
+        result = &results[c];
+        fprintf(file,
+                "    {\"layer\": \"%s\", \"msg\": \"%s\", \"api\": \"%s\", \"bits\": %u, "
+                "\"pack_ns\": %.1f, \"unpack_ns\": %.1f, \"first_alloc_bytes\": %llu, "
+                "\"pack_alloc_bytes\": %.1f, \"unpack_alloc_bytes\": %.1f, \"round_trip\": \"%s\"}%s\n",
+                codec_bench_layer_text[codec_bench_case_info[c].layer],
+                codec_bench_case_info[c].name,
+                codec_bench_case_info[c].bits ? "bits" : "bytes",
+                result->N_bits,
+                (double)result->pack_ns/(double)N_msgs,
+                (double)result->unpack_ns/(double)N_msgs,
+                (unsigned long long)result->first_alloc_bytes,
+                (double)result->pack_alloc_bytes/(double)N_msgs,
+                (double)result->unpack_alloc_bytes/(double)N_msgs,
+                result->codec_error ? "error" : (result->mismatch ? "mismatch" : "pass"),
+                (c+1 < CODEC_BENCH_CASE_N_ITEMS) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+}
+
+int main(int argc, char *argv[])
+{
+    static CODEC_BENCH_RESULT_STRUCT  results[CODEC_BENCH_CASE_N_ITEMS];
+    CODEC_BENCH_RESULT_STRUCT        *result;
+    FILE                             *json   = NULL;
+    char                             *end;
+    unsigned long                     value;
+    uint32                            N_msgs = CODEC_BENCH_DEFAULT_N_MSGS;
+    uint32                            N_fail = 0;
+    uint32                            c;
+
+    if(argc > 1)
+    {
+        value = strtoul(argv[1], &end, 10);
+        if(argc  > 3                ||
+           !isdigit(argv[1][0])     ||
+           '\0'  != *end            ||
+           value > 0xFFFFFFFF)
+        {
+            printf("Usage: %s [N_msgs [results.json]]\n", argv[0]);
+            return(1);
+        }
+        N_msgs = value;
+    }
+    if(0 == N_msgs)
+    {
+        N_msgs = 1;
+    }
+
+    codec_bench_fill_rrc();
+    codec_bench_fill_mme();
+    codec_bench_fill_lower_layers();
+
+    printf("%u messages per case\n", N_msgs);
+    printf("%-5s %-33s %-5s %6s %10s %10s %8s %9s %9s %s\n",
+           "layer", "message", "api", "bits", "pack ns", "unpack ns", "first B",
+           "pack B/m", "unpk B/m", "round trip");
+    for(c=0; c<CODEC_BENCH_CASE_N_ITEMS; c++)
+    {
+        result = &results[c];
+        codec_bench_run_case((CODEC_BENCH_CASE_ENUM)c, N_msgs, result);
+        printf("%-5s %-33s %-5s %6u %10.1f %10.1f %8llu %9.1f %9.1f %s\n",
+               codec_bench_layer_text[codec_bench_case_info[c].layer],
+               codec_bench_case_info[c].name,
+               codec_bench_case_info[c].bits ? "bits" : "bytes",
+               result->N_bits,
+               (double)result->pack_ns/(double)N_msgs,
+               (double)result->unpack_ns/(double)N_msgs,
+               (unsigned long long)result->first_alloc_bytes,
+               (double)result->pack_alloc_bytes/(double)N_msgs,
+               (double)result->unpack_alloc_bytes/(double)N_msgs,
+               result->codec_error ? "ERROR" : (result->mismatch ? "MISMATCH" : "pass"));
+        if(result->codec_error || result->mismatch)
+        {
+            N_fail++;
+        }
+    }
+
+    if(argc > 2)
+    {
+        json = fopen(argv[2], "w");
+        if(NULL != json)
+        {
+            codec_bench_write_json(json, N_msgs, results);
+            fclose(json);
+        }else{
+            printf("Could not open %s\n", argv[2]);
+            N_fail++;
+        }
+    }
+
+    if(0 != N_fail)
+    {
+        printf("%u of %u cases failed\n", N_fail, CODEC_BENCH_CASE_N_ITEMS);
+        return(1);
+    }
+    return(0);
+}
@@ -0,0 +1,432 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_harq_bench.cc
+
+    Description: Measures the downlink shared channel throughput over a
+                 block Rayleigh fading channel with HARQ incremental
+                 redundancy combining, and compares it with sending the
+                 same transport blocks without combining.  Fails if a
+                 first transmission does not decode over a clean
+                 channel, or if combining loses throughput.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_bench_common.h"
+#include "liblte_phy.h"
+#include <math.h>
+#include <string.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define HARQ_BENCH_DEFAULT_N_TBS 50
+#define HARQ_BENCH_N_ID_CELL     77
+#define HARQ_BENCH_SUBFR_NUM     1
+#define HARQ_BENCH_N_PDCCH_SYMBS 2
+#define HARQ_BENCH_MAX_TX        4
+#define HARQ_BENCH_POOL_SIZE     (1024*1024)
+#define HARQ_BENCH_CLEAN_SNR     30
+#define HARQ_BENCH_MIN_GAIN      0.95 // Allows for the noise of a finite number of transport blocks
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef struct{
+    uint8                           mcs;
+    LIBLTE_PHY_MODULATION_TYPE_ENUM mod_type;
+    uint32                          N_bits;
+}HARQ_BENCH_MCS_STRUCT;
+
+typedef struct{
+    uint32 N_bits_ok;
+    uint32 N_tbs_ok;
+    uint32 N_tx;
+}HARQ_BENCH_RESULT_STRUCT;
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+HARQ_BENCH_MCS_STRUCT mcs_list[] = {{2, LIBLTE_PHY_MODULATION_TYPE_QPSK, 1000},
+                                    {5, LIBLTE_PHY_MODULATION_TYPE_QPSK, 2000},
+                                    {7, LIBLTE_PHY_MODULATION_TYPE_QPSK, 2500},
+                                    {9, LIBLTE_PHY_MODULATION_TYPE_QPSK, 3000}};
+float                 snr_list[] = {3, 6, 10, 15, 20};
+uint32                rv_list[]  = {0, 2, 3, 1};
+
+LIBLTE_PHY_SUBFRAME_STRUCT tx_subframe;
+LIBLTE_PHY_SUBFRAME_STRUCT rx_subframe;
+LIBLTE_PHY_PDCCH_STRUCT    pdcch;
+uint8                      out_bits[LIBLTE_MAX_MSG_SIZE];
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: random_gauss
+
+    Description: Returns a zero mean, unit variance gaussian sample
+*********************************************************************/
+float random_gauss(uint32 *seed)
+{
+    float u1 = ((float)(liblte_bench_rand(seed) >> 8) + 1) / 16777217.0;
+    float u2 = ((float)(liblte_bench_rand(seed) >> 8) + 1) / 16777217.0;
+
+    return(sqrt(-2*log(u1))*cos(2*M_PI*u2));
+}
+
+/*********************************************************************
+    Name: send_subframe
+
+    Description: Encodes one transmission of the transport block,
+                 passes it through a flat Rayleigh fading channel that
+                 is held for the whole subframe, adds white gaussian
+                 noise at the requested average SNR, and demodulates
+                 the result into rx_subframe.  Without fading the
+                 channel gain is 1.
+*********************************************************************/
+void send_subframe(LIBLTE_PHY_STRUCT *phy_struct,
+                   uint32            *seed,
+                   float              snr_db,
+                   bool               fading,
+                   float             *i_buf,
+                   float             *q_buf)
+{
+    float  *i_samps = &i_buf[HARQ_BENCH_SUBFR_NUM*phy_struct->N_samps_per_subfr];
+    float  *q_samps = &q_buf[HARQ_BENCH_SUBFR_NUM*phy_struct->N_samps_per_subfr];
+    float   h_re    = 1;
+    float   h_im    = 0;
+    float   power   = 0;
+    float   sd;
+    float   tmp_i;
+    uint32  i;
+
+    if(fading)
+    {
+        h_re = random_gauss(seed)/sqrt(2);
+        h_im = random_gauss(seed)/sqrt(2);
+    }
+
+    memset(&tx_subframe, 0, sizeof(LIBLTE_PHY_SUBFRAME_STRUCT));
+    tx_subframe.num = HARQ_BENCH_SUBFR_NUM;
+    liblte_phy_map_crs(phy_struct,
+                       &tx_subframe,
+                       HARQ_BENCH_N_ID_CELL,
+                       1);
+    liblte_phy_pdsch_channel_encode(phy_struct,
+                                    &pdcch,
+                                    HARQ_BENCH_N_ID_CELL,
+                                    1,
+                                    &tx_subframe);
+    liblte_phy_create_dl_subframe(phy_struct,
+                                  &tx_subframe,
+                                  0,
+                                  i_samps,
+                                  q_samps);
+
+    for(i=0; i<phy_struct->N_samps_per_subfr; i++)
+    {
+        power += i_samps[i]*i_samps[i] + q_samps[i]*q_samps[i];
+    }
+    sd = sqrt(power/phy_struct->N_samps_per_subfr/pow(10, snr_db/10)/2);
+    for(i=0; i<phy_struct->N_samps_per_subfr; i++)
+    {
+        tmp_i      = h_re*i_samps[i] - h_im*q_samps[i];
+        q_samps[i] = h_re*q_samps[i] + h_im*i_samps[i] + sd*random_gauss(seed);
+        i_samps[i] = tmp_i + sd*random_gauss(seed);
+    }
+
+    liblte_phy_get_dl_subframe_and_ce(phy_struct,
+                                      i_buf,
+                                      q_buf,
+                                      0,
+                                      HARQ_BENCH_SUBFR_NUM,
+                                      HARQ_BENCH_N_ID_CELL,
+                                      1,
+                                      &rx_subframe);
+}
+
+/*********************************************************************
+    Name: send_tb
+
+    Description: Sends one transport block with up to
+                 HARQ_BENCH_MAX_TX transmissions.  With a soft buffer
+                 each retransmission uses the next redundancy version
+                 and is combined with the earlier ones, without one
+                 every transmission is redundancy version 0 and is
+                 decoded on its own.
+*********************************************************************/
+void send_tb(LIBLTE_PHY_STRUCT                  *phy_struct,
+             LIBLTE_PHY_SOFT_BUFFER_POOL_STRUCT *pool,
+             uint32                              seed,
+             float                               snr_db,
+             bool                                combine,
+             float                              *i_buf,
+             float                              *q_buf,
+             HARQ_BENCH_RESULT_STRUCT           *result)
+{
+    LIBLTE_PHY_ALLOCATION_STRUCT  *alloc       = &pdcch.alloc[0];
+    LIBLTE_PHY_SUBFRAME_STRUCT    *subframe    = &rx_subframe;
+    LIBLTE_PHY_SOFT_BUFFER_STRUCT  soft_buffer;
+    LIBLTE_PHY_SOFT_BUFFER_STRUCT *sb          = NULL;
+    uint32                         N_out_bits;
+    uint32                         tx;
+
+    if(combine &&
+       LIBLTE_SUCCESS == liblte_phy_soft_buffer_alloc(pool, alloc->tbs, &soft_buffer))
+    {
+        sb = &soft_buffer;
+    }
+
+    for(tx=0; tx<HARQ_BENCH_MAX_TX; tx++)
+    {
+        if(combine)
+        {
+            alloc->rv_idx = rv_list[tx];
+        }else{
+            alloc->rv_idx = 0;
+        }
+        send_subframe(phy_struct, &seed, snr_db, true, i_buf, q_buf);
+        result->N_tx++;
+
+        if(LIBLTE_SUCCESS == liblte_phy_pdsch_channel_decode_multi_rx(phy_struct,
+                                                                      &subframe,
+                                                                      1,
+                                                                      alloc,
+                                                                      HARQ_BENCH_N_PDCCH_SYMBS,
+                                                                      HARQ_BENCH_N_ID_CELL,
+                                                                      1,
+                                                                      sb,
+                                                                      out_bits,
+                                                                      &N_out_bits) &&
+           N_out_bits >= alloc->tbs                                                 &&
+           0          == memcmp(out_bits, alloc->msg.msg, alloc->tbs))
+        {
+            result->N_bits_ok += alloc->tbs;
+            result->N_tbs_ok++;
+            break;
+        }
+    }
+
+    if(NULL != sb)
+    {
+        liblte_phy_soft_buffer_free(sb);
+    }
+}
+
+/*********************************************************************
+    Name: first_tx_decodes
+
+    Description: Sends redundancy version 0 of the transport block
+                 once over a clean channel and checks that it decodes
+                 without any retransmission.
+*********************************************************************/
+bool first_tx_decodes(LIBLTE_PHY_STRUCT *phy_struct,
+                      uint32             seed,
+                      float             *i_buf,
+                      float             *q_buf)
+{
+    LIBLTE_PHY_ALLOCATION_STRUCT *alloc    = &pdcch.alloc[0];
+    LIBLTE_PHY_SUBFRAME_STRUCT   *subframe = &rx_subframe;
+    uint32                        N_out_bits;
+
+    alloc->rv_idx = 0;
+    send_subframe(phy_struct, &seed, HARQ_BENCH_CLEAN_SNR, false, i_buf, q_buf);
+
+    return(LIBLTE_SUCCESS == liblte_phy_pdsch_channel_decode_multi_rx(phy_struct,
+                                                                      &subframe,
+                                                                      1,
+                                                                      alloc,
+                                                                      HARQ_BENCH_N_PDCCH_SYMBS,
+                                                                      HARQ_BENCH_N_ID_CELL,
+                                                                      1,
+                                                                      NULL,
+                                                                      out_bits,
+                                                                      &N_out_bits) &&
+           N_out_bits >= alloc->tbs                                                 &&
+           0          == memcmp(out_bits, alloc->msg.msg, alloc->tbs));
+}
+
+int main(int argc, char *argv[])
+{
+    LIBLTE_PHY_STRUCT                  *phy_struct;
+    LIBLTE_PHY_SOFT_BUFFER_POOL_STRUCT *pool;
+    LIBLTE_PHY_ALLOCATION_STRUCT       *alloc = &pdcch.alloc[0];
+    HARQ_BENCH_RESULT_STRUCT            ir;
+    HARQ_BENCH_RESULT_STRUCT            arq;
+    HARQ_BENCH_RESULT_STRUCT            ir_total;
+    HARQ_BENCH_RESULT_STRUCT            arq_total;
+    uint64                              start;
+    uint64                              stop;
+    float                              *i_buf;
+    float                              *q_buf;
+    float                               ir_mbps;
+    float                               arq_mbps;
+    uint32                              N_tbs = HARQ_BENCH_DEFAULT_N_TBS;
+    uint32                              seed  = 1;
+    uint32                              tb_seed;
+    uint32                              i;
+    uint32                              j;
+    uint32                              k;
+    bool                                fail  = false;
+
+    if(argc > 1)
+    {
+        N_tbs = atoi(argv[1]);
+    }
+
+    liblte_phy_init(&phy_struct,
+                    LIBLTE_PHY_FS_7_68MHZ,
+                    HARQ_BENCH_N_ID_CELL,
+                    1,
+                    LIBLTE_PHY_N_RB_DL_5MHZ,
+                    LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
+                    1);
+    liblte_phy_soft_buffer_pool_init(&pool, HARQ_BENCH_POOL_SIZE);
+    i_buf = (float *)calloc(phy_struct->N_samps_per_frame, sizeof(float));
+    q_buf = (float *)calloc(phy_struct->N_samps_per_frame, sizeof(float));
+
+    memset(&pdcch, 0, sizeof(LIBLTE_PHY_PDCCH_STRUCT));
+    pdcch.N_symbs         = HARQ_BENCH_N_PDCCH_SYMBS;
+    pdcch.N_alloc         = 1;
+    alloc->pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
+    alloc->chan_type      = LIBLTE_PHY_CHAN_TYPE_DLSCH;
+    alloc->N_codewords    = 1;
+    alloc->N_layers       = 1;
+    alloc->tx_mode        = 1;
+    alloc->rnti           = 0x3D;
+
+    printf("%4s %5s %4s %6s %10s %10s %9s %9s %8s\n",
+           "mcs", "tbs", "prbs", "snr", "IR (Mb/s)", "ARQ (Mb/s)", "IR tx/TB", "ARQ tx/TB", "gain");
+    memset(&ir_total, 0, sizeof(HARQ_BENCH_RESULT_STRUCT));
+    memset(&arq_total, 0, sizeof(HARQ_BENCH_RESULT_STRUCT));
+    start = liblte_bench_get_time_ns();
+    for(i=0; i<sizeof(mcs_list)/sizeof(mcs_list[0]); i++)
+    {
+        alloc->mcs      = mcs_list[i].mcs;
+        alloc->mod_type = mcs_list[i].mod_type;
+        liblte_phy_get_tbs_and_n_prb_for_dl(mcs_list[i].N_bits,
+                                            LIBLTE_PHY_N_RB_DL_5MHZ,
+                                            alloc->mcs,
+                                            &alloc->tbs,
+                                            &alloc->N_prb);
+        for(j=0; j<alloc->N_prb; j++)
+        {
+            alloc->prb[0][j] = j;
+            alloc->prb[1][j] = j;
+        }
+        alloc->msg.N_bits = alloc->tbs;
+
+        liblte_bench_random_bits(&seed, alloc->msg.msg, alloc->tbs);
+        if(!first_tx_decodes(phy_struct, liblte_bench_rand(&seed), i_buf, q_buf))
+        {
+            printf("mcs %u tbs %u does not decode on the first transmission at %u dB without fading\n",
+                   alloc->mcs,
+                   alloc->tbs,
+                   HARQ_BENCH_CLEAN_SNR);
+            fail = true;
+        }
+
+        for(j=0; j<sizeof(snr_list)/sizeof(snr_list[0]); j++)
+        {
+            memset(&ir, 0, sizeof(HARQ_BENCH_RESULT_STRUCT));
+            memset(&arq, 0, sizeof(HARQ_BENCH_RESULT_STRUCT));
+            for(k=0; k<N_tbs; k++)
+            {
+                liblte_bench_random_bits(&seed, alloc->msg.msg, alloc->tbs);
+
+                // Both schemes see the same channel and noise for each transmission
+                tb_seed = liblte_bench_rand(&seed);
+                send_tb(phy_struct, pool, tb_seed, snr_list[j], true,  i_buf, q_buf, &ir);
+                send_tb(phy_struct, pool, tb_seed, snr_list[j], false, i_buf, q_buf, &arq);
+            }
+
+            // Each transmission takes one 1ms subframe
+            ir_mbps  = (float)ir.N_bits_ok/(float)ir.N_tx/1000;
+            arq_mbps = (float)arq.N_bits_ok/(float)arq.N_tx/1000;
+            ir_total.N_bits_ok  += ir.N_bits_ok;
+            ir_total.N_tx       += ir.N_tx;
+            arq_total.N_bits_ok += arq.N_bits_ok;
+            arq_total.N_tx      += arq.N_tx;
+
+            printf("%4u %5u %4u %6.1f %10.3f %10.3f %9.2f %9.2f",
+                   alloc->mcs,
+                   alloc->tbs,
+                   alloc->N_prb,
+                   snr_list[j],
+                   ir_mbps,
+                   arq_mbps,
+                   (float)ir.N_tx/(float)N_tbs,
+                   (float)arq.N_tx/(float)N_tbs);
+            if(0 != arq.N_bits_ok)
+            {
+                printf(" %7.2fx\n", ir_mbps/arq_mbps);
+            }else{
+                printf(" %8s\n", "-");
+            }
+            if(ir_mbps < HARQ_BENCH_MIN_GAIN*arq_mbps)
+            {
+                printf("combining lost throughput at mcs %u, %.1f dB\n", alloc->mcs, snr_list[j]);
+                fail = true;
+            }
+        }
+    }
+    stop     = liblte_bench_get_time_ns();
+    ir_mbps  = (float)ir_total.N_bits_ok/(float)ir_total.N_tx/1000;
+    arq_mbps = (float)arq_total.N_bits_ok/(float)arq_total.N_tx/1000;
+    printf("overall IR %.3f Mb/s, ARQ %.3f Mb/s, %u transport blocks per point in %.1f s\n",
+           ir_mbps,
+           arq_mbps,
+           N_tbs,
+           (float)(stop - start)/1000000000);
+
+    if(ir_mbps < arq_mbps)
+    {
+        printf("combining lost throughput\n");
+        fail = true;
+    }
+    if(pool->N_free_chunks != pool->N_chunks)
+    {
+        printf("soft buffer pool leaked %u chunks\n", pool->N_chunks - pool->N_free_chunks);
+        fail = true;
+    }
+
+    free(i_buf);
+    free(q_buf);
+    liblte_phy_soft_buffer_pool_cleanup(pool);
+    liblte_phy_cleanup(phy_struct);
+
+    if(fail)
+    {
+        return(1);
+    }
+    return(0);
+}
@@ -0,0 +1,403 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_milenage_bench.cc
+
+    Description: Verifies the Milenage functions against the 35.208 test
+                 sets and reports single core authentication vector
+                 generation rates for many subscribers, with a key
+                 setup per vector, with cached subscriber contexts, and
+                 with the batch API.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_bench_common.h"
+#include "liblte_security.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define MILENAGE_BENCH_DEFAULT_N_VECS  1000000
+#define MILENAGE_BENCH_N_SUBSCRIBERS   1024
+#define MILENAGE_BENCH_BATCH_SIZE      32
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef struct{
+    uint8 k[16];
+    uint8 rand[16];
+    uint8 sqn[6];
+    uint8 amf[2];
+    uint8 op[16];
+    uint8 op_c[16];
+    uint8 f1[8];
+    uint8 f1_star[8];
+    uint8 f2[8];
+    uint8 f5[6];
+    uint8 f3[16];
+    uint8 f4[16];
+    uint8 f5_star[6];
+}MILENAGE_BENCH_TEST_SET_STRUCT;
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+// 35.208 v10.0.0 Section 4.3, test sets 1 through 3
+MILENAGE_BENCH_TEST_SET_STRUCT test_sets[] = {{{0x46,0x5B,0x5C,0xE8,0xB1,0x99,0xB4,0x9F,0xAA,0x5F,0x0A,0x2E,0xE2,0x38,0xA6,0xBC},
+                                               {0x23,0x55,0x3C,0xBE,0x96,0x37,0xA8,0x9D,0x21,0x8A,0xE6,0x4D,0xAE,0x47,0xBF,0x35},
+                                               {0xFF,0x9B,0xB4,0xD0,0xB6,0x07},
+                                               {0xB9,0xB9},
+                                               {0xCD,0xC2,0x02,0xD5,0x12,0x3E,0x20,0xF6,0x2B,0x6D,0x67,0x6A,0xC7,0x2C,0xB3,0x18},
+                                               {0xCD,0x63,0xCB,0x71,0x95,0x4A,0x9F,0x4E,0x48,0xA5,0x99,0x4E,0x37,0xA0,0x2B,0xAF},
+                                               {0x4A,0x9F,0xFA,0xC3,0x54,0xDF,0xAF,0xB3},
+                                               {0x01,0xCF,0xAF,0x9E,0xC4,0xE8,0x71,0xE9},
+                                               {0xA5,0x42,0x11,0xD5,0xE3,0xBA,0x50,0xBF},
+                                               {0xAA,0x68,0x9C,0x64,0x83,0x70},
+                                               {0xB4,0x0B,0xA9,0xA3,0xC5,0x8B,0x2A,0x05,0xBB,0xF0,0xD9,0x87,0xB2,0x1B,0xF8,0xCB},
+                                               {0xF7,0x69,0xBC,0xD7,0x51,0x04,0x46,0x04,0x12,0x76,0x72,0x71,0x1C,0x6D,0x34,0x41},
+                                               {0x45,0x1E,0x8B,0xEC,0xA4,0x3B}},
+                                              {{0x03,0x96,0xEB,0x31,0x7B,0x6D,0x1C,0x36,0xF1,0x9C,0x1C,0x84,0xCD,0x6F,0xFD,0x16},
+                                               {0xC0,0x0D,0x60,0x31,0x03,0xDC,0xEE,0x52,0xC4,0x47,0x81,0x19,0x49,0x42,0x02,0xE8},
+                                               {0xFD,0x8E,0xEF,0x40,0xDF,0x7D},
+                                               {0xAF,0x17},
+                                               {0xFF,0x53,0xBA,0xDE,0x17,0xDF,0x5D,0x4E,0x79,0x30,0x73,0xCE,0x9D,0x75,0x79,0xFA},
+                                               {0x53,0xC1,0x56,0x71,0xC6,0x0A,0x4B,0x73,0x1C,0x55,0xB4,0xA4,0x41,0xC0,0xBD,0xE2},
+                                               {0x5D,0xF5,0xB3,0x18,0x07,0xE2,0x58,0xB0},
+                                               {0xA8,0xC0,0x16,0xE5,0x1E,0xF4,0xA3,0x43},
+                                               {0xD3,0xA6,0x28,0xED,0x98,0x86,0x20,0xF0},
+                                               {0xC4,0x77,0x83,0x99,0x5F,0x72},
+                                               {0x58,0xC4,0x33,0xFF,0x7A,0x70,0x82,0xAC,0xD4,0x24,0x22,0x0F,0x2B,0x67,0xC5,0x56},
+                                               {0x21,0xA8,0xC1,0xF9,0x29,0x70,0x2A,0xDB,0x3E,0x73,0x84,0x88,0xB9,0xF5,0xC5,0xDA},
+                                               {0x30,0xF1,0x19,0x70,0x61,0xC1}},
+                                              {{0xFE,0xC8,0x6B,0xA6,0xEB,0x70,0x7E,0xD0,0x89,0x05,0x75,0x7B,0x1B,0xB4,0x4B,0x8F},
+                                               {0x9F,0x7C,0x8D,0x02,0x1A,0xCC,0xF4,0xDB,0x21,0x3C,0xCF,0xF0,0xC7,0xF7,0x1A,0x6A},
+                                               {0x9D,0x02,0x77,0x59,0x5F,0xFC},
+                                               {0x72,0x5C},
+                                               {0xDB,0xC5,0x9A,0xDC,0xB6,0xF9,0xA0,0xEF,0x73,0x54,0x77,0xB7,0xFA,0xDF,0x83,0x74},
+                                               {0x10,0x06,0x02,0x0F,0x0A,0x47,0x8B,0xF6,0xB6,0x99,0xF1,0x5C,0x06,0x2E,0x42,0xB3},
+                                               {0x9C,0xAB,0xC3,0xE9,0x9B,0xAF,0x72,0x81},
+                                               {0x95,0x81,0x4B,0xA2,0xB3,0x04,0x43,0x24},
+                                               {0x80,0x11,0xC4,0x8C,0x0C,0x21,0x4E,0xD2},
+                                               {0x33,0x48,0x4D,0xC2,0x13,0x6B},
+                                               {0x5D,0xBD,0xBB,0x29,0x54,0xE8,0xF3,0xCD,0xE6,0x65,0xB0,0x46,0x17,0x9A,0x50,0x98},
+                                               {0x59,0xA9,0x2D,0x3B,0x47,0x6A,0x04,0x43,0x48,0x70,0x55,0xCF,0x88,0xB2,0x30,0x7B},
+                                               {0xDE,0xAC,0xDD,0x84,0x8C,0xC6}}};
+
+uint8                                  sub_k[MILENAGE_BENCH_N_SUBSCRIBERS][16];
+LIBLTE_SECURITY_MILENAGE_CTX_STRUCT    sub_ctx[MILENAGE_BENCH_N_SUBSCRIBERS];
+LIBLTE_SECURITY_MILENAGE_VECTOR_STRUCT vec[MILENAGE_BENCH_BATCH_SIZE];
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: check_test_sets
+
+    Description: Runs every Milenage function on each test set and
+                 returns the number of mismatches
+*********************************************************************/
+uint32 check_test_sets(void)
+{
+    LIBLTE_SECURITY_MILENAGE_CTX_STRUCT    ctx;
+    LIBLTE_SECURITY_MILENAGE_VECTOR_STRUCT v;
+    uint32                                 N_fail = 0;
+    uint32                                 i;
+    uint32                                 j;
+    uint8                                  op_c[16];
+    uint8                                  mac[8];
+    uint8                                  res[8];
+    uint8                                  ck[16];
+    uint8                                  ik[16];
+    uint8                                  ak[6];
+    uint8                                  ak_star[6];
+
+    for(i=0; i<sizeof(test_sets)/sizeof(test_sets[0]); i++)
+    {
+        liblte_security_milenage_init(&ctx, test_sets[i].k, test_sets[i].op);
+        for(j=0; j<16; j++)
+        {
+            op_c[j] = (ctx.op_c[j/4] >> (24 - (j%4)*8)) & 0xFF;
+        }
+        if(memcmp(op_c, test_sets[i].op_c, 16))
+        {
+            printf("Test set %u OPc mismatch\n", i+1);
+            N_fail++;
+        }
+
+        liblte_security_milenage_f1(&ctx, test_sets[i].rand, test_sets[i].sqn, test_sets[i].amf, mac);
+        if(memcmp(mac, test_sets[i].f1, 8))
+        {
+            printf("Test set %u f1 mismatch\n", i+1);
+            N_fail++;
+        }
+        liblte_security_milenage_f1_star(&ctx, test_sets[i].rand, test_sets[i].sqn, test_sets[i].amf, mac);
+        if(memcmp(mac, test_sets[i].f1_star, 8))
+        {
+            printf("Test set %u f1* mismatch\n", i+1);
+            N_fail++;
+        }
+        liblte_security_milenage_f2345(&ctx, test_sets[i].rand, res, ck, ik, ak);
+        liblte_security_milenage_f5_star(&ctx, test_sets[i].rand, ak_star);
+        if(memcmp(res, test_sets[i].f2, 8)  ||
+           memcmp(ck, test_sets[i].f3, 16)  ||
+           memcmp(ik, test_sets[i].f4, 16)  ||
+           memcmp(ak, test_sets[i].f5, 6)   ||
+           memcmp(ak_star, test_sets[i].f5_star, 6))
+        {
+            printf("Test set %u f2-f5* mismatch\n", i+1);
+            N_fail++;
+        }
+
+        v.ctx = &ctx;
+        memcpy(v.rand, test_sets[i].rand, 16);
+        memcpy(v.sqn, test_sets[i].sqn, 6);
+        memcpy(v.amf, test_sets[i].amf, 2);
+        liblte_security_milenage_batch(&v, 1);
+        if(memcmp(v.mac_a, test_sets[i].f1, 8) ||
+           memcmp(v.res, test_sets[i].f2, 8)   ||
+           memcmp(v.ck, test_sets[i].f3, 16)   ||
+           memcmp(v.ik, test_sets[i].f4, 16)   ||
+           memcmp(v.ak, test_sets[i].f5, 6))
+        {
+            printf("Test set %u batch mismatch\n", i+1);
+            N_fail++;
+        }
+    }
+
+    return(N_fail);
+}
+
+/*********************************************************************
+    Name: fill_batch
+
+    Description: Picks a pseudo random subscriber, RAND, and SQN for
+                 each vector of a batch
+*********************************************************************/
+void fill_batch(uint32 *seed,
+                uint32  N_vecs)
+{
+    uint32 i;
+    uint32 j;
+
+    for(i=0; i<N_vecs; i++)
+    {
+        vec[i].ctx = &sub_ctx[liblte_bench_rand(seed) % MILENAGE_BENCH_N_SUBSCRIBERS];
+        for(j=0; j<16; j++)
+        {
+            vec[i].rand[j] = liblte_bench_rand(seed) & 0xFF;
+        }
+        for(j=0; j<6; j++)
+        {
+            vec[i].sqn[j] = liblte_bench_rand(seed) & 0xFF;
+        }
+        vec[i].amf[0] = 0x80;
+        vec[i].amf[1] = 0x00;
+    }
+}
+
+/*********************************************************************
+    Name: check_batch
+
+    Description: Checks that a batch of vectors for different
+                 subscribers, including a partial last group, matches
+                 the same vectors computed one at a time, and returns
+                 the number of mismatches
+*********************************************************************/
+uint32 check_batch(uint32 *seed)
+{
+    uint32 N_fail = 0;
+    uint32 N_vecs;
+    uint32 i;
+    uint8  mac[8];
+    uint8  res[8];
+    uint8  ck[16];
+    uint8  ik[16];
+    uint8  ak[6];
+
+    for(N_vecs=1; N_vecs<=MILENAGE_BENCH_BATCH_SIZE; N_vecs++)
+    {
+        fill_batch(seed, N_vecs);
+        liblte_security_milenage_batch(vec, N_vecs);
+        for(i=0; i<N_vecs; i++)
+        {
+            liblte_security_milenage_f1(vec[i].ctx, vec[i].rand, vec[i].sqn, vec[i].amf, mac);
+            liblte_security_milenage_f2345(vec[i].ctx, vec[i].rand, res, ck, ik, ak);
+            if(memcmp(mac, vec[i].mac_a, 8) ||
+               memcmp(res, vec[i].res, 8)   ||
+               memcmp(ck, vec[i].ck, 16)    ||
+               memcmp(ik, vec[i].ik, 16)    ||
+               memcmp(ak, vec[i].ak, 6))
+            {
+                N_fail++;
+            }
+        }
+    }
+    if(N_fail != 0)
+    {
+        printf("Batch does not match single vector generation\n");
+    }
+
+    return(N_fail);
+}
+
+/*********************************************************************
+    Name: run_key_setup
+
+    Description: Generates N_vecs vectors with the K only functions,
+                 which set up the key and OPc for every function, and
+                 returns the rate in vectors per second
+*********************************************************************/
+double run_key_setup(uint32 *seed,
+                     uint32  N_vecs)
+{
+    uint64 start;
+    uint32 i;
+    uint32 j;
+    uint8  mac[8];
+    uint8  res[8];
+    uint8  ck[16];
+    uint8  ik[16];
+    uint8  ak[6];
+
+    fill_batch(seed, MILENAGE_BENCH_BATCH_SIZE);
+    start = liblte_bench_get_time_ns();
+    for(i=0; i<N_vecs; i++)
+    {
+        j = i % MILENAGE_BENCH_BATCH_SIZE;
+        liblte_security_milenage_f1(sub_k[vec[j].ctx - sub_ctx], vec[j].rand, vec[j].sqn, vec[j].amf, mac);
+        liblte_security_milenage_f2345(sub_k[vec[j].ctx - sub_ctx], vec[j].rand, res, ck, ik, ak);
+        vec[j].rand[0] ^= res[0];
+    }
+
+    return((double)N_vecs*1000000000/(double)(liblte_bench_get_time_ns() - start));
+}
+
+/*********************************************************************
+    Name: run_single
+
+    Description: Generates N_vecs vectors one at a time with cached
+                 subscriber contexts and returns the rate in vectors
+                 per second
+*********************************************************************/
+double run_single(uint32 *seed,
+                  uint32  N_vecs)
+{
+    uint64 start;
+    uint32 i;
+    uint32 j;
+    uint8  mac[8];
+    uint8  res[8];
+    uint8  ck[16];
+    uint8  ik[16];
+    uint8  ak[6];
+
+    fill_batch(seed, MILENAGE_BENCH_BATCH_SIZE);
+    start = liblte_bench_get_time_ns();
+    for(i=0; i<N_vecs; i++)
+    {
+        j = i % MILENAGE_BENCH_BATCH_SIZE;
+        liblte_security_milenage_f1(vec[j].ctx, vec[j].rand, vec[j].sqn, vec[j].amf, mac);
+        liblte_security_milenage_f2345(vec[j].ctx, vec[j].rand, res, ck, ik, ak);
+        vec[j].rand[0] ^= res[0];
+    }
+
+    return((double)N_vecs*1000000000/(double)(liblte_bench_get_time_ns() - start));
+}
+
+/*********************************************************************
+    Name: run_batch
+
+    Description: Generates N_vecs vectors in batches with cached
+                 subscriber contexts and returns the rate in vectors
+                 per second
+*********************************************************************/
+double run_batch(uint32 *seed,
+                 uint32  N_vecs)
+{
+    uint64 start;
+    uint32 i;
+
+    fill_batch(seed, MILENAGE_BENCH_BATCH_SIZE);
+    start = liblte_bench_get_time_ns();
+    for(i=0; i<N_vecs; i+=MILENAGE_BENCH_BATCH_SIZE)
+    {
+        liblte_security_milenage_batch(vec, MILENAGE_BENCH_BATCH_SIZE);
+        vec[0].rand[0] ^= vec[0].res[0];
+    }
+
+    return((double)i*1000000000/(double)(liblte_bench_get_time_ns() - start));
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 N_vecs = MILENAGE_BENCH_DEFAULT_N_VECS;
+    uint32 seed   = 1;
+    uint32 N_fail;
+    uint32 i;
+    uint32 j;
+
+    if(argc > 1)
+    {
+        N_vecs = atoi(argv[1]);
+    }
+
+    for(i=0; i<MILENAGE_BENCH_N_SUBSCRIBERS; i++)
+    {
+        for(j=0; j<16; j++)
+        {
+            sub_k[i][j] = liblte_bench_rand(&seed) & 0xFF;
+        }
+        liblte_security_milenage_init(&sub_ctx[i], sub_k[i], NULL);
+    }
+
+    N_fail  = check_test_sets();
+    N_fail += check_batch(&seed);
+    printf("Test sets and batch checks: %s\n", (N_fail == 0) ? "pass" : "FAIL");
+
+    printf("%u vectors per run, %u subscribers, batches of %u vectors\n",
+           N_vecs,
+           MILENAGE_BENCH_N_SUBSCRIBERS,
+           MILENAGE_BENCH_BATCH_SIZE);
+    printf("%-24s %14s\n", "mode", "vectors/s");
+    printf("%-24s %14.0f\n", "key setup per vector", run_key_setup(&seed, N_vecs));
+    printf("%-24s %14.0f\n", "cached context", run_single(&seed, N_vecs));
+    printf("%-24s %14.0f\n", "cached context, batch", run_batch(&seed, N_vecs));
+
+    if(N_fail != 0)
+    {
+        return(1);
+    }
+    return(0);
+}
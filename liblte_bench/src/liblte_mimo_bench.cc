@@ -0,0 +1,300 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_mimo_bench.cc
+
+    Description: Measures the throughput, in resource elements per second,
+                 of the downlink pre-coders and pre-decoders for transmit
+                 diversity, closed loop spatial multiplexing, and large
+                 delay CDD, and checks that each mode recovers its QPSK
+                 layers through a random flat fading channel.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_bench_common.h"
+#include "liblte_phy.h"
+#include <math.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define MIMO_BENCH_DEFAULT_N_ITERATIONS 200
+#define MIMO_BENCH_N_RE                 4800
+#define MIMO_BENCH_BUF_LEN              5000
+#define MIMO_BENCH_COHERENCE_RE         4
+#define MIMO_BENCH_NOISE_VAR            0.0001
+#define MIMO_BENCH_MAX_SYMB_ERR_RATE    0.001
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef struct{
+    const char                     *name;
+    LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type;
+    uint8                           N_ant;
+    uint8                           N_rx;
+    uint32                          N_layers;
+    uint32                          codebook_idx;
+}MIMO_BENCH_MODE_STRUCT;
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+MIMO_BENCH_MODE_STRUCT modes[] = {{"TXD",     LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,         1, 1, 1, 0},
+                                  {"TXD",     LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,         2, 1, 2, 0},
+                                  {"TXD",     LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,         2, 2, 2, 0},
+                                  {"TXD",     LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,         4, 2, 4, 0},
+                                  {"TM4",     LIBLTE_PHY_PRE_CODER_TYPE_SPATIAL_MULTIPLEXING, 2, 2, 1, 0},
+                                  {"TM4",     LIBLTE_PHY_PRE_CODER_TYPE_SPATIAL_MULTIPLEXING, 2, 2, 2, 1},
+                                  {"TM4",     LIBLTE_PHY_PRE_CODER_TYPE_SPATIAL_MULTIPLEXING, 4, 4, 1, 0},
+                                  {"TM4",     LIBLTE_PHY_PRE_CODER_TYPE_SPATIAL_MULTIPLEXING, 4, 4, 2, 0},
+                                  {"TM4",     LIBLTE_PHY_PRE_CODER_TYPE_SPATIAL_MULTIPLEXING, 4, 4, 3, 0},
+                                  {"TM4",     LIBLTE_PHY_PRE_CODER_TYPE_SPATIAL_MULTIPLEXING, 4, 4, 4, 0},
+                                  {"TM3 CDD", LIBLTE_PHY_PRE_CODER_TYPE_LARGE_DELAY_CDD,      2, 2, 2, 0},
+                                  {"TM3 CDD", LIBLTE_PHY_PRE_CODER_TYPE_LARGE_DELAY_CDD,      4, 4, 2, 0},
+                                  {"TM3 CDD", LIBLTE_PHY_PRE_CODER_TYPE_LARGE_DELAY_CDD,      4, 4, 3, 0},
+                                  {"TM3 CDD", LIBLTE_PHY_PRE_CODER_TYPE_LARGE_DELAY_CDD,      4, 4, 4, 0}};
+
+float x_re[LIBLTE_PHY_N_ANT_MAX*MIMO_BENCH_BUF_LEN];
+float x_im[LIBLTE_PHY_N_ANT_MAX*MIMO_BENCH_BUF_LEN];
+float tx_re[LIBLTE_PHY_N_ANT_MAX*MIMO_BENCH_BUF_LEN];
+float tx_im[LIBLTE_PHY_N_ANT_MAX*MIMO_BENCH_BUF_LEN];
+float rx_re[LIBLTE_PHY_N_RX_ANT_MAX*MIMO_BENCH_BUF_LEN];
+float rx_im[LIBLTE_PHY_N_RX_ANT_MAX*MIMO_BENCH_BUF_LEN];
+float h_re[LIBLTE_PHY_N_RX_ANT_MAX*LIBLTE_PHY_N_ANT_MAX*MIMO_BENCH_BUF_LEN];
+float h_im[LIBLTE_PHY_N_RX_ANT_MAX*LIBLTE_PHY_N_ANT_MAX*MIMO_BENCH_BUF_LEN];
+float noise_var[MIMO_BENCH_BUF_LEN];
+float x_est_re[LIBLTE_PHY_N_ANT_MAX*MIMO_BENCH_BUF_LEN];
+float x_est_im[LIBLTE_PHY_N_ANT_MAX*MIMO_BENCH_BUF_LEN];
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: random_gauss
+
+    Description: Returns a zero mean, unit variance gaussian sample
+*********************************************************************/
+float random_gauss(uint32 *seed)
+{
+    float u1 = ((float)(liblte_bench_rand(seed) >> 8) + 1) / 16777217.0;
+    float u2 = ((float)(liblte_bench_rand(seed) >> 8) + 1) / 16777217.0;
+
+    return(sqrt(-2*log(u1))*cos(2*M_PI*u2));
+}
+
+/*********************************************************************
+    Name: apply_channel
+
+    Description: Passes the antenna port symbols through a random flat
+                 fading channel and adds white gaussian noise.  The
+                 channel is held for MIMO_BENCH_COHERENCE_RE resource
+                 elements so that the transmit diversity pairs and
+                 quads see the same channel.
+*********************************************************************/
+void apply_channel(uint32                 *seed,
+                   MIMO_BENCH_MODE_STRUCT *mode,
+                   uint32                  M_ap_symb)
+{
+    float  sd = sqrt(MIMO_BENCH_NOISE_VAR/2);
+    uint32 h_idx;
+    uint32 i;
+    uint32 r;
+    uint32 p;
+
+    for(r=0; r<mode->N_rx; r++)
+    {
+        for(i=0; i<M_ap_symb; i++)
+        {
+            rx_re[r*MIMO_BENCH_BUF_LEN+i] = sd*random_gauss(seed);
+            rx_im[r*MIMO_BENCH_BUF_LEN+i] = sd*random_gauss(seed);
+        }
+        for(p=0; p<mode->N_ant; p++)
+        {
+            h_idx = (r*LIBLTE_PHY_N_ANT_MAX+p)*MIMO_BENCH_BUF_LEN;
+            for(i=0; i<M_ap_symb; i++)
+            {
+                if(0 == (i % MIMO_BENCH_COHERENCE_RE))
+                {
+                    h_re[h_idx+i] = random_gauss(seed)/sqrt(2);
+                    h_im[h_idx+i] = random_gauss(seed)/sqrt(2);
+                }else{
+                    h_re[h_idx+i] = h_re[h_idx+i-1];
+                    h_im[h_idx+i] = h_im[h_idx+i-1];
+                }
+                rx_re[r*MIMO_BENCH_BUF_LEN+i] += (h_re[h_idx+i]*tx_re[p*MIMO_BENCH_BUF_LEN+i] -
+                                                  h_im[h_idx+i]*tx_im[p*MIMO_BENCH_BUF_LEN+i]);
+                rx_im[r*MIMO_BENCH_BUF_LEN+i] += (h_re[h_idx+i]*tx_im[p*MIMO_BENCH_BUF_LEN+i] +
+                                                  h_im[h_idx+i]*tx_re[p*MIMO_BENCH_BUF_LEN+i]);
+            }
+        }
+    }
+    for(i=0; i<M_ap_symb; i++)
+    {
+        noise_var[i] = MIMO_BENCH_NOISE_VAR;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    LIBLTE_PHY_STRUCT      *phy_struct;
+    MIMO_BENCH_MODE_STRUCT *mode;
+    uint64                  start;
+    uint64                  stop;
+    float                   code_mres;
+    float                   decode_mres;
+    float                   err_rate;
+    uint32                  N_iterations = MIMO_BENCH_DEFAULT_N_ITERATIONS;
+    uint32                  seed         = 1;
+    uint32                  M_layer_symb;
+    uint32                  M_ap_symb;
+    uint32                  M_layer_est;
+    uint32                  N_symb_err;
+    uint32                  N_fail       = 0;
+    uint32                  i;
+    uint32                  j;
+
+    if(argc > 1)
+    {
+        N_iterations = atoi(argv[1]);
+    }
+
+    liblte_phy_init(&phy_struct,
+                    LIBLTE_PHY_FS_1_92MHZ,
+                    LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN,
+                    4,
+                    LIBLTE_PHY_N_RB_DL_1_4MHZ,
+                    LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
+                    1);
+
+    printf("%-8s %3s %3s %6s %3s %16s %18s %10s %6s\n",
+           "mode", "tx", "rx", "layers", "cb", "pre-code (MRE/s)", "pre-decode (MRE/s)", "symb err", "pass");
+    for(i=0; i<sizeof(modes)/sizeof(modes[0]); i++)
+    {
+        mode = &modes[i];
+
+        // Transmit diversity spreads the layers over the antenna ports,
+        // the other pre-coders send every layer on every resource element
+        if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY == mode->type)
+        {
+            M_layer_symb = MIMO_BENCH_N_RE/mode->N_ant;
+        }else{
+            M_layer_symb = MIMO_BENCH_N_RE;
+        }
+        for(j=0; j<mode->N_layers*M_layer_symb; j++)
+        {
+            x_re[j] = (liblte_bench_rand(&seed) & 1) ? -M_SQRT1_2 : M_SQRT1_2;
+            x_im[j] = (liblte_bench_rand(&seed) & 1) ? -M_SQRT1_2 : M_SQRT1_2;
+        }
+
+        start = liblte_bench_get_time_ns();
+        for(j=0; j<N_iterations; j++)
+        {
+            liblte_phy_dl_pre_code(phy_struct,
+                                   mode->type,
+                                   x_re,
+                                   x_im,
+                                   M_layer_symb,
+                                   mode->N_ant,
+                                   mode->N_layers,
+                                   mode->codebook_idx,
+                                   tx_re,
+                                   tx_im,
+                                   MIMO_BENCH_BUF_LEN,
+                                   &M_ap_symb);
+        }
+        stop      = liblte_bench_get_time_ns();
+        code_mres = (float)M_ap_symb*N_iterations*1000/(float)(stop - start);
+
+        apply_channel(&seed, mode, M_ap_symb);
+
+        start = liblte_bench_get_time_ns();
+        for(j=0; j<N_iterations; j++)
+        {
+            liblte_phy_dl_pre_decode(phy_struct,
+                                     mode->type,
+                                     rx_re,
+                                     rx_im,
+                                     MIMO_BENCH_BUF_LEN,
+                                     h_re,
+                                     h_im,
+                                     MIMO_BENCH_BUF_LEN,
+                                     noise_var,
+                                     M_ap_symb,
+                                     mode->N_rx,
+                                     mode->N_ant,
+                                     mode->N_layers,
+                                     mode->codebook_idx,
+                                     x_est_re,
+                                     x_est_im,
+                                     &M_layer_est);
+        }
+        stop        = liblte_bench_get_time_ns();
+        decode_mres = (float)M_ap_symb*N_iterations*1000/(float)(stop - start);
+
+        // Count the QPSK symbols that land in the wrong quadrant
+        N_symb_err = 0;
+        for(j=0; j<mode->N_layers*M_layer_symb; j++)
+        {
+            if((x_est_re[j] < 0) != (x_re[j] < 0) ||
+               (x_est_im[j] < 0) != (x_im[j] < 0))
+            {
+                N_symb_err++;
+            }
+        }
+        err_rate = (float)N_symb_err/(float)(mode->N_layers*M_layer_symb);
+        if(M_layer_est != M_layer_symb ||
+           err_rate    >  MIMO_BENCH_MAX_SYMB_ERR_RATE)
+        {
+            N_fail++;
+        }
+
+        printf("%-8s %3u %3u %6u %3u %16.2f %18.2f %10.5f %6s\n",
+               mode->name,
+               mode->N_ant,
+               mode->N_rx,
+               mode->N_layers,
+               mode->codebook_idx,
+               code_mres,
+               decode_mres,
+               err_rate,
+               (M_layer_est == M_layer_symb && err_rate <= MIMO_BENCH_MAX_SYMB_ERR_RATE) ? "yes" : "NO");
+    }
+
+    liblte_phy_cleanup(phy_struct);
+
+    if(0 != N_fail)
+    {
+        printf("%u modes did not recover their layers\n", N_fail);
+        return(1);
+    }
+    return(0);
+}
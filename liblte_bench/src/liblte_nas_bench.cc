@@ -0,0 +1,603 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_nas_bench.cc
+
+    Description: Decodes the uplink NAS messages of an attach and a
+                 service request through the liblte_mme unpack
+                 functions, the way the eNodeB does, and builds the
+                 Attach Accept both through the pack functions and
+                 through the NAS message builder.  Checks that each
+                 uplink message decodes, that the messages the eNodeB
+                 validates are rejected once truncated by a byte, and
+                 that both Attach Accept paths produce the same bytes.
+                 Reports the time per message along with the decoder
+                 state each path fills in per message.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_bench_common.h"
+#include "liblte_mme.h"
+#include "liblte_security.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define NAS_BENCH_DEFAULT_N_MSGS 200000
+#define NAS_BENCH_IMSI           1010123456789ULL
+#define NAS_BENCH_COUNT          3
+#define NAS_BENCH_RB_ID          0
+#define NAS_BENCH_EBI            5
+#define NAS_BENCH_PTI            1
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef enum{
+    NAS_BENCH_MSG_ATTACH_REQUEST = 0,
+    NAS_BENCH_MSG_AUTHENTICATION_RESPONSE,
+    NAS_BENCH_MSG_SECURITY_MODE_COMPLETE,
+    NAS_BENCH_MSG_ATTACH_COMPLETE,
+    NAS_BENCH_MSG_SERVICE_REQUEST,
+    NAS_BENCH_MSG_N_ITEMS,
+}NAS_BENCH_MSG_ENUM;
+static const char nas_bench_msg_text[NAS_BENCH_MSG_N_ITEMS][30] = {"Attach Request",
+                                                                   "Authentication Response",
+                                                                   "Security Mode Complete",
+                                                                   "Attach Complete",
+                                                                   "Service Request"};
+// The messages the eNodeB rejects when their IEs overrun the message
+static const bool nas_bench_msg_validated[NAS_BENCH_MSG_N_ITEMS] = {true,
+                                                                    true,
+                                                                    false,
+                                                                    false,
+                                                                    true};
+
+typedef struct{
+    uint64 ns;
+    uint32 state_bytes;
+    uint32 N_msg_bytes;
+    bool   decoded;
+    bool   truncated_rejected;
+}NAS_BENCH_DECODE_RESULT_STRUCT;
+
+typedef struct{
+    uint64 struct_ns;
+    uint64 builder_ns;
+    uint32 struct_state_bytes;
+    uint32 builder_state_bytes;
+    uint32 N_msg_bytes;
+    bool   match;
+}NAS_BENCH_BUILD_RESULT_STRUCT;
+
+// The fields the eNodeB keeps from each uplink message
+typedef struct{
+    LIBLTE_MME_EPS_MOBILE_ID_STRUCT eps_mobile_id;
+    uint32                          N_pco_opts;
+    uint8                           eps_attach_type;
+    uint8                           ue_eea;
+    uint8                           ms_gea;
+    uint8                           pdn_type;
+    uint8                           eps_bearer_id;
+    uint8                           proc_transaction_id;
+    uint8                           res[8];
+    uint8                           ksi;
+    uint8                           seq_num;
+    bool                            imeisv_present;
+}NAS_BENCH_DECODED_STRUCT;
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+static LIBLTE_BYTE_MSG_STRUCT nas_bench_msg[NAS_BENCH_MSG_N_ITEMS];
+static uint8                  nas_bench_key[32];
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: nas_bench_build_corpus
+
+    Description: Packs the uplink messages of an attach and a service
+                 request the way a UE sends them
+*********************************************************************/
+void nas_bench_build_corpus(void)
+{
+    LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT                              attach_req;
+    LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT                    pdn_con_req;
+    LIBLTE_MME_AUTHENTICATION_RESPONSE_MSG_STRUCT                     auth_resp;
+    LIBLTE_MME_SECURITY_MODE_COMPLETE_MSG_STRUCT                      sec_mode_comp;
+    LIBLTE_MME_ATTACH_COMPLETE_MSG_STRUCT                             attach_comp;
+    LIBLTE_MME_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_ACCEPT_MSG_STRUCT  act_def_eps_bearer_context_accept;
+    LIBLTE_MME_SERVICE_REQUEST_MSG_STRUCT                             service_req;
+    LIBLTE_MME_PROTOCOL_CONFIG_OPTIONS_STRUCT                        *pco = &pdn_con_req.protocol_cnfg_opts;
+    uint64                                                            imsi = NAS_BENCH_IMSI;
+    uint32                                                            seed = 1;
+    uint32                                                            i;
+
+    for(i=0; i<32; i++)
+    {
+        nas_bench_key[i] = liblte_bench_rand(&seed) & 0xFF;
+    }
+
+    // Attach Request carrying a PDN Connectivity Request with an
+    // IPCP DNS request and an IPv4 DNS server address request
+    pdn_con_req.eps_bearer_id                  = 0;
+    pdn_con_req.proc_transaction_id            = NAS_BENCH_PTI;
+    pdn_con_req.pdn_type                       = LIBLTE_MME_PDN_TYPE_IPV4V6;
+    pdn_con_req.request_type                   = LIBLTE_MME_REQUEST_TYPE_INITIAL_REQUEST;
+    pdn_con_req.esm_info_transfer_flag_present = false;
+    pdn_con_req.apn_present                    = false;
+    pdn_con_req.protocol_cnfg_opts_present     = true;
+    pdn_con_req.device_properties_present      = false;
+    pco->N_opts                                = 2;
+    pco->opt[0].id                             = LIBLTE_MME_CONFIGURATION_PROTOCOL_OPTIONS_IPCP;
+    pco->opt[0].len                            = 16;
+    memset(pco->opt[0].contents, 0, 16);
+    pco->opt[0].contents[0]                    = 0x01;
+    pco->opt[0].contents[1]                    = 0x00;
+    pco->opt[0].contents[3]                    = 0x10;
+    pco->opt[0].contents[4]                    = 0x81;
+    pco->opt[0].contents[5]                    = 0x06;
+    pco->opt[0].contents[10]                   = 0x83;
+    pco->opt[0].contents[11]                   = 0x06;
+    pco->opt[1].id                             = LIBLTE_MME_ADDITIONAL_PARAMETERS_UL_DNS_SERVER_IPV4_ADDRESS_REQUEST;
+    pco->opt[1].len                            = 0;
+    memset(&attach_req, 0, sizeof(attach_req));
+    liblte_mme_pack_pdn_connectivity_request_msg(&pdn_con_req, &attach_req.esm_msg);
+    attach_req.eps_attach_type          = LIBLTE_MME_EPS_ATTACH_TYPE_EPS_ATTACH;
+    attach_req.nas_ksi.tsc_flag         = LIBLTE_MME_TYPE_OF_SECURITY_CONTEXT_FLAG_NATIVE;
+    attach_req.nas_ksi.nas_ksi          = 7;
+    attach_req.eps_mobile_id.type_of_id = LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI;
+    for(i=0; i<15; i++)
+    {
+        attach_req.eps_mobile_id.imsi[14-i] = imsi % 10;
+        imsi                               /= 10;
+    }
+    attach_req.ue_network_cap.eea[0]      = true;
+    attach_req.ue_network_cap.eea[1]      = true;
+    attach_req.ue_network_cap.eea[2]      = true;
+    attach_req.ue_network_cap.eia[1]      = true;
+    attach_req.ue_network_cap.eia[2]      = true;
+    attach_req.drx_param_present          = true;
+    attach_req.drx_param.non_drx_timer    = LIBLTE_MME_NON_DRX_TIMER_NO_NON_DRX_MODE;
+    attach_req.ms_network_cap_present     = true;
+    attach_req.ms_network_cap.gea[1]      = true;
+    attach_req.ms_network_cap.gea[2]      = true;
+    attach_req.ms_network_cap.ucs2        = true;
+    attach_req.ms_network_cap.emm_comb    = true;
+    attach_req.ms_network_cap.isr         = true;
+    attach_req.ms_network_cap.epc         = true;
+    liblte_mme_pack_attach_request_msg(&attach_req, &nas_bench_msg[NAS_BENCH_MSG_ATTACH_REQUEST]);
+
+    // Authentication Response
+    for(i=0; i<8; i++)
+    {
+        auth_resp.res[i] = liblte_bench_rand(&seed) & 0xFF;
+    }
+    liblte_mme_pack_authentication_response_msg(&auth_resp, &nas_bench_msg[NAS_BENCH_MSG_AUTHENTICATION_RESPONSE]);
+
+    // Security Mode Complete
+    sec_mode_comp.imeisv_present = false;
+    liblte_mme_pack_security_mode_complete_msg(&sec_mode_comp,
+                                               LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED_WITH_NEW_EPS_SECURITY_CONTEXT,
+                                               nas_bench_key,
+                                               NAS_BENCH_COUNT,
+                                               LIBLTE_SECURITY_DIRECTION_UPLINK,
+                                               NAS_BENCH_RB_ID,
+                                               &nas_bench_msg[NAS_BENCH_MSG_SECURITY_MODE_COMPLETE]);
+
+    // Attach Complete carrying an Activate Default EPS Bearer Context Accept
+    act_def_eps_bearer_context_accept.eps_bearer_id              = NAS_BENCH_EBI;
+    act_def_eps_bearer_context_accept.proc_transaction_id        = NAS_BENCH_PTI;
+    act_def_eps_bearer_context_accept.protocol_cnfg_opts_present = false;
+    liblte_mme_pack_activate_default_eps_bearer_context_accept_msg(&act_def_eps_bearer_context_accept,
+                                                                   &attach_comp.esm_msg);
+    liblte_mme_pack_attach_complete_msg(&attach_comp,
+                                        LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED,
+                                        nas_bench_key,
+                                        NAS_BENCH_COUNT,
+                                        LIBLTE_SECURITY_DIRECTION_UPLINK,
+                                        NAS_BENCH_RB_ID,
+                                        &nas_bench_msg[NAS_BENCH_MSG_ATTACH_COMPLETE]);
+
+    // Service Request
+    service_req.ksi_and_seq_num.ksi     = 1;
+    service_req.ksi_and_seq_num.seq_num = 17;
+    service_req.short_mac               = 0xBEEF;
+    liblte_mme_pack_service_request_msg(&service_req, &nas_bench_msg[NAS_BENCH_MSG_SERVICE_REQUEST]);
+}
+
+/*********************************************************************
+    Name: nas_bench_decode
+
+    Description: Decodes an uplink message through the unpack
+                 functions, the way the eNodeB does
+*********************************************************************/
+LIBLTE_ERROR_ENUM nas_bench_decode(NAS_BENCH_MSG_ENUM        msg_idx,
+                                   LIBLTE_BYTE_MSG_STRUCT   *msg,
+                                   NAS_BENCH_DECODED_STRUCT *decoded,
+                                   uint32                   *state_bytes)
+{
+    LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT                              attach_req;
+    LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT                    pdn_con_req;
+    LIBLTE_MME_AUTHENTICATION_RESPONSE_MSG_STRUCT                     auth_resp;
+    LIBLTE_MME_SECURITY_MODE_COMPLETE_MSG_STRUCT                      sec_mode_comp;
+    LIBLTE_MME_ATTACH_COMPLETE_MSG_STRUCT                             attach_comp;
+    LIBLTE_MME_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_ACCEPT_MSG_STRUCT  act_def_eps_bearer_context_accept;
+    LIBLTE_MME_SERVICE_REQUEST_MSG_STRUCT                             service_req;
+    LIBLTE_ERROR_ENUM                                                 err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    switch(msg_idx)
+    {
+    case NAS_BENCH_MSG_ATTACH_REQUEST:
+        err = liblte_mme_unpack_attach_request_msg(msg, &attach_req);
+        if(LIBLTE_SUCCESS == err)
+        {
+            err = liblte_mme_unpack_pdn_connectivity_request_msg(&attach_req.esm_msg, &pdn_con_req);
+        }
+        if(LIBLTE_SUCCESS == err)
+        {
+            decoded->eps_attach_type     = attach_req.eps_attach_type;
+            decoded->eps_mobile_id       = attach_req.eps_mobile_id;
+            decoded->ue_eea              = attach_req.ue_network_cap.eea[1];
+            decoded->ms_gea              = attach_req.ms_network_cap.gea[1];
+            decoded->pdn_type            = pdn_con_req.pdn_type;
+            decoded->eps_bearer_id       = pdn_con_req.eps_bearer_id;
+            decoded->proc_transaction_id = pdn_con_req.proc_transaction_id;
+            decoded->N_pco_opts          = pdn_con_req.protocol_cnfg_opts.N_opts;
+        }
+        *state_bytes = sizeof(attach_req) + sizeof(pdn_con_req);
+        break;
+    case NAS_BENCH_MSG_AUTHENTICATION_RESPONSE:
+        err = liblte_mme_unpack_authentication_response_msg(msg, &auth_resp);
+        memcpy(decoded->res, auth_resp.res, 8);
+        *state_bytes = sizeof(auth_resp);
+        break;
+    case NAS_BENCH_MSG_SECURITY_MODE_COMPLETE:
+        err                     = liblte_mme_unpack_security_mode_complete_msg(msg, &sec_mode_comp);
+        decoded->imeisv_present = sec_mode_comp.imeisv_present;
+        *state_bytes            = sizeof(sec_mode_comp);
+        break;
+    case NAS_BENCH_MSG_ATTACH_COMPLETE:
+        err = liblte_mme_unpack_attach_complete_msg(msg, &attach_comp);
+        if(LIBLTE_SUCCESS == err)
+        {
+            err = liblte_mme_unpack_activate_default_eps_bearer_context_accept_msg(&attach_comp.esm_msg,
+                                                                                   &act_def_eps_bearer_context_accept);
+        }
+        decoded->eps_bearer_id = act_def_eps_bearer_context_accept.eps_bearer_id;
+        *state_bytes           = sizeof(attach_comp) + sizeof(act_def_eps_bearer_context_accept);
+        break;
+    case NAS_BENCH_MSG_SERVICE_REQUEST:
+        err              = liblte_mme_unpack_service_request_msg(msg, &service_req);
+        decoded->ksi     = service_req.ksi_and_seq_num.ksi;
+        decoded->seq_num = service_req.ksi_and_seq_num.seq_num;
+        *state_bytes     = sizeof(service_req);
+        break;
+    default:
+        break;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: nas_bench_build_struct
+
+    Description: Packs the Attach Accept through the message structs,
+                 the way the eNodeB used to
+*********************************************************************/
+void nas_bench_build_struct(uint32                  m_tmsi,
+                            LIBLTE_BYTE_MSG_STRUCT *msg,
+                            uint32                 *state_bytes)
+{
+    LIBLTE_MME_ATTACH_ACCEPT_MSG_STRUCT                               attach_accept;
+    LIBLTE_MME_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_MSG_STRUCT act_def_eps_bearer_context_req;
+
+    act_def_eps_bearer_context_req.eps_bearer_id              = NAS_BENCH_EBI;
+    act_def_eps_bearer_context_req.proc_transaction_id        = NAS_BENCH_PTI;
+    act_def_eps_bearer_context_req.eps_qos.qci                = 9;
+    act_def_eps_bearer_context_req.eps_qos.br_present         = false;
+    act_def_eps_bearer_context_req.eps_qos.br_ext_present     = false;
+    act_def_eps_bearer_context_req.apn.apn                    = "www.openLTE.com";
+    act_def_eps_bearer_context_req.pdn_addr.pdn_type          = LIBLTE_MME_PDN_TYPE_IPV4;
+    act_def_eps_bearer_context_req.pdn_addr.addr[0]           = 192;
+    act_def_eps_bearer_context_req.pdn_addr.addr[1]           = 168;
+    act_def_eps_bearer_context_req.pdn_addr.addr[2]           = 0;
+    act_def_eps_bearer_context_req.pdn_addr.addr[3]           = 2;
+    act_def_eps_bearer_context_req.transaction_id_present     = false;
+    act_def_eps_bearer_context_req.negotiated_qos_present     = false;
+    act_def_eps_bearer_context_req.llc_sapi_present           = false;
+    act_def_eps_bearer_context_req.radio_prio_present         = false;
+    act_def_eps_bearer_context_req.packet_flow_id_present     = false;
+    act_def_eps_bearer_context_req.apn_ambr_present           = false;
+    act_def_eps_bearer_context_req.esm_cause_present          = true;
+    act_def_eps_bearer_context_req.esm_cause                  = LIBLTE_MME_ESM_CAUSE_PDN_TYPE_IPV4_ONLY_ALLOWED;
+    act_def_eps_bearer_context_req.protocol_cnfg_opts_present = false;
+    act_def_eps_bearer_context_req.connectivity_type_present  = false;
+    liblte_mme_pack_activate_default_eps_bearer_context_request_msg(&act_def_eps_bearer_context_req,
+                                                                    &attach_accept.esm_msg);
+
+    attach_accept.eps_attach_result                   = LIBLTE_MME_EPS_ATTACH_RESULT_EPS_ONLY;
+    attach_accept.t3412.unit                          = LIBLTE_MME_GPRS_TIMER_DEACTIVATED;
+    attach_accept.t3412.value                         = 0;
+    attach_accept.tai_list.N_tais                     = 1;
+    attach_accept.tai_list.tai[0].mcc                 = 0xF001;
+    attach_accept.tai_list.tai[0].mnc                 = 0xFF01;
+    attach_accept.tai_list.tai[0].tac                 = 1;
+    attach_accept.guti_present                        = true;
+    attach_accept.guti.type_of_id                     = LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI;
+    attach_accept.guti.guti.mcc                       = 0xF001;
+    attach_accept.guti.guti.mnc                       = 0xFF01;
+    attach_accept.guti.guti.mme_group_id              = 0;
+    attach_accept.guti.guti.mme_code                  = 0;
+    attach_accept.guti.guti.m_tmsi                    = m_tmsi;
+    attach_accept.lai_present                         = false;
+    attach_accept.ms_id_present                       = false;
+    attach_accept.emm_cause_present                   = false;
+    attach_accept.t3402_present                       = false;
+    attach_accept.t3423_present                       = false;
+    attach_accept.equivalent_plmns_present            = false;
+    attach_accept.emerg_num_list_present              = false;
+    attach_accept.eps_network_feature_support_present = false;
+    attach_accept.additional_update_result_present    = false;
+    attach_accept.t3412_ext_present                   = false;
+    liblte_mme_pack_attach_accept_msg(&attach_accept,
+                                      LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED,
+                                      nas_bench_key,
+                                      NAS_BENCH_COUNT,
+                                      LIBLTE_SECURITY_DIRECTION_DOWNLINK,
+                                      NAS_BENCH_RB_ID,
+                                      msg);
+
+    *state_bytes = sizeof(attach_accept) + sizeof(act_def_eps_bearer_context_req);
+}
+
+/*********************************************************************
+    Name: nas_bench_build_builder
+
+    Description: Builds the Attach Accept directly into the output
+                 message, the way the eNodeB does now
+*********************************************************************/
+void nas_bench_build_builder(uint32                  m_tmsi,
+                             LIBLTE_BYTE_MSG_STRUCT *msg,
+                             uint32                 *state_bytes)
+{
+    LIBLTE_MME_NAS_BUILDER_STRUCT                 builder;
+    LIBLTE_MME_GPRS_TIMER_STRUCT                  t3412;
+    LIBLTE_MME_TRACKING_AREA_IDENTITY_LIST_STRUCT tai_list;
+    LIBLTE_MME_EPS_QUALITY_OF_SERVICE_STRUCT      eps_qos;
+    LIBLTE_MME_ACCESS_POINT_NAME_STRUCT           apn;
+    LIBLTE_MME_PDN_ADDRESS_STRUCT                 pdn_addr;
+    LIBLTE_MME_EPS_MOBILE_ID_STRUCT               guti;
+
+    liblte_mme_nas_builder_start(msg,
+                                 LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED,
+                                 NAS_BENCH_COUNT,
+                                 &builder);
+    liblte_mme_nas_builder_add_emm_header(&builder, LIBLTE_MME_MSG_TYPE_ATTACH_ACCEPT);
+    *builder.msg_ptr = 0;
+    liblte_mme_pack_eps_attach_result_ie(LIBLTE_MME_EPS_ATTACH_RESULT_EPS_ONLY, 0, &builder.msg_ptr);
+    builder.msg_ptr++;
+    t3412.unit  = LIBLTE_MME_GPRS_TIMER_DEACTIVATED;
+    t3412.value = 0;
+    liblte_mme_pack_gprs_timer_ie(&t3412, &builder.msg_ptr);
+    tai_list.N_tais     = 1;
+    tai_list.tai[0].mcc = 0xF001;
+    tai_list.tai[0].mnc = 0xFF01;
+    tai_list.tai[0].tac = 1;
+    liblte_mme_pack_tracking_area_identity_list_ie(&tai_list, &builder.msg_ptr);
+
+    liblte_mme_nas_builder_open_esm_msg_container(&builder);
+    liblte_mme_nas_builder_add_esm_header(&builder,
+                                          NAS_BENCH_EBI,
+                                          NAS_BENCH_PTI,
+                                          LIBLTE_MME_MSG_TYPE_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST);
+    eps_qos.qci            = 9;
+    eps_qos.br_present     = false;
+    eps_qos.br_ext_present = false;
+    liblte_mme_pack_eps_quality_of_service_ie(&eps_qos, &builder.msg_ptr);
+    apn.apn = "www.openLTE.com";
+    liblte_mme_pack_access_point_name_ie(&apn, &builder.msg_ptr);
+    pdn_addr.pdn_type = LIBLTE_MME_PDN_TYPE_IPV4;
+    pdn_addr.addr[0]  = 192;
+    pdn_addr.addr[1]  = 168;
+    pdn_addr.addr[2]  = 0;
+    pdn_addr.addr[3]  = 2;
+    liblte_mme_pack_pdn_address_ie(&pdn_addr, &builder.msg_ptr);
+    liblte_mme_nas_builder_add_iei(&builder, LIBLTE_MME_ESM_CAUSE_IEI);
+    liblte_mme_pack_esm_cause_ie(LIBLTE_MME_ESM_CAUSE_PDN_TYPE_IPV4_ONLY_ALLOWED, &builder.msg_ptr);
+    liblte_mme_nas_builder_close_esm_msg_container(&builder);
+
+    guti.type_of_id        = LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI;
+    guti.guti.mcc          = 0xF001;
+    guti.guti.mnc          = 0xFF01;
+    guti.guti.mme_group_id = 0;
+    guti.guti.mme_code     = 0;
+    guti.guti.m_tmsi       = m_tmsi;
+    liblte_mme_nas_builder_add_iei(&builder, LIBLTE_MME_GUTI_IEI);
+    liblte_mme_pack_eps_mobile_id_ie(&guti, &builder.msg_ptr);
+
+    liblte_mme_nas_builder_finish(&builder,
+                                  nas_bench_key,
+                                  NAS_BENCH_COUNT,
+                                  LIBLTE_SECURITY_DIRECTION_DOWNLINK,
+                                  NAS_BENCH_RB_ID);
+
+    *state_bytes = (sizeof(builder) + sizeof(t3412) + sizeof(tai_list) + sizeof(eps_qos) +
+                    sizeof(apn) + sizeof(pdn_addr) + sizeof(guti));
+}
+
+/*********************************************************************
+    Name: nas_bench_run_decode
+
+    Description: Times the decoder on one uplink message and checks
+                 that the message decodes and, when the eNodeB
+                 validates it, that a copy truncated by a byte is
+                 rejected
+*********************************************************************/
+void nas_bench_run_decode(NAS_BENCH_MSG_ENUM              msg_idx,
+                          uint32                          N_msgs,
+                          NAS_BENCH_DECODE_RESULT_STRUCT *result)
+{
+    LIBLTE_BYTE_MSG_STRUCT   truncated_msg;
+    NAS_BENCH_DECODED_STRUCT decoded;
+    uint64                   start;
+    uint32                   i;
+
+    memset(&decoded, 0, sizeof(decoded));
+    result->decoded     = (LIBLTE_SUCCESS == nas_bench_decode(msg_idx,
+                                                              &nas_bench_msg[msg_idx],
+                                                              &decoded,
+                                                              &result->state_bytes));
+    result->N_msg_bytes = nas_bench_msg[msg_idx].N_bytes;
+
+    truncated_msg = nas_bench_msg[msg_idx];
+    truncated_msg.N_bytes--;
+    result->truncated_rejected = (LIBLTE_ERROR_DECODE_FAIL == nas_bench_decode(msg_idx,
+                                                                               &truncated_msg,
+                                                                               &decoded,
+                                                                               &result->state_bytes));
+
+    start = liblte_bench_get_time_ns();
+    for(i=0; i<N_msgs; i++)
+    {
+        nas_bench_decode(msg_idx, &nas_bench_msg[msg_idx], &decoded, &result->state_bytes);
+    }
+    result->ns = liblte_bench_get_time_ns() - start;
+}
+
+/*********************************************************************
+    Name: nas_bench_run_build
+
+    Description: Times both encoders on the Attach Accept and checks
+                 that they produce the same bytes
+*********************************************************************/
+void nas_bench_run_build(uint32                         N_msgs,
+                         NAS_BENCH_BUILD_RESULT_STRUCT *result)
+{
+    LIBLTE_BYTE_MSG_STRUCT struct_msg;
+    LIBLTE_BYTE_MSG_STRUCT builder_msg;
+    uint64                 start;
+    uint32                 i;
+
+    nas_bench_build_struct(0x12345678, &struct_msg, &result->struct_state_bytes);
+    nas_bench_build_builder(0x12345678, &builder_msg, &result->builder_state_bytes);
+    result->match       = (struct_msg.N_bytes == builder_msg.N_bytes &&
+                           0 == memcmp(struct_msg.msg, builder_msg.msg, struct_msg.N_bytes));
+    result->N_msg_bytes = builder_msg.N_bytes;
+
+    start = liblte_bench_get_time_ns();
+    for(i=0; i<N_msgs; i++)
+    {
+        nas_bench_build_struct(i, &struct_msg, &result->struct_state_bytes);
+    }
+    result->struct_ns = liblte_bench_get_time_ns() - start;
+
+    start = liblte_bench_get_time_ns();
+    for(i=0; i<N_msgs; i++)
+    {
+        nas_bench_build_builder(i, &builder_msg, &result->builder_state_bytes);
+    }
+    result->builder_ns = liblte_bench_get_time_ns() - start;
+}
+
+/*********************************************************************
+    Name: main
+
+    Description: Runs the benchmark.  The optional argument is the
+                 number of times each message is decoded or built.
+*********************************************************************/
+int main(int argc, char *argv[])
+{
+    NAS_BENCH_DECODE_RESULT_STRUCT result[NAS_BENCH_MSG_N_ITEMS];
+    NAS_BENCH_BUILD_RESULT_STRUCT  build_result;
+    uint64                         state_bytes = 0;
+    uint32                         N_msgs      = NAS_BENCH_DEFAULT_N_MSGS;
+    uint32                         i;
+    bool                           all_pass    = true;
+    bool                           pass;
+
+    if(argc > 1)
+    {
+        N_msgs = strtoul(argv[1], NULL, 10);
+    }
+
+    nas_bench_build_corpus();
+    for(i=0; i<NAS_BENCH_MSG_N_ITEMS; i++)
+    {
+        nas_bench_run_decode((NAS_BENCH_MSG_ENUM)i, N_msgs, &result[i]);
+    }
+    nas_bench_run_build(N_msgs, &build_result);
+
+    printf("NAS codec benchmark, %u messages per row\n", N_msgs);
+    printf("%-24s %5s %12s %12s %8s %10s\n",
+           "Message", "Bytes", "decode ns", "state", "decoded", "truncated");
+    for(i=0; i<NAS_BENCH_MSG_N_ITEMS; i++)
+    {
+        pass = result[i].decoded;
+        if(nas_bench_msg_validated[i])
+        {
+            pass = pass && result[i].truncated_rejected;
+        }
+        printf("%-24s %5u %12.1f %12u %8s %10s\n",
+               nas_bench_msg_text[i],
+               result[i].N_msg_bytes,
+               (double)result[i].ns / N_msgs,
+               result[i].state_bytes,
+               result[i].decoded ? "yes" : "NO",
+               nas_bench_msg_validated[i] ? (result[i].truncated_rejected ? "rejected" : "ACCEPTED") : "-");
+        state_bytes += result[i].state_bytes;
+        all_pass     = all_pass && pass;
+    }
+    printf("Decoder state per attach and service request: %llu bytes\n",
+           (unsigned long long)state_bytes);
+
+    printf("%-24s %5s %12s %12s %8s %6s\n",
+           "Message", "Bytes", "pack ns", "builder ns", "speedup", "match");
+    printf("%-24s %5u %12.1f %12.1f %7.2fx %6s\n",
+           "Attach Accept (build)",
+           build_result.N_msg_bytes,
+           (double)build_result.struct_ns / N_msgs,
+           (double)build_result.builder_ns / N_msgs,
+           (double)build_result.struct_ns / build_result.builder_ns,
+           build_result.match ? "yes" : "NO");
+    printf("Encoder state per Attach Accept: %u bytes through structs, %u bytes through the builder\n",
+           build_result.struct_state_bytes,
+           build_result.builder_state_bytes);
+    all_pass = all_pass && build_result.match;
+
+    return(all_pass ? 0 : 1);
+}
@@ -0,0 +1,818 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_phy_bench.cc
+
+    Description: Measures the downlink receive chain end to end.  For every
+                 bandwidth and transmit antenna count a capture is generated
+                 with the same encode calls as the file generator (PSS, SSS,
+                 CRS, PBCH, SIB1 on the SI-RNTI and a test load on the
+                 P-RNTI), passed through a random phase flat channel per
+                 antenna port, optionally white gaussian noise and a
+                 carrier frequency offset, and then decoded the way the
+                 file scanner does it.  Each decode stage is timed and
+                 reported in microseconds per subframe against a fixed
+                 real time budget, and every decoded MIB and transport
+                 block is checked against what was sent.
+
+                 Usage: liblte_phy_bench [N_frames] [SNR dB] [CFO Hz]
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_bench_common.h"
+#include "liblte_phy.h"
+#include "liblte_mac.h"
+#include "liblte_rrc.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define PHY_BENCH_DEFAULT_N_FRAMES    2
+#define PHY_BENCH_MAX_N_FRAMES        8
+#define PHY_BENCH_N_SUBFR_PER_FRAME   10
+#define PHY_BENCH_N_SYMB_PER_SLOT     7
+#define PHY_BENCH_COARSE_N_SLOTS      20
+#define PHY_BENCH_PERCENT_LOAD        50
+#define PHY_BENCH_MAX_TEST_LOAD_BITS  1480
+#define PHY_BENCH_FINE_FREQ_THRESH    100
+#define PHY_BENCH_SUBFR_BUDGET_US     1000
+#define PHY_BENCH_BUF_LEN             ((PHY_BENCH_MAX_N_FRAMES+2)*LIBLTE_PHY_N_SAMPS_PER_FRAME_30_72MHZ)
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef struct{
+    const char                   *name;
+    LIBLTE_PHY_FS_ENUM            fs;
+    uint32                        N_rb_dl;
+    LIBLTE_RRC_DL_BANDWIDTH_ENUM  dl_bw;
+}PHY_BENCH_BW_STRUCT;
+
+typedef struct{
+    uint64 synth;
+    uint64 sync;
+    uint64 ofdm;
+    uint64 pbch;
+    uint64 pdcch;
+    uint64 pdsch;
+}PHY_BENCH_TIMES_STRUCT;
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+PHY_BENCH_BW_STRUCT bws[] = {{"1.4",  LIBLTE_PHY_FS_1_92MHZ,  LIBLTE_PHY_N_RB_DL_1_4MHZ, LIBLTE_RRC_DL_BANDWIDTH_6},
+                             {"3",    LIBLTE_PHY_FS_3_84MHZ,  LIBLTE_PHY_N_RB_DL_3MHZ,   LIBLTE_RRC_DL_BANDWIDTH_15},
+                             {"5",    LIBLTE_PHY_FS_7_68MHZ,  LIBLTE_PHY_N_RB_DL_5MHZ,   LIBLTE_RRC_DL_BANDWIDTH_25},
+                             {"10",   LIBLTE_PHY_FS_15_36MHZ, LIBLTE_PHY_N_RB_DL_10MHZ,  LIBLTE_RRC_DL_BANDWIDTH_50},
+                             {"15",   LIBLTE_PHY_FS_30_72MHZ, LIBLTE_PHY_N_RB_DL_15MHZ,  LIBLTE_RRC_DL_BANDWIDTH_75},
+                             {"20",   LIBLTE_PHY_FS_30_72MHZ, LIBLTE_PHY_N_RB_DL_20MHZ,  LIBLTE_RRC_DL_BANDWIDTH_100}};
+uint8               ants[] = {1, 2, 4};
+
+LIBLTE_PHY_SUBFRAME_STRUCT               subframe;
+LIBLTE_PHY_PCFICH_STRUCT                 pcfich;
+LIBLTE_PHY_PHICH_STRUCT                  phich;
+LIBLTE_PHY_PDCCH_STRUCT                  pdcch;
+LIBLTE_RRC_MIB_STRUCT                    mib;
+LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1_STRUCT  sib1;
+LIBLTE_RRC_BCCH_DLSCH_MSG_STRUCT         bcch_dlsch_msg;
+LIBLTE_BIT_MSG_STRUCT                    rrc_msg;
+LIBLTE_BIT_MSG_STRUCT                    tx_msg[(PHY_BENCH_MAX_N_FRAMES+2)*PHY_BENCH_N_SUBFR_PER_FRAME];
+uint16                                   tx_rnti[(PHY_BENCH_MAX_N_FRAMES+2)*PHY_BENCH_N_SUBFR_PER_FRAME];
+float                                    h_re[LIBLTE_PHY_N_ANT_MAX];
+float                                    h_im[LIBLTE_PHY_N_ANT_MAX];
+float                                    tx_i[LIBLTE_PHY_N_SAMPS_PER_SUBFR_30_72MHZ];
+float                                    tx_q[LIBLTE_PHY_N_SAMPS_PER_SUBFR_30_72MHZ];
+float                                   *i_buf;
+float                                   *q_buf;
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: random_gauss
+
+    Description: Returns a zero mean, unit variance gaussian sample
+*********************************************************************/
+float random_gauss(uint32 *seed)
+{
+    float u1 = ((float)(liblte_bench_rand(seed) >> 8) + 1) / 16777217.0;
+    float u2 = ((float)(liblte_bench_rand(seed) >> 8) + 1) / 16777217.0;
+
+    return(sqrt(-2*log(u1))*cos(2*M_PI*u2));
+}
+
+/*********************************************************************
+    Name: freq_shift
+
+    Description: Shifts the samples down in frequency by freq_offset,
+                 matching the correction done by the file scanner
+*********************************************************************/
+void freq_shift(LIBLTE_PHY_STRUCT *phy_struct,
+                uint32             N_samps,
+                float              freq_offset)
+{
+    float  f_samp_re;
+    float  f_samp_im;
+    float  tmp_i;
+    float  tmp_q;
+    uint32 i;
+
+    for(i=0; i<N_samps; i++)
+    {
+        f_samp_re = cosf((i+1)*(freq_offset)*2*M_PI/phy_struct->fs);
+        f_samp_im = sinf((i+1)*(freq_offset)*2*M_PI/phy_struct->fs);
+        tmp_i     = i_buf[i];
+        tmp_q     = q_buf[i];
+        i_buf[i]  = tmp_i*f_samp_re + tmp_q*f_samp_im;
+        q_buf[i]  = tmp_q*f_samp_re - tmp_i*f_samp_im;
+    }
+}
+
+/*********************************************************************
+    Name: add_noise
+
+    Description: Adds white gaussian noise at snr_db below the mean
+                 power of the capture
+*********************************************************************/
+void add_noise(uint32 *seed,
+               uint32  N_samps,
+               float   snr_db)
+{
+    float  pwr = 0;
+    float  sd;
+    uint32 i;
+
+    for(i=0; i<N_samps; i++)
+    {
+        pwr += i_buf[i]*i_buf[i] + q_buf[i]*q_buf[i];
+    }
+    pwr /= N_samps;
+    sd   = sqrt(pwr/pow(10, snr_db/10)/2);
+    for(i=0; i<N_samps; i++)
+    {
+        i_buf[i] += sd*random_gauss(seed);
+        q_buf[i] += sd*random_gauss(seed);
+    }
+}
+
+/*********************************************************************
+    Name: synth_frame
+
+    Description: Generates one downlink frame with the encode calls
+                 used by LTE_fdd_dl_fg_samp_buf::work(), passes each
+                 antenna port through its flat channel h and sums the
+                 ports into the capture buffer, and records the
+                 transport block sent in each subframe.  Subframes
+                 that start before the capture buffer are only
+                 partially written, or skipped when they end before
+                 it.  Returns the number of subframes generated.
+*********************************************************************/
+uint32 synth_frame(LIBLTE_PHY_STRUCT *phy_struct,
+                 uint32            *seed,
+                 uint32             N_id_cell,
+                 uint8              N_ant,
+                 uint32             N_rb_dl,
+                 float              phich_res,
+                 uint32             sfn,
+                 int32              frame_start)
+{
+    LIBLTE_PHY_ALLOCATION_STRUCT *alloc;
+    uint32                        N_id_2 = N_id_cell % 3;
+    uint32                        N_id_1 = (N_id_cell - N_id_2)/3;
+    uint32                        N_bits;
+    uint32                        tbs;
+    uint32                        N_prb;
+    uint32                        last_prb;
+    uint32                        idx;
+    uint32                        N_subfr = 0;
+    int32                         samp_idx;
+    uint32                        i;
+    uint32                        j;
+    uint32                        p;
+    uint8                         mcs;
+
+    for(subframe.num=0; subframe.num<PHY_BENCH_N_SUBFR_PER_FRAME; subframe.num++)
+    {
+        samp_idx = frame_start + (int32)(subframe.num*phy_struct->N_samps_per_subfr);
+        if(samp_idx + (int32)phy_struct->N_samps_per_subfr <= 0)
+        {
+            continue;
+        }
+        N_subfr++;
+
+        // Initialize the output to all zeros
+        memset(subframe.tx_symb_re, 0, sizeof(subframe.tx_symb_re));
+        memset(subframe.tx_symb_im, 0, sizeof(subframe.tx_symb_im));
+
+        // PSS and SSS
+        if(subframe.num == 0 ||
+           subframe.num == 5)
+        {
+            liblte_phy_map_pss(phy_struct, &subframe, N_id_2, N_ant);
+            liblte_phy_map_sss(phy_struct, &subframe, N_id_1, N_id_2, N_ant);
+        }
+
+        // CRS
+        liblte_phy_map_crs(phy_struct, &subframe, N_id_cell, N_ant);
+
+        // PBCH
+        if(subframe.num == 0)
+        {
+            mib.sfn_div_4 = sfn/4;
+            liblte_rrc_pack_bcch_bch_msg(&mib, &rrc_msg);
+            liblte_phy_bch_channel_encode(phy_struct,
+                                          rrc_msg.msg,
+                                          rrc_msg.N_bits,
+                                          N_id_cell,
+                                          N_ant,
+                                          &subframe,
+                                          sfn);
+        }
+
+        // PDCCH & PDSCH
+        alloc         = &pdcch.alloc[0];
+        pdcch.N_alloc = 0;
+        if(subframe.num == 5 &&
+           (sfn % 2)    == 0)
+        {
+            // SIB1
+            bcch_dlsch_msg.N_sibs           = 0;
+            bcch_dlsch_msg.sibs[0].sib_type = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1;
+            memcpy(&bcch_dlsch_msg.sibs[0].sib, &sib1, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1_STRUCT));
+            liblte_rrc_pack_bcch_dlsch_msg(&bcch_dlsch_msg, &alloc->msg);
+            liblte_phy_get_tbs_mcs_and_n_prb_for_dl(alloc->msg.N_bits,
+                                                    subframe.num,
+                                                    N_rb_dl,
+                                                    LIBLTE_MAC_SI_RNTI,
+                                                    &alloc->tbs,
+                                                    &alloc->mcs,
+                                                    &alloc->N_prb);
+            alloc->rv_idx = (uint32)ceilf(1.5 * ((sfn / 2) % 4)) % 4; //36.321 section 5.3.1
+            alloc->rnti   = LIBLTE_MAC_SI_RNTI;
+        }else{
+            // Test load, the largest transport block that fits in
+            // PHY_BENCH_PERCENT_LOAD of the PRBs
+            alloc->tbs   = 0;
+            alloc->N_prb = 0;
+            for(N_bits=8; N_bits<=PHY_BENCH_MAX_TEST_LOAD_BITS; N_bits+=8)
+            {
+                if(LIBLTE_SUCCESS != liblte_phy_get_tbs_mcs_and_n_prb_for_dl(N_bits,
+                                                                             subframe.num,
+                                                                             N_rb_dl,
+                                                                             LIBLTE_MAC_P_RNTI,
+                                                                             &tbs,
+                                                                             &mcs,
+                                                                             &N_prb) ||
+                   N_prb > (N_rb_dl*PHY_BENCH_PERCENT_LOAD)/100)
+                {
+                    break;
+                }
+                alloc->tbs   = tbs;
+                alloc->mcs   = mcs;
+                alloc->N_prb = N_prb;
+            }
+
+            // The PRB count above assumes three control symbols, give
+            // the block another PRB when the control region is larger
+            // so that rate matching does not puncture it
+            if(0       != alloc->N_prb &&
+               N_rb_dl >  alloc->N_prb &&
+               3       <  pcfich.cfi + ((N_rb_dl <= 10) ? 1 : 0))
+            {
+                alloc->N_prb++;
+            }
+            alloc->msg.N_bits = alloc->tbs;
+            liblte_bench_random_bits(seed, alloc->msg.msg, alloc->msg.N_bits);
+            alloc->rv_idx = 0;
+            alloc->rnti   = LIBLTE_MAC_P_RNTI;
+        }
+        idx = (sfn*PHY_BENCH_N_SUBFR_PER_FRAME) + subframe.num;
+        if(0 != alloc->N_prb)
+        {
+            alloc->pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
+            alloc->mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
+            alloc->N_codewords    = 1;
+            alloc->tx_mode        = (1 == N_ant) ? 1 : 2;
+            pdcch.N_alloc++;
+            memcpy(&tx_msg[idx], &alloc->msg, sizeof(LIBLTE_BIT_MSG_STRUCT));
+            tx_rnti[idx] = alloc->rnti;
+        }else{
+            tx_rnti[idx] = 0;
+        }
+
+        // Schedule all allocations
+        last_prb = 0;
+        for(i=0; i<pdcch.N_alloc; i++)
+        {
+            for(j=0; j<pdcch.alloc[i].N_prb; j++)
+            {
+                pdcch.alloc[i].prb[0][j] = last_prb;
+                pdcch.alloc[i].prb[1][j] = last_prb++;
+            }
+        }
+        if(0 != pdcch.N_alloc)
+        {
+            liblte_phy_pdcch_channel_encode(phy_struct,
+                                            &pcfich,
+                                            &phich,
+                                            &pdcch,
+                                            N_id_cell,
+                                            N_ant,
+                                            phich_res,
+                                            mib.phich_config.dur,
+                                            &subframe);
+            liblte_phy_pdsch_channel_encode(phy_struct,
+                                            &pdcch,
+                                            N_id_cell,
+                                            N_ant,
+                                            &subframe);
+        }
+
+        // Construct the output, summing the antenna ports
+        for(p=0; p<N_ant; p++)
+        {
+            liblte_phy_create_dl_subframe(phy_struct, &subframe, p, tx_i, tx_q);
+            for(i=0; i<phy_struct->N_samps_per_subfr; i++)
+            {
+                if(samp_idx + (int32)i >= 0)
+                {
+                    i_buf[samp_idx+i] += tx_i[i]*h_re[p] - tx_q[i]*h_im[p];
+                    q_buf[samp_idx+i] += tx_i[i]*h_im[p] + tx_q[i]*h_re[p];
+                }
+            }
+        }
+    }
+
+    return(N_subfr);
+}
+
+/*********************************************************************
+    Name: find_alloc
+
+    Description: Returns the decoded PDCCH allocation for rnti, or
+                 NULL if the PDCCH did not carry one
+*********************************************************************/
+LIBLTE_PHY_ALLOCATION_STRUCT* find_alloc(uint16 rnti)
+{
+    uint32 i;
+
+    for(i=0; i<pdcch.N_alloc; i++)
+    {
+        if(rnti == pdcch.alloc[i].rnti)
+        {
+            return(&pdcch.alloc[i]);
+        }
+    }
+    return(NULL);
+}
+
+int main(int argc, char *argv[])
+{
+    LIBLTE_PHY_STRUCT               *tx_phy;
+    LIBLTE_PHY_STRUCT               *rx_phy;
+    LIBLTE_PHY_ALLOCATION_STRUCT    *alloc;
+    LIBLTE_PHY_COARSE_TIMING_STRUCT  timing_struct;
+    LIBLTE_RRC_MIB_STRUCT            rx_mib;
+    PHY_BENCH_BW_STRUCT             *bw;
+    PHY_BENCH_TIMES_STRUCT           times;
+    uint64                           start;
+    float                            snr_db       = 0;
+    float                            cfo          = 0;
+    float                            phich_res    = liblte_rrc_phich_resource_num[LIBLTE_RRC_PHICH_RESOURCE_1];
+    float                            pss_thresh;
+    float                            freq_offset;
+    float                            fine_offset;
+    float                            total_us;
+    float                            phase;
+    float                            h_sum_re;
+    float                            h_sum_im;
+    bool                             noise        = false;
+    bool                             synced;
+    uint32                           N_frames     = PHY_BENCH_DEFAULT_N_FRAMES;
+    uint32                           seed;
+    uint32                           N_id_cell;
+    uint32                           N_id_1;
+    uint32                           N_id_2;
+    uint32                           pss_symb;
+    uint32                           tx_start;
+    uint32                           frame_start_idx;
+    uint32                           N_samps;
+    uint32                           N_synth;
+    uint32                           N_subfr;
+    uint32                           N_mib_ok;
+    uint32                           N_tb;
+    uint32                           N_tb_ok;
+    uint32                           N_fail       = 0;
+    uint32                           N_over       = 0;
+    uint32                           cfg          = 0;
+    uint32                           peak;
+    uint32                           attempt;
+    uint32                           cp_shift;
+    uint32                           symb_starts[PHY_BENCH_N_SYMB_PER_SLOT];
+    uint32                           idx;
+    uint32                           i;
+    uint32                           j;
+    uint32                           a;
+    uint32                           f;
+    uint32                           s;
+    uint32                           p;
+    uint8                            N_ant;
+    uint8                            rx_N_ant;
+    uint8                            sfn_offset;
+    bool                             pass;
+
+    if(argc > 1)
+    {
+        N_frames = atoi(argv[1]);
+        if(N_frames < 1)
+        {
+            N_frames = 1;
+        }else if(N_frames > PHY_BENCH_MAX_N_FRAMES){
+            N_frames = PHY_BENCH_MAX_N_FRAMES;
+        }
+    }
+    if(argc > 2)
+    {
+        snr_db = atof(argv[2]);
+        noise  = true;
+    }
+    if(argc > 3)
+    {
+        cfo = atof(argv[3]);
+    }
+
+    i_buf = (float *)malloc(sizeof(float)*PHY_BENCH_BUF_LEN);
+    q_buf = (float *)malloc(sizeof(float)*PHY_BENCH_BUF_LEN);
+
+    // Same cell configuration as the file generator defaults
+    mib.phich_config.dur                  = LIBLTE_RRC_PHICH_DURATION_NORMAL;
+    mib.phich_config.res                  = LIBLTE_RRC_PHICH_RESOURCE_1;
+    sib1.N_plmn_ids                       = 1;
+    sib1.plmn_id[0].id.mcc                = 0xF001;
+    sib1.plmn_id[0].id.mnc                = 0xFF01;
+    sib1.plmn_id[0].resv_for_oper         = LIBLTE_RRC_NOT_RESV_FOR_OPER;
+    sib1.N_sched_info                     = 1;
+    sib1.sched_info[0].N_sib_mapping_info = 0;
+    sib1.sched_info[0].si_periodicity     = LIBLTE_RRC_SI_PERIODICITY_RF8;
+    sib1.cell_barred                      = LIBLTE_RRC_CELL_NOT_BARRED;
+    sib1.intra_freq_reselection           = LIBLTE_RRC_INTRA_FREQ_RESELECTION_ALLOWED;
+    sib1.si_window_length                 = LIBLTE_RRC_SI_WINDOW_LENGTH_MS2;
+    sib1.tdd_cnfg.sf_assignment           = LIBLTE_RRC_SUBFRAME_ASSIGNMENT_0;
+    sib1.tdd_cnfg.special_sf_patterns     = LIBLTE_RRC_SPECIAL_SUBFRAME_PATTERNS_0;
+    sib1.cell_id                          = 0;
+    sib1.csg_id                           = 0;
+    sib1.tracking_area_code               = 0;
+    sib1.q_rx_lev_min                     = -140;
+    sib1.csg_indication                   = 0;
+    sib1.q_rx_lev_min_offset              = 1;
+    sib1.freq_band_indicator              = 1;
+    sib1.system_info_value_tag            = 0;
+    sib1.p_max_present                    = true;
+    sib1.p_max                            = -30;
+    sib1.tdd                              = false;
+
+    if(noise)
+    {
+        printf("frames %u, snr %.1f dB, cfo %.1f Hz, budget %u us/subframe\n",
+               N_frames,
+               snr_db,
+               cfo,
+               PHY_BENCH_SUBFR_BUDGET_US);
+    }else{
+        printf("frames %u, no noise, cfo %.1f Hz, budget %u us/subframe\n",
+               N_frames,
+               cfo,
+               PHY_BENCH_SUBFR_BUDGET_US);
+    }
+    printf("%-4s %3s %3s %9s %9s %9s %9s %9s %9s %7s %5s %7s %6s\n",
+           "MHz", "ant", "pci", "synth(us)", "sync(us)", "ofdm(us)", "pbch(us)", "pdcch(us)", "pdsch(us)", "budget", "mib", "tb", "pass");
+    for(i=0; i<sizeof(bws)/sizeof(bws[0]); i++)
+    {
+        bw = &bws[i];
+        for(a=0; a<sizeof(ants)/sizeof(ants[0]); a++, cfg++)
+        {
+            N_ant     = ants[a];
+            seed      = 1 + cfg;
+            N_id_cell = (37*cfg + 11) % 504;
+            memset(&times, 0, sizeof(times));
+            liblte_phy_init(&tx_phy,
+                            bw->fs,
+                            N_id_cell,
+                            N_ant,
+                            bw->N_rb_dl,
+                            LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
+                            phich_res);
+            liblte_phy_init(&rx_phy,
+                            bw->fs,
+                            LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN,
+                            4,
+                            bw->N_rb_dl,
+                            LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
+                            phich_res);
+            mib.dl_bw  = bw->dl_bw;
+
+            // Use the CFI of the file generator, except at 1.4 MHz with
+            // four antenna ports where it leaves fewer CCEs than the
+            // common search space needs for aggregation level 4
+            pcfich.cfi = 2;
+            if(LIBLTE_PHY_N_RB_DL_1_4MHZ == bw->N_rb_dl &&
+               4                         == N_ant)
+            {
+                pcfich.cfi = 3;
+            }
+
+            // Give every antenna port a unit gain, random phase flat
+            // channel.  Summing the ports in phase would put all of the
+            // PSS and SSS energy in a few symbols and swamp the cyclic
+            // prefix correlation used for coarse timing.  The PSS and
+            // SSS are sent on every port, so redraw phases that leave
+            // them weaker than a single port.
+            do
+            {
+                h_sum_re = 0;
+                h_sum_im = 0;
+                for(p=0; p<N_ant; p++)
+                {
+                    phase     = 2*M_PI*(float)(liblte_bench_rand(&seed) >> 8)/16777216.0;
+                    h_re[p]   = cos(phase);
+                    h_im[p]   = sin(phase);
+                    h_sum_re += h_re[p];
+                    h_sum_im += h_im[p];
+                }
+            }while((h_sum_re*h_sum_re + h_sum_im*h_sum_im) < 1);
+
+            // Start the capture part way into frame 0 so that the
+            // receiver has to find the frame boundary in a continuous
+            // signal, frame f+1 then starts at sample tx_start +
+            // f*N_samps_per_frame
+            tx_start = liblte_bench_rand(&seed) % tx_phy->N_samps_per_frame;
+            N_samps  = (N_frames+1)*tx_phy->N_samps_per_frame + tx_start;
+            N_synth  = 0;
+            memset(i_buf, 0, sizeof(float)*N_samps);
+            memset(q_buf, 0, sizeof(float)*N_samps);
+            start = liblte_bench_get_time_ns();
+            for(f=0; f<=N_frames+1; f++)
+            {
+                N_synth += synth_frame(tx_phy,
+                                       &seed,
+                                       N_id_cell,
+                                       N_ant,
+                                       bw->N_rb_dl,
+                                       phich_res,
+                                       f,
+                                       (int32)(f*tx_phy->N_samps_per_frame + tx_start) - (int32)tx_phy->N_samps_per_frame);
+            }
+            times.synth = liblte_bench_get_time_ns() - start;
+            if(noise)
+            {
+                add_noise(&seed, N_samps, snr_db);
+            }
+            if(0 != cfo)
+            {
+                freq_shift(rx_phy, N_samps, -cfo);
+            }
+
+            // Acquire the cell the way the file scanner does, moving
+            // on to the next coarse timing peak when PSS or SSS fail.
+            // The coarse peak can land anywhere in the longer cyclic
+            // prefix of the first symbol of a slot, which puts the PSS
+            // search window late enough to miss the PSS, so each peak
+            // is also tried that much earlier.
+            synced   = false;
+            cp_shift = rx_phy->N_samps_cp_l_0 - rx_phy->N_samps_cp_l_else;
+            start    = liblte_bench_get_time_ns();
+            if(LIBLTE_SUCCESS == liblte_phy_dl_find_coarse_timing_and_freq_offset(rx_phy,
+                                                                                  i_buf,
+                                                                                  q_buf,
+                                                                                  PHY_BENCH_COARSE_N_SLOTS,
+                                                                                  &timing_struct))
+            {
+                for(attempt=0; !synced && attempt<2*timing_struct.n_corr_peaks; attempt++)
+                {
+                    peak = attempt/2;
+                    for(j=0; j<PHY_BENCH_N_SYMB_PER_SLOT; j++)
+                    {
+                        symb_starts[j] = timing_struct.symb_starts[peak][j];
+                        if(1 == (attempt % 2))
+                        {
+                            if(symb_starts[0] < cp_shift)
+                            {
+                                symb_starts[j] += rx_phy->N_samps_per_slot;
+                            }
+                            symb_starts[j] -= cp_shift;
+                        }
+                    }
+                    freq_shift(rx_phy, N_samps, timing_struct.freq_offset[peak]);
+                    fine_offset = 0;
+                    if(LIBLTE_SUCCESS == liblte_phy_find_pss_and_fine_timing(rx_phy,
+                                                                             i_buf,
+                                                                             q_buf,
+                                                                             symb_starts,
+                                                                             &N_id_2,
+                                                                             &pss_symb,
+                                                                             &pss_thresh,
+                                                                             &freq_offset))
+                    {
+                        if(fabs(freq_offset) > PHY_BENCH_FINE_FREQ_THRESH)
+                        {
+                            freq_shift(rx_phy, N_samps, freq_offset);
+                            fine_offset = freq_offset;
+                        }
+                        if(LIBLTE_SUCCESS == liblte_phy_find_sss(rx_phy,
+                                                                 i_buf,
+                                                                 q_buf,
+                                                                 N_id_2,
+                                                                 symb_starts,
+                                                                 pss_thresh,
+                                                                 &N_id_1,
+                                                                 &frame_start_idx))
+                        {
+                            synced = true;
+                        }
+                    }
+                    if(!synced)
+                    {
+                        // Undo the correction before the next attempt
+                        freq_shift(rx_phy, N_samps, -(timing_struct.freq_offset[peak] + fine_offset));
+                    }
+                }
+            }
+            times.sync = liblte_bench_get_time_ns() - start;
+            if(synced)
+            {
+                frame_start_idx %= rx_phy->N_samps_per_frame;
+                synced           = (N_id_cell == (3*N_id_1 + N_id_2));
+            }
+
+            // Decode every subframe of the first N_frames complete frames
+            N_subfr  = 0;
+            N_mib_ok = 0;
+            N_tb     = 0;
+            N_tb_ok  = 0;
+            rx_N_ant = N_ant;
+            for(f=0; synced && f<N_frames; f++)
+            {
+                for(s=0; s<PHY_BENCH_N_SUBFR_PER_FRAME; s++)
+                {
+                    start = liblte_bench_get_time_ns();
+                    liblte_phy_get_dl_subframe_and_ce(rx_phy,
+                                                      i_buf,
+                                                      q_buf,
+                                                      frame_start_idx + f*rx_phy->N_samps_per_frame,
+                                                      s,
+                                                      N_id_cell,
+                                                      (0 == s) ? 4 : rx_N_ant,
+                                                      &subframe);
+                    times.ofdm += liblte_bench_get_time_ns() - start;
+                    N_subfr++;
+
+                    if(0 == s)
+                    {
+                        start = liblte_bench_get_time_ns();
+                        if(LIBLTE_SUCCESS == liblte_phy_bch_channel_decode(rx_phy,
+                                                                           &subframe,
+                                                                           N_id_cell,
+                                                                           &rx_N_ant,
+                                                                           rrc_msg.msg,
+                                                                           &rrc_msg.N_bits,
+                                                                           &sfn_offset) &&
+                           LIBLTE_SUCCESS == liblte_rrc_unpack_bcch_bch_msg(&rrc_msg,
+                                                                            &rx_mib))
+                        {
+                            if(rx_N_ant                 == N_ant                    &&
+                               rx_mib.dl_bw             == mib.dl_bw                &&
+                               rx_mib.phich_config.dur  == mib.phich_config.dur     &&
+                               rx_mib.phich_config.res  == mib.phich_config.res     &&
+                               rx_mib.sfn_div_4         == (f+1)/4                  &&
+                               sfn_offset               == (f+1)%4)
+                            {
+                                N_mib_ok++;
+                            }
+                        }else{
+                            rx_N_ant = N_ant;
+                        }
+                        times.pbch += liblte_bench_get_time_ns() - start;
+                    }
+
+                    idx = ((f+1)*PHY_BENCH_N_SUBFR_PER_FRAME) + s;
+                    if(0 == tx_rnti[idx])
+                    {
+                        continue;
+                    }
+                    N_tb++;
+                    start = liblte_bench_get_time_ns();
+                    liblte_phy_pdcch_channel_decode(rx_phy,
+                                                    &subframe,
+                                                    N_id_cell,
+                                                    rx_N_ant,
+                                                    phich_res,
+                                                    mib.phich_config.dur,
+                                                    &pcfich,
+                                                    &phich,
+                                                    &pdcch);
+                    times.pdcch += liblte_bench_get_time_ns() - start;
+                    alloc        = find_alloc(tx_rnti[idx]);
+                    if(NULL != alloc)
+                    {
+                        start = liblte_bench_get_time_ns();
+                        if(LIBLTE_SUCCESS == liblte_phy_pdsch_channel_decode(rx_phy,
+                                                                             &subframe,
+                                                                             alloc,
+                                                                             pdcch.N_symbs,
+                                                                             N_id_cell,
+                                                                             rx_N_ant,
+                                                                             rrc_msg.msg,
+                                                                             &rrc_msg.N_bits) &&
+                           rrc_msg.N_bits >= tx_msg[idx].N_bits                            &&
+                           0              == memcmp(rrc_msg.msg, tx_msg[idx].msg, tx_msg[idx].N_bits))
+                        {
+                            N_tb_ok++;
+                        }
+                        times.pdsch += liblte_bench_get_time_ns() - start;
+                    }
+                }
+            }
+
+            // Stage times are per decoded subframe, except for sync
+            // which is per acquisition
+            if(0 == N_subfr)
+            {
+                N_subfr = 1;
+            }
+            total_us = (times.ofdm + times.pbch + times.pdcch + times.pdsch)/(1000.0*N_subfr);
+            pass     = (synced && N_mib_ok == N_frames && 0 != N_tb && N_tb_ok == N_tb);
+            if(!pass)
+            {
+                N_fail++;
+            }
+            if(total_us > PHY_BENCH_SUBFR_BUDGET_US)
+            {
+                N_over++;
+            }
+            printf("%-4s %3u %3u %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %6.0f%% %2u/%-2u %3u/%-3u %6s\n",
+                   bw->name,
+                   N_ant,
+                   N_id_cell,
+                   times.synth/(1000.0*N_synth),
+                   times.sync/1000.0,
+                   times.ofdm/(1000.0*N_subfr),
+                   times.pbch/(1000.0*N_subfr),
+                   times.pdcch/(1000.0*N_subfr),
+                   times.pdsch/(1000.0*N_subfr),
+                   100*total_us/PHY_BENCH_SUBFR_BUDGET_US,
+                   N_mib_ok,
+                   N_frames,
+                   N_tb_ok,
+                   N_tb,
+                   pass ? "yes" : "NO");
+
+            liblte_phy_cleanup(rx_phy);
+            liblte_phy_cleanup(tx_phy);
+        }
+    }
+
+    free(i_buf);
+    free(q_buf);
+
+    if(0 != N_over)
+    {
+        printf("%u configurations over the %u us/subframe budget\n", N_over, PHY_BENCH_SUBFR_BUDGET_US);
+    }
+    if(0 != N_fail)
+    {
+        printf("%u configurations did not decode\n", N_fail);
+        return(1);
+    }
+    return(0);
+}
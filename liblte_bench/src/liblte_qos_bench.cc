@@ -0,0 +1,467 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_qos_bench.cc
+
+    Description: Simulates a user with a saturating bulk download on a
+                 QCI 9 bearer and a VoIP flow on a QCI 1 bearer sharing
+                 a downlink that varies from TTI to TTI.  Compares a
+                 single shared FIFO, per bearer queues served in bearer
+                 order, GBR plus deficit round robin, and GBR plus
+                 deficit round robin with CoDel, reporting VoIP latency
+                 and bulk throughput and latency for each.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_bench_common.h"
+#include "liblte_qos.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define QOS_BENCH_DEFAULT_SECONDS 30
+#define QOS_BENCH_WARMUP_TTIS     2000
+#define QOS_BENCH_TTI_BYTES       1250 // 10Mbps on average
+#define QOS_BENCH_BULK_KBPS       11000
+#define QOS_BENCH_BULK_PKT_BYTES  1500
+#define QOS_BENCH_BULK_QCI        9
+#define QOS_BENCH_VOIP_PERIOD_MS  20
+#define QOS_BENCH_VOIP_PKT_BYTES  72
+#define QOS_BENCH_VOIP_QCI        1
+#define QOS_BENCH_VOIP_GBR_KBPS   64
+#define QOS_BENCH_QUEUE_SIZE      1024
+#define QOS_BENCH_MAX_SAMPLES     65536
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef enum{
+    QOS_BENCH_MODE_FIFO = 0,
+    QOS_BENCH_MODE_BEARER_ORDER,
+    QOS_BENCH_MODE_DRR,
+    QOS_BENCH_MODE_DRR_CODEL,
+    QOS_BENCH_MODE_N_ITEMS,
+}QOS_BENCH_MODE_ENUM;
+static const char qos_bench_mode_text[QOS_BENCH_MODE_N_ITEMS][20] = {"shared FIFO",
+                                                                     "bearer order",
+                                                                     "GBR + DRR",
+                                                                     "GBR + DRR + CoDel"};
+
+typedef enum{
+    QOS_BENCH_FLOW_VOIP = 0,
+    QOS_BENCH_FLOW_BULK,
+    QOS_BENCH_FLOW_N_ITEMS,
+}QOS_BENCH_FLOW_ENUM;
+
+typedef struct{
+    uint64 arrival_us;
+    uint32 N_bytes;
+    uint32 flow;
+}QOS_BENCH_PKT_STRUCT;
+
+typedef struct{
+    QOS_BENCH_PKT_STRUCT    pkt[QOS_BENCH_QUEUE_SIZE];
+    LIBLTE_QOS_CODEL_STRUCT codel;
+    uint32                  head;
+    uint32                  N_pkts;
+    uint32                  N_bytes;
+    uint32                  offset;
+    bool                    aqm;
+}QOS_BENCH_QUEUE_STRUCT;
+
+typedef struct{
+    uint32 latency_us[QOS_BENCH_MAX_SAMPLES];
+    uint64 N_bytes;
+    uint32 N_latency;
+    uint32 N_sent;
+    uint32 N_tail_drops;
+    uint32 N_aqm_drops;
+}QOS_BENCH_FLOW_RESULT_STRUCT;
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+QOS_BENCH_QUEUE_STRUCT       queue[QOS_BENCH_FLOW_N_ITEMS];
+QOS_BENCH_FLOW_RESULT_STRUCT result[QOS_BENCH_FLOW_N_ITEMS];
+bool                         recording;
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: queue_init
+
+    Description: Empties a queue and resets its CoDel state
+*********************************************************************/
+void queue_init(QOS_BENCH_QUEUE_STRUCT *q,
+                bool                    aqm)
+{
+    q->head    = 0;
+    q->N_pkts  = 0;
+    q->N_bytes = 0;
+    q->offset  = 0;
+    q->aqm     = aqm;
+    liblte_qos_codel_init(&q->codel, LIBLTE_QOS_CODEL_TARGET_US, LIBLTE_QOS_CODEL_INTERVAL_US);
+}
+
+/*********************************************************************
+    Name: queue_push
+
+    Description: Adds a packet to the tail of a queue, dropping it if
+                 the queue is full
+*********************************************************************/
+void queue_push(QOS_BENCH_QUEUE_STRUCT *q,
+                uint64                  now_us,
+                uint32                  N_bytes,
+                uint32                  flow)
+{
+    QOS_BENCH_PKT_STRUCT *pkt;
+
+    if(QOS_BENCH_QUEUE_SIZE == q->N_pkts)
+    {
+        if(recording)
+        {
+            result[flow].N_tail_drops++;
+        }
+    }else{
+        pkt             = &q->pkt[(q->head + q->N_pkts) % QOS_BENCH_QUEUE_SIZE];
+        pkt->arrival_us = now_us;
+        pkt->N_bytes    = N_bytes;
+        pkt->flow       = flow;
+        q->N_pkts++;
+        q->N_bytes     += N_bytes;
+    }
+}
+
+/*********************************************************************
+    Name: queue_pop
+
+    Description: Removes the packet at the head of a queue
+*********************************************************************/
+void queue_pop(QOS_BENCH_QUEUE_STRUCT *q)
+{
+    q->N_bytes -= q->pkt[q->head].N_bytes;
+    q->head     = (q->head + 1) % QOS_BENCH_QUEUE_SIZE;
+    q->offset   = 0;
+    q->N_pkts--;
+}
+
+/*********************************************************************
+    Name: queue_serve
+
+    Description: Sends up to N_bytes_max bytes from the head of a
+                 queue, segmenting the last packet if needed, and
+                 returns the number of bytes sent.  Packets finish at
+                 the end of the TTI.  With AQM, CoDel is asked about
+                 every packet before its first byte is sent.
+*********************************************************************/
+uint32 queue_serve(QOS_BENCH_QUEUE_STRUCT *q,
+                   uint64                  now_us,
+                   uint32                  N_bytes_max)
+{
+    QOS_BENCH_PKT_STRUCT *pkt;
+    uint32                N_sent = 0;
+    uint32                N_bytes;
+
+    while(0 != q->N_pkts &&
+          N_sent < N_bytes_max)
+    {
+        pkt = &q->pkt[q->head];
+        if(q->aqm          &&
+           0 == q->offset &&
+           liblte_qos_codel_drop(&q->codel, now_us, now_us - pkt->arrival_us, q->N_bytes))
+        {
+            if(recording)
+            {
+                result[pkt->flow].N_aqm_drops++;
+            }
+            queue_pop(q);
+            continue;
+        }
+
+        N_bytes = pkt->N_bytes - q->offset;
+        if(N_bytes > (N_bytes_max - N_sent))
+        {
+            N_bytes = N_bytes_max - N_sent;
+        }
+        N_sent    += N_bytes;
+        q->offset += N_bytes;
+        if(q->offset == pkt->N_bytes)
+        {
+            if(recording)
+            {
+                result[pkt->flow].N_bytes += pkt->N_bytes;
+                result[pkt->flow].N_sent++;
+                if(QOS_BENCH_MAX_SAMPLES > result[pkt->flow].N_latency)
+                {
+                    result[pkt->flow].latency_us[result[pkt->flow].N_latency++] = now_us + 1000 - pkt->arrival_us;
+                }
+            }
+            queue_pop(q);
+        }
+    }
+
+    return(N_sent);
+}
+
+/*********************************************************************
+    Name: compare_uint32
+
+    Description: qsort comparison function for latencies
+*********************************************************************/
+int compare_uint32(const void *a,
+                   const void *b)
+{
+    uint32 v_a = *(const uint32 *)a;
+    uint32 v_b = *(const uint32 *)b;
+
+    return((v_a > v_b) - (v_a < v_b));
+}
+
+/*********************************************************************
+    Name: percentile_ms
+
+    Description: Returns a percentile of the sorted latencies of a flow
+                 in milliseconds
+*********************************************************************/
+float percentile_ms(QOS_BENCH_FLOW_RESULT_STRUCT *res,
+                    uint32                        pct)
+{
+    float ms = 0;
+
+    if(0 != res->N_latency)
+    {
+        ms = (float)res->latency_us[((res->N_latency - 1) * pct) / 100] / 1000.0;
+    }
+
+    return(ms);
+}
+
+/*********************************************************************
+    Name: print_ms
+
+    Description: Prints a latency column, or a dash if the flow never
+                 got a packet through
+*********************************************************************/
+void print_ms(QOS_BENCH_FLOW_RESULT_STRUCT *res,
+              uint32                        pct)
+{
+    if(0 != res->N_latency)
+    {
+        printf(" %7.1fms", percentile_ms(res, pct));
+    }else{
+        printf(" %9s", "-");
+    }
+}
+
+/*********************************************************************
+    Name: run_mode
+
+    Description: Simulates N_ttis TTIs of both flows under one queueing
+                 mode, the same way the eNodeB MAC shares a transport
+                 block between bearers
+*********************************************************************/
+void run_mode(QOS_BENCH_MODE_ENUM mode,
+              uint32              N_ttis)
+{
+    LIBLTE_QOS_TOKEN_BUCKET_STRUCT  gbr;
+    LIBLTE_QOS_DRR_STRUCT           drr;
+    LIBLTE_QOS_QCI_STRUCT           qci_char;
+    QOS_BENCH_QUEUE_STRUCT         *voip_q = &queue[QOS_BENCH_FLOW_VOIP];
+    QOS_BENCH_QUEUE_STRUCT         *bulk_q = &queue[QOS_BENCH_FLOW_BULK];
+    uint64                          now;
+    uint32                          seed        = 1;
+    uint32                          bulk_credit = 0;
+    uint32                          N_bytes;
+    uint32                          N_limit;
+    uint32                          N_sent;
+    uint32                          flow;
+    uint32                          tti;
+    uint32                          i;
+
+    // The shared FIFO only uses the VoIP queue
+    queue_init(voip_q, QOS_BENCH_MODE_DRR_CODEL == mode);
+    queue_init(bulk_q, QOS_BENCH_MODE_DRR_CODEL == mode);
+    memset(result, 0, sizeof(result));
+    liblte_qos_token_bucket_init(&gbr, QOS_BENCH_VOIP_GBR_KBPS, LIBLTE_QOS_TOKEN_BUCKET_BURST_MS, 0);
+    liblte_qos_drr_init(&drr, QOS_BENCH_FLOW_N_ITEMS);
+    liblte_qos_get_qci(QOS_BENCH_VOIP_QCI, &qci_char);
+    liblte_qos_drr_set_quantum(&drr, QOS_BENCH_FLOW_VOIP, LIBLTE_QOS_DRR_QUANTUM(qci_char.priority));
+    liblte_qos_get_qci(QOS_BENCH_BULK_QCI, &qci_char);
+    liblte_qos_drr_set_quantum(&drr, QOS_BENCH_FLOW_BULK, LIBLTE_QOS_DRR_QUANTUM(qci_char.priority));
+
+    for(tti=0; tti<N_ttis; tti++)
+    {
+        now       = (uint64)tti * 1000;
+        recording = (QOS_BENCH_WARMUP_TTIS <= tti);
+
+        // Arrivals
+        bulk_credit += QOS_BENCH_BULK_KBPS / 8;
+        while(QOS_BENCH_BULK_PKT_BYTES <= bulk_credit)
+        {
+            bulk_credit -= QOS_BENCH_BULK_PKT_BYTES;
+            if(QOS_BENCH_MODE_FIFO == mode)
+            {
+                queue_push(voip_q, now, QOS_BENCH_BULK_PKT_BYTES, QOS_BENCH_FLOW_BULK);
+            }else{
+                queue_push(bulk_q, now, QOS_BENCH_BULK_PKT_BYTES, QOS_BENCH_FLOW_BULK);
+            }
+        }
+        if(0 == (tti % QOS_BENCH_VOIP_PERIOD_MS))
+        {
+            queue_push(voip_q, now, QOS_BENCH_VOIP_PKT_BYTES, QOS_BENCH_FLOW_VOIP);
+        }
+
+        // Channel quality moves the TTI capacity between 75% and 125%
+        N_bytes = (QOS_BENCH_TTI_BYTES * (75 + (liblte_bench_rand(&seed) % 51))) / 100;
+
+        if(QOS_BENCH_MODE_FIFO == mode)
+        {
+            queue_serve(voip_q, now, N_bytes);
+        }else if(QOS_BENCH_MODE_BEARER_ORDER == mode){
+            // The default bearer comes first, like the old MAC PDU builder
+            N_bytes -= queue_serve(bulk_q, now, N_bytes);
+            queue_serve(voip_q, now, N_bytes);
+        }else{
+            // Guaranteed bit rate first
+            liblte_qos_token_bucket_update(&gbr, now);
+            N_limit = liblte_qos_token_bucket_bytes(&gbr);
+            if(N_limit > N_bytes)
+            {
+                N_limit = N_bytes;
+            }
+            N_sent   = queue_serve(voip_q, now, N_limit);
+            N_bytes -= N_sent;
+            liblte_qos_token_bucket_consume(&gbr, N_sent);
+
+            // Then deficit round robin
+            for(i=0; i<QOS_BENCH_FLOW_N_ITEMS; i++)
+            {
+                drr.flow[i].backlogged = (0 != queue[i].N_pkts);
+            }
+            while(0              != N_bytes &&
+                  LIBLTE_SUCCESS == liblte_qos_drr_select(&drr, &flow, &N_limit))
+            {
+                if(N_limit > N_bytes)
+                {
+                    N_limit = N_bytes;
+                }
+                N_sent   = queue_serve(&queue[flow], now, N_limit);
+                N_bytes -= N_sent;
+                liblte_qos_drr_charge(&drr, flow, N_sent, (0 == N_sent || 0 == queue[flow].N_pkts));
+            }
+        }
+    }
+
+    for(i=0; i<QOS_BENCH_FLOW_N_ITEMS; i++)
+    {
+        qsort(result[i].latency_us, result[i].N_latency, sizeof(uint32), compare_uint32);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QOS_BENCH_FLOW_RESULT_STRUCT *voip = &result[QOS_BENCH_FLOW_VOIP];
+    QOS_BENCH_FLOW_RESULT_STRUCT *bulk = &result[QOS_BENCH_FLOW_BULK];
+    uint32                        N_seconds = QOS_BENCH_DEFAULT_SECONDS;
+    uint32                        N_ttis;
+    uint32                        mode;
+    float                         seconds;
+    float                         bulk_mbps;
+    float                         voip_p99[QOS_BENCH_MODE_N_ITEMS];
+    float                         bulk_p99[QOS_BENCH_MODE_N_ITEMS];
+    float                         min_bulk_mbps;
+    bool                          fail      = false;
+
+    if(argc > 1)
+    {
+        N_seconds = atoi(argv[1]);
+    }
+    N_ttis  = QOS_BENCH_WARMUP_TTIS + N_seconds*1000;
+    seconds = (float)N_seconds;
+
+    printf("%u s of a %u kbps bulk flow and a %u byte every %u ms VoIP flow over about %u kbps\n",
+           N_seconds,
+           QOS_BENCH_BULK_KBPS,
+           QOS_BENCH_VOIP_PKT_BYTES,
+           QOS_BENCH_VOIP_PERIOD_MS,
+           QOS_BENCH_TTI_BYTES*8);
+    printf("%-18s %9s %9s %9s %9s %9s %9s %9s %9s\n",
+           "mode", "voip p50", "voip p99", "voip max", "voip lost",
+           "bulk Mbps", "bulk p50", "bulk p99", "bulk drop");
+    for(mode=0; mode<QOS_BENCH_MODE_N_ITEMS; mode++)
+    {
+        run_mode((QOS_BENCH_MODE_ENUM)mode, N_ttis);
+        bulk_mbps      = (float)bulk->N_bytes*8/(seconds*1e6);
+        voip_p99[mode] = percentile_ms(voip, 99);
+        bulk_p99[mode] = percentile_ms(bulk, 99);
+        printf("%-18s", qos_bench_mode_text[mode]);
+        print_ms(voip, 50);
+        print_ms(voip, 99);
+        print_ms(voip, 100);
+        printf(" %9u %9.2f", voip->N_tail_drops + voip->N_aqm_drops, bulk_mbps);
+        print_ms(bulk, 50);
+        print_ms(bulk, 99);
+        printf(" %9u\n", bulk->N_tail_drops + bulk->N_aqm_drops);
+
+        // Sharing must not cost the bulk flow more than a few percent
+        // of what the VoIP flow leaves over
+        min_bulk_mbps = 0.95*(QOS_BENCH_TTI_BYTES*8/1000.0 - QOS_BENCH_VOIP_PKT_BYTES*8/(QOS_BENCH_VOIP_PERIOD_MS*1000.0));
+        if(QOS_BENCH_MODE_DRR_CODEL == mode &&
+           bulk_mbps                <  min_bulk_mbps)
+        {
+            printf("bulk throughput below %.2f Mbps\n", min_bulk_mbps);
+            fail = true;
+        }
+    }
+
+    // The small flow has to meet the QCI 1 delay budget with AQM on,
+    // and CoDel has to keep the bulk queue shorter than a plain FIFO
+    if(voip_p99[QOS_BENCH_MODE_DRR_CODEL] > 100)
+    {
+        printf("VoIP p99 latency over the QCI 1 delay budget\n");
+        fail = true;
+    }
+    if(bulk_p99[QOS_BENCH_MODE_DRR_CODEL] >= bulk_p99[QOS_BENCH_MODE_DRR])
+    {
+        printf("CoDel did not cut the bulk queueing delay\n");
+        fail = true;
+    }
+
+    if(fail)
+    {
+        return(1);
+    }
+    return(0);
+}
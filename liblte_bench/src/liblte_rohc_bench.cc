@@ -0,0 +1,332 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_rohc_bench.cc
+
+    Description: Runs VoIP, UDP, ESP, and TCP flows through the ROHC
+                 compressor and decompressor, checks that every packet
+                 is restored byte for byte, and reports header bytes
+                 saved and packets per second in both directions.  A
+                 second pass drops compressed packets to exercise
+                 context repair through feedback.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_bench_common.h"
+#include "liblte_rohc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define ROHC_BENCH_DEFAULT_N_PKTS 100000
+#define ROHC_BENCH_LOSS_PERCENT   5
+#define ROHC_BENCH_PROFILES       ((1 << LIBLTE_ROHC_PROFILE_RTP) | \
+                                   (1 << LIBLTE_ROHC_PROFILE_UDP) | \
+                                   (1 << LIBLTE_ROHC_PROFILE_ESP))
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef enum{
+    ROHC_BENCH_FLOW_VOIP = 0,
+    ROHC_BENCH_FLOW_UDP,
+    ROHC_BENCH_FLOW_ESP,
+    ROHC_BENCH_FLOW_TCP,
+    ROHC_BENCH_FLOW_N_ITEMS,
+}ROHC_BENCH_FLOW_ENUM;
+static const char rohc_bench_flow_text[ROHC_BENCH_FLOW_N_ITEMS][20] = {"VoIP (RTP)",
+                                                                       "IoT (UDP)",
+                                                                       "IPsec (ESP)",
+                                                                       "TCP (uncompressed)"};
+
+typedef struct{
+    uint32 sn;
+    uint32 ts;
+    uint16 ip_id;
+}ROHC_BENCH_FLOW_STATE_STRUCT;
+
+typedef struct{
+    uint64 N_ip_bytes;
+    uint64 N_rohc_bytes;
+    uint64 N_hdr_bytes;
+    uint64 comp_ns;
+    uint64 decomp_ns;
+    uint32 N_pkts;
+    uint32 N_ok;
+    uint32 N_mismatch;
+}ROHC_BENCH_RESULT_STRUCT;
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+LIBLTE_ROHC_COMP_STRUCT   comp;
+LIBLTE_ROHC_DECOMP_STRUCT decomp;
+LIBLTE_BYTE_MSG_STRUCT    ip_pkt;
+LIBLTE_BYTE_MSG_STRUCT    rohc_pkt;
+LIBLTE_BYTE_MSG_STRUCT    out_pkt;
+LIBLTE_BYTE_MSG_STRUCT    feedback;
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: put_16/put_32
+
+    Description: Network byte order field writes
+*********************************************************************/
+void put_16(uint8  *ptr,
+            uint32  value)
+{
+    ptr[0] = (value >> 8) & 0xFF;
+    ptr[1] = value & 0xFF;
+}
+void put_32(uint8  *ptr,
+            uint32  value)
+{
+    put_16(ptr, value >> 16);
+    put_16(&ptr[2], value);
+}
+
+/*********************************************************************
+    Name: build_pkt
+
+    Description: Builds the next packet of a flow and returns the size
+                 of its headers
+*********************************************************************/
+uint32 build_pkt(ROHC_BENCH_FLOW_ENUM          type,
+                 ROHC_BENCH_FLOW_STATE_STRUCT *state,
+                 uint32                       *seed,
+                 LIBLTE_BYTE_MSG_STRUCT       *pkt)
+{
+    uint8  *msg      = pkt->msg;
+    uint32  hdr_len  = 28;
+    uint32  N_data   = 32;
+    uint32  protocol = 17;
+    uint32  sum      = 0;
+    uint32  i;
+
+    // Payload sizes of an AMR-WB frame, a sensor report, and a TCP segment
+    if(ROHC_BENCH_FLOW_UDP == type)
+    {
+        N_data = 20 + (liblte_bench_rand(seed) % 40);
+    }else if(ROHC_BENCH_FLOW_ESP == type){
+        N_data   = 64 + (liblte_bench_rand(seed) % 64);
+        protocol = 50;
+    }else if(ROHC_BENCH_FLOW_TCP == type){
+        N_data   = 1000;
+        protocol = 6;
+    }else{
+        hdr_len = 40;
+    }
+
+    // IPv4
+    msg[0] = 0x45;
+    msg[1] = 0;
+    put_16(&msg[2], hdr_len + N_data);
+    put_16(&msg[4], state->ip_id);
+    msg[6] = 0x40;
+    msg[7] = 0;
+    msg[8] = 64;
+    msg[9] = protocol;
+    put_16(&msg[10], 0);
+    put_32(&msg[12], 0x0A000001 + type);
+    put_32(&msg[16], 0xC0A80001);
+    for(i=0; i<20; i+=2)
+    {
+        sum += (msg[i] << 8) | msg[i+1];
+    }
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    put_16(&msg[10], ~sum);
+
+    if(ROHC_BENCH_FLOW_ESP == type)
+    {
+        put_32(&msg[20], 0x1000 + type);
+        put_32(&msg[24], state->sn);
+    }else{
+        put_16(&msg[20], 5000 + type);
+        put_16(&msg[22], 6000);
+        put_16(&msg[24], hdr_len + N_data - 20);
+        put_16(&msg[26], 0);
+        if(ROHC_BENCH_FLOW_VOIP == type)
+        {
+            // UDP checksums are carried in every packet
+            put_16(&msg[26], liblte_bench_rand(seed) | 1);
+            msg[28] = 0x80;
+            msg[29] = 96;
+            put_16(&msg[30], state->sn);
+            put_32(&msg[32], state->ts);
+            put_32(&msg[36], 0x12345678);
+        }
+    }
+    for(i=0; i<N_data; i++)
+    {
+        msg[hdr_len + i] = liblte_bench_rand(seed);
+    }
+    pkt->N_bytes = hdr_len + N_data;
+
+    // Every 100th VoIP packet follows a talk spurt gap with the marker set
+    state->sn    = (state->sn + 1) & ((ROHC_BENCH_FLOW_ESP == type) ? 0xFFFFFFFF : 0xFFFF);
+    state->ts   += 160;
+    state->ip_id = state->ip_id + 1;
+    if(ROHC_BENCH_FLOW_VOIP == type &&
+       0 == (state->sn % 100))
+    {
+        state->ts += 160*25;
+        msg[29]   |= 0x80;
+    }
+
+    return(hdr_len);
+}
+
+/*********************************************************************
+    Name: run_flow
+
+    Description: Runs N_pkts packets of a flow through a fresh
+                 compressor and decompressor, dropping loss_percent of
+                 the compressed packets.  With feedback, the
+                 decompressor's feedback is delivered straight back to
+                 the compressor.
+*********************************************************************/
+void run_flow(ROHC_BENCH_FLOW_ENUM      type,
+              uint32                    N_pkts,
+              uint32                    loss_percent,
+              bool                      fb,
+              ROHC_BENCH_RESULT_STRUCT *result)
+{
+    ROHC_BENCH_FLOW_STATE_STRUCT state;
+    LIBLTE_ERROR_ENUM            err;
+    uint64                       start;
+    uint32                       seed = 1;
+    uint32                       hdr_len;
+    uint32                       i;
+
+    liblte_rohc_comp_init(&comp, LIBLTE_ROHC_MAX_CID, ROHC_BENCH_PROFILES);
+    liblte_rohc_decomp_init(&decomp, LIBLTE_ROHC_MAX_CID, ROHC_BENCH_PROFILES, fb);
+    memset(result, 0, sizeof(ROHC_BENCH_RESULT_STRUCT));
+    state.sn    = 0xFFF0;
+    state.ts    = 0xFFFFF000;
+    state.ip_id = 0x1234;
+
+    for(i=0; i<N_pkts; i++)
+    {
+        hdr_len = build_pkt(type, &state, &seed, &ip_pkt);
+
+        start = liblte_bench_get_time_ns();
+        liblte_rohc_compress(&comp, &ip_pkt, &rohc_pkt);
+        result->comp_ns += liblte_bench_get_time_ns() - start;
+
+        result->N_pkts++;
+        result->N_hdr_bytes  += hdr_len;
+        result->N_ip_bytes   += ip_pkt.N_bytes;
+        result->N_rohc_bytes += rohc_pkt.N_bytes;
+        if((liblte_bench_rand(&seed) % 100) >= loss_percent)
+        {
+            start = liblte_bench_get_time_ns();
+            err   = liblte_rohc_decompress(&decomp, &rohc_pkt, &out_pkt, &feedback);
+            result->decomp_ns += liblte_bench_get_time_ns() - start;
+            if(LIBLTE_SUCCESS == err)
+            {
+                result->N_ok++;
+                if(out_pkt.N_bytes != ip_pkt.N_bytes ||
+                   0               != memcmp(out_pkt.msg, ip_pkt.msg, ip_pkt.N_bytes))
+                {
+                    result->N_mismatch++;
+                }
+            }
+            if(0 != feedback.N_bytes)
+            {
+                liblte_rohc_comp_handle_feedback(&comp, &feedback);
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    ROHC_BENCH_RESULT_STRUCT result;
+    uint32                   N_pkts = ROHC_BENCH_DEFAULT_N_PKTS;
+    uint32                   f;
+    uint32                   pass;
+    float                    rohc_hdr;
+    bool                     fail   = false;
+
+    if(argc > 1)
+    {
+        N_pkts = atoi(argv[1]);
+    }
+
+    printf("%u packets per flow\n", N_pkts);
+    printf("%-18s %-10s %8s %8s %8s %10s %10s %9s\n",
+           "flow", "channel", "hdr (B)", "rohc (B)", "saved", "comp pps", "decomp pps", "delivered");
+    for(pass=0; pass<3; pass++)
+    {
+        for(f=0; f<ROHC_BENCH_FLOW_N_ITEMS; f++)
+        {
+            // Lossless U-mode, lossy U-mode, and lossy O-mode
+            run_flow((ROHC_BENCH_FLOW_ENUM)f,
+                     N_pkts,
+                     (0 == pass) ? 0 : ROHC_BENCH_LOSS_PERCENT,
+                     (2 == pass),
+                     &result);
+            rohc_hdr = (float)result.N_rohc_bytes - (float)(result.N_ip_bytes - result.N_hdr_bytes);
+            printf("%-18s %-10s %8.2f %8.2f %7.1f%% %10.0f %10.0f %8.2f%%\n",
+                   rohc_bench_flow_text[f],
+                   (0 == pass) ? "lossless" : ((1 == pass) ? "lossy U" : "lossy O"),
+                   (float)result.N_hdr_bytes/(float)result.N_pkts,
+                   rohc_hdr/(float)result.N_pkts,
+                   100.0*(1 - rohc_hdr/(float)result.N_hdr_bytes),
+                   (float)result.N_pkts*1e9/(float)(result.comp_ns + 1),
+                   (float)result.N_ok*1e9/(float)(result.decomp_ns + 1),
+                   100.0*(float)result.N_ok/(float)result.N_pkts);
+            if(0 != result.N_mismatch)
+            {
+                printf("%u packets not restored byte for byte\n", result.N_mismatch);
+                fail = true;
+            }
+            if(0 == pass &&
+               result.N_ok != result.N_pkts)
+            {
+                printf("%u packets lost on a lossless channel\n", result.N_pkts - result.N_ok);
+                fail = true;
+            }
+        }
+    }
+
+    if(fail)
+    {
+        return(1);
+    }
+    return(0);
+}
@@ -0,0 +1,501 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_rrc_bench.cc
+
+    Description: Packs and unpacks the MIB, SIB1, SIB2, RRC Connection
+                 Setup, and RRC Connection Reconfiguration the eNodeB
+                 sends, checks that every message survives a pack,
+                 unpack, and repack unchanged, and reports messages per
+                 second in both directions.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_bench_common.h"
+#include "liblte_rrc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define RRC_BENCH_DEFAULT_N_MSGS 200000
+#define RRC_BENCH_N_NAS_BYTES    64
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef enum{
+    RRC_BENCH_MSG_MIB = 0,
+    RRC_BENCH_MSG_SIB1,
+    RRC_BENCH_MSG_SIB2,
+    RRC_BENCH_MSG_RRC_CON_SETUP,
+    RRC_BENCH_MSG_RRC_CON_RECONFIG,
+    RRC_BENCH_MSG_N_ITEMS,
+}RRC_BENCH_MSG_ENUM;
+static const char rrc_bench_msg_text[RRC_BENCH_MSG_N_ITEMS][40] = {"MIB",
+                                                                   "SIB1",
+                                                                   "SIB2",
+                                                                   "RRC Connection Setup",
+                                                                   "RRC Connection Reconfig"};
+
+typedef struct{
+    uint64 pack_ns;
+    uint64 unpack_ns;
+    uint32 N_bits;
+    bool   mismatch;
+}RRC_BENCH_RESULT_STRUCT;
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+LIBLTE_RRC_MIB_STRUCT            mib;
+LIBLTE_RRC_BCCH_DLSCH_MSG_STRUCT sib1_msg;
+LIBLTE_RRC_BCCH_DLSCH_MSG_STRUCT sib2_msg;
+LIBLTE_RRC_DL_CCCH_MSG_STRUCT    dl_ccch_msg;
+LIBLTE_RRC_DL_DCCH_MSG_STRUCT    dl_dcch_msg;
+LIBLTE_RRC_MIB_STRUCT            rx_mib;
+LIBLTE_RRC_BCCH_DLSCH_MSG_STRUCT rx_bcch_dlsch_msg;
+LIBLTE_RRC_DL_CCCH_MSG_STRUCT    rx_dl_ccch_msg;
+LIBLTE_RRC_DL_DCCH_MSG_STRUCT    rx_dl_dcch_msg;
+LIBLTE_BIT_MSG_STRUCT            bits;
+LIBLTE_BIT_MSG_STRUCT            rx_bits;
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: fill_mib/fill_sibs
+
+    Description: Fills the broadcast messages the way the eNodeB
+                 configures them for a 10MHz band 13 cell
+*********************************************************************/
+void fill_mib(void)
+{
+    mib.dl_bw            = LIBLTE_RRC_DL_BANDWIDTH_50;
+    mib.phich_config.dur = LIBLTE_RRC_PHICH_DURATION_NORMAL;
+    mib.phich_config.res = LIBLTE_RRC_PHICH_RESOURCE_1;
+    mib.sfn_div_4        = 173;
+}
+void fill_sibs(void)
+{
+    LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1_STRUCT *sib1 = (LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1_STRUCT *)&sib1_msg.sibs[0].sib;
+    LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2_STRUCT *sib2 = (LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2_STRUCT *)&sib2_msg.sibs[0].sib;
+
+    sib1_msg.N_sibs                                 = 0;
+    sib1_msg.sibs[0].sib_type                       = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1;
+    sib1->N_plmn_ids                                = 2;
+    sib1->plmn_id[0].id.mcc                         = 0xF001;
+    sib1->plmn_id[0].id.mnc                         = 0xFF01;
+    sib1->plmn_id[0].resv_for_oper                  = LIBLTE_RRC_NOT_RESV_FOR_OPER;
+    sib1->plmn_id[1].id.mcc                         = 0xF310;
+    sib1->plmn_id[1].id.mnc                         = 0xF410;
+    sib1->plmn_id[1].resv_for_oper                  = LIBLTE_RRC_NOT_RESV_FOR_OPER;
+    sib1->tracking_area_code                        = 1;
+    sib1->cell_id                                   = 1;
+    sib1->cell_barred                               = LIBLTE_RRC_CELL_NOT_BARRED;
+    sib1->intra_freq_reselection                    = LIBLTE_RRC_INTRA_FREQ_RESELECTION_ALLOWED;
+    sib1->csg_indication                            = 0;
+    sib1->csg_id                                    = 0;
+    sib1->q_rx_lev_min                              = -140;
+    sib1->q_rx_lev_min_offset                       = 1;
+    sib1->p_max_present                             = true;
+    sib1->p_max                                     = 23;
+    sib1->freq_band_indicator                       = 13;
+    sib1->N_sched_info                              = 2;
+    sib1->sched_info[0].si_periodicity              = LIBLTE_RRC_SI_PERIODICITY_RF8;
+    sib1->sched_info[0].N_sib_mapping_info          = 0;
+    sib1->sched_info[1].si_periodicity              = LIBLTE_RRC_SI_PERIODICITY_RF16;
+    sib1->sched_info[1].N_sib_mapping_info          = 2;
+    sib1->sched_info[1].sib_mapping_info[0].sib_type = LIBLTE_RRC_SIB_TYPE_3;
+    sib1->sched_info[1].sib_mapping_info[1].sib_type = LIBLTE_RRC_SIB_TYPE_4;
+    sib1->tdd                                       = false;
+    sib1->si_window_length                          = LIBLTE_RRC_SI_WINDOW_LENGTH_MS2;
+    sib1->system_info_value_tag                     = 7;
+
+    sib2_msg.N_sibs                                                                   = 1;
+    sib2_msg.sibs[0].sib_type                                                         = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2;
+    sib2->ac_barring_info_present                                                     = false;
+    sib2->rr_config_common_sib.rach_cnfg.num_ra_preambles                              = LIBLTE_RRC_NUMBER_OF_RA_PREAMBLES_N4;
+    sib2->rr_config_common_sib.rach_cnfg.preambles_group_a_cnfg.present                = false;
+    sib2->rr_config_common_sib.rach_cnfg.pwr_ramping_step                              = LIBLTE_RRC_POWER_RAMPING_STEP_DB6;
+    sib2->rr_config_common_sib.rach_cnfg.preamble_init_rx_target_pwr                   = LIBLTE_RRC_PREAMBLE_INITIAL_RECEIVED_TARGET_POWER_DBM_N90;
+    sib2->rr_config_common_sib.rach_cnfg.preamble_trans_max                            = LIBLTE_RRC_PREAMBLE_TRANS_MAX_N200;
+    sib2->rr_config_common_sib.rach_cnfg.ra_resp_win_size                              = LIBLTE_RRC_RA_RESPONSE_WINDOW_SIZE_SF7;
+    sib2->rr_config_common_sib.rach_cnfg.mac_con_res_timer                             = LIBLTE_RRC_MAC_CONTENTION_RESOLUTION_TIMER_SF64;
+    sib2->rr_config_common_sib.rach_cnfg.max_harq_msg3_tx                              = 1;
+    sib2->rr_config_common_sib.bcch_cnfg.modification_period_coeff                     = LIBLTE_RRC_MODIFICATION_PERIOD_COEFF_N2;
+    sib2->rr_config_common_sib.pcch_cnfg.default_paging_cycle                          = LIBLTE_RRC_DEFAULT_PAGING_CYCLE_RF256;
+    sib2->rr_config_common_sib.pcch_cnfg.nB                                            = LIBLTE_RRC_NB_ONE_T;
+    sib2->rr_config_common_sib.prach_cnfg.root_sequence_index                          = 0;
+    sib2->rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_config_index           = 0;
+    sib2->rr_config_common_sib.prach_cnfg.prach_cnfg_info.high_speed_flag              = false;
+    sib2->rr_config_common_sib.prach_cnfg.prach_cnfg_info.zero_correlation_zone_config = 1;
+    sib2->rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_freq_offset            = 0;
+    sib2->rr_config_common_sib.pdsch_cnfg.rs_power                                     = 0;
+    sib2->rr_config_common_sib.pdsch_cnfg.p_b                                          = 0;
+    sib2->rr_config_common_sib.pusch_cnfg.n_sb                                         = 1;
+    sib2->rr_config_common_sib.pusch_cnfg.hopping_mode                                 = LIBLTE_RRC_HOPPING_MODE_INTER_SUBFRAME;
+    sib2->rr_config_common_sib.pusch_cnfg.pusch_hopping_offset                         = 0;
+    sib2->rr_config_common_sib.pusch_cnfg.enable_64_qam                                = true;
+    sib2->rr_config_common_sib.pusch_cnfg.ul_rs.group_hopping_enabled                  = false;
+    sib2->rr_config_common_sib.pusch_cnfg.ul_rs.group_assignment_pusch                 = 0;
+    sib2->rr_config_common_sib.pusch_cnfg.ul_rs.sequence_hopping_enabled               = false;
+    sib2->rr_config_common_sib.pusch_cnfg.ul_rs.cyclic_shift                           = 0;
+    sib2->rr_config_common_sib.pucch_cnfg.delta_pucch_shift                            = LIBLTE_RRC_DELTA_PUCCH_SHIFT_DS1;
+    sib2->rr_config_common_sib.pucch_cnfg.n_rb_cqi                                     = 1;
+    sib2->rr_config_common_sib.pucch_cnfg.n_cs_an                                      = 0;
+    sib2->rr_config_common_sib.pucch_cnfg.n1_pucch_an                                  = 4;
+    sib2->rr_config_common_sib.srs_ul_cnfg.present                                     = false;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.p0_nominal_pusch                            = -70;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.alpha                                       = LIBLTE_RRC_UL_POWER_CONTROL_ALPHA_1;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.p0_nominal_pucch                            = -96;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_1                  = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_1_0;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_1b                 = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_1B_1;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_2                  = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_2_0;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_2a                 = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_2A_0;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_2b                 = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_2B_0;
+    sib2->rr_config_common_sib.ul_pwr_ctrl.delta_preamble_msg3                         = -2;
+    sib2->rr_config_common_sib.ul_cp_length                                            = LIBLTE_RRC_UL_CP_LENGTH_1;
+    sib2->ue_timers_and_constants.t300                                                 = LIBLTE_RRC_T300_MS1000;
+    sib2->ue_timers_and_constants.t301                                                 = LIBLTE_RRC_T301_MS1000;
+    sib2->ue_timers_and_constants.t310                                                 = LIBLTE_RRC_T310_MS1000;
+    sib2->ue_timers_and_constants.n310                                                 = LIBLTE_RRC_N310_N20;
+    sib2->ue_timers_and_constants.t311                                                 = LIBLTE_RRC_T311_MS30000;
+    sib2->ue_timers_and_constants.n311                                                 = LIBLTE_RRC_N311_N1;
+    sib2->arfcn_value_eutra.present                                                    = false;
+    sib2->ul_bw.present                                                                = false;
+    sib2->additional_spectrum_emission                                                 = 1;
+    sib2->mbsfn_subfr_cnfg_list_size                                                   = 0;
+    sib2->time_alignment_timer                                                         = LIBLTE_RRC_TIME_ALIGNMENT_TIMER_SF500;
+}
+
+/*********************************************************************
+    Name: fill_rrc_con_setup/fill_rrc_con_reconfig
+
+    Description: Fills the dedicated messages the way the eNodeB sends
+                 them when a UE attaches with two data bearers
+*********************************************************************/
+void fill_rrc_con_setup(void)
+{
+    LIBLTE_RRC_CONNECTION_SETUP_STRUCT         *rrc_con_setup = &dl_ccch_msg.msg.rrc_con_setup;
+    LIBLTE_RRC_PHYSICAL_CONFIG_DEDICATED_STRUCT *phy_cnfg_ded = &rrc_con_setup->rr_cnfg.phy_cnfg_ded;
+
+    dl_ccch_msg.msg_type                                                                       = LIBLTE_RRC_DL_CCCH_MSG_TYPE_RRC_CON_SETUP;
+    rrc_con_setup->rrc_transaction_id                                                         = 1;
+    rrc_con_setup->rr_cnfg.srb_to_add_mod_list_size                                           = 1;
+    rrc_con_setup->rr_cnfg.srb_to_add_mod_list[0].srb_id                                      = 1;
+    rrc_con_setup->rr_cnfg.srb_to_add_mod_list[0].rlc_cnfg_present                            = true;
+    rrc_con_setup->rr_cnfg.srb_to_add_mod_list[0].rlc_default_cnfg_present                    = true;
+    rrc_con_setup->rr_cnfg.srb_to_add_mod_list[0].lc_cnfg_present                             = true;
+    rrc_con_setup->rr_cnfg.srb_to_add_mod_list[0].lc_default_cnfg_present                     = true;
+    rrc_con_setup->rr_cnfg.drb_to_add_mod_list_size                                           = 0;
+    rrc_con_setup->rr_cnfg.drb_to_release_list_size                                           = 0;
+    rrc_con_setup->rr_cnfg.mac_main_cnfg_present                                              = true;
+    rrc_con_setup->rr_cnfg.mac_main_cnfg.default_value                                        = false;
+    rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg_present                    = true;
+    rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg.max_harq_tx_present        = true;
+    rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg.max_harq_tx                = LIBLTE_RRC_MAX_HARQ_TX_N4;
+    rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg.periodic_bsr_timer_present = false;
+    rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg.retx_bsr_timer             = LIBLTE_RRC_RETRANSMISSION_BSR_TIMER_SF1280;
+    rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.ulsch_cnfg.tti_bundling               = false;
+    rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.drx_cnfg_present                      = false;
+    rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.phr_cnfg_present                      = false;
+    rrc_con_setup->rr_cnfg.mac_main_cnfg.explicit_value.time_alignment_timer                  = LIBLTE_RRC_TIME_ALIGNMENT_TIMER_SF500;
+    rrc_con_setup->rr_cnfg.sps_cnfg_present                                                   = false;
+    rrc_con_setup->rr_cnfg.phy_cnfg_ded_present                                               = true;
+    rrc_con_setup->rr_cnfg.rlf_timers_and_constants_present                                   = false;
+    phy_cnfg_ded->pdsch_cnfg_ded_present                                                      = false;
+    phy_cnfg_ded->pucch_cnfg_ded_present                                                      = false;
+    phy_cnfg_ded->pusch_cnfg_ded_present                                                      = false;
+    phy_cnfg_ded->ul_pwr_ctrl_ded_present                                                     = false;
+    phy_cnfg_ded->tpc_pdcch_cnfg_pucch_present                                                = false;
+    phy_cnfg_ded->tpc_pdcch_cnfg_pusch_present                                                = false;
+    phy_cnfg_ded->cqi_report_cnfg_present                                                     = true;
+    phy_cnfg_ded->cqi_report_cnfg.report_mode_aperiodic_present                               = false;
+    phy_cnfg_ded->cqi_report_cnfg.nom_pdsch_rs_epre_offset                                    = 0;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic_present                                     = true;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic_setup_present                               = true;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic.pucch_resource_idx                          = 2;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic.pmi_cnfg_idx                                = 22;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic.format_ind_periodic                         = LIBLTE_RRC_CQI_FORMAT_INDICATOR_PERIODIC_WIDEBAND_CQI;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic.ri_cnfg_idx_present                         = false;
+    phy_cnfg_ded->cqi_report_cnfg.report_periodic.simult_ack_nack_and_cqi                     = false;
+    phy_cnfg_ded->srs_ul_cnfg_ded_present                                                     = false;
+    phy_cnfg_ded->antenna_info_present                                                        = false;
+    phy_cnfg_ded->sched_request_cnfg_present                                                  = true;
+    phy_cnfg_ded->sched_request_cnfg.setup_present                                            = true;
+    phy_cnfg_ded->sched_request_cnfg.sr_pucch_resource_idx                                    = 1;
+    phy_cnfg_ded->sched_request_cnfg.sr_cnfg_idx                                              = 7;
+    phy_cnfg_ded->sched_request_cnfg.dsr_trans_max                                            = LIBLTE_RRC_DSR_TRANS_MAX_N64;
+}
+void fill_rrc_con_reconfig(void)
+{
+    LIBLTE_RRC_CONNECTION_RECONFIGURATION_STRUCT *rrc_con_recnfg = &dl_dcch_msg.msg.rrc_con_reconfig;
+    LIBLTE_RRC_DRB_TO_ADD_MOD_STRUCT             *drb;
+    uint32                                        seed           = 1;
+    uint32                                        i;
+
+    dl_dcch_msg.msg_type                                                        = LIBLTE_RRC_DL_DCCH_MSG_TYPE_RRC_CON_RECONFIG;
+    rrc_con_recnfg->rrc_transaction_id                                          = 2;
+    rrc_con_recnfg->meas_cnfg_present                                           = false;
+    rrc_con_recnfg->mob_ctrl_info_present                                       = false;
+    rrc_con_recnfg->N_ded_info_nas                                              = 1;
+    rrc_con_recnfg->ded_info_nas_list[0].N_bytes                                = RRC_BENCH_N_NAS_BYTES;
+    rrc_con_recnfg->rr_cnfg_ded_present                                         = true;
+    rrc_con_recnfg->rr_cnfg_ded.srb_to_add_mod_list_size                        = 1;
+    rrc_con_recnfg->rr_cnfg_ded.srb_to_add_mod_list[0].srb_id                   = 2;
+    rrc_con_recnfg->rr_cnfg_ded.srb_to_add_mod_list[0].rlc_cnfg_present         = true;
+    rrc_con_recnfg->rr_cnfg_ded.srb_to_add_mod_list[0].rlc_default_cnfg_present = true;
+    rrc_con_recnfg->rr_cnfg_ded.srb_to_add_mod_list[0].lc_cnfg_present          = true;
+    rrc_con_recnfg->rr_cnfg_ded.srb_to_add_mod_list[0].lc_default_cnfg_present  = true;
+    rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list_size                        = 2;
+    for(i=0; i<RRC_BENCH_N_NAS_BYTES; i++)
+    {
+        rrc_con_recnfg->ded_info_nas_list[0].msg[i] = liblte_bench_rand(&seed);
+    }
+    for(i=0; i<rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list_size; i++)
+    {
+        drb                                                    = &rrc_con_recnfg->rr_cnfg_ded.drb_to_add_mod_list[i];
+        drb->eps_bearer_id_present                             = true;
+        drb->eps_bearer_id                                     = 5 + i;
+        drb->drb_id                                            = 1 + i;
+        drb->pdcp_cnfg_present                                 = true;
+        drb->pdcp_cnfg.discard_timer_present                   = true;
+        drb->pdcp_cnfg.discard_timer                           = LIBLTE_RRC_DISCARD_TIMER_INFINITY;
+        drb->pdcp_cnfg.rlc_am_status_report_required_present   = false;
+        drb->pdcp_cnfg.rlc_um_pdcp_sn_size_present             = true;
+        drb->pdcp_cnfg.rlc_um_pdcp_sn_size                     = LIBLTE_RRC_PDCP_SN_SIZE_12_BITS;
+        drb->pdcp_cnfg.hdr_compression_rohc                    = (1 == i);
+        drb->pdcp_cnfg.hdr_compression_max_cid                 = 15;
+        drb->pdcp_cnfg.hdr_compression_profile_0001            = true;
+        drb->pdcp_cnfg.hdr_compression_profile_0002            = true;
+        drb->pdcp_cnfg.hdr_compression_profile_0003            = true;
+        drb->rlc_cnfg_present                                  = true;
+        drb->rlc_cnfg.rlc_mode                                 = LIBLTE_RRC_RLC_MODE_UM_BI;
+        drb->rlc_cnfg.ul_um_bi_rlc.sn_field_len                = LIBLTE_RRC_SN_FIELD_LENGTH_SIZE10;
+        drb->rlc_cnfg.dl_um_bi_rlc.sn_field_len                = LIBLTE_RRC_SN_FIELD_LENGTH_SIZE10;
+        drb->rlc_cnfg.dl_um_bi_rlc.t_reordering                = LIBLTE_RRC_T_REORDERING_MS50;
+        drb->lc_id_present                                     = true;
+        drb->lc_id                                             = 3 + i;
+        drb->lc_cnfg_present                                   = true;
+        drb->lc_cnfg.ul_specific_params_present                = true;
+        drb->lc_cnfg.ul_specific_params.priority               = 13;
+        drb->lc_cnfg.ul_specific_params.prioritized_bit_rate   = LIBLTE_RRC_PRIORITIZED_BIT_RATE_INFINITY;
+        drb->lc_cnfg.ul_specific_params.bucket_size_duration   = LIBLTE_RRC_BUCKET_SIZE_DURATION_MS100;
+        drb->lc_cnfg.ul_specific_params.log_chan_group_present = true;
+        drb->lc_cnfg.ul_specific_params.log_chan_group         = 3;
+        drb->lc_cnfg.log_chan_sr_mask_present                  = false;
+    }
+    rrc_con_recnfg->rr_cnfg_ded.drb_to_release_list_size         = 0;
+    rrc_con_recnfg->rr_cnfg_ded.mac_main_cnfg_present            = false;
+    rrc_con_recnfg->rr_cnfg_ded.sps_cnfg_present                 = false;
+    rrc_con_recnfg->rr_cnfg_ded.phy_cnfg_ded_present             = false;
+    rrc_con_recnfg->rr_cnfg_ded.rlf_timers_and_constants_present = false;
+    rrc_con_recnfg->sec_cnfg_ho_present                          = false;
+}
+
+/*********************************************************************
+    Name: pack_msg/unpack_msg
+
+    Description: Packs one of the benchmarked messages into bits, or
+                 unpacks it from them
+*********************************************************************/
+LIBLTE_ERROR_ENUM pack_msg(RRC_BENCH_MSG_ENUM     type,
+                           LIBLTE_BIT_MSG_STRUCT *bit_msg)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    switch(type)
+    {
+    case RRC_BENCH_MSG_MIB:
+        err = liblte_rrc_pack_bcch_bch_msg(&mib, bit_msg);
+        break;
+    case RRC_BENCH_MSG_SIB1:
+        err = liblte_rrc_pack_bcch_dlsch_msg(&sib1_msg, bit_msg);
+        break;
+    case RRC_BENCH_MSG_SIB2:
+        err = liblte_rrc_pack_bcch_dlsch_msg(&sib2_msg, bit_msg);
+        break;
+    case RRC_BENCH_MSG_RRC_CON_SETUP:
+        err = liblte_rrc_pack_dl_ccch_msg(&dl_ccch_msg, bit_msg);
+        break;
+    case RRC_BENCH_MSG_RRC_CON_RECONFIG:
+        err = liblte_rrc_pack_dl_dcch_msg(&dl_dcch_msg, bit_msg);
+        break;
+    default:
+        break;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM unpack_msg(RRC_BENCH_MSG_ENUM     type,
+                             LIBLTE_BIT_MSG_STRUCT *bit_msg)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    switch(type)
+    {
+    case RRC_BENCH_MSG_MIB:
+        err = liblte_rrc_unpack_bcch_bch_msg(bit_msg, &rx_mib);
+        break;
+    case RRC_BENCH_MSG_SIB1:
+    case RRC_BENCH_MSG_SIB2:
+        err = liblte_rrc_unpack_bcch_dlsch_msg(bit_msg, &rx_bcch_dlsch_msg);
+        break;
+    case RRC_BENCH_MSG_RRC_CON_SETUP:
+        err = liblte_rrc_unpack_dl_ccch_msg(bit_msg, &rx_dl_ccch_msg);
+        break;
+    case RRC_BENCH_MSG_RRC_CON_RECONFIG:
+        err = liblte_rrc_unpack_dl_dcch_msg(bit_msg, &rx_dl_dcch_msg);
+        break;
+    default:
+        break;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: repack_msg
+
+    Description: Packs the last unpacked message again
+*********************************************************************/
+LIBLTE_ERROR_ENUM repack_msg(RRC_BENCH_MSG_ENUM     type,
+                             LIBLTE_BIT_MSG_STRUCT *bit_msg)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    switch(type)
+    {
+    case RRC_BENCH_MSG_MIB:
+        err = liblte_rrc_pack_bcch_bch_msg(&rx_mib, bit_msg);
+        break;
+    case RRC_BENCH_MSG_SIB1:
+    case RRC_BENCH_MSG_SIB2:
+        err = liblte_rrc_pack_bcch_dlsch_msg(&rx_bcch_dlsch_msg, bit_msg);
+        break;
+    case RRC_BENCH_MSG_RRC_CON_SETUP:
+        err = liblte_rrc_pack_dl_ccch_msg(&rx_dl_ccch_msg, bit_msg);
+        break;
+    case RRC_BENCH_MSG_RRC_CON_RECONFIG:
+        err = liblte_rrc_pack_dl_dcch_msg(&rx_dl_dcch_msg, bit_msg);
+        break;
+    default:
+        break;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: run_msg
+
+    Description: Times N_msgs packs and unpacks of a message, then
+                 checks that it repacks to the same bits
+*********************************************************************/
+void run_msg(RRC_BENCH_MSG_ENUM       type,
+             uint32                   N_msgs,
+             RRC_BENCH_RESULT_STRUCT *result)
+{
+    LIBLTE_ERROR_ENUM err;
+    uint64            start;
+    uint32            i;
+
+    memset(result, 0, sizeof(RRC_BENCH_RESULT_STRUCT));
+
+    start = liblte_bench_get_time_ns();
+    for(i=0; i<N_msgs; i++)
+    {
+        pack_msg(type, &bits);
+    }
+    result->pack_ns = liblte_bench_get_time_ns() - start;
+    result->N_bits  = bits.N_bits;
+
+    start = liblte_bench_get_time_ns();
+    for(i=0; i<N_msgs; i++)
+    {
+        unpack_msg(type, &bits);
+    }
+    result->unpack_ns = liblte_bench_get_time_ns() - start;
+
+    err = repack_msg(type, &rx_bits);
+    if(LIBLTE_SUCCESS != err)
+    {
+        result->mismatch = true;
+    }else{
+        result->mismatch = (rx_bits.N_bits != bits.N_bits ||
+                            0              != memcmp(rx_bits.msg, bits.msg, bits.N_bits));
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    RRC_BENCH_RESULT_STRUCT result;
+    uint32                  N_msgs = RRC_BENCH_DEFAULT_N_MSGS;
+    uint32                  m;
+    bool                    fail   = false;
+
+    if(argc > 1)
+    {
+        N_msgs = atoi(argv[1]);
+    }
+
+    fill_mib();
+    fill_sibs();
+    fill_rrc_con_setup();
+    fill_rrc_con_reconfig();
+
+    printf("%u messages per type\n", N_msgs);
+    printf("%-24s %6s %12s %12s\n",
+           "message", "bits", "pack msg/s", "unpack msg/s");
+    for(m=0; m<RRC_BENCH_MSG_N_ITEMS; m++)
+    {
+        run_msg((RRC_BENCH_MSG_ENUM)m, N_msgs, &result);
+        printf("%-24s %6u %12.0f %12.0f\n",
+               rrc_bench_msg_text[m],
+               result.N_bits,
+               (float)N_msgs*1e9/(float)(result.pack_ns + 1),
+               (float)N_msgs*1e9/(float)(result.unpack_ns + 1));
+        if(result.mismatch)
+        {
+            printf("%s did not repack to the same bits\n", rrc_bench_msg_text[m]);
+            fail = true;
+        }
+    }
+
+    if(fail)
+    {
+        return(1);
+    }
+    return(0);
+}
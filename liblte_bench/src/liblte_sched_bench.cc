@@ -0,0 +1,277 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_sched_bench.cc
+
+    Description: Simulates a downlink cell with full buffer users over
+                 a Rayleigh fading channel and reports cell throughput,
+                 Jain fairness, and scheduler CPU time per TTI for each
+                 scheduling policy and resource allocation type.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_bench_common.h"
+#include "liblte_mac.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define SCHED_BENCH_DEFAULT_N_TTI  2000
+#define SCHED_BENCH_N_RB           50
+#define SCHED_BENCH_MAX_GRANTS     10
+#define SCHED_BENCH_MIN_SNR_DB     -5.0
+#define SCHED_BENCH_MAX_SNR_DB     25.0
+#define SCHED_BENCH_FADING_CORR    0.9
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef struct{
+    float  mean_snr_db;
+    float  h_re;
+    float  h_im;
+    uint64 N_bits;
+}SCHED_BENCH_UE_STRUCT;
+
+typedef struct{
+    float tput_mbps;
+    float fairness;
+    float us_per_tti;
+    bool  overlap;
+}SCHED_BENCH_RESULT_STRUCT;
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+// SNR thresholds (dB) for reporting CQI 1 to 15
+float  cqi_snr_thresh[15] = {-6.7, -4.7, -2.3,  0.2,  2.4,  4.3,  5.9,  8.1,
+                             10.3, 11.7, 14.1, 16.3, 18.7, 21.0, 22.7};
+uint32 n_ue_list[]        = {1, 2, 5, 10, 20, 50, 100, 200};
+
+LIBLTE_MAC_SCHED_UE_STRUCT    sched_ue[LIBLTE_MAC_SCHED_N_UE_MAX];
+SCHED_BENCH_UE_STRUCT         bench_ue[LIBLTE_MAC_SCHED_N_UE_MAX];
+LIBLTE_MAC_SCHED_GRANT_STRUCT grant[SCHED_BENCH_MAX_GRANTS];
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: random_gauss
+
+    Description: Returns a zero mean, unit variance gaussian sample
+*********************************************************************/
+float random_gauss(uint32 *seed)
+{
+    float u1 = ((float)(liblte_bench_rand(seed) >> 8) + 1) / 16777217.0;
+    float u2 = ((float)(liblte_bench_rand(seed) >> 8) + 1) / 16777217.0;
+
+    return(sqrt(-2*log(u1))*cos(2*M_PI*u2));
+}
+
+/*********************************************************************
+    Name: update_channel
+
+    Description: Advances the Rayleigh fading gain of a user by one
+                 TTI and returns the wideband CQI it reports
+*********************************************************************/
+uint8 update_channel(SCHED_BENCH_UE_STRUCT *ue,
+                     uint32                *seed)
+{
+    float  rho = SCHED_BENCH_FADING_CORR;
+    float  sd  = sqrt((1 - rho*rho)/2);
+    float  snr_db;
+    uint8  cqi = 0;
+
+    ue->h_re = rho*ue->h_re + sd*random_gauss(seed);
+    ue->h_im = rho*ue->h_im + sd*random_gauss(seed);
+    snr_db   = ue->mean_snr_db + 10*log10(ue->h_re*ue->h_re + ue->h_im*ue->h_im + 1e-9);
+    while(cqi < 15 &&
+          snr_db >= cqi_snr_thresh[cqi])
+    {
+        cqi++;
+    }
+
+    return(cqi);
+}
+
+/*********************************************************************
+    Name: run_sim
+
+    Description: Runs N_tti TTIs of the cell with N_ue full buffer
+                 users.  The users and their fading are generated from
+                 the same seed for every policy, so results are
+                 comparable across rows.
+*********************************************************************/
+void run_sim(LIBLTE_MAC_SCHED_POLICY_ENUM  policy,
+             LIBLTE_MAC_RA_TYPE_ENUM       ra_type,
+             uint32                        N_ue,
+             uint32                        N_tti,
+             SCHED_BENCH_RESULT_STRUCT    *result)
+{
+    LIBLTE_MAC_SCHED_STRUCT    sched;
+    LIBLTE_MAC_PRB_MASK_STRUCT mask;
+    LIBLTE_MAC_PRB_MASK_STRUCT check;
+    uint64                     start;
+    uint64                     sched_ns = 0;
+    uint64                     total    = 0;
+    double                     sum      = 0;
+    double                     sum_sq   = 0;
+    uint32                     seed     = 1;
+    uint32                     N_grant;
+    uint32                     t;
+    uint32                     i;
+
+    liblte_mac_sched_init(&sched, policy, ra_type);
+    for(i=0; i<N_ue; i++)
+    {
+        liblte_mac_sched_ue_init(&sched_ue[i], LIBLTE_MAC_C_RNTI_START + i);
+        sched_ue[i].N_prb_min = 1;
+        sched_ue[i].N_prb_max = SCHED_BENCH_N_RB;
+        bench_ue[i].mean_snr_db = SCHED_BENCH_MIN_SNR_DB + (SCHED_BENCH_MAX_SNR_DB - SCHED_BENCH_MIN_SNR_DB)*(liblte_bench_rand(&seed) % 1000)/1000.0;
+        bench_ue[i].h_re        = random_gauss(&seed)/sqrt(2);
+        bench_ue[i].h_im        = random_gauss(&seed)/sqrt(2);
+        bench_ue[i].N_bits      = 0;
+    }
+
+    result->overlap = false;
+    for(t=0; t<N_tti; t++)
+    {
+        for(i=0; i<N_ue; i++)
+        {
+            sched_ue[i].cqi = update_channel(&bench_ue[i], &seed);
+        }
+
+        start = liblte_bench_get_time_ns();
+        liblte_mac_prb_mask_init(&mask, SCHED_BENCH_N_RB);
+        liblte_mac_sched_run(&sched,
+                             sched_ue,
+                             N_ue,
+                             &mask,
+                             SCHED_BENCH_MAX_GRANTS,
+                             grant,
+                             &N_grant);
+        sched_ns += liblte_bench_get_time_ns() - start;
+
+        // Every PRB may be granted to one user only
+        liblte_mac_prb_mask_init(&check, SCHED_BENCH_N_RB);
+        for(i=0; i<N_grant; i++)
+        {
+            if(!liblte_mac_prb_mask_is_free(&check, grant[i].rb_alloc.prb, grant[i].rb_alloc.N_prb))
+            {
+                result->overlap = true;
+            }
+            liblte_mac_prb_mask_set_list(&check, grant[i].rb_alloc.prb, grant[i].rb_alloc.N_prb);
+            bench_ue[grant[i].ue_idx].N_bits += grant[i].N_bits;
+        }
+    }
+
+    for(i=0; i<N_ue; i++)
+    {
+        total  += bench_ue[i].N_bits;
+        sum    += (double)bench_ue[i].N_bits;
+        sum_sq += (double)bench_ue[i].N_bits*(double)bench_ue[i].N_bits;
+    }
+
+    // Each TTI is 1ms
+    result->tput_mbps  = (float)total/(float)N_tti/1000;
+    result->fairness   = 0;
+    if(sum_sq > 0)
+    {
+        result->fairness = (float)(sum*sum/(N_ue*sum_sq));
+    }
+    result->us_per_tti = (float)sched_ns/(float)N_tti/1000;
+}
+
+int main(int argc, char *argv[])
+{
+    SCHED_BENCH_RESULT_STRUCT result[LIBLTE_MAC_SCHED_POLICY_N_ITEMS][LIBLTE_MAC_RA_TYPE_N_ITEMS];
+    uint32                    N_tti = SCHED_BENCH_DEFAULT_N_TTI;
+    uint32                    i;
+    uint32                    p;
+    uint32                    r;
+    bool                      fail  = false;
+
+    if(argc > 1)
+    {
+        N_tti = atoi(argv[1]);
+    }
+
+    printf("%u PRBs, %u TTIs, up to %u grants per TTI\n", SCHED_BENCH_N_RB, N_tti, SCHED_BENCH_MAX_GRANTS);
+    printf("%4s %-18s %-7s %12s %9s %10s\n",
+           "UEs", "policy", "RA", "tput (Mb/s)", "fairness", "us/TTI");
+    for(i=0; i<sizeof(n_ue_list)/sizeof(n_ue_list[0]); i++)
+    {
+        for(p=0; p<LIBLTE_MAC_SCHED_POLICY_N_ITEMS; p++)
+        {
+            for(r=0; r<LIBLTE_MAC_RA_TYPE_N_ITEMS; r++)
+            {
+                run_sim((LIBLTE_MAC_SCHED_POLICY_ENUM)p,
+                        (LIBLTE_MAC_RA_TYPE_ENUM)r,
+                        n_ue_list[i],
+                        N_tti,
+                        &result[p][r]);
+                printf("%4u %-18s %-7s %12.3f %9.3f %10.2f\n",
+                       n_ue_list[i],
+                       liblte_mac_sched_policy_text[p],
+                       liblte_mac_ra_type_text[r],
+                       result[p][r].tput_mbps,
+                       result[p][r].fairness,
+                       result[p][r].us_per_tti);
+                if(result[p][r].overlap)
+                {
+                    printf("PRB granted to more than one user\n");
+                    fail = true;
+                }
+            }
+        }
+
+        // Proportional fair must sit between the two extremes
+        for(r=0; r<LIBLTE_MAC_RA_TYPE_N_ITEMS; r++)
+        {
+            if(result[LIBLTE_MAC_SCHED_POLICY_PROPORTIONAL_FAIR][r].fairness + 0.01 < result[LIBLTE_MAC_SCHED_POLICY_MAX_CI][r].fairness ||
+               result[LIBLTE_MAC_SCHED_POLICY_PROPORTIONAL_FAIR][r].tput_mbps       > result[LIBLTE_MAC_SCHED_POLICY_MAX_CI][r].tput_mbps*1.01)
+            {
+                printf("proportional fair out of bounds for %u UEs, %s\n", n_ue_list[i], liblte_mac_ra_type_text[r]);
+                fail = true;
+            }
+        }
+    }
+
+    if(fail)
+    {
+        return(1);
+    }
+    return(0);
+}
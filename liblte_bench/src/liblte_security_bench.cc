@@ -0,0 +1,448 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_security_bench.cc
+
+    Description: Verifies the EEA1, EEA2, and EEA3 ciphering algorithms
+                 and the EIA2 integrity algorithm against the 3GPP test
+                 vectors and reports single core throughput for PDCP
+                 sized PDUs, both with a cached key context and batch
+                 API and with a key setup per PDU.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_bench_common.h"
+#include "liblte_security.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define SECURITY_BENCH_DEFAULT_N_MBYTES 64
+#define SECURITY_BENCH_BATCH_SIZE       16
+#define SECURITY_BENCH_MAX_PDU_SIZE     1500
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef LIBLTE_ERROR_ENUM (*SECURITY_BENCH_EEA_FUNC)(uint8*, uint32, uint8, uint8, uint8*, uint32, uint8*);
+
+typedef struct{
+    LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM alg;
+    uint8                                       key[16];
+    uint32                                      count;
+    uint8                                       bearer;
+    uint8                                       direction;
+    uint32                                      N_bits;
+    uint8                                       pt[32];
+    uint8                                       ct[32];
+}SECURITY_BENCH_VECTOR_STRUCT;
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+// 33.401 v10.0.0 Annex C.1 and 35.222 v11.0.0 Section 4.4, test set 1
+SECURITY_BENCH_VECTOR_STRUCT vectors[] = {{LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA1,
+                                           {0xD3,0xC5,0xD5,0x92,0x32,0x7F,0xB1,0x1C,0x40,0x35,0xC6,0x68,0x0A,0xF8,0xC6,0xD1},
+                                           0x398A59B4, 0x15, 1, 253,
+                                           {0x98,0x1B,0xA6,0x82,0x4C,0x1B,0xFB,0x1A,0xB4,0x85,0x47,0x20,0x29,0xB7,0x1D,0x80,
+                                            0x8C,0xE3,0x3E,0x2C,0xC3,0xC0,0xB5,0xFC,0x1F,0x3D,0xE8,0xA6,0xDC,0x66,0xB1,0xF0},
+                                           {0x5D,0x5B,0xFE,0x75,0xEB,0x04,0xF6,0x8C,0xE0,0xA1,0x23,0x77,0xEA,0x00,0xB3,0x7D,
+                                            0x47,0xC6,0xA0,0xBA,0x06,0x30,0x91,0x55,0x08,0x6A,0x85,0x9C,0x43,0x41,0xB3,0x78}},
+                                          {LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA2,
+                                           {0xD3,0xC5,0xD5,0x92,0x32,0x7F,0xB1,0x1C,0x40,0x35,0xC6,0x68,0x0A,0xF8,0xC6,0xD1},
+                                           0x398A59B4, 0x15, 1, 253,
+                                           {0x98,0x1B,0xA6,0x82,0x4C,0x1B,0xFB,0x1A,0xB4,0x85,0x47,0x20,0x29,0xB7,0x1D,0x80,
+                                            0x8C,0xE3,0x3E,0x2C,0xC3,0xC0,0xB5,0xFC,0x1F,0x3D,0xE8,0xA6,0xDC,0x66,0xB1,0xF0},
+                                           {0xE9,0xFE,0xD8,0xA6,0x3D,0x15,0x53,0x04,0xD7,0x1D,0xF2,0x0B,0xF3,0xE8,0x22,0x14,
+                                            0xB2,0x0E,0xD7,0xDA,0xD2,0xF2,0x33,0xDC,0x3C,0x22,0xD7,0xBD,0xEE,0xED,0x8E,0x78}},
+                                          {LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA3,
+                                           {0x17,0x3D,0x14,0xBA,0x50,0x03,0x73,0x1D,0x7A,0x60,0x04,0x94,0x70,0xF0,0x0A,0x29},
+                                           0x66035492, 0x0F, 0, 193,
+                                           {0x6C,0xF6,0x53,0x40,0x73,0x55,0x52,0xAB,0x0C,0x97,0x52,0xFA,0x6F,0x90,0x25,0xFE,
+                                            0x0B,0xD6,0x75,0xD9,0x00,0x58,0x75,0xB2,0x00},
+                                           {0xA6,0xC8,0x5F,0xC6,0x6A,0xFB,0x85,0x33,0xAA,0xFC,0x25,0x18,0xDF,0xE7,0x84,0x94,
+                                            0x0E,0xE1,0xE4,0xB0,0x30,0x23,0x8C,0xC8,0x00}}};
+uint32 pdu_size_list[] = {40, 100, 500, 1500};
+
+// 33.401 v10.0.0 Annex C.2, test set 1
+uint8  eia2_key[16] = {0xD3,0xC5,0xD5,0x92,0x32,0x7F,0xB1,0x1C,0x40,0x35,0xC6,0x68,0x0A,0xF8,0xC6,0xD1};
+uint8  eia2_msg[8]  = {0x48,0x45,0x83,0xD5,0xAF,0xE0,0x82,0xAE};
+uint8  eia2_mac[4]  = {0xB9,0x37,0x87,0xE6};
+
+SECURITY_BENCH_EEA_FUNC eea_func[LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_N_ITEMS] = {NULL,
+                                                                                    liblte_security_128_eea1,
+                                                                                    liblte_security_128_eea2,
+                                                                                    liblte_security_128_eea3};
+
+uint8 pdu_buf[SECURITY_BENCH_BATCH_SIZE][SECURITY_BENCH_MAX_PDU_SIZE];
+uint8 ref_buf[SECURITY_BENCH_BATCH_SIZE][SECURITY_BENCH_MAX_PDU_SIZE];
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: check_vectors
+
+    Description: Ciphers and deciphers each test vector and returns
+                 the number of mismatches
+*********************************************************************/
+uint32 check_vectors(void)
+{
+    uint8  out[32];
+    uint32 N_bytes;
+    uint32 N_fail = 0;
+    uint32 i;
+    uint8  mask;
+
+    for(i=0; i<sizeof(vectors)/sizeof(vectors[0]); i++)
+    {
+        N_bytes = (vectors[i].N_bits + 7)/8;
+        eea_func[vectors[i].alg](vectors[i].key,
+                                 vectors[i].count,
+                                 vectors[i].bearer,
+                                 vectors[i].direction,
+                                 vectors[i].pt,
+                                 vectors[i].N_bits,
+                                 out);
+        if(memcmp(out, vectors[i].ct, N_bytes))
+        {
+            printf("%s test vector cipher mismatch\n", liblte_security_ciphering_algorithm_id_text[vectors[i].alg]);
+            N_fail++;
+        }
+        eea_func[vectors[i].alg](vectors[i].key,
+                                 vectors[i].count,
+                                 vectors[i].bearer,
+                                 vectors[i].direction,
+                                 vectors[i].ct,
+                                 vectors[i].N_bits,
+                                 out);
+        mask = 0xFF << ((8 - (vectors[i].N_bits % 8)) % 8);
+        if(memcmp(out, vectors[i].pt, vectors[i].N_bits/8) ||
+           ((out[N_bytes-1] ^ vectors[i].pt[N_bytes-1]) & mask) != 0)
+        {
+            printf("%s test vector decipher mismatch\n", liblte_security_ciphering_algorithm_id_text[vectors[i].alg]);
+            N_fail++;
+        }
+    }
+
+    return(N_fail);
+}
+
+/*********************************************************************
+    Name: check_batch
+
+    Description: Checks that a batch ciphered with a cached context
+                 matches the same PDUs ciphered one at a time, and
+                 returns the number of mismatches
+*********************************************************************/
+uint32 check_batch(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM  alg,
+                   uint8                                       *key,
+                   uint32                                      *seed)
+{
+    LIBLTE_SECURITY_CIPHER_CTX_STRUCT ctx;
+    LIBLTE_SECURITY_CIPHER_PDU_STRUCT pdu[SECURITY_BENCH_BATCH_SIZE];
+    uint32                            N_fail = 0;
+    uint32                            i;
+    uint32                            j;
+
+    liblte_security_cipher_init(&ctx, alg, key, 2, LIBLTE_SECURITY_DIRECTION_DOWNLINK);
+    for(i=0; i<SECURITY_BENCH_BATCH_SIZE; i++)
+    {
+        pdu[i].msg    = pdu_buf[i];
+        pdu[i].N_bits = (1 + liblte_bench_rand(seed) % SECURITY_BENCH_MAX_PDU_SIZE)*8;
+        pdu[i].count  = liblte_bench_rand(seed);
+        for(j=0; j<pdu[i].N_bits/8; j++)
+        {
+            pdu_buf[i][j] = liblte_bench_rand(seed) & 0xFF;
+        }
+        eea_func[alg](key, pdu[i].count, 2, LIBLTE_SECURITY_DIRECTION_DOWNLINK, pdu_buf[i], pdu[i].N_bits, ref_buf[i]);
+    }
+    liblte_security_cipher_batch(&ctx, pdu, SECURITY_BENCH_BATCH_SIZE);
+    for(i=0; i<SECURITY_BENCH_BATCH_SIZE; i++)
+    {
+        if(memcmp(pdu_buf[i], ref_buf[i], pdu[i].N_bits/8))
+        {
+            N_fail++;
+        }
+    }
+    if(N_fail != 0)
+    {
+        printf("%s batch does not match single PDU ciphering\n", liblte_security_ciphering_algorithm_id_text[alg]);
+    }
+
+    return(N_fail);
+}
+
+/*********************************************************************
+    Name: check_eia2
+
+    Description: Checks EIA2 against the test vector and a batch of
+                 MACs computed with a cached context against the same
+                 messages computed one at a time, and returns the
+                 number of mismatches
+*********************************************************************/
+uint32 check_eia2(uint8  *key,
+                  uint32 *seed)
+{
+    LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT ctx;
+    LIBLTE_SECURITY_INTEGRITY_MSG_STRUCT msg[SECURITY_BENCH_BATCH_SIZE];
+    uint32                               N_fail = 0;
+    uint32                               i;
+    uint32                               j;
+    uint8                                mac[4];
+
+    liblte_security_128_eia2_init(&ctx, eia2_key, 0x1A, 1);
+    liblte_security_128_eia2(&ctx, 0x398A59B4, eia2_msg, 64, mac);
+    if(memcmp(mac, eia2_mac, 4))
+    {
+        printf("128-EIA2 test vector mismatch\n");
+        N_fail++;
+    }
+
+    liblte_security_128_eia2_init(&ctx, key, 0, LIBLTE_SECURITY_DIRECTION_DOWNLINK);
+    for(i=0; i<SECURITY_BENCH_BATCH_SIZE; i++)
+    {
+        msg[i].msg    = pdu_buf[i];
+        msg[i].N_bits = (1 + liblte_bench_rand(seed) % SECURITY_BENCH_MAX_PDU_SIZE)*8;
+        msg[i].count  = liblte_bench_rand(seed);
+        for(j=0; j<msg[i].N_bits/8; j++)
+        {
+            pdu_buf[i][j] = liblte_bench_rand(seed) & 0xFF;
+        }
+        liblte_security_128_eia2(key, msg[i].count, 0, LIBLTE_SECURITY_DIRECTION_DOWNLINK, pdu_buf[i], msg[i].N_bits/8, ref_buf[i]);
+    }
+    liblte_security_128_eia2_batch(&ctx, msg, SECURITY_BENCH_BATCH_SIZE);
+    for(i=0; i<SECURITY_BENCH_BATCH_SIZE; i++)
+    {
+        if(memcmp(msg[i].mac, ref_buf[i], 4))
+        {
+            N_fail++;
+        }
+    }
+    if(N_fail != 0)
+    {
+        printf("128-EIA2 batch does not match single message MAC\n");
+    }
+
+    return(N_fail);
+}
+
+/*********************************************************************
+    Name: run_batch
+
+    Description: Ciphers N_mbytes of PDUs of one size in batches with
+                 a cached context and returns the throughput in Gbit/s
+*********************************************************************/
+double run_batch(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM  alg,
+                 uint8                                       *key,
+                 uint32                                       pdu_size,
+                 uint32                                       N_mbytes)
+{
+    LIBLTE_SECURITY_CIPHER_CTX_STRUCT ctx;
+    LIBLTE_SECURITY_CIPHER_PDU_STRUCT pdu[SECURITY_BENCH_BATCH_SIZE];
+    uint64                            start;
+    uint64                            N_bytes = 0;
+    uint64                            total   = (uint64)N_mbytes*1000000;
+    uint32                            count   = 0;
+    uint32                            i;
+
+    liblte_security_cipher_init(&ctx, alg, key, 2, LIBLTE_SECURITY_DIRECTION_DOWNLINK);
+    for(i=0; i<SECURITY_BENCH_BATCH_SIZE; i++)
+    {
+        pdu[i].msg    = pdu_buf[i];
+        pdu[i].N_bits = pdu_size*8;
+    }
+
+    start = liblte_bench_get_time_ns();
+    while(N_bytes < total)
+    {
+        for(i=0; i<SECURITY_BENCH_BATCH_SIZE; i++)
+        {
+            pdu[i].count = count++;
+        }
+        liblte_security_cipher_batch(&ctx, pdu, SECURITY_BENCH_BATCH_SIZE);
+        N_bytes += pdu_size*SECURITY_BENCH_BATCH_SIZE;
+    }
+
+    return((double)N_bytes*8/(double)(liblte_bench_get_time_ns() - start));
+}
+
+/*********************************************************************
+    Name: run_single
+
+    Description: Ciphers N_mbytes of PDUs of one size, setting up the
+                 key for every PDU, and returns the throughput in
+                 Gbit/s
+*********************************************************************/
+double run_single(LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM  alg,
+                  uint8                                       *key,
+                  uint32                                       pdu_size,
+                  uint32                                       N_mbytes)
+{
+    uint64 start;
+    uint64 N_bytes = 0;
+    uint64 total   = (uint64)N_mbytes*1000000;
+    uint32 count   = 0;
+
+    start = liblte_bench_get_time_ns();
+    while(N_bytes < total)
+    {
+        eea_func[alg](key, count++, 2, LIBLTE_SECURITY_DIRECTION_DOWNLINK, pdu_buf[0], pdu_size*8, pdu_buf[0]);
+        N_bytes += pdu_size;
+    }
+
+    return((double)N_bytes*8/(double)(liblte_bench_get_time_ns() - start));
+}
+
+/*********************************************************************
+    Name: run_eia2_batch
+
+    Description: Computes the EIA2 MAC of N_mbytes of messages of one
+                 size in batches with a cached context and returns the
+                 throughput in Gbit/s
+*********************************************************************/
+double run_eia2_batch(uint8  *key,
+                      uint32  msg_size,
+                      uint32  N_mbytes)
+{
+    LIBLTE_SECURITY_INTEGRITY_CTX_STRUCT ctx;
+    LIBLTE_SECURITY_INTEGRITY_MSG_STRUCT msg[SECURITY_BENCH_BATCH_SIZE];
+    uint64                               start;
+    uint64                               N_bytes = 0;
+    uint64                               total   = (uint64)N_mbytes*1000000;
+    uint32                               count   = 0;
+    uint32                               i;
+
+    liblte_security_128_eia2_init(&ctx, key, 0, LIBLTE_SECURITY_DIRECTION_DOWNLINK);
+    for(i=0; i<SECURITY_BENCH_BATCH_SIZE; i++)
+    {
+        msg[i].msg    = pdu_buf[i];
+        msg[i].N_bits = msg_size*8;
+    }
+
+    start = liblte_bench_get_time_ns();
+    while(N_bytes < total)
+    {
+        for(i=0; i<SECURITY_BENCH_BATCH_SIZE; i++)
+        {
+            msg[i].count = count++;
+        }
+        liblte_security_128_eia2_batch(&ctx, msg, SECURITY_BENCH_BATCH_SIZE);
+        N_bytes += msg_size*SECURITY_BENCH_BATCH_SIZE;
+    }
+
+    return((double)N_bytes*8/(double)(liblte_bench_get_time_ns() - start));
+}
+
+/*********************************************************************
+    Name: run_eia2_single
+
+    Description: Computes the EIA2 MAC of N_mbytes of messages of one
+                 size, setting up the key for every message, and
+                 returns the throughput in Gbit/s
+*********************************************************************/
+double run_eia2_single(uint8  *key,
+                       uint32  msg_size,
+                       uint32  N_mbytes)
+{
+    uint64 start;
+    uint64 N_bytes = 0;
+    uint64 total   = (uint64)N_mbytes*1000000;
+    uint32 count   = 0;
+    uint8  mac[4];
+
+    start = liblte_bench_get_time_ns();
+    while(N_bytes < total)
+    {
+        liblte_security_128_eia2(key, count++, 0, LIBLTE_SECURITY_DIRECTION_DOWNLINK, pdu_buf[0], msg_size, mac);
+        N_bytes += msg_size;
+    }
+
+    return((double)N_bytes*8/(double)(liblte_bench_get_time_ns() - start));
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 N_mbytes = SECURITY_BENCH_DEFAULT_N_MBYTES;
+    uint32 seed     = 1;
+    uint32 N_fail;
+    uint32 a;
+    uint32 i;
+    uint8  key[16];
+
+    if(argc > 1)
+    {
+        N_mbytes = atoi(argv[1]);
+    }
+
+    N_fail = check_vectors();
+    for(i=0; i<16; i++)
+    {
+        key[i] = liblte_bench_rand(&seed) & 0xFF;
+    }
+    for(a=LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA1; a<LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_N_ITEMS; a++)
+    {
+        N_fail += check_batch((LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM)a, key, &seed);
+    }
+    N_fail += check_eia2(key, &seed);
+    printf("Test vectors and batch checks: %s\n", (N_fail == 0) ? "pass" : "FAIL");
+
+    printf("%u MB per run, batches of %u PDUs\n", N_mbytes, SECURITY_BENCH_BATCH_SIZE);
+    printf("%-10s %10s %18s %18s\n", "algorithm", "PDU bytes", "batch (Gbit/s)", "per PDU (Gbit/s)");
+    for(a=LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_128_EEA1; a<LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_N_ITEMS; a++)
+    {
+        for(i=0; i<sizeof(pdu_size_list)/sizeof(pdu_size_list[0]); i++)
+        {
+            printf("%-10s %10u %18.3f %18.3f\n",
+                   liblte_security_ciphering_algorithm_id_text[a],
+                   pdu_size_list[i],
+                   run_batch((LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM)a, key, pdu_size_list[i], N_mbytes),
+                   run_single((LIBLTE_SECURITY_CIPHERING_ALGORITHM_ID_ENUM)a, key, pdu_size_list[i], N_mbytes));
+        }
+    }
+    for(i=0; i<sizeof(pdu_size_list)/sizeof(pdu_size_list[0]); i++)
+    {
+        printf("%-10s %10u %18.3f %18.3f\n",
+               liblte_security_integrity_algorithm_id_text[LIBLTE_SECURITY_INTEGRITY_ALGORITHM_ID_128_EIA2],
+               pdu_size_list[i],
+               run_eia2_batch(key, pdu_size_list[i], N_mbytes),
+               run_eia2_single(key, pdu_size_list[i], N_mbytes));
+    }
+
+    if(N_fail != 0)
+    {
+        return(1);
+    }
+    return(0);
+}
@@ -0,0 +1,155 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_turbo_bench.cc
+
+    Description: Measures the throughput of the lookup table turbo encoder
+                 against the bit serial turbo encoder for every code block
+                 size K and checks that both produce the same systematic,
+                 parity and trellis termination bits.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_bench_common.h"
+#include "liblte_phy.h"
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define TURBO_BENCH_DEFAULT_N_ITERATIONS 200
+#define TURBO_BENCH_MAX_K                6144
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+uint8 c_bits[TURBO_BENCH_MAX_K];
+uint8 lut_d_bits[3*(TURBO_BENCH_MAX_K+4)];
+uint8 ref_d_bits[3*(TURBO_BENCH_MAX_K+4)];
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: time_encoder
+
+    Description: Returns the throughput of an encoder in Mbps
+*********************************************************************/
+float time_encoder(LIBLTE_PHY_STRUCT             *phy_struct,
+                   LIBLTE_PHY_TURBO_ENCODER_ENUM  encoder,
+                   uint32                         K,
+                   uint32                         N_iterations,
+                   uint8                         *d_bits)
+{
+    uint64 start;
+    uint64 stop;
+    uint32 i;
+    uint32 N_d_bits;
+
+    start = liblte_bench_get_time_ns();
+    for(i=0; i<N_iterations; i++)
+    {
+        liblte_phy_turbo_encode(phy_struct, encoder, c_bits, K, d_bits, &N_d_bits);
+    }
+    stop = liblte_bench_get_time_ns();
+
+    return((float)K*N_iterations*1000/(float)(stop - start));
+}
+
+int main(int argc, char *argv[])
+{
+    LIBLTE_PHY_STRUCT *phy_struct;
+    float              lut_mbps;
+    float              ref_mbps;
+    uint32             N_iterations = TURBO_BENCH_DEFAULT_N_ITERATIONS;
+    uint32             seed         = 1;
+    uint32             K;
+    uint32             N_d_bits;
+    uint32             N_mismatch   = 0;
+    uint32             i;
+    bool               match;
+
+    if(argc > 1)
+    {
+        N_iterations = atoi(argv[1]);
+    }
+
+    liblte_phy_init(&phy_struct,
+                    LIBLTE_PHY_FS_1_92MHZ,
+                    LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN,
+                    1,
+                    LIBLTE_PHY_N_RB_DL_1_4MHZ,
+                    LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
+                    1);
+
+    printf("%6s %18s %18s %8s %6s\n", "K", "bit serial (Mbps)", "LUT (Mbps)", "speedup", "match");
+    for(K=40; K<=TURBO_BENCH_MAX_K; K+=8)
+    {
+        liblte_bench_random_bits(&seed, c_bits, K);
+        if(LIBLTE_SUCCESS != liblte_phy_turbo_encode(phy_struct, LIBLTE_PHY_TURBO_ENCODER_LUT, c_bits, K, lut_d_bits, &N_d_bits))
+        {
+            // Not a valid code block size
+            continue;
+        }
+        liblte_phy_turbo_encode(phy_struct, LIBLTE_PHY_TURBO_ENCODER_BIT_SERIAL, c_bits, K, ref_d_bits, &N_d_bits);
+
+        // All D = K+4 bits of each stream are compared, including the
+        // 12 trellis termination bits
+        match = (N_d_bits == 3*(K+4));
+        for(i=0; i<3*(K+4) && match; i++)
+        {
+            if(lut_d_bits[i] != ref_d_bits[i])
+            {
+                match = false;
+            }
+        }
+        if(!match)
+        {
+            N_mismatch++;
+        }
+
+        ref_mbps = time_encoder(phy_struct, LIBLTE_PHY_TURBO_ENCODER_BIT_SERIAL, K, N_iterations, ref_d_bits);
+        lut_mbps = time_encoder(phy_struct, LIBLTE_PHY_TURBO_ENCODER_LUT, K, N_iterations, lut_d_bits);
+        printf("%6u %18.2f %18.2f %8.2f %6s\n", K, ref_mbps, lut_mbps, lut_mbps/ref_mbps, match ? "yes" : "NO");
+    }
+
+    liblte_phy_cleanup(phy_struct);
+
+    if(0 != N_mismatch)
+    {
+        printf("%u code block sizes did not match\n", N_mismatch);
+        return(1);
+    }
+    return(0);
+}
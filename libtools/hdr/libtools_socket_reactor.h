@@ -0,0 +1,108 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: libtools_socket_reactor.h
+
+    Description: Contains all the definitions for the epoll event loop shared
+                 by all text mode communication sockets.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+#ifndef __LIBTOOLS_SOCKET_REACTOR_H__
+#define __LIBTOOLS_SOCKET_REACTOR_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "typedefs.h"
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <pthread.h>
+#include <map>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LIBTOOLS_SOCKET_REACTOR_MAX_EVENTS 64
+#define LIBTOOLS_SOCKET_REACTOR_WAKE_ID    0xFFFFFFFF
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+class libtools_socket_wrap;
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef struct{
+    libtools_socket_wrap *wrap;
+    uint32                N_dispatching;
+    bool                  unregistered;
+}LIBTOOLS_SOCKET_REACTOR_WRAP_STRUCT;
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+class libtools_socket_reactor
+{
+public:
+    // Singleton
+    static libtools_socket_reactor* get_instance(void);
+    static void cleanup(void);
+
+    // Registration
+    bool register_wrap(libtools_socket_wrap *wrap, uint32 *wrap_id);
+    void unregister_wrap(uint32 wrap_id);
+    bool add_fd(int32 fd, uint32 wrap_id, uint32 client_id, uint32 events);
+    bool mod_fd(int32 fd, uint32 wrap_id, uint32 client_id, uint32 events);
+    void del_fd(int32 fd);
+
+private:
+    // Singleton
+    static libtools_socket_reactor *instance;
+    libtools_socket_reactor();
+    ~libtools_socket_reactor();
+
+    // Event loop
+    static void* reactor_thread(void *inputs);
+    bool start(void);
+
+    // Variables
+    std::map<uint32, LIBTOOLS_SOCKET_REACTOR_WRAP_STRUCT> wrap_map;
+    boost::mutex                                          wrap_map_mutex;
+    boost::condition_variable                             wrap_idle_cond;
+    boost::mutex                                          start_mutex;
+    pthread_t                                             thread;
+    int32                                                 epoll_fd;
+    int32                                                 wake_fd;
+    uint32                                                next_wrap_id;
+    bool                                                  started;
+    bool                                                  stop;
+};
+
+#endif /* __LIBTOOLS_SOCKET_REACTOR_H__ */
@@ -38,19 +38,23 @@
 
 #include "typedefs.h"
 #include <boost/thread/mutex.hpp>
-#include <pthread.h>
 #include <string>
+#include <map>
 
 /*******************************************************************************
                               DEFINES
 *******************************************************************************/
 
+#define LIBTOOLS_SOCKET_WRAP_RX_BUF_SIZE      4096
+#define LIBTOOLS_SOCKET_WRAP_DEFAULT_TX_LIMIT 65536
+#define LIBTOOLS_SOCKET_WRAP_LISTEN_ID        0xFFFFFFFF
+#define LIBTOOLS_SOCKET_WRAP_ALL_CLIENTS      0xFFFFFFFF
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
 *******************************************************************************/
 
-class libtools_socket_wrap;
+class libtools_socket_reactor;
 
 /*******************************************************************************
                               TYPEDEFS
@@ -62,34 +66,30 @@ typedef enum{
     LIBTOOLS_SOCKET_WRAP_ERROR_SOCKET,
     LIBTOOLS_SOCKET_WRAP_ERROR_PTHREAD,
     LIBTOOLS_SOCKET_WRAP_ERROR_WRITE_FAIL,
+    LIBTOOLS_SOCKET_WRAP_ERROR_BACKPRESSURE,
     LIBTOOLS_SOCKET_WRAP_ERROR_N_ITEMS,
 }LIBTOOLS_SOCKET_WRAP_ERROR_ENUM;
 static const char libtools_socket_wrap_error_text[LIBTOOLS_SOCKET_WRAP_ERROR_N_ITEMS][20] = {"Success",
                                                                                              "Invalid Inputs",
                                                                                              "Socket",
                                                                                              "PThread",
-                                                                                             "Write Fail"};
+                                                                                             "Write Fail",
+                                                                                             "Backpressure"};
 
 typedef enum{
     LIBTOOLS_SOCKET_WRAP_TYPE_SERVER = 0,
     LIBTOOLS_SOCKET_WRAP_TYPE_CLIENT,
 }LIBTOOLS_SOCKET_WRAP_TYPE_ENUM;
 
-typedef enum{
-    LIBTOOLS_SOCKET_WRAP_STATE_DISCONNECTED = 0,
-    LIBTOOLS_SOCKET_WRAP_STATE_THREADED,
-    LIBTOOLS_SOCKET_WRAP_STATE_CONNECTED,
-    LIBTOOLS_SOCKET_WRAP_STATE_CLOSED,
-}LIBTOOLS_SOCKET_WRAP_STATE_ENUM;
-
+// Per client state, the RX buffer is framed in place and the TX buffer holds
+// whatever the kernel would not take without blocking
 typedef struct{
-    libtools_socket_wrap *socket_wrap;
-    void                  (*handle_msg)(std::string msg);
-    void                  (*handle_connect)(void);
-    void                  (*handle_disconnect)(void);
-    void                  (*handle_error)(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM err);
-    int32                 sock;
-}LIBTOOLS_SOCKET_WRAP_THREAD_INPUTS_STRUCT;
+    std::string tx_buf;
+    uint32      tx_offset;
+    uint32      rx_len;
+    int32       fd;
+    char        rx_buf[LIBTOOLS_SOCKET_WRAP_RX_BUF_SIZE];
+}LIBTOOLS_SOCKET_WRAP_CLIENT_STRUCT;
 
 /*******************************************************************************
                               CLASS DECLARATIONS
@@ -98,6 +98,7 @@ typedef struct{
 class libtools_socket_wrap
 {
 public:
+    // Single client server, kept for existing users
     libtools_socket_wrap(uint32                          *ip_addr,
                          uint16                           port,
                          LIBTOOLS_SOCKET_WRAP_TYPE_ENUM   type,
@@ -106,28 +107,55 @@ public:
                          void                             (*handle_disconnect)(void),
                          void                             (*handle_error)(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM err),
                          LIBTOOLS_SOCKET_WRAP_ERROR_ENUM *error);
+    // Multi client server, lines are delivered in place from the RX buffer
+    libtools_socket_wrap(uint32                          *ip_addr,
+                         uint16                           port,
+                         uint32                           max_clients,
+                         uint32                           tx_limit,
+                         void                             (*handle_client_msg)(uint32 client, const char *line, uint32 len),
+                         void                             (*handle_client_connect)(uint32 client),
+                         void                             (*handle_client_disconnect)(uint32 client),
+                         void                             (*handle_error)(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM err),
+                         LIBTOOLS_SOCKET_WRAP_ERROR_ENUM *error);
     ~libtools_socket_wrap();
 
     // Send
     LIBTOOLS_SOCKET_WRAP_ERROR_ENUM send(std::string msg);
+    LIBTOOLS_SOCKET_WRAP_ERROR_ENUM send(uint32 client, std::string msg);
 private:
-    // Receive
-    static void* server_thread(void *inputs);
-    static void* client_thread(void *inputs);
+    friend class libtools_socket_reactor;
+
+    // Setup
+    LIBTOOLS_SOCKET_WRAP_ERROR_ENUM open_server(uint16 port);
+
+    // Events, called from the reactor thread
+    void handle_event(uint32 client_id, uint32 events);
+    void handle_accept(void);
+    bool handle_read(uint32 client_id, LIBTOOLS_SOCKET_WRAP_CLIENT_STRUCT *client);
+    bool handle_write(uint32 client_id, LIBTOOLS_SOCKET_WRAP_CLIENT_STRUCT *client);
+    void close_client(uint32 client_id);
+    void deliver_line(uint32 client_id, const char *line, uint32 len);
+
+    // Helpers
+    LIBTOOLS_SOCKET_WRAP_ERROR_ENUM queue_msg(uint32 client_id, LIBTOOLS_SOCKET_WRAP_CLIENT_STRUCT *client, const char *msg, uint32 len);
 
     // Variables
-    LIBTOOLS_SOCKET_WRAP_THREAD_INPUTS_STRUCT thread_inputs;
-    LIBTOOLS_SOCKET_WRAP_STATE_ENUM           socket_state;
-    pthread_t                                 socket_thread;
-    boost::mutex                              socket_mutex;
-    uint32                                    socket_ip_addr;
-    int32                                     socket_fd;
-    int32                                     sock;
-    uint16                                    socket_port;
-    void                                      (*socket_handle_msg)(std::string msg);
-    void                                      (*socket_handle_connect)(void);
-    void                                      (*socket_handle_disconnect)(void);
-    void                                      (*socket_handle_error)(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM err);
+    std::map<uint32, LIBTOOLS_SOCKET_WRAP_CLIENT_STRUCT*>  clients;
+    libtools_socket_reactor                               *reactor;
+    boost::mutex                                           socket_mutex;
+    uint32                                                 socket_max_clients;
+    uint32                                                 socket_tx_limit;
+    uint32                                                 next_client_id;
+    uint32                                                 wrap_id;
+    int32                                                  sock;
+    bool                                                   registered;
+    void                                                   (*socket_handle_msg)(std::string msg);
+    void                                                   (*socket_handle_connect)(void);
+    void                                                   (*socket_handle_disconnect)(void);
+    void                                                   (*socket_handle_client_msg)(uint32 client, const char *line, uint32 len);
+    void                                                   (*socket_handle_client_connect)(uint32 client);
+    void                                                   (*socket_handle_client_disconnect)(uint32 client);
+    void                                                   (*socket_handle_error)(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM err);
 };
 
 #endif /* __LIBTOOLS_SOCKET_WRAP_H__ */
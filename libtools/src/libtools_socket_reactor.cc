@@ -0,0 +1,300 @@
+/*******************************************************************************
+
+    Copyright 2026 openLTE contributors
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: libtools_socket_reactor.cc
+
+    Description: Contains all the implementations for the epoll event loop
+                 shared by all text mode communication sockets.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    openLTE          Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "libtools_socket_reactor.h"
+#include "libtools_socket_wrap.h"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+libtools_socket_reactor* libtools_socket_reactor::instance = NULL;
+boost::mutex             reactor_instance_mutex;
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+/*******************/
+/*    Singleton    */
+/*******************/
+libtools_socket_reactor* libtools_socket_reactor::get_instance(void)
+{
+    boost::mutex::scoped_lock lock(reactor_instance_mutex);
+
+    if(NULL == instance)
+    {
+        instance = new libtools_socket_reactor();
+    }
+
+    return(instance);
+}
+void libtools_socket_reactor::cleanup(void)
+{
+    boost::mutex::scoped_lock lock(reactor_instance_mutex);
+
+    if(NULL != instance)
+    {
+        delete instance;
+        instance = NULL;
+    }
+}
+
+/********************************/
+/*    Constructor/Destructor    */
+/********************************/
+libtools_socket_reactor::libtools_socket_reactor()
+{
+    epoll_fd     = -1;
+    wake_fd      = -1;
+    next_wrap_id = 0;
+    started      = false;
+    stop         = false;
+}
+libtools_socket_reactor::~libtools_socket_reactor()
+{
+    uint64 wake = 1;
+
+    if(started)
+    {
+        stop = true;
+        if(sizeof(wake) != write(wake_fd, &wake, sizeof(wake)))
+        {
+            pthread_cancel(thread);
+        }
+        pthread_join(thread, NULL);
+    }
+    if(0 <= wake_fd)
+    {
+        close(wake_fd);
+    }
+    if(0 <= epoll_fd)
+    {
+        close(epoll_fd);
+    }
+}
+
+/**********************/
+/*    Registration    */
+/**********************/
+bool libtools_socket_reactor::register_wrap(libtools_socket_wrap *wrap,
+                                            uint32               *wrap_id)
+{
+    LIBTOOLS_SOCKET_REACTOR_WRAP_STRUCT entry;
+
+    if(!start())
+    {
+        return(false);
+    }
+
+    boost::mutex::scoped_lock lock(wrap_map_mutex);
+    entry.wrap          = wrap;
+    entry.N_dispatching = 0;
+    entry.unregistered  = false;
+    *wrap_id            = next_wrap_id++;
+    wrap_map[*wrap_id]  = entry;
+
+    return(true);
+}
+void libtools_socket_reactor::unregister_wrap(uint32 wrap_id)
+{
+    boost::mutex::scoped_lock                                       lock(wrap_map_mutex);
+    std::map<uint32, LIBTOOLS_SOCKET_REACTOR_WRAP_STRUCT>::iterator iter;
+
+    iter = wrap_map.find(wrap_id);
+    if(wrap_map.end() == iter)
+    {
+        return;
+    }
+
+    // No new callbacks start once unregistered.  A callback in progress
+    // removes the wrap when it returns, so wait for that unless the
+    // caller is that callback.
+    (*iter).second.unregistered = true;
+    if(0 == (*iter).second.N_dispatching)
+    {
+        wrap_map.erase(iter);
+    }else if(!pthread_equal(pthread_self(), thread)){
+        while(wrap_map.end() != wrap_map.find(wrap_id))
+        {
+            wrap_idle_cond.wait(lock);
+        }
+    }
+}
+bool libtools_socket_reactor::add_fd(int32  fd,
+                                     uint32 wrap_id,
+                                     uint32 client_id,
+                                     uint32 events)
+{
+    struct epoll_event ev;
+
+    ev.events   = events;
+    ev.data.u64 = ((uint64)wrap_id << 32) | client_id;
+
+    return(0 == epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev));
+}
+bool libtools_socket_reactor::mod_fd(int32  fd,
+                                     uint32 wrap_id,
+                                     uint32 client_id,
+                                     uint32 events)
+{
+    struct epoll_event ev;
+
+    ev.events   = events;
+    ev.data.u64 = ((uint64)wrap_id << 32) | client_id;
+
+    return(0 == epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &ev));
+}
+void libtools_socket_reactor::del_fd(int32 fd)
+{
+    struct epoll_event ev;
+
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, &ev);
+}
+
+/********************/
+/*    Event loop    */
+/********************/
+void* libtools_socket_reactor::reactor_thread(void *inputs)
+{
+    libtools_socket_reactor                                         *reactor = (libtools_socket_reactor *)inputs;
+    std::map<uint32, LIBTOOLS_SOCKET_REACTOR_WRAP_STRUCT>::iterator  iter;
+    libtools_socket_wrap                                            *wrap;
+    struct epoll_event                                               events[LIBTOOLS_SOCKET_REACTOR_MAX_EVENTS];
+    uint32                                                           wrap_id;
+    uint32                                                           client_id;
+    int32                                                            n_events;
+    int32                                                            i;
+
+    while(!reactor->stop)
+    {
+        n_events = epoll_wait(reactor->epoll_fd, events, LIBTOOLS_SOCKET_REACTOR_MAX_EVENTS, -1);
+        if(-1 == n_events)
+        {
+            if(EINTR == errno)
+            {
+                continue;
+            }
+            break;
+        }
+
+        for(i=0; i<n_events; i++)
+        {
+            wrap_id   = (uint32)(events[i].data.u64 >> 32);
+            client_id = (uint32)(events[i].data.u64 & 0xFFFFFFFF);
+            if(LIBTOOLS_SOCKET_REACTOR_WAKE_ID == wrap_id)
+            {
+                continue;
+            }
+
+            // Wraps that were unregistered since epoll_wait returned are
+            // skipped.  The callback runs without the map lock held, so a
+            // slow callback only holds up its own wrap's unregistration.
+            wrap = NULL;
+            reactor->wrap_map_mutex.lock();
+            iter = reactor->wrap_map.find(wrap_id);
+            if(reactor->wrap_map.end() != iter &&
+               !(*iter).second.unregistered)
+            {
+                wrap = (*iter).second.wrap;
+                (*iter).second.N_dispatching++;
+            }
+            reactor->wrap_map_mutex.unlock();
+            if(NULL == wrap)
+            {
+                continue;
+            }
+
+            wrap->handle_event(client_id, events[i].events);
+
+            reactor->wrap_map_mutex.lock();
+            iter = reactor->wrap_map.find(wrap_id);
+            (*iter).second.N_dispatching--;
+            if((*iter).second.unregistered &&
+               0 == (*iter).second.N_dispatching)
+            {
+                reactor->wrap_map.erase(iter);
+                reactor->wrap_idle_cond.notify_all();
+            }
+            reactor->wrap_map_mutex.unlock();
+        }
+    }
+
+    return(NULL);
+}
+bool libtools_socket_reactor::start(void)
+{
+    boost::mutex::scoped_lock lock(start_mutex);
+
+    if(started)
+    {
+        return(true);
+    }
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if(0 > epoll_fd)
+    {
+        return(false);
+    }
+    wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if(0 > wake_fd)
+    {
+        return(false);
+    }
+    if(!add_fd(wake_fd, LIBTOOLS_SOCKET_REACTOR_WAKE_ID, 0, EPOLLIN))
+    {
+        return(false);
+    }
+    if(0 != pthread_create(&thread, NULL, &reactor_thread, this))
+    {
+        return(false);
+    }
+    started = true;
+
+    return(true);
+}
@@ -37,12 +37,13 @@
 *******************************************************************************/
 
 #include "libtools_socket_wrap.h"
+#include "libtools_socket_reactor.h"
 #include <sys/socket.h>
-#include <sys/select.h>
+#include <sys/epoll.h>
 #include <netinet/in.h>
 #include <string.h>
 #include <unistd.h>
-#include <limits.h>
+#include <errno.h>
 
 /*******************************************************************************
                               DEFINES
@@ -74,264 +75,434 @@ libtools_socket_wrap::libtools_socket_wrap(uint32                          *ip_a
                                            LIBTOOLS_SOCKET_WRAP_ERROR_ENUM *error)
 {
     boost::mutex::scoped_lock lock(socket_mutex);
-    struct sockaddr_in        s_addr;
-    struct linger             linger;
+
+    // Save inputs
+    reactor                         = libtools_socket_reactor::get_instance();
+    socket_max_clients              = 1;
+    socket_tx_limit                 = LIBTOOLS_SOCKET_WRAP_DEFAULT_TX_LIMIT;
+    next_client_id                  = 0;
+    sock                            = -1;
+    registered                      = false;
+    socket_handle_msg               = handle_msg;
+    socket_handle_connect           = handle_connect;
+    socket_handle_disconnect        = handle_disconnect;
+    socket_handle_client_msg        = NULL;
+    socket_handle_client_connect    = NULL;
+    socket_handle_client_disconnect = NULL;
+    socket_handle_error             = handle_error;
 
     if(handle_msg        == NULL ||
        handle_connect    == NULL ||
        handle_disconnect == NULL ||
-       handle_error      == NULL)
+       handle_error      == NULL ||
+       type              != LIBTOOLS_SOCKET_WRAP_TYPE_SERVER)
     {
         *error = LIBTOOLS_SOCKET_WRAP_ERROR_INVALID_INPUTS;
         return;
     }
 
+    *error = open_server(port);
+}
+libtools_socket_wrap::libtools_socket_wrap(uint32                          *ip_addr,
+                                           uint16                           port,
+                                           uint32                           max_clients,
+                                           uint32                           tx_limit,
+                                           void                             (*handle_client_msg)(uint32 client, const char *line, uint32 len),
+                                           void                             (*handle_client_connect)(uint32 client),
+                                           void                             (*handle_client_disconnect)(uint32 client),
+                                           void                             (*handle_error)(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM err),
+                                           LIBTOOLS_SOCKET_WRAP_ERROR_ENUM *error)
+{
+    boost::mutex::scoped_lock lock(socket_mutex);
+
     // Save inputs
-    socket_handle_msg        = handle_msg;
-    socket_handle_connect    = handle_connect;
-    socket_handle_disconnect = handle_disconnect;
-    socket_handle_error      = handle_error;
-    socket_port              = port;
-    socket_state             = LIBTOOLS_SOCKET_WRAP_STATE_DISCONNECTED;
+    reactor                         = libtools_socket_reactor::get_instance();
+    socket_max_clients              = max_clients;
+    socket_tx_limit                 = tx_limit;
+    next_client_id                  = 0;
+    sock                            = -1;
+    registered                      = false;
+    socket_handle_msg               = NULL;
+    socket_handle_connect           = NULL;
+    socket_handle_disconnect        = NULL;
+    socket_handle_client_msg        = handle_client_msg;
+    socket_handle_client_connect    = handle_client_connect;
+    socket_handle_client_disconnect = handle_client_disconnect;
+    socket_handle_error             = handle_error;
+
+    if(handle_client_msg        == NULL ||
+       handle_client_connect    == NULL ||
+       handle_client_disconnect == NULL ||
+       handle_error             == NULL ||
+       max_clients              == 0    ||
+       tx_limit                 == 0)
+    {
+        *error = LIBTOOLS_SOCKET_WRAP_ERROR_INVALID_INPUTS;
+        return;
+    }
+
+    *error = open_server(port);
+}
+libtools_socket_wrap::~libtools_socket_wrap()
+{
+    // Once unregistered no more events are dispatched to this wrap
+    if(registered)
+    {
+        reactor->unregister_wrap(wrap_id);
+    }
+
+    if(0 <= sock)
+    {
+        reactor->del_fd(sock);
+        close(sock);
+    }
+    while(0 != clients.size())
+    {
+        close_client((*clients.begin()).first);
+    }
+}
+
+// Send
+LIBTOOLS_SOCKET_WRAP_ERROR_ENUM libtools_socket_wrap::send(std::string msg)
+{
+    return(send(LIBTOOLS_SOCKET_WRAP_ALL_CLIENTS, msg));
+}
+LIBTOOLS_SOCKET_WRAP_ERROR_ENUM libtools_socket_wrap::send(uint32      client,
+                                                           std::string msg)
+{
+    boost::mutex::scoped_lock                                       lock(socket_mutex);
+    std::map<uint32, LIBTOOLS_SOCKET_WRAP_CLIENT_STRUCT*>::iterator iter;
+    LIBTOOLS_SOCKET_WRAP_ERROR_ENUM                                 err = LIBTOOLS_SOCKET_WRAP_ERROR_SOCKET;
+    LIBTOOLS_SOCKET_WRAP_ERROR_ENUM                                 client_err;
+
+    if(LIBTOOLS_SOCKET_WRAP_ALL_CLIENTS == client)
+    {
+        for(iter=clients.begin(); iter!=clients.end(); iter++)
+        {
+            client_err = queue_msg((*iter).first, (*iter).second, msg.c_str(), msg.size());
+            if(LIBTOOLS_SOCKET_WRAP_SUCCESS          != client_err ||
+               LIBTOOLS_SOCKET_WRAP_ERROR_SOCKET     == err)
+            {
+                err = client_err;
+            }
+        }
+    }else{
+        iter = clients.find(client);
+        if(clients.end() != iter)
+        {
+            err = queue_msg((*iter).first, (*iter).second, msg.c_str(), msg.size());
+        }
+    }
+
+    return(err);
+}
+
+// Setup
+LIBTOOLS_SOCKET_WRAP_ERROR_ENUM libtools_socket_wrap::open_server(uint16 port)
+{
+    struct sockaddr_in s_addr;
+    struct linger      linger;
 
     // Create the socket
-    sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sock = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
     memset(&s_addr, 0, sizeof(s_addr));
     s_addr.sin_family      = AF_INET;
     s_addr.sin_addr.s_addr = INADDR_ANY;
-    s_addr.sin_port        = htons(socket_port);
+    s_addr.sin_port        = htons(port);
     if(0 > sock)
     {
-        *error = LIBTOOLS_SOCKET_WRAP_ERROR_SOCKET;
+        return(LIBTOOLS_SOCKET_WRAP_ERROR_SOCKET);
+    }
+
+    // Set the options
+    linger.l_onoff  = 1;
+    linger.l_linger = 0;
+    if(0 != setsockopt(sock, SOL_SOCKET, SO_LINGER, &linger, sizeof(linger)))
+    {
+        return(LIBTOOLS_SOCKET_WRAP_ERROR_SOCKET);
+    }
+
+    // Bind and listen
+    if(0 != bind(sock, (struct sockaddr *)&s_addr, sizeof(s_addr)) ||
+       0 != listen(sock, SOMAXCONN))
+    {
+        return(LIBTOOLS_SOCKET_WRAP_ERROR_SOCKET);
+    }
+
+    // Hand the listening socket to the shared event loop
+    if(!reactor->register_wrap(this, &wrap_id))
+    {
+        return(LIBTOOLS_SOCKET_WRAP_ERROR_PTHREAD);
+    }
+    registered = true;
+    if(!reactor->add_fd(sock, wrap_id, LIBTOOLS_SOCKET_WRAP_LISTEN_ID, EPOLLIN))
+    {
+        return(LIBTOOLS_SOCKET_WRAP_ERROR_SOCKET);
+    }
+
+    return(LIBTOOLS_SOCKET_WRAP_SUCCESS);
+}
+
+// Events
+void libtools_socket_wrap::handle_event(uint32 client_id,
+                                        uint32 events)
+{
+    std::map<uint32, LIBTOOLS_SOCKET_WRAP_CLIENT_STRUCT*>::iterator  iter;
+    LIBTOOLS_SOCKET_WRAP_CLIENT_STRUCT                              *client = NULL;
+
+    if(LIBTOOLS_SOCKET_WRAP_LISTEN_ID == client_id)
+    {
+        handle_accept();
         return;
     }
 
-    if(LIBTOOLS_SOCKET_WRAP_TYPE_SERVER == type)
+    // Clients are only removed from this thread, so the pointer stays valid
+    socket_mutex.lock();
+    iter = clients.find(client_id);
+    if(clients.end() != iter)
+    {
+        client = (*iter).second;
+    }
+    socket_mutex.unlock();
+    if(NULL == client)
     {
-        // Set the options
-        linger.l_onoff  = 1;
-        linger.l_linger = 0;
-        if(0 != setsockopt(sock, SOL_SOCKET, SO_LINGER, &linger, sizeof(linger)))
+        return;
+    }
+
+    if((events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)))
+    {
+        if(!handle_read(client_id, client))
         {
-            *error = LIBTOOLS_SOCKET_WRAP_ERROR_SOCKET;
             return;
         }
     }
-
-    // Bind
-    if(0 != bind(sock, (struct sockaddr *)&s_addr, sizeof(s_addr)))
+    if((events & EPOLLOUT))
     {
-        *error = LIBTOOLS_SOCKET_WRAP_ERROR_SOCKET;
-        return;
+        handle_write(client_id, client);
     }
+}
+void libtools_socket_wrap::handle_accept(void)
+{
+    LIBTOOLS_SOCKET_WRAP_CLIENT_STRUCT *client;
+    uint32                              client_id;
+    int32                               sock_fd;
 
-    // Create read thread
-    thread_inputs.socket_wrap       = this;
-    thread_inputs.handle_msg        = socket_handle_msg;
-    thread_inputs.handle_connect    = socket_handle_connect;
-    thread_inputs.handle_disconnect = socket_handle_disconnect;
-    thread_inputs.handle_error      = socket_handle_error;
-    thread_inputs.sock              = sock;
-    if(LIBTOOLS_SOCKET_WRAP_TYPE_SERVER == type)
+    while(1)
     {
-        if(0 != pthread_create(&socket_thread, NULL, &server_thread, &thread_inputs))
+        sock_fd = accept4(sock, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if(0 > sock_fd)
         {
-            *error = LIBTOOLS_SOCKET_WRAP_ERROR_PTHREAD;
+            if(EAGAIN       != errno &&
+               EWOULDBLOCK  != errno &&
+               EINTR        != errno &&
+               ECONNABORTED != errno)
+            {
+                socket_handle_error(LIBTOOLS_SOCKET_WRAP_ERROR_SOCKET);
+            }
             return;
         }
-    }else{
-        if(0 != pthread_create(&socket_thread, NULL, &client_thread, &thread_inputs))
+
+        socket_mutex.lock();
+        if(clients.size() >= socket_max_clients)
         {
-            *error = LIBTOOLS_SOCKET_WRAP_ERROR_PTHREAD;
-            return;
+            // Refuse rather than leave the connection waiting in the backlog
+            socket_mutex.unlock();
+            close(sock_fd);
+            continue;
         }
-    }
-    socket_state = LIBTOOLS_SOCKET_WRAP_STATE_THREADED;
+        client            = new LIBTOOLS_SOCKET_WRAP_CLIENT_STRUCT;
+        client->tx_offset = 0;
+        client->rx_len    = 0;
+        client->fd        = sock_fd;
+        client_id         = next_client_id++;
+        if(LIBTOOLS_SOCKET_WRAP_LISTEN_ID == next_client_id)
+        {
+            next_client_id = 0;
+        }
+        clients[client_id] = client;
+        if(!reactor->add_fd(sock_fd, wrap_id, client_id, EPOLLIN | EPOLLRDHUP))
+        {
+            clients.erase(client_id);
+            socket_mutex.unlock();
+            close(sock_fd);
+            delete client;
+            socket_handle_error(LIBTOOLS_SOCKET_WRAP_ERROR_SOCKET);
+            continue;
+        }
+        socket_mutex.unlock();
 
-    *error = LIBTOOLS_SOCKET_WRAP_SUCCESS;
+        if(NULL != socket_handle_client_connect)
+        {
+            socket_handle_client_connect(client_id);
+        }else{
+            socket_handle_connect();
+        }
+    }
 }
-libtools_socket_wrap::~libtools_socket_wrap()
+bool libtools_socket_wrap::handle_read(uint32                              client_id,
+                                       LIBTOOLS_SOCKET_WRAP_CLIENT_STRUCT *client)
 {
-    boost::mutex::scoped_lock lock(socket_mutex);
+    char   *line;
+    char   *end;
+    uint32  len;
+    uint32  start;
+    int32   nbytes;
+
+    nbytes = read(client->fd, &client->rx_buf[client->rx_len], LIBTOOLS_SOCKET_WRAP_RX_BUF_SIZE - client->rx_len);
+    if(0 == nbytes)
+    {
+        close_client(client_id);
+        return(false);
+    }else if(0 > nbytes){
+        if(EAGAIN      == errno ||
+           EWOULDBLOCK == errno ||
+           EINTR       == errno)
+        {
+            return(true);
+        }
+        close_client(client_id);
+        return(false);
+    }
+    client->rx_len += nbytes;
 
-    if(LIBTOOLS_SOCKET_WRAP_STATE_DISCONNECTED != socket_state)
+    // Deliver every complete line straight out of the RX buffer
+    start = 0;
+    while(NULL != (end = (char *)memchr(&client->rx_buf[start], '\n', client->rx_len - start)))
     {
-        socket_handle_disconnect();
-        socket_state = LIBTOOLS_SOCKET_WRAP_STATE_DISCONNECTED;
+        line = &client->rx_buf[start];
+        len  = end - line;
+        if(0 < len && '\r' == line[len-1])
+        {
+            len--;
+        }
+        deliver_line(client_id, line, len);
+        start = (end - client->rx_buf) + 1;
     }
-    close(sock);
-    sleep(1);
-    pthread_cancel(socket_thread);
-    pthread_join(socket_thread, NULL);
-}
 
-// Send
-LIBTOOLS_SOCKET_WRAP_ERROR_ENUM libtools_socket_wrap::send(std::string msg)
-{
-    boost::mutex::scoped_lock       lock(socket_mutex);
-    LIBTOOLS_SOCKET_WRAP_ERROR_ENUM err = LIBTOOLS_SOCKET_WRAP_ERROR_SOCKET;
+    // Keep the partial line, or flush it if it can never be terminated
+    if(0 == start && LIBTOOLS_SOCKET_WRAP_RX_BUF_SIZE == client->rx_len)
+    {
+        deliver_line(client_id, client->rx_buf, client->rx_len);
+        client->rx_len = 0;
+    }else if(0 != start){
+        client->rx_len -= start;
+        memmove(client->rx_buf, &client->rx_buf[start], client->rx_len);
+    }
 
-    if(LIBTOOLS_SOCKET_WRAP_STATE_CONNECTED == socket_state)
+    return(true);
+}
+bool libtools_socket_wrap::handle_write(uint32                              client_id,
+                                        LIBTOOLS_SOCKET_WRAP_CLIENT_STRUCT *client)
+{
+    int32 nbytes;
+
+    socket_mutex.lock();
+    nbytes = ::send(client->fd,
+                    client->tx_buf.data() + client->tx_offset,
+                    client->tx_buf.size() - client->tx_offset,
+                    MSG_NOSIGNAL);
+    if(0 > nbytes)
     {
-        if(msg.size() != write(socket_fd, msg.c_str(), msg.size()))
+        if(EAGAIN      == errno ||
+           EWOULDBLOCK == errno ||
+           EINTR       == errno)
         {
-            err = LIBTOOLS_SOCKET_WRAP_ERROR_WRITE_FAIL;
-        }else{
-            err = LIBTOOLS_SOCKET_WRAP_SUCCESS;
+            socket_mutex.unlock();
+            return(true);
         }
+        socket_mutex.unlock();
+        close_client(client_id);
+        return(false);
+    }
+    client->tx_offset += nbytes;
+    if(client->tx_offset == client->tx_buf.size())
+    {
+        // Fully drained, stop watching for writability
+        client->tx_buf.clear();
+        client->tx_offset = 0;
+        reactor->mod_fd(client->fd, wrap_id, client_id, EPOLLIN | EPOLLRDHUP);
     }
+    socket_mutex.unlock();
 
-    return(err);
+    return(true);
 }
+void libtools_socket_wrap::close_client(uint32 client_id)
+{
+    std::map<uint32, LIBTOOLS_SOCKET_WRAP_CLIENT_STRUCT*>::iterator  iter;
+    LIBTOOLS_SOCKET_WRAP_CLIENT_STRUCT                              *client;
+
+    socket_mutex.lock();
+    iter = clients.find(client_id);
+    if(clients.end() == iter)
+    {
+        socket_mutex.unlock();
+        return;
+    }
+    client = (*iter).second;
+    clients.erase(iter);
+    socket_mutex.unlock();
+
+    reactor->del_fd(client->fd);
+    close(client->fd);
+    delete client;
 
-// Receive
-void* libtools_socket_wrap::server_thread(void *inputs)
+    if(NULL != socket_handle_client_disconnect)
+    {
+        socket_handle_client_disconnect(client_id);
+    }else{
+        socket_handle_disconnect();
+    }
+}
+void libtools_socket_wrap::deliver_line(uint32      client_id,
+                                        const char *line,
+                                        uint32      len)
 {
-    std::string                                msg;
-    LIBTOOLS_SOCKET_WRAP_THREAD_INPUTS_STRUCT *act_inputs = (LIBTOOLS_SOCKET_WRAP_THREAD_INPUTS_STRUCT *)inputs;
-    fd_set                                     fds;
-    fd_set                                     tmp_fds;
-    struct timeval                             select_timeout;
-    struct sockaddr_in                         c_addr;
-    socklen_t                                  c_addr_len;
-    int32                                      sock_fd;
-    int32                                      nbytes;
-    int32                                      ready;
-    int32                                      fd_max;
-    int32                                      i;
-    char                                       read_buf[LINE_MAX];
-
-    // Put socket into listen mode
-    if(0 != listen(act_inputs->sock, 1))
+    if(NULL != socket_handle_client_msg)
     {
-        act_inputs->handle_error(LIBTOOLS_SOCKET_WRAP_ERROR_SOCKET);
-        return(NULL);
+        socket_handle_client_msg(client_id, line, len);
+    }else{
+        socket_handle_msg(std::string(line, len));
     }
+}
 
-    // Setup the FD_SETs
-    FD_ZERO(&fds);
-    FD_ZERO(&tmp_fds);
-    FD_SET(act_inputs->sock, &fds);
-    fd_max = act_inputs->sock;
+// Helpers
+LIBTOOLS_SOCKET_WRAP_ERROR_ENUM libtools_socket_wrap::queue_msg(uint32                              client_id,
+                                                                LIBTOOLS_SOCKET_WRAP_CLIENT_STRUCT *client,
+                                                                const char                         *msg,
+                                                                uint32                              len)
+{
+    uint32 pending = client->tx_buf.size() - client->tx_offset;
+    int32  nbytes  = 0;
 
-    while(1)
+    // A slow reader only loses its own messages, the caller never blocks
+    if(pending + len > socket_tx_limit)
     {
-        // Select on the fds to see if there is any new data
-        select_timeout.tv_sec  = 0;
-        select_timeout.tv_usec = 500000;
-        tmp_fds                = fds;
-        if(select(fd_max+1, &tmp_fds, NULL, NULL, &select_timeout) == -1)
-        {
-            break;
-        }
+        return(LIBTOOLS_SOCKET_WRAP_ERROR_BACKPRESSURE);
+    }
 
-        for(i=0; i<=fd_max; i++)
+    if(0 == pending)
+    {
+        nbytes = ::send(client->fd, msg, len, MSG_NOSIGNAL);
+        if(0 > nbytes)
         {
-            if(FD_ISSET(i, &tmp_fds))
+            if(EAGAIN      != errno &&
+               EWOULDBLOCK != errno &&
+               EINTR       != errno)
             {
-                if(i == act_inputs->sock)
-                {
-                    // Accept connections
-                    act_inputs->socket_wrap->socket_mutex.lock();
-                    if(act_inputs->socket_wrap->socket_state != LIBTOOLS_SOCKET_WRAP_STATE_CONNECTED)
-                    {
-                        sock_fd = accept(act_inputs->sock, (struct sockaddr *)&c_addr, &c_addr_len);
-                        if(0 > sock_fd)
-                        {
-                            act_inputs->handle_error(LIBTOOLS_SOCKET_WRAP_ERROR_SOCKET);
-                            act_inputs->socket_wrap->socket_mutex.unlock();
-                            return(NULL);
-                        }
-
-                        // Finish setup
-                        act_inputs->socket_wrap->socket_fd    = sock_fd;
-                        act_inputs->socket_wrap->socket_state = LIBTOOLS_SOCKET_WRAP_STATE_CONNECTED;
-                        act_inputs->socket_wrap->socket_mutex.unlock();
-                        act_inputs->handle_connect();
-
-                        // Finish FD_SET setup
-                        FD_SET(sock_fd, &fds);
-                        if(sock_fd > fd_max)
-                        {
-                            fd_max = sock_fd;
-                        }
-                    }else{
-                        act_inputs->socket_wrap->socket_mutex.unlock();
-                    }
-                }else{
-                    memset(read_buf, '\0', LINE_MAX);
-                    nbytes = read(sock_fd, read_buf, LINE_MAX);
-
-                    // Check the return
-                    if(-1 == nbytes)
-                    {
-                        act_inputs->socket_wrap->socket_mutex.lock();
-                        if(LIBTOOLS_SOCKET_WRAP_STATE_CONNECTED == act_inputs->socket_wrap->socket_state)
-                        {
-                            act_inputs->socket_wrap->socket_mutex.unlock();
-                            act_inputs->handle_disconnect();
-                        }else{
-                            act_inputs->socket_wrap->socket_mutex.unlock();
-                        }
-                        act_inputs->socket_wrap->socket_mutex.lock();
-                        act_inputs->socket_wrap->socket_state = LIBTOOLS_SOCKET_WRAP_STATE_CLOSED;
-                        act_inputs->socket_wrap->socket_mutex.unlock();
-                        break;
-                    }else if(0 == nbytes){
-                        act_inputs->socket_wrap->socket_mutex.lock();
-                        if(LIBTOOLS_SOCKET_WRAP_STATE_CONNECTED == act_inputs->socket_wrap->socket_state)
-                        {
-                            act_inputs->socket_wrap->socket_mutex.unlock();
-                            act_inputs->handle_disconnect();
-                        }else{
-                            act_inputs->socket_wrap->socket_mutex.unlock();
-                        }
-                        act_inputs->socket_wrap->socket_mutex.lock();
-                        act_inputs->socket_wrap->socket_state = LIBTOOLS_SOCKET_WRAP_STATE_THREADED;
-                        act_inputs->socket_wrap->socket_mutex.unlock();
-                        break;
-                    }else{
-                        // Remove \n
-                        read_buf[strlen(read_buf)-1] = '\0';
-                        msg = read_buf;
-
-                        // Check for \r
-                        if(std::string::npos != msg.find("\r"))
-                        {
-                            // Remove \r
-                            read_buf[strlen(read_buf)-1] = '\0';
-                            msg = read_buf;
-
-                            // Process input
-                            while(std::string::npos != msg.find("\n"))
-                            {
-                                act_inputs->handle_msg(msg.substr(0, msg.find("\n")-1));
-                                msg = msg.substr(msg.find("\n")+1, std::string::npos);
-                            }
-                            act_inputs->handle_msg(msg);
-                        }else{
-                            // Process input
-                            while(std::string::npos != msg.find("\n"))
-                            {
-                                act_inputs->handle_msg(msg.substr(0, msg.find("\n")));
-                                msg = msg.substr(msg.find("\n")+1, std::string::npos);
-                            }
-                            act_inputs->handle_msg(msg);
-                        }
-                    }
-                }
+                return(LIBTOOLS_SOCKET_WRAP_ERROR_WRITE_FAIL);
             }
+            nbytes = 0;
+        }
+        if((uint32)nbytes == len)
+        {
+            return(LIBTOOLS_SOCKET_WRAP_SUCCESS);
         }
+        reactor->mod_fd(client->fd, wrap_id, client_id, EPOLLIN | EPOLLRDHUP | EPOLLOUT);
+    }else if(client->tx_offset > client->tx_buf.size()/2){
+        client->tx_buf.erase(0, client->tx_offset);
+        client->tx_offset = 0;
     }
+    client->tx_buf.append(&msg[nbytes], len - nbytes);
 
-    // Close
-    close(sock_fd);
-    close(act_inputs->sock);
-
-    return(NULL);
-}
-void* libtools_socket_wrap::client_thread(void *inputs)
-{
-    // FIXME
-    return(NULL);
+    return(LIBTOOLS_SOCKET_WRAP_SUCCESS);
 }